@@ -847,9 +847,11 @@ class MixxxCore(Feature):
 
                    "src/engine/engineworker.cpp",
                    "src/engine/engineworkerscheduler.cpp",
+                   "src/engine/enginethreadpool.cpp",
                    "src/engine/enginebuffer.cpp",
                    "src/engine/bufferscalers/enginebufferscale.cpp",
                    "src/engine/bufferscalers/enginebufferscalelinear.cpp",
+                   "src/engine/bufferscalers/enginebufferscalelookahead.cpp",
                    "src/engine/channels/engineaux.cpp",
                    "src/engine/channels/enginechannel.cpp",
                    "src/engine/channels/enginedeck.cpp",
@@ -866,6 +868,7 @@ class MixxxCore(Feature):
                    "src/engine/filters/enginefilter.cpp",
                    "src/engine/engineobject.cpp",
                    "src/engine/enginepregain.cpp",
+                   "src/engine/enginerenderer.cpp",
                    "src/engine/enginemaster.cpp",
                    "src/engine/enginedelay.cpp",
                    "src/engine/enginevumeter.cpp",
@@ -892,6 +895,8 @@ class MixxxCore(Feature):
 
                    "src/analyzer/trackanalysisscheduler.cpp",
                    "src/analyzer/analyzerthread.cpp",
+                   "src/analyzer/analysisframebus.cpp",
+                   "src/analyzer/analysisreuse.cpp",
                    "src/analyzer/analyzerwaveform.cpp",
                    "src/analyzer/analyzergain.cpp",
                    "src/analyzer/analyzerbeats.cpp",
@@ -902,6 +907,7 @@ class MixxxCore(Feature):
                    "src/analyzer/plugins/analyzerqueenmarybeats.cpp",
                    "src/analyzer/plugins/analyzerqueenmarykey.cpp",
                    "src/analyzer/plugins/buffering_utils.cpp",
+                   "src/analyzer/quickanalysis.cpp",
 
                    "src/audio/types.cpp",
                    "src/audio/signalinfo.cpp",
@@ -1090,6 +1096,7 @@ class MixxxCore(Feature):
                    "src/library/baseexternallibraryfeature.cpp",
                    "src/library/baseexternaltrackmodel.cpp",
                    "src/library/baseexternalplaylistmodel.cpp",
+                   "src/library/importbatchwriter.cpp",
                    "src/library/rhythmbox/rhythmboxfeature.cpp",
 
                    "src/library/banshee/bansheefeature.cpp",
@@ -1097,11 +1104,13 @@ class MixxxCore(Feature):
                    "src/library/banshee/bansheedbconnection.cpp",
 
                    "src/library/itunes/itunesfeature.cpp",
+                   "src/library/itunes/itunesxmlimporter.cpp",
                    "src/library/traktor/traktorfeature.cpp",
                    "src/library/serato/seratofeature.cpp",
                    "src/library/serato/seratoplaylistmodel.cpp",
 
                    "src/library/rekordbox/rekordboxfeature.cpp",
+                   "src/library/rekordbox/rekordboxpdbreader.cpp",
                    "src/library/rekordbox/rekordbox_pdb.cpp",
                    "src/library/rekordbox/rekordbox_anlz.cpp",
 
@@ -1110,6 +1119,7 @@ class MixxxCore(Feature):
 
                    "src/library/scanner/libraryscanner.cpp",
                    "src/library/scanner/libraryscannerdlg.cpp",
+                   "src/library/scanner/librarywatcher.cpp",
                    "src/library/scanner/scannertask.cpp",
                    "src/library/scanner/importfilestask.cpp",
                    "src/library/scanner/recursivescandirectorytask.cpp",
@@ -1118,6 +1128,7 @@ class MixxxCore(Feature):
                    "src/library/dao/trackdao.cpp",
                    "src/library/dao/playlistdao.cpp",
                    "src/library/dao/libraryhashdao.cpp",
+                   "src/library/dao/libraryfilestatdao.cpp",
                    "src/library/dao/settingsdao.cpp",
                    "src/library/dao/analysisdao.cpp",
                    "src/library/dao/autodjcratesdao.cpp",
@@ -1213,6 +1224,8 @@ class MixxxCore(Feature):
                    "src/skin/colorschemeparser.cpp",
                    "src/skin/tooltips.cpp",
                    "src/skin/skincontext.cpp",
+                   "src/skin/skindocumentcache.cpp",
+                   "src/skin/skinimagepreloader.cpp",
                    "src/skin/svgparser.cpp",
                    "src/skin/pixmapsource.cpp",
                    "src/skin/launchimage.cpp",
@@ -1277,6 +1290,8 @@ class MixxxCore(Feature):
                    "src/util/sleepableqthread.cpp",
                    "src/util/statsmanager.cpp",
                    "src/util/stat.cpp",
+                   "src/util/callbackprofiler.cpp",
+                   "src/util/latencyhistogram.cpp",
                    "src/util/statmodel.cpp",
                    "src/util/dnd.cpp",
                    "src/util/duration.cpp",
@@ -1310,6 +1325,7 @@ class MixxxCore(Feature):
                    "src/util/db/fwdsqlqueryselectresult.cpp",
                    "src/util/db/sqllikewildcardescaper.cpp",
                    "src/util/db/sqlqueryfinisher.cpp",
+                   "src/util/db/sqlstatementcache.cpp",
                    "src/util/db/sqlstringformatter.cpp",
                    "src/util/db/sqltransaction.cpp",
                    "src/util/sample.cpp",
@@ -299,6 +299,8 @@ class VinylControl(Feature):
                    'src/vinylcontrol/vinylcontrolmanager.cpp',
                    'src/vinylcontrol/vinylcontrolprocessor.cpp',
                    'src/vinylcontrol/steadypitch.cpp',
+                   'src/vinylcontrol/timecodelutcache.cpp',
+                   'src/vinylcontrol/vinylcontroldecoder.cpp',
                    'src/engine/controls/vinylcontrolcontrol.cpp', ]
         if build.platform_is_windows:
             sources.append("lib/xwax/timecoder_win32.cpp")
@@ -84,7 +84,15 @@ struct timecoder {
     int mon_size, mon_counter;
 };
 
+/* Reports the number of lookup table entries built so far */
+typedef void (*timecoder_progress_t)(void *data, unsigned int n);
+
+#define LUT_PROGRESS_INTERVAL 65536
+
+struct timecode_def* timecoder_match_definition(const char *name);
 struct timecode_def* timecoder_find_definition(const char *name);
+int timecoder_build_lookup(struct timecode_def *def,
+                           timecoder_progress_t progress, void *data);
 void timecoder_free_lookup(void);
 
 void timecoder_init(struct timecoder *tc, struct timecode_def *def,
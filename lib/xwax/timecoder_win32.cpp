@@ -194,12 +194,15 @@ static inline bits_t rev(bits_t current, struct timecode_def *def)
 }
 
 /*
- * Where necessary, build the lookup table required for this timecode
+ * Where necessary, build the lookup table required for this timecode.
+ * The optional progress callback is invoked with the number of entries
+ * built so far every LUT_PROGRESS_INTERVAL entries.
  *
  * Return: -1 if not enough memory could be allocated, otherwise 0
  */
 
-static int build_lookup(struct timecode_def *def)
+int timecoder_build_lookup(struct timecode_def *def,
+                           timecoder_progress_t progress, void *data)
 {
     unsigned int n;
     bits_t current;
@@ -227,6 +230,9 @@ static int build_lookup(struct timecode_def *def)
         dassert(rev(next, def) == current);
 
         current = next;
+
+        if (progress != NULL && (n + 1) % LUT_PROGRESS_INTERVAL == 0)
+            progress(data, n + 1);
     }
 
     def->lookup = true;
@@ -235,12 +241,12 @@ static int build_lookup(struct timecode_def *def)
 }
 
 /*
- * Find a timecode definition by name
+ * Find a timecode definition by name without building its lookup table
  *
  * Return: pointer to timecode definition, or NULL if not found
  */
 
-struct timecode_def* timecoder_find_definition(const char *name)
+struct timecode_def* timecoder_match_definition(const char *name)
 {
     struct timecode_def *def, *end;
 
@@ -257,7 +263,24 @@ struct timecode_def* timecoder_find_definition(const char *name)
             return NULL;
     }
 
-    if (build_lookup(def) == -1)
+    return def;
+}
+
+/*
+ * Find a timecode definition by name
+ *
+ * Return: pointer to timecode definition, or NULL if not found
+ */
+
+struct timecode_def* timecoder_find_definition(const char *name)
+{
+    struct timecode_def *def;
+
+    def = timecoder_match_definition(name);
+    if (def == NULL)
+        return NULL;
+
+    if (timecoder_build_lookup(def, NULL, NULL) == -1)
         return NULL;
 
     return def;
@@ -274,8 +297,10 @@ void timecoder_free_lookup(void) {
     end = def + ARRAY_SIZE(timecodes);
 
     while (def < end) {
-        if (def->lookup)
+        if (def->lookup) {
             lut_clear(&def->lut);
+            def->lookup = false;
+        }
         def++;
     }
 }
@@ -204,6 +204,8 @@ def write_channelmixer_autogen(output, num_channels):
                     "processed signal into pOutput",
                     depth=2,
                 )
+            if i > 1:
+                write("pEngineEffectsManager->beginParallelBatch();", depth=2)
             for j in range(i):
                 if inplace:
                     write(
@@ -229,6 +231,8 @@ def write_channelmixer_autogen(output, num_channels):
                         % {"j": j},
                         depth=2,
                     )
+            if i > 1:
+                write("pEngineEffectsManager->finishParallelBatch();", depth=2)
 
             if inplace:
                 write(
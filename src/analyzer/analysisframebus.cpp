@@ -0,0 +1,81 @@
+#include "analyzer/analysisframebus.h"
+
+#include "util/assert.h"
+
+namespace mixxx {
+
+AnalysisFrameBus::AnalysisFrameBus(SINT maxFrames)
+        : m_pStereoSamples(nullptr),
+          m_frames(0),
+          m_monoSamples(maxFrames),
+          m_monoValid(false) {
+}
+
+void AnalysisFrameBus::reset() {
+    m_pStereoSamples = nullptr;
+    m_frames = 0;
+    m_monoValid = false;
+    m_decimatedSignals.clear();
+}
+
+void AnalysisFrameBus::publish(const CSAMPLE* pStereoSamples, SINT frames) {
+    DEBUG_ASSERT(frames >= 0);
+    if (frames > m_monoSamples.size()) {
+        // Only analyzers that are fed directly with larger chunks than
+        // the analysis uses get here
+        SampleBuffer(frames).swap(m_monoSamples);
+    }
+    m_pStereoSamples = pStereoSamples;
+    m_frames = frames;
+    m_monoValid = false;
+    // The decimated signals depend on all previous chunks and can't be
+    // computed later on demand
+    for (const auto& pSignal : m_decimatedSignals) {
+        updateDecimatedSignal(pSignal.get());
+    }
+}
+
+const CSAMPLE* AnalysisFrameBus::monoData() const {
+    if (!m_monoValid) {
+        CSAMPLE* pMono = m_monoSamples.data();
+        const CSAMPLE* pStereo = m_pStereoSamples;
+        // The sum is halved exactly, so the result is the same as if the
+        // downmix would have been done by the analyzers in double precision
+        for (SINT i = 0; i < m_frames; ++i) {
+            pMono[i] = (pStereo[i * 2] + pStereo[i * 2 + 1]) * 0.5f;
+        }
+        m_monoValid = true;
+    }
+    return m_monoSamples.data();
+}
+
+SampleBuffer::ReadableSlice AnalysisFrameBus::decimatedMonoData(int factor) const {
+    if (factor <= 1) {
+        return SampleBuffer::ReadableSlice(monoData(), m_frames);
+    }
+    for (const auto& pSignal : m_decimatedSignals) {
+        if (pSignal->decimator.factor() == factor) {
+            return SampleBuffer::ReadableSlice(
+                    pSignal->samples.data(), pSignal->length);
+        }
+    }
+    // Requested for the first time, starting with the current chunk
+    auto pSignal = std::make_unique<DecimatedSignal>(
+            factor, m_monoSamples.size());
+    updateDecimatedSignal(pSignal.get());
+    m_decimatedSignals.push_back(std::move(pSignal));
+    const DecimatedSignal& signal = *m_decimatedSignals.back();
+    return SampleBuffer::ReadableSlice(signal.samples.data(), signal.length);
+}
+
+void AnalysisFrameBus::updateDecimatedSignal(DecimatedSignal* pSignal) const {
+    const auto maxLength = static_cast<SINT>(PolyphaseDecimator::maxOutputSamples(
+            m_frames, pSignal->decimator.factor()));
+    if (maxLength > pSignal->samples.size()) {
+        SampleBuffer(maxLength).swap(pSignal->samples);
+    }
+    pSignal->length = static_cast<SINT>(pSignal->decimator.process(
+            monoData(), m_frames, pSignal->samples.data()));
+}
+
+} // namespace mixxx
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "analyzer/plugins/buffering_utils.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+namespace mixxx {
+
+// Hands each decoded chunk of stereo frames to all analyzers of a track.
+// Signals that are derived from the decoded frames like the mono downmix
+// are computed only once per chunk when the first analyzer asks for them
+// instead of once by every analyzer.
+class AnalysisFrameBus final {
+  public:
+    explicit AnalysisFrameBus(SINT maxFrames);
+    AnalysisFrameBus(const AnalysisFrameBus&) = delete;
+    AnalysisFrameBus& operator=(const AnalysisFrameBus&) = delete;
+
+    // Starts a new track. The state of the decimated signals is discarded.
+    void reset();
+
+    // Publishes the next chunk of interleaved stereo samples that are
+    // not copied and must stay valid until the next chunk is published.
+    void publish(const CSAMPLE* pStereoSamples, SINT frames);
+
+    SINT frameLength() const {
+        return m_frames;
+    }
+
+    const CSAMPLE* stereoData() const {
+        return m_pStereoSamples;
+    }
+    SINT stereoLength() const {
+        return m_frames * 2;
+    }
+
+    // The (L+R)/2 downmix of the current chunk with one sample per frame
+    const CSAMPLE* monoData() const;
+
+    // The mono downmix of the current chunk at the sample rate lowered by
+    // the given factor, see PolyphaseDecimator. The number of samples may
+    // vary from chunk to chunk. Once requested, a decimated signal is
+    // updated for every published chunk until the bus is reset, so that
+    // the signal stays continuous for all analyzers that share it.
+    SampleBuffer::ReadableSlice decimatedMonoData(int factor) const;
+
+  private:
+    struct DecimatedSignal {
+        DecimatedSignal(int factor, SINT maxFrames)
+                : decimator(factor),
+                  samples(PolyphaseDecimator::maxOutputSamples(maxFrames, factor)),
+                  length(0) {
+        }
+        PolyphaseDecimator decimator;
+        SampleBuffer samples;
+        SINT length;
+    };
+
+    void updateDecimatedSignal(DecimatedSignal* pSignal) const;
+
+    const CSAMPLE* m_pStereoSamples;
+    SINT m_frames;
+
+    // Lazily computed on first access
+    mutable SampleBuffer m_monoSamples;
+    mutable bool m_monoValid;
+
+    mutable std::vector<std::unique_ptr<DecimatedSignal>> m_decimatedSignals;
+};
+
+} // namespace mixxx
@@ -0,0 +1,264 @@
+#include "analyzer/analysisreuse.h"
+
+#include <QCryptographicHash>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QtEndian>
+#include <cmath>
+#include <vector>
+
+#include "analyzer/constants.h"
+#include "analyzer/quickanalysis.h"
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "track/beatfactory.h"
+#include "track/keyfactory.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("AnalysisReuse");
+
+const ConfigKey kReuseAnalysisConfigKey("[Library]", "ReuseAnalysisOfIdenticalAudio");
+
+// Spread evenly across the track, so that tracks with the same length and
+// digital silence at both ends are still told apart. About 6 seconds of
+// audio are decoded.
+constexpr int kFingerprintChunks = 16;
+
+template<typename T>
+void addValueToHash(QCryptographicHash* pHash, T value) {
+    const T littleEndian = qToLittleEndian(value);
+    pHash->addData(reinterpret_cast<const char*>(&littleEndian), sizeof(T));
+}
+
+} // anonymous namespace
+
+// static
+bool AnalysisReuse::isEnabled(const UserSettingsPointer& pConfig) {
+    return pConfig->getValue<bool>(kReuseAnalysisConfigKey, true);
+}
+
+// static
+AudioFingerprint AnalysisReuse::computeAudioFingerprint(
+        const AudioSourcePointer& pAudioSource,
+        SampleBuffer* pSampleBuffer) {
+    DEBUG_ASSERT(pSampleBuffer->size() >= kAnalysisSamplesPerChunk);
+    AudioSourceStereoProxy audioSourceProxy(
+            pAudioSource,
+            kAnalysisFramesPerChunk);
+    const IndexRange frameIndexRange = audioSourceProxy.frameIndexRange();
+    const SINT chunkFrames = math_min(kAnalysisFramesPerChunk, frameIndexRange.length());
+    if (chunkFrames <= 0) {
+        return kInvalidAudioFingerprint;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    addValueToHash<quint32>(&hash, audioSourceProxy.getSignalInfo().getSampleRate());
+    addValueToHash<quint64>(&hash, frameIndexRange.length());
+    // The samples are quantized to 16 bits, so tiny differences between
+    // decoder versions don't change the fingerprint in most cases
+    std::vector<qint16> quantizedSamples(chunkFrames * kAnalysisChannels);
+    for (int chunk = 0; chunk < kFingerprintChunks; ++chunk) {
+        const SINT chunkStart = frameIndexRange.start() +
+                (frameIndexRange.length() - chunkFrames) * chunk /
+                        (kFingerprintChunks - 1);
+        const auto readableSampleFrames =
+                audioSourceProxy.readSampleFrames(
+                        WritableSampleFrames(
+                                IndexRange::forward(chunkStart, chunkFrames),
+                                SampleBuffer::WritableSlice(*pSampleBuffer)));
+        const SINT samples = readableSampleFrames.readableLength();
+        if (samples <= 0) {
+            kLogger.warning()
+                    << "Failed to read audio for the fingerprint at frame"
+                    << chunkStart;
+            return kInvalidAudioFingerprint;
+        }
+        const CSAMPLE* pSamples = readableSampleFrames.readableData();
+        for (SINT i = 0; i < samples; ++i) {
+            const CSAMPLE sample = math_clamp(pSamples[i], -1.0f, 1.0f);
+            quantizedSamples[i] = qToLittleEndian(
+                    static_cast<qint16>(std::lround(sample * 32767.0f)));
+        }
+        hash.addData(
+                reinterpret_cast<const char*>(quantizedSamples.data()),
+                samples * sizeof(qint16));
+    }
+
+    const QByteArray result = hash.result();
+    const auto audioFingerprint =
+            qFromLittleEndian<AudioFingerprint>(result.constData());
+    if (audioFingerprint == kInvalidAudioFingerprint) {
+        // Extremely unlikely
+        return kInvalidAudioFingerprint + 1;
+    }
+    return audioFingerprint;
+}
+
+AnalysisReuse::AnalysisReuse(
+        const QSqlDatabase& database)
+        : m_database(database) {
+}
+
+bool AnalysisReuse::hasAudioFingerprint(
+        TrackId trackId) {
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "SELECT 1 FROM " LIBRARY_TABLE " "
+            "WHERE %1=:id AND %2 IS NOT NULL")
+                          .arg(LIBRARYTABLE_ID,
+                                  LIBRARYTABLE_AUDIOFINGERPRINT));
+    query.bindValue(":id", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't find audio fingerprint of track" << trackId;
+        // Don't fingerprint the track again and again
+        return true;
+    }
+    return query.next();
+}
+
+bool AnalysisReuse::storeAudioFingerprint(
+        TrackId trackId,
+        AudioFingerprint audioFingerprint) {
+    DEBUG_ASSERT(audioFingerprint != kInvalidAudioFingerprint);
+    QSqlQuery query(m_database);
+    // An unchanged fingerprint is not written again
+    query.prepare(QString(
+            "UPDATE " LIBRARY_TABLE " SET %1=:fingerprint "
+            "WHERE %2=:id AND %1 IS NOT :storedFingerprint")
+                          .arg(LIBRARYTABLE_AUDIOFINGERPRINT,
+                                  LIBRARYTABLE_ID));
+    query.bindValue(":fingerprint", audioFingerprint);
+    query.bindValue(":id", trackId.toVariant());
+    query.bindValue(":storedFingerprint", audioFingerprint);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't store audio fingerprint of track" << trackId;
+        return false;
+    }
+    return true;
+}
+
+bool AnalysisReuse::reuseAnalysisResults(
+        const TrackPointer& pTrack,
+        AudioFingerprint audioFingerprint) {
+    DEBUG_ASSERT(audioFingerprint != kInvalidAudioFingerprint);
+    const TrackId trackId = pTrack->getId();
+    if (!trackId.isValid()) {
+        return false;
+    }
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+            "SELECT beats_version,beats_sub_version,beats,"
+            "keys_version,keys_sub_version,keys "
+            "FROM " LIBRARY_TABLE " WHERE %1=:fingerprint AND id<>:id")
+                          .arg(LIBRARYTABLE_AUDIOFINGERPRINT));
+    query.bindValue(":fingerprint", audioFingerprint);
+    query.bindValue(":id", trackId.toVariant());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't find tracks with the same audio as" << trackId;
+        return false;
+    }
+
+    bool reused = false;
+    while (query.next()) {
+        const QSqlRecord record = query.record();
+        const QString beatsSubVersion = record.value("beats_sub_version").toString();
+        const QString keysSubVersion = record.value("keys_sub_version").toString();
+        if (isQuickAnalysisSubVersion(beatsSubVersion) ||
+                isQuickAnalysisSubVersion(keysSubVersion)) {
+            continue;
+        }
+
+        if (!pTrack->getBeats() && !pTrack->isBpmLocked()) {
+            const BeatsPointer pBeats = BeatFactory::loadBeatsFromByteArray(
+                    *pTrack,
+                    record.value("beats_version").toString(),
+                    beatsSubVersion,
+                    record.value("beats").toByteArray());
+            if (pBeats) {
+                pTrack->setBeats(pBeats);
+                reused = true;
+            }
+        }
+
+        if (!pTrack->getKeys().isValid()) {
+            QByteArray keysBlob = record.value("keys").toByteArray();
+            const Keys keys = KeyFactory::loadKeysFromByteArray(
+                    record.value("keys_version").toString(),
+                    keysSubVersion,
+                    &keysBlob);
+            if (keys.isValid()) {
+                pTrack->setKeys(keys);
+                reused = true;
+            }
+        }
+    }
+
+    if (reused) {
+        kLogger.debug()
+                << "Reused analysis results for track"
+                << trackId
+                << "with the same audio fingerprint"
+                << audioFingerprint;
+    }
+    return reused;
+}
+
+void AnalysisReuseStatistics::addTrack(const TrackAnalysisStatistics& track) {
+    if (track.isReused()) {
+        if (track.isPartiallyReused()) {
+            ++m_partiallyReusedTracksCount;
+            if (track.beatsReused) {
+                m_beatsReusedAudioSeconds += track.audioSeconds;
+            }
+            if (track.keysReused) {
+                m_keysReusedAudioSeconds += track.audioSeconds;
+            }
+        } else {
+            ++m_reusedTracksCount;
+            m_skippedAudioSeconds += track.audioSeconds;
+        }
+    } else if (track.analyzed) {
+        // Only complete analyses tell how long a skipped track would
+        // have taken
+        m_analyzedAudioSeconds += track.audioSeconds;
+        m_analysisSeconds += track.analysisSeconds;
+    }
+    if (track.beatsAnalyzed) {
+        m_beatsAnalyzedAudioSeconds += track.audioSeconds;
+        m_beatsAnalysisSeconds += track.beatsAnalysisSeconds;
+    }
+    if (track.keysAnalyzed) {
+        m_keysAnalyzedAudioSeconds += track.audioSeconds;
+        m_keysAnalysisSeconds += track.keysAnalysisSeconds;
+    }
+}
+
+void AnalysisReuseStatistics::reset() {
+    *this = AnalysisReuseStatistics();
+}
+
+double AnalysisReuseStatistics::estimatedSecondsSaved() const {
+    double secondsSaved = 0.0;
+    if (m_analyzedAudioSeconds > 0.0) {
+        secondsSaved += m_skippedAudioSeconds *
+                m_analysisSeconds / m_analyzedAudioSeconds;
+    }
+    if (m_beatsAnalyzedAudioSeconds > 0.0) {
+        secondsSaved += m_beatsReusedAudioSeconds *
+                m_beatsAnalysisSeconds / m_beatsAnalyzedAudioSeconds;
+    }
+    if (m_keysAnalyzedAudioSeconds > 0.0) {
+        secondsSaved += m_keysReusedAudioSeconds *
+                m_keysAnalysisSeconds / m_keysAnalyzedAudioSeconds;
+    }
+    return secondsSaved;
+}
+
+} // namespace mixxx
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QMetaType>
+#include <QSqlDatabase>
+
+#include "preferences/usersettings.h"
+#include "sources/audiosource.h"
+#include "track/track.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+// Identifies the decoded audio of a track independent of its file, e.g.
+// for copies of the same file in different folders or with different tags.
+typedef qint64 AudioFingerprint;
+
+constexpr AudioFingerprint kInvalidAudioFingerprint = 0;
+
+// Reuses the analysis results of tracks with identical audio instead of
+// analyzing the same audio again. The fingerprint of the audio is stored
+// in the library whenever the analyzer visits a track without one, also
+// if nothing is left to analyze. Tracks analyzed before fingerprints
+// were introduced are therefore only reused after they have been loaded
+// or analyzed again.
+// Only the beats and keys of other tracks with the same fingerprint are
+// copied. The fingerprint only samples the audio, so edits of a track like
+// a clean and an explicit version may share it. Beats and keys don't change
+// with such edits, but the waveform and ReplayGain do and are analyzed
+// again.
+class AnalysisReuse final {
+  public:
+    static bool isEnabled(const UserSettingsPointer& pConfig);
+
+    // Hashes the signal properties and chunks of decoded audio spread
+    // evenly from the start to the end of the audio source. This is much
+    // cheaper than decoding the whole track. The sample buffer
+    // must fit kAnalysisSamplesPerChunk samples.
+    static AudioFingerprint computeAudioFingerprint(
+            const AudioSourcePointer& pAudioSource,
+            SampleBuffer* pSampleBuffer);
+
+    explicit AnalysisReuse(
+            const QSqlDatabase& database);
+
+    bool hasAudioFingerprint(
+            TrackId trackId);
+
+    // Leaves the library alone if the fingerprint has been stored before
+    bool storeAudioFingerprint(
+            TrackId trackId,
+            AudioFingerprint audioFingerprint);
+
+    // Copies the results that the track is missing from other tracks with
+    // the same fingerprint. Provisional results of a quick analysis are
+    // not reused. Returns true if any results have been copied.
+    bool reuseAnalysisResults(
+            const TrackPointer& pTrack,
+            AudioFingerprint audioFingerprint);
+
+  private:
+    QSqlDatabase m_database;
+};
+
+// How long the analysis of a single track took and which of its results
+// have been reused instead of being analyzed
+struct TrackAnalysisStatistics {
+    // The part of the track that is or would have been analyzed
+    double audioSeconds = 0.0;
+    // Decoding and all analyzers
+    double analysisSeconds = 0.0;
+    // False if nothing was left to analyze after reusing results
+    bool analyzed = false;
+    // Spent in the beat and key analyzers if they analyzed the track
+    double beatsAnalysisSeconds = 0.0;
+    double keysAnalysisSeconds = 0.0;
+    bool beatsAnalyzed = false;
+    bool keysAnalyzed = false;
+    bool beatsReused = false;
+    bool keysReused = false;
+
+    bool isReused() const {
+        return beatsReused || keysReused;
+    }
+    // The other analyzers, e.g. the waveform or ReplayGain, still needed
+    // to decode the whole track
+    bool isPartiallyReused() const {
+        return isReused() && analyzed;
+    }
+};
+
+// Sums up the statistics of all tracks to estimate how much time reusing
+// results has saved. Tracks that have been skipped entirely save the
+// average time of a complete analysis. The beat and key analyzers that
+// have been skipped for partially reused tracks save their average time.
+class AnalysisReuseStatistics final {
+  public:
+    void addTrack(const TrackAnalysisStatistics& track);
+    void reset();
+
+    int reusedTracksCount() const {
+        return m_reusedTracksCount;
+    }
+    int partiallyReusedTracksCount() const {
+        return m_partiallyReusedTracksCount;
+    }
+
+    // Zero until tracks have been analyzed that the estimate could be
+    // based on
+    double estimatedSecondsSaved() const;
+
+  private:
+    int m_reusedTracksCount = 0;
+    int m_partiallyReusedTracksCount = 0;
+
+    // The audio of tracks that have been skipped entirely and of beats
+    // and keys that have been reused for partially reused tracks
+    double m_skippedAudioSeconds = 0.0;
+    double m_beatsReusedAudioSeconds = 0.0;
+    double m_keysReusedAudioSeconds = 0.0;
+
+    // The measured speed of complete analyses and of the beat and key
+    // analyzers
+    double m_analyzedAudioSeconds = 0.0;
+    double m_analysisSeconds = 0.0;
+    double m_beatsAnalyzedAudioSeconds = 0.0;
+    double m_beatsAnalysisSeconds = 0.0;
+    double m_keysAnalyzedAudioSeconds = 0.0;
+    double m_keysAnalysisSeconds = 0.0;
+};
+
+} // namespace mixxx
+
+Q_DECLARE_METATYPE(mixxx::TrackAnalysisStatistics);
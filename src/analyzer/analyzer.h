@@ -1,6 +1,9 @@
 #pragma once
 
+#include "analyzer/analysisframebus.h"
 #include "util/assert.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
 #include "util/types.h"
 
 /*
@@ -34,6 +37,13 @@ class Analyzer {
     // but not finalize()!
     virtual bool processSamples(const CSAMPLE* pIn, const int iLen) = 0;
 
+    // Analyze the next chunk of audio frames that is shared with all
+    // other analyzers. Analyzers that are able to reuse signals derived
+    // from the chunk, e.g. the mono downmix, should override this method.
+    virtual bool processFrames(const mixxx::AnalysisFrameBus& frameBus) {
+        return processSamples(frameBus.stereoData(), frameBus.stereoLength());
+    }
+
     // Update the track object with the analysis results after
     // processing finished successfully, i.e. all available audio
     // samples have been processed.
@@ -66,14 +76,44 @@ class AnalyzerWithState final {
         return m_active;
     }
 
+    // Time spent processing the current track and storing the results
+    mixxx::Duration processingDuration() const {
+        return m_processingDuration;
+    }
+
     bool initialize(TrackPointer tio, int sampleRate, int totalSamples) {
         DEBUG_ASSERT(!m_active);
+        m_processingDuration = mixxx::Duration::empty();
         return m_active = m_analyzer->initialize(tio, sampleRate, totalSamples);
     }
 
+    // Lets the analyzer decide again if the track needs to be analyzed,
+    // e.g. after results have been added to the track by other means
+    bool reinitialize(TrackPointer tio, int sampleRate, int totalSamples) {
+        cancel();
+        return initialize(tio, sampleRate, totalSamples);
+    }
+
     void processSamples(const CSAMPLE* pIn, const int iLen) {
         if (m_active) {
+            PerformanceTimer timer;
+            timer.start();
             m_active = m_analyzer->processSamples(pIn, iLen);
+            m_processingDuration += timer.elapsed();
+            if (!m_active) {
+                // Ensure that cleanup() is invoked after processing
+                // failed and the analyzer became inactive!
+                m_analyzer->cleanup();
+            }
+        }
+    }
+
+    void processFrames(const mixxx::AnalysisFrameBus& frameBus) {
+        if (m_active) {
+            PerformanceTimer timer;
+            timer.start();
+            m_active = m_analyzer->processFrames(frameBus);
+            m_processingDuration += timer.elapsed();
             if (!m_active) {
                 // Ensure that cleanup() is invoked after processing
                 // failed and the analyzer became inactive!
@@ -84,7 +124,10 @@ class AnalyzerWithState final {
 
     void finish(TrackPointer tio) {
         if (m_active) {
+            PerformanceTimer timer;
+            timer.start();
             m_analyzer->storeResults(tio);
+            m_processingDuration += timer.elapsed();
             m_analyzer->cleanup();
             m_active = false;
         }
@@ -100,4 +143,5 @@ class AnalyzerWithState final {
   private:
     AnalyzerPtr m_analyzer;
     bool m_active;
+    mixxx::Duration m_processingDuration;
 };
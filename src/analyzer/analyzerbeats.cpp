@@ -4,11 +4,15 @@
 #include <QString>
 #include <QVector>
 #include <QtDebug>
+#include <algorithm>
+#include <utility>
 
 #include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerqueenmarybeats.h"
 #include "analyzer/plugins/analyzersoundtouchbeats.h"
+#include "analyzer/quickanalysis.h"
 #include "track/beatfactory.h"
+#include "track/beatgrid.h"
 #include "track/beatmap.h"
 #include "track/beatutils.h"
 #include "track/track.h"
@@ -22,9 +26,13 @@ QList<mixxx::AnalyzerPluginInfo> AnalyzerBeats::availablePlugins() {
     return plugins;
 }
 
-AnalyzerBeats::AnalyzerBeats(UserSettingsPointer pConfig, bool enforceBpmDetection)
+AnalyzerBeats::AnalyzerBeats(UserSettingsPointer pConfig,
+        bool enforceBpmDetection,
+        bool quickAnalysis)
         : m_bpmSettings(pConfig),
           m_enforceBpmDetection(enforceBpmDetection),
+          m_quickAnalysis(quickAnalysis),
+          m_bQuickAnalysisReplayGain(false),
           m_bPreferencesReanalyzeOldBpm(false),
           m_bPreferencesFixedTempo(true),
           m_bPreferencesOffsetCorrection(false),
@@ -80,13 +88,21 @@ bool AnalyzerBeats::initialize(TrackPointer tio, int sampleRate, int totalSample
              << "\nFixed tempo assumption:" << m_bPreferencesFixedTempo
              << "\nOffset correction:" << m_bPreferencesOffsetCorrection
              << "\nRe-analyze when settings change:" << m_bPreferencesReanalyzeOldBpm
-             << "\nFast analysis:" << m_bPreferencesFastAnalysis;
+             << "\nFast analysis:" << m_bPreferencesFastAnalysis
+             << "\nQuick analysis:" << m_quickAnalysis;
 
     m_iSampleRate = sampleRate;
     m_iTotalSamples = totalSamples;
     // In fast analysis mode, skip processing after
-    // kFastAnalysisSecondsToAnalyze seconds are analyzed.
-    if (m_bPreferencesFastAnalysis) {
+    // kFastAnalysisSecondsToAnalyze seconds are analyzed. In quick analysis
+    // mode, only the windows of the track are received.
+    if (m_quickAnalysis) {
+        m_iMaxSamplesToProcess = m_iTotalSamples;
+        m_bQuickAnalysisReplayGain = !tio->getReplayGain().hasRatio();
+        m_quickAnalysisFrameRanges = mixxx::quickAnalysisFrameRanges(
+                mixxx::IndexRange::forward(0, m_iTotalSamples / mixxx::kAnalysisChannels),
+                m_iSampleRate);
+    } else if (m_bPreferencesFastAnalysis) {
         m_iMaxSamplesToProcess =
                 mixxx::kFastAnalysisSecondsToAnalyze * m_iSampleRate * mixxx::kAnalysisChannels;
     } else {
@@ -144,6 +160,15 @@ bool AnalyzerBeats::shouldAnalyze(TrackPointer tio) const {
         QString version = pBeats->getVersion();
         QString subVersion = pBeats->getSubVersion();
 
+        if (m_quickAnalysis) {
+            // Never replace beats with provisional ones
+            return false;
+        }
+        if (mixxx::isQuickAnalysisSubVersion(subVersion)) {
+            qDebug() << "Replacing the provisional beats of a quick analysis.";
+            return true;
+        }
+
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
                 pluginID,
                 m_bPreferencesFastAnalysis);
@@ -191,6 +216,19 @@ bool AnalyzerBeats::processSamples(const CSAMPLE *pIn, const int iLen) {
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+bool AnalyzerBeats::processFrames(const mixxx::AnalysisFrameBus& frameBus) {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+
+    m_iCurrentSample += frameBus.stereoLength();
+    if (m_iCurrentSample > m_iMaxSamplesToProcess) {
+        return true; // silently ignore all remaining samples
+    }
+
+    return m_pPlugin->processFrames(frameBus);
+}
+
 void AnalyzerBeats::cleanup() {
     m_pPlugin.reset();
 }
@@ -206,7 +244,14 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
     }
 
     BeatsPointer pBeats;
-    if (m_pPlugin->supportsBeatTracking()) {
+    if (m_quickAnalysis && m_pPlugin->supportsBeatTracking()) {
+        pBeats = makeQuickAnalysisBeats(*tio, m_pPlugin->getBeats());
+        if (!pBeats) {
+            qWarning() << "Quick beat/BPM analysis failed";
+            return;
+        }
+        qDebug() << "AnalyzerBeats quick analysis detected BPM:" << pBeats->getBpm();
+    } else if (m_pPlugin->supportsBeatTracking()) {
         QVector<double> beats = m_pPlugin->getBeats();
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
                 m_pluginId, m_bPreferencesFastAnalysis);
@@ -226,6 +271,18 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
         float bpm = m_pPlugin->getBpm();
         qDebug() << "AnalyzerBeats plugin detected constant BPM: " << bpm;
         pBeats = BeatFactory::makeBeatGrid(*tio, bpm, 0.0f);
+        if (m_quickAnalysis) {
+            // Mark the grid as provisional
+            QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
+                    m_pluginId, m_bPreferencesFastAnalysis);
+            pBeats.staticCast<BeatGrid>()->setSubVersion(
+                    BeatFactory::getPreferredSubVersion(
+                            m_bPreferencesFixedTempo,
+                            m_bPreferencesOffsetCorrection,
+                            m_iMinBpm,
+                            m_iMaxBpm,
+                            extraVersionInfo));
+        }
     }
 
     BeatsPointer pCurrentBeats = tio->getBeats();
@@ -247,7 +304,9 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
     // If the user prefers to replace old beatgrids with newly generated ones or
     // the old beatgrid has 0-bpm then we replace it.
     bool zeroCurrentBpm = pCurrentBeats->getBpm() == 0.0;
-    if (m_bPreferencesReanalyzeOldBpm || zeroCurrentBpm) {
+    bool provisionalCurrentBeats =
+            mixxx::isQuickAnalysisSubVersion(pCurrentBeats->getSubVersion());
+    if (m_bPreferencesReanalyzeOldBpm || zeroCurrentBpm || provisionalCurrentBeats) {
         if (zeroCurrentBpm) {
             qDebug() << "Replacing 0-BPM beatgrid with a" << pBeats->getBpm()
                      << "beatgrid.";
@@ -265,12 +324,66 @@ void AnalyzerBeats::storeResults(TrackPointer tio) {
     }
 }
 
-// static
+// The beats of the windows of a quick analysis are detected one after
+// another. The tempo is estimated for each window, so that the gaps between
+// the windows don't distort it. The grid is aligned to the beats of the
+// window with the median tempo.
+BeatsPointer AnalyzerBeats::makeQuickAnalysisBeats(
+        const Track& track, const QVector<double>& beats) const {
+    std::vector<QVector<double>> windowBeats(m_quickAnalysisFrameRanges.size());
+    for (const double beat : beats) {
+        const double position = mixxx::quickAnalysisTrackFramePosition(
+                m_quickAnalysisFrameRanges, beat);
+        std::size_t window = 0;
+        while (window + 1 < m_quickAnalysisFrameRanges.size() &&
+                position >= m_quickAnalysisFrameRanges[window].end()) {
+            ++window;
+        }
+        windowBeats[window].append(position);
+    }
+
+    std::vector<std::pair<double, std::size_t>> windowBpms;
+    for (std::size_t window = 0; window < windowBeats.size(); ++window) {
+        const double bpm = BeatUtils::calculateBpm(
+                windowBeats[window], m_iSampleRate, m_iMinBpm, m_iMaxBpm);
+        if (bpm > 0) {
+            windowBpms.emplace_back(bpm, window);
+        }
+    }
+    if (windowBpms.empty()) {
+        return BeatsPointer();
+    }
+    std::sort(windowBpms.begin(), windowBpms.end());
+    const auto medianBpm = windowBpms[windowBpms.size() / 2];
+
+    // The first beat is extrapolated from the window to the start of the track
+    const double firstBeat = BeatUtils::calculateFixedTempoFirstBeat(
+            true,
+            windowBeats[medianBpm.second],
+            m_iSampleRate,
+            m_iTotalSamples,
+            medianBpm.first);
+    // firstBeat is in frames here and makeBeatGrid() takes samples.
+    BeatsPointer pBeats = BeatFactory::makeBeatGrid(
+            track, medianBpm.first, firstBeat * 2);
+    pBeats.staticCast<BeatGrid>()->setSubVersion(
+            BeatFactory::getPreferredSubVersion(
+                    true,
+                    true,
+                    m_iMinBpm,
+                    m_iMaxBpm,
+                    getExtraVersionInfo(m_pluginId, m_bPreferencesFastAnalysis)));
+    return pBeats;
+}
+
 QHash<QString, QString> AnalyzerBeats::getExtraVersionInfo(
-        QString pluginId, bool bPreferencesFastAnalysis) {
+        QString pluginId, bool bPreferencesFastAnalysis) const {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
-    if (bPreferencesFastAnalysis) {
+    if (m_quickAnalysis) {
+        mixxx::addQuickAnalysisVersionInfo(
+                &extraVersionInfo, m_bQuickAnalysisReplayGain);
+    } else if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
     return extraVersionInfo;
@@ -10,35 +10,47 @@
 
 #include <QHash>
 #include <QList>
+#include <QVector>
+#include <vector>
 
 #include "analyzer/analyzer.h"
 #include "analyzer/plugins/analyzerplugin.h"
 #include "preferences/beatdetectionsettings.h"
 #include "preferences/usersettings.h"
+#include "util/indexrange.h"
 #include "util/memory.h"
 
 class AnalyzerBeats : public Analyzer {
   public:
     explicit AnalyzerBeats(
             UserSettingsPointer pConfig,
-            bool enforceBpmDetection = false);
+            bool enforceBpmDetection = false,
+            bool quickAnalysis = false);
     ~AnalyzerBeats() override = default;
 
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
 
     bool initialize(TrackPointer tio, int sampleRate, int totalSamples) override;
     bool processSamples(const CSAMPLE *pIn, const int iLen) override;
+    bool processFrames(const mixxx::AnalysisFrameBus& frameBus) override;
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
   private:
     bool shouldAnalyze(TrackPointer tio) const;
-    static QHash<QString, QString> getExtraVersionInfo(
-            QString pluginId, bool bPreferencesFastAnalysis);
+    QHash<QString, QString> getExtraVersionInfo(
+            QString pluginId, bool bPreferencesFastAnalysis) const;
+    BeatsPointer makeQuickAnalysisBeats(
+            const Track& track, const QVector<double>& beats) const;
 
     BeatDetectionSettings m_bpmSettings;
     std::unique_ptr<mixxx::AnalyzerBeatsPlugin> m_pPlugin;
     const bool m_enforceBpmDetection;
+    // The beat grid is detected in the sampled windows and mapped back to
+    // the positions in the track, see mixxx::quickAnalysisTrackFramePosition()
+    const bool m_quickAnalysis;
+    bool m_bQuickAnalysisReplayGain;
+    std::vector<mixxx::IndexRange> m_quickAnalysisFrameRanges;
     QString m_pluginId;
     bool m_bPreferencesReanalyzeOldBpm;
     bool m_bPreferencesFixedTempo;
@@ -2,6 +2,7 @@
 
 #include <QtDebug>
 
+#include "analyzer/quickanalysis.h"
 #include "track/track.h"
 #include "util/math.h"
 #include "util/sample.h"
@@ -11,8 +12,9 @@ namespace {
 const double kReplayGain2ReferenceLUFS = -18;
 } // anonymous namespace
 
-AnalyzerEbur128::AnalyzerEbur128(UserSettingsPointer pConfig)
+AnalyzerEbur128::AnalyzerEbur128(UserSettingsPointer pConfig, bool quickAnalysis)
         : m_rgSettings(pConfig),
+          m_quickAnalysis(quickAnalysis),
           m_pState(nullptr) {
 }
 
@@ -20,10 +22,21 @@ AnalyzerEbur128::~AnalyzerEbur128() {
     cleanup(); // ...to prevent memory leaks
 }
 
+bool AnalyzerEbur128::isAnalyzerDisabled(TrackPointer tio) const {
+    if (m_quickAnalysis) {
+        // Never replace a ReplayGain with a provisional one
+        return !isEnabled(m_rgSettings) || tio->getReplayGain().hasRatio();
+    }
+    if (isEnabled(m_rgSettings) && mixxx::hasQuickAnalysisReplayGain(tio)) {
+        return false;
+    }
+    return m_rgSettings.isAnalyzerDisabled(2, tio);
+}
+
 bool AnalyzerEbur128::initialize(TrackPointer tio,
         int sampleRate,
         int totalSamples) {
-    if (m_rgSettings.isAnalyzerDisabled(2, tio) || totalSamples == 0) {
+    if (isAnalyzerDisabled(tio) || totalSamples == 0) {
         qDebug() << "Skipping AnalyzerEbur128";
         return false;
     }
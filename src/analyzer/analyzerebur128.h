@@ -8,7 +8,7 @@
 
 class AnalyzerEbur128 : public Analyzer {
   public:
-    AnalyzerEbur128(UserSettingsPointer pConfig);
+    AnalyzerEbur128(UserSettingsPointer pConfig, bool quickAnalysis = false);
     virtual ~AnalyzerEbur128();
 
     static bool isEnabled(const ReplayGainSettings& rgSettings) {
@@ -21,7 +21,12 @@ class AnalyzerEbur128 : public Analyzer {
     void cleanup() override;
 
   private:
+    bool isAnalyzerDisabled(TrackPointer tio) const;
+
     ReplayGainSettings m_rgSettings;
+    // The integrated loudness of the sampled windows is an estimate for
+    // the whole track that never replaces an existing ReplayGain
+    const bool m_quickAnalysis;
     ebur128_state* m_pState;
 };
 
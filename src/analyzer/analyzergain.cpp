@@ -2,13 +2,15 @@
 #include <QtDebug>
 
 #include "analyzer/analyzergain.h"
+#include "analyzer/quickanalysis.h"
 #include "track/track.h"
 #include "util/math.h"
 #include "util/sample.h"
 #include "util/timer.h"
 
-AnalyzerGain::AnalyzerGain(UserSettingsPointer pConfig)
+AnalyzerGain::AnalyzerGain(UserSettingsPointer pConfig, bool quickAnalysis)
         : m_rgSettings(pConfig),
+          m_quickAnalysis(quickAnalysis),
           m_pLeftTempBuffer(NULL),
           m_pRightTempBuffer(NULL),
           m_iBufferSize(0) {
@@ -21,8 +23,19 @@ AnalyzerGain::~AnalyzerGain() {
     delete m_pReplayGain;
 }
 
+bool AnalyzerGain::isAnalyzerDisabled(TrackPointer tio) const {
+    if (m_quickAnalysis) {
+        // Never replace a ReplayGain with a provisional one
+        return !isEnabled(m_rgSettings) || tio->getReplayGain().hasRatio();
+    }
+    if (isEnabled(m_rgSettings) && mixxx::hasQuickAnalysisReplayGain(tio)) {
+        return false;
+    }
+    return m_rgSettings.isAnalyzerDisabled(1, tio);
+}
+
 bool AnalyzerGain::initialize(TrackPointer tio, int sampleRate, int totalSamples) {
-    if (m_rgSettings.isAnalyzerDisabled(1, tio) || totalSamples == 0) {
+    if (isAnalyzerDisabled(tio) || totalSamples == 0) {
         qDebug() << "Skipping AnalyzerGain";
         return false;
     }
@@ -15,7 +15,7 @@ class ReplayGain;
 
 class AnalyzerGain : public Analyzer {
   public:
-    AnalyzerGain(UserSettingsPointer pConfig);
+    AnalyzerGain(UserSettingsPointer pConfig, bool quickAnalysis = false);
     virtual ~AnalyzerGain();
 
     static bool isEnabled(const ReplayGainSettings& rgSettings) {
@@ -28,7 +28,12 @@ class AnalyzerGain : public Analyzer {
     void cleanup() override;
 
   private:
+    bool isAnalyzerDisabled(TrackPointer tio) const;
+
     ReplayGainSettings m_rgSettings;
+    // Only the sampled windows contribute to the ReplayGain 1.0 loudness.
+    // Tracks that already have a ReplayGain are skipped.
+    const bool m_quickAnalysis;
     CSAMPLE* m_pLeftTempBuffer;
     CSAMPLE* m_pRightTempBuffer;
     ReplayGain* m_pReplayGain;
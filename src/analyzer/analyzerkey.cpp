@@ -5,6 +5,7 @@
 
 #include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "analyzer/quickanalysis.h"
 #include "proto/keys.pb.h"
 #include "track/keyfactory.h"
 
@@ -16,8 +17,10 @@ QList<mixxx::AnalyzerPluginInfo> AnalyzerKey::availablePlugins() {
     return analyzers;
 }
 
-AnalyzerKey::AnalyzerKey(KeyDetectionSettings keySettings)
+AnalyzerKey::AnalyzerKey(KeyDetectionSettings keySettings, bool quickAnalysis)
         : m_keySettings(keySettings),
+          m_quickAnalysis(quickAnalysis),
+          m_bQuickAnalysisReplayGain(false),
           m_iSampleRate(0),
           m_iTotalSamples(0),
           m_iMaxSamplesToProcess(0),
@@ -55,13 +58,21 @@ bool AnalyzerKey::initialize(TrackPointer tio, int sampleRate, int totalSamples)
     qDebug() << "AnalyzerKey preference settings:"
              << "\nPlugin:" << m_pluginId
              << "\nRe-analyze when settings change:" << m_bPreferencesReanalyzeEnabled
-             << "\nFast analysis:" << m_bPreferencesFastAnalysisEnabled;
+             << "\nFast analysis:" << m_bPreferencesFastAnalysisEnabled
+             << "\nQuick analysis:" << m_quickAnalysis;
 
     m_iSampleRate = sampleRate;
     m_iTotalSamples = totalSamples;
     // In fast analysis mode, skip processing after
-    // kFastAnalysisSecondsToAnalyze seconds are analyzed.
-    if (m_bPreferencesFastAnalysisEnabled) {
+    // kFastAnalysisSecondsToAnalyze seconds are analyzed. In quick analysis
+    // mode, only the windows of the track are received.
+    if (m_quickAnalysis) {
+        m_iMaxSamplesToProcess = m_iTotalSamples;
+        m_bQuickAnalysisReplayGain = !tio->getReplayGain().hasRatio();
+        m_quickAnalysisFrameRanges = mixxx::quickAnalysisFrameRanges(
+                mixxx::IndexRange::forward(0, m_iTotalSamples / mixxx::kAnalysisChannels),
+                m_iSampleRate);
+    } else if (m_bPreferencesFastAnalysisEnabled) {
         m_iMaxSamplesToProcess = mixxx::kFastAnalysisSecondsToAnalyze * m_iSampleRate * mixxx::kAnalysisChannels;
     } else {
         m_iMaxSamplesToProcess = m_iTotalSamples;
@@ -105,6 +116,16 @@ bool AnalyzerKey::shouldAnalyze(TrackPointer tio) const {
         QString version = keys.getVersion();
         QString subVersion = keys.getSubVersion();
 
+        if (m_quickAnalysis) {
+            qDebug() << "Track has previous key detection result. Not replacing"
+                     << "it with a provisional one.";
+            return false;
+        }
+        if (mixxx::isQuickAnalysisSubVersion(subVersion)) {
+            qDebug() << "Replacing the provisional keys of a quick analysis.";
+            return true;
+        }
+
         QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
                 pluginID, bPreferencesFastAnalysisEnabled);
         QString newVersion = KeyFactory::getPreferredVersion();
@@ -139,6 +160,19 @@ bool AnalyzerKey::processSamples(const CSAMPLE *pIn, const int iLen) {
     return m_pPlugin->processSamples(pIn, iLen);
 }
 
+bool AnalyzerKey::processFrames(const mixxx::AnalysisFrameBus& frameBus) {
+    VERIFY_OR_DEBUG_ASSERT(m_pPlugin) {
+        return false;
+    }
+
+    m_iCurrentSample += frameBus.stereoLength();
+    if (m_iCurrentSample > m_iMaxSamplesToProcess) {
+        return true; // silently ignore remaining samples
+    }
+
+    return m_pPlugin->processFrames(frameBus);
+}
+
 void AnalyzerKey::cleanup() {
     m_pPlugin.reset();
 }
@@ -154,6 +188,14 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
     }
 
     KeyChangeList key_changes = m_pPlugin->getKeyChanges();
+    if (m_quickAnalysis) {
+        // Each key lasts until the next change, including the gaps
+        // between the windows
+        for (auto& key_change : key_changes) {
+            key_change.second = mixxx::quickAnalysisTrackFramePosition(
+                    m_quickAnalysisFrameRanges, key_change.second);
+        }
+    }
     QHash<QString, QString> extraVersionInfo = getExtraVersionInfo(
             m_pluginId, m_bPreferencesFastAnalysisEnabled);
     Keys track_keys = KeyFactory::makePreferredKeys(
@@ -161,12 +203,14 @@ void AnalyzerKey::storeResults(TrackPointer tio) {
     tio->setKeys(track_keys);
 }
 
-// static
 QHash<QString, QString> AnalyzerKey::getExtraVersionInfo(
-        QString pluginId, bool bPreferencesFastAnalysis) {
+        QString pluginId, bool bPreferencesFastAnalysis) const {
     QHash<QString, QString> extraVersionInfo;
     extraVersionInfo["vamp_plugin_id"] = pluginId;
-    if (bPreferencesFastAnalysis) {
+    if (m_quickAnalysis) {
+        mixxx::addQuickAnalysisVersionInfo(
+                &extraVersionInfo, m_bQuickAnalysisReplayGain);
+    } else if (bPreferencesFastAnalysis) {
         extraVersionInfo["fast_analysis"] = "1";
     }
     return extraVersionInfo;
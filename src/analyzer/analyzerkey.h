@@ -4,33 +4,43 @@
 #include <QHash>
 #include <QList>
 #include <QString>
+#include <vector>
 
 #include "analyzer/analyzer.h"
 #include "analyzer/plugins/analyzerplugin.h"
 #include "preferences/keydetectionsettings.h"
 #include "preferences/usersettings.h"
 #include "track/track.h"
+#include "util/indexrange.h"
 #include "util/memory.h"
 
 class AnalyzerKey : public Analyzer {
   public:
-    explicit AnalyzerKey(KeyDetectionSettings keySettings);
+    explicit AnalyzerKey(
+            KeyDetectionSettings keySettings,
+            bool quickAnalysis = false);
     ~AnalyzerKey() override = default;
 
     static QList<mixxx::AnalyzerPluginInfo> availablePlugins();
 
     bool initialize(TrackPointer tio, int sampleRate, int totalSamples) override;
     bool processSamples(const CSAMPLE *pIn, const int iLen) override;
+    bool processFrames(const mixxx::AnalysisFrameBus& frameBus) override;
     void storeResults(TrackPointer tio) override;
     void cleanup() override;
 
   private:
-    static QHash<QString, QString> getExtraVersionInfo(
-            QString pluginId, bool bPreferencesFastAnalysis);
+    QHash<QString, QString> getExtraVersionInfo(
+            QString pluginId, bool bPreferencesFastAnalysis) const;
 
     bool shouldAnalyze(TrackPointer tio) const;
 
     KeyDetectionSettings m_keySettings;
+    // The key changes of the sampled windows last until the next change,
+    // including the gaps between the windows
+    const bool m_quickAnalysis;
+    bool m_bQuickAnalysisReplayGain;
+    std::vector<mixxx::IndexRange> m_quickAnalysisFrameRanges;
     std::unique_ptr<mixxx::AnalyzerKeyPlugin> m_pPlugin;
     QString m_pluginId;
     int m_iSampleRate;
@@ -1,5 +1,6 @@
 #include "analyzer/analyzerthread.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include "analyzer/analyzerbeats.h"
@@ -9,6 +10,7 @@
 #include "analyzer/analyzersilence.h"
 #include "analyzer/analyzerwaveform.h"
 #include "analyzer/constants.h"
+#include "analyzer/quickanalysis.h"
 
 #include "library/dao/analysisdao.h"
 
@@ -20,6 +22,7 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/logger.h"
+#include "util/performancetimer.h"
 #include "util/timer.h"
 
 namespace {
@@ -44,6 +47,26 @@ void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     }
 }
 
+// The frames of the track that are decoded and analyzed in this order
+std::vector<mixxx::IndexRange> analysisFrameRanges(
+        const mixxx::AudioSourcePointer& audioSource,
+        AnalyzerModeFlags modeFlags) {
+    if (modeFlags & AnalyzerModeFlags::Quick) {
+        return mixxx::quickAnalysisFrameRanges(
+                audioSource->frameIndexRange(),
+                audioSource->getSignalInfo().getSampleRate());
+    }
+    return {audioSource->frameIndexRange()};
+}
+
+SINT framesToAnalyze(const std::vector<mixxx::IndexRange>& frameRanges) {
+    SINT frames = 0;
+    for (const auto& frameRange : frameRanges) {
+        frames += frameRange.length();
+    }
+    return frames;
+}
+
 std::once_flag registerMetaTypesOnceFlag;
 
 void registerMetaTypesOnce() {
@@ -51,6 +74,7 @@ void registerMetaTypesOnce() {
     // AnalyzerProgress is just an alias/typedef and must be registered explicitly
     // by name!
     qRegisterMetaType<AnalyzerProgress>("AnalyzerProgress");
+    qRegisterMetaType<mixxx::TrackAnalysisStatistics>();
 }
 
 } // anonymous namespace
@@ -84,7 +108,10 @@ AnalyzerThread::AnalyzerThread(
           m_pConfig(pConfig),
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
+          m_beatsAnalyzerIndex(0),
+          m_keysAnalyzerIndex(0),
           m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
+          m_frameBus(mixxx::kAnalysisFramesPerChunk),
           m_emittedState(AnalyzerThreadState::Void) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
@@ -95,7 +122,13 @@ void AnalyzerThread::doRun() {
     // before returning from this function.
     mixxx::DbConnectionPooler dbConnectionPooler;
 
-    if (m_modeFlags & AnalyzerModeFlags::WithWaveform) {
+    const bool quickAnalysis = (m_modeFlags & AnalyzerModeFlags::Quick) != 0;
+    // The waveforms and the silence at the end of the track need the whole
+    // track
+    const bool withWaveform =
+            (m_modeFlags & AnalyzerModeFlags::WithWaveform) && !quickAnalysis;
+    const bool reuseAnalysis = mixxx::AnalysisReuse::isEnabled(m_pConfig);
+    if (withWaveform || reuseAnalysis) {
         dbConnectionPooler = mixxx::DbConnectionPooler(m_dbConnectionPool); // move assignment
         if (!dbConnectionPooler.isPooling()) {
             kLogger.warning()
@@ -103,20 +136,29 @@ void AnalyzerThread::doRun() {
             return;
         }
         QSqlDatabase dbConnection = mixxx::DbConnectionPooled(m_dbConnectionPool);
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        if (withWaveform) {
+            m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerWaveform>(m_pConfig, dbConnection)));
+        }
+        if (reuseAnalysis) {
+            m_pAnalysisReuse = std::make_unique<mixxx::AnalysisReuse>(dbConnection);
+        }
     }
     if (AnalyzerGain::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerGain>(m_pConfig, quickAnalysis)));
     }
     if (AnalyzerEbur128::isEnabled(ReplayGainSettings(m_pConfig))) {
-        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig)));
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerEbur128>(m_pConfig, quickAnalysis)));
     }
     // BPM detection might be disabled in the config, but can be overridden
     // and enabled by explicitly setting the mode flag.
     const bool enforceBpmDetection = (m_modeFlags & AnalyzerModeFlags::WithBeats) != 0;
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig)));
-    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
+    m_beatsAnalyzerIndex = m_analyzers.size();
+    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerBeats>(m_pConfig, enforceBpmDetection, quickAnalysis)));
+    m_keysAnalyzerIndex = m_analyzers.size();
+    m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerKey>(m_pConfig, quickAnalysis)));
+    if (!quickAnalysis) {
+        m_analyzers.push_back(AnalyzerWithState(std::make_unique<AnalyzerSilence>(m_pConfig)));
+    }
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
 
@@ -140,16 +182,60 @@ void AnalyzerThread::doRun() {
             continue;
         }
 
-        bool processTrack = false;
-        for (auto&& analyzer : m_analyzers) {
-            // Make sure not to short-circuit initialize(...)
-            if (analyzer.initialize(
-                        m_currentTrack,
-                        audioSource->getSignalInfo().getSampleRate(),
-                        audioSource->frameLength() * mixxx::kAnalysisChannels)) {
-                processTrack = true;
+        PerformanceTimer analysisTimer;
+        analysisTimer.start();
+        const double audioSeconds =
+                double(framesToAnalyze(analysisFrameRanges(audioSource, m_modeFlags))) /
+                audioSource->getSignalInfo().getSampleRate();
+
+        bool processTrack = initializeAnalyzers(audioSource);
+
+        mixxx::TrackAnalysisStatistics statistics;
+        statistics.audioSeconds = audioSeconds;
+
+        // If results are missing the results of a track with the same
+        // audio are copied to the current track and the analyzers decide
+        // again what is missing. The waveform and ReplayGain are never
+        // reused, so the track is usually still decoded without the beat
+        // and key analyzers. Tracks that have been analyzed before
+        // fingerprints were stored only get theirs when they are visited
+        // again, e.g. when loaded into a deck, and are reuse sources from
+        // then on.
+        if (m_pAnalysisReuse &&
+                (processTrack ||
+                        !m_pAnalysisReuse->hasAudioFingerprint(
+                                m_currentTrack->getId()))) {
+            const auto audioFingerprint =
+                    mixxx::AnalysisReuse::computeAudioFingerprint(
+                            audioSource, &m_sampleBuffer);
+            bool reusedResults = false;
+            if (audioFingerprint != mixxx::kInvalidAudioFingerprint) {
+                m_pAnalysisReuse->storeAudioFingerprint(
+                        m_currentTrack->getId(), audioFingerprint);
+                reusedResults = processTrack &&
+                        m_pAnalysisReuse->reuseAnalysisResults(
+                                m_currentTrack, audioFingerprint);
+            }
+            if (reusedResults) {
+                // Only the beat and key analyzers decide again. The others
+                // would find their own empty results, e.g. the waveform,
+                // in the track and skip it.
+                statistics.beatsReused =
+                        reinitializeReusedAnalyzer(
+                                &m_analyzers[m_beatsAnalyzerIndex], audioSource);
+                statistics.keysReused =
+                        reinitializeReusedAnalyzer(
+                                &m_analyzers[m_keysAnalyzerIndex], audioSource);
+                processTrack = std::any_of(
+                        m_analyzers.begin(),
+                        m_analyzers.end(),
+                        [](const AnalyzerWithState& analyzer) {
+                            return analyzer.isActive();
+                        });
             }
         }
+        statistics.beatsAnalyzed = m_analyzers[m_beatsAnalyzerIndex].isActive();
+        statistics.keysAnalyzed = m_analyzers[m_keysAnalyzerIndex].isActive();
 
         if (processTrack) {
             const auto analysisResult = analyzeAudioSource(audioSource);
@@ -166,6 +252,18 @@ void AnalyzerThread::doRun() {
                 for (auto&& analyzer : m_analyzers) {
                     analyzer.finish(m_currentTrack);
                 }
+                statistics.analyzed = true;
+                statistics.analysisSeconds =
+                        analysisTimer.elapsed().toDoubleSeconds();
+                statistics.beatsAnalysisSeconds =
+                        m_analyzers[m_beatsAnalyzerIndex]
+                                .processingDuration()
+                                .toDoubleSeconds();
+                statistics.keysAnalysisSeconds =
+                        m_analyzers[m_keysAnalyzerIndex]
+                                .processingDuration()
+                                .toDoubleSeconds();
+                emit analysisStatistics(m_id, statistics);
                 emitDoneProgress(kAnalyzerProgressDone);
             } else {
                 for (auto&& analyzer : m_analyzers) {
@@ -175,6 +273,9 @@ void AnalyzerThread::doRun() {
             }
         } else {
             kLogger.debug() << "Skipping track analysis because no analyzer initialized.";
+            if (statistics.isReused()) {
+                emit analysisStatistics(m_id, statistics);
+            }
             emitDoneProgress(kAnalyzerProgressDone);
         }
     }
@@ -182,11 +283,40 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(isStopping());
 
     m_analyzers.clear();
+    m_pAnalysisReuse.reset();
 
     kLogger.debug() << "Exiting worker thread";
     emitProgress(AnalyzerThreadState::Exit);
 }
 
+bool AnalyzerThread::initializeAnalyzers(
+        const mixxx::AudioSourcePointer& audioSource) {
+    bool processTrack = false;
+    for (auto&& analyzer : m_analyzers) {
+        // Make sure not to short-circuit initialize(...)
+        if (analyzer.initialize(
+                    m_currentTrack,
+                    audioSource->getSignalInfo().getSampleRate(),
+                    audioSource->frameLength() * mixxx::kAnalysisChannels)) {
+            processTrack = true;
+        }
+    }
+    return processTrack;
+}
+
+bool AnalyzerThread::reinitializeReusedAnalyzer(
+        AnalyzerWithState* pAnalyzer,
+        const mixxx::AudioSourcePointer& audioSource) {
+    if (!pAnalyzer->isActive()) {
+        // Nothing was missing
+        return false;
+    }
+    return !pAnalyzer->reinitialize(
+            m_currentTrack,
+            audioSource->getSignalInfo().getSampleRate(),
+            audioSource->frameLength() * mixxx::kAnalysisChannels);
+}
+
 bool AnalyzerThread::submitNextTrack(TrackPointer nextTrack) {
     DEBUG_ASSERT(nextTrack);
     kLogger.debug()
@@ -232,96 +362,109 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
 
     // Analysis starts now
     emitBusyProgress(kAnalyzerProgressNone);
+    m_frameBus.reset();
+
+    const auto frameRanges = analysisFrameRanges(audioSource, m_modeFlags);
+    const SINT framesToAnalyze = ::framesToAnalyze(frameRanges);
+    SINT analyzedFrames = 0;
+    for (const auto& frameRange : frameRanges) {
+        // The windows of a quick analysis usually end before the audio source
+        const bool toEndOfAudioSource =
+                frameRange.end() == audioSource->frameIndexRange().end();
+        mixxx::IndexRange remainingFrameRange =
+                intersect(frameRange, audioSourceProxy.frameIndexRange());
+        while (!remainingFrameRange.empty()) {
+            sleepWhileSuspended();
+            if (isStopping()) {
+                return AnalysisResult::Cancelled;
+            }
 
-    mixxx::IndexRange remainingFrameRange = audioSource->frameIndexRange();
-    while (!remainingFrameRange.empty()) {
-        sleepWhileSuspended();
-        if (isStopping()) {
-            return AnalysisResult::Cancelled;
-        }
-
-        // 1st step: Decode next chunk of audio data
-
-        // Split the range for the next chunk from the remaining (= to-be-analyzed) frames
-        auto chunkFrameRange =
-                remainingFrameRange.splitAndShrinkFront(
-                        math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
-        DEBUG_ASSERT(!chunkFrameRange.empty());
-
-        // Request the next chunk of audio data
-        const auto readableSampleFrames =
-                audioSourceProxy.readSampleFrames(
-                        mixxx::WritableSampleFrames(
-                                chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
-        // The returned range fits into the requested range
-        DEBUG_ASSERT(readableSampleFrames.frameIndexRange() <= chunkFrameRange);
-
-        // Sometimes the duration of the audio source is inaccurate and adjusted
-        // while reading. We need to adjust all frame ranges to reflect this new
-        // situation by restoring all invariants and consistency requirements!
-
-        // Shrink the original range of the current chunks to the actual available
-        // range.
-        chunkFrameRange = intersect(chunkFrameRange, audioSourceProxy.frameIndexRange());
-        // The audio data that has just been read should still fit into the adjusted
-        // chunk range.
-        DEBUG_ASSERT(readableSampleFrames.frameIndexRange() <= chunkFrameRange);
-
-        // We also need to adjust the remaining frame range for the next requests.
-        remainingFrameRange = intersect(remainingFrameRange, audioSourceProxy.frameIndexRange());
-        // Currently the range will never grow, but lets also account for this case
-        // that might become relevant in the future.
-        VERIFY_OR_DEBUG_ASSERT(remainingFrameRange.empty() ||
-                remainingFrameRange.end() == audioSourceProxy.frameIndexRange().end()) {
-            if (chunkFrameRange.length() < mixxx::kAnalysisFramesPerChunk) {
-                // If we have read an incomplete chunk while the range has grown
-                // we need to discard the read results and re-read the current
-                // chunk!
-                remainingFrameRange = span(remainingFrameRange, chunkFrameRange);
-                continue;
+            // 1st step: Decode next chunk of audio data
+
+            // Split the range for the next chunk from the remaining (= to-be-analyzed) frames
+            auto chunkFrameRange =
+                    remainingFrameRange.splitAndShrinkFront(
+                            math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
+            DEBUG_ASSERT(!chunkFrameRange.empty());
+
+            // Request the next chunk of audio data
+            const auto readableSampleFrames =
+                    audioSourceProxy.readSampleFrames(
+                            mixxx::WritableSampleFrames(
+                                    chunkFrameRange,
+                                    mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+            // The returned range fits into the requested range
+            DEBUG_ASSERT(readableSampleFrames.frameIndexRange() <= chunkFrameRange);
+
+            // Sometimes the duration of the audio source is inaccurate and adjusted
+            // while reading. We need to adjust all frame ranges to reflect this new
+            // situation by restoring all invariants and consistency requirements!
+
+            // Shrink the original range of the current chunks to the actual available
+            // range.
+            chunkFrameRange = intersect(chunkFrameRange, audioSourceProxy.frameIndexRange());
+            // The audio data that has just been read should still fit into the adjusted
+            // chunk range.
+            DEBUG_ASSERT(readableSampleFrames.frameIndexRange() <= chunkFrameRange);
+
+            // We also need to adjust the remaining frame range for the next requests.
+            remainingFrameRange = intersect(remainingFrameRange, audioSourceProxy.frameIndexRange());
+            // Currently the range will never grow, but lets also account for this case
+            // that might become relevant in the future.
+            VERIFY_OR_DEBUG_ASSERT(!toEndOfAudioSource ||
+                    remainingFrameRange.empty() ||
+                    remainingFrameRange.end() == audioSourceProxy.frameIndexRange().end()) {
+                if (chunkFrameRange.length() < mixxx::kAnalysisFramesPerChunk) {
+                    // If we have read an incomplete chunk while the range has grown
+                    // we need to discard the read results and re-read the current
+                    // chunk!
+                    remainingFrameRange = span(remainingFrameRange, chunkFrameRange);
+                    continue;
+                }
+                DEBUG_ASSERT(remainingFrameRange.end() < audioSourceProxy.frameIndexRange().end());
+                kLogger.warning()
+                        << "Unexpected growth of the audio source while reading"
+                        << mixxx::IndexRange::forward(
+                                remainingFrameRange.end(), audioSourceProxy.frameIndexRange().end());
+                remainingFrameRange.growBack(
+                        audioSourceProxy.frameIndexRange().end() - remainingFrameRange.end());
             }
-            DEBUG_ASSERT(remainingFrameRange.end() < audioSourceProxy.frameIndexRange().end());
-            kLogger.warning()
-                    << "Unexpected growth of the audio source while reading"
-                    << mixxx::IndexRange::forward(
-                            remainingFrameRange.end(), audioSourceProxy.frameIndexRange().end());
-            remainingFrameRange.growBack(
-                    audioSourceProxy.frameIndexRange().end() - remainingFrameRange.end());
-        }
+            analyzedFrames += chunkFrameRange.length();
 
-        sleepWhileSuspended();
-        if (isStopping()) {
-            return AnalysisResult::Cancelled;
-        }
+            sleepWhileSuspended();
+            if (isStopping()) {
+                return AnalysisResult::Cancelled;
+            }
 
-        // 2nd: step: Analyze chunk of decoded audio data
-        if (!readableSampleFrames.frameIndexRange().empty()) {
-            for (auto&& analyzer : m_analyzers) {
-                analyzer.processSamples(
+            // 2nd: step: Analyze chunk of decoded audio data
+            if (!readableSampleFrames.frameIndexRange().empty()) {
+                // The decoded chunk is shared by all analyzers
+                m_frameBus.publish(
                         readableSampleFrames.readableData(),
-                        readableSampleFrames.readableLength());
+                        readableSampleFrames.frameIndexRange().length());
+                for (auto&& analyzer : m_analyzers) {
+                    analyzer.processFrames(m_frameBus);
+                }
             }
-        }
 
-        // Don't check again for paused/stopped again and simply finish
-        // the current iteration by emitting progress.
-
-        // 3rd step: Update & emit progress
-        if (audioSource->frameLength() > 0) {
-            const double frameProgress =
-                    double(audioSource->frameLength() - remainingFrameRange.length()) /
-                    double(audioSource->frameLength());
-            const AnalyzerProgress progress =
-                    frameProgress *
-                    (kAnalyzerProgressFinalizing - kAnalyzerProgressNone);
-            DEBUG_ASSERT(progress > kAnalyzerProgressNone);
-            DEBUG_ASSERT(progress <= kAnalyzerProgressFinalizing);
-            emitBusyProgress(progress);
-        } else {
-            // Unreadable audio source
-            DEBUG_ASSERT(remainingFrameRange.empty());
-            emitBusyProgress(kAnalyzerProgressUnknown);
+            // Don't check again for paused/stopped again and simply finish
+            // the current iteration by emitting progress.
+
+            // 3rd step: Update & emit progress
+            if (framesToAnalyze > 0) {
+                const double frameProgress = math_min(1.0,
+                        double(analyzedFrames) / double(framesToAnalyze));
+                const AnalyzerProgress progress =
+                        frameProgress *
+                        (kAnalyzerProgressFinalizing - kAnalyzerProgressNone);
+                DEBUG_ASSERT(progress >= kAnalyzerProgressNone);
+                DEBUG_ASSERT(progress <= kAnalyzerProgressFinalizing);
+                emitBusyProgress(progress);
+            } else {
+                // Unreadable audio source
+                DEBUG_ASSERT(remainingFrameRange.empty());
+                emitBusyProgress(kAnalyzerProgressUnknown);
+            }
         }
     }
 
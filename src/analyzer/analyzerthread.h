@@ -4,6 +4,8 @@
 
 #include "rigtorp/SPSCQueue.h"
 
+#include "analyzer/analysisframebus.h"
+#include "analyzer/analysisreuse.h"
 #include "analyzer/analyzer.h"
 #include "analyzer/analyzerprogress.h"
 #include "preferences/usersettings.h"
@@ -20,6 +22,9 @@ enum AnalyzerModeFlags {
     WithBeats = 0x01,
     WithWaveform = 0x02,
     All = WithBeats | WithWaveform,
+    // Provisional BPM, key and ReplayGain from a few windows of the track
+    // without waveforms, see analyzer/quickanalysis.h
+    Quick = 0x04,
 };
 
 enum class AnalyzerThreadState {
@@ -85,6 +90,11 @@ class AnalyzerThread : public WorkerThread {
     // AnalyzerThreadProgress object and register it as a new meta type.
     void progress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress trackProgress);
 
+    // Emitted before the Done progress of a track that has been analyzed
+    // or whose analysis has been skipped entirely, because the results of
+    // a track with identical audio have been reused.
+    void analysisStatistics(int threadId, mixxx::TrackAnalysisStatistics statistics);
+
   protected:
     void doRun() override;
 
@@ -114,8 +124,14 @@ class AnalyzerThread : public WorkerThread {
     // run() by the worker thread.
 
     std::vector<AnalyzerWithState> m_analyzers;
+    // The analyzers whose results might be reused
+    std::size_t m_beatsAnalyzerIndex;
+    std::size_t m_keysAnalyzerIndex;
 
     mixxx::SampleBuffer m_sampleBuffer;
+    mixxx::AnalysisFrameBus m_frameBus;
+
+    std::unique_ptr<mixxx::AnalysisReuse> m_pAnalysisReuse;
 
     TrackPointer m_currentTrack;
 
@@ -131,6 +147,15 @@ class AnalyzerThread : public WorkerThread {
     AnalysisResult analyzeAudioSource(
             const mixxx::AudioSourcePointer& audioSource);
 
+    // Returns true if any analyzer needs to process the current track
+    bool initializeAnalyzers(
+            const mixxx::AudioSourcePointer& audioSource);
+    // Returns true if the analyzer was needed, but isn't anymore after
+    // results have been reused
+    bool reinitializeReusedAnalyzer(
+            AnalyzerWithState* pAnalyzer,
+            const mixxx::AudioSourcePointer& audioSource);
+
     // Blocks the worker thread until a next track becomes available
     TrackPointer receiveNextTrack();
 
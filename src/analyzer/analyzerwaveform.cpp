@@ -112,6 +112,11 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer tio) const {
                     pLoadedTrackWaveform = ConstWaveformPointer(
                             WaveformFactory::loadWaveformFromAnalysis(analysis));
                     missingWaveform = false;
+                } else if (missingWaveform && vc == WaveformFactory::VC_CONVERT) {
+                    pLoadedTrackWaveform = ConstWaveformPointer(
+                            WaveformFactory::convertWaveformFromAnalysis(
+                                    &m_analysisDao, analysis));
+                    missingWaveform = false;
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
                     m_analysisDao.deleteAnalysis(analysis.analysisId);
@@ -123,6 +128,11 @@ bool AnalyzerWaveform::shouldAnalyze(TrackPointer tio) const {
                     pLoadedTrackWaveformSummary = ConstWaveformPointer(
                             WaveformFactory::loadWaveformFromAnalysis(analysis));
                     missingWavesummary = false;
+                } else if (missingWavesummary && vc == WaveformFactory::VC_CONVERT) {
+                    pLoadedTrackWaveformSummary = ConstWaveformPointer(
+                            WaveformFactory::convertWaveformFromAnalysis(
+                                    &m_analysisDao, analysis));
+                    missingWavesummary = false;
                 } else if (vc != WaveformFactory::VC_KEEP) {
                     // remove all other Analysis except that one we should keep
                     m_analysisDao.deleteAnalysis(analysis.analysisId);
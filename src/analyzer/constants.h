@@ -5,15 +5,28 @@
 namespace mixxx {
 
 // Analysis is done in blocks to avoid dynamic allocation of memory
-// depending on the track length. A block size of 4096 frames per block
-// seems to do fine. Signal processing during analysis uses the same,
+// depending on the track length. Larger blocks amortize the per-block
+// overhead of the decoders and the analyzers, 16384 frames still fit
+// into the L2 cache. Signal processing during analysis uses the same,
 // fixed number of channels like the engine does, usually 2 = stereo.
 constexpr audio::ChannelCount kAnalysisChannels = mixxx::kEngineChannelCount;
-constexpr SINT kAnalysisFramesPerChunk = 4096;
+constexpr SINT kAnalysisFramesPerChunk = 16384;
 constexpr SINT kAnalysisSamplesPerChunk =
         kAnalysisFramesPerChunk * kAnalysisChannels;
 
+// The beat and key detectors analyze the mono downmix at a lower sample
+// rate that is still at or above these rates, see PolyphaseDecimator.
+// Onsets are detected from the content up to ~8 kHz, the chroma of the
+// key detector doesn't need more than ~3 kHz. 0 = no decimation.
+constexpr int kAnalysisBeatsTargetSampleRate = 22050;
+constexpr int kAnalysisKeyTargetSampleRate = 11025;
+
 // Only analyze the first minute in fast-analysis mode.
 constexpr int kFastAnalysisSecondsToAnalyze = 60;
 
+// Only decode and analyze a few windows spread across the track in
+// quick-analysis mode, see quickAnalysisFrameRanges().
+constexpr int kQuickAnalysisWindows = 3;
+constexpr int kQuickAnalysisSecondsPerWindow = 10;
+
 }  // namespace mixxx
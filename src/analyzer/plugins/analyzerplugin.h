@@ -3,6 +3,7 @@
 
 #include <QString>
 
+#include "analyzer/analysisframebus.h"
 #include "track/beats.h"
 #include "track/keys.h"
 #include "util/types.h"
@@ -42,6 +43,10 @@ class AnalyzerPlugin {
 
     virtual bool initialize(int samplerate) = 0;
     virtual bool processSamples(const CSAMPLE* pIn, const int iLen) = 0;
+    // Plugins that analyze a mono downmix take it from the frame bus
+    virtual bool processFrames(const AnalysisFrameBus& frameBus) {
+        return processSamples(frameBus.stereoData(), frameBus.stereoLength());
+    }
     virtual bool finalize() = 0;
 };
 
@@ -29,8 +29,12 @@ DFConfig makeDetectionFunctionConfig(int stepSize, int windowSize) {
 
 } // namespace
 
-AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats()
-        : m_iSampleRate(0) {
+AnalyzerQueenMaryBeats::AnalyzerQueenMaryBeats(int targetSampleRate)
+        : m_frameBus(kAnalysisFramesPerChunk),
+          m_targetSampleRate(targetSampleRate),
+          m_iSampleRate(0),
+          m_decimationFactor(1),
+          m_decimatedSampleRate(0.0) {
 }
 
 AnalyzerQueenMaryBeats::~AnalyzerQueenMaryBeats() {
@@ -39,12 +43,18 @@ AnalyzerQueenMaryBeats::~AnalyzerQueenMaryBeats() {
 bool AnalyzerQueenMaryBeats::initialize(int samplerate) {
     m_detectionResults.clear();
     m_iSampleRate = samplerate;
+    m_frameBus.reset();
+    m_decimationFactor = PolyphaseDecimator::factorForTargetSampleRate(
+            samplerate, m_targetSampleRate);
+    m_decimatedSampleRate = double(samplerate) / m_decimationFactor;
     // These are the preferred window/step sizes from the BeatTrack VAMP
-    m_stepSize = int(m_iSampleRate * kStepSecs + 0.0001);
+    m_stepSize = int(m_decimatedSampleRate * kStepSecs + 0.0001);
     m_windowSize = m_stepSize * 2;
     m_pDetectionFunction = std::make_unique<DetectionFunction>(
             makeDetectionFunctionConfig(m_stepSize, m_windowSize));
-    qDebug() << "input sample rate is " << m_iSampleRate << ", step size is " << m_stepSize;
+    qDebug() << "input sample rate is " << m_iSampleRate
+             << ", decimation factor is " << m_decimationFactor
+             << ", step size is " << m_stepSize;
 
     m_helper.initialize(
             m_windowSize, m_stepSize, [this](double* pWindow, size_t) {
@@ -62,7 +72,17 @@ bool AnalyzerQueenMaryBeats::processSamples(const CSAMPLE* pIn, const int iLen)
         return false;
     }
 
-    return m_helper.processStereoSamples(pIn, iLen);
+    m_frameBus.publish(pIn, iLen / kAnalysisChannels);
+    return processFrames(m_frameBus);
+}
+
+bool AnalyzerQueenMaryBeats::processFrames(const AnalysisFrameBus& frameBus) {
+    if (!m_pDetectionFunction) {
+        return false;
+    }
+
+    const auto decimated = frameBus.decimatedMonoData(m_decimationFactor);
+    return m_helper.processMonoSamples(decimated.data(), decimated.length());
 }
 
 bool AnalyzerQueenMaryBeats::finalize() {
@@ -87,16 +107,19 @@ bool AnalyzerQueenMaryBeats::finalize() {
         beatPeriod.push_back(0.0);
     }
 
-    TempoTrackV2 tt(m_iSampleRate, m_stepSize);
+    TempoTrackV2 tt(m_decimatedSampleRate, m_stepSize);
     tt.calculateBeatPeriod(df, beatPeriod, tempi);
 
     std::vector<double> beats;
     tt.calculateBeats(df, beatPeriod, beats);
 
+    // The beats are detected in the decimated signal that is delayed by
+    // the low-pass filter
+    const double delayFrames = PolyphaseDecimator::delayFrames(m_decimationFactor);
     m_resultBeats.reserve(beats.size());
     for (size_t i = 0; i < beats.size(); ++i) {
         double result = (beats.at(i) * m_stepSize) - m_stepSize / 2;
-        m_resultBeats.push_back(result);
+        m_resultBeats.push_back(result * m_decimationFactor - delayFrames);
     }
 
     m_pDetectionFunction.reset();
@@ -5,6 +5,7 @@
 
 #include <QObject>
 
+#include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerplugin.h"
 #include "analyzer/plugins/buffering_utils.h"
 #include "util/memory.h"
@@ -26,7 +27,10 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
                 true);
     }
 
-    AnalyzerQueenMaryBeats();
+    // The signal is analyzed at the lowest sample rate that is at or above
+    // the target sample rate
+    explicit AnalyzerQueenMaryBeats(
+            int targetSampleRate = kAnalysisBeatsTargetSampleRate);
     ~AnalyzerQueenMaryBeats() override;
 
     AnalyzerPluginInfo info() const override {
@@ -35,6 +39,7 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
 
     bool initialize(int samplerate) override;
     bool processSamples(const CSAMPLE* pIn, const int iLen) override;
+    bool processFrames(const AnalysisFrameBus& frameBus) override;
     bool finalize() override;
 
     bool supportsBeatTracking() const override {
@@ -48,7 +53,12 @@ class AnalyzerQueenMaryBeats : public AnalyzerBeatsPlugin {
   private:
     std::unique_ptr<DetectionFunction> m_pDetectionFunction;
     DownmixAndOverlapHelper m_helper;
+    // For samples that are not passed through a frame bus
+    AnalysisFrameBus m_frameBus;
+    const int m_targetSampleRate;
     int m_iSampleRate;
+    int m_decimationFactor;
+    double m_decimatedSampleRate;
     int m_windowSize;
     int m_stepSize;
     std::vector<double> m_detectionResults;
@@ -19,8 +19,11 @@ constexpr int kTuningFrequencyHertz = 440;
 
 } // namespace
 
-AnalyzerQueenMaryKey::AnalyzerQueenMaryKey()
-        : m_currentFrame(0),
+AnalyzerQueenMaryKey::AnalyzerQueenMaryKey(int targetSampleRate)
+        : m_frameBus(kAnalysisFramesPerChunk),
+          m_targetSampleRate(targetSampleRate),
+          m_decimationFactor(1),
+          m_currentFrame(0),
           m_prevKey(mixxx::track::io::key::INVALID) {
 }
 
@@ -31,6 +34,7 @@ bool AnalyzerQueenMaryKey::initialize(int samplerate) {
     m_prevKey = mixxx::track::io::key::INVALID;
     m_resultKeys.clear();
     m_currentFrame = 0;
+    m_frameBus.reset();
 
     struct Config {
         double sampleRate;
@@ -53,6 +57,16 @@ bool AnalyzerQueenMaryKey::initialize(int samplerate) {
     };
 
     GetKeyMode::Config config(samplerate, kTuningFrequencyHertz);
+    // GetKeyMode decimates the signal itself before computing the chroma.
+    // Only the remaining part of this decimation is done by GetKeyMode, so
+    // the chroma is computed at the same sample rate as before.
+    // Both factors are powers of two.
+    m_decimationFactor = math_min(
+            PolyphaseDecimator::factorForTargetSampleRate(
+                    samplerate, m_targetSampleRate),
+            config.decimationFactor);
+    config.sampleRate /= m_decimationFactor;
+    config.decimationFactor /= m_decimationFactor;
     m_pKeyMode = std::make_unique<GetKeyMode>(config);
     size_t windowSize = m_pKeyMode->getBlockSize();
     size_t stepSize = m_pKeyMode->getHopSize();
@@ -82,9 +96,18 @@ bool AnalyzerQueenMaryKey::processSamples(const CSAMPLE* pIn, const int iLen) {
         return false;
     }
 
-    const size_t numInputFrames = iLen / kAnalysisChannels;
-    m_currentFrame += numInputFrames;
-    return m_helper.processStereoSamples(pIn, iLen);
+    m_frameBus.publish(pIn, iLen / kAnalysisChannels);
+    return processFrames(m_frameBus);
+}
+
+bool AnalyzerQueenMaryKey::processFrames(const AnalysisFrameBus& frameBus) {
+    if (!m_pKeyMode) {
+        return false;
+    }
+
+    m_currentFrame += frameBus.frameLength();
+    const auto decimated = frameBus.decimatedMonoData(m_decimationFactor);
+    return m_helper.processMonoSamples(decimated.data(), decimated.length());
 }
 
 bool AnalyzerQueenMaryKey::finalize() {
@@ -5,6 +5,7 @@
 
 #include <QObject>
 
+#include "analyzer/constants.h"
 #include "analyzer/plugins/analyzerplugin.h"
 #include "analyzer/plugins/buffering_utils.h"
 #include "util/memory.h"
@@ -26,7 +27,10 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
                 false);
     }
 
-    AnalyzerQueenMaryKey();
+    // The signal is analyzed at the lowest sample rate that is at or above
+    // the target sample rate
+    explicit AnalyzerQueenMaryKey(
+            int targetSampleRate = kAnalysisKeyTargetSampleRate);
     ~AnalyzerQueenMaryKey() override;
 
     AnalyzerPluginInfo info() const override {
@@ -35,6 +39,7 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
 
     bool initialize(int samplerate) override;
     bool processSamples(const CSAMPLE* pIn, const int iLen) override;
+    bool processFrames(const AnalysisFrameBus& frameBus) override;
     bool finalize() override;
 
     KeyChangeList getKeyChanges() const override {
@@ -44,6 +49,10 @@ class AnalyzerQueenMaryKey : public AnalyzerKeyPlugin {
   private:
     std::unique_ptr<GetKeyMode> m_pKeyMode;
     DownmixAndOverlapHelper m_helper;
+    // For samples that are not passed through a frame bus
+    AnalysisFrameBus m_frameBus;
+    const int m_targetSampleRate;
+    int m_decimationFactor;
     size_t m_currentFrame;
     KeyChangeList m_resultKeys;
     mixxx::track::io::key::ChromaticKey m_prevKey;
@@ -8,8 +8,7 @@
 namespace mixxx {
 
 AnalyzerSoundTouchBeats::AnalyzerSoundTouchBeats()
-        : m_downmixBuffer(kAnalysisFramesPerChunk), // mono, i.e. 1 sample per frame
-          m_fResultBpm(0.0f) {
+        : m_fResultBpm(0.0f) {
 }
 
 AnalyzerSoundTouchBeats::~AnalyzerSoundTouchBeats() {
@@ -26,14 +25,7 @@ bool AnalyzerSoundTouchBeats::processSamples(const CSAMPLE* pIn, const int iLen)
         return false;
     }
     DEBUG_ASSERT(iLen % kAnalysisChannels == 0);
-    // We analyze a mono mixdown of the signal since we don't think stereo does
-    // us any good.
-
-    CSAMPLE* pDownmix = m_downmixBuffer.data();
-    for (int i = 0; i < iLen / 2; i += 2) {
-        pDownmix[i] = (pIn[i * 2] + pIn[i * 2 + 1]) * 0.5f;
-    }
-
+    // BPMDetect mixes the stereo frames down to mono itself
     m_pSoundTouch->inputSamples(pIn, iLen / 2);
     return true;
 }
@@ -5,7 +5,6 @@
 
 #include "analyzer/plugins/analyzerplugin.h"
 #include "util/memory.h"
-#include "util/samplebuffer.h"
 
 namespace soundtouch {
 class BPMDetect;
@@ -44,7 +43,6 @@ class AnalyzerSoundTouchBeats : public AnalyzerBeatsPlugin {
 
   private:
     std::unique_ptr<soundtouch::BPMDetect> m_pSoundTouch;
-    SampleBuffer m_downmixBuffer;
     float m_fResultBpm;
 };
 
@@ -1,12 +1,59 @@
 #include "analyzer/plugins/buffering_utils.h"
 
+#include "util/assert.h"
 #include "util/math.h"
 #include "util/sample.h"
 
 #include <string.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mixxx {
 
+namespace {
+
+// The length of the half-band filters. Longer filters have a steeper
+// transition band and suppress aliasing better. With a length of 4 * n - 1
+// the first and last coefficients are not zero.
+constexpr int kHalfBandLength = 47;
+constexpr int kHalfBandCenter = kHalfBandLength / 2;
+// The non-zero coefficients on one side of the center, all other
+// coefficients except the center one are zero.
+constexpr int kHalfBandSideTaps = (kHalfBandCenter + 1) / 2;
+
+struct HalfBandCoefficients {
+    HalfBandCoefficients() {
+        // Blackman windowed sinc with the cutoff frequency at half of the
+        // Nyquist frequency
+        double coefficients[kHalfBandLength];
+        double sum = 0.0;
+        for (int i = 0; i < kHalfBandLength; ++i) {
+            const int x = i - kHalfBandCenter;
+            const double sinc = x == 0 ? 0.5 : std::sin(M_PI * x / 2) / (M_PI * x);
+            const double window = 0.42 -
+                    0.5 * std::cos(2.0 * M_PI * i / (kHalfBandLength - 1)) +
+                    0.08 * std::cos(4.0 * M_PI * i / (kHalfBandLength - 1));
+            coefficients[i] = sinc * window;
+            sum += coefficients[i];
+        }
+        // Unity gain for DC
+        center = static_cast<CSAMPLE>(coefficients[kHalfBandCenter] / sum);
+        for (int k = 0; k < kHalfBandSideTaps; ++k) {
+            side[k] = static_cast<CSAMPLE>(
+                    coefficients[kHalfBandCenter + 2 * k + 1] / sum);
+        }
+    }
+
+    CSAMPLE center;
+    // At the odd distances 1, 3, 5, ... from the center
+    CSAMPLE side[kHalfBandSideTaps];
+};
+
+const HalfBandCoefficients kHalfBandCoefficients;
+
+} // anonymous namespace
+
 bool DownmixAndOverlapHelper::initialize(size_t windowSize, size_t stepSize, WindowReadyCallback callback) {
     m_buffer.assign(windowSize, 0.0);
     m_callback = callback;
@@ -21,7 +68,11 @@ bool DownmixAndOverlapHelper::initialize(size_t windowSize, size_t stepSize, Win
 
 bool DownmixAndOverlapHelper::processStereoSamples(const CSAMPLE* pInput, size_t inputStereoSamples) {
     const size_t numInputFrames = inputStereoSamples / 2;
-    return processInner(pInput, numInputFrames);
+    return processInner(pInput, numInputFrames, 2);
+}
+
+bool DownmixAndOverlapHelper::processMonoSamples(const CSAMPLE* pInput, size_t inputMonoSamples) {
+    return processInner(pInput, inputMonoSamples, 1);
 }
 
 bool DownmixAndOverlapHelper::finalize() {
@@ -32,19 +83,24 @@ bool DownmixAndOverlapHelper::finalize() {
     // instead of "m_windowSize / 2 - m_stepSize"
     size_t framesToFillWindow = m_windowSize - m_bufferWritePosition;
     size_t numInputFrames = math_max(framesToFillWindow, m_windowSize / 2 - 1);
-    return processInner(nullptr, numInputFrames);
+    return processInner(nullptr, numInputFrames, 1);
 }
 
 bool DownmixAndOverlapHelper::processInner(
-        const CSAMPLE* pInput, size_t numInputFrames) {
+        const CSAMPLE* pInput, size_t numInputFrames, int channels) {
     size_t inRead = 0;
     double* pDownmix = m_buffer.data();
 
     while (inRead < numInputFrames) {
-        size_t writeAvailable = math_min(numInputFrames,
+        size_t writeAvailable = math_min(numInputFrames - inRead,
                 m_windowSize - m_bufferWritePosition);
 
-        if (pInput) {
+        if (pInput && channels == 1) {
+            for (size_t i = 0; i < writeAvailable; ++i) {
+                pDownmix[m_bufferWritePosition + i] = pInput[inRead + i];
+            }
+        } else if (pInput) {
+            DEBUG_ASSERT(channels == 2);
             for (size_t i = 0; i < writeAvailable; ++i) {
                 // We analyze a mono downmix of the signal since we don't think
                 // stereo does us any good.
@@ -81,4 +137,108 @@ bool DownmixAndOverlapHelper::processInner(
     return true;
 }
 
+PolyphaseDecimator::HalfBandStage::HalfBandStage()
+        : m_history(kHalfBandLength * 2, 0.0f),
+          m_historyPosition(0),
+          m_skipNext(false) {
+}
+
+void PolyphaseDecimator::HalfBandStage::reset() {
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_historyPosition = 0;
+    m_skipNext = false;
+}
+
+size_t PolyphaseDecimator::HalfBandStage::process(
+        const CSAMPLE* pInput,
+        size_t inputSamples,
+        CSAMPLE* pOutput) {
+    CSAMPLE* pHistory = m_history.data();
+    size_t outputSamples = 0;
+    for (size_t i = 0; i < inputSamples; ++i) {
+        // Read before writing, pOutput may be the same as pInput
+        const CSAMPLE input = pInput[i];
+        pHistory[m_historyPosition] = input;
+        pHistory[m_historyPosition + kHalfBandLength] = input;
+        if (++m_historyPosition == kHalfBandLength) {
+            m_historyPosition = 0;
+        }
+        m_skipNext = !m_skipNext;
+        if (!m_skipNext) {
+            // The filter output would be discarded
+            continue;
+        }
+        // The most recent input samples starting at the oldest one. The
+        // filter is symmetric, so the samples at the same distance from the
+        // center are added before they are multiplied.
+        const CSAMPLE* pCenter = pHistory + m_historyPosition + kHalfBandCenter;
+        CSAMPLE output = kHalfBandCoefficients.center * pCenter[0];
+        for (int k = 0; k < kHalfBandSideTaps; ++k) {
+            const int distance = 2 * k + 1;
+            output += kHalfBandCoefficients.side[k] *
+                    (pCenter[-distance] + pCenter[distance]);
+        }
+        pOutput[outputSamples++] = output;
+    }
+    return outputSamples;
+}
+
+PolyphaseDecimator::PolyphaseDecimator(int factor)
+        : m_factor(1) {
+    while (m_factor * 2 <= factor) {
+        m_stages.emplace_back();
+        m_factor *= 2;
+    }
+    DEBUG_ASSERT(m_factor == math_max(factor, 1));
+}
+
+// static
+int PolyphaseDecimator::factorForTargetSampleRate(
+        int sampleRate, int targetSampleRate) {
+    int factor = 1;
+    if (targetSampleRate <= 0) {
+        return factor;
+    }
+    while (sampleRate / (factor * 2) >= targetSampleRate) {
+        factor *= 2;
+    }
+    return factor;
+}
+
+// static
+double PolyphaseDecimator::delayFrames(int factor) {
+    // Each stage delays by half of its length at its input sample rate
+    return kHalfBandCenter * (math_max(factor, 1) - 1);
+}
+
+void PolyphaseDecimator::reset() {
+    for (auto& stage : m_stages) {
+        stage.reset();
+    }
+}
+
+size_t PolyphaseDecimator::process(
+        const CSAMPLE* pInput,
+        size_t inputSamples,
+        CSAMPLE* pOutput) {
+    if (m_stages.empty()) {
+        std::copy(pInput, pInput + inputSamples, pOutput);
+        return inputSamples;
+    }
+    if (m_stages.size() == 1) {
+        return m_stages.front().process(pInput, inputSamples, pOutput);
+    }
+    // The intermediate stages work in place on the output of the first one
+    const size_t maxIntermediateSamples = maxOutputSamples(inputSamples, 2);
+    if (m_intermediate.size() < maxIntermediateSamples) {
+        m_intermediate.resize(maxIntermediateSamples);
+    }
+    CSAMPLE* pIntermediate = m_intermediate.data();
+    size_t samples = m_stages.front().process(pInput, inputSamples, pIntermediate);
+    for (size_t i = 1; i < m_stages.size() - 1; ++i) {
+        samples = m_stages[i].process(pIntermediate, samples, pIntermediate);
+    }
+    return m_stages.back().process(pIntermediate, samples, pOutput);
+}
+
 } // namespace mixxx
@@ -25,10 +25,15 @@ class DownmixAndOverlapHelper {
             const CSAMPLE* pInput,
             size_t inputStereoSamples);
 
+    // Frames the given samples that have already been downmixed to mono
+    bool processMonoSamples(
+            const CSAMPLE* pInput,
+            size_t inputMonoSamples);
+
     bool finalize();
 
   private:
-    bool processInner(const CSAMPLE* pInput, size_t numInputFrames);
+    bool processInner(const CSAMPLE* pInput, size_t numInputFrames, int channels);
 
     std::vector<double> m_buffer;
     // The window size in frames.
@@ -39,4 +44,71 @@ class DownmixAndOverlapHelper {
     WindowReadyCallback m_callback;
 };
 
+// Lowers the sample rate of a mono signal by a power of two. Each halving
+// is done by a half-band low-pass FIR filter in polyphase form: every other
+// coefficient of a half-band filter is zero, so one polyphase component is
+// a pure delay and only the other one needs to be computed, and only for
+// the output samples that are kept. The filter state is kept between
+// calls, so a signal can be decimated chunk by chunk with arbitrary chunk
+// sizes and the same result as if it was decimated at once.
+class PolyphaseDecimator {
+  public:
+    explicit PolyphaseDecimator(int factor = 1);
+
+    // Returns the largest decimation factor that keeps the sample rate of
+    // the decimated signal at or above the target sample rate. A target
+    // sample rate of 0 disables the decimation.
+    static int factorForTargetSampleRate(int sampleRate, int targetSampleRate);
+
+    int factor() const {
+        return m_factor;
+    }
+
+    // The delay of the filters in input frames. The decimated signal lags
+    // behind the input signal by this amount.
+    static double delayFrames(int factor);
+
+    // The maximum number of samples that process() writes for the given
+    // number of input samples
+    static size_t maxOutputSamples(size_t inputSamples, int factor) {
+        return (inputSamples + factor - 1) / factor;
+    }
+
+    // Clears the filter state to start with a new signal
+    void reset();
+
+    // Decimates the input samples and returns the number of samples that
+    // have been written to pOutput. pOutput may be the same as pInput.
+    size_t process(
+            const CSAMPLE* pInput,
+            size_t inputSamples,
+            CSAMPLE* pOutput);
+
+  private:
+    // Halves the sample rate
+    class HalfBandStage {
+      public:
+        HalfBandStage();
+
+        void reset();
+        size_t process(
+                const CSAMPLE* pInput,
+                size_t inputSamples,
+                CSAMPLE* pOutput);
+
+      private:
+        // The most recent input samples are stored twice, so the filter
+        // can always be applied to a contiguous range without wrapping.
+        std::vector<CSAMPLE> m_history;
+        size_t m_historyPosition;
+        // Every other input sample produces an output sample
+        bool m_skipNext;
+    };
+
+    int m_factor;
+    std::vector<HalfBandStage> m_stages;
+    // The output of the first stages, if there is more than one
+    std::vector<CSAMPLE> m_intermediate;
+};
+
 } // namespace mixxx
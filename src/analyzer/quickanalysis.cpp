@@ -0,0 +1,90 @@
+#include "analyzer/quickanalysis.h"
+
+#include <QStringList>
+
+#include "analyzer/constants.h"
+#include "track/beats.h"
+#include "track/keys.h"
+
+namespace mixxx {
+
+namespace {
+
+const QString kQuickAnalysisKey = QStringLiteral("quick_analysis");
+const QString kQuickAnalysisFragment = QStringLiteral("quick_analysis=1");
+const QString kQuickReplayGainKey = QStringLiteral("quick_replaygain");
+const QString kQuickReplayGainFragment = QStringLiteral("quick_replaygain=1");
+
+// See BeatFactory::getPreferredSubVersion() and
+// KeyFactory::getPreferredSubVersion()
+bool containsFragment(const QString& subVersion, const QString& fragment) {
+    return subVersion.split(QChar('|')).contains(fragment);
+}
+
+bool hasFragment(const TrackPointer& pTrack, const QString& fragment) {
+    const BeatsPointer pBeats = pTrack->getBeats();
+    if (pBeats && containsFragment(pBeats->getSubVersion(), fragment)) {
+        return true;
+    }
+    const Keys keys = pTrack->getKeys();
+    return keys.isValid() && containsFragment(keys.getSubVersion(), fragment);
+}
+
+} // anonymous namespace
+
+std::vector<IndexRange> quickAnalysisFrameRanges(
+        IndexRange frameIndexRange,
+        SINT sampleRate) {
+    DEBUG_ASSERT(frameIndexRange.orientation() != IndexRange::Orientation::Backward);
+    const SINT windowFrames = kQuickAnalysisSecondsPerWindow * sampleRate;
+    const SINT trackFrames = frameIndexRange.length();
+    // The windows would overlap otherwise
+    if (windowFrames <= 0 || trackFrames <= (kQuickAnalysisWindows + 1) * windowFrames) {
+        return {frameIndexRange};
+    }
+    std::vector<IndexRange> frameRanges;
+    frameRanges.reserve(kQuickAnalysisWindows);
+    for (int i = 0; i < kQuickAnalysisWindows; ++i) {
+        const SINT center = frameIndexRange.start() +
+                trackFrames * (i + 1) / (kQuickAnalysisWindows + 1);
+        frameRanges.push_back(IndexRange::forward(
+                center - windowFrames / 2, windowFrames));
+    }
+    return frameRanges;
+}
+
+double quickAnalysisTrackFramePosition(
+        const std::vector<IndexRange>& frameRanges,
+        double framePosition) {
+    VERIFY_OR_DEBUG_ASSERT(!frameRanges.empty()) {
+        return framePosition;
+    }
+    for (const auto& frameRange : frameRanges) {
+        if (framePosition < frameRange.length()) {
+            return frameRange.start() + framePosition;
+        }
+        framePosition -= frameRange.length();
+    }
+    // Beyond the last window
+    return frameRanges.back().end() + framePosition;
+}
+
+void addQuickAnalysisVersionInfo(
+        QHash<QString, QString>* pExtraVersionInfo,
+        bool provisionalReplayGain) {
+    pExtraVersionInfo->insert(kQuickAnalysisKey, QStringLiteral("1"));
+    if (provisionalReplayGain) {
+        pExtraVersionInfo->insert(kQuickReplayGainKey, QStringLiteral("1"));
+    }
+}
+
+bool isQuickAnalysisSubVersion(const QString& subVersion) {
+    return containsFragment(subVersion, kQuickAnalysisFragment);
+}
+
+bool hasQuickAnalysisReplayGain(const TrackPointer& pTrack) {
+    return pTrack->getReplayGain().hasRatio() &&
+            hasFragment(pTrack, kQuickReplayGainFragment);
+}
+
+} // namespace mixxx
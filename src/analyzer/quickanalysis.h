@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <vector>
+
+#include "track/track.h"
+#include "util/indexrange.h"
+
+namespace mixxx {
+
+// A quick analysis only decodes kQuickAnalysisWindows windows of
+// kQuickAnalysisSecondsPerWindow seconds spread across a track to get a
+// BPM, key and ReplayGain for sorting and sync right after importing. The
+// analyzers receive the windows one after another. These provisional
+// results are marked in the sub-version of the beats and keys and the next
+// regular analysis replaces them regardless of the re-analysis preferences.
+
+// The windows of a track that a quick analysis decodes in ascending order.
+// They are centered at equal distances from each other and from both ends,
+// which skips intros and outros. Short tracks are decoded completely.
+std::vector<IndexRange> quickAnalysisFrameRanges(
+        IndexRange frameIndexRange,
+        SINT sampleRate);
+
+// Maps a frame position within the concatenated windows to the
+// corresponding frame position in the track
+double quickAnalysisTrackFramePosition(
+        const std::vector<IndexRange>& frameRanges,
+        double framePosition);
+
+// Marks the results of a quick analysis. ReplayGain has no version, so
+// the beats and keys also record if the track did not have a ReplayGain
+// before the quick analysis, which then is provisional as well.
+void addQuickAnalysisVersionInfo(
+        QHash<QString, QString>* pExtraVersionInfo,
+        bool provisionalReplayGain);
+
+bool isQuickAnalysisSubVersion(const QString& subVersion);
+
+// True if the ReplayGain of the track has been added by a quick analysis
+// and has not been replaced by a regular analysis yet
+bool hasQuickAnalysisReplayGain(const TrackPointer& pTrack);
+
+} // namespace mixxx
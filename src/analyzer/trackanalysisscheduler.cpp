@@ -75,6 +75,8 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 modeFlags));
         connect(m_workers.back().thread(), &AnalyzerThread::progress,
             this, &TrackAnalysisScheduler::onWorkerThreadProgress);
+        connect(m_workers.back().thread(), &AnalyzerThread::analysisStatistics,
+            this, &TrackAnalysisScheduler::onWorkerThreadStatistics);
     }
     // 2nd pass: Start worker threads in a suspended state
     for (const auto& worker: m_workers) {
@@ -94,6 +96,18 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
         m_currentTrackProgress = kAnalyzerProgressUnknown;
         m_currentTrackNumber = 0;
         m_dequeuedTracksCount = 0;
+        if (m_reuseStatistics.reusedTracksCount() > 0 ||
+                m_reuseStatistics.partiallyReusedTracksCount() > 0) {
+            kLogger.info()
+                    << "Reused the analysis results of"
+                    << m_reuseStatistics.reusedTracksCount()
+                    << "tracks entirely and of"
+                    << m_reuseStatistics.partiallyReusedTracksCount()
+                    << "tracks partially with identical audio, saving an estimated"
+                    << m_reuseStatistics.estimatedSecondsSaved()
+                    << "seconds";
+        }
+        m_reuseStatistics.reset();
         emit finished();
         return;
     }
@@ -229,6 +243,20 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     emitProgressOrFinished();
 }
 
+void TrackAnalysisScheduler::onWorkerThreadStatistics(
+        int threadId,
+        mixxx::TrackAnalysisStatistics statistics) {
+    Q_UNUSED(threadId);
+    m_reuseStatistics.addTrack(statistics);
+    if (m_reuseStatistics.reusedTracksCount() > 0 ||
+            m_reuseStatistics.partiallyReusedTracksCount() > 0) {
+        emit analysisReused(
+                m_reuseStatistics.reusedTracksCount(),
+                m_reuseStatistics.partiallyReusedTracksCount(),
+                m_reuseStatistics.estimatedSecondsSaved());
+    }
+}
+
 bool TrackAnalysisScheduler::scheduleTrackById(TrackId trackId) {
     VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
         qWarning()
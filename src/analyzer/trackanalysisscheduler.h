@@ -67,9 +67,14 @@ class TrackAnalysisScheduler : public QObject {
     // Current average progress for all scheduled tracks and from all workers
     void progress(AnalyzerProgress currentTrackProgress, int currentTrackNumber, int totalTracksCount);
     void finished();
+    // Tracks whose analysis has been skipped entirely or partially,
+    // because the results of a track with identical audio have been
+    // reused. See mixxx::AnalysisReuseStatistics for the time saved.
+    void analysisReused(int reusedTracksCount, int partiallyReusedTracksCount, double estimatedSecondsSaved);
 
   private slots:
     void onWorkerThreadProgress(int threadId, AnalyzerThreadState threadState, TrackId trackId, AnalyzerProgress analyzerProgress);
+    void onWorkerThreadStatistics(int threadId, mixxx::TrackAnalysisStatistics statistics);
 
   private:
     // Owns an analyzer thread and buffers the most recent progress update
@@ -162,6 +167,10 @@ class TrackAnalysisScheduler : public QObject {
 
     int m_dequeuedTracksCount;
 
+    // Statistics about reused analysis results since the last time
+    // that all tracks have been finished
+    mixxx::AnalysisReuseStatistics m_reuseStatistics;
+
     typedef std::chrono::steady_clock Clock;
     Clock::time_point m_lastProgressEmittedAt;
 };
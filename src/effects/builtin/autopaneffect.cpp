@@ -24,6 +24,7 @@ EffectManifestPointer AutoPanEffect::getManifest() {
     pManifest->setVersion("1.0");
     pManifest->setDescription(QObject::tr(
         "Bounce the sound left and right across the stereo field"));
+    pManifest->setTailLengthSeconds(0.0);
 
     // Period
     EffectManifestParameterPointer period = pManifest->addParameter();
@@ -20,6 +20,7 @@ EffectManifestPointer Bessel8LVMixEQEffect::getManifest() {
         "A Bessel 8th-order filter isolator with Lipshitz and Vanderkooy mix (bit perfect unity, roll-off -48 dB/octave).") + " " + EqualizerUtil::adjustFrequencyShelvesTip());
     pManifest->setIsMixingEQ(true);
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EqualizerUtil::createCommonParameters(pManifest.data(), false);
     return pManifest;
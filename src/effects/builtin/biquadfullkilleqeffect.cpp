@@ -64,6 +64,7 @@ EffectManifestPointer BiquadFullKillEQEffect::getManifest() {
         "A 3-band Equalizer that combines an Equalizer and an Isolator circuit to offer gentle slopes and full kill.") + " " +  EqualizerUtil::adjustFrequencyShelvesTip());
     pManifest->setEffectRampsFromDry(true);
     pManifest->setIsMixingEQ(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EqualizerUtil::createCommonParameters(pManifest.data(), false);
     return pManifest;
@@ -19,6 +19,7 @@ EffectManifestPointer BitCrusherEffect::getManifest() {
         "Adds noise by the reducing the bit depth and sample rate"));
     pManifest->setEffectRampsFromDry(true);
     pManifest->setMetaknobDefault(0.0);
+    pManifest->setTailLengthSeconds(0.0);
 
     EffectManifestParameterPointer depth = pManifest->addParameter();
     depth->setId("bit_depth");
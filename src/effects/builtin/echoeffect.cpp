@@ -40,6 +40,9 @@ EffectManifestPointer EchoEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
       "Stores the input signal in a temporary buffer and outputs it after a short time"));
     pManifest->setMetaknobDefault(db2ratio(-3.0));
+    // Between two repeats the output is silent for up to the delay time,
+    // while the repeats are still stored in the delay buffer.
+    pManifest->setTailLengthSeconds(EchoGroupState::kMaxDelaySeconds);
 
     EffectManifestParameterPointer delay = pManifest->addParameter();
     delay->setId("delay_time");
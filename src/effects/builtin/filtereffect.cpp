@@ -22,6 +22,7 @@ EffectManifestPointer FilterEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
         "Allows only high or low frequencies to play."));
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EffectManifestParameterPointer lpf = pManifest->addParameter();
     lpf->setId("lpf");
@@ -37,6 +38,7 @@ EffectManifestPointer FilterEffect::getManifest() {
     lpf->setDefault(kMaxCorner);
     lpf->setMinimum(kMinCorner);
     lpf->setMaximum(kMaxCorner);
+    lpf->setIdentityValue(kMaxCorner);
 
     EffectManifestParameterPointer q = pManifest->addParameter();
     q->setId("q");
@@ -66,6 +68,7 @@ EffectManifestPointer FilterEffect::getManifest() {
     hpf->setDefault(kMinCorner);
     hpf->setMinimum(kMinCorner);
     hpf->setMaximum(kMaxCorner);
+    hpf->setIdentityValue(kMinCorner);
 
     return pManifest;
 }
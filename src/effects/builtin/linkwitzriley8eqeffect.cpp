@@ -23,6 +23,7 @@ EffectManifestPointer LinkwitzRiley8EQEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
         "A Linkwitz-Riley 8th-order filter isolator (optimized crossover, constant phase shift, roll-off -48 dB/octave).") + " " + EqualizerUtil::adjustFrequencyShelvesTip());
     pManifest->setIsMixingEQ(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EqualizerUtil::createCommonParameters(pManifest.data(), false);
     return pManifest;
@@ -21,6 +21,7 @@ EffectManifestPointer MoogLadder4FilterEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
             "A 4-pole Moog ladder filter, based on Antti Houvilainen's non linear digital implementation"));
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EffectManifestParameterPointer lpf = pManifest->addParameter();
     lpf->setId("lpf");
@@ -34,6 +35,7 @@ EffectManifestPointer MoogLadder4FilterEffect::getManifest() {
     lpf->setDefault(kMaxCorner);
     lpf->setMinimum(kMinCorner);
     lpf->setMaximum(kMaxCorner);
+    lpf->setIdentityValue(kMaxCorner);
 
     EffectManifestParameterPointer q = pManifest->addParameter();
     q->setId("resonance");
@@ -59,6 +61,7 @@ EffectManifestPointer MoogLadder4FilterEffect::getManifest() {
     hpf->setDefault(kMinCorner);
     hpf->setMinimum(kMinCorner);
     hpf->setMaximum(kMaxCorner);
+    hpf->setIdentityValue(kMinCorner);
 
     return pManifest;
 }
@@ -25,6 +25,7 @@ EffectManifestPointer ParametricEQEffect::getManifest() {
         "It is designed as a complement to the steep mixing equalizers."));
     pManifest->setEffectRampsFromDry(true);
     pManifest->setIsMasterEQ(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EffectManifestParameterPointer gain1 = pManifest->addParameter();
     gain1->setId("gain1");
@@ -23,6 +23,7 @@ EffectManifestPointer PhaserEffect::getManifest() {
         "Mixes the input signal with a copy passed through a series of "
         "all-pass filters to create comb filtering"));
     pManifest->setEffectRampsFromDry(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EffectManifestParameterPointer period = pManifest->addParameter();
     period->setId("lfo_period");
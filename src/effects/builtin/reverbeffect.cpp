@@ -21,6 +21,8 @@ EffectManifestPointer ReverbEffect::getManifest() {
     pManifest->setVersion("1.0");
     pManifest->setDescription(QObject::tr(
         "Emulates the sound of the signal bouncing off the walls of a room"));
+    // Covers the longest delay line of the reverb tank.
+    pManifest->setTailLengthSeconds(0.5);
 
     EffectManifestParameterPointer decay = pManifest->addParameter();
     decay->setId("decay");
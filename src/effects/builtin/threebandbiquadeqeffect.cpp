@@ -63,6 +63,7 @@ EffectManifestPointer ThreeBandBiquadEQEffect::getManifest() {
         " " + EqualizerUtil::adjustFrequencyShelvesTip());
     pManifest->setEffectRampsFromDry(true);
     pManifest->setIsMixingEQ(true);
+    pManifest->setTailLengthSeconds(0.05);
 
     EqualizerUtil::createCommonParameters(pManifest.data(), true);
     return pManifest;
@@ -21,6 +21,7 @@ EffectManifestPointer TremoloEffect::getManifest() {
     pManifest->setDescription(QObject::tr(
         "Cycles the volume up and down"));
     pManifest->setMetaknobDefault(1.0);
+    pManifest->setTailLengthSeconds(0.0);
 
     EffectManifestParameterPointer depth = pManifest->addParameter();
     depth->setId("depth");
@@ -23,13 +23,19 @@
 // example, a database-backed manifest)
 class EffectManifest final {
   public:
+    // The effect may keep producing output from silent input for an
+    // unlimited time, or nobody knows. The engine never skips processing
+    // such an effect because of silence.
+    static constexpr double kUnknownTailLength = -1.0;
+
     EffectManifest()
         : m_backendType(EffectBackendType::Unknown),
           m_isMixingEQ(false),
           m_isMasterEQ(false),
           m_effectRampsFromDry(false),
           m_bAddDryToWet(false),
-          m_metaknobDefault(0.5) {
+          m_metaknobDefault(0.5),
+          m_tailLengthSeconds(kUnknownTailLength) {
     }
 
     const QString& id() const {
@@ -142,6 +148,21 @@ class EffectManifest final {
         m_metaknobDefault = metaknobDefault;
     }
 
+    // The time the output of the effect may remain silent while its internal
+    // state still holds audible signal, e.g. the longest delay time of an
+    // echo. Once both the input and the output of the effect have been silent
+    // for this time, EngineEffect stops processing it until the input becomes
+    // audible again. 0 is suitable for effects without memory.
+    bool hasTailLength() const {
+        return m_tailLengthSeconds >= 0.0;
+    }
+    double tailLengthSeconds() const {
+        return m_tailLengthSeconds;
+    }
+    void setTailLengthSeconds(double tailLengthSeconds) {
+        m_tailLengthSeconds = tailLengthSeconds;
+    }
+
     QString backendName() {
         switch (m_backendType) {
             case EffectBackendType::BuiltIn:
@@ -194,6 +215,7 @@ class EffectManifest final {
     bool m_effectRampsFromDry;
     bool m_bAddDryToWet;
     double m_metaknobDefault;
+    double m_tailLengthSeconds;
 };
 
 #endif /* EFFECTMANIFEST_H */
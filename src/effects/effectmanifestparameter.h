@@ -89,6 +89,8 @@ class EffectManifestParameter {
               m_default(0),
               m_minimum(0),
               m_maximum(1.0),
+              m_hasIdentityValue(false),
+              m_identityValue(0.0),
               m_showInParametertSlot(true) {
     }
 
@@ -220,6 +222,23 @@ class EffectManifestParameter {
         m_maximum = maximum;
     }
 
+    // The value at which this parameter does not alter the signal. If the
+    // identity value is the minimum or the maximum, values beyond it count
+    // as well. An effect whose parameters with an identity value are all at
+    // their identity passes its input through unchanged, and the engine does
+    // not need to process it. The meta knob of a filter is at identity when
+    // the low pass is fully open and the high pass fully closed.
+    virtual bool hasIdentityValue() const {
+        return m_hasIdentityValue;
+    }
+    virtual double identityValue() const {
+        return m_identityValue;
+    }
+    virtual void setIdentityValue(double identityValue) {
+        m_hasIdentityValue = true;
+        m_identityValue = identityValue;
+    }
+
     virtual void appendStep(const QPair<QString, double>& step) {
         m_steps.append(step);
     }
@@ -248,6 +267,9 @@ class EffectManifestParameter {
     double m_minimum;
     double m_maximum;
 
+    bool m_hasIdentityValue;
+    double m_identityValue;
+
     // Used to describe steps of
     // CONTROL_KNOB_STEPPING and CONTROL_TOGGLE_STEPPING
     // effect parameters
@@ -82,6 +82,35 @@ class EffectProcessor {
                          const mixxx::EngineParameters& bufferParameters,
                          const EffectEnableState enableState,
                          const GroupFeatureState& groupFeatures) = 0;
+
+    // Effects that work on separate buffers for each channel internally, like
+    // LV2 plugins, may implement processPlanar() additionally. Consecutive
+    // effects of an EngineEffectChain that support it share planar buffers
+    // and the chain only converts from and to the interleaved format before
+    // the first and after the last of them.
+    virtual bool supportsPlanarProcessing() const {
+        return false;
+    }
+
+    // Like process(), but pInputChannels and pOutputChannels point to
+    // bufferParameters.channelCount() buffers with
+    // bufferParameters.framesPerBuffer() samples each.
+    virtual void processPlanar(const ChannelHandle& inputHandle,
+                               const ChannelHandle& outputHandle,
+                               const CSAMPLE* const* pInputChannels,
+                               CSAMPLE* const* pOutputChannels,
+                               const mixxx::EngineParameters& bufferParameters,
+                               const EffectEnableState enableState,
+                               const GroupFeatureState& groupFeatures) {
+        Q_UNUSED(inputHandle);
+        Q_UNUSED(outputHandle);
+        Q_UNUSED(pInputChannels);
+        Q_UNUSED(pOutputChannels);
+        Q_UNUSED(bufferParameters);
+        Q_UNUSED(enableState);
+        Q_UNUSED(groupFeatures);
+        DEBUG_ASSERT(!"processPlanar() is not supported by this effect");
+    }
 };
 
 // EffectProcessorImpl manages a separate EffectState for every routing of
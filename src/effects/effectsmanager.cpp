@@ -17,6 +17,9 @@ namespace {
 const QString kEffectGroupSeparator = "_";
 const QString kGroupClose = "]";
 const unsigned int kEffectMessagPipeFifoSize = 2048;
+// Number of helper threads for processing the effects of several channels
+// concurrently. 0 disables parallel processing.
+const ConfigKey kParallelProcessingThreadsKey("[Effects]", "ParallelProcessingThreads");
 } // anonymous namespace
 
 
@@ -35,7 +38,8 @@ EffectsManager::EffectsManager(QObject* pParent, UserSettingsPointer pConfig,
                 kEffectMessagPipeFifoSize, kEffectMessagPipeFifoSize);
 
     m_pRequestPipe.reset(requestPipes.first);
-    m_pEngineEffectsManager = new EngineEffectsManager(requestPipes.second);
+    m_pEngineEffectsManager = new EngineEffectsManager(requestPipes.second,
+            pConfig->getValue(kParallelProcessingThreadsKey, 0));
 
     m_pNumEffectsAvailable = new ControlObject(ConfigKey("[Master]", "num_effectsavailable"));
     m_pNumEffectsAvailable->setReadOnly();
@@ -3,6 +3,17 @@
 #include "control/controlobject.h"
 #include "util/sample.h"
 #include "util/defs.h"
+#include "util/math.h"
+
+namespace {
+
+// LV2 plugins are run on blocks of at most this many frames, independent
+// from the buffer size of the sound card. The control ports are updated
+// before every block, so parameter changes take effect within a few
+// milliseconds instead of jumping once per buffer.
+constexpr SINT kMaxBlockFrames = 64;
+
+} // anonymous namespace
 
 LV2EffectProcessor::LV2EffectProcessor(EngineEffect* pEngineEffect,
                                        EffectManifestPointer pManifest,
@@ -13,18 +24,16 @@ LV2EffectProcessor::LV2EffectProcessor(EngineEffect* pEngineEffect,
               m_audioPortIndices(audioPortIndices),
               m_controlPortIndices(controlPortIndices),
               m_pEffectsManager(nullptr) {
-    m_inputL = new float[MAX_BUFFER_LEN];
-    m_inputR = new float[MAX_BUFFER_LEN];
-    m_outputL = new float[MAX_BUFFER_LEN];
-    m_outputR = new float[MAX_BUFFER_LEN];
-    m_params = new float[pManifest->parameters().size()];
-
     const QList<EffectManifestParameterPointer>& effectManifestParameterList =
             pManifest->parameters();
 
     // Initialize EngineEffectParameters
     for (const auto& pParam: effectManifestParameterList) {
         m_parameters.append(pEngineEffect->getParameterById(pParam->id()));
+        const auto controlHint = pParam->controlHint();
+        m_interpolateParameters.append(
+                controlHint != EffectManifestParameter::ControlHint::KNOB_STEPPING &&
+                controlHint != EffectManifestParameter::ControlHint::TOGGLE_STEPPING);
     }
 }
 
@@ -50,12 +59,6 @@ LV2EffectProcessor::~LV2EffectProcessor() {
         outputsMap.clear();
     }
     m_channelStateMatrix.clear();
-
-    delete[] m_inputL;
-    delete[] m_inputR;
-    delete[] m_outputL;
-    delete[] m_outputR;
-    delete[] m_params;
 }
 
 void LV2EffectProcessor::initialize(
@@ -89,15 +92,10 @@ void LV2EffectProcessor::initialize(
     DEBUG_ASSERT(m_pEffectsManager != nullptr);
 }
 
-void LV2EffectProcessor::process(const ChannelHandle& inputHandle,
+LV2EffectGroupState* LV2EffectProcessor::getGroupState(
+        const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle,
-        const CSAMPLE* pInput, CSAMPLE* pOutput,
-        const mixxx::EngineParameters& bufferParameters,
-        const EffectEnableState enableState,
-        const GroupFeatureState& groupFeatures) {
-    Q_UNUSED(groupFeatures);
-    Q_UNUSED(enableState);
-
+        const mixxx::EngineParameters& bufferParameters) {
     LV2EffectGroupState* pState = m_channelStateMatrix[inputHandle][outputHandle];
     VERIFY_OR_DEBUG_ASSERT(pState != nullptr) {
         if (kEffectDebugOutput) {
@@ -110,48 +108,119 @@ void LV2EffectProcessor::process(const ChannelHandle& inputHandle,
         pState = createGroupState(bufferParameters);
         m_channelStateMatrix[inputHandle][outputHandle] = pState;
     }
+    return pState;
+}
 
+void LV2EffectProcessor::process(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const CSAMPLE* pInput, CSAMPLE* pOutput,
+        const mixxx::EngineParameters& bufferParameters,
+        const EffectEnableState enableState,
+        const GroupFeatureState& groupFeatures) {
+    Q_UNUSED(groupFeatures);
+    Q_UNUSED(enableState);
+
+    LV2EffectGroupState* pState = getGroupState(inputHandle, outputHandle, bufferParameters);
     if (!pState) {
         SampleUtil::copyWithGain(pOutput, pInput, 1.0, bufferParameters.samplesPerBuffer());
         return;
-    } 
-
-    for (int i = 0; i < m_parameters.size(); i++) {
-        m_params[i] = m_parameters[i]->value();
     }
 
-    int j = 0;
-    for (unsigned int i = 0; i < bufferParameters.samplesPerBuffer(); i += 2) {
-        m_inputL[j] = pInput[i];
-        m_inputR[j] = pInput[i + 1];
-        j++;
+    const SINT numFrames = bufferParameters.framesPerBuffer();
+    SampleUtil::deinterleaveBuffer(pState->inputL(), pState->inputR(), pInput, numFrames);
+
+    const CSAMPLE* pInputChannels[] = {pState->inputL(), pState->inputR()};
+    CSAMPLE* pOutputChannels[] = {pState->outputL(), pState->outputR()};
+    runBlocks(pState, pInputChannels, pOutputChannels, numFrames);
+
+    SampleUtil::interleaveBuffer(pOutput, pState->outputL(), pState->outputR(), numFrames);
+}
+
+void LV2EffectProcessor::processPlanar(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const CSAMPLE* const* pInputChannels,
+        CSAMPLE* const* pOutputChannels,
+        const mixxx::EngineParameters& bufferParameters,
+        const EffectEnableState enableState,
+        const GroupFeatureState& groupFeatures) {
+    Q_UNUSED(groupFeatures);
+    Q_UNUSED(enableState);
+
+    const SINT numFrames = bufferParameters.framesPerBuffer();
+    LV2EffectGroupState* pState = getGroupState(inputHandle, outputHandle, bufferParameters);
+    if (!pState) {
+        SampleUtil::copy(pOutputChannels[0], pInputChannels[0], numFrames);
+        SampleUtil::copy(pOutputChannels[1], pInputChannels[1], numFrames);
+        return;
     }
 
-    lilv_instance_run(pState->lilvIinstance(), bufferParameters.framesPerBuffer());
+    // The plugin reads from and writes to the buffers of the chain directly.
+    runBlocks(pState, pInputChannels, pOutputChannels, numFrames);
+}
+
+void LV2EffectProcessor::runBlocks(LV2EffectGroupState* pState,
+        const CSAMPLE* const* pInputChannels,
+        CSAMPLE* const* pOutputChannels,
+        SINT numFrames) {
+    LilvInstance* pInstance = pState->lilvIinstance();
+    float* pParams = pState->params();
+    float* pPreviousParams = pState->previousParams();
+
+    const SINT numBlocks = (numFrames + kMaxBlockFrames - 1) / kMaxBlockFrames;
+    for (SINT block = 0; block < numBlocks; ++block) {
+        const SINT offset = block * kMaxBlockFrames;
+        const SINT blockFrames = math_min(kMaxBlockFrames, numFrames - offset);
+
+        const float progress = static_cast<float>(block + 1) / numBlocks;
+        for (int i = 0; i < m_parameters.size(); i++) {
+            const float value = static_cast<float>(m_parameters[i]->value());
+            if (m_interpolateParameters[i]) {
+                pParams[i] = pPreviousParams[i] + (value - pPreviousParams[i]) * progress;
+            } else {
+                pParams[i] = value;
+            }
+        }
 
-    j = 0;
-    for (unsigned int i = 0; i < bufferParameters.samplesPerBuffer(); i += 2) {
-        pOutput[i] = m_outputL[j];
-        pOutput[i + 1] = m_outputR[j];
-        j++;
+        // We assume the audio ports are in the following order:
+        // input_left, input_right, output_left, output_right
+        // Connecting ports is real-time safe and input ports are never
+        // written by the plugin.
+        lilv_instance_connect_port(pInstance, m_audioPortIndices[0],
+                const_cast<CSAMPLE*>(pInputChannels[0] + offset));
+        lilv_instance_connect_port(pInstance, m_audioPortIndices[1],
+                const_cast<CSAMPLE*>(pInputChannels[1] + offset));
+        lilv_instance_connect_port(pInstance, m_audioPortIndices[2],
+                pOutputChannels[0] + offset);
+        lilv_instance_connect_port(pInstance, m_audioPortIndices[3],
+                pOutputChannels[1] + offset);
+
+        lilv_instance_run(pInstance, blockFrames);
+    }
+
+    for (int i = 0; i < m_parameters.size(); i++) {
+        pPreviousParams[i] = pParams[i];
     }
 }
 
 LV2EffectGroupState* LV2EffectProcessor::createGroupState(const mixxx::EngineParameters& bufferParameters) {
-    LV2EffectGroupState * pState = new LV2EffectGroupState(bufferParameters, m_pPlugin);
+    LV2EffectGroupState * pState = new LV2EffectGroupState(
+            bufferParameters, m_pPlugin, m_parameters.size());
     LilvInstance* handle = pState->lilvIinstance();
     if (handle) {
+        float* pParams = pState->params();
+        float* pPreviousParams = pState->previousParams();
         for (int i = 0; i < m_parameters.size(); i++) {
-            m_params[i] = m_parameters[i]->value();
-            lilv_instance_connect_port(handle, m_controlPortIndices[i], &m_params[i]);
+            pParams[i] = m_parameters[i]->value();
+            pPreviousParams[i] = pParams[i];
+            lilv_instance_connect_port(handle, m_controlPortIndices[i], &pParams[i]);
         }
 
         // We assume the audio ports are in the following order:
         // input_left, input_right, output_left, output_right
-        lilv_instance_connect_port(handle, m_audioPortIndices[0], m_inputL);
-        lilv_instance_connect_port(handle, m_audioPortIndices[1], m_inputR);
-        lilv_instance_connect_port(handle, m_audioPortIndices[2], m_outputL);
-        lilv_instance_connect_port(handle, m_audioPortIndices[3], m_outputR);
+        lilv_instance_connect_port(handle, m_audioPortIndices[0], pState->inputL());
+        lilv_instance_connect_port(handle, m_audioPortIndices[1], pState->inputR());
+        lilv_instance_connect_port(handle, m_audioPortIndices[2], pState->outputL());
+        lilv_instance_connect_port(handle, m_audioPortIndices[3], pState->outputR());
 
         lilv_instance_activate(handle);
     }
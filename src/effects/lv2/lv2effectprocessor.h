@@ -7,11 +7,25 @@
 #include <lilv-0/lilv/lilv.h>
 #include "effects/defs.h"
 #include "engine/engine.h"
+#include "util/defs.h"
+#include "util/samplebuffer.h"
 
+#include <vector>
+
+// Each instance owns the buffers its ports are connected to, so that the
+// same effect can be processed for different channels concurrently.
 class LV2EffectGroupState : public EffectState {
   public:
-    LV2EffectGroupState(const mixxx::EngineParameters& bufferParameters, const LilvPlugin* pPlugin)
-            : EffectState(bufferParameters) {
+    LV2EffectGroupState(const mixxx::EngineParameters& bufferParameters,
+                        const LilvPlugin* pPlugin,
+                        int numParams)
+            : EffectState(bufferParameters),
+              m_inputL(MAX_BUFFER_LEN),
+              m_inputR(MAX_BUFFER_LEN),
+              m_outputL(MAX_BUFFER_LEN),
+              m_outputR(MAX_BUFFER_LEN),
+              m_params(numParams, 0.0f),
+              m_previousParams(numParams, 0.0f) {
         m_pInstance = lilv_plugin_instantiate(pPlugin, bufferParameters.sampleRate(), nullptr);
     }
     ~LV2EffectGroupState() {
@@ -22,8 +36,36 @@ class LV2EffectGroupState : public EffectState {
     LilvInstance* lilvIinstance() {
         return m_pInstance;
     }
+
+    float* inputL() {
+        return m_inputL.data();
+    }
+    float* inputR() {
+        return m_inputR.data();
+    }
+    float* outputL() {
+        return m_outputL.data();
+    }
+    float* outputR() {
+        return m_outputR.data();
+    }
+    // The values of the control ports.
+    float* params() {
+        return m_params.data();
+    }
+    // The control values at the end of the last processed buffer.
+    float* previousParams() {
+        return m_previousParams.data();
+    }
+
   private:
     LilvInstance* m_pInstance;
+    mixxx::SampleBuffer m_inputL;
+    mixxx::SampleBuffer m_inputR;
+    mixxx::SampleBuffer m_outputL;
+    mixxx::SampleBuffer m_outputR;
+    std::vector<float> m_params;
+    std::vector<float> m_previousParams;
 };
 
 class LV2EffectProcessor : public EffectProcessor {
@@ -52,15 +94,35 @@ class LV2EffectProcessor : public EffectProcessor {
             const mixxx::EngineParameters& bufferParameters,
             const EffectEnableState enableState,
             const GroupFeatureState& groupFeatures) override;
+
+    bool supportsPlanarProcessing() const override {
+        return true;
+    }
+    void processPlanar(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const CSAMPLE* const* pInputChannels,
+            CSAMPLE* const* pOutputChannels,
+            const mixxx::EngineParameters& bufferParameters,
+            const EffectEnableState enableState,
+            const GroupFeatureState& groupFeatures) override;
+
   private:
     LV2EffectGroupState* createGroupState(const mixxx::EngineParameters& bufferParameters);
+    LV2EffectGroupState* getGroupState(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle,
+            const mixxx::EngineParameters& bufferParameters);
+
+    // Runs the plugin on blocks of at most kMaxBlockFrames frames, see
+    // lv2effectprocessor.cpp.
+    void runBlocks(LV2EffectGroupState* pState,
+            const CSAMPLE* const* pInputChannels,
+            CSAMPLE* const* pOutputChannels,
+            SINT numFrames);
 
     QList<EngineEffectParameter*> m_parameters;
-    float* m_inputL;
-    float* m_inputR;
-    float* m_outputL;
-    float* m_outputR;
-    float* m_params;
+    // Continuous parameters are ramped over the blocks of a buffer, stepped
+    // parameters are applied with the first block.
+    QList<bool> m_interpolateParameters;
     const LilvPlugin* m_pPlugin;
     const QList<int> m_audioPortIndices;
     const QList<int> m_controlPortIndices;
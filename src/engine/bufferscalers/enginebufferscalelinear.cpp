@@ -1,28 +1,211 @@
 #include "engine/bufferscalers/enginebufferscalelinear.h"
 
 #include <QtDebug>
+#include <cstring>
 
 #include "track/keyutils.h"
 #include "util/assert.h"
 #include "util/math.h"
 #include "util/sample.h"
 
+namespace {
+
+// Stereo
+const SINT kChannels = 2;
+
+// Enough for the taps in front of the lowest position after reading more
+// samples, which is up to lookaheadFrames() before the new buffer.
+const SINT kHistoryFrames = 8;
+const SINT kHistorySamples = kHistoryFrames * kChannels;
+
+// The number of frames after the floor of the position that are needed for
+// interpolating.
+SINT lookaheadFrames(EngineBufferScaleLinear::Quality quality) {
+    switch (quality) {
+    case EngineBufferScaleLinear::Quality::CubicHermite:
+        return 2;
+    case EngineBufferScaleLinear::Quality::Sinc8:
+        return 4;
+    case EngineBufferScaleLinear::Quality::Linear:
+    default:
+        return 1;
+    }
+}
+
+const int kSincTaps = 8;
+const int kSincPhases = 512;
+
+// Lanczos windowed sinc
+double lanczos(double x) {
+    const double width = kSincTaps / 2;
+    if (x == 0.0) {
+        return 1.0;
+    }
+    if (x == floor(x) || fabs(x) >= width) {
+        // Exact zeros, so integer positions reproduce the input
+        return 0.0;
+    }
+    const double pix = M_PI * x;
+    return width * sin(pix) * sin(pix / width) / (pix * pix);
+}
+
+// The coefficients of the windowed sinc for fractional positions in steps
+// of 1 / kSincPhases, normalized for unity gain.
+struct SincTable {
+    SincTable() {
+        for (int phase = 0; phase <= kSincPhases; ++phase) {
+            const double frac = static_cast<double>(phase) / kSincPhases;
+            double taps[kSincTaps];
+            double sum = 0.0;
+            for (int tap = 0; tap < kSincTaps; ++tap) {
+                taps[tap] = lanczos((tap - (kSincTaps / 2 - 1)) - frac);
+                sum += taps[tap];
+            }
+            for (int tap = 0; tap < kSincTaps; ++tap) {
+                // Interleaved like the samples of a stereo frame
+                coefficients[phase][tap * kChannels] =
+                        static_cast<CSAMPLE>(taps[tap] / sum);
+                coefficients[phase][tap * kChannels + 1] =
+                        static_cast<CSAMPLE>(taps[tap] / sum);
+            }
+        }
+    }
+
+    alignas(16) CSAMPLE coefficients[kSincPhases + 1][kSincTaps * kChannels];
+};
+
+const SincTable& sincTable() {
+    static const SincTable s_table;
+    return s_table;
+}
+
+// laurent de soras - punked from musicdsp.org (mad props)
+inline float hermite4(float frac_pos, float xm1, float x0, float x1, float x2)
+{
+    const float c = (x1 - xm1) * 0.5f;
+    const float v = x0 - x1;
+    const float w = c + v;
+    const float a = w + v + (x2 - x0) * 0.5f;
+    const float b_neg = w + a;
+    return ((((a * frac_pos) - b_neg) * frac_pos + c) * frac_pos + x0);
+}
+
+// The interpolators calculate a stereo output frame from the input frame at
+// the floor of the position and its neighbors.
+
+struct LinearInterpolator {
+    void operator()(CSAMPLE* pOut, const CSAMPLE* pFrame, CSAMPLE frac) const {
+        pOut[0] = pFrame[0] + frac * (pFrame[2] - pFrame[0]);
+        pOut[1] = pFrame[1] + frac * (pFrame[3] - pFrame[1]);
+    }
+};
+
+struct CubicHermiteInterpolator {
+    void operator()(CSAMPLE* pOut, const CSAMPLE* pFrame, CSAMPLE frac) const {
+        pOut[0] = hermite4(frac, pFrame[-2], pFrame[0], pFrame[2], pFrame[4]);
+        pOut[1] = hermite4(frac, pFrame[-1], pFrame[1], pFrame[3], pFrame[5]);
+    }
+};
+
+struct SincInterpolator {
+    void operator()(CSAMPLE* pOut, const CSAMPLE* pFrame, CSAMPLE frac) const {
+        const CSAMPLE* pCoefficients = table.coefficients[
+                static_cast<int>(frac * kSincPhases + 0.5f)];
+        const CSAMPLE* pTaps = pFrame - (kSincTaps / 2 - 1) * kChannels;
+        CSAMPLE products[kSincTaps * kChannels];
+        // note: LOOP VECTORIZED.
+        for (int i = 0; i < kSincTaps * kChannels; ++i) {
+            products[i] = pCoefficients[i] * pTaps[i];
+        }
+        // Sum up pairwise, which keeps the channels apart
+        for (int width = kSincTaps; width >= kChannels; width /= 2) {
+            for (int i = 0; i < width; ++i) {
+                products[i] += products[i + width];
+            }
+        }
+        pOut[0] = products[0];
+        pOut[1] = products[1];
+    }
+
+    const SincTable& table;
+};
+
+// Renders frames from the input without any bounds checks. With a constant
+// rate the position is the only state that is carried from frame to frame.
+template<typename Interpolator, bool kRamp>
+void interpolateFrames(
+        CSAMPLE* pOutput,
+        const CSAMPLE* pInput,
+        SINT frames,
+        double* pCurrentFrame,
+        double* pNextFrame,
+        double* pRateAdd,
+        double rateDelta,
+        const Interpolator& interpolator) {
+    double currentFrame = *pCurrentFrame;
+    double nextFrame = *pNextFrame;
+    double rateAdd = *pRateAdd;
+    for (SINT i = 0; i < frames; ++i) {
+        currentFrame = nextFrame;
+        const SINT currentFrameFloor = static_cast<SINT>(floor(currentFrame));
+        // For the current index, what percentage is it
+        // between the previous and the next?
+        const CSAMPLE frac = static_cast<CSAMPLE>(currentFrame) - currentFrameFloor;
+        interpolator(&pOutput[i * kChannels], &pInput[currentFrameFloor * kChannels], frac);
+        // increment the index for the next loop
+        nextFrame = currentFrame + rateAdd;
+        if (kRamp) {
+            // Smooth any changes in the playback rate over one buf_size
+            // samples. This prevents the change from being discontinuous and
+            // helps improve sound quality.
+            rateAdd += rateDelta;
+        }
+    }
+    *pCurrentFrame = currentFrame;
+    *pNextFrame = nextFrame;
+    *pRateAdd = rateAdd;
+}
+
+template<typename Interpolator>
+void interpolateFrames(
+        CSAMPLE* pOutput,
+        const CSAMPLE* pInput,
+        SINT frames,
+        double* pCurrentFrame,
+        double* pNextFrame,
+        double* pRateAdd,
+        double rateDelta,
+        const Interpolator& interpolator) {
+    if (rateDelta == 0) {
+        interpolateFrames<Interpolator, false>(pOutput, pInput, frames,
+                pCurrentFrame, pNextFrame, pRateAdd, rateDelta, interpolator);
+    } else {
+        interpolateFrames<Interpolator, true>(pOutput, pInput, frames,
+                pCurrentFrame, pNextFrame, pRateAdd, rateDelta, interpolator);
+    }
+}
+
+} // anonymous namespace
+
 EngineBufferScaleLinear::EngineBufferScaleLinear(ReadAheadManager *pReadAheadManager)
     : m_pReadAheadManager(pReadAheadManager),
-      m_bufferInt(SampleUtil::alloc(kiLinearScaleReadAheadLength)),
+      m_pHistoryAndBufferInt(SampleUtil::alloc(kHistorySamples + kiLinearScaleReadAheadLength)),
+      m_bufferInt(m_pHistoryAndBufferInt + kHistorySamples),
       m_bufferIntSize(0),
+      m_requestedQuality(Quality::Linear),
+      m_quality(Quality::Linear),
       m_bClear(false),
       m_dRate(1.0),
       m_dOldRate(1.0),
       m_dCurrentFrame(0.0),
       m_dNextFrame(0.0) {
-    m_floorSampleOld[0] = 0.0;
-    m_floorSampleOld[1] = 0.0;
-    SampleUtil::clear(m_bufferInt, kiLinearScaleReadAheadLength);
+    SampleUtil::clear(m_pHistoryAndBufferInt, kHistorySamples + kiLinearScaleReadAheadLength);
+    // Calculate the coefficients outside of the engine thread
+    sincTable();
 }
 
 EngineBufferScaleLinear::~EngineBufferScaleLinear() {
-    SampleUtil::free(m_bufferInt);
+    SampleUtil::free(m_pHistoryAndBufferInt);
 }
 
 void EngineBufferScaleLinear::setScaleParameters(double base_rate,
@@ -39,19 +222,41 @@ void EngineBufferScaleLinear::clear() {
     // Clear out buffer and saved sample data
     m_bufferIntSize = 0;
     m_dNextFrame = 0;
-    m_floorSampleOld[0] = 0;
-    m_floorSampleOld[1] = 0;
+    SampleUtil::clear(m_pHistoryAndBufferInt, kHistorySamples);
 }
 
-// laurent de soras - punked from musicdsp.org (mad props)
-inline float hermite4(float frac_pos, float xm1, float x0, float x1, float x2)
-{
-    const float c = (x1 - xm1) * 0.5f;
-    const float v = x0 - x1;
-    const float w = c + v;
-    const float a = w + v + (x2 - x0) * 0.5f;
-    const float b_neg = w + a;
-    return ((((a * frac_pos) - b_neg) * frac_pos + c) * frac_pos + x0);
+void EngineBufferScaleLinear::appendHistory(const CSAMPLE* pSamples, SINT samples) {
+    if (samples >= kHistorySamples) {
+        SampleUtil::copy(m_pHistoryAndBufferInt,
+                pSamples + samples - kHistorySamples,
+                kHistorySamples);
+    } else if (samples > 0) {
+        memmove(m_pHistoryAndBufferInt,
+                m_pHistoryAndBufferInt + samples,
+                sizeof(CSAMPLE) * (kHistorySamples - samples));
+        SampleUtil::copy(m_pHistoryAndBufferInt + kHistorySamples - samples,
+                pSamples,
+                samples);
+    }
+}
+
+void EngineBufferScaleLinear::reverseHistory() {
+    // The frames ahead of the position become the history in the other
+    // direction. Without them we continue with the frame of the last
+    // position.
+    SINT nextFrame = static_cast<SINT>(ceil(m_dNextFrame));
+    if (getOutputSignal().frames2samples(nextFrame) + 1 >= m_bufferIntSize) {
+        nextFrame = static_cast<SINT>(floor(m_dCurrentFrame));
+    }
+    const SINT lastFrame = getOutputSignal().samples2frames(m_bufferIntSize) - 1;
+    CSAMPLE reversed[kHistorySamples];
+    for (SINT i = 0; i < kHistoryFrames; ++i) {
+        const SINT frame = math_clamp(nextFrame + i, -kHistoryFrames, lastFrame);
+        CSAMPLE* pReversedFrame = &reversed[kHistorySamples - (i + 1) * kChannels];
+        pReversedFrame[0] = m_bufferInt[frame * kChannels];
+        pReversedFrame[1] = m_bufferInt[frame * kChannels + 1];
+    }
+    SampleUtil::copy(m_pHistoryAndBufferInt, reversed, kHistorySamples);
 }
 
 // Determine if we're changing directions (scratching) and then perform
@@ -67,6 +272,7 @@ double EngineBufferScaleLinear::scaleBuffer(
         m_dOldRate = m_dRate;  // If cleared, don't interpolate rate.
         m_bClear = false;
     }
+    m_quality = m_requestedQuality.load();
     float rate_add_old = m_dOldRate;  // Smoothly interpolate to new playback rate
     float rate_add_new = m_dRate;
     SINT frames_read = 0;
@@ -81,13 +287,9 @@ double EngineBufferScaleLinear::scaleBuffer(
         m_dRate = 0.0;
         frames_read += do_scale(pOutputBuffer, getOutputSignal().samples2frames(iOutputBufferSize));
 
-        // reset m_floorSampleOld in a way as we were coming from
+        // reset the history in a way as we were coming from
         // the other direction
-        SINT iNextSample = getOutputSignal().frames2samples(static_cast<SINT>(ceil(m_dNextFrame)));
-        if (iNextSample + 1 < m_bufferIntSize) {
-            m_floorSampleOld[0] = m_bufferInt[iNextSample];
-            m_floorSampleOld[1] = m_bufferInt[iNextSample + 1];
-        }
+        reverseHistory();
 
         // if the buffer has extra samples, do a read so RAMAN ends up back where
         // it should be
@@ -168,10 +370,7 @@ SINT EngineBufferScaleLinear::do_copy(CSAMPLE* buf, SINT buf_size) {
     // blow away the fractional sample position here
     m_bufferIntSize = 0; // force buffer read
     m_dNextFrame = 0;
-    if (read_samples > 1) {
-        m_floorSampleOld[0] = buf[read_samples - 2];
-        m_floorSampleOld[1] = buf[read_samples - 1];
-    }
+    appendHistory(buf, read_samples);
     return read_samples;
 }
 
@@ -218,61 +417,29 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
     // m_dNextFrame and frames are greater than one"
     SINT unscaled_frames_needed = static_cast<SINT>(frames +
             m_dNextFrame - floor(m_dNextFrame));
+    // The wider kernels need a few more frames after the last position
+    const SINT lookahead_frames = lookaheadFrames(m_quality);
+    unscaled_frames_needed += lookahead_frames - 1;
 
     int read_failed_count = 0;
-    CSAMPLE floor_sample[2];
-    CSAMPLE ceil_sample[2];
-
-    floor_sample[0] = 0;
-    floor_sample[1] = 0;
-    ceil_sample[0] = 0;
-    ceil_sample[1] = 0;
-
     SINT frames_read = 0;
     SINT i = 0;
-    //int screwups_debug = 0;
 
     double rate_add = fabs(rate_old);
     const double rate_delta_abs =
             rate_old < 0 || rate_new < 0 ? -rate_delta : rate_delta;
+    // The rate is ramped monotonically, so no frame advances further
+    const double rate_add_max = math_max(fabs(rate_old), fabs(rate_new));
 
-    // Hot frame loop
     while (i < buf_size) {
-        // shift indices
-        m_dCurrentFrame = m_dNextFrame;
-
         // Because our index is a float value, we're going to be interpolating
-        // between two samples, a lower (prev) and upper (cur) sample.
-        // If the lower sample is off the end of the buffer (values between
-        // -.999 and 0), load it from the saved globals.
-
-        // The first bounds check (< m_bufferIntSize) is probably not needed.
-
-        SINT currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
-
-        if (currentFrameFloor < 0) {
-            // we have advanced to a new buffer in the previous run,
-            // but the floor still points to the old buffer
-            // so take the cached sample, this happens on slow rates
-            floor_sample[0] = m_floorSampleOld[0];
-            floor_sample[1] = m_floorSampleOld[1];
-            ceil_sample[0] = m_bufferInt[0];
-            ceil_sample[1] = m_bufferInt[1];
-        } else if (getOutputSignal().frames2samples(currentFrameFloor) + 3 < m_bufferIntSize) {
-            // take floor_sample form the buffer of the previous run
-            floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-            floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
-            ceil_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 2];
-            ceil_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 3];
-        } else {
-            // if we don't have the ceil_sample in buffer, load some more
-
-            if (getOutputSignal().frames2samples(currentFrameFloor) + 1 < m_bufferIntSize) {
-                // take floor_sample form the buffer of the previous run
-                floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-                floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
-            }
+        // between samples around the floor of the index. Frames before the
+        // buffer (values down to -kHistoryFrames) are taken from the history.
+        SINT nextFrameFloor = static_cast<SINT>(floor(m_dNextFrame));
 
+        if (nextFrameFloor + lookahead_frames >=
+                getOutputSignal().samples2frames(m_bufferIntSize)) {
+            // if we don't have the frames after the floor in buffer, load some more
             do {
                 SINT old_bufsize = m_bufferIntSize;
                 if (unscaled_frames_needed == 0) {
@@ -285,6 +452,7 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
                         kiLinearScaleReadAheadLength,
                         getOutputSignal().frames2samples(unscaled_frames_needed));
 
+                appendHistory(m_bufferInt, old_bufsize);
                 m_bufferIntSize = m_pReadAheadManager->getNextSamples(
                         rate_new == 0 ? rate_old : rate_new,
                         m_bufferInt, samples_to_read);
@@ -300,49 +468,59 @@ SINT EngineBufferScaleLinear::do_scale(CSAMPLE* buf, SINT buf_size) {
                 frames_read += getOutputSignal().samples2frames(m_bufferIntSize);
                 unscaled_frames_needed -= getOutputSignal().samples2frames(m_bufferIntSize);
 
-                // adapt the m_dCurrentFrame the index of the new buffer
+                // adapt the indexes to the new buffer
                 m_dCurrentFrame -= getOutputSignal().samples2frames(old_bufsize);
-                currentFrameFloor = static_cast<SINT>(floor(m_dCurrentFrame));
-            } while (getOutputSignal().frames2samples(currentFrameFloor) + 3 >= m_bufferIntSize);
+                m_dNextFrame -= getOutputSignal().samples2frames(old_bufsize);
+                nextFrameFloor = static_cast<SINT>(floor(m_dNextFrame));
+            } while (nextFrameFloor + lookahead_frames >=
+                    getOutputSignal().samples2frames(m_bufferIntSize));
 
             // I guess?
             if (read_failed_count > 1) {
                 break;
             }
-
-            // Now that the buffer is up to date, we can get the value of the sample
-            // at the floor of our position.
-            if (currentFrameFloor >= 0) {
-                // the previous position is in the new buffer
-                floor_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor)];
-                floor_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 1];
-            }
-            ceil_sample[0] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 2];
-            ceil_sample[1] = m_bufferInt[getOutputSignal().frames2samples(currentFrameFloor) + 3];
         }
 
-        // For the current index, what percentage is it
-        // between the previous and the next?
-        CSAMPLE frac = static_cast<CSAMPLE>(m_dCurrentFrame) - currentFrameFloor;
-
-        // Perform linear interpolation
-        buf[i] = floor_sample[0] + frac * (ceil_sample[0] - floor_sample[0]);
-        buf[i + 1] = floor_sample[1] + frac * (ceil_sample[1] - floor_sample[1]);
-
-        m_floorSampleOld[0] = floor_sample[0];
-        m_floorSampleOld[1] = floor_sample[1];
-
-        // increment the index for the next loop
-        m_dNextFrame = m_dCurrentFrame + rate_add;
-
-        // Smooth any changes in the playback rate over one buf_size
-        // samples. This prevents the change from being discontinuous and helps
-        // improve sound quality.
-        rate_add += rate_delta_abs;
-        i += getOutputSignal().getChannelCount();
+        // Render all frames whose interpolation only needs buffered frames
+        // in one go. One frame of tolerance covers the rounding of the
+        // accumulated rate.
+        // Includes a trailing partial frame
+        const SINT remaining_frames = getOutputSignal().samples2frames(
+                buf_size - i + getOutputSignal().getChannelCount() - 1);
+        SINT run_frames = remaining_frames;
+        if (rate_add_max > 0) {
+            const double available_frames =
+                    getOutputSignal().samples2frames(m_bufferIntSize) -
+                    lookahead_frames - m_dNextFrame - 1.0;
+            run_frames = static_cast<SINT>(math_clamp(
+                    available_frames / rate_add_max,
+                    1.0,
+                    static_cast<double>(remaining_frames)));
+        }
+        interpolate(&buf[i], run_frames, &rate_add, rate_delta_abs);
+        i += getOutputSignal().frames2samples(run_frames);
     }
 
     SampleUtil::clear(&buf[i], buf_size - i);
 
     return frames_read;
 }
+
+void EngineBufferScaleLinear::interpolate(
+        CSAMPLE* buf, SINT frames, double* pRateAdd, double rateDelta) {
+    switch (m_quality) {
+    case Quality::CubicHermite:
+        interpolateFrames(buf, m_bufferInt, frames, &m_dCurrentFrame, &m_dNextFrame,
+                pRateAdd, rateDelta, CubicHermiteInterpolator());
+        break;
+    case Quality::Sinc8:
+        interpolateFrames(buf, m_bufferInt, frames, &m_dCurrentFrame, &m_dNextFrame,
+                pRateAdd, rateDelta, SincInterpolator{sincTable()});
+        break;
+    case Quality::Linear:
+    default:
+        interpolateFrames(buf, m_bufferInt, frames, &m_dCurrentFrame, &m_dNextFrame,
+                pRateAdd, rateDelta, LinearInterpolator());
+        break;
+    }
+}
@@ -1,6 +1,8 @@
 #ifndef ENGINEBUFFERSCALELINEAR_H
 #define ENGINEBUFFERSCALELINEAR_H
 
+#include <atomic>
+
 #include "engine/bufferscalers/enginebufferscale.h"
 #include "engine/readaheadmanager.h"
 
@@ -8,8 +10,19 @@
 const int kiLinearScaleReadAheadLength = 10240;
 
 
+// Resamples without keylock. Despite its name the interpolation can be
+// switched between linear, cubic Hermite and an 8-tap windowed sinc. The
+// frames that are needed by the interpolation are kept in front of the read
+// ahead buffer, so the inner loops render whole runs of frames without any
+// branches for buffer boundaries.
 class EngineBufferScaleLinear : public EngineBufferScale  {
   public:
+    enum class Quality {
+        Linear = 0,
+        CubicHermite = 1,
+        Sinc8 = 2,
+    };
+
     explicit EngineBufferScaleLinear(
             ReadAheadManager *pReadAheadManager);
     ~EngineBufferScaleLinear() override;
@@ -23,20 +36,37 @@ class EngineBufferScaleLinear : public EngineBufferScale  {
                             double* pTempoRatio,
                              double* pPitchRatio) override;
 
+    // Thread-safe, takes effect with the next buffer
+    void setQuality(Quality quality) {
+        m_requestedQuality.store(quality);
+    }
+
   private:
     void onSampleRateChanged() override {}
 
     SINT do_scale(CSAMPLE* buf, SINT buf_size);
     SINT do_copy(CSAMPLE* buf, SINT buf_size);
 
+    // Renders frames from the buffered input starting at m_dNextFrame
+    // without any bounds checks
+    void interpolate(CSAMPLE* buf, SINT frames, double* pRateAdd, double rateDelta);
+
+    // Keeps the last frames of the given samples in front of the input
+    void appendHistory(const CSAMPLE* pSamples, SINT samples);
+    // Prepares the history for reading into the other direction
+    void reverseHistory();
+
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
-    // Buffer for handling calls to ReadAheadManager
+    // Buffer for handling calls to ReadAheadManager. Starts with the
+    // history of the frames that have been read before m_bufferInt.
+    CSAMPLE* m_pHistoryAndBufferInt;
     CSAMPLE* m_bufferInt;
     SINT m_bufferIntSize;
 
-    CSAMPLE m_floorSampleOld[2];
+    std::atomic<Quality> m_requestedQuality;
+    Quality m_quality;
 
     bool m_bClear;
     double m_dRate;
@@ -0,0 +1,467 @@
+#include "engine/bufferscalers/enginebufferscalelookahead.h"
+
+#include <QtDebug>
+
+#include "engine/engineworkerscheduler.h"
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+// Stretched ahead at least, which covers the worst case timing of the worker
+// with some room. Larger buffers are stretched ahead by two callbacks.
+const SINT kLookAheadFrames = 2048;
+const int kStretchedChunks = 128;
+
+// The stretchers request more input than they return output now and then,
+// so the worker only stretches a chunk if it is sure that they do not run
+// out of input. Otherwise they would flush themselves like at the end of
+// the track.
+const SINT kInputMarginFrames = 4096;
+const SINT kInputSamples = 131072;
+
+// The number of callbacks with unchanged parameters before the stretcher is
+// handed over to the worker
+const int kSteadyCallbacks = 8;
+
+// Relative changes of the rate or pitch that are stretched with the delay of
+// the frames ahead
+const double kMaxSteadyChange = 0.02;
+
+} // anonymous namespace
+
+EngineBufferScaleLookAheadWorker::EngineBufferScaleLookAheadWorker(
+        EngineBufferScaleLookAhead* pLookAhead)
+        : m_pLookAhead(pLookAhead),
+          m_stop(false) {
+}
+
+void EngineBufferScaleLookAheadWorker::run() {
+    unsigned static id = 0; //the id of this thread, for debugging purposes
+    QThread::currentThread()->setObjectName(
+            QString("EngineBufferScaleLookAheadWorker %1").arg(++id));
+
+    while (!m_stop.load()) {
+        if (!m_pLookAhead->stretchAhead()) {
+            m_semaRun.acquire();
+        }
+    }
+}
+
+bool EngineBufferScaleLookAheadWorker::isIdle() {
+    return !m_pLookAhead->hasWorkAhead();
+}
+
+void EngineBufferScaleLookAheadWorker::quitWait() {
+    m_stop.store(true);
+    m_semaRun.release();
+    wait();
+}
+
+EngineBufferScaleLookAhead::EngineBufferScaleLookAhead(
+        ReadAheadManager* pReadAheadManager)
+        : m_pReadAheadManager(pReadAheadManager),
+          m_inputReader(this),
+          m_pScheduler(nullptr),
+          m_active(0),
+          // Never set by the engine, so the first parameters are applied
+          m_parameters{-1.0, 1.0, 1.0},
+          m_steadyCallbacks(0),
+          m_chunkReadFrames(0),
+          m_session(0),
+          m_playableChunks(-1),
+          m_underflowCount(0),
+          m_input(kInputSamples),
+          m_targetChunks(0),
+          m_workerSession(0),
+          m_pWorkerStretcher(nullptr),
+          m_stretched(kStretchedChunks),
+          m_state(State::Engine),
+          m_worker(this) {
+    m_workerParameters.setValue(m_parameters);
+    m_worker.start(QThread::HighPriority);
+}
+
+EngineBufferScaleLookAhead::~EngineBufferScaleLookAhead() {
+    if (m_pScheduler) {
+        m_pScheduler->removeWorker(&m_worker);
+    }
+    m_worker.quitWait();
+}
+
+void EngineBufferScaleLookAhead::setScheduler(EngineWorkerScheduler* pScheduler) {
+    m_worker.setScheduler(pScheduler);
+    m_pScheduler = pScheduler;
+}
+
+void EngineBufferScaleLookAhead::setScales(
+        std::unique_ptr<EngineBufferScale> pScale,
+        std::unique_ptr<EngineBufferScale> pSpareScale) {
+    DEBUG_ASSERT(m_state.load() == State::Engine);
+    DEBUG_ASSERT(!m_stretchers[0].pScale && !m_stretchers[1].pScale);
+    m_stretchers[0].pScale = std::move(pScale);
+    m_stretchers[1].pScale = std::move(pSpareScale);
+    for (auto& stretcher : m_stretchers) {
+        stretcher.appliedParameters = ScaleParameters{-1.0, 1.0, 1.0};
+        if (getOutputSignal().isValid()) {
+            stretcher.pScale->setSampleRate(getOutputSignal().getSampleRate());
+        }
+        stretcher.pScale->clear();
+    }
+    m_active = 0;
+    clear();
+    applyParameters(&m_stretchers[m_active], m_parameters);
+}
+
+void EngineBufferScaleLookAhead::onSampleRateChanged() {
+    clear();
+    // The abandoned stretcher gets the sample rate when it is released
+    for (int i = 0; i < 2; ++i) {
+        if (m_stretchers[i].pScale &&
+                (i == m_active || m_state.load() == State::Engine)) {
+            m_stretchers[i].pScale->setSampleRate(getOutputSignal().getSampleRate());
+        }
+    }
+}
+
+void EngineBufferScaleLookAhead::setScaleParameters(double base_rate,
+                                                    double* pTempoRatio,
+                                                    double* pPitchRatio) {
+    const ScaleParameters parameters{base_rate, *pTempoRatio, *pPitchRatio};
+    if (parameters != m_parameters) {
+        m_parameters = parameters;
+        m_workerParameters.setValue(parameters);
+        if (!isWorkerOwner() && activeScale()) {
+            // Passing the pointers lets the stretcher adjust the parameters
+            m_steadyCallbacks = 0;
+            m_stretchers[m_active].appliedParameters = parameters;
+            activeScale()->setScaleParameters(base_rate, pTempoRatio, pPitchRatio);
+        }
+    }
+    EngineBufferScale::setScaleParameters(base_rate, pTempoRatio, pPitchRatio);
+}
+
+bool EngineBufferScaleLookAhead::isRateJump(double base_rate,
+                                            double tempoRatio,
+                                            double pitchRatio) const {
+    if (!isWorkerOwner() && m_stretched.readAvailable() == 0) {
+        // Nothing ahead that could delay the change
+        return false;
+    }
+    const double rate = m_parameters.baseRate * m_parameters.tempoRatio;
+    if (rate == 0.0 || m_parameters.pitchRatio == 0.0) {
+        return true;
+    }
+    return fabs(base_rate * tempoRatio / rate - 1.0) > kMaxSteadyChange ||
+            fabs(pitchRatio / m_parameters.pitchRatio - 1.0) > kMaxSteadyChange;
+}
+
+SINT EngineBufferScaleLookAhead::stretchedAheadFrames() const {
+    int chunks = m_stretched.readAvailable();
+    if (m_playableChunks >= 0) {
+        chunks = math_min(chunks, m_playableChunks);
+    }
+    if (chunks == 0) {
+        return 0;
+    }
+    return chunks * kChunkFrames - m_chunkReadFrames;
+}
+
+void EngineBufferScaleLookAhead::clear() {
+    reclaimReleasedStretcher();
+    takeOver();
+    // Chunks that the worker finishes after this are discarded
+    ++m_session;
+    m_playableChunks = -1;
+    m_stretched.flushReadData(m_stretched.readAvailable());
+    m_chunkReadFrames = 0;
+    if (m_state.load() == State::Engine) {
+        // Otherwise the input is dropped when the worker has released the
+        // abandoned stretcher
+        m_input.flushReadData(m_input.readAvailable());
+    }
+    m_steadyCallbacks = 0;
+    if (activeScale()) {
+        activeScale()->clear();
+    }
+}
+
+bool EngineBufferScaleLookAhead::prepareScaleBuffer(SINT iOutputBufferSize) {
+    reclaimReleasedStretcher();
+    if (!isWorkerOwner() ||
+            stretchedAheadFrames() >= getOutputSignal().samples2frames(iOutputBufferSize)) {
+        return true;
+    }
+    ++m_underflowCount;
+    return takeOver();
+}
+
+double EngineBufferScaleLookAhead::scaleBuffer(
+        CSAMPLE* pOutputBuffer,
+        SINT iOutputBufferSize) {
+    VERIFY_OR_DEBUG_ASSERT(activeScale()) {
+        SampleUtil::clear(pOutputBuffer, iOutputBufferSize);
+        return 0.0;
+    }
+    reclaimReleasedStretcher();
+
+    const SINT frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    double framesRead = 0.0;
+    // Frames that are left over from the worker always come first
+    SINT stretchedFrames = readStretched(pOutputBuffer, frames, &framesRead);
+    if (stretchedFrames < frames && isWorkerOwner()) {
+        // The worker has not kept up. Chunks that have been finished in the
+        // meantime are played even if the stretcher has been abandoned.
+        ++m_underflowCount;
+        takeOver();
+        stretchedFrames += readStretched(
+                pOutputBuffer + getOutputSignal().frames2samples(stretchedFrames),
+                frames - stretchedFrames,
+                &framesRead);
+        Counter counter("EngineBufferScaleLookAhead underflow");
+        counter.increment();
+    }
+    if (stretchedFrames < frames) {
+        // Continues with the input that has been read ahead for the worker
+        // or with the spare stretcher if the worker is busy, which reads
+        // from the ReadAheadManager directly
+        framesRead += activeScale()->scaleBuffer(
+                pOutputBuffer + getOutputSignal().frames2samples(stretchedFrames),
+                getOutputSignal().frames2samples(frames - stretchedFrames));
+    }
+
+    const State state = m_state.load();
+    if (m_pScheduler &&
+            (state == State::Engine || isWorkerOwner()) &&
+            m_parameters.baseRate * m_parameters.tempoRatio != 0.0) {
+        if (m_steadyCallbacks < kSteadyCallbacks) {
+            ++m_steadyCallbacks;
+        }
+        if (m_steadyCallbacks >= kSteadyCallbacks) {
+            readInputAhead(frames);
+            handOver();
+        }
+    }
+    return framesRead;
+}
+
+SINT EngineBufferScaleLookAhead::readStretched(
+        CSAMPLE* pOutput, SINT frames, double* pFramesRead) {
+    SINT framesDone = 0;
+    while (framesDone < frames) {
+        StretchedChunk* pChunk;
+        ring_buffer_size_t size1;
+        StretchedChunk* pChunk2;
+        ring_buffer_size_t size2;
+        if (m_stretched.aquireReadRegions(1, &pChunk, &size1, &pChunk2, &size2) < 1) {
+            break;
+        }
+        if (pChunk->session != m_session || m_playableChunks == 0) {
+            // Finished by the worker after the engine has moved on
+            m_stretched.releaseReadRegions(1);
+            m_chunkReadFrames = 0;
+            continue;
+        }
+        const SINT chunkFrames = math_min(
+                kChunkFrames - m_chunkReadFrames, frames - framesDone);
+        SampleUtil::copy(
+                pOutput + getOutputSignal().frames2samples(framesDone),
+                pChunk->samples + getOutputSignal().frames2samples(m_chunkReadFrames),
+                getOutputSignal().frames2samples(chunkFrames));
+        *pFramesRead += pChunk->framesRead * chunkFrames / kChunkFrames;
+        framesDone += chunkFrames;
+        m_chunkReadFrames += chunkFrames;
+        if (m_chunkReadFrames == kChunkFrames) {
+            m_stretched.releaseReadRegions(1);
+            m_chunkReadFrames = 0;
+            if (m_playableChunks > 0) {
+                --m_playableChunks;
+            }
+        }
+    }
+    return framesDone;
+}
+
+void EngineBufferScaleLookAhead::readInputAhead(SINT callbackFrames) {
+    const int targetChunks = static_cast<int>(math_min<SINT>(
+            (math_max(kLookAheadFrames, 2 * callbackFrames) + kChunkFrames - 1) /
+                    kChunkFrames,
+            kStretchedChunks - 1));
+    m_targetChunks.store(targetChunks);
+
+    // Enough input for stretching one chunk more than the target
+    const double rate = m_parameters.baseRate * m_parameters.tempoRatio;
+    const SINT targetFrames = static_cast<SINT>(
+            ceil((targetChunks + 1) * kChunkFrames * fabs(rate))) + kInputMarginFrames;
+    const SINT samplesToRead = math_min<SINT>(
+            getOutputSignal().frames2samples(targetFrames) - m_input.readAvailable(),
+            m_input.writeAvailable());
+    if (samplesToRead <= 0) {
+        return;
+    }
+
+    CSAMPLE* pRegions[2];
+    ring_buffer_size_t regionSizes[2];
+    m_input.aquireWriteRegions(samplesToRead,
+            &pRegions[0], &regionSizes[0], &pRegions[1], &regionSizes[1]);
+    SINT samplesRead = 0;
+    for (int i = 0; i < 2; ++i) {
+        SINT regionRead = 0;
+        while (regionRead < regionSizes[i]) {
+            const SINT read = m_pReadAheadManager->getNextSamples(
+                    rate, pRegions[i] + regionRead, regionSizes[i] - regionRead);
+            if (read <= 0) {
+                break;
+            }
+            regionRead += read;
+        }
+        samplesRead += regionRead;
+        if (regionRead < regionSizes[i]) {
+            break;
+        }
+    }
+    m_input.releaseWriteRegions(samplesRead);
+}
+
+SINT EngineBufferScaleLookAhead::readInput(
+        double dRate, CSAMPLE* pBuffer, SINT samples) {
+    if (QThread::currentThread() == &m_worker) {
+        // The worker only stretches as far as the input has been read ahead
+        return m_input.read(pBuffer, samples);
+    }
+    SINT samplesRead = 0;
+    if (m_state.load() == State::Engine) {
+        // Continues with the input that has been read ahead for the worker.
+        // The spare stretcher of an abandoned one starts at the playhead
+        // instead.
+        samplesRead = m_input.read(pBuffer, samples);
+    }
+    if (samplesRead < samples) {
+        samplesRead += m_pReadAheadManager->getNextSamples(
+                dRate, pBuffer + samplesRead, samples - samplesRead);
+    }
+    return samplesRead;
+}
+
+void EngineBufferScaleLookAhead::handOver() {
+    if (m_state.load() == State::Engine) {
+        // Nothing is left from the previous hand-over
+        ++m_session;
+        m_playableChunks = -1;
+        m_pWorkerStretcher = &m_stretchers[m_active];
+        m_workerSession.store(m_session);
+        m_state.store(State::Worker);
+    }
+    m_worker.workReady();
+}
+
+bool EngineBufferScaleLookAhead::takeOver() {
+    State state = m_state.load();
+    // Lock-free: The compare-and-swap only fails if the worker has started
+    // or finished a chunk in the meantime
+    while (state == State::Worker || state == State::Stretching) {
+        if (state == State::Worker) {
+            if (m_state.compare_exchange_weak(state, State::Engine)) {
+                // The worker is between two chunks and the stretcher
+                // continues with the input that has been read ahead
+                applyParameters(&m_stretchers[m_active], m_parameters);
+                return true;
+            }
+        } else if (m_state.compare_exchange_weak(state, State::Abandoned)) {
+            // Waiting for the chunk could overrun the callback. Only the
+            // chunks that are finished already are played.
+            m_playableChunks = m_stretched.readAvailable();
+            m_active = 1 - m_active;
+            applyParameters(&m_stretchers[m_active], m_parameters);
+            Counter counter("EngineBufferScaleLookAhead abandoned");
+            counter.increment();
+            return false;
+        }
+    }
+    return true;
+}
+
+void EngineBufferScaleLookAhead::reclaimReleasedStretcher() {
+    if (m_state.load() != State::Released) {
+        return;
+    }
+    // The worker has finished the chunk and does not touch the abandoned
+    // stretcher or the input anymore, so it becomes the spare one
+    Stretcher* pSpare = &m_stretchers[1 - m_active];
+    if (getOutputSignal().isValid()) {
+        pSpare->pScale->setSampleRate(getOutputSignal().getSampleRate());
+    }
+    pSpare->pScale->clear();
+    m_input.flushReadData(m_input.readAvailable());
+    m_state.store(State::Engine);
+}
+
+// static
+void EngineBufferScaleLookAhead::applyParameters(
+        Stretcher* pStretcher,
+        const ScaleParameters& parameters) {
+    if (!pStretcher->pScale ||
+            parameters == pStretcher->appliedParameters ||
+            parameters.baseRate < 0.0) {
+        return;
+    }
+    pStretcher->appliedParameters = parameters;
+    double tempoRatio = parameters.tempoRatio;
+    double pitchRatio = parameters.pitchRatio;
+    pStretcher->pScale->setScaleParameters(parameters.baseRate, &tempoRatio, &pitchRatio);
+}
+
+bool EngineBufferScaleLookAhead::canStretchAhead() const {
+    if (m_stretched.writeAvailable() < 1 ||
+            m_stretched.readAvailable() >= m_targetChunks.load()) {
+        return false;
+    }
+    const ScaleParameters parameters = m_workerParameters.getValue();
+    const SINT inputFrames = static_cast<SINT>(ceil(kChunkFrames *
+            fabs(parameters.baseRate * parameters.tempoRatio))) + kInputMarginFrames;
+    return m_input.readAvailable() >= getOutputSignal().frames2samples(inputFrames);
+}
+
+bool EngineBufferScaleLookAhead::hasWorkAhead() const {
+    const State state = m_state.load();
+    // An abandoned stretcher is busy until the worker has released it
+    return state == State::Stretching ||
+            state == State::Abandoned ||
+            (state == State::Worker && canStretchAhead());
+}
+
+bool EngineBufferScaleLookAhead::stretchAhead() {
+    State state = State::Worker;
+    if (!m_state.compare_exchange_strong(state, State::Stretching)) {
+        return false;
+    }
+    bool stretched = false;
+    if (canStretchAhead()) {
+        Stretcher* pStretcher = m_pWorkerStretcher;
+        applyParameters(pStretcher, m_workerParameters.getValue());
+
+        StretchedChunk* pChunk;
+        ring_buffer_size_t size1;
+        StretchedChunk* pChunk2;
+        ring_buffer_size_t size2;
+        m_stretched.aquireWriteRegions(1, &pChunk, &size1, &pChunk2, &size2);
+        pChunk->session = m_workerSession.load();
+        pChunk->framesRead = pStretcher->pScale->scaleBuffer(
+                pChunk->samples, getOutputSignal().frames2samples(kChunkFrames));
+        // Published before the engine can take the stretcher back between
+        // two chunks, so it doesn't miss the chunk
+        m_stretched.releaseWriteRegions(1);
+        stretched = true;
+    }
+
+    state = State::Stretching;
+    if (!m_state.compare_exchange_strong(state, State::Worker)) {
+        // The engine has continued with the spare stretcher
+        DEBUG_ASSERT(state == State::Abandoned);
+        m_state.store(State::Released);
+        return false;
+    }
+    return stretched;
+}
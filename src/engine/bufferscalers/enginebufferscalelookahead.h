@@ -0,0 +1,244 @@
+#ifndef ENGINEBUFFERSCALELOOKAHEAD_H
+#define ENGINEBUFFERSCALELOOKAHEAD_H
+
+#include <atomic>
+#include <memory>
+
+#include "control/controlvalue.h"
+#include "engine/bufferscalers/enginebufferscale.h"
+#include "engine/engineworker.h"
+#include "engine/readaheadmanager.h"
+#include "util/fifo.h"
+#include "util/types.h"
+
+class EngineBufferScaleLookAhead;
+class EngineWorkerScheduler;
+
+// Runs the time stretcher of an EngineBufferScaleLookAhead ahead of the
+// playhead whenever the engine has handed it over.
+class EngineBufferScaleLookAheadWorker : public EngineWorker {
+    Q_OBJECT
+  public:
+    explicit EngineBufferScaleLookAheadWorker(
+            EngineBufferScaleLookAhead* pLookAhead);
+    ~EngineBufferScaleLookAheadWorker() override = default;
+
+    void run() override;
+
+    bool isIdle() override;
+
+    void quitWait();
+
+  private:
+    EngineBufferScaleLookAhead* const m_pLookAhead;
+    std::atomic<bool> m_stop;
+};
+
+// Runs a time stretcher like EngineBufferScaleRubberBand or
+// EngineBufferScaleST ahead of the playhead. While the scale parameters are
+// steady, the stretcher is run on a worker thread that keeps a few thousand
+// frames stretched ahead of the playhead. The engine callback then only
+// reads the input ahead from the ReadAheadManager and takes the stretched
+// frames.
+//
+// The active stretcher is owned either by the engine or by the worker and
+// reads its input through getInputReadAheadManager(). The input is queued
+// in order, so the engine can take the stretcher back between two chunks
+// and continue seamlessly, e.g. if the worker has not kept up. The engine
+// never waits for the worker though. If the worker is in the middle of a
+// chunk, the engine abandons the stretcher to the worker and continues with
+// a second, spare stretcher of the same kind, which needs a crossfade and
+// a seek to the playhead, see prepareScaleBuffer(). The worker releases the
+// abandoned stretcher after the chunk and the frames it has stretched are
+// discarded.
+//
+// Small changes of the parameters are passed to the worker and take effect
+// after the frames that have already been stretched. Everything else, like
+// seeks or rate jumps (see isRateJump()), needs clear(), which drops the
+// frames ahead and stretches in the callback again until the parameters
+// are steady. The caller needs to seek the ReadAheadManager to the playhead
+// afterwards.
+class EngineBufferScaleLookAhead : public EngineBufferScale {
+    Q_OBJECT
+  public:
+    explicit EngineBufferScaleLookAhead(
+            ReadAheadManager* pReadAheadManager);
+    ~EngineBufferScaleLookAhead() override;
+
+    // Nothing is stretched ahead before the worker has been bound
+    void setScheduler(EngineWorkerScheduler* pScheduler);
+
+    // The stretchers must read their input from here
+    ReadAheadManager* getInputReadAheadManager() {
+        return &m_inputReader;
+    }
+
+    // Takes two stretchers of the same kind that read their input from
+    // getInputReadAheadManager(). Must be called once before scaling.
+    void setScales(
+            std::unique_ptr<EngineBufferScale> pScale,
+            std::unique_ptr<EngineBufferScale> pSpareScale);
+
+    void setScaleParameters(double base_rate,
+                            double* pTempoRatio,
+                            double* pPitchRatio) override;
+
+    // Returns false if the next buffer can't continue seamlessly, because
+    // the worker has not stretched enough frames ahead and is in the middle
+    // of a chunk. The engine then continues with the spare stretcher right
+    // away and the caller must crossfade, seek to the playhead and clear()
+    // like on a seek.
+    bool prepareScaleBuffer(SINT iOutputBufferSize);
+
+    double scaleBuffer(
+            CSAMPLE* pOutputBuffer,
+            SINT iOutputBufferSize) override;
+
+    // Drops everything that has been read and stretched ahead.
+    void clear() override;
+
+    // Returns true if the frames that are stretched ahead would noticeably
+    // delay a change to the given parameters
+    bool isRateJump(double base_rate,
+                    double tempoRatio,
+                    double pitchRatio) const;
+
+    // The number of frames that are stretched ahead of the playhead
+    SINT stretchedAheadFrames() const;
+
+    // The number of callbacks in which the engine had to take the
+    // stretcher back, because the worker had not stretched enough frames
+    int underflowCount() const {
+        return m_underflowCount;
+    }
+
+    // Called by the worker. Stretches the next chunk ahead and returns
+    // false if there is nothing to do.
+    bool stretchAhead();
+    bool hasWorkAhead() const;
+
+  private:
+    struct ScaleParameters {
+        double baseRate;
+        double tempoRatio;
+        double pitchRatio;
+
+        bool operator==(const ScaleParameters& other) const {
+            return baseRate == other.baseRate &&
+                    tempoRatio == other.tempoRatio &&
+                    pitchRatio == other.pitchRatio;
+        }
+        bool operator!=(const ScaleParameters& other) const {
+            return !(*this == other);
+        }
+    };
+
+    struct Stretcher {
+        std::unique_ptr<EngineBufferScale> pScale;
+        // Only used by the owner of the stretcher
+        ScaleParameters appliedParameters;
+    };
+
+    // The owner of the active stretcher and the input that has been read
+    // ahead. Only the engine leaves the states Engine, Abandoned and
+    // Released and only the worker leaves Worker and Stretching, except
+    // for the compare-and-swap from Worker to Engine or from Stretching to
+    // Abandoned when the engine takes over.
+    enum class State {
+        // The engine stretches in the callback
+        Engine,
+        // Handed over to the worker, which is between two chunks
+        Worker,
+        // The worker is stretching a chunk
+        Stretching,
+        // The engine continues with the spare stretcher while the worker
+        // finishes the chunk of the abandoned one
+        Abandoned,
+        // The worker has finished with the abandoned stretcher
+        Released,
+    };
+
+    // Feeds the stretchers with the input that has been read ahead
+    class InputReader : public ReadAheadManager {
+      public:
+        explicit InputReader(EngineBufferScaleLookAhead* pLookAhead)
+                : m_pLookAhead(pLookAhead) {
+        }
+
+        SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+            return m_pLookAhead->readInput(dRate, buffer, requested_samples);
+        }
+
+      private:
+        EngineBufferScaleLookAhead* const m_pLookAhead;
+    };
+
+    // A chunk of frames stretched by the worker with the number of input
+    // frames that have been consumed for them
+    static constexpr SINT kChunkFrames = 256;
+    struct StretchedChunk {
+        CSAMPLE samples[kChunkFrames * 2];
+        double framesRead;
+        // Chunks of a previous hand-over are discarded
+        int session;
+    };
+
+    void onSampleRateChanged() override;
+
+    EngineBufferScale* activeScale() const {
+        return m_stretchers[m_active].pScale.get();
+    }
+    bool isWorkerOwner() const {
+        const State state = m_state.load();
+        return state == State::Worker || state == State::Stretching;
+    }
+
+    SINT readInput(double dRate, CSAMPLE* pBuffer, SINT samples);
+    void readInputAhead(SINT callbackFrames);
+    SINT readStretched(CSAMPLE* pOutput, SINT frames, double* pFramesRead);
+
+    // Hands the active stretcher over to the worker or takes it back. The
+    // engine never waits for the worker, so taking over returns false if
+    // the stretcher had to be abandoned.
+    void handOver();
+    bool takeOver();
+    void reclaimReleasedStretcher();
+    static void applyParameters(
+            Stretcher* pStretcher,
+            const ScaleParameters& parameters);
+    bool canStretchAhead() const;
+
+    ReadAheadManager* m_pReadAheadManager;
+    InputReader m_inputReader;
+    EngineWorkerScheduler* m_pScheduler;
+
+    // The active stretcher and the spare one
+    Stretcher m_stretchers[2];
+
+    // Engine callback only
+    int m_active;
+    ScaleParameters m_parameters;
+    int m_steadyCallbacks;
+    SINT m_chunkReadFrames;
+    int m_session;
+    // The chunks of an abandoned stretcher that have been finished before,
+    // or -1 if not limited
+    int m_playableChunks;
+    int m_underflowCount;
+
+    // Engine -> worker
+    FIFO<CSAMPLE> m_input;
+    ControlValueAtomic<ScaleParameters> m_workerParameters;
+    std::atomic<int> m_targetChunks;
+    std::atomic<int> m_workerSession;
+    // Set by the engine before handing over
+    Stretcher* m_pWorkerStretcher;
+    // Worker -> engine
+    FIFO<StretchedChunk> m_stretched;
+
+    std::atomic<State> m_state;
+
+    EngineBufferScaleLookAheadWorker m_worker;
+};
+
+#endif /* ENGINEBUFFERSCALELOOKAHEAD_H */
@@ -26,7 +26,8 @@ CachingReaderWorker::CachingReaderWorker(
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
           m_newTrackAvailable(false),
-          m_stop(0) {
+          m_stop(0),
+          m_busy(false) {
 }
 
 ReaderStatusUpdate CachingReaderWorker::processReadRequest(
@@ -90,6 +91,7 @@ void CachingReaderWorker::run() {
 
     Event::start(m_tag);
     while (!atomicLoadAcquire(m_stop)) {
+        m_busy.store(true);
         // Request is initialized by reading from FIFO
         CachingReaderChunkReadRequest request;
         if (m_newTrackAvailable) {
@@ -106,6 +108,7 @@ void CachingReaderWorker::run() {
             const ReaderStatusUpdate update(processReadRequest(request));
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
         } else {
+            m_busy.store(false);
             Event::end(m_tag);
             m_semaRun.acquire();
             Event::start(m_tag);
@@ -113,6 +116,21 @@ void CachingReaderWorker::run() {
     }
 }
 
+bool CachingReaderWorker::isIdle() {
+    // The worker is marked busy before taking a new track or a request
+    // and only marked idle after finding both empty.
+    if (m_busy.load()) {
+        return false;
+    }
+    {
+        QMutexLocker locker(&m_newTrackMutex);
+        if (m_newTrackAvailable) {
+            return false;
+        }
+    }
+    return m_pChunkReadRequestFIFO->readAvailable() == 0;
+}
+
 void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     // Discard all pending read requests
     CachingReaderChunkReadRequest request;
@@ -1,6 +1,8 @@
 #ifndef ENGINE_CACHINGREADERWORKER_H
 #define ENGINE_CACHINGREADERWORKER_H
 
+#include <atomic>
+
 #include <QtDebug>
 #include <QMutex>
 #include <QSemaphore>
@@ -110,6 +112,8 @@ class CachingReaderWorker : public EngineWorker {
     // thread pool via the EngineWorkerScheduler.
     void run() override;
 
+    bool isIdle() override;
+
     void quitWait();
 
   signals:
@@ -147,6 +151,10 @@ class CachingReaderWorker : public EngineWorker {
     mixxx::SampleBuffer m_tempReadBuffer;
 
     QAtomicInt m_stop;
+
+    // Set while the worker is processing requests and not waiting to be
+    // woken up.
+    std::atomic<bool> m_busy;
 };
 
 
@@ -4,12 +4,23 @@
 #include "util/defs.h"
 #include "util/sample.h"
 
+namespace {
+
+// -80 dBFS, well below the point where cutting off a decaying tail would
+// be noticeable.
+constexpr CSAMPLE kSilenceThreshold = 0.0001f;
+
+} // anonymous namespace
+
 EngineEffect::EngineEffect(EffectManifestPointer pManifest,
                            const QSet<ChannelHandleAndGroup>& activeInputChannels,
                            EffectsManager* pEffectsManager,
                            EffectInstantiatorPointer pInstantiator)
         : m_pManifest(pManifest),
           m_parameters(pManifest->parameters().size()),
+          m_tailLengthSeconds(pManifest->tailLengthSeconds()),
+          m_processedBufferCount(0),
+          m_skippedBufferCount(0),
           m_pEffectsManager(pEffectsManager) {
     const QList<EffectManifestParameterPointer>& parameters = m_pManifest->parameters();
     for (int i = 0; i < parameters.size(); ++i) {
@@ -18,16 +29,22 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
                 new EngineEffectParameter(param);
         m_parameters[i] = pParameter;
         m_parametersById[param->id()] = pParameter;
+        if (pParameter->hasIdentityValue()) {
+            m_identityParameters.append(pParameter);
+        }
     }
 
     for (const ChannelHandleAndGroup& inputChannel :
             pEffectsManager->registeredInputChannels()) {
         ChannelHandleMap<EffectEnableState> outputChannelMap;
+        ChannelHandleMap<BypassState> bypassStateMap;
         for (const ChannelHandleAndGroup& outputChannel :
                 pEffectsManager->registeredOutputChannels()) {
             outputChannelMap.insert(outputChannel.handle(), EffectEnableState::Disabled);
+            bypassStateMap.insert(outputChannel.handle(), BypassState());
         }
         m_effectEnableStateForChannelMatrix.insert(inputChannel.handle(), outputChannelMap);
+        m_bypassStateForChannelMatrix.insert(inputChannel.handle(), bypassStateMap);
     }
 
     // Creating the processor must come last.
@@ -38,11 +55,14 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
           MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
     m_pProcessor->initialize(activeInputChannels, pEffectsManager, bufferParameters);
     m_effectRampsFromDry = pManifest->effectRampsFromDry();
+    m_bSupportsPlanarProcessing = m_pProcessor->supportsPlanarProcessing();
 }
 
 EngineEffect::~EngineEffect() {
     if (kEffectDebugOutput) {
-        qDebug() << debugString() << "destroyed";
+        qDebug() << debugString() << "destroyed"
+                 << "processed buffers" << processedBufferCount()
+                 << "skipped buffers" << skippedBufferCount();
     }
     delete m_pProcessor;
     m_parametersById.clear();
@@ -136,13 +156,10 @@ bool EngineEffect::processEffectsRequest(EffectsRequest& message,
     return false;
 }
 
-bool EngineEffect::process(const ChannelHandle& inputHandle,
-                           const ChannelHandle& outputHandle,
-                           const CSAMPLE* pInput, CSAMPLE* pOutput,
-                           const unsigned int numSamples,
-                           const unsigned int sampleRate,
-                           const EffectEnableState chainEnableState,
-                           const GroupFeatureState& groupFeatures) {
+EffectEnableState EngineEffect::effectiveEnableState(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const EffectEnableState chainEnableState) {
     // Compute the effective enable state from the combination of the effect's state
     // for the channel and the state passed from the EngineEffectChain.
 
@@ -185,49 +202,208 @@ bool EngineEffect::process(const ChannelHandle& inputHandle,
             }
         }
     }
+    return effectiveEffectEnableState;
+}
+
+bool EngineEffect::skipProcessing(BypassState* pBypassState,
+                                  const EffectEnableState enableState,
+                                  const bool inputSilent,
+                                  const bool atIdentity,
+                                  const SINT numFrames,
+                                  const unsigned int sampleRate) {
+    // Skipping is only safe in the steady state. Intermediate enable
+    // states must reach the EffectProcessor to let it ramp and reset.
+    if (enableState != EffectEnableState::Enabled) {
+        return false;
+    }
+    bool skip = false;
+    if (atIdentity && pBypassState->processedAtIdentity) {
+        skip = true;
+    } else if (inputSilent) {
+        const SINT tailFrames = static_cast<SINT>(m_tailLengthSeconds * sampleRate);
+        skip = pBypassState->silentFrames >= tailFrames;
+    }
+    if (!skip) {
+        return false;
+    }
+    // The unprocessed input is passed on instead of the output.
+    if (inputSilent) {
+        pBypassState->silentFrames += numFrames;
+    } else {
+        pBypassState->silentFrames = 0;
+    }
+    m_skippedBufferCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void EngineEffect::updateBypassState(BypassState* pBypassState,
+                                     const EffectEnableState enableState,
+                                     const bool inputAndOutputSilent,
+                                     const bool atIdentity,
+                                     const SINT numFrames) {
+    m_processedBufferCount.fetch_add(1, std::memory_order_relaxed);
+    if (enableState == EffectEnableState::Enabled) {
+        if (inputAndOutputSilent) {
+            pBypassState->silentFrames += numFrames;
+        } else {
+            pBypassState->silentFrames = 0;
+        }
+        pBypassState->processedAtIdentity = atIdentity;
+    } else {
+        *pBypassState = BypassState();
+    }
+}
+
+void EngineEffect::finishEnableStateTransition(const ChannelHandle& inputHandle,
+                                               const ChannelHandle& outputHandle) {
+    // Now that the EffectProcessor has been sent the intermediate enabling/disabling
+    // signal, set the channel state to fully enabled/disabled for the next engine callback.
+    EffectEnableState& effectOnChannelState = m_effectEnableStateForChannelMatrix[inputHandle][outputHandle];
+    if (effectOnChannelState == EffectEnableState::Disabling) {
+        effectOnChannelState = EffectEnableState::Disabled;
+    } else if (effectOnChannelState == EffectEnableState::Enabling) {
+        effectOnChannelState = EffectEnableState::Enabled;
+    }
+}
+
+void EngineEffect::rampFromOrToDry(const CSAMPLE* pInput, CSAMPLE* pOutput,
+                                   const SINT numSamples,
+                                   const EffectEnableState enableState) {
+    if (m_effectRampsFromDry) {
+        return;
+    }
+    // the effect does not fade, so we care for it
+    if (enableState == EffectEnableState::Disabling) {
+        DEBUG_ASSERT(pInput != pOutput); // Fade to dry only works if pInput is not touched by pOutput
+        // Fade out (fade to dry signal)
+        SampleUtil::copy2WithRampingGain(pOutput,
+                pInput, 0.0, 1.0,
+                pOutput, 1.0, 0.0,
+                numSamples);
+    } else if (enableState == EffectEnableState::Enabling) {
+        DEBUG_ASSERT(pInput != pOutput); // Fade to dry only works if pInput is not touched by pOutput
+        // Fade in (fade to wet signal)
+        SampleUtil::copy2WithRampingGain(pOutput,
+                pInput, 1.0, 0.0,
+                pOutput, 0.0, 1.0,
+                numSamples);
+    }
+}
+
+bool EngineEffect::process(const ChannelHandle& inputHandle,
+                           const ChannelHandle& outputHandle,
+                           const CSAMPLE* pInput, CSAMPLE* pOutput,
+                           const unsigned int numSamples,
+                           const unsigned int sampleRate,
+                           const EffectEnableState chainEnableState,
+                           const GroupFeatureState& groupFeatures) {
+    const EffectEnableState effectiveEffectEnableState =
+            effectiveEnableState(inputHandle, outputHandle, chainEnableState);
 
     bool processingOccured = false;
+    BypassState& bypassState = m_bypassStateForChannelMatrix[inputHandle][outputHandle];
+
+    if (effectiveEffectEnableState == EffectEnableState::Disabled) {
+        // The EffectProcessor may reset its state when it is enabled again.
+        bypassState = BypassState();
+    } else {
+        const SINT numFrames = numSamples / mixxx::kEngineChannelCount;
+        const bool atIdentity = isAtIdentity();
+        const bool inputSilent = m_tailLengthSeconds >= 0.0 &&
+                SampleUtil::maxAbsAmplitude(pInput, numSamples) < kSilenceThreshold;
+
+        if (skipProcessing(&bypassState, effectiveEffectEnableState,
+                           inputSilent, atIdentity, numFrames, sampleRate)) {
+            return false;
+        }
 
-    if (effectiveEffectEnableState != EffectEnableState::Disabled) {
         //TODO: refactor rest of audio engine to use mixxx::AudioParameters
         const mixxx::EngineParameters bufferParameters(
               mixxx::audio::SampleRate(sampleRate),
-              numSamples / mixxx::kEngineChannelCount);
+              numFrames);
 
         m_pProcessor->process(inputHandle, outputHandle, pInput, pOutput,
                               bufferParameters,
                               effectiveEffectEnableState, groupFeatures);
 
         processingOccured = true;
+        updateBypassState(&bypassState, effectiveEffectEnableState,
+                inputSilent &&
+                        SampleUtil::maxAbsAmplitude(pOutput, numSamples) < kSilenceThreshold,
+                atIdentity, numFrames);
 
-        if (!m_effectRampsFromDry) {
-            // the effect does not fade, so we care for it
-            if (effectiveEffectEnableState == EffectEnableState::Disabling) {
-                DEBUG_ASSERT(pInput != pOutput); // Fade to dry only works if pInput is not touched by pOutput
-                // Fade out (fade to dry signal)
-                SampleUtil::copy2WithRampingGain(pOutput,
-                        pInput, 0.0, 1.0,
-                        pOutput, 1.0, 0.0,
-                        numSamples);
-            } else if (effectiveEffectEnableState == EffectEnableState::Enabling) {
-                DEBUG_ASSERT(pInput != pOutput); // Fade to dry only works if pInput is not touched by pOutput
-                // Fade in (fade to wet signal)
-                SampleUtil::copy2WithRampingGain(pOutput,
-                        pInput, 1.0, 0.0,
-                        pOutput, 0.0, 1.0,
-                        numSamples);
-            }
-        }
+        rampFromOrToDry(pInput, pOutput, numSamples, effectiveEffectEnableState);
     }
 
-    // Now that the EffectProcessor has been sent the intermediate enabling/disabling
-    // signal, set the channel state to fully enabled/disabled for the next engine callback.
-    EffectEnableState& effectOnChannelState = m_effectEnableStateForChannelMatrix[inputHandle][outputHandle];
-    if (effectOnChannelState == EffectEnableState::Disabling) {
-        effectOnChannelState = EffectEnableState::Disabled;
-    } else if (effectOnChannelState == EffectEnableState::Enabling) {
-        effectOnChannelState = EffectEnableState::Enabled;
+    finishEnableStateTransition(inputHandle, outputHandle);
+    return processingOccured;
+}
+
+bool EngineEffect::processPlanar(const ChannelHandle& inputHandle,
+                                 const ChannelHandle& outputHandle,
+                                 const CSAMPLE* const* pInputChannels,
+                                 CSAMPLE* const* pOutputChannels,
+                                 const unsigned int numFrames,
+                                 const unsigned int sampleRate,
+                                 const EffectEnableState chainEnableState,
+                                 const GroupFeatureState& groupFeatures) {
+    const EffectEnableState effectiveEffectEnableState =
+            effectiveEnableState(inputHandle, outputHandle, chainEnableState);
+
+    bool processingOccured = false;
+    BypassState& bypassState = m_bypassStateForChannelMatrix[inputHandle][outputHandle];
+
+    if (effectiveEffectEnableState == EffectEnableState::Disabled) {
+        bypassState = BypassState();
+    } else {
+        const bool atIdentity = isAtIdentity();
+        bool inputSilent = m_tailLengthSeconds >= 0.0;
+        for (int i = 0; inputSilent && i < mixxx::kEngineChannelCount; ++i) {
+            inputSilent = SampleUtil::maxAbsAmplitude(
+                    pInputChannels[i], numFrames) < kSilenceThreshold;
+        }
+
+        if (skipProcessing(&bypassState, effectiveEffectEnableState,
+                           inputSilent, atIdentity, numFrames, sampleRate)) {
+            return false;
+        }
+
+        const mixxx::EngineParameters bufferParameters(
+              mixxx::audio::SampleRate(sampleRate),
+              numFrames);
+
+        m_pProcessor->processPlanar(inputHandle, outputHandle,
+                                    pInputChannels, pOutputChannels,
+                                    bufferParameters,
+                                    effectiveEffectEnableState, groupFeatures);
+
+        processingOccured = true;
+        bool outputSilent = inputSilent;
+        for (int i = 0; outputSilent && i < mixxx::kEngineChannelCount; ++i) {
+            outputSilent = SampleUtil::maxAbsAmplitude(
+                    pOutputChannels[i], numFrames) < kSilenceThreshold;
+        }
+        updateBypassState(&bypassState, effectiveEffectEnableState,
+                outputSilent, atIdentity, numFrames);
+
+        for (int i = 0; i < mixxx::kEngineChannelCount; ++i) {
+            rampFromOrToDry(pInputChannels[i], pOutputChannels[i], numFrames,
+                    effectiveEffectEnableState);
+        }
     }
 
+    finishEnableStateTransition(inputHandle, outputHandle);
     return processingOccured;
 }
+
+bool EngineEffect::isAtIdentity() const {
+    if (m_identityParameters.isEmpty()) {
+        return false;
+    }
+    for (const EngineEffectParameter* pParameter : m_identityParameters) {
+        if (!pParameter->isAtIdentity()) {
+            return false;
+        }
+    }
+    return true;
+}
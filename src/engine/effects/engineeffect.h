@@ -1,6 +1,8 @@
 #ifndef ENGINEEFFECT_H
 #define ENGINEEFFECT_H
 
+#include <atomic>
+
 #include <QMap>
 #include <QString>
 #include <QList>
@@ -43,6 +45,9 @@ class EngineEffect : public EffectsRequestHandler {
         EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe);
 
+    // Returns false if pOutput has not been written, either because the
+    // effect is disabled or because processing has been skipped. The caller
+    // must continue with pInput in this case.
     bool process(const ChannelHandle& inputHandle, const ChannelHandle& outputHandle,
                  const CSAMPLE* pInput, CSAMPLE* pOutput,
                  const unsigned int numSamples,
@@ -50,11 +55,76 @@ class EngineEffect : public EffectsRequestHandler {
                  const EffectEnableState chainEnableState,
                  const GroupFeatureState& groupFeatures);
 
+    bool supportsPlanarProcessing() const {
+        return m_bSupportsPlanarProcessing;
+    }
+
+    // Like process() for effects that support planar processing, see
+    // EffectProcessor::processPlanar().
+    bool processPlanar(const ChannelHandle& inputHandle, const ChannelHandle& outputHandle,
+                       const CSAMPLE* const* pInputChannels,
+                       CSAMPLE* const* pOutputChannels,
+                       const unsigned int numFrames,
+                       const unsigned int sampleRate,
+                       const EffectEnableState chainEnableState,
+                       const GroupFeatureState& groupFeatures);
+
     const EffectManifestPointer getManifest() const {
         return m_pManifest;
     }
 
+    // The number of buffers that have been passed to the EffectProcessor and
+    // the number of buffers that have been passed through unprocessed,
+    // because the input was silent and the tail of the effect had decayed or
+    // because the effect was at identity. Summed up over all channels. Safe
+    // to call from any thread.
+    quint64 processedBufferCount() const {
+        return m_processedBufferCount.load(std::memory_order_relaxed);
+    }
+    quint64 skippedBufferCount() const {
+        return m_skippedBufferCount.load(std::memory_order_relaxed);
+    }
+
   private:
+    // Tracks what the EffectProcessor has seen recently for one combination
+    // of input and output channel.
+    struct BypassState {
+        BypassState()
+                : silentFrames(0),
+                  processedAtIdentity(false) {
+        }
+        // The number of frames since both the input and the output of the
+        // effect became silent.
+        SINT silentFrames;
+        // The last buffer has been processed with all parameters at their
+        // identity, i.e. the EffectProcessor has already faded out its own
+        // processing.
+        bool processedAtIdentity;
+    };
+
+    EffectEnableState effectiveEnableState(const ChannelHandle& inputHandle,
+                                           const ChannelHandle& outputHandle,
+                                           const EffectEnableState chainEnableState);
+    // Returns true and accounts for the skipped buffer if the EffectProcessor
+    // does not need to process it.
+    bool skipProcessing(BypassState* pBypassState,
+                        const EffectEnableState enableState,
+                        const bool inputSilent,
+                        const bool atIdentity,
+                        const SINT numFrames,
+                        const unsigned int sampleRate);
+    void updateBypassState(BypassState* pBypassState,
+                           const EffectEnableState enableState,
+                           const bool inputAndOutputSilent,
+                           const bool atIdentity,
+                           const SINT numFrames);
+    void finishEnableStateTransition(const ChannelHandle& inputHandle,
+                                     const ChannelHandle& outputHandle);
+    void rampFromOrToDry(const CSAMPLE* pInput, CSAMPLE* pOutput,
+                         const SINT numSamples,
+                         const EffectEnableState enableState);
+    bool isAtIdentity() const;
+
     QString debugString() const {
         return QString("EngineEffect(%1)").arg(m_pManifest->name());
     }
@@ -63,9 +133,17 @@ class EngineEffect : public EffectsRequestHandler {
     EffectProcessor* m_pProcessor;
     ChannelHandleMap<ChannelHandleMap<EffectEnableState>> m_effectEnableStateForChannelMatrix;
     bool m_effectRampsFromDry;
+    bool m_bSupportsPlanarProcessing;
     // Must not be modified after construction.
     QVector<EngineEffectParameter*> m_parameters;
     QMap<QString, EngineEffectParameter*> m_parametersById;
+    QVector<EngineEffectParameter*> m_identityParameters;
+
+    ChannelHandleMap<ChannelHandleMap<BypassState>> m_bypassStateForChannelMatrix;
+    double m_tailLengthSeconds;
+    // Channels of the same effect may be processed concurrently.
+    std::atomic<quint64> m_processedBufferCount;
+    std::atomic<quint64> m_skippedBufferCount;
 
     const EffectsManager* m_pEffectsManager;
 
@@ -1,6 +1,9 @@
 #include "engine/effects/engineeffectchain.h"
 
+#include <utility>
+
 #include "engine/effects/engineeffect.h"
+#include "engine/effects/engineeffectsscratchbuffers.h"
 #include "util/defs.h"
 #include "util/sample.h"
 
@@ -11,8 +14,7 @@ EngineEffectChain::EngineEffectChain(const QString& id,
           m_enableState(EffectEnableState::Enabled),
           m_mixMode(EffectChainMixMode::DrySlashWet),
           m_dMix(0),
-          m_buffer1(MAX_BUFFER_LEN),
-          m_buffer2(MAX_BUFFER_LEN) {
+          m_bProcessedSinceTransition(false) {
     // Try to prevent memory allocation.
     m_effects.reserve(256);
 
@@ -231,7 +233,8 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
                                 CSAMPLE* pIn, CSAMPLE* pOut,
                                 const unsigned int numSamples,
                                 const unsigned int sampleRate,
-                                const GroupFeatureState& groupFeatures) {
+                                const GroupFeatureState& groupFeatures,
+                                EngineEffectsScratchBuffers* pScratch) {
     // Compute the effective enable state from the channel input routing switch and
     // the chain's enable state. When either of these are turned on/off, send the
     // effects the intermediate enabling/disabling signal.
@@ -265,47 +268,51 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         CSAMPLE* pIntermediateOutput;
         bool firstAddDryToWetEffectProcessed = false;
 
-        for (EngineEffect* pEffect: m_effects) {
-            if (pEffect != nullptr) {
-                // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
-                } else {
-                    pIntermediateOutput = m_buffer1.data();
-                }
+        for (int i = 0; i < m_effects.size(); ++i) {
+            EngineEffect* pEffect = m_effects.at(i);
+            if (pEffect == nullptr) {
+                continue;
+            }
+            // Select an unused intermediate buffer for the next output
+            if (pIntermediateInput == pScratch->chainBuffer1.data()) {
+                pIntermediateOutput = pScratch->chainBuffer2.data();
+            } else {
+                pIntermediateOutput = pScratch->chainBuffer1.data();
+            }
 
-                if (pEffect->process(inputHandle, outputHandle,
+            bool effectProcessed;
+            if (pEffect->supportsPlanarProcessing()) {
+                // Hand over this and all following effects that support
+                // planar processing at once.
+                int lastIndex = i;
+                while (lastIndex + 1 < m_effects.size() &&
+                        (m_effects.at(lastIndex + 1) == nullptr ||
+                                m_effects.at(lastIndex + 1)->supportsPlanarProcessing())) {
+                    ++lastIndex;
+                }
+                effectProcessed = processPlanarEffects(i, lastIndex,
+                        inputHandle, outputHandle,
+                        pIntermediateInput, pIntermediateOutput,
+                        numSamples, sampleRate,
+                        effectiveChainEnableState, groupFeatures,
+                        pScratch, &firstAddDryToWetEffectProcessed);
+                i = lastIndex;
+            } else {
+                effectProcessed = pEffect->process(inputHandle, outputHandle,
                                      pIntermediateInput, pIntermediateOutput,
                                      numSamples, sampleRate,
-                                     effectiveChainEnableState, groupFeatures)) {
-                    if (pEffect->getManifest()->addDryToWet()) {
-                        // Skip adding the dry signal to the effect's wet output
-                        // when it is the first addDryToWet type effect in
-                        // a DryPlusWet mode chain. This allows effects after
-                        // it to process only the wet output. For example,
-                        // when chaining Echo then Reverb in DryPlusWet mode,
-                        // the Reverb effect will get only the wet output of
-                        // Echo to process instead of the echoed signal mixed
-                        // with the input to Echo. The dry signal that entered
-                        // the first effect in the chain will be mixed back in
-                        // below after all effects in the chain have been processed.
-                        bool skipAddingDry = !firstAddDryToWetEffectProcessed
-                                && m_mixMode == EffectChainMixMode::DryPlusWet;
-
-                        if (!skipAddingDry) {
-                            for (SINT i = 0; i <= static_cast<SINT>(numSamples); ++i) {
-                                pIntermediateOutput[i] += pIntermediateInput[i];
-                            }
-                        }
-
-                        firstAddDryToWetEffectProcessed = true;
-                    }
-
-                    processingOccured = true;
-                    // Output of this effect becomes the input of the next effect
-                    pIntermediateInput = pIntermediateOutput;
+                                     effectiveChainEnableState, groupFeatures);
+                if (effectProcessed &&
+                        shouldAddDryToWet(pEffect, &firstAddDryToWetEffectProcessed)) {
+                    SampleUtil::add(pIntermediateOutput, pIntermediateInput, numSamples);
                 }
             }
+
+            if (effectProcessed) {
+                processingOccured = true;
+                // Output of this effect becomes the input of the next effect
+                pIntermediateInput = pIntermediateOutput;
+            }
         }
 
         if (processingOccured) {
@@ -342,11 +349,90 @@ bool EngineEffectChain::process(const ChannelHandle& inputHandle,
         chainOnChannelEnableState = EffectEnableState::Enabled;
     }
 
+    // The chain's own intermediate state must reach every channel that is
+    // processed during this callback, possibly concurrently. It is completed
+    // in finishEnableStateTransition() at the start of the next callback.
+    m_bProcessedSinceTransition.store(true, std::memory_order_relaxed);
+
+    return processingOccured;
+}
+
+bool EngineEffectChain::shouldAddDryToWet(EngineEffect* pEffect,
+        bool* pFirstAddDryToWetEffectProcessed) const {
+    if (!pEffect->getManifest()->addDryToWet()) {
+        return false;
+    }
+    // Skip adding the dry signal to the effect's wet output
+    // when it is the first addDryToWet type effect in
+    // a DryPlusWet mode chain. This allows effects after
+    // it to process only the wet output. For example,
+    // when chaining Echo then Reverb in DryPlusWet mode,
+    // the Reverb effect will get only the wet output of
+    // Echo to process instead of the echoed signal mixed
+    // with the input to Echo. The dry signal that entered
+    // the first effect in the chain will be mixed back in
+    // after all effects in the chain have been processed.
+    bool skipAddingDry = !*pFirstAddDryToWetEffectProcessed
+            && m_mixMode == EffectChainMixMode::DryPlusWet;
+    *pFirstAddDryToWetEffectProcessed = true;
+    return !skipAddingDry;
+}
+
+bool EngineEffectChain::processPlanarEffects(int firstIndex, int lastIndex,
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle,
+        const CSAMPLE* pIn, CSAMPLE* pOut,
+        const unsigned int numSamples,
+        const unsigned int sampleRate,
+        const EffectEnableState enableState,
+        const GroupFeatureState& groupFeatures,
+        EngineEffectsScratchBuffers* pScratch,
+        bool* pFirstAddDryToWetEffectProcessed) {
+    const SINT numFrames = numSamples / mixxx::kEngineChannelCount;
+    CSAMPLE* planarBuffers1[] = {
+            pScratch->chainPlanarBuffer1L.data(),
+            pScratch->chainPlanarBuffer1R.data()};
+    CSAMPLE* planarBuffers2[] = {
+            pScratch->chainPlanarBuffer2L.data(),
+            pScratch->chainPlanarBuffer2R.data()};
+    CSAMPLE** pPlanarInput = planarBuffers1;
+    CSAMPLE** pPlanarOutput = planarBuffers2;
+
+    SampleUtil::deinterleaveBuffer(pPlanarInput[0], pPlanarInput[1], pIn, numFrames);
+
+    bool processingOccured = false;
+    for (int i = firstIndex; i <= lastIndex; ++i) {
+        EngineEffect* pEffect = m_effects.at(i);
+        if (pEffect == nullptr) {
+            continue;
+        }
+        if (pEffect->processPlanar(inputHandle, outputHandle,
+                                   pPlanarInput, pPlanarOutput,
+                                   numFrames, sampleRate,
+                                   enableState, groupFeatures)) {
+            if (shouldAddDryToWet(pEffect, pFirstAddDryToWetEffectProcessed)) {
+                for (int channel = 0; channel < mixxx::kEngineChannelCount; ++channel) {
+                    SampleUtil::add(pPlanarOutput[channel], pPlanarInput[channel], numFrames);
+                }
+            }
+            processingOccured = true;
+            std::swap(pPlanarInput, pPlanarOutput);
+        }
+    }
+
+    if (processingOccured) {
+        SampleUtil::interleaveBuffer(pOut, pPlanarInput[0], pPlanarInput[1], numFrames);
+    }
+    return processingOccured;
+}
+
+void EngineEffectChain::finishEnableStateTransition() {
+    if (!m_bProcessedSinceTransition.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
     if (m_enableState == EffectEnableState::Disabling) {
         m_enableState = EffectEnableState::Disabled;
     } else if (m_enableState == EffectEnableState::Enabling) {
         m_enableState = EffectEnableState::Enabled;
     }
-
-    return processingOccured;
 }
@@ -5,9 +5,10 @@
 #include <QList>
 #include <QLinkedList>
 
+#include <atomic>
+
 #include "util/class.h"
 #include "util/types.h"
-#include "util/samplebuffer.h"
 #include "util/memory.h"
 #include "engine/channelhandle.h"
 #include "engine/effects/message.h"
@@ -15,6 +16,7 @@
 #include "effects/effectchain.h"
 
 class EngineEffect;
+struct EngineEffectsScratchBuffers;
 
 class EngineEffectChain : public EffectsRequestHandler {
   public:
@@ -27,12 +29,20 @@ class EngineEffectChain : public EffectsRequestHandler {
         EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe);
 
+    // May be called concurrently for different input channels.
     bool process(const ChannelHandle& inputHandle,
                  const ChannelHandle& outputHandle,
                  CSAMPLE* pIn, CSAMPLE* pOut,
                  const unsigned int numSamples,
                  const unsigned int sampleRate,
-                 const GroupFeatureState& groupFeatures);
+                 const GroupFeatureState& groupFeatures,
+                 EngineEffectsScratchBuffers* pScratch);
+
+    // Completes an intermediate enabling/disabling state of the whole chain
+    // after it has been processed for all routed channels during the last
+    // engine callback. Called from the engine thread at the start of the
+    // next callback before any new requests are handled.
+    void finishEnableStateTransition();
 
     const QString& id() const {
         return m_id;
@@ -63,6 +73,26 @@ class EngineEffectChain : public EffectsRequestHandler {
             EffectStatesMapArray* statesForEffectsInChain);
     bool disableForInputChannel(const ChannelHandle* inputHandle);
 
+    // Returns true if the dry signal must be added to the output of
+    // pEffect, which has just been processed.
+    bool shouldAddDryToWet(EngineEffect* pEffect,
+                           bool* pFirstAddDryToWetEffectProcessed) const;
+
+    // Processes the effects from firstIndex to lastIndex that all support
+    // planar processing on the planar scratch buffers. pIn is only converted
+    // once before the first and pOut once after the last of them. Returns
+    // false if pOut has not been written.
+    bool processPlanarEffects(int firstIndex, int lastIndex,
+                              const ChannelHandle& inputHandle,
+                              const ChannelHandle& outputHandle,
+                              const CSAMPLE* pIn, CSAMPLE* pOut,
+                              const unsigned int numSamples,
+                              const unsigned int sampleRate,
+                              const EffectEnableState enableState,
+                              const GroupFeatureState& groupFeatures,
+                              EngineEffectsScratchBuffers* pScratch,
+                              bool* pFirstAddDryToWetEffectProcessed);
+
     // Gets or creates a ChannelStatus entry in m_channelStatus for the provided
     // handle.
     ChannelStatus& getChannelStatus(const ChannelHandle& inputHandle,
@@ -72,9 +102,9 @@ class EngineEffectChain : public EffectsRequestHandler {
     EffectEnableState m_enableState;
     EffectChainMixMode m_mixMode;
     CSAMPLE m_dMix;
+    // Set by process() when the chain has seen the current m_enableState.
+    std::atomic<bool> m_bProcessedSinceTransition;
     QList<EngineEffect*> m_effects;
-    mixxx::SampleBuffer m_buffer1;
-    mixxx::SampleBuffer m_buffer2;
     ChannelHandleMap<ChannelHandleMap<ChannelStatus>> m_chainStatusForChannelMatrix;
 
     DISALLOW_COPY_AND_ASSIGN(EngineEffectChain);
@@ -76,6 +76,24 @@ class EngineEffectParameter {
         m_maximum = maximum;
     }
 
+    inline bool hasIdentityValue() const {
+        return m_pParameter->hasIdentityValue();
+    }
+    // Returns true if the parameter does not alter the signal at its current
+    // value, see EffectManifestParameter::identityValue().
+    inline bool isAtIdentity() const {
+        if (!m_pParameter->hasIdentityValue()) {
+            return false;
+        }
+        const double identityValue = m_pParameter->identityValue();
+        if (identityValue >= m_maximum) {
+            return m_value >= identityValue;
+        } else if (identityValue <= m_minimum) {
+            return m_value <= identityValue;
+        }
+        return m_value == identityValue;
+    }
+
   private:
     EffectManifestParameterPointer m_pParameter;
     double m_value;
@@ -1,12 +1,11 @@
 #include "engine/effects/engineeffectrack.h"
 #include "engine/effects/engineeffectchain.h"
+#include "engine/effects/engineeffectsscratchbuffers.h"
 #include "util/defs.h"
 #include "util/sample.h"
 
 EngineEffectRack::EngineEffectRack(int iRackNumber)
-        : m_iRackNumber(iRackNumber),
-          m_buffer1(MAX_BUFFER_LEN),
-          m_buffer2(MAX_BUFFER_LEN) {
+        : m_iRackNumber(iRackNumber) {
     // Try to prevent memory allocation.
     m_chains.reserve(256);
 }
@@ -49,7 +48,8 @@ bool EngineEffectRack::process(const ChannelHandle& inputHandle,
                                CSAMPLE* pIn, CSAMPLE* pOut,
                                const unsigned int numSamples,
                                const unsigned int sampleRate,
-                               const GroupFeatureState& groupFeatures) {
+                               const GroupFeatureState& groupFeatures,
+                               EngineEffectsScratchBuffers* pScratch) {
     bool processingOccured = false;
     if (pIn == pOut) {
         // Effects are applied to the buffer in place
@@ -57,7 +57,8 @@ bool EngineEffectRack::process(const ChannelHandle& inputHandle,
             if (pChain != nullptr) {
                 if (pChain->process(inputHandle, outputHandle,
                                     pIn, pOut,
-                                    numSamples, sampleRate, groupFeatures)) {
+                                    numSamples, sampleRate, groupFeatures,
+                                    pScratch)) {
                     processingOccured = true;
                 }
             }
@@ -70,15 +71,16 @@ bool EngineEffectRack::process(const ChannelHandle& inputHandle,
         for (EngineEffectChain* pChain : m_chains) {
             if (pChain != nullptr) {
                 // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
+                if (pIntermediateInput == pScratch->rackBuffer1.data()) {
+                    pIntermediateOutput = pScratch->rackBuffer2.data();
                 } else {
-                    pIntermediateOutput = m_buffer1.data();
+                    pIntermediateOutput = pScratch->rackBuffer1.data();
                 }
 
                 if (pChain->process(inputHandle, outputHandle,
                                     pIntermediateInput, pIntermediateOutput,
-                                    numSamples, sampleRate, groupFeatures)) {
+                                    numSamples, sampleRate, groupFeatures,
+                                    pScratch)) {
                     processingOccured = true;
                     // Output of this chain becomes the input of the next chain.
                     pIntermediateInput = pIntermediateOutput;
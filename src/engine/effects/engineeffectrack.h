@@ -6,9 +6,11 @@
 #include "engine/channelhandle.h"
 #include "engine/effects/message.h"
 #include "engine/effects/groupfeaturestate.h"
-#include "util/samplebuffer.h"
+#include "util/class.h"
+#include "util/types.h"
 
 class EngineEffectChain;
+struct EngineEffectsScratchBuffers;
 
 //TODO(Be): Remove this superfluous class.
 class EngineEffectRack : public EffectsRequestHandler {
@@ -25,7 +27,8 @@ class EngineEffectRack : public EffectsRequestHandler {
                  CSAMPLE* pIn, CSAMPLE* pOut,
                  const unsigned int numSamples,
                  const unsigned int sampleRate,
-                 const GroupFeatureState& groupFeatures);
+                 const GroupFeatureState& groupFeatures,
+                 EngineEffectsScratchBuffers* pScratch);
 
     int number() const {
         return m_iRackNumber;
@@ -42,9 +45,6 @@ class EngineEffectRack : public EffectsRequestHandler {
     int m_iRackNumber;
     QList<EngineEffectChain*> m_chains;
 
-    mixxx::SampleBuffer m_buffer1;
-    mixxx::SampleBuffer m_buffer2;
-
     DISALLOW_COPY_AND_ASSIGN(EngineEffectRack);
 };
 
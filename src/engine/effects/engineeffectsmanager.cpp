@@ -4,22 +4,56 @@
 #include "engine/effects/engineeffectchain.h"
 #include "engine/effects/engineeffect.h"
 
+#include "util/callbackprofiler.h"
 #include "util/defs.h"
 #include "util/sample.h"
 
-EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
+namespace {
+
+// The number of channels that can be deferred in a single parallel batch.
+// Further channels are processed immediately on the engine thread.
+constexpr int kMaxBatchSize = 16;
+
+} // anonymous namespace
+
+EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe,
+                                           int numWorkerThreads)
         : m_pResponsePipe(pResponsePipe),
-          m_buffer1(MAX_BUFFER_LEN),
-          m_buffer2(MAX_BUFFER_LEN) {
+          m_bBatchActive(false),
+          m_bBatchStalled(false) {
     // Try to prevent memory allocation.
     m_chains.reserve(256);
     m_effects.reserve(256);
+
+    if (numWorkerThreads > 0) {
+        m_pThreadPool = std::make_unique<EngineThreadPool>(numWorkerThreads);
+        m_batch.reserve(kMaxBatchSize);
+        for (int i = 0; i < kMaxBatchSize; ++i) {
+            m_batchOutputs.emplace_back(MAX_BUFFER_LEN);
+        }
+    }
+    const int numThreads = m_pThreadPool ? m_pThreadPool->numThreads() : 1;
+    for (int i = 0; i < numThreads; ++i) {
+        m_scratchBuffers.push_back(std::make_unique<EngineEffectsScratchBuffers>());
+    }
 }
 
 EngineEffectsManager::~EngineEffectsManager() {
 }
 
 void EngineEffectsManager::onCallbackStart() {
+    if (m_bBatchStalled && m_pThreadPool->isBusy()) {
+        // Effects that a helper still processes must not change or be
+        // removed, so everything waits for the next callback.
+        return;
+    }
+
+    // Must happen before handling new requests, which may start another
+    // transition that needs to be seen by the chain's process() first.
+    for (EngineEffectChain* pChain : m_chains) {
+        pChain->finishEnableStateTransition();
+    }
+
     EffectsRequest* request = NULL;
     while (m_pResponsePipe->readMessage(&request)) {
         EffectsResponse response(*request);
@@ -129,11 +163,14 @@ void EngineEffectsManager::processPreFaderInPlace(const ChannelHandle& inputHand
     // However, if an effect is loaded into a QuickEffectRack that could make use
     // of the GroupFeatureState, it will not sound the same as if it is loaded into
     // a StandardEffectRack.
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Effects);
     GroupFeatureState featureState;
     processInner(SignalProcessingStage::Prefader,
                  inputHandle, outputHandle,
                  pInOut, pInOut,
-                 numSamples, sampleRate, featureState);
+                 numSamples, sampleRate, featureState,
+                 CSAMPLE_GAIN_ONE, CSAMPLE_GAIN_ONE,
+                 m_scratchBuffers[0].get());
 }
 
 void EngineEffectsManager::processPostFaderInPlace(
@@ -145,11 +182,23 @@ void EngineEffectsManager::processPostFaderInPlace(
     const GroupFeatureState& groupFeatures,
     const CSAMPLE_GAIN oldGain,
     const CSAMPLE_GAIN newGain) {
+    if (addToBatch(inputHandle, outputHandle,
+                   pInOut, nullptr,
+                   numSamples, sampleRate, groupFeatures,
+                   oldGain, newGain)) {
+        return;
+    }
+    if (isStalledChannel(inputHandle, outputHandle)) {
+        SampleUtil::applyRampingGain(pInOut, oldGain, newGain, numSamples);
+        return;
+    }
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Effects);
     processInner(SignalProcessingStage::Postfader,
                  inputHandle, outputHandle,
                  pInOut, pInOut,
                  numSamples, sampleRate, groupFeatures,
-                 oldGain, newGain);
+                 oldGain, newGain,
+                 m_scratchBuffers[0].get());
 }
 
 void EngineEffectsManager::processPostFaderAndMix(
@@ -161,11 +210,138 @@ void EngineEffectsManager::processPostFaderAndMix(
     const GroupFeatureState& groupFeatures,
     const CSAMPLE_GAIN oldGain,
     const CSAMPLE_GAIN newGain) {
+    if (addToBatch(inputHandle, outputHandle,
+                   pIn, pOut,
+                   numSamples, sampleRate, groupFeatures,
+                   oldGain, newGain)) {
+        return;
+    }
+    if (isStalledChannel(inputHandle, outputHandle)) {
+        SampleUtil::addWithRampingGain(pOut, pIn, oldGain, newGain, numSamples);
+        return;
+    }
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Effects);
     processInner(SignalProcessingStage::Postfader,
                  inputHandle, outputHandle,
                  pIn, pOut,
                  numSamples, sampleRate, groupFeatures,
-                 oldGain, newGain);
+                 oldGain, newGain,
+                 m_scratchBuffers[0].get());
+}
+
+void EngineEffectsManager::beginParallelBatch() {
+    DEBUG_ASSERT(!m_bBatchActive);
+    if (m_bBatchStalled) {
+        if (m_pThreadPool->isBusy()) {
+            // The helper still uses the stalled batch
+            return;
+        }
+        m_bBatchStalled = false;
+        m_batch.clear();
+    }
+    DEBUG_ASSERT(m_batch.empty());
+    m_bBatchActive = m_pThreadPool != nullptr;
+}
+
+bool EngineEffectsManager::addToBatch(
+    const ChannelHandle& inputHandle,
+    const ChannelHandle& outputHandle,
+    CSAMPLE* pIn, CSAMPLE* pMixOutput,
+    const unsigned int numSamples,
+    const unsigned int sampleRate,
+    const GroupFeatureState& groupFeatures,
+    const CSAMPLE_GAIN oldGain,
+    const CSAMPLE_GAIN newGain) {
+    if (!m_bBatchActive || static_cast<int>(m_batch.size()) >= kMaxBatchSize) {
+        return false;
+    }
+    BatchEntry entry;
+    entry.inputHandle = inputHandle;
+    entry.outputHandle = outputHandle;
+    entry.pIn = pIn;
+    entry.pMixOutput = pMixOutput;
+    entry.numSamples = numSamples;
+    entry.sampleRate = sampleRate;
+    entry.groupFeatures = groupFeatures;
+    entry.oldGain = oldGain;
+    entry.newGain = newGain;
+    // Does not allocate, the capacity has been reserved upfront.
+    m_batch.push_back(entry);
+    return true;
+}
+
+void EngineEffectsManager::finishParallelBatch() {
+    if (!m_bBatchActive) {
+        return;
+    }
+    m_bBatchActive = false;
+    if (m_batch.empty()) {
+        return;
+    }
+
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Effects);
+    const bool finished = m_pThreadPool->run(this, static_cast<int>(m_batch.size()));
+
+    // Mix in a fixed order to produce the same output regardless of which
+    // thread finished first.
+    for (std::size_t i = 0; i < m_batch.size(); ++i) {
+        const BatchEntry& entry = m_batch[i];
+        if (!finished && !m_pThreadPool->isPartFinished(static_cast<int>(i))) {
+            // The helper still reads the input, so it is mixed without
+            // effects and left alone if processed in place
+            if (entry.pMixOutput) {
+                SampleUtil::addWithRampingGain(entry.pMixOutput, entry.pIn,
+                        entry.oldGain, entry.newGain, entry.numSamples);
+            }
+            continue;
+        }
+        if (entry.pMixOutput) {
+            SampleUtil::add(entry.pMixOutput, m_batchOutputs[i].data(),
+                            entry.numSamples);
+        } else {
+            SampleUtil::copy(entry.pIn, m_batchOutputs[i].data(),
+                             entry.numSamples);
+        }
+    }
+    if (finished) {
+        m_batch.clear();
+    } else {
+        // Kept until the helper has finished
+        m_bBatchStalled = true;
+    }
+}
+
+bool EngineEffectsManager::isStalledChannel(
+        const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) const {
+    if (!m_bBatchStalled) {
+        return false;
+    }
+    for (std::size_t i = 0; i < m_batch.size(); ++i) {
+        if (m_batch[i].inputHandle == inputHandle &&
+                m_batch[i].outputHandle == outputHandle &&
+                !m_pThreadPool->isPartFinished(static_cast<int>(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EngineEffectsManager::runJobPart(int partIndex, int threadIndex) {
+    const BatchEntry& entry = m_batch[partIndex];
+    EngineEffectsScratchBuffers* pScratch = m_scratchBuffers[threadIndex].get();
+    // The outputs are shared between the entries of a batch, so the
+    // processed signal is collected separately and mixed afterwards. The
+    // input is not modified even if it is processed in place, so a stalled
+    // helper does not interfere with the engine.
+    CSAMPLE* pOutput = m_batchOutputs[partIndex].data();
+    SampleUtil::clear(pOutput, entry.numSamples);
+    processInner(SignalProcessingStage::Postfader,
+                 entry.inputHandle, entry.outputHandle,
+                 entry.pIn, pOutput,
+                 entry.numSamples, entry.sampleRate, entry.groupFeatures,
+                 entry.oldGain, entry.newGain,
+                 pScratch);
 }
 
 void EngineEffectsManager::processInner(
@@ -177,8 +353,11 @@ void EngineEffectsManager::processInner(
     const unsigned int sampleRate,
     const GroupFeatureState& groupFeatures,
     const CSAMPLE_GAIN oldGain,
-    const CSAMPLE_GAIN newGain) {
+    const CSAMPLE_GAIN newGain,
+    EngineEffectsScratchBuffers* pScratch) {
 
+    // Only read access, m_racksByStage is modified exclusively in
+    // onCallbackStart() and never while a batch is processed.
     const QList<EngineEffectRack*>& racks = m_racksByStage.value(stage);
     if (pIn == pOut) {
         // Gain and effects are applied to the buffer in place,
@@ -188,7 +367,8 @@ void EngineEffectsManager::processInner(
             if (pRack != nullptr) {
                 pRack->process(inputHandle, outputHandle,
                                pIn, pIn,
-                               numSamples, sampleRate, groupFeatures);
+                               numSamples, sampleRate, groupFeatures,
+                               pScratch);
             }
         }
     } else {
@@ -199,7 +379,7 @@ void EngineEffectsManager::processInner(
         // 3. Mix the temporary buffer into pOut
         //    ChannelMixer::applyEffectsAndMixChannels use
         //    this to mix channels into pOut regardless of whether any effects were processed.
-        CSAMPLE* pIntermediateInput = m_buffer1.data();
+        CSAMPLE* pIntermediateInput = pScratch->managerBuffer1.data();
         if (oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE) {
             // Avoid an unnecessary copy. EngineEffectRack::process does not modify the
             // input buffer when its input & output buffers are different, so this is okay.
@@ -213,15 +393,16 @@ void EngineEffectsManager::processInner(
         for (EngineEffectRack* pRack : racks) {
             if (pRack != nullptr) {
                 // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
+                if (pIntermediateInput == pScratch->managerBuffer1.data()) {
+                    pIntermediateOutput = pScratch->managerBuffer2.data();
                 } else {
-                    pIntermediateOutput = m_buffer1.data();
+                    pIntermediateOutput = pScratch->managerBuffer1.data();
                 }
 
                 if (pRack->process(inputHandle, outputHandle,
                                    pIntermediateInput, pIntermediateOutput,
-                                   numSamples, sampleRate, groupFeatures)) {
+                                   numSamples, sampleRate, groupFeatures,
+                                   pScratch)) {
                     // Output of this rack becomes the input of the next rack.
                     pIntermediateInput = pIntermediateOutput;
                 }
@@ -3,22 +3,36 @@
 
 #include <QScopedPointer>
 
+#include <memory>
+#include <vector>
+
 #include "util/samplebuffer.h"
 #include "util/types.h"
 #include "util/fifo.h"
+#include "engine/effects/engineeffectsscratchbuffers.h"
 #include "engine/effects/message.h"
 #include "engine/effects/groupfeaturestate.h"
 #include "engine/channelhandle.h"
+#include "engine/enginethreadpool.h"
 
 class EngineEffectRack;
 class EngineEffectChain;
 class EngineEffect;
 
-class EngineEffectsManager : public EffectsRequestHandler {
+class EngineEffectsManager : public EffectsRequestHandler,
+                             private EngineThreadPoolJob {
   public:
-    EngineEffectsManager(EffectsResponsePipe* pResponsePipe);
+    // If numWorkerThreads is greater than 0 the post-fader effects of
+    // channels that are mixed together are processed concurrently on that
+    // many helper threads in addition to the engine thread.
+    EngineEffectsManager(EffectsResponsePipe* pResponsePipe,
+                         int numWorkerThreads = 0);
     virtual ~EngineEffectsManager();
 
+    bool isParallelProcessingEnabled() const {
+        return m_pThreadPool != nullptr;
+    }
+
     void onCallbackStart();
 
     // Take a buffer of numSamples samples of audio from a channel, provided as
@@ -55,11 +69,59 @@ class EngineEffectsManager : public EffectsRequestHandler {
         const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
         const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
 
+    // Between beginParallelBatch() and finishParallelBatch() the calls of
+    // processPostFaderInPlace() and processPostFaderAndMix() only record the
+    // work. finishParallelBatch() then processes all recorded channels
+    // concurrently and returns after all of them have been processed and
+    // mixed into their outputs. The channels in a batch must be distinct,
+    // because an EngineEffectChain keeps its state per input/output channel
+    // pair. Without worker threads both calls are no-ops and all processing
+    // happens immediately.
+    //
+    // If a helper thread stalls, the channel it processes is mixed without
+    // effects. Until the helper has finished, that channel stays without
+    // effects, all channels are processed immediately and effects requests
+    // are deferred.
+    void beginParallelBatch();
+    void finishParallelBatch();
+
     bool processEffectsRequest(
         EffectsRequest& message,
         EffectsResponsePipe* pResponsePipe);
 
   private:
+    // Deferred post-fader processing of a single channel.
+    struct BatchEntry {
+        ChannelHandle inputHandle;
+        ChannelHandle outputHandle;
+        CSAMPLE* pIn;
+        // nullptr if processing is done in place.
+        CSAMPLE* pMixOutput;
+        unsigned int numSamples;
+        unsigned int sampleRate;
+        GroupFeatureState groupFeatures;
+        CSAMPLE_GAIN oldGain;
+        CSAMPLE_GAIN newGain;
+    };
+
+    // Returns false if the channel needs to be processed immediately.
+    bool addToBatch(const ChannelHandle& inputHandle,
+                    const ChannelHandle& outputHandle,
+                    CSAMPLE* pIn, CSAMPLE* pMixOutput,
+                    const unsigned int numSamples,
+                    const unsigned int sampleRate,
+                    const GroupFeatureState& groupFeatures,
+                    const CSAMPLE_GAIN oldGain,
+                    const CSAMPLE_GAIN newGain);
+
+    // EngineThreadPoolJob
+    void runJobPart(int partIndex, int threadIndex) override;
+
+    // Returns true while a helper still processes the channel in the
+    // background
+    bool isStalledChannel(const ChannelHandle& inputHandle,
+                          const ChannelHandle& outputHandle) const;
+
     QString debugString() const {
         return QString("EngineEffectsManager");
     }
@@ -80,16 +142,25 @@ class EngineEffectsManager : public EffectsRequestHandler {
                       const unsigned int numSamples,
                       const unsigned int sampleRate,
                       const GroupFeatureState& groupFeatures,
-                      const CSAMPLE_GAIN oldGain = CSAMPLE_GAIN_ONE,
-                      const CSAMPLE_GAIN newGain = CSAMPLE_GAIN_ONE);
+                      const CSAMPLE_GAIN oldGain,
+                      const CSAMPLE_GAIN newGain,
+                      EngineEffectsScratchBuffers* pScratch);
 
     QScopedPointer<EffectsResponsePipe> m_pResponsePipe;
     QHash<SignalProcessingStage, QList<EngineEffectRack*>> m_racksByStage;
     QList<EngineEffectChain*> m_chains;
     QList<EngineEffect*> m_effects;
 
-    mixxx::SampleBuffer m_buffer1;
-    mixxx::SampleBuffer m_buffer2;
+    std::unique_ptr<EngineThreadPool> m_pThreadPool;
+    // One set per thread of m_pThreadPool, index 0 is the engine thread.
+    std::vector<std::unique_ptr<EngineEffectsScratchBuffers>> m_scratchBuffers;
+
+    bool m_bBatchActive;
+    // A helper has not finished its part of m_batch in time
+    bool m_bBatchStalled;
+    std::vector<BatchEntry> m_batch;
+    // The processed signal of each batch entry that is mixed into an output.
+    std::vector<mixxx::SampleBuffer> m_batchOutputs;
 };
 
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "util/defs.h"
+#include "util/samplebuffer.h"
+
+// Intermediate buffers needed while running one channel through the effect
+// racks of a signal processing stage. The EngineEffectsManager, each
+// EngineEffectRack and each EngineEffectChain on the way ping-pong between
+// their own pair of buffers. Every thread that processes effects
+// concurrently needs its own set, so these are owned by the
+// EngineEffectsManager and passed down instead of being members of the
+// racks and chains.
+struct EngineEffectsScratchBuffers {
+    EngineEffectsScratchBuffers()
+            : managerBuffer1(MAX_BUFFER_LEN),
+              managerBuffer2(MAX_BUFFER_LEN),
+              rackBuffer1(MAX_BUFFER_LEN),
+              rackBuffer2(MAX_BUFFER_LEN),
+              chainBuffer1(MAX_BUFFER_LEN),
+              chainBuffer2(MAX_BUFFER_LEN),
+              chainPlanarBuffer1L(MAX_BUFFER_LEN),
+              chainPlanarBuffer1R(MAX_BUFFER_LEN),
+              chainPlanarBuffer2L(MAX_BUFFER_LEN),
+              chainPlanarBuffer2R(MAX_BUFFER_LEN) {
+    }
+
+    mixxx::SampleBuffer managerBuffer1;
+    mixxx::SampleBuffer managerBuffer2;
+    mixxx::SampleBuffer rackBuffer1;
+    mixxx::SampleBuffer rackBuffer2;
+    mixxx::SampleBuffer chainBuffer1;
+    mixxx::SampleBuffer chainBuffer2;
+    // Shared by consecutive effects of a chain that support planar
+    // processing.
+    mixxx::SampleBuffer chainPlanarBuffer1L;
+    mixxx::SampleBuffer chainPlanarBuffer1R;
+    mixxx::SampleBuffer chainPlanarBuffer2L;
+    mixxx::SampleBuffer chainPlanarBuffer2R;
+};
@@ -1,6 +1,7 @@
 #include "engine/enginebuffer.h"
 
 #include <cfloat>
+#include <memory>
 
 #include <QtDebug>
 
@@ -20,6 +21,7 @@
 #include "engine/controls/quantizecontrol.h"
 #include "engine/controls/ratecontrol.h"
 #include "engine/bufferscalers/enginebufferscalelinear.h"
+#include "engine/bufferscalers/enginebufferscalelookahead.h"
 #include "engine/bufferscalers/enginebufferscalerubberband.h"
 #include "engine/bufferscalers/enginebufferscalest.h"
 #include "engine/channels/enginechannel.h"
@@ -82,6 +84,9 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_pRepeat(nullptr),
           m_startButton(nullptr),
           m_endButton(nullptr),
+          m_pScaleLookAhead(nullptr),
+          m_scaleLookAheadEngine(SOUNDTOUCH),
+          m_pWorkerScheduler(nullptr),
           m_bScalerOverride(false),
           m_iSeekQueued(SEEK_NONE),
           m_iSeekPhaseQueued(0),
@@ -237,13 +242,18 @@ EngineBuffer::EngineBuffer(const QString& group,
 
     // Construct scaling objects
     m_pScaleLinear = new EngineBufferScaleLinear(m_pReadAheadManager);
+    m_pResamplerQuality = new ControlProxy("[Master]", "resampler_quality", this);
+    m_pResamplerQuality->connectValueChanged(this, &EngineBuffer::slotResamplerQualityChanged,
+                                             Qt::DirectConnection);
+    slotResamplerQualityChanged(m_pResamplerQuality->get());
     m_pScaleST = new EngineBufferScaleST(m_pReadAheadManager);
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
-    if (m_pKeylockEngine->get() == SOUNDTOUCH) {
-        m_pScaleKeylock = m_pScaleST;
-    } else {
-        m_pScaleKeylock = m_pScaleRB;
-    }
+    // m_pScaleLookAhead is only created while the look-ahead is enabled,
+    // because it runs a thread and buffers for each deck
+    m_pKeylockLookAhead = new ControlProxy("[Master]", "keylock_lookahead", this);
+    m_pKeylockLookAhead->connectValueChanged(this, &EngineBuffer::slotKeylockLookAheadChanged,
+                                             Qt::DirectConnection);
+    slotKeylockEngineChanged(m_pKeylockEngine->get());
     m_pScaleVinyl = m_pScaleLinear;
     m_pScale = m_pScaleVinyl;
     m_pScale->clear();
@@ -292,6 +302,7 @@ EngineBuffer::~EngineBuffer() {
     delete m_pTrackSampleRate;
 
     delete m_pScaleLinear;
+    delete m_pScaleLookAhead;
     delete m_pScaleST;
     delete m_pScaleRB;
 
@@ -332,6 +343,10 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
             // applied later
             readToCrossfadeBuffer(iBufferSize);
         }
+        if (m_pScale == m_pScaleLookAhead) {
+            // Takes the stretcher back from the worker
+            m_pScaleLookAhead->clear();
+        }
         m_pScale = keylock_scale;
         m_pScale->clear();
         m_bScalerChanged = true;
@@ -341,6 +356,9 @@ void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
             // (for slow speeds below 0.1 the vinyl_scale is used)
             readToCrossfadeBuffer(iBufferSize);
         }
+        if (m_pScale == m_pScaleLookAhead) {
+            m_pScaleLookAhead->clear();
+        }
         m_pScale = vinyl_scale;
         m_pScale->clear();
         m_bScalerChanged = true;
@@ -698,16 +716,91 @@ void EngineBuffer::slotKeylockEngineChanged(double dIndex) {
     int iEngine = static_cast<int>(dIndex);
     KeylockEngine engine = static_cast<KeylockEngine>(iEngine);
     if (engine == SOUNDTOUCH) {
-        m_pScaleKeylock = m_pScaleST;
+        m_pScaleKeylockStretcher = m_pScaleST;
     } else {
-        m_pScaleKeylock = m_pScaleRB;
+        m_pScaleKeylockStretcher = m_pScaleRB;
     }
+    slotKeylockLookAheadChanged(m_pKeylockLookAhead->get());
+}
+
+void EngineBuffer::slotKeylockLookAheadChanged(double v) {
+    if (m_bScalerOverride) {
+        return;
+    }
+    const KeylockEngine engine =
+            m_pScaleKeylockStretcher == m_pScaleST ? SOUNDTOUCH : RUBBERBAND;
+    EngineBufferScaleLookAhead* pScaleLookAhead = nullptr;
+    if (v > 0.0) {
+        if (m_pScaleLookAhead && m_scaleLookAheadEngine == engine) {
+            pScaleLookAhead = m_pScaleLookAhead;
+        } else {
+            pScaleLookAhead = newScaleLookAhead(engine);
+        }
+    }
+    if (pScaleLookAhead == m_pScaleLookAhead) {
+        m_pScaleKeylock = pScaleLookAhead ? pScaleLookAhead : m_pScaleKeylockStretcher;
+        return;
+    }
+
+    // The engine uses m_pScaleLookAhead only while holding the pause lock
+    m_pause.lock();
+    EngineBufferScaleLookAhead* pOldScaleLookAhead = m_pScaleLookAhead;
+    if (pOldScaleLookAhead && m_pScale == pOldScaleLookAhead) {
+        // The new scaler starts at the playhead, because the input of the
+        // old one has been read ahead
+        m_pScale = pScaleLookAhead ? pScaleLookAhead : m_pScaleKeylockStretcher;
+        m_pScale->clear();
+        m_pReadAheadManager->notifySeek(m_filepos_play);
+        m_bScalerChanged = true;
+    }
+    m_pScaleLookAhead = pScaleLookAhead;
+    m_scaleLookAheadEngine = engine;
+    m_pScaleKeylock = pScaleLookAhead ? pScaleLookAhead : m_pScaleKeylockStretcher;
+    m_pause.unlock();
+
+    // Stops the worker thread
+    delete pOldScaleLookAhead;
+}
+
+EngineBufferScaleLookAhead* EngineBuffer::newScaleLookAhead(KeylockEngine engine) {
+    auto pScaleLookAhead = new EngineBufferScaleLookAhead(m_pReadAheadManager);
+    // The stretchers read through the look-ahead wrapper, which passes
+    // through to m_pReadAheadManager while it is not running ahead.
+    ReadAheadManager* pInput = pScaleLookAhead->getInputReadAheadManager();
+    if (engine == SOUNDTOUCH) {
+        pScaleLookAhead->setScales(
+                std::make_unique<EngineBufferScaleST>(pInput),
+                std::make_unique<EngineBufferScaleST>(pInput));
+    } else {
+        pScaleLookAhead->setScales(
+                std::make_unique<EngineBufferScaleRubberBand>(pInput),
+                std::make_unique<EngineBufferScaleRubberBand>(pInput));
+    }
+    if (m_pWorkerScheduler) {
+        pScaleLookAhead->setScheduler(m_pWorkerScheduler);
+    }
+    return pScaleLookAhead;
+}
+
+void EngineBuffer::slotResamplerQualityChanged(double dIndex) {
+    int iQuality = static_cast<int>(dIndex);
+    if (iQuality < static_cast<int>(EngineBufferScaleLinear::Quality::Linear) ||
+            iQuality > static_cast<int>(EngineBufferScaleLinear::Quality::Sinc8)) {
+        iQuality = static_cast<int>(EngineBufferScaleLinear::Quality::Linear);
+    }
+    m_pScaleLinear->setQuality(
+            static_cast<EngineBufferScaleLinear::Quality>(iQuality));
 }
 
 void EngineBuffer::processTrackLocked(
         CSAMPLE* pOutput, const int iBufferSize, int sample_rate) {
     ScopedTimer t("EngineBuffer::process_pauselock");
 
+    if (m_pScaleLookAhead) {
+        // Takes the stretcher back from the worker if the sample rate changes
+        m_pScaleLookAhead->setSampleRate(mixxx::audio::SampleRate(sample_rate));
+    }
+
     m_trackSampleRateOld = m_pTrackSampleRate->get();
     m_trackSamplesOld = m_pTrackSamples->get();
 
@@ -881,6 +974,12 @@ void EngineBuffer::processTrackLocked(
             readToCrossfadeBuffer(iBufferSize);
             // Clear the scaler information
             m_pScale->clear();
+        } else if (m_pScale == m_pScaleLookAhead &&
+                m_pScaleLookAhead->isRateJump(baserate, speed, pitchRatio)) {
+            // Don't play the frames that have been stretched ahead with the
+            // old rate, crossfade like on a seek instead.
+            readToCrossfadeBuffer(iBufferSize);
+            m_pScale->clear();
         }
 
         m_baserate_old = baserate;
@@ -932,6 +1031,15 @@ void EngineBuffer::processTrackLocked(
 
     // If the buffer is not paused, then scale the audio.
     if (!bCurBufferPaused) {
+        if (m_pScale == m_pScaleLookAhead &&
+                !m_pScaleLookAhead->prepareScaleBuffer(iBufferSize)) {
+            // The worker has not kept up and the spare stretcher continues
+            // at the playhead, crossfaded like on a seek
+            readToCrossfadeBuffer(iBufferSize);
+            m_pReadAheadManager->notifySeek(m_filepos_play);
+            m_pScale->clear();
+        }
+
         // Perform scaling of Reader buffer into buffer.
         double framesRead =
                 m_pScale->scaleBuffer(pOutput, iBufferSize);
@@ -1303,6 +1411,10 @@ void EngineBuffer::addControl(EngineControl* pControl) {
 
 void EngineBuffer::bindWorkers(EngineWorkerScheduler* pWorkerScheduler) {
     m_pReader->setScheduler(pWorkerScheduler);
+    m_pWorkerScheduler = pWorkerScheduler;
+    if (m_pScaleLookAhead) {
+        m_pScaleLookAhead->setScheduler(pWorkerScheduler);
+    }
 }
 
 bool EngineBuffer::isTrackLoaded() {
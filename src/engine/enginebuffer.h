@@ -57,6 +57,7 @@ class ControlTTRotary;
 class ControlPotmeter;
 class EngineBufferScale;
 class EngineBufferScaleLinear;
+class EngineBufferScaleLookAhead;
 class EngineBufferScaleST;
 class EngineBufferScaleRubberBand;
 class EngineSync;
@@ -193,6 +194,8 @@ class EngineBuffer : public EngineObject {
     void slotControlSeekAbs(double);
     void slotControlSeekExact(double);
     void slotKeylockEngineChanged(double);
+    void slotResamplerQualityChanged(double);
+    void slotKeylockLookAheadChanged(double);
 
     void slotEjectTrack(double);
 
@@ -216,6 +219,7 @@ class EngineBuffer : public EngineObject {
 
     void enableIndependentPitchTempoScaling(bool bEnable,
                                             const int iBufferSize);
+    EngineBufferScaleLookAhead* newScaleLookAhead(KeylockEngine engine);
 
     void updateIndicators(double rate, int iBufferSize);
 
@@ -348,6 +352,8 @@ class EngineBuffer : public EngineObject {
     ControlPotmeter* m_playposSlider;
     ControlProxy* m_pSampleRate;
     ControlProxy* m_pKeylockEngine;
+    ControlProxy* m_pResamplerQuality;
+    ControlProxy* m_pKeylockLookAhead;
     ControlPushButton* m_pKeylock;
 
     // This ControlProxys is created as parent to this and deleted by
@@ -378,12 +384,21 @@ class EngineBuffer : public EngineObject {
     // The keylock engine is configurable, so it could flip flop between
     // ScaleST and ScaleRB during a single callback.
     EngineBufferScale* volatile m_pScaleKeylock;
+    // ScaleST or ScaleRB, which is used as m_pScaleKeylock unless the
+    // look-ahead is enabled
+    EngineBufferScale* volatile m_pScaleKeylockStretcher;
 
     // Object used for vinyl-style interpolation scaling of the audio
     EngineBufferScaleLinear* m_pScaleLinear;
     // Objects used for pitch-indep time stretch (key lock) scaling of the audio
     EngineBufferScaleST* m_pScaleST;
     EngineBufferScaleRubberBand* m_pScaleRB;
+    // Stretches ahead of the playhead on a worker thread with its own
+    // stretchers of m_scaleLookAheadEngine. Only exists while the keylock
+    // look-ahead is enabled.
+    EngineBufferScaleLookAhead* m_pScaleLookAhead;
+    KeylockEngine m_scaleLookAheadEngine;
+    EngineWorkerScheduler* m_pWorkerScheduler;
 
     // Indicates whether the scaler has changed since the last process()
     bool m_bScalerChanged;
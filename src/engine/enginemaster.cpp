@@ -24,6 +24,7 @@
 #include "engine/sidechain/enginesidechain.h"
 #include "engine/sync/enginesync.h"
 #include "mixer/playermanager.h"
+#include "util/callbackprofiler.h"
 #include "util/defs.h"
 #include "util/sample.h"
 #include "util/timer.h"
@@ -175,6 +176,16 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
     m_pKeylockEngine->set(pConfig->getValueString(
             ConfigKey(group, "keylock_engine")).toDouble());
 
+    m_pResamplerQuality = new ControlObject(ConfigKey(group, "resampler_quality"),
+                                            true, false, true);
+    m_pResamplerQuality->set(pConfig->getValueString(
+            ConfigKey(group, "resampler_quality")).toDouble());
+
+    m_pKeylockLookAhead = new ControlObject(ConfigKey(group, "keylock_lookahead"),
+                                            true, false, true);
+    m_pKeylockLookAhead->set(pConfig->getValueString(
+            ConfigKey(group, "keylock_lookahead")).toDouble());
+
     // TODO: Make this read only and make EngineMaster decide whether
     // processing the master mix is necessary.
     m_pMasterEnabled = new ControlObject(ConfigKey(group, "enabled"),
@@ -194,6 +205,8 @@ EngineMaster::EngineMaster(UserSettingsPointer pConfig,
 EngineMaster::~EngineMaster() {
     qDebug() << "in ~EngineMaster()";
     delete m_pKeylockEngine;
+    delete m_pResamplerQuality;
+    delete m_pKeylockLookAhead;
     delete m_pCrossfader;
     delete m_pBalance;
     delete m_pHeadMix;
@@ -275,6 +288,7 @@ void EngineMaster::processChannels(int iBufferSize) {
     m_activeChannels.clear();
 
     //ScopedTimer timer("EngineMaster::processChannels");
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::ProcessChannels);
     EngineChannel* pMasterChannel = m_pMasterSync->getMaster();
     // Reserve the first place for the master channel which
     // should be processed first
@@ -378,6 +392,8 @@ void EngineMaster::process(const int iBufferSize) {
         haveSetName = true;
     }
     //Trace t("EngineMaster::process");
+    // Everything that is not accounted to a nested stage
+    CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Mixing);
 
     bool masterEnabled = m_pMasterEnabled->get();
     bool boothEnabled = m_pBoothEnabled->get();
@@ -667,6 +683,8 @@ void EngineMaster::process(const int iBufferSize) {
         // so skip sending a buffer to m_pSidechain here.
         if (!m_bExternalRecordBroadcastInputConnected
             && m_pEngineSideChain != nullptr) {
+            CallbackProfiler::ScopedStage sidechainStage(
+                    CallbackProfiler::Stage::SidechainPush);
             m_pEngineSideChain->writeSamples(m_pSidechainMix, iFrames);
         }
 
@@ -729,6 +747,10 @@ void EngineMaster::process(const int iBufferSize) {
     m_pWorkerScheduler->runWorkers();
 }
 
+void EngineMaster::waitForWorkers() {
+    m_pWorkerScheduler->waitForIdleWorkers();
+}
+
 void EngineMaster::applyMasterEffects() {
     // Apply master effects
     if (m_pEngineEffectsManager) {
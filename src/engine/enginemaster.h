@@ -86,6 +86,11 @@ class EngineMaster : public QObject, public AudioSource {
 
     void process(const int iBufferSize);
 
+    // Blocks until the engine workers, e.g. the readers of the decks, have
+    // handled all requests of the previous callbacks. Only for clocking the
+    // engine offline, must not be called from the audio callback.
+    void waitForWorkers();
+
     // Add an EngineChannel to the mixing engine. This is not thread safe --
     // only call it before the engine has started mixing.
     void addChannel(EngineChannel* pChannel);
@@ -333,6 +338,8 @@ class EngineMaster : public QObject, public AudioSource {
     ControlPushButton* m_pXFaderReverse;
     ControlPushButton* m_pHeadSplitEnabled;
     ControlObject* m_pKeylockEngine;
+    ControlObject* m_pResamplerQuality;
+    ControlObject* m_pKeylockLookAhead;
 
     PflGainCalculator m_headphoneGain;
     TalkoverGainCalculator m_talkoverGain;
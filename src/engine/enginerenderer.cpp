@@ -0,0 +1,387 @@
+#include "engine/enginerenderer.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+
+#include "control/controlobject.h"
+#include "engine/channels/enginechannel.h"
+#include "engine/enginebuffer.h"
+#include "engine/enginemaster.h"
+#include "mixer/basetrackplayer.h"
+#include "mixer/playermanager.h"
+#include "util/defs.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+mixxx::Logger kLogger("EngineRenderer");
+
+const ConfigKey kSampleRateKey("[Master]", "samplerate");
+const ConfigKey kMasterEnabledKey("[Master]", "enabled");
+
+const QRegularExpression kWhitespace(QStringLiteral("\\s+"));
+// The file name is the rest of the line and may contain spaces
+const QRegularExpression kLoadLine(
+        QStringLiteral("^load\\s+(\\S+)\\s+(\\S+)\\s+(play|cue)\\s+(.+)$"));
+
+bool parseFrame(const QString& seconds, double sampleRate, SINT* pFrame) {
+    bool ok;
+    const double value = seconds.toDouble(&ok);
+    if (!ok || value < 0) {
+        return false;
+    }
+    *pFrame = static_cast<SINT>(std::round(value * sampleRate));
+    return true;
+}
+
+// Writes the encoded output to a file
+class FileEncoderCallback : public EncoderCallback {
+  public:
+    explicit FileEncoderCallback(const QString& filePath)
+            : m_file(filePath),
+              m_bWriteFailed(false) {
+    }
+
+    bool open() {
+        return m_file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+
+    bool writeFailed() const {
+        return m_bWriteFailed;
+    }
+
+    void write(const unsigned char* header, const unsigned char* body,
+            int headerLen, int bodyLen) override {
+        // Relevant for OGG
+        if (headerLen > 0 &&
+                m_file.write(reinterpret_cast<const char*>(header), headerLen) != headerLen) {
+            m_bWriteFailed = true;
+        }
+        if (m_file.write(reinterpret_cast<const char*>(body), bodyLen) != bodyLen) {
+            m_bWriteFailed = true;
+        }
+    }
+    int tell() override {
+        return static_cast<int>(m_file.pos());
+    }
+    void seek(int pos) override {
+        m_file.seek(static_cast<qint64>(pos));
+    }
+    int filelen() override {
+        return static_cast<int>(m_file.size());
+    }
+
+  private:
+    QFile m_file;
+    bool m_bWriteFailed;
+};
+
+} // anonymous namespace
+
+void EngineRenderTimeline::setControl(SINT frame, const ConfigKey& key, double value) {
+    Event event;
+    event.type = Event::Type::SetControl;
+    event.frame = frame;
+    event.endFrame = frame;
+    event.key = key;
+    event.value = value;
+    event.endValue = value;
+    event.play = false;
+    addEvent(std::move(event));
+}
+
+void EngineRenderTimeline::rampControl(SINT startFrame, SINT endFrame,
+        const ConfigKey& key, double startValue, double endValue) {
+    DEBUG_ASSERT(startFrame <= endFrame);
+    Event event;
+    event.type = Event::Type::RampControl;
+    event.frame = startFrame;
+    event.endFrame = endFrame;
+    event.key = key;
+    event.value = startValue;
+    event.endValue = endValue;
+    event.play = false;
+    addEvent(std::move(event));
+}
+
+void EngineRenderTimeline::loadTrack(SINT frame, const QString& group,
+        TrackPointer pTrack, bool play) {
+    Event event;
+    event.type = Event::Type::LoadTrack;
+    event.frame = frame;
+    event.endFrame = frame;
+    event.key = ConfigKey(group, QString());
+    event.value = 0.0;
+    event.endValue = 0.0;
+    event.pTrack = std::move(pTrack);
+    event.play = play;
+    addEvent(std::move(event));
+}
+
+bool EngineRenderTimeline::parse(const QString& script,
+        double sampleRate,
+        const TrackResolver& resolveTrack,
+        SINT* pEndFrame,
+        QString* pError) {
+    DEBUG_ASSERT(sampleRate > 0);
+    bool hasEnd = false;
+    const QStringList lines = script.split(QChar('\n'));
+    for (int i = 0; i < lines.size(); ++i) {
+        const QString line = lines.at(i).trimmed();
+        if (line.isEmpty() || line.startsWith(QChar('#'))) {
+            continue;
+        }
+        const QStringList args = line.split(kWhitespace);
+        const QString& command = args.first();
+        SINT frame = 0;
+        bool valid = args.size() >= 2 &&
+                parseFrame(args.at(1), sampleRate, &frame);
+        if (!valid) {
+            // Invalid time
+        } else if (command == QStringLiteral("load")) {
+            const QRegularExpressionMatch match = kLoadLine.match(line);
+            valid = match.hasMatch();
+            if (valid) {
+                const QString location = match.captured(4);
+                TrackPointer pTrack = resolveTrack(location);
+                if (!pTrack) {
+                    *pError = QString("Line %1: Failed to load %2")
+                                      .arg(QString::number(i + 1), location);
+                    return false;
+                }
+                loadTrack(frame, match.captured(2), std::move(pTrack),
+                        match.captured(3) == QStringLiteral("play"));
+            }
+        } else if (command == QStringLiteral("set")) {
+            double value = 0;
+            valid = args.size() == 5;
+            if (valid) {
+                value = args.at(4).toDouble(&valid);
+            }
+            if (valid) {
+                setControl(frame, ConfigKey(args.at(2), args.at(3)), value);
+            }
+        } else if (command == QStringLiteral("ramp")) {
+            SINT endFrame = 0;
+            double startValue = 0;
+            double endValue = 0;
+            valid = args.size() == 7 &&
+                    parseFrame(args.at(2), sampleRate, &endFrame) &&
+                    endFrame >= frame;
+            if (valid) {
+                startValue = args.at(5).toDouble(&valid);
+            }
+            if (valid) {
+                endValue = args.at(6).toDouble(&valid);
+            }
+            if (valid) {
+                rampControl(frame, endFrame, ConfigKey(args.at(3), args.at(4)),
+                        startValue, endValue);
+            }
+        } else if (command == QStringLiteral("end")) {
+            valid = args.size() == 2;
+            if (valid) {
+                *pEndFrame = frame;
+                hasEnd = true;
+            }
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            *pError = QString("Line %1: Invalid event: %2")
+                              .arg(QString::number(i + 1), line);
+            return false;
+        }
+    }
+    if (!hasEnd) {
+        *pError = QStringLiteral("The end of the render is missing");
+        return false;
+    }
+    return true;
+}
+
+void EngineRenderTimeline::addEvent(Event event) {
+    // Keep the order of insertion for events at the same frame
+    const auto it = std::upper_bound(m_events.begin(), m_events.end(), event.frame,
+            [](SINT frame, const Event& other) {
+                return frame < other.frame;
+            });
+    m_events.insert(it, std::move(event));
+}
+
+EngineRenderer::EngineRenderer(EngineMaster* pEngineMaster,
+        PlayerManagerInterface* pPlayerManager,
+        int framesPerBuffer)
+        : m_pEngineMaster(pEngineMaster),
+          m_pPlayerManager(pPlayerManager),
+          m_framesPerBuffer(framesPerBuffer),
+          m_pCallbackListener(nullptr),
+          m_renderedFrames(0) {
+    DEBUG_ASSERT(m_pEngineMaster);
+    DEBUG_ASSERT(m_framesPerBuffer > 0);
+    DEBUG_ASSERT(m_framesPerBuffer * 2 <= MAX_BUFFER_LEN);
+}
+
+double EngineRenderer::realTimeFactor() const {
+    const double sampleRate = ControlObject::get(kSampleRateKey);
+    const double renderSeconds = m_renderDuration.toDoubleSeconds();
+    if (sampleRate <= 0 || renderSeconds <= 0) {
+        return 0.0;
+    }
+    return m_renderedFrames / sampleRate / renderSeconds;
+}
+
+bool EngineRenderer::render(const EngineRenderTimeline& timeline,
+        SINT numFrames,
+        const AudioOutput& output,
+        const BufferConsumer& consumer) {
+    VERIFY_OR_DEBUG_ASSERT(output.getType() == AudioOutput::MASTER ||
+            output.getType() == AudioOutput::RECORD_BROADCAST) {
+        return false;
+    }
+    m_renderedFrames = 0;
+    m_renderDuration = mixxx::Duration();
+
+    // The record/broadcast mix is derived from the master mix, which is
+    // only mixed if a master output is connected.
+    const AudioOutput masterOutput(AudioOutput::MASTER, 0, 2);
+    const bool connectMaster = ControlObject::get(kMasterEnabledKey) == 0.0;
+    if (connectMaster) {
+        m_pEngineMaster->onOutputConnected(masterOutput);
+    }
+    const CSAMPLE* pOutputBuffer = m_pEngineMaster->buffer(output);
+
+    PerformanceTimer timer;
+    timer.start();
+    bool success = true;
+    auto nextEvent = timeline.m_events.cbegin();
+    std::vector<EngineRenderTimeline::Event> ramps;
+    while (m_renderedFrames < numFrames) {
+        const SINT bufferEnd = m_renderedFrames + m_framesPerBuffer;
+        while (nextEvent != timeline.m_events.cend() && nextEvent->frame < bufferEnd) {
+            if (nextEvent->type == EngineRenderTimeline::Event::Type::RampControl) {
+                ramps.push_back(*nextEvent);
+            } else if (!applyEvent(*nextEvent)) {
+                success = false;
+            }
+            ++nextEvent;
+        }
+        for (auto it = ramps.begin(); it != ramps.end();) {
+            const SINT rampFrames = it->endFrame - it->frame;
+            const double progress = rampFrames > 0 ?
+                    math_clamp(static_cast<double>(m_renderedFrames - it->frame) / rampFrames,
+                            0.0, 1.0) :
+                    1.0;
+            ControlObject::set(it->key,
+                    it->value + (it->endValue - it->value) * progress);
+            if (progress >= 1.0) {
+                it = ramps.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        const SINT bufferFrames = math_min<SINT>(m_framesPerBuffer, numFrames - m_renderedFrames);
+        if (m_pCallbackListener) {
+            m_pCallbackListener->callbackStarted();
+        }
+        m_pEngineMaster->process(bufferFrames * 2);
+        if (m_pCallbackListener) {
+            m_pCallbackListener->callbackFinished();
+        }
+        consumer(pOutputBuffer, bufferFrames * 2);
+        m_renderedFrames += bufferFrames;
+
+        // Instead of missing chunks that are not read in time like in a
+        // real-time callback, wait until the readers have caught up.
+        m_pEngineMaster->waitForWorkers();
+    }
+    m_renderDuration = timer.elapsed();
+
+    if (connectMaster) {
+        m_pEngineMaster->onOutputDisconnected(masterOutput);
+    }
+    return success;
+}
+
+bool EngineRenderer::renderToFile(const EngineRenderTimeline& timeline,
+        SINT numFrames,
+        const AudioOutput& output,
+        const QString& filePath,
+        Encoder::Format format,
+        UserSettingsPointer pConfig) {
+    FileEncoderCallback callback(filePath);
+    if (!callback.open()) {
+        kLogger.warning() << "Failed to open" << filePath;
+        return false;
+    }
+    EncoderPointer pEncoder = EncoderFactory::getFactory().createRecordingEncoder(
+            format, pConfig, &callback);
+    QString errorMessage;
+    if (!pEncoder ||
+            pEncoder->initEncoder(static_cast<int>(ControlObject::get(kSampleRateKey)),
+                    errorMessage) < 0) {
+        kLogger.warning() << "Failed to initialize the encoder" << errorMessage;
+        return false;
+    }
+
+    const bool success = render(timeline, numFrames, output,
+            [&pEncoder](const CSAMPLE* pBuffer, int iBufferSize) {
+                pEncoder->encodeBuffer(pBuffer, iBufferSize);
+            });
+    pEncoder->flush();
+    pEncoder.reset();
+    if (callback.writeFailed()) {
+        kLogger.warning() << "Failed to write" << filePath;
+        return false;
+    }
+    return success;
+}
+
+bool EngineRenderer::applyEvent(const EngineRenderTimeline::Event& event) {
+    switch (event.type) {
+    case EngineRenderTimeline::Event::Type::SetControl:
+        ControlObject::set(event.key, event.value);
+        return true;
+    case EngineRenderTimeline::Event::Type::LoadTrack: {
+        const QString& group = event.key.group;
+        BaseTrackPlayer* pPlayer = m_pPlayerManager ?
+                m_pPlayerManager->getPlayer(group) : nullptr;
+        if (!pPlayer) {
+            kLogger.warning() << "No player for" << group;
+            return false;
+        }
+        pPlayer->slotLoadTrack(event.pTrack, event.play);
+        return waitForTrackLoaded(group, event.pTrack);
+    }
+    case EngineRenderTimeline::Event::Type::RampControl:
+        // Ramps are applied per buffer
+        break;
+    }
+    DEBUG_ASSERT(!"Event type not handled");
+    return false;
+}
+
+bool EngineRenderer::waitForTrackLoaded(const QString& group,
+        const TrackPointer& pTrack) {
+    EngineChannel* pChannel = m_pEngineMaster->getChannel(group);
+    VERIFY_OR_DEBUG_ASSERT(pChannel && pChannel->getEngineBuffer()) {
+        return false;
+    }
+    // The reader loads the track in its worker, which reports the result
+    // before becoming idle.
+    m_pEngineMaster->waitForWorkers();
+    // Deliver the queued signals of the loaded track to the player, which
+    // sets up its controls, e.g. the BPM and the replay gain.
+    QCoreApplication::sendPostedEvents();
+    if (pChannel->getEngineBuffer()->getLoadedTrack() != pTrack) {
+        kLogger.warning() << "Failed to load track into" << group;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QString>
+#include <functional>
+#include <vector>
+
+#include "encoder/encoder.h"
+#include "preferences/usersettings.h"
+#include "soundio/soundmanagerutil.h"
+#include "track/track.h"
+#include "util/duration.h"
+#include "util/types.h"
+
+class EngineMaster;
+class PlayerManagerInterface;
+
+// A script of control changes and track loads at fixed positions of a
+// rendered mix, e.g. loading tracks, pressing play, moving the crossfader
+// or enabling effects. Positions are in frames of the rendered output and
+// are applied at the start of the buffer that contains them.
+class EngineRenderTimeline {
+  public:
+    // Returns the track of a file that is loaded by a timeline script
+    typedef std::function<TrackPointer(const QString& location)> TrackResolver;
+
+    void setControl(SINT frame, const ConfigKey& key, double value);
+    // Moves a control linearly from startValue to endValue, e.g. for
+    // crossfades. The value is updated once per buffer.
+    void rampControl(SINT startFrame, SINT endFrame, const ConfigKey& key,
+            double startValue, double endValue);
+    // Loads the track into the deck or sampler of the given group. Rendering
+    // is paused until the track has been loaded.
+    void loadTrack(SINT frame, const QString& group, TrackPointer pTrack,
+            bool play = false);
+
+    bool isEmpty() const {
+        return m_events.empty();
+    }
+
+    // Adds the events of a script with one event per line. Times are in
+    // seconds of the rendered output:
+    //   load <time> <group> play|cue <file>
+    //   set <time> <group> <item> <value>
+    //   ramp <startTime> <endTime> <group> <item> <startValue> <endValue>
+    //   end <time>
+    // Empty lines and lines starting with # are ignored. The end of the
+    // render is returned in pEndFrame. Returns false with a message in
+    // pError for the first invalid line.
+    bool parse(const QString& script,
+            double sampleRate,
+            const TrackResolver& resolveTrack,
+            SINT* pEndFrame,
+            QString* pError);
+
+  private:
+    friend class EngineRenderer;
+
+    struct Event {
+        enum class Type {
+            SetControl,
+            RampControl,
+            LoadTrack,
+        };
+        Type type;
+        SINT frame;
+        SINT endFrame;
+        ConfigKey key;
+        double value;
+        double endValue;
+        TrackPointer pTrack;
+        bool play;
+    };
+
+    void addEvent(Event event);
+
+    // Sorted by frame, events at the same frame in the order of insertion
+    std::vector<Event> m_events;
+};
+
+// Clocks the engine as fast as possible instead of from a sound device
+// callback, e.g. to render a prepared mix or to benchmark the whole signal
+// path reproducibly. The readers of the decks are waited for after every
+// buffer, so the output does not depend on the speed of the disk or of the
+// decoders.
+//
+// Must not be used while SoundManager has opened any devices.
+class EngineRenderer {
+  public:
+    static constexpr int kDefaultFramesPerBuffer = 1024;
+
+    // Receives each rendered buffer of interleaved stereo samples
+    typedef std::function<void(const CSAMPLE* pBuffer, int iBufferSize)>
+            BufferConsumer;
+
+    // Notified right before and after each call of EngineMaster::process,
+    // e.g. for measuring the callbacks in benchmarks. Waiting for the
+    // engine workers is not part of the callback.
+    class CallbackListener {
+      public:
+        virtual ~CallbackListener() = default;
+        virtual void callbackStarted() = 0;
+        virtual void callbackFinished() = 0;
+    };
+
+    EngineRenderer(EngineMaster* pEngineMaster,
+            PlayerManagerInterface* pPlayerManager,
+            int framesPerBuffer = kDefaultFramesPerBuffer);
+
+    int framesPerBuffer() const {
+        return m_framesPerBuffer;
+    }
+
+    void setCallbackListener(CallbackListener* pListener) {
+        m_pCallbackListener = pListener;
+    }
+
+    // Renders numFrames of the output, which is either the master or the
+    // record/broadcast output. Returns false if a track failed to load.
+    bool render(const EngineRenderTimeline& timeline,
+            SINT numFrames,
+            const AudioOutput& output,
+            const BufferConsumer& consumer);
+
+    // Renders into a file with an encoder that is configured like for
+    // recording. Returns false if the file could not be written.
+    bool renderToFile(const EngineRenderTimeline& timeline,
+            SINT numFrames,
+            const AudioOutput& output,
+            const QString& filePath,
+            Encoder::Format format,
+            UserSettingsPointer pConfig);
+
+    // Wall clock time of the last render
+    mixxx::Duration renderDuration() const {
+        return m_renderDuration;
+    }
+    // How many times faster than real time the last render was
+    double realTimeFactor() const;
+
+  private:
+    bool applyEvent(const EngineRenderTimeline::Event& event);
+    bool waitForTrackLoaded(const QString& group, const TrackPointer& pTrack);
+
+    EngineMaster* const m_pEngineMaster;
+    PlayerManagerInterface* const m_pPlayerManager;
+    const int m_framesPerBuffer;
+    CallbackListener* m_pCallbackListener;
+
+    SINT m_renderedFrames;
+    mixxx::Duration m_renderDuration;
+};
@@ -0,0 +1,174 @@
+#include "engine/enginethreadpool.h"
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include <intrin.h>
+#endif
+
+#include "util/assert.h"
+#include "util/counter.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+// The clock is only read every few spins
+constexpr int kSpinsPerTimeCheck = 64;
+
+inline void pauseCpu() {
+    // Tells the CPU that we are spinning, which saves power and frees
+    // resources for a hyper-thread sibling that may run a helper
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#elif defined(_M_ARM64) || defined(_M_ARM)
+    __yield();
+#else
+    // Without a spin hint give other threads a chance to run at least
+    std::this_thread::yield();
+#endif
+}
+
+// Spins until done() returns true and returns false if that takes longer
+// than maxWait
+template<typename Predicate>
+bool spinWait(Predicate done, mixxx::Duration maxWait) {
+    if (done()) {
+        return true;
+    }
+    PerformanceTimer timer;
+    timer.start();
+    int spins = 0;
+    while (!done()) {
+        pauseCpu();
+        if (++spins % kSpinsPerTimeCheck == 0 && timer.elapsed() > maxWait) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+EngineThreadPool::Worker::Worker(EngineThreadPool* pPool, int threadIndex)
+        : m_pPool(pPool),
+          m_threadIndex(threadIndex) {
+    setObjectName(QString("EngineThreadPool %1").arg(threadIndex));
+}
+
+void EngineThreadPool::Worker::run() {
+    while (true) {
+        m_semaRun.acquire();
+        if (m_pPool->m_quit.load()) {
+            return;
+        }
+        m_pPool->processParts(m_threadIndex);
+    }
+}
+
+EngineThreadPool::EngineThreadPool(int numWorkers, mixxx::Duration maxWait)
+        : m_maxWait(maxWait),
+          m_pJob(nullptr),
+          m_numParts(0),
+          m_nextPart(0),
+          m_finishedParts(0),
+          m_activeWorkers(0),
+          m_quit(false),
+          m_returnedParts(0) {
+    for (int i = 0; i < numWorkers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>(this, i + 1));
+    }
+    for (const auto& pWorker : m_workers) {
+        pWorker->start(QThread::TimeCriticalPriority);
+    }
+}
+
+EngineThreadPool::~EngineThreadPool() {
+    m_quit.store(true);
+    for (const auto& pWorker : m_workers) {
+        pWorker->wake();
+    }
+    for (const auto& pWorker : m_workers) {
+        pWorker->wait();
+    }
+}
+
+void EngineThreadPool::processParts(int threadIndex) {
+    // Announce ourselves before looking at the job, so that run() does not
+    // return and publish the next job while we are still working on this one.
+    m_activeWorkers.fetch_add(1);
+    EngineThreadPoolJob* pJob = m_pJob.load();
+    if (pJob) {
+        const int numParts = m_numParts.load();
+        int part;
+        while ((part = m_nextPart.fetch_add(1)) < numParts) {
+            pJob->runJobPart(part, threadIndex);
+            m_finishedParts.fetch_or(Q_UINT64_C(1) << part);
+        }
+    }
+    m_activeWorkers.fetch_sub(1);
+}
+
+bool EngineThreadPool::run(EngineThreadPoolJob* pJob, int numParts) {
+    VERIFY_OR_DEBUG_ASSERT(pJob) {
+        return true;
+    }
+    VERIFY_OR_DEBUG_ASSERT(numParts <= kMaxParts) {
+        numParts = kMaxParts;
+    }
+    if (numParts <= 0) {
+        return true;
+    }
+    // A helper that still processes a cancelled job must not see this one
+    if (numParts == 1 || m_workers.empty() || isBusy()) {
+        for (int part = 0; part < numParts; ++part) {
+            pJob->runJobPart(part, 0);
+        }
+        m_returnedParts = ~Q_UINT64_C(0);
+        return true;
+    }
+
+    m_numParts.store(numParts);
+    m_nextPart.store(0);
+    m_finishedParts.store(0);
+    m_pJob.store(pJob);
+
+    // The calling thread takes its share, so we need one helper less than
+    // there are parts.
+    const int numHelpers = std::min(numWorkers(), numParts - 1);
+    for (int i = 0; i < numHelpers; ++i) {
+        m_workers[i]->wake();
+    }
+
+    int part;
+    while ((part = m_nextPart.fetch_add(1)) < numParts) {
+        pJob->runJobPart(part, 0);
+        m_finishedParts.fetch_or(Q_UINT64_C(1) << part);
+    }
+
+    // All parts have been claimed. Only wait for the parts that are still
+    // being processed by helpers, unless a helper is stalled.
+    const quint64 allParts = numParts == kMaxParts ?
+            ~Q_UINT64_C(0) : (Q_UINT64_C(1) << numParts) - 1;
+    const bool finished = spinWait(
+            [this, allParts] { return m_finishedParts.load() == allParts; },
+            m_maxWait);
+    m_returnedParts = m_finishedParts.load();
+
+    // Helpers that wake up late must not touch this job anymore.
+    m_pJob.store(nullptr);
+    if (finished) {
+        // Helpers that are about to leave. A helper that is stalled before
+        // it has seen that there is nothing left to do only keeps the pool
+        // busy.
+        spinWait([this] { return !isBusy(); }, m_maxWait);
+    } else {
+        Counter counter("EngineThreadPool cancelled job");
+        counter.increment();
+    }
+    return finished;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QSemaphore>
+#include <QThread>
+
+#include "util/class.h"
+#include "util/duration.h"
+
+// A job that can be split into independent, indexed parts which are
+// executed concurrently by EngineThreadPool.
+class EngineThreadPoolJob {
+  public:
+    virtual ~EngineThreadPoolJob() = default;
+
+    // Processes the part with the given index. threadIndex identifies the
+    // thread that runs the part: 0 is the calling (engine) thread and
+    // 1..numWorkers() are the helper threads. Each thread processes at most
+    // one part at a time, so threadIndex can be used to select scratch
+    // memory without any locking.
+    virtual void runJobPart(int partIndex, int threadIndex) = 0;
+};
+
+// A small set of high priority helper threads that lend their CPU time to
+// the engine callback. run() distributes the parts of a job among the
+// helper threads and the calling thread and returns after all parts have
+// been processed.
+//
+// The calling thread never blocks on a helper thread that has not started
+// yet: parts are claimed on a first come first served basis and a helper
+// that wakes up late finds nothing left to do. run() does not allocate and
+// only waits for parts that are already being processed, and only up to
+// maxWait. If a helper is stalled in the middle of a part, e.g. because it
+// has been preempted, the job is cancelled and run() returns without that
+// part. Parts can't be taken over, because they may have changed state
+// that is shared with the calling thread, like the state of an effect.
+class EngineThreadPool {
+  public:
+    // The maximum number of parts of a job
+    static constexpr int kMaxParts = 64;
+
+    explicit EngineThreadPool(int numWorkers,
+            mixxx::Duration maxWait = mixxx::Duration::fromMicros(1000));
+    ~EngineThreadPool();
+
+    int numWorkers() const {
+        return static_cast<int>(m_workers.size());
+    }
+
+    // The maximum number of threads that may call runJobPart() concurrently,
+    // i.e. the valid range of threadIndex is [0, numThreads()).
+    int numThreads() const {
+        return numWorkers() + 1;
+    }
+
+    // Must only be called from a single thread, usually the engine thread.
+    // Returns false if the job has been cancelled, because a helper has not
+    // finished its part in time. The helper continues with that part in
+    // the background, so its data must stay valid and the part must not
+    // be processed again until isBusy() returns false. Until then run()
+    // processes all parts on the calling thread.
+    bool run(EngineThreadPoolJob* pJob, int numParts);
+
+    // After run() has returned false
+    bool isPartFinished(int partIndex) const {
+        return (m_returnedParts & (Q_UINT64_C(1) << partIndex)) != 0;
+    }
+
+    // Returns true while a helper is still processing a cancelled job
+    bool isBusy() const {
+        return m_activeWorkers.load() > 0;
+    }
+
+  private:
+    class Worker : public QThread {
+      public:
+        Worker(EngineThreadPool* pPool, int threadIndex);
+
+        void wake() {
+            m_semaRun.release();
+        }
+
+      protected:
+        void run() override;
+
+      private:
+        EngineThreadPool* const m_pPool;
+        const int m_threadIndex;
+        QSemaphore m_semaRun;
+    };
+
+    void processParts(int threadIndex);
+    bool waitForHelpers(int numParts);
+
+    const mixxx::Duration m_maxWait;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    std::atomic<EngineThreadPoolJob*> m_pJob;
+    std::atomic<int> m_numParts;
+    std::atomic<int> m_nextPart;
+    // One bit per part
+    std::atomic<quint64> m_finishedParts;
+    std::atomic<int> m_activeWorkers;
+    std::atomic<bool> m_quit;
+
+    // The finished parts when run() has returned
+    quint64 m_returnedParts;
+
+    DISALLOW_COPY_AND_ASSIGN(EngineThreadPool);
+};
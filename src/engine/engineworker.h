@@ -28,6 +28,13 @@ class EngineWorker : public QThread {
     void workReady();
     void wakeIfReady();
 
+    // Returns true if the worker has finished all work that has been
+    // requested so far. Only used for offline rendering where the engine
+    // waits for its workers instead of running in real time.
+    virtual bool isIdle() {
+        return true;
+    }
+
   protected:
     QSemaphore m_semaRun;
 
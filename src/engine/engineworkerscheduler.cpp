@@ -3,6 +3,8 @@
 
 #include <QtDebug>
 
+#include <algorithm>
+
 #include "engine/engineworker.h"
 #include "engine/engineworkerscheduler.h"
 #include "util/event.h"
@@ -29,6 +31,13 @@ void EngineWorkerScheduler::addWorker(EngineWorker* pWorker) {
     m_workers.push_back(pWorker);
 }
 
+void EngineWorkerScheduler::removeWorker(EngineWorker* pWorker) {
+    QMutexLocker locker(&m_mutex);
+    m_workers.erase(
+            std::remove(m_workers.begin(), m_workers.end(), pWorker),
+            m_workers.end());
+}
+
 void EngineWorkerScheduler::runWorkers() {
     // Wake the scheduler if we have written a worker-ready message to the
     // scheduler. There is no race condition in accessing this boolean because
@@ -39,6 +48,29 @@ void EngineWorkerScheduler::runWorkers() {
     }
 }
 
+void EngineWorkerScheduler::waitForIdleWorkers() {
+    // Workers don't notify when they are done, so we need to poll. The
+    // workers are woken up directly, because a wake up of the scheduler
+    // thread might get lost if it is not waiting yet.
+    const unsigned long kPollIntervalMicros = 50;
+    QMutexLocker lock(&m_mutex);
+    while (true) {
+        bool idle = true;
+        for (const auto& pWorker : m_workers) {
+            pWorker->wakeIfReady();
+            if (!pWorker->isIdle()) {
+                idle = false;
+            }
+        }
+        if (idle) {
+            return;
+        }
+        lock.unlock();
+        QThread::usleep(kPollIntervalMicros);
+        lock.relock();
+    }
+}
+
 void EngineWorkerScheduler::run() {
     static const QString tag("EngineWorkerScheduler");
     while (!m_bQuit) {
@@ -20,9 +20,15 @@ class EngineWorkerScheduler : public QThread {
     virtual ~EngineWorkerScheduler();
 
     void addWorker(EngineWorker* pWorker);
+    // Must be called before a worker is deleted while the scheduler runs
+    void removeWorker(EngineWorker* pWorker);
     void runWorkers();
     void workerReady();
 
+    // Wakes up all workers that are ready and blocks until all of them are
+    // idle. Must not be called from a real-time thread.
+    void waitForIdleWorkers();
+
   protected:
     void run();
 
@@ -26,7 +26,8 @@ class RateControl;
 // point.
 class ReadAheadManager {
   public:
-    ReadAheadManager(); // Only for testing: ReadAheadManagerMock
+    ReadAheadManager(); // Only for testing: ReadAheadManagerMock, or for
+                        // subclasses that provide the samples themselves
     ReadAheadManager(CachingReader* reader,
                               LoopingControl* pLoopingControl);
     virtual ~ReadAheadManager();
@@ -44,6 +44,11 @@ AnalyzerModeFlags getAnalyzerModeFlags(
     if (pConfig->getValue<bool>(ConfigKey("[Library]", "EnableWaveformGenerationWithAnalysis"), true)) {
         modeFlags |= AnalyzerModeFlags::WithWaveform;
     }
+    // Provisional results for many tracks at once that are replaced by a
+    // regular analysis when loading the tracks into a deck
+    if (pConfig->getValue<bool>(ConfigKey("[Library]", "QuickAnalysis"), false)) {
+        modeFlags |= AnalyzerModeFlags::Quick;
+    }
     return static_cast<AnalyzerModeFlags>(modeFlags);
 }
 
@@ -155,6 +160,10 @@ void AnalysisFeature::analyzeTracks(QList<TrackId> trackIds) {
                 &TrackAnalysisScheduler::finished,
                 m_pAnalysisView,
                 &DlgAnalysis::onTrackAnalysisSchedulerFinished);
+        connect(m_pTrackAnalysisScheduler.get(),
+                &TrackAnalysisScheduler::analysisReused,
+                m_pAnalysisView,
+                &DlgAnalysis::onTrackAnalysisSchedulerAnalysisReused);
         connect(m_pTrackAnalysisScheduler.get(),
                 &TrackAnalysisScheduler::progress,
                 this,
@@ -7,12 +7,17 @@
 #include "library/dao/trackschema.h"
 #include "library/trackmodel.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "widget/wlibrarytableview.h"
 
 namespace {
 
 const mixxx::Logger kLogger("BaseCoverArtDelegate");
 
+// The number of pages above and below the visible rows whose
+// covers are prefetched
+const int kPrefetchPages = 1;
+
 inline TrackModel* asTrackModel(
         QTableView* pTableView) {
     auto* pTrackModel =
@@ -27,7 +32,9 @@ BaseCoverArtDelegate::BaseCoverArtDelegate(QTableView* parent)
         : TableItemDelegate(parent),
           m_pTrackModel(asTrackModel(parent)),
           m_pCache(CoverArtCache::instance()),
-          m_inhibitLazyLoading(false) {
+          m_inhibitLazyLoading(false),
+          m_coverColumn(-1),
+          m_coverWidth(0) {
     if (m_pCache) {
         connect(m_pCache,
                 &CoverArtCache::coverFound,
@@ -56,7 +63,11 @@ void BaseCoverArtDelegate::emitRowsChanged(
 void BaseCoverArtDelegate::slotInhibitLazyLoading(
         bool inhibitLazyLoading) {
     m_inhibitLazyLoading = inhibitLazyLoading;
-    if (m_inhibitLazyLoading || m_cacheMissRows.isEmpty()) {
+    if (m_inhibitLazyLoading) {
+        return;
+    }
+    prefetchCovers();
+    if (m_cacheMissRows.isEmpty()) {
         return;
     }
     // If we can request non-cache covers now, request updates
@@ -69,6 +80,42 @@ void BaseCoverArtDelegate::slotInhibitLazyLoading(
     emitRowsChanged(std::move(staleRows));
 }
 
+void BaseCoverArtDelegate::prefetchCovers() const {
+    if (!m_pCache || m_coverColumn < 0 || m_coverWidth <= 0) {
+        return;
+    }
+    const auto* pTableView = static_cast<QTableView*>(parent());
+    const QAbstractItemModel* pModel = pTableView->model();
+    const int firstVisibleRow = pTableView->rowAt(0);
+    if (!pModel || firstVisibleRow < 0) {
+        return;
+    }
+    int lastVisibleRow = pTableView->rowAt(pTableView->viewport()->height() - 1);
+    if (lastVisibleRow < 0) {
+        lastVisibleRow = pModel->rowCount() - 1;
+    }
+    const int pageRows = lastVisibleRow - firstVisibleRow + 1;
+    const int firstRow = math_max(firstVisibleRow - kPrefetchPages * pageRows, 0);
+    const int lastRow = math_min(
+            lastVisibleRow + kPrefetchPages * pageRows, pModel->rowCount() - 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        if (row >= firstVisibleRow && row <= lastVisibleRow) {
+            // Painted anyway
+            continue;
+        }
+        const CoverInfo coverInfo =
+                coverInfoForIndex(pModel->index(row, m_coverColumn));
+        if (CoverImageUtils::isValidHash(coverInfo.hash)) {
+            // Nothing to do if the cover is already cached
+            m_pCache->tryLoadCover(
+                    this,
+                    coverInfo,
+                    m_coverWidth,
+                    CoverArtCache::Loading::NoSignal);
+        }
+    }
+}
+
 void BaseCoverArtDelegate::slotCoverFound(
         const QObject* pRequestor,
         const CoverInfo& coverInfo,
@@ -116,10 +163,12 @@ void BaseCoverArtDelegate::paintItem(
         }
         const double scaleFactor =
                 getDevicePixelRatioF(static_cast<QWidget*>(parent()));
+        m_coverColumn = index.column();
+        m_coverWidth = static_cast<int>(option.rect.width() * scaleFactor);
         QPixmap pixmap = m_pCache->tryLoadCover(
                 this,
                 coverInfo,
-                option.rect.width() * scaleFactor,
+                m_coverWidth,
                 m_inhibitLazyLoading ? CoverArtCache::Loading::CachedOnly : CoverArtCache::Loading::Default);
         if (pixmap.isNull()) {
             // Cache miss
@@ -59,6 +59,11 @@ class BaseCoverArtDelegate : public TableItemDelegate {
     void emitRowsChanged(
             QList<int>&& rows);
 
+    // Starts loading the covers of the rows above and below the
+    // visible rows in the background, so that they are already
+    // cached when scrolling there.
+    void prefetchCovers() const;
+
     TrackPointer loadTrackByLocation(
             const QString& trackLocation) const;
 
@@ -72,4 +77,9 @@ class BaseCoverArtDelegate : public TableItemDelegate {
     // these are marked mutable.
     mutable QList<int> m_cacheMissRows;
     mutable QHash<mixxx::cache_key_t, int> m_pendingCacheRows;
+
+    // The column and the width in device pixels of the last painted
+    // cover, used for prefetching.
+    mutable int m_coverColumn;
+    mutable int m_coverWidth;
 };
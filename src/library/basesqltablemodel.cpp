@@ -3,6 +3,7 @@
 #include "library/basesqltablemodel.h"
 
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <QtDebug>
 #include <algorithm>
 
@@ -17,6 +18,8 @@
 #include "track/trackmetadata.h"
 #include "util/assert.h"
 #include "util/db/dbconnection.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
 #include "util/platform.h"
@@ -36,6 +39,42 @@ const QString COLUMNS_SORTING = QStringLiteral("ColumnsSorting");
 
 const QString kEmptyString = QStringLiteral("");
 
+// The first batch of rows of an asynchronous select only needs to fill
+// the visible part of the table. Inserting the remaining rows in larger
+// batches keeps the number of layout updates of the view low.
+const int kFirstSelectBatchSize = 256;
+const int kSelectBatchSize = 8192;
+
+// Number of rows between checks if a select has been superseded
+const int kSelectCancelCheckInterval = 256;
+
+// Returns the statement that creates the temporary view with the given
+// name, which only exists for the connection that created it. Returns
+// an empty string if name refers to a persistent table or view.
+QString createTempViewStatement(
+        const QSqlDatabase& database,
+        const QString& name) {
+    QSqlQuery query(database);
+    query.prepare(
+            "SELECT sql FROM sqlite_temp_master "
+            "WHERE type='view' AND name=:name");
+    query.bindValue(":name", name);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return QString();
+    }
+    if (!query.next()) {
+        return QString();
+    }
+    // SQLite stores the statement without the TEMP keyword
+    const QString kCreateView = QStringLiteral("CREATE VIEW ");
+    QString statement = query.value(0).toString();
+    VERIFY_OR_DEBUG_ASSERT(statement.startsWith(kCreateView)) {
+        return QString();
+    }
+    return statement.replace(0, kCreateView.size(), "CREATE TEMP VIEW ");
+}
+
 } // anonymous namespace
 
 BaseSqlTableModel::BaseSqlTableModel(
@@ -49,10 +88,57 @@ BaseSqlTableModel::BaseSqlTableModel(
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
           m_bInitialized(false),
-          m_currentSearch(kEmptyString) {
+          m_currentSearch(kEmptyString),
+          m_bSelectAsync(false),
+          m_bSkipUnchangedSelects(false),
+          m_numSelectedBatches(0),
+          m_bSelectComplete(true),
+          m_bSelectedRowsDirty(true) {
+    connect(&m_selectWatcher,
+            &QFutureWatcher<RowBatch>::resultsReadyAt,
+            this,
+            &BaseSqlTableModel::slotSelectResultsReady);
+    connect(&m_selectWatcher,
+            &QFutureWatcher<RowBatch>::finished,
+            this,
+            &BaseSqlTableModel::slotSelectFinished);
+
+    // Modifications of the library, crates and playlists invalidate the
+    // rows of the last select. The signals are emitted synchronously, i.e.
+    // before the modifying code calls select().
+    TrackCollection* pTrackCollection =
+            pTrackCollectionManager->internalCollection();
+    connect(pTrackCollection,
+            &TrackCollection::tracksAdded,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
+    connect(pTrackCollection,
+            &TrackCollection::tracksChanged,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
+    connect(pTrackCollection,
+            &TrackCollection::tracksRemoved,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
+    connect(pTrackCollection,
+            &TrackCollection::multipleTracksChanged,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
+    connect(pTrackCollection,
+            &TrackCollection::crateTracksChanged,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
+    connect(&pTrackCollection->getPlaylistDAO(),
+            &PlaylistDAO::tracksChanged,
+            this,
+            &BaseSqlTableModel::slotSelectedRowsDirty);
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    // The background connection of a running select must be closed
+    // before the database.
+    m_selectWatcher.cancel();
+    m_selectWatcher.waitForFinished();
 }
 
 void BaseSqlTableModel::initHeaderProperties() {
@@ -138,20 +224,50 @@ void BaseSqlTableModel::replaceRows(
     }
 }
 
+QString BaseSqlTableModel::tableQuery() const {
+    return QString("SELECT %1 FROM %2 %3")
+            .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+}
+
+QString BaseSqlTableModel::selectKey() const {
+    return QStringList{
+            tableQuery(),
+            m_trackSourceOrderBy,
+            m_currentSearch,
+            m_currentSearchFilter}
+            .join('\n');
+}
+
 void BaseSqlTableModel::select() {
     if (!m_bInitialized) {
         return;
     }
-    // We should be able to detect when a select() would be a no-op. The DAO's
-    // do not currently broadcast signals for when common things happen. In the
-    // future, we can turn this check on and avoid a lot of needless
-    // select()'s. rryan 9/2011
-    // if (!m_bDirty) {
-    //     if (sDebug) {
-    //         qDebug() << this << "Skipping non-dirty select()";
-    //     }
-    //     return;
-    // }
+
+    const QString key = selectKey();
+    if (m_bSkipUnchangedSelects &&
+            !m_bSelectedRowsDirty &&
+            key == m_selectedKey &&
+            // Shuffle again when sorting randomly
+            !key.contains("RANDOM()")) {
+        if (sDebug) {
+            qDebug() << this << "Skipping non-dirty select()";
+        }
+        return;
+    }
+    m_selectedKey = key;
+    m_bSelectedRowsDirty = false;
+
+    if (m_bSelectAsync && m_pTrackCollectionManager->dbConnectionPool()) {
+        startSelect();
+    } else {
+        selectNow();
+    }
+}
+
+void BaseSqlTableModel::selectNow() {
+    // Supersedes a running select
+    m_selectWatcher.cancel();
+    m_bSelectComplete = true;
 
     if (sDebug) {
         qDebug() << this << "select()";
@@ -161,8 +277,7 @@ void BaseSqlTableModel::select() {
     time.start();
 
     // Prepare query for id and all columns not in m_trackSource
-    QString queryString = QString("SELECT %1 FROM %2 %3")
-                                  .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+    QString queryString = tableQuery();
 
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
@@ -174,10 +289,12 @@ void BaseSqlTableModel::select() {
     query.setForwardOnly(true);
     if (!query.prepare(queryString)) {
         LOG_FAILED_QUERY(query);
+        m_selectedKey.clear();
         return;
     }
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
+        m_selectedKey.clear();
         return;
     }
 
@@ -202,6 +319,7 @@ void BaseSqlTableModel::select() {
             qCritical()
                     << "ID column not available in database query results:"
                     << m_idColumn;
+            m_selectedKey.clear();
             return;
         }
         // TODO(XXX): Can we get rid of the hard-coded assumption that
@@ -283,6 +401,270 @@ void BaseSqlTableModel::select() {
 
     qDebug() << this << "select() took" << time.elapsed().debugMillisWithUnit()
              << m_rowInfo.size();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::startSelect() {
+    // Supersedes a running select
+    m_selectWatcher.cancel();
+
+    if (sDebug) {
+        qDebug() << this << "select() started";
+    }
+    m_selectTimer.start();
+
+    SelectQuery selectQuery;
+    selectQuery.pDbConnectionPool = m_pTrackCollectionManager->dbConnectionPool();
+    selectQuery.tableQuery = tableQuery();
+    selectQuery.numTableColumns = m_tableColumns.size();
+    selectQuery.sortByTrackSource = false;
+    QString createTempView = createTempViewStatement(m_database, m_tableName);
+    if (!createTempView.isEmpty()) {
+        selectQuery.createTempViews.append(createTempView);
+    }
+    if (m_trackSource) {
+        createTempView = createTempViewStatement(
+                m_database, m_trackSource->tableName());
+        if (!createTempView.isEmpty()) {
+            selectQuery.createTempViews.append(createTempView);
+        }
+        selectQuery.trackSourceQuery = m_trackSource->filterAndSortQuery(
+                QString("SELECT %1 FROM %2").arg(m_idColumn, m_tableName),
+                m_currentSearch,
+                m_currentSearchFilter,
+                m_trackSourceOrderBy);
+        selectQuery.sortByTrackSource = !m_trackSourceOrderBy.isEmpty();
+        selectQuery.dirtyTracks = m_trackSource->dirtyTracks();
+    }
+
+    m_numSelectedBatches = 0;
+    m_bSelectComplete = false;
+    QFutureInterface<RowBatch> futureInterface;
+    futureInterface.reportStarted();
+    m_selectWatcher.setFuture(futureInterface.future());
+    QtConcurrent::run([futureInterface, selectQuery]() mutable {
+        loadRows(&futureInterface, selectQuery);
+        futureInterface.reportFinished();
+    });
+}
+
+// static
+void BaseSqlTableModel::loadRows(
+        QFutureInterface<RowBatch>* pFutureInterface,
+        const SelectQuery& selectQuery) {
+    // Returning without reporting the last batch lets the model fall back
+    // to a synchronous select.
+    const mixxx::DbConnectionPooler dbConnectionPooler(
+            selectQuery.pDbConnectionPool);
+    const QSqlDatabase database =
+            mixxx::DbConnectionPooled(selectQuery.pDbConnectionPool);
+    if (!database.isOpen()) {
+        return;
+    }
+    for (const auto& createTempView : selectQuery.createTempViews) {
+        QSqlQuery query(database);
+        if (!query.exec(createTempView)) {
+            LOG_FAILED_QUERY(query);
+            return;
+        }
+    }
+
+    QHash<TrackId, int> trackSortOrder;
+    if (!selectQuery.trackSourceQuery.isEmpty()) {
+        QSqlQuery query(database);
+        query.setForwardOnly(true);
+        if (!query.prepare(selectQuery.trackSourceQuery) || !query.exec()) {
+            LOG_FAILED_QUERY(query);
+            return;
+        }
+        while (query.next()) {
+            if (trackSortOrder.size() % kSelectCancelCheckInterval == 0 &&
+                    pFutureInterface->isCanceled()) {
+                return;
+            }
+            trackSortOrder.insert(TrackId(query.value(0)), trackSortOrder.size());
+        }
+    }
+
+    QSqlQuery query(database);
+    // See selectNow()
+    query.setForwardOnly(true);
+    if (!query.prepare(selectQuery.tableQuery) || !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return;
+    }
+
+    RowBatch batch;
+    int batchSize = kFirstSelectBatchSize;
+    QVector<RowInfo> sortedRows;
+    QVector<RowInfo> dirtyRows;
+    int tableRow = 0;
+    while (query.next()) {
+        if (tableRow % kSelectCancelCheckInterval == 0 &&
+                pFutureInterface->isCanceled()) {
+            return;
+        }
+        RowInfo rowInfo;
+        rowInfo.trackId = TrackId(query.value(kIdColumn));
+        // The position in the table defines the ordering unless
+        // sorting by the track source.
+        rowInfo.order = tableRow++;
+        rowInfo.metadata.reserve(selectQuery.numTableColumns);
+        for (int i = 0; i < selectQuery.numTableColumns; ++i) {
+            rowInfo.metadata.push_back(query.value(i));
+        }
+
+        if (selectQuery.dirtyTracks.contains(rowInfo.trackId)) {
+            dirtyRows.push_back(rowInfo);
+            continue;
+        }
+        if (!selectQuery.trackSourceQuery.isEmpty()) {
+            const auto it = trackSortOrder.constFind(rowInfo.trackId);
+            if (it == trackSortOrder.constEnd()) {
+                // Filtered by the search
+                continue;
+            }
+            if (selectQuery.sortByTrackSource) {
+                rowInfo.order = it.value();
+                sortedRows.push_back(rowInfo);
+                continue;
+            }
+        }
+        batch.rows.push_back(rowInfo);
+        if (batch.rows.size() >= batchSize) {
+            pFutureInterface->reportResult(batch);
+            batch.rows.clear();
+            batchSize = kSelectBatchSize;
+        }
+    }
+
+    if (selectQuery.sortByTrackSource) {
+        // Rows of the same track are kept in table order
+        std::stable_sort(sortedRows.begin(), sortedRows.end());
+        int firstRow = 0;
+        while (sortedRows.size() - firstRow > batchSize) {
+            if (pFutureInterface->isCanceled()) {
+                return;
+            }
+            batch.rows = sortedRows.mid(firstRow, batchSize);
+            pFutureInterface->reportResult(batch);
+            firstRow += batchSize;
+            batchSize = kSelectBatchSize;
+        }
+        batch.rows = sortedRows.mid(firstRow);
+    }
+    batch.dirtyRows = dirtyRows;
+    batch.last = true;
+    pFutureInterface->reportResult(batch);
+}
+
+void BaseSqlTableModel::slotSelectResultsReady() {
+    if (m_selectWatcher.isCanceled()) {
+        return;
+    }
+    const QFuture<RowBatch> future = m_selectWatcher.future();
+    while (m_numSelectedBatches < future.resultCount()) {
+        const RowBatch batch = future.resultAt(m_numSelectedBatches);
+        if (m_numSelectedBatches++ == 0) {
+            // The previous rows are displayed until the first batch
+            // of the new rows arrives
+            clearRows();
+        }
+        appendRows(batch.rows);
+        if (batch.last) {
+            insertDirtyRows(batch.dirtyRows);
+            m_bSelectComplete = true;
+        }
+    }
+}
+
+void BaseSqlTableModel::slotSelectFinished() {
+    if (m_selectWatcher.isCanceled()) {
+        return;
+    }
+    // Results might still be pending
+    slotSelectResultsReady();
+    if (!m_bSelectComplete) {
+        qWarning() << this
+                   << "Failed to select rows on a background connection";
+        selectNow();
+        return;
+    }
+    qDebug() << this << "select() took"
+             << m_selectTimer.elapsed().debugMillisWithUnit()
+             << m_rowInfo.size();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::appendRows(const QVector<RowInfo>& rows) {
+    if (rows.isEmpty()) {
+        return;
+    }
+    const int firstRow = m_rowInfo.size();
+    beginInsertRows(QModelIndex(), firstRow, firstRow + rows.size() - 1);
+    m_rowInfo += rows;
+    for (int row = firstRow; row < m_rowInfo.size(); ++row) {
+        m_trackIdToRows[m_rowInfo[row].trackId].push_back(row);
+    }
+    endInsertRows();
+}
+
+void BaseSqlTableModel::insertDirtyRows(const QVector<RowInfo>& dirtyRows) {
+    if (dirtyRows.isEmpty() || !m_trackSource) {
+        return;
+    }
+    // Unless sorting by the track source the dirty rows keep their
+    // position in the table and are only filtered.
+    const bool sortByTrackSource = !m_trackSourceOrderBy.isEmpty();
+    QVector<TrackId> sortedTrackIds;
+    if (sortByTrackSource) {
+        sortedTrackIds.reserve(m_rowInfo.size());
+        for (const auto& rowInfo : qAsConst(m_rowInfo)) {
+            sortedTrackIds.append(rowInfo.trackId);
+        }
+    }
+
+    // Insertion points refer to the rows before inserting any dirty row
+    QVector<QPair<int, RowInfo>> insertions;
+    for (const auto& dirtyRow : dirtyRows) {
+        int row = 0;
+        if (!m_trackSource->matchDirtyTrack(dirtyRow.trackId,
+                    m_currentSearch,
+                    m_currentSearchFilter,
+                    sortByTrackSource ? m_sortColumns : QList<SortColumn>(),
+                    m_tableColumns.size() - 1, // exclude the 1st column with the id
+                    sortedTrackIds,
+                    &row)) {
+            continue;
+        }
+        if (!sortByTrackSource) {
+            row = std::upper_bound(m_rowInfo.constBegin(),
+                          m_rowInfo.constEnd(),
+                          dirtyRow) -
+                    m_rowInfo.constBegin();
+        }
+        insertions.append(qMakePair(row, dirtyRow));
+    }
+    if (insertions.isEmpty()) {
+        return;
+    }
+    std::stable_sort(insertions.begin(),
+            insertions.end(),
+            [](const QPair<int, RowInfo>& lhs, const QPair<int, RowInfo>& rhs) {
+                return lhs.first < rhs.first;
+            });
+    for (int i = 0; i < insertions.size(); ++i) {
+        const int row = insertions[i].first + i;
+        beginInsertRows(QModelIndex(), row, row);
+        m_rowInfo.insert(row, insertions[i].second);
+        endInsertRows();
+    }
+
+    // All following rows have been shifted
+    m_trackIdToRows.clear();
+    for (int row = 0; row < m_rowInfo.size(); ++row) {
+        m_trackIdToRows[m_rowInfo[row].trackId].push_back(row);
+    }
 }
 
 void BaseSqlTableModel::setTable(const QString& tableName,
@@ -292,6 +674,7 @@ void BaseSqlTableModel::setTable(const QString& tableName,
     if (sDebug) {
         qDebug() << this << "setTable" << tableName << tableColumns << idColumn;
     }
+    m_bSelectedRowsDirty = true;
     m_tableName = tableName;
     m_idColumn = idColumn;
     m_tableColumns = tableColumns;
@@ -725,10 +1108,16 @@ QString BaseSqlTableModel::getTrackLocation(const QModelIndex& index) const {
     return QDir::fromNativeSeparators(nativeLocation);
 }
 
+void BaseSqlTableModel::slotSelectedRowsDirty() {
+    m_bSelectedRowsDirty = true;
+}
+
 void BaseSqlTableModel::tracksChanged(QSet<TrackId> trackIds) {
     if (sDebug) {
         qDebug() << this << "trackChanged" << trackIds.size();
     }
+    // The search and the sort order might be affected
+    m_bSelectedRowsDirty = true;
 
     const int numColumns = columnCount();
     for (const auto& trackId : trackIds) {
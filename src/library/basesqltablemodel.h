@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QFutureInterface>
+#include <QFutureWatcher>
 #include <QHash>
 #include <QtSql>
 
@@ -8,6 +10,8 @@
 #include "library/basetracktablemodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/db/dbconnectionpool.h"
+#include "util/performancetimer.h"
 
 class TrackCollectionManager;
 
@@ -32,6 +36,25 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     void setSearch(const QString& searchText, const QString& extraFilter = QString());
     void setSort(int column, Qt::SortOrder order);
 
+    // Lets select() run the queries on a background database connection
+    // and insert the rows in batches as they arrive, instead of blocking
+    // until all rows have been loaded. Only for models that are displayed,
+    // because the rows are not available yet when select() returns.
+    void setSelectAsync(bool selectAsync) {
+        m_bSelectAsync = selectAsync;
+    }
+    // Lets select() skip reselects if neither the query nor the track
+    // collection have changed since the last select. Only for models of
+    // the internal library, crates and playlists, because the tables of
+    // other models are modified without the signals of the collection.
+    void setSkipUnchangedSelects(bool skipUnchangedSelects) {
+        m_bSkipUnchangedSelects = skipUnchangedSelects;
+    }
+    // Rows are still being inserted, selectFinished() will follow
+    bool isSelecting() const {
+        return !m_bSelectComplete;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from QAbstractItemModel
     ///////////////////////////////////////////////////////////////////////////
@@ -61,6 +84,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     void hideTracks(const QModelIndexList& indices) override;
 
+    // See setSkipUnchangedSelects()
     void select() override;
 
     ///////////////////////////////////////////////////////////////////////////
@@ -103,8 +127,16 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     int m_columnIndexBySortColumnId[NUM_SORTCOLUMNIDS];
     QMap<int, TrackModel::SortColumnId> m_sortColumnIdByColumnIndex;
 
+  signals:
+    // All rows of the last select() have been inserted
+    void selectFinished();
+
   private slots:
     void tracksChanged(QSet<TrackId> trackIds);
+    void slotSelectedRowsDirty();
+
+    void slotSelectResultsReady();
+    void slotSelectFinished();
 
     void slotRefreshCoverRows(QList<int> rows);
 
@@ -143,6 +175,36 @@ class BaseSqlTableModel : public BaseTrackTableModel {
             QVector<RowInfo>&& rows,
             TrackId2Rows&& trackIdToRows);
 
+    // The queries of a select() on a background database connection
+    struct SelectQuery {
+        mixxx::DbConnectionPoolPtr pDbConnectionPool;
+        // Temporary views only exist in the connection that created them
+        QStringList createTempViews;
+        QString tableQuery;
+        int numTableColumns;
+        // Filtered and sorted track ids, empty without a track source
+        QString trackSourceQuery;
+        bool sortByTrackSource;
+        QSet<TrackId> dirtyTracks;
+    };
+    struct RowBatch {
+        QVector<RowInfo> rows;
+        // Rows of dirty tracks whose database records are outdated. They
+        // are delivered with the last batch and evaluated in memory.
+        QVector<RowInfo> dirtyRows;
+        bool last = false;
+    };
+    static void loadRows(
+            QFutureInterface<RowBatch>* pFutureInterface,
+            const SelectQuery& selectQuery);
+
+    QString tableQuery() const;
+    QString selectKey() const;
+    void selectNow();
+    void startSelect();
+    void appendRows(const QVector<RowInfo>& rows);
+    void insertDirtyRows(const QVector<RowInfo>& dirtyRows);
+
     QVector<RowInfo> m_rowInfo;
 
     QString m_tableName;
@@ -158,5 +220,17 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     QVector<QHash<int, QVariant> > m_headerInfo;
     QString m_trackSourceOrderBy;
 
+    bool m_bSelectAsync;
+    bool m_bSkipUnchangedSelects;
+    QFutureWatcher<RowBatch> m_selectWatcher;
+    PerformanceTimer m_selectTimer;
+    int m_numSelectedBatches;
+    bool m_bSelectComplete;
+    // Identifies the query of the last select for skipping reselects that
+    // would not change anything. Set dirty by modifications of the track
+    // collection.
+    QString m_selectedKey;
+    bool m_bSelectedRowsDirty;
+
     DISALLOW_COPY_AND_ASSIGN(BaseSqlTableModel);
 };
@@ -413,6 +413,11 @@ void BaseTrackCache::getTrackValueForColumn(TrackPointer pTrack,
         trackValue.setValue(static_cast<int>(pTrack->getKey()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM_LOCK) == column) {
         trackValue.setValue(pTrack->isBpmLocked());
+    } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BEATS_SUB_VERSION) == column) {
+        BeatsPointer pBeats = pTrack->getBeats();
+        trackValue.setValue(pBeats ? pBeats->getSubVersion() : QString());
+    } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEYS_SUB_VERSION) == column) {
+        trackValue.setValue(pTrack->getKeys().getSubVersion());
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COLOR) == column) {
         trackValue.setValue(mixxx::RgbColor::toQVariant(pTrack->getColor()));
     } else if (fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) == column) {
@@ -473,10 +478,6 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         return;
     }
 
-    if (!m_bIndexBuilt) {
-        buildIndex();
-    }
-
     QStringList idStrings;
     // TODO(rryan) consider making this the data passed in and a separate
     // QVector for output
@@ -488,32 +489,10 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         }
     }
 
-    QStringList queryFragments;
-    if (!extraFilter.isNull() && extraFilter != "") {
-        queryFragments << QString("(%1)").arg(extraFilter);
-    }
-    if (idStrings.size() > 0) {
-        queryFragments << QString("%1 in (%2)")
-                .arg(m_idColumn, idStrings.join(","));
-    }
-
     const std::unique_ptr<QueryNode> pQuery =
-            m_pQueryParser->parseQuery(
-                    searchQuery,
-                    m_searchColumns,
-                    queryFragments.join(" AND "));
-
-    QString filter = pQuery->toSql();
-    if (!filter.isEmpty()) {
-        filter.prepend("WHERE ");
-    }
-
-    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
-
-    if (sDebug) {
-        qDebug() << this << "select() executing:" << queryString;
-    }
+            parseQuery(idStrings.join(","), searchQuery, extraFilter);
+    const QString queryString =
+            filterAndSortQuery(*pQuery, orderByClause);
 
     QSqlQuery query(m_database);
     // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
@@ -620,6 +599,94 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     }
 }
 
+std::unique_ptr<QueryNode> BaseTrackCache::parseQuery(
+        const QString& trackIds,
+        const QString& searchQuery,
+        const QString& extraFilter) {
+    if (!m_bIndexBuilt) {
+        buildIndex();
+    }
+
+    QStringList queryFragments;
+    if (!extraFilter.isNull() && extraFilter != "") {
+        queryFragments << QString("(%1)").arg(extraFilter);
+    }
+    if (!trackIds.isEmpty()) {
+        queryFragments << QString("%1 in (%2)")
+                .arg(m_idColumn, trackIds);
+    }
+
+    return m_pQueryParser->parseQuery(
+            searchQuery,
+            m_searchColumns,
+            queryFragments.join(" AND "));
+}
+
+QString BaseTrackCache::filterAndSortQuery(
+        const QueryNode& query,
+        const QString& orderByClause) const {
+    QString filter = query.toSql();
+    if (!filter.isEmpty()) {
+        filter.prepend("WHERE ");
+    }
+
+    QString queryString = QString("SELECT %1 FROM %2 %3 %4")
+            .arg(m_idColumn, m_tableName, filter, orderByClause);
+
+    if (sDebug) {
+        qDebug() << this << "select() executing:" << queryString;
+    }
+    return queryString;
+}
+
+QString BaseTrackCache::filterAndSortQuery(
+        const QString& trackIdSubselect,
+        const QString& searchQuery,
+        const QString& extraFilter,
+        const QString& orderByClause) {
+    return filterAndSortQuery(
+            *parseQuery(trackIdSubselect, searchQuery, extraFilter),
+            orderByClause);
+}
+
+QSet<TrackId> BaseTrackCache::dirtyTracks() const {
+    QSet<TrackId> dirtyTracks;
+    if (!m_bIsCaching) {
+        return dirtyTracks;
+    }
+    for (const auto& trackId : m_dirtyTracks) {
+        // Skip false positives
+        if (getRecentTrack(trackId)) {
+            dirtyTracks.insert(trackId);
+        }
+    }
+    return dirtyTracks;
+}
+
+bool BaseTrackCache::matchDirtyTrack(TrackId trackId,
+        const QString& searchQuery,
+        const QString& extraFilter,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        const QVector<TrackId>& sortedTrackIds,
+        int* pRow) {
+    DEBUG_ASSERT(pRow);
+    if (!m_bIsCaching) {
+        return false;
+    }
+    TrackPointer pTrack = getRecentTrack(trackId);
+    if (!pTrack) {
+        return false;
+    }
+    if (!searchQuery.isEmpty() &&
+            !parseQuery(QString(), searchQuery, extraFilter)->match(pTrack)) {
+        return false;
+    }
+    *pRow = findSortInsertionPoint(
+            pTrack, sortColumns, columnOffset, sortedTrackIds);
+    return true;
+}
+
 int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
         const QList<SortColumn>& sortColumns,
         const int columnOffset,
@@ -16,6 +16,7 @@
 #include "util/class.h"
 #include "util/string.h"
 
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
 
@@ -66,6 +67,32 @@ class BaseTrackCache : public QObject {
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                QHash<TrackId, int>* trackToIndex);
+
+    const QString& tableName() const {
+        return m_tableName;
+    }
+
+    // Returns the query of filterAndSort() for running it on a different
+    // database connection. The tracks are given by a subselect of their
+    // ids. The result doesn't reflect modifications of dirty tracks that
+    // have not been saved yet, see matchDirtyTrack().
+    QString filterAndSortQuery(const QString& trackIdSubselect,
+                               const QString& searchQuery,
+                               const QString& extraFilter,
+                               const QString& orderByClause);
+    // Tracks that have been modified, but not saved yet.
+    QSet<TrackId> dirtyTracks() const;
+    // Evaluates the search for a dirty track by its modified metadata.
+    // If it matches pRow receives the row among the sorted tracks where
+    // it belongs.
+    bool matchDirtyTrack(TrackId trackId,
+                         const QString& searchQuery,
+                         const QString& extraFilter,
+                         const QList<SortColumn>& sortColumns,
+                         const int columnOffset,
+                         const QVector<TrackId>& sortedTrackIds,
+                         int* pRow);
+
     virtual bool isCached(TrackId trackId) const;
     virtual void ensureCached(TrackId trackId);
     virtual void ensureCached(QSet<TrackId> trackIds);
@@ -88,6 +115,12 @@ class BaseTrackCache : public QObject {
     void replaceRecentTrack(TrackId trackId, TrackPointer pTrack) const;
     void resetRecentTrack() const;
 
+    std::unique_ptr<QueryNode> parseQuery(const QString& trackIds,
+                                          const QString& searchQuery,
+                                          const QString& extraFilter);
+    QString filterAndSortQuery(const QueryNode& query,
+                               const QString& orderByClause) const;
+
     bool updateIndexWithQuery(const QString& query);
     bool updateIndexWithTrackpointer(TrackPointer pTrack);
     void updateTrackInIndex(TrackId trackId);
@@ -1,5 +1,6 @@
 #include "library/basetracktablemodel.h"
 
+#include "analyzer/quickanalysis.h"
 #include "library/basecoverartdelegate.h"
 #include "library/bpmdelegate.h"
 #include "library/colordelegate.h"
@@ -428,6 +429,23 @@ QVariant BaseTrackTableModel::data(
     return roleValue(index, rawValue(index), role);
 }
 
+QString BaseTrackTableModel::formatProvisionalValue(
+        const QModelIndex& index,
+        ColumnCache::Column subVersionColumn,
+        const QString& text,
+        int role) const {
+    const int subVersionIndex = fieldIndex(subVersionColumn);
+    if (subVersionIndex == -1 ||
+            !mixxx::isQuickAnalysisSubVersion(
+                    index.sibling(index.row(), subVersionIndex).data().toString())) {
+        return text;
+    }
+    if (role == Qt::ToolTipRole) {
+        return tr("%1 (provisional, from a quick analysis)").arg(text);
+    }
+    return QChar('~') + text;
+}
+
 bool BaseTrackTableModel::setData(
         const QModelIndex& index,
         const QVariant& value,
@@ -508,7 +526,11 @@ QVariant BaseTrackTableModel::roleValue(
             bool ok;
             const auto bpmValue = rawValue.toDouble(&ok);
             if (ok && bpmValue > 0.0) {
-                return QString("%1").arg(bpmValue, 0, 'f', 1);
+                return formatProvisionalValue(
+                        index,
+                        ColumnCache::COLUMN_LIBRARYTABLE_BEATS_SUB_VERSION,
+                        QString("%1").arg(bpmValue, 0, 'f', 1),
+                        role);
             } else {
                 return QChar('-');
             }
@@ -544,7 +566,11 @@ QVariant BaseTrackTableModel::roleValue(
                                 index.sibling(index.row(), keyIdColumn).data().toInt());
                 if (key != mixxx::track::io::key::INVALID) {
                     // Render this key with the user-provided notation.
-                    return KeyUtils::keyToString(key);
+                    return formatProvisionalValue(
+                            index,
+                            ColumnCache::COLUMN_LIBRARYTABLE_KEYS_SUB_VERSION,
+                            KeyUtils::keyToString(key),
+                            role);
                 }
             }
             // clear invalid values
@@ -202,6 +202,14 @@ class BaseTrackTableModel : public QAbstractTableModel, public TrackModel {
     QList<QUrl> collectUrls(
             const QModelIndexList& indexes) const;
 
+    // Marks the BPM or key of a quick analysis until it is replaced
+    // by a regular analysis
+    QString formatProvisionalValue(
+            const QModelIndex& index,
+            ColumnCache::Column subVersionColumn,
+            const QString& text,
+            int role) const;
+
     const QString m_previewDeckGroup;
 
     double m_backgroundColorOpacity;
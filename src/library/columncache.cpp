@@ -67,6 +67,8 @@ void ColumnCache::setColumns(const QStringList& columns) {
     m_columnIndexByEnum[COLUMN_LIBRARYTABLE_COVERART_TYPE] = fieldIndex(LIBRARYTABLE_COVERART_TYPE);
     m_columnIndexByEnum[COLUMN_LIBRARYTABLE_COVERART_LOCATION] = fieldIndex(LIBRARYTABLE_COVERART_LOCATION);
     m_columnIndexByEnum[COLUMN_LIBRARYTABLE_COVERART_HASH] = fieldIndex(LIBRARYTABLE_COVERART_HASH);
+    m_columnIndexByEnum[COLUMN_LIBRARYTABLE_BEATS_SUB_VERSION] = fieldIndex(LIBRARYTABLE_BEATS_SUB_VERSION);
+    m_columnIndexByEnum[COLUMN_LIBRARYTABLE_KEYS_SUB_VERSION] = fieldIndex(LIBRARYTABLE_KEYS_SUB_VERSION);
 
     m_columnIndexByEnum[COLUMN_TRACKLOCATIONSTABLE_FSDELETED] = fieldIndex(TRACKLOCATIONSTABLE_FSDELETED);
 
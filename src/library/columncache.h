@@ -55,6 +55,8 @@ class ColumnCache : public QObject {
         COLUMN_LIBRARYTABLE_COVERART_TYPE,
         COLUMN_LIBRARYTABLE_COVERART_LOCATION,
         COLUMN_LIBRARYTABLE_COVERART_HASH,
+        COLUMN_LIBRARYTABLE_BEATS_SUB_VERSION,
+        COLUMN_LIBRARYTABLE_KEYS_SUB_VERSION,
 
         COLUMN_TRACKLOCATIONSTABLE_FSDELETED,
 
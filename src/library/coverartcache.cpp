@@ -1,32 +1,90 @@
+#include <QCryptographicHash>
+#include <QDir>
 #include <QFutureWatcher>
-#include <QPixmapCache>
+#include <QSaveFile>
 #include <QtConcurrentRun>
 #include <QtDebug>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
+#include "util/cache.h"
 #include "util/compatibility.h"
 #include "util/logger.h"
+#include "util/math.h"
 
 
 namespace {
 
 mixxx::Logger kLogger("CoverArtCache");
 
-// The initial QPixmapCache limit is 10MB.
-// But it is not used just by the coverArt stuff,
-// it is also used by Qt to handle other things behind the scenes.
-// Consequently coverArt cache will always have less than those
-// 10MB available to store the pixmaps.
-// So, we must increase this size a bit more,
-// in order to allow CoverCache handle more covers (performance gain).
-constexpr int kPixmapCacheLimit = 20480;
+// The limit of the resized covers in memory in KB. A cover of 100x100
+// pixels takes about 40 KB.
+constexpr int kPixmapCacheLimit = 32 * 1024;
+
+// Thumbnails are stored for covers up to this width. The width of the
+// thumbnails is rounded up to a multiple of the step, so resizing the cover
+// column doesn't store new thumbnails for every pixel.
+constexpr int kMaxThumbnailWidth = 512;
+constexpr int kThumbnailWidthStep = 64;
+constexpr int kThumbnailJpegQuality = 90;
 
 QString pixmapCacheKey(quint16 hash, int width) {
     return QString("CoverArtCache_%1_%2")
             .arg(QString::number(hash), QString::number(width));
 }
 
+int pixmapCacheCost(const QPixmap& pixmap) {
+    return math_max(1, pixmap.width() * pixmap.height() * pixmap.depth() / (8 * 1024));
+}
+
+int thumbnailWidth(int desiredWidth) {
+    return (desiredWidth + kThumbnailWidthStep - 1) /
+            kThumbnailWidthStep * kThumbnailWidthStep;
+}
+
+// Returns an empty string if no thumbnail should be stored for the cover.
+// The 16 bit hash of the image is ambiguous, so thumbnails are keyed by the
+// location of the cover as well.
+QString thumbnailFilePath(
+        const QString& thumbnailPath,
+        const CoverInfo& coverInfo,
+        int desiredWidth) {
+    if (thumbnailPath.isEmpty() ||
+            desiredWidth <= 0 ||
+            desiredWidth > kMaxThumbnailWidth ||
+            !CoverImageUtils::isValidHash(coverInfo.hash)) {
+        return QString();
+    }
+    QCryptographicHash location(QCryptographicHash::Sha1);
+    location.addData(QByteArray::number(static_cast<int>(coverInfo.type)));
+    location.addData(coverInfo.trackLocation.toUtf8());
+    location.addData(QByteArray(1, '\0'));
+    location.addData(coverInfo.coverLocation.toUtf8());
+    const mixxx::cache_key_t locationKey =
+            mixxx::cacheKeyFromMessageDigest(location.result());
+    return QDir(thumbnailPath).filePath(QString("%1-%2-%3")
+            .arg(coverInfo.hash, 4, 16, QChar('0'))
+            .arg(locationKey, 16, 16, QChar('0'))
+            .arg(thumbnailWidth(desiredWidth)));
+}
+
+// Thumbnails are small, so JPEG is decoded quickly. The format is detected
+// when loading them.
+void saveThumbnail(const QString& filePath, const QImage& thumbnail) {
+    QSaveFile file(filePath);
+    const bool hasAlpha = thumbnail.hasAlphaChannel();
+    if (!file.open(QIODevice::WriteOnly) ||
+            !thumbnail.save(&file,
+                    hasAlpha ? "PNG" : "JPG",
+                    hasAlpha ? -1 : kThumbnailJpegQuality) ||
+            !file.commit()) {
+        kLogger.warning()
+                << "Failed to save thumbnail"
+                << filePath
+                << file.errorString();
+    }
+}
+
 // The transformation mode when scaling images
 const Qt::TransformationMode kTransformationMode = Qt::SmoothTransformation;
 
@@ -37,8 +95,19 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
 
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
-    QPixmapCache::setCacheLimit(kPixmapCacheLimit);
+CoverArtCache::CoverArtCache()
+        : m_pixmapCache(kPixmapCacheLimit) {
+}
+
+void CoverArtCache::setThumbnailPath(const QString& thumbnailPath) {
+    if (!thumbnailPath.isEmpty() && !QDir().mkpath(thumbnailPath)) {
+        kLogger.warning()
+                << "Failed to create thumbnail directory"
+                << thumbnailPath;
+        m_thumbnailPath = QString();
+        return;
+    }
+    m_thumbnailPath = thumbnailPath;
 }
 
 //static
@@ -98,7 +167,12 @@ QPixmap CoverArtCache::tryLoadCover(
     // keep a list of trackIds for which a future is currently running
     // to avoid loading the same picture again while we are loading it
     QPair<const QObject*, quint16> requestId = qMakePair(pRequestor, coverInfo.hash);
-    if (m_runningRequests.contains(requestId)) {
+    auto runningRequest = m_runningRequests.find(requestId);
+    if (runningRequest != m_runningRequests.end()) {
+        // Signal when a prefetch that is still running is done
+        if (loading == Loading::Default) {
+            runningRequest.value() = true;
+        }
         return QPixmap();
     }
 
@@ -109,8 +183,9 @@ QPixmap CoverArtCache::tryLoadCover(
     // performance issues).
     QString cacheKey = pixmapCacheKey(coverInfo.hash, desiredWidth);
 
-    QPixmap pixmap;
-    if (QPixmapCache::find(cacheKey, &pixmap)) {
+    const QPixmap* pCachedPixmap = m_pixmapCache.object(cacheKey);
+    if (pCachedPixmap) {
+        const QPixmap pixmap = *pCachedPixmap;
         if (kLogger.traceEnabled()) {
             kLogger.trace()
                     << "requestCover cache hit"
@@ -135,16 +210,21 @@ QPixmap CoverArtCache::tryLoadCover(
                 << "requestCover starting future for"
                 << coverInfo;
     }
-    m_runningRequests.insert(requestId);
+    const bool signalWhenDone = loading == Loading::Default;
+    m_runningRequests.insert(requestId, signalWhenDone);
     // The watcher will be deleted in coverLoaded()
     QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
+    const QString thumbnailPath = m_thumbnailPath;
     QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
-            pRequestor,
-            pTrack,
-            coverInfo,
-            desiredWidth,
-            loading == Loading::Default);
+            [pRequestor, pTrack, coverInfo, desiredWidth, signalWhenDone, thumbnailPath] {
+                return loadCover(
+                        pRequestor,
+                        pTrack,
+                        coverInfo,
+                        desiredWidth,
+                        signalWhenDone,
+                        thumbnailPath);
+            });
     connect(watcher,
             &QFutureWatcher<FutureResult>::finished,
             this,
@@ -159,7 +239,8 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
         TrackPointer pTrack,
         CoverInfo coverInfo,
         int desiredWidth,
-        bool signalWhenDone) {
+        bool signalWhenDone,
+        const QString& thumbnailPath) {
     if (kLogger.traceEnabled()) {
         kLogger.trace()
                 << "loadCover"
@@ -176,6 +257,19 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     res.signalWhenDone = signalWhenDone;
     DEBUG_ASSERT(!res.coverInfoUpdated);
 
+    const QString thumbnailFile =
+            thumbnailFilePath(thumbnailPath, coverInfo, desiredWidth);
+    if (!thumbnailFile.isEmpty()) {
+        QImage thumbnail(thumbnailFile);
+        if (!thumbnail.isNull()) {
+            if (thumbnail.width() != desiredWidth) {
+                thumbnail = resizeImageWidth(thumbnail, desiredWidth);
+            }
+            res.cover = CoverArt(coverInfo, thumbnail, desiredWidth);
+            return res;
+        }
+    }
+
     QImage image = coverInfo.loadImage(
             pTrack ? pTrack->getSecurityToken() : SecurityTokenPointer());
 
@@ -188,6 +282,16 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
         pTrack->setCoverInfo(coverInfo);
     }
 
+    // The hash might have been refreshed
+    const QString newThumbnailFile =
+            thumbnailFilePath(thumbnailPath, coverInfo, desiredWidth);
+    if (!image.isNull() && !newThumbnailFile.isEmpty()) {
+        // Never scale up small covers
+        saveThumbnail(newThumbnailFile,
+                resizeImageWidth(image,
+                        math_min(thumbnailWidth(desiredWidth), image.width())));
+    }
+
     // Resize image to requested size
     if (!image.isNull() && desiredWidth > 0) {
         // Adjust the cover size according to the request
@@ -231,12 +335,13 @@ void CoverArtCache::coverLoaded() {
         // because insert replaces the images with the same key
         QString cacheKey = pixmapCacheKey(
                 res.cover.hash, res.cover.resizedToWidth);
-        QPixmapCache::insert(cacheKey, pixmap);
+        m_pixmapCache.insert(cacheKey, new QPixmap(pixmap), pixmapCacheCost(pixmap));
     }
 
-    m_runningRequests.remove(qMakePair(res.pRequestor, res.requestedHash));
+    const bool signalWhenDone =
+            m_runningRequests.take(qMakePair(res.pRequestor, res.requestedHash));
 
-    if (res.signalWhenDone) {
+    if (signalWhenDone) {
         emit coverFound(res.pRequestor, res.cover, pixmap, res.requestedHash, res.coverInfoUpdated);
     }
 }
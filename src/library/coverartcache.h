@@ -1,9 +1,10 @@
 #pragma once
 
+#include <QCache>
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QPixmap>
-#include <QSet>
 #include <QtDebug>
 
 #include "library/coverart.h"
@@ -22,6 +23,10 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const QObject* pRequestor,
             const TrackPointer& pTrack);
 
+    // Enables the persistent thumbnails of covers that are requested with
+    // a small width. GUI thread only.
+    void setThumbnailPath(const QString& thumbnailPath);
+
     /* This method is used to request a cover art pixmap.
      *
      * @param pRequestor : an arbitrary pointer (can be any number you'd like,
@@ -32,7 +37,7 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
      *      covers from the given 'coverLocation' and it will also NOT run the
      *      search algorithm.
      *      In this way, the method will just look into CoverCache and return
-     *      a Pixmap if it is already loaded in the QPixmapCache.
+     *      a Pixmap if it is already loaded in memory.
      */
     enum class Loading {
         CachedOnly,
@@ -70,12 +75,16 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     };
     // Load cover from path indicated in coverInfo. WARNING: This is run in a
     // worker thread.
+    //
+    // Small covers are loaded from a thumbnail in thumbnailPath if available
+    // and are stored as a thumbnail otherwise.
     static FutureResult loadCover(
             const QObject* pRequestor,
             TrackPointer pTrack,
             CoverInfo coverInfo,
             int desiredWidth,
-            bool emitSignals);
+            bool emitSignals,
+            const QString& thumbnailPath = QString());
 
   private slots:
     // Called when loadCover is complete in the main thread.
@@ -107,7 +116,13 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             int desiredWidth,
             Loading loading);
 
-    QSet<QPair<const QObject*, quint16> > m_runningRequests;
+    // Whether to signal when done, requests that prefetch covers don't
+    QHash<QPair<const QObject*, quint16>, bool> m_runningRequests;
+
+    // Resized covers in least recently used order, the cost is in KB
+    QCache<QString, QPixmap> m_pixmapCache;
+
+    QString m_thumbnailPath;
 };
 
 inline
@@ -1,7 +1,10 @@
+#include <QDataStream>
 #include <QSqlQuery>
 #include <QSqlResult>
 #include <QSqlError>
 #include <QtDebug>
+#include <cstring>
+#include <limits>
 
 #include "library/dao/analysisdao.h"
 #include "library/queryutil.h"
@@ -17,6 +20,47 @@ const QString AnalysisDao::s_analysisTableName = "track_analysis";
 // CPU time so I think we should stick with the default. rryan 4/3/2012
 const int kCompressionLevel = -1;
 
+// Files of mapped analyses start with this header followed by the data. All
+// values are little endian.
+//
+//   char[4] magic
+//   quint32 version
+//   quint64 dataSize
+//
+// Compressed files start with the big endian size of the uncompressed data
+// instead, which does not match the magic for sizes below 1 GB.
+const char kMappedMagic[4] = {'M', 'X', 'A', 'B'};
+const quint32 kMappedVersion = 1;
+const int kMappedHeaderSize = 16;
+
+namespace {
+
+QByteArray mappedHeader(int dataSize) {
+    QByteArray header;
+    QDataStream stream(&header, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData(kMappedMagic, sizeof(kMappedMagic));
+    stream << kMappedVersion << static_cast<quint64>(dataSize);
+    DEBUG_ASSERT(header.size() == kMappedHeaderSize);
+    return header;
+}
+
+// Trailing zeros, e.g. the padding of a waveform texture, are not written.
+// The file is extended to its full size instead, which leaves a hole in file
+// systems that support sparse files.
+bool writeData(QFile* pFile, const QByteArray& data) {
+    int size = data.size();
+    while (size > 0 && data.at(size - 1) == '\0') {
+        --size;
+    }
+    if (pFile->write(data.constData(), size) != size) {
+        return false;
+    }
+    return pFile->resize(data.size());
+}
+
+} // anonymous namespace
+
 AnalysisDao::AnalysisDao(UserSettingsPointer pConfig)
         : m_pConfig(pConfig) {
     QDir storagePath = getAnalysisStoragePath();
@@ -84,15 +128,11 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        QByteArray compressedData = loadDataFromFile(dataPath);
-        int file_checksum = qChecksum(compressedData.constData(),
-                                      compressedData.length());
-        if (checksum != file_checksum) {
+        if (!loadAnalysisData(dataPath, checksum, &info)) {
             qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
+                     << "length" << QFileInfo(dataPath).size();
             continue;
         }
-        info.data = qUncompress(compressedData);
         bytes += info.data.length();
         analyses.append(info);
     }
@@ -114,9 +154,17 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-    int checksum = qChecksum(compressedData.constData(),
-                             compressedData.length());
+    QByteArray fileData;
+    int checksum;
+    if (info->storageFormat == STORAGE_MAPPED) {
+        // Only the header is validated when loading
+        fileData = mappedHeader(info->data.length());
+        checksum = qChecksum(fileData.constData(), fileData.length());
+        fileData.append(info->data);
+    } else {
+        fileData = qCompress(info->data, kCompressionLevel);
+        checksum = qChecksum(fileData.constData(), fileData.length());
+    }
 
     QSqlQuery query(m_db);
     if (info->analysisId == -1) {
@@ -161,14 +209,14 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
 
     QString dataPath = getAnalysisStoragePath().absoluteFilePath(
         QString::number(info->analysisId));
-    if (!saveDataToFile(dataPath, compressedData)) {
+    if (!saveDataToFile(dataPath, fileData)) {
         qDebug() << "WARNING: Couldn't save analysis data to file" << dataPath;
         return false;
     }
 
     qDebug() << "AnalysisDAO saved analysis" << info->analysisId
-             << QString("%1 (%2 compressed)").arg(QString::number(info->data.length()),
-                                                  QString::number(compressedData.length()))
+             << QString("%1 (%2 stored)").arg(QString::number(info->data.length()),
+                                              QString::number(fileData.length()))
              << "bytes for track"
              << info->trackId << "in" << time.elapsed().debugMillisWithUnit();
     return true;
@@ -178,6 +226,14 @@ bool AnalysisDao::deleteAnalysis(const int analysisId) {
     if (analysisId == -1) {
         return false;
     }
+    // The analysis is kept if its file can't be removed, so removing it can
+    // be retried and its file is not left behind
+    QString dataPath = getAnalysisStoragePath().absoluteFilePath(
+        QString::number(analysisId));
+    if (!deleteFile(dataPath)) {
+        return false;
+    }
+
     QSqlQuery query(m_db);
     query.prepare(QString(
         "DELETE FROM %1 WHERE id = :id").arg(s_analysisTableName));
@@ -187,10 +243,6 @@ bool AnalysisDao::deleteAnalysis(const int analysisId) {
         LOG_FAILED_QUERY(query) << "couldn't delete analysis";
         return false;
     }
-
-    QString dataPath = getAnalysisStoragePath().absoluteFilePath(
-        QString::number(analysisId));
-    deleteFile(dataPath);
     return true;
 }
 
@@ -239,10 +291,11 @@ bool AnalysisDao::deleteAnalysesForTrack(TrackId trackId) {
         analysesToDelete.append(
             query.value(idColumn).toInt());
     }
+    bool success = true;
     foreach (int analysisId, analysesToDelete) {
-        deleteAnalysis(analysisId);
+        success = deleteAnalysis(analysisId) && success;
     }
-    return true;
+    return success;
 }
 
 QDir AnalysisDao::getAnalysisStoragePath() const {
@@ -251,20 +304,79 @@ QDir AnalysisDao::getAnalysisStoragePath() const {
     return dir.absolutePath().append("/");
 }
 
-QByteArray AnalysisDao::loadDataFromFile(const QString& filename) const {
-    QFile file(filename);
-    if (!file.exists()) {
-        return QByteArray();
+bool AnalysisDao::loadAnalysisData(
+        const QString& fileName, int checksum, AnalysisInfo* info) const {
+    auto pFile = std::make_shared<QFile>(fileName);
+    if (!pFile->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QByteArray header = pFile->peek(kMappedHeaderSize);
+    if (header.length() < kMappedHeaderSize ||
+            std::memcmp(header.constData(), kMappedMagic, sizeof(kMappedMagic)) != 0) {
+        const QByteArray compressedData = pFile->readAll();
+        if (checksum != qChecksum(compressedData.constData(), compressedData.length())) {
+            return false;
+        }
+        info->storageFormat = STORAGE_COMPRESSED;
+        info->data = qUncompress(compressedData);
+        return true;
+    }
+
+    if (checksum != qChecksum(header.constData(), header.length())) {
+        return false;
+    }
+    QDataStream stream(header);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.skipRawData(sizeof(kMappedMagic));
+    quint32 version = 0;
+    quint64 dataSize = 0;
+    stream >> version >> dataSize;
+    if (version != kMappedVersion) {
+        qDebug() << "WARNING: Unsupported analysis version" << version
+                 << "in" << fileName;
+        return false;
+    }
+    if (dataSize != static_cast<quint64>(pFile->size() - kMappedHeaderSize) ||
+            dataSize > static_cast<quint64>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    info->storageFormat = STORAGE_MAPPED;
+    if (dataSize == 0) {
+        info->data = QByteArray();
+        return true;
+    }
+#ifndef __WINDOWS__
+    const uchar* pData = pFile->map(kMappedHeaderSize, static_cast<qint64>(dataSize));
+    if (pData) {
+        // The mapping outlives the file descriptor until pFile is destroyed.
+        // Removing or replacing the file only unlinks it.
+        pFile->close();
+        info->data = QByteArray::fromRawData(
+                reinterpret_cast<const char*>(pData), static_cast<int>(dataSize));
+        info->pMappedFile = pFile;
+        return true;
     }
-    if (!file.open(QIODevice::ReadOnly)) {
-        return QByteArray();
+    // Mapping may fail, e.g. if the address space is exhausted
+    qDebug() << "WARNING: Failed to map analysis" << fileName
+             << pFile->errorString();
+#endif
+    if (!pFile->seek(kMappedHeaderSize)) {
+        return false;
     }
-    return file.readAll();
+    info->data = pFile->read(static_cast<qint64>(dataSize));
+    return info->data.length() == static_cast<int>(dataSize);
 }
 
 bool AnalysisDao::deleteFile(const QString& fileName) const {
     QFile file(fileName);
-    return file.remove();
+    if (!file.exists() || file.remove()) {
+        return true;
+    }
+    qWarning() << "Failed to remove analysis file" << fileName
+               << file.errorString();
+    return false;
 }
 
 bool AnalysisDao::saveDataToFile(const QString& fileName, const QByteArray& data) const {
@@ -278,15 +390,17 @@ bool AnalysisDao::saveDataToFile(const QString& fileName, const QByteArray& data
         if (!tempFile.open(QIODevice::WriteOnly)) {
             return false;
         }
-        int bytesWritten = tempFile.write(data);
-        if (bytesWritten == -1 || bytesWritten != data.length()) {
+        if (!writeData(&tempFile, data)) {
             return false;
         }
         tempFile.close();
-        if (!file.remove()) {
+        if (!deleteFile(fileName)) {
+            tempFile.remove();
             return false;
         }
         if (!tempFile.rename(fileName)) {
+            qWarning() << "Failed to rename analysis file" << tempFileName
+                       << tempFile.errorString();
             return false;
         }
         return true;
@@ -296,8 +410,7 @@ bool AnalysisDao::saveDataToFile(const QString& fileName, const QByteArray& data
     if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
-    int bytesWritten = file.write(data);
-    if (bytesWritten == -1 || bytesWritten != data.length()) {
+    if (!writeData(&file, data)) {
         return false;
     }
     file.close();
@@ -329,7 +442,8 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVEFORM;
     analysis.description = pWaveform->getDescription();
     analysis.version = pWaveform->getVersion();
-    analysis.data = pWaveform->toByteArray();
+    analysis.storageFormat = AnalysisDao::STORAGE_MAPPED;
+    analysis.data = pWaveform->toBlob();
     bool success = saveAnalysis(&analysis);
     if (success) {
         pWaveform->setSaveState(Waveform::SaveState::Saved);
@@ -344,7 +458,7 @@ void AnalysisDao::saveTrackAnalyses(
     analysis.type = AnalysisDao::TYPE_WAVESUMMARY;
     analysis.description = pWaveSummary->getDescription();
     analysis.version = pWaveSummary->getVersion();
-    analysis.data = pWaveSummary->toByteArray();
+    analysis.data = pWaveSummary->toBlob();
 
     success = saveAnalysis(&analysis);
     if (success) {
@@ -393,15 +507,22 @@ bool AnalysisDao::deleteAnalysesByType(
     }
 
     const int idColumn = query.record().indexOf("id");
+    // Analyses whose files can't be removed are kept
+    QStringList keptIdList;
     while (query.next()) {
-        QString dataPath = analysisPath.absoluteFilePath(query.value(idColumn).toString());
-        deleteFile(dataPath);
+        const QString id = query.value(idColumn).toString();
+        QString dataPath = analysisPath.absoluteFilePath(id);
+        if (!deleteFile(dataPath)) {
+            keptIdList << id;
+        }
     }
-    query.prepare(QString("DELETE FROM %1 WHERE type=:type").arg(s_analysisTableName));
+    query.prepare(QString("DELETE FROM %1 WHERE type=:type AND id NOT IN (%2)")
+                          .arg(s_analysisTableName, keptIdList.join(",")));
     query.bindValue(":type", type);
     if (!query.exec()) {
         LOG_FAILED_QUERY(query) << "couldn't delete analysis";
+        return false;
     }
 
-    return true;
+    return keptIdList.isEmpty();
 }
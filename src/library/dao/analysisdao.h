@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QDir>
 #include <QSqlDatabase>
+#include <memory>
 
 #include "preferences/usersettings.h"
 #include "library/dao/dao.h"
@@ -20,17 +21,33 @@ class AnalysisDao : public DAO {
         TYPE_WAVESUMMARY
     };
 
+    enum StorageFormat {
+        // Compressed with qCompress. Loading reads and decompresses the
+        // whole file.
+        STORAGE_COMPRESSED = 0,
+        // A versioned header followed by the uncompressed data. Loading maps
+        // the file into memory and only validates the header. On Windows,
+        // mapped files can't be removed or replaced, so the data is read
+        // into memory instead.
+        STORAGE_MAPPED
+    };
+
     struct AnalysisInfo {
         AnalysisInfo()
                 : analysisId(-1),
-                  type(TYPE_UNKNOWN) {
+                  type(TYPE_UNKNOWN),
+                  storageFormat(STORAGE_COMPRESSED) {
         }
         int analysisId;
         TrackId trackId;
         AnalysisType type;
         QString description;
         QString version;
+        StorageFormat storageFormat;
         QByteArray data;
+        // Keeps the file mapped while data refers to it. The file itself
+        // has already been closed.
+        std::shared_ptr<const void> pMappedFile;
     };
 
     explicit AnalysisDao(UserSettingsPointer pConfig);
@@ -64,8 +81,8 @@ class AnalysisDao : public DAO {
 
   private:
     QDir getAnalysisStoragePath() const;
-    QByteArray loadDataFromFile(const QString& fileName) const;
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
+    bool loadAnalysisData(const QString& fileName, int checksum, AnalysisInfo* info) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
 
@@ -0,0 +1,97 @@
+#include "library/dao/libraryfilestatdao.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QtDebug>
+
+#ifndef __WINDOWS__
+#include <sys/stat.h>
+#endif
+
+#include "library/queryutil.h"
+
+// static
+LibraryFileStat LibraryFileStat::fromFileInfo(const QFileInfo& fileInfo) {
+#ifdef __WINDOWS__
+    if (!fileInfo.exists()) {
+        return LibraryFileStat();
+    }
+    return LibraryFileStat(
+            fileInfo.size(),
+            fileInfo.lastModified().toMSecsSinceEpoch(),
+            0);
+#else
+    // A single stat() call instead of letting QFileInfo query the
+    // same information, which doesn't provide the inode anyway.
+    struct stat statBuf;
+    if (stat(QFile::encodeName(fileInfo.filePath()).constData(), &statBuf) != 0) {
+        return LibraryFileStat();
+    }
+#ifdef __APPLE__
+    const qint64 modifiedNanos = statBuf.st_mtimespec.tv_nsec;
+#else
+    const qint64 modifiedNanos = statBuf.st_mtim.tv_nsec;
+#endif
+    return LibraryFileStat(
+            statBuf.st_size,
+            static_cast<qint64>(statBuf.st_mtime) * 1000 + modifiedNanos / 1000000,
+            statBuf.st_ino);
+#endif
+}
+
+QHash<QString, LibraryFileStat> LibraryFileStatDAO::getFileStats() {
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare("SELECT location, size, modified, inode FROM LibraryFileStats");
+    QHash<QString, LibraryFileStat> fileStats;
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return fileStats;
+    }
+
+    const QSqlRecord record = query.record();
+    const int locationColumn = record.indexOf("location");
+    const int sizeColumn = record.indexOf("size");
+    const int modifiedColumn = record.indexOf("modified");
+    const int inodeColumn = record.indexOf("inode");
+    while (query.next()) {
+        fileStats.insert(query.value(locationColumn).toString(),
+                LibraryFileStat(
+                        query.value(sizeColumn).toLongLong(),
+                        query.value(modifiedColumn).toLongLong(),
+                        static_cast<quint64>(query.value(inodeColumn).toLongLong())));
+    }
+    return fileStats;
+}
+
+void LibraryFileStatDAO::saveFileStats(
+        const QHash<QString, LibraryFileStat>& fileStats) {
+    if (fileStats.isEmpty()) {
+        return;
+    }
+    QSqlQuery query(m_database);
+    query.prepare("INSERT OR REPLACE INTO LibraryFileStats "
+                  "(location, size, modified, inode) "
+                  "VALUES (:location, :size, :modified, :inode)");
+    for (auto it = fileStats.constBegin(); it != fileStats.constEnd(); ++it) {
+        query.bindValue(":location", it.key());
+        query.bindValue(":size", it.value().size());
+        query.bindValue(":modified", it.value().modified());
+        // SQLite only stores signed 64-bit integers
+        query.bindValue(":inode", static_cast<qint64>(it.value().inode()));
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query) << "Saving file status failed.";
+        }
+    }
+}
+
+void LibraryFileStatDAO::removeStaleFileStats() {
+    QSqlQuery query(m_database);
+    query.prepare("DELETE FROM LibraryFileStats WHERE location NOT IN "
+                  "(SELECT location FROM track_locations WHERE fs_deleted=0)");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+}
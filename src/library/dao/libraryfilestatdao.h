@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QString>
+
+#include "library/dao/dao.h"
+
+// The properties of a file that change when its contents are modified or
+// when it is replaced by another file. The inode is 0 on platforms that
+// don't have inodes.
+class LibraryFileStat {
+  public:
+    LibraryFileStat()
+            : m_size(-1),
+              m_modified(-1),
+              m_inode(0) {
+    }
+    LibraryFileStat(qint64 size, qint64 modified, quint64 inode)
+            : m_size(size),
+              m_modified(modified),
+              m_inode(inode) {
+    }
+
+    // Reads the current properties of the file from the file system. The
+    // result is invalid if the file is not accessible.
+    static LibraryFileStat fromFileInfo(const QFileInfo& fileInfo);
+
+    bool isValid() const {
+        return m_size >= 0;
+    }
+
+    qint64 size() const {
+        return m_size;
+    }
+    // Milliseconds since the epoch
+    qint64 modified() const {
+        return m_modified;
+    }
+    quint64 inode() const {
+        return m_inode;
+    }
+
+  private:
+    qint64 m_size;
+    qint64 m_modified;
+    quint64 m_inode;
+};
+
+inline bool operator==(const LibraryFileStat& lhs, const LibraryFileStat& rhs) {
+    return lhs.size() == rhs.size() &&
+            lhs.modified() == rhs.modified() &&
+            lhs.inode() == rhs.inode();
+}
+
+inline bool operator!=(const LibraryFileStat& lhs, const LibraryFileStat& rhs) {
+    return !(lhs == rhs);
+}
+
+// Stores the properties of all track files as seen by the last library scan.
+class LibraryFileStatDAO : public DAO {
+  public:
+    ~LibraryFileStatDAO() override {}
+
+    void initialize(const QSqlDatabase& database) override {
+        m_database = database;
+    }
+
+    QHash<QString, LibraryFileStat> getFileStats();
+    void saveFileStats(const QHash<QString, LibraryFileStat>& fileStats);
+    // Removes the entries of files that are no longer in the library.
+    void removeStaleFileStats();
+
+  private:
+    QSqlDatabase m_database;
+};
@@ -7,6 +7,7 @@
 #include "library/trackcollection.h"
 #include "library/autodj/autodjprocessor.h"
 #include "util/compatibility.h"
+#include "util/db/fwdsqlquery.h"
 #include "util/math.h"
 
 PlaylistDAO::PlaylistDAO()
@@ -106,21 +107,20 @@ int PlaylistDAO::createUniquePlaylist(QString* pName, const HiddenType hidden) {
 QString PlaylistDAO::getPlaylistName(const int playlistId) const {
     //qDebug() << "PlaylistDAO::getPlaylistName" << QThread::currentThread() << m_database.connectionName();
 
-    QSqlQuery query(m_database);
-    query.prepare("SELECT name FROM Playlists "
-                  "WHERE id= :id");
+    FwdSqlQuery query(m_database,
+            "SELECT name FROM Playlists "
+            "WHERE id= :id");
     query.bindValue(":id", playlistId);
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    if (!query.execPrepared()) {
         return "";
     }
 
     // Get the name field
     QString name = "";
-    const int nameColumn = query.record().indexOf("name");
+    const DbFieldIndex nameColumn = query.fieldIndex("name");
     if (query.next()) {
-        name = query.value(nameColumn).toString();
+        name = query.fieldValue(nameColumn).toString();
     }
     return name;
 }
@@ -147,15 +147,11 @@ QList<TrackId> PlaylistDAO::getTrackIds(const int playlistId) const {
 int PlaylistDAO::getPlaylistIdFromName(const QString& name) const {
     //qDebug() << "PlaylistDAO::getPlaylistIdFromName" << QThread::currentThread() << m_database.connectionName();
 
-    QSqlQuery query(m_database);
-    query.prepare("SELECT id FROM Playlists WHERE name = :name");
+    FwdSqlQuery query(m_database,
+            "SELECT id FROM Playlists WHERE name = :name");
     query.bindValue(":name", name);
-    if (query.exec()) {
-        if (query.next()) {
-            return query.value(query.record().indexOf("id")).toInt();
-        }
-    } else {
-        LOG_FAILED_QUERY(query);
+    if (query.execPrepared() && query.next()) {
+        return query.fieldValue(query.fieldIndex("id")).toInt();
     }
     return -1;
 }
@@ -229,17 +225,13 @@ bool PlaylistDAO::setPlaylistLocked(const int playlistId, const bool locked) {
 }
 
 bool PlaylistDAO::isPlaylistLocked(const int playlistId) const {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT locked FROM Playlists WHERE id = :id");
+    FwdSqlQuery query(m_database,
+            "SELECT locked FROM Playlists WHERE id = :id");
     query.bindValue(":id", playlistId);
 
-    if (query.exec()) {
-        if (query.next()) {
-            int lockValue = query.value(0).toInt();
-            return lockValue == 1;
-        }
-    } else {
-        LOG_FAILED_QUERY(query);
+    if (query.execPrepared() && query.next()) {
+        int lockValue = query.fieldValue(0).toInt();
+        return lockValue == 1;
     }
     return false;
 }
@@ -351,16 +343,12 @@ PlaylistDAO::HiddenType PlaylistDAO::getHiddenType(const int playlistId) const {
     // qDebug() << "PlaylistDAO::getHiddenType"
     //          << QThread::currentThread() << m_database.connectionName();
 
-    QSqlQuery query(m_database);
-    query.prepare("SELECT hidden FROM Playlists WHERE id = :id");
+    FwdSqlQuery query(m_database,
+            "SELECT hidden FROM Playlists WHERE id = :id");
     query.bindValue(":id", playlistId);
 
-    if (query.exec()) {
-        if (query.next()) {
-            return static_cast<HiddenType>(query.value(0).toInt());
-        }
-    } else {
-        LOG_FAILED_QUERY(query);
+    if (query.execPrepared() && query.next()) {
+        return static_cast<HiddenType>(query.fieldValue(0).toInt());
     }
     qDebug() << "PlaylistDAO::getHiddenType returns PLHT_UNKNOWN for playlistId "
              << playlistId;
@@ -720,18 +708,15 @@ bool PlaylistDAO::copyPlaylistTracks(const int sourcePlaylistID, const int targe
 int PlaylistDAO::getMaxPosition(const int playlistId) const {
     // Find out the highest position existing in the playlist so we know what
     // position this track should have.
-    QSqlQuery query(m_database);
-    query.prepare("SELECT max(position) as position FROM PlaylistTracks "
-                  "WHERE playlist_id = :id");
+    FwdSqlQuery query(m_database,
+            "SELECT max(position) as position FROM PlaylistTracks "
+            "WHERE playlist_id = :id");
     query.bindValue(":id", playlistId);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
-    }
 
     // Get the position of the highest track in the playlist.
     int position = 0;
-    if (query.next()) {
-        position = query.value(query.record().indexOf("position")).toInt();
+    if (query.execPrepared() && query.next()) {
+        position = query.fieldValue(query.fieldIndex("position")).toInt();
     }
     return position;
 }
@@ -758,19 +743,19 @@ void PlaylistDAO::removeTracksFromPlaylists(const QList<TrackId>& trackIds) {
 }
 
 int PlaylistDAO::tracksInPlaylist(const int playlistId) const {
-    QSqlQuery query(m_database);
-    query.prepare("SELECT COUNT(id) AS count FROM PlaylistTracks "
-                  "WHERE playlist_id = :playlist_id");
+    FwdSqlQuery query(m_database,
+            "SELECT COUNT(id) AS count FROM PlaylistTracks "
+            "WHERE playlist_id = :playlist_id");
     query.bindValue(":playlist_id", playlistId);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query) << "Couldn't get the number of tracks in playlist"
-                                << playlistId;
+    if (!query.execPrepared()) {
+        qWarning() << "Couldn't get the number of tracks in playlist"
+                   << playlistId;
         return -1;
     }
     int count = -1;
-    const int countColumn = query.record().indexOf("count");
+    const DbFieldIndex countColumn = query.fieldIndex("count");
     while (query.next()) {
-        count = query.value(countColumn).toInt();
+        count = query.fieldValue(countColumn).toInt();
     }
     return count;
 }
@@ -115,21 +115,19 @@ TrackId TrackDAO::getTrackIdByLocation(const QString& location) const {
         return TrackId();
     }
 
-    QSqlQuery query(m_database);
-    query.prepare(
+    FwdSqlQuery query(m_database,
             "SELECT library.id FROM library "
             "INNER JOIN track_locations ON library.location = track_locations.id "
             "WHERE track_locations.location=:location");
     query.bindValue(":location", location);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    if (!query.execPrepared()) {
         return TrackId();
     }
     if (!query.next()) {
         qDebug() << "TrackDAO::getTrackId(): Track location not found in library:" << location;
         return TrackId();
     }
-    const auto trackId = TrackId(query.value(query.record().indexOf("id")));
+    const auto trackId = TrackId(query.fieldValue(query.fieldIndex("id")));
     DEBUG_ASSERT(trackId.isValid());
     return trackId;
 }
@@ -651,6 +649,20 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 }
 
 TrackPointer TrackDAO::addTracksAddFile(const TrackFile& trackFile, bool unremove) {
+    return addTracksAddFile(trackFile, nullptr, unremove);
+}
+
+TrackPointer TrackDAO::addTracksAddImportedFile(
+        const TrackFile& trackFile,
+        const mixxx::TrackRecord& importedRecord,
+        bool unremove) {
+    return addTracksAddFile(trackFile, &importedRecord, unremove);
+}
+
+TrackPointer TrackDAO::addTracksAddFile(
+        const TrackFile& trackFile,
+        const mixxx::TrackRecord* pImportedRecord,
+        bool unremove) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -681,9 +693,20 @@ TrackPointer TrackDAO::addTracksAddFile(const TrackFile& trackFile, bool unremov
     // Keep the GlobalTrackCache locked until the id of the Track
     // object is known and has been updated in the cache.
 
-    // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource();
+    if (pImportedRecord) {
+        // The metadata has already been imported from the file while
+        // the cache was not locked.
+        pTrack->setType(pImportedRecord->getFileType());
+        pTrack->importMetadata(
+                pImportedRecord->getMetadata(),
+                pImportedRecord->getMetadataSynchronized() ?
+                        trackFile.fileLastModified() : QDateTime());
+        pTrack->setCoverInfo(pImportedRecord->getCoverInfo());
+    } else {
+        // Initially (re-)import the metadata for the newly created track
+        // from the file.
+        SoundSourceProxy(pTrack).updateTrackFromSource();
+    }
     if (!pTrack->isMetadataSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -1136,7 +1159,6 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
     // will be locked again after the query has been executed (see below)
     // and potential race conditions will be resolved.
     ScopedTimer t("TrackDAO::getTrackById");
-    QSqlQuery query(m_database);
 
     ColumnPopulator columns[] = {
         // Location must be first.
@@ -1208,14 +1230,15 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         columnsStr.append(columns[i].name);
     }
 
-    query.prepare(QString(
+    // The id is bound, so the statement can be reused for all tracks
+    FwdSqlQuery query(m_database, QString(
             "SELECT %1 FROM Library "
             "INNER JOIN track_locations ON library.location = track_locations.id "
-            "WHERE library.id = %2").arg(columnsStr, trackId.toString()));
+            "WHERE library.id = :id").arg(columnsStr));
+    query.bindValue(":id", trackId);
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query)
-                << QString("getTrack(%1)").arg(trackId.toString());
+    if (!query.execPrepared()) {
+        qWarning() << QString("getTrack(%1)").arg(trackId.toString());
         return TrackPointer();
     }
     if (!query.next()) {
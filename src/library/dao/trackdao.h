@@ -114,6 +114,16 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackPointer addTracksAddFile(
             const TrackFile& trackFile,
             bool unremove);
+    // Adds a file whose metadata has already been imported into a
+    // plain track record, e.g. concurrently by the library scanner.
+    TrackPointer addTracksAddImportedFile(
+            const TrackFile& trackFile,
+            const mixxx::TrackRecord& importedRecord,
+            bool unremove);
+    TrackPointer addTracksAddFile(
+            const TrackFile& trackFile,
+            const mixxx::TrackRecord* pImportedRecord,
+            bool unremove);
     void addTracksFinish(bool rollback = false);
 
     bool updateTrack(Track* pTrack) const;
@@ -36,6 +36,8 @@ const QString LIBRARYTABLE_RATING = "rating";
 const QString LIBRARYTABLE_KEY = "key";
 const QString LIBRARYTABLE_KEY_ID = "key_id";
 const QString LIBRARYTABLE_BPM_LOCK = "bpm_lock";
+const QString LIBRARYTABLE_BEATS_SUB_VERSION = "beats_sub_version";
+const QString LIBRARYTABLE_KEYS_SUB_VERSION = "keys_sub_version";
 const QString LIBRARYTABLE_PREVIEW = "preview";
 const QString LIBRARYTABLE_COLOR = "color";
 const QString LIBRARYTABLE_COVERART = "coverart";
@@ -43,6 +45,7 @@ const QString LIBRARYTABLE_COVERART_SOURCE = "coverart_source";
 const QString LIBRARYTABLE_COVERART_TYPE = "coverart_type";
 const QString LIBRARYTABLE_COVERART_LOCATION = "coverart_location";
 const QString LIBRARYTABLE_COVERART_HASH = "coverart_hash";
+const QString LIBRARYTABLE_AUDIOFINGERPRINT = "audio_fingerprint";
 
 const QString TRACKLOCATIONSTABLE_ID = "id";
 const QString TRACKLOCATIONSTABLE_LOCATION = "location";
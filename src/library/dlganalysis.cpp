@@ -10,13 +10,17 @@
 #include "library/library.h"
 #include "widget/wlibrary.h"
 #include "util/assert.h"
+#include "util/duration.h"
 
 DlgAnalysis::DlgAnalysis(WLibrary* parent,
                        UserSettingsPointer pConfig,
                        Library* pLibrary)
         : QWidget(parent),
           m_pConfig(pConfig),
-          m_bAnalysisActive(false) {
+          m_bAnalysisActive(false),
+          m_reusedTracksCount(0),
+          m_partiallyReusedTracksCount(0),
+          m_estimatedSecondsSaved(0.0) {
     setupUi(this);
     m_songsButtonGroup.addButton(radioButtonRecentlyAdded);
     m_songsButtonGroup.addButton(radioButtonAllSongs);
@@ -176,6 +180,9 @@ void DlgAnalysis::slotAnalysisActive(bool bActive) {
         pushButtonAnalyze->setChecked(true);
         pushButtonAnalyze->setText(tr("Stop Analysis"));
         labelProgress->setEnabled(true);
+        m_reusedTracksCount = 0;
+        m_partiallyReusedTracksCount = 0;
+        m_estimatedSecondsSaved = 0.0;
     } else {
         pushButtonAnalyze->setChecked(false);
         pushButtonAnalyze->setText(tr("Analyze"));
@@ -202,10 +209,25 @@ void DlgAnalysis::onTrackAnalysisSchedulerProgress(
                     QString::number(finishedCount),
                     QString::number(totalCount));
         }
+        if (m_reusedTracksCount > 0 || m_partiallyReusedTracksCount > 0) {
+            progressText += QStringLiteral(" ") +
+                    tr("(%1 reused, %2 partially reused, %3 saved)").arg(
+                            QString::number(m_reusedTracksCount),
+                            QString::number(m_partiallyReusedTracksCount),
+                            mixxx::Duration::formatTime(m_estimatedSecondsSaved));
+        }
         labelProgress->setText(progressText);
     }
 }
 
+void DlgAnalysis::onTrackAnalysisSchedulerAnalysisReused(
+        int reusedTracksCount, int partiallyReusedTracksCount, double estimatedSecondsSaved) {
+    // Displayed with the next progress update
+    m_reusedTracksCount = reusedTracksCount;
+    m_partiallyReusedTracksCount = partiallyReusedTracksCount;
+    m_estimatedSecondsSaved = estimatedSecondsSaved;
+}
+
 void DlgAnalysis::onTrackAnalysisSchedulerFinished() {
     slotAnalysisActive(false);
 }
@@ -44,6 +44,7 @@ class DlgAnalysis : public QWidget, public Ui::DlgAnalysis, public virtual Libra
     void slotAnalysisActive(bool bActive);
     void onTrackAnalysisSchedulerProgress(AnalyzerProgress analyzerProgress, int finishedCount, int totalCount);
     void onTrackAnalysisSchedulerFinished();
+    void onTrackAnalysisSchedulerAnalysisReused(int reusedTracksCount, int partiallyReusedTracksCount, double estimatedSecondsSaved);
     void showRecentSongs();
     void showAllSongs();
     void installEventFilter(QObject* pFilter);
@@ -59,6 +60,9 @@ class DlgAnalysis : public QWidget, public Ui::DlgAnalysis, public virtual Libra
     //Note m_pTrackTablePlaceholder is defined in the .ui file
     UserSettingsPointer m_pConfig;
     bool m_bAnalysisActive;
+    int m_reusedTracksCount;
+    int m_partiallyReusedTracksCount;
+    double m_estimatedSecondsSaved;
     QButtonGroup m_songsButtonGroup;
     WAnalysisLibraryTableView* m_pAnalysisLibraryTableView;
     AnalysisLibraryTableModel* m_pAnalysisLibraryTableModel;
@@ -0,0 +1,269 @@
+#include "library/importbatchwriter.h"
+
+#include <QMutexLocker>
+#include <QtConcurrentRun>
+
+#include "library/queryutil.h"
+#include "util/assert.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/db/sqltransaction.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ImportBatchWriter");
+
+QString insertStatement(
+        const QString& tableName,
+        const QStringList& columns,
+        int rowCount) {
+    DEBUG_ASSERT(rowCount > 0);
+    QString row = QString("?,").repeated(columns.size());
+    row.chop(1);
+    QString rows = QString("(%1),").arg(row).repeated(rowCount);
+    rows.chop(1);
+    return QString("INSERT INTO %1 (%2) VALUES %3").arg(
+            tableName, columns.join(","), rows);
+}
+
+} // anonymous namespace
+
+ImportBatchWriter::ImportBatchWriter(
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        ProgressCallback progressCallback,
+        int maxRowsPerStatement)
+        : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_progressCallback(std::move(progressCallback)),
+          m_maxRowsPerStatement(math_max(maxRowsPerStatement, 1)),
+          m_finished(false),
+          m_aborted(false),
+          m_failed(false),
+          m_started(false),
+          m_rowCount(0) {
+    m_threadPool.setMaxThreadCount(1);
+}
+
+ImportBatchWriter::~ImportBatchWriter() {
+    if (m_started && !m_future.isFinished()) {
+        kLogger.warning() << "Discarding all pending rows";
+        stop(false);
+    }
+}
+
+int ImportBatchWriter::addTable(
+        const QString& tableName, const QStringList& columns) {
+    DEBUG_ASSERT(!m_started);
+    DEBUG_ASSERT(!columns.isEmpty());
+    Table table;
+    table.name = tableName;
+    table.columns = columns;
+    table.rowsPerStatement = math_max(1,
+            math_min(m_maxRowsPerStatement,
+                    kMaxVariablesPerStatement / columns.size()));
+    const int tableId = m_tables.size();
+    m_tables.append(table);
+    Batch batch;
+    batch.tableId = tableId;
+    m_pendingBatches.append(batch);
+    return tableId;
+}
+
+void ImportBatchWriter::addRow(int tableId, QVariantList values) {
+    VERIFY_OR_DEBUG_ASSERT(tableId >= 0 && tableId < m_tables.size()) {
+        return;
+    }
+    DEBUG_ASSERT(values.size() == m_tables[tableId].columns.size());
+    if (!m_started) {
+        start();
+    }
+    Batch& batch = m_pendingBatches[tableId];
+    batch.rows.append(std::move(values));
+    if (batch.rows.size() >= m_tables[tableId].rowsPerStatement) {
+        enqueueBatch(tableId);
+    }
+}
+
+bool ImportBatchWriter::finish() {
+    if (!m_started) {
+        // Nothing to write
+        return true;
+    }
+    for (int tableId = 0; tableId < m_pendingBatches.size(); ++tableId) {
+        enqueueBatch(tableId);
+    }
+    const bool success = stop(true);
+    kLogger.info()
+            << "Wrote" << rowCount() << "rows in"
+            << m_timer.elapsed().formatMillisWithUnit()
+            << "with" << rowsPerSecond() << "rows/s";
+    return success;
+}
+
+double ImportBatchWriter::rowsPerSecond() const {
+    const double seconds = m_started ? m_timer.elapsed().toDoubleSeconds() : 0.0;
+    if (seconds <= 0.0) {
+        return 0.0;
+    }
+    return rowCount() / seconds;
+}
+
+void ImportBatchWriter::start() {
+    DEBUG_ASSERT(!m_started);
+    m_started = true;
+    m_timer.start();
+    m_future = QtConcurrent::run(&m_threadPool, this, &ImportBatchWriter::writeBatches);
+}
+
+void ImportBatchWriter::enqueueBatch(int tableId) {
+    Batch& batch = m_pendingBatches[tableId];
+    if (batch.rows.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    while (m_queue.size() >= kMaxQueuedBatches && !m_failed) {
+        m_queueNotFull.wait(&m_mutex);
+    }
+    // Rows are dropped if the writer has already given up
+    if (!m_failed) {
+        m_queue.append(batch);
+        m_queueNotEmpty.wakeOne();
+    }
+    locker.unlock();
+    batch.rows = QList<QVariantList>();
+    batch.rows.reserve(m_tables[tableId].rowsPerStatement);
+}
+
+bool ImportBatchWriter::stop(bool commit) {
+    QMutexLocker locker(&m_mutex);
+    if (commit) {
+        m_finished = true;
+    } else {
+        m_aborted = true;
+    }
+    m_queueNotEmpty.wakeAll();
+    locker.unlock();
+    m_future.waitForFinished();
+    return m_future.result();
+}
+
+void ImportBatchWriter::setFailed() {
+    QMutexLocker locker(&m_mutex);
+    m_failed = true;
+    m_queue.clear();
+    // Unblock the producer
+    m_queueNotFull.wakeAll();
+}
+
+bool ImportBatchWriter::writeBatches() {
+    const mixxx::DbConnectionPooler dbConnectionPooler(m_pDbConnectionPool);
+    QSqlDatabase database = mixxx::DbConnectionPooled(m_pDbConnectionPool);
+    if (!database.isOpen()) {
+        kLogger.warning() << "No database connection";
+        setFailed();
+        return false;
+    }
+    SqlTransaction transaction(database);
+    if (!transaction) {
+        setFailed();
+        return false;
+    }
+
+    // Full batches reuse the same prepared statement
+    QList<QSqlQuery> batchQueries;
+    QList<QSqlQuery> rowQueries;
+    for (const auto& table : m_tables) {
+        QSqlQuery batchQuery(database);
+        batchQuery.prepare(insertStatement(
+                table.name, table.columns, table.rowsPerStatement));
+        batchQueries.append(batchQuery);
+        QSqlQuery rowQuery(database);
+        rowQuery.prepare(insertStatement(table.name, table.columns, 1));
+        rowQueries.append(rowQuery);
+    }
+
+    PerformanceTimer progressTimer;
+    progressTimer.start();
+    QMutexLocker locker(&m_mutex);
+    while (true) {
+        while (m_queue.isEmpty() && !m_finished && !m_aborted) {
+            m_queueNotEmpty.wait(&m_mutex);
+        }
+        if (m_aborted || m_queue.isEmpty()) {
+            break;
+        }
+        const Batch batch = m_queue.takeFirst();
+        m_queueNotFull.wakeOne();
+        locker.unlock();
+
+        m_rowCount += writeBatch(
+                database,
+                batch,
+                &batchQueries[batch.tableId],
+                &rowQueries[batch.tableId]);
+        if (m_progressCallback &&
+                progressTimer.elapsed().toIntegerMillis() >= kProgressIntervalMillis) {
+            progressTimer.restart();
+            m_progressCallback(rowCount(), rowsPerSecond());
+        }
+
+        locker.relock();
+    }
+    const bool aborted = m_aborted;
+    locker.unlock();
+
+    if (aborted) {
+        transaction.rollback();
+        return false;
+    }
+    if (!transaction.commit()) {
+        setFailed();
+        return false;
+    }
+    if (m_progressCallback) {
+        m_progressCallback(rowCount(), rowsPerSecond());
+    }
+    return true;
+}
+
+int ImportBatchWriter::writeBatch(
+        QSqlDatabase database,
+        const Batch& batch,
+        QSqlQuery* pBatchQuery,
+        QSqlQuery* pRowQuery) {
+    const Table& table = m_tables[batch.tableId];
+    QSqlQuery partialQuery(database);
+    QSqlQuery* pQuery = pBatchQuery;
+    if (batch.rows.size() != table.rowsPerStatement) {
+        // Only the last batch of each table might not be full
+        partialQuery.prepare(insertStatement(
+                table.name, table.columns, batch.rows.size()));
+        pQuery = &partialQuery;
+    }
+    int index = 0;
+    for (const auto& row : batch.rows) {
+        for (const auto& value : row) {
+            pQuery->bindValue(index++, value);
+        }
+    }
+    if (pQuery->exec()) {
+        return batch.rows.size();
+    }
+    LOG_FAILED_QUERY(*pQuery);
+
+    // The failed statement has not inserted any rows. Retry them one by
+    // one to keep all rows except the invalid ones.
+    int rowCount = 0;
+    for (const auto& row : batch.rows) {
+        for (int i = 0; i < row.size(); ++i) {
+            pRowQuery->bindValue(i, row[i]);
+        }
+        if (pRowQuery->exec()) {
+            ++rowCount;
+        } else {
+            LOG_FAILED_QUERY(*pRowQuery);
+        }
+    }
+    return rowCount;
+}
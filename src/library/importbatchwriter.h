@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QFuture>
+#include <QList>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariant>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+
+#include "util/db/dbconnectionpool.h"
+#include "util/performancetimer.h"
+
+// Writes the rows that are produced by an importer for an external
+// library into the database on a separate thread.
+//
+// Rows are collected per table into batches that are inserted with
+// a single multi-row INSERT statement. All batches are written within
+// a single transaction that is committed by finish(). The producer is
+// blocked if the writer thread falls behind by more than a few batches,
+// which limits the memory that is occupied by pending rows.
+//
+// All tables must be added before the first row. Except for the
+// constructor and the progress callback all functions must be invoked
+// from the same (producer) thread.
+class ImportBatchWriter final {
+  public:
+    // Invoked on the writer thread after batches have been written,
+    // but not more often than every kProgressIntervalMillis
+    typedef std::function<void(int rowCount, double rowsPerSecond)> ProgressCallback;
+
+    // SQLite limits the number of host parameters per statement
+    static constexpr int kMaxVariablesPerStatement = 999;
+    static constexpr int kMaxRowsPerStatement = 256;
+    static constexpr int kMaxQueuedBatches = 16;
+    static constexpr int kProgressIntervalMillis = 250;
+
+    explicit ImportBatchWriter(
+            mixxx::DbConnectionPoolPtr pDbConnectionPool,
+            ProgressCallback progressCallback = ProgressCallback(),
+            int maxRowsPerStatement = kMaxRowsPerStatement);
+    // Aborts and rolls back all pending rows if finish() has not
+    // been invoked
+    ~ImportBatchWriter();
+
+    // Returns the id of the table for addRow()
+    int addTable(const QString& tableName, const QStringList& columns);
+
+    // The values must be ordered like the columns of the table
+    void addRow(int tableId, QVariantList values);
+
+    // Writes all pending rows and commits the transaction. Returns
+    // false if the transaction could not be committed.
+    bool finish();
+
+    int rowCount() const {
+        return m_rowCount.load();
+    }
+    double rowsPerSecond() const;
+
+  private:
+    ImportBatchWriter(const ImportBatchWriter&) = delete;
+    ImportBatchWriter& operator=(const ImportBatchWriter&) = delete;
+
+    struct Table {
+        QString name;
+        QStringList columns;
+        int rowsPerStatement;
+    };
+
+    struct Batch {
+        int tableId;
+        QList<QVariantList> rows;
+    };
+
+    void start();
+    void enqueueBatch(int tableId);
+    bool stop(bool commit);
+
+    // Executed on the writer thread
+    bool writeBatches();
+    int writeBatch(
+            QSqlDatabase database,
+            const Batch& batch,
+            QSqlQuery* pBatchQuery,
+            QSqlQuery* pRowQuery);
+    void setFailed();
+
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const ProgressCallback m_progressCallback;
+    const int m_maxRowsPerStatement;
+
+    // Only modified before the writer thread has been started
+    QList<Table> m_tables;
+
+    // Batches of the producer that have not been enqueued yet
+    QList<Batch> m_pendingBatches;
+
+    QMutex m_mutex;
+    QWaitCondition m_queueNotEmpty;
+    QWaitCondition m_queueNotFull;
+    QList<Batch> m_queue;
+    bool m_finished;
+    bool m_aborted;
+    bool m_failed;
+
+    // The writer must not wait for a thread of the global pool that
+    // might be occupied by the producer
+    QThreadPool m_threadPool;
+    bool m_started;
+    QFuture<bool> m_future;
+    PerformanceTimer m_timer;
+    std::atomic<int> m_rowCount;
+};
@@ -9,7 +9,9 @@
 #include <QFuture>
 #include <QtConcurrentRun>
 #include <QFutureWatcher>
+#include <QMutex>
 #include <QPointer>
+#include <atomic>
 
 #include "library/baseexternallibraryfeature.h"
 #include "library/trackcollection.h"
@@ -40,19 +42,22 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     void onRightClick(const QPoint& globalPos) override;
     void onTrackCollectionLoaded();
 
+  signals:
+    // Emitted from the worker threads of the import
+    void playlistItemsParsed();
+    void importProgress(int rowCount, double rowsPerSecond);
+
+  private slots:
+    void slotPlaylistItemsParsed();
+    void slotImportProgress(int rowCount, double rowsPerSecond);
+
   private:
     BaseSqlTableModel* getPlaylistModelForPlaylist(QString playlist) override;
     static QString getiTunesMusicPath();
-    // returns the invisible rootItem for the sidebar model
-    TreeItem* importLibrary();
-    void guessMusicLibraryMountpoint(QXmlStreamReader& xml);
-    void parseTracks(QXmlStreamReader& xml);
-    void parseTrack(QXmlStreamReader& xml, QSqlQuery& query);
-    TreeItem* parsePlaylists(QXmlStreamReader &xml);
-    void parsePlaylist(QXmlStreamReader& xml, QSqlQuery& query1,
-                       QSqlQuery &query2, TreeItem*);
+    // Returns false if the library could not be imported completely
+    bool importLibrary();
+    void cancelImport();
     void clearTable(QString table_name);
-    bool readNextStartElement(QXmlStreamReader& xml);
 
     BaseExternalTrackModel* m_pITunesTrackModel;
     BaseExternalPlaylistModel* m_pITunesPlaylistModel;
@@ -60,16 +65,17 @@ class ITunesFeature : public BaseExternalLibraryFeature {
     QStringList m_playlists;
     // a new DB connection for the worker thread
     QSqlDatabase m_database;
-    bool m_cancelImport;
+    std::atomic<bool> m_cancelImport;
     bool m_isActivated;
     QString m_dbfile;
 
-    QFutureWatcher<TreeItem*> m_future_watcher;
-    QFuture<TreeItem*> m_future;
+    QFutureWatcher<bool> m_future_watcher;
+    QFuture<bool> m_future;
     QString m_title;
 
-    QString m_dbItunesRoot;
-    QString m_mixxxItunesRoot;
+    // Playlists that have been parsed but not yet added to m_childModel
+    QMutex m_pendingPlaylistItemsMutex;
+    QList<TreeItem*> m_pendingPlaylistItems;
 
     QSharedPointer<BaseTrackCache> m_trackSource;
     QPointer<WLibrarySidebar> m_pSidebarWidget;
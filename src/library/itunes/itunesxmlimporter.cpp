@@ -0,0 +1,567 @@
+#include "library/itunes/itunesxmlimporter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSqlQuery>
+#include <QUrl>
+
+#include "library/queryutil.h"
+#include "library/treeitem.h"
+#include "track/trackfile.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/lcs.h"
+#include "util/logger.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("ITunesXmlImporter");
+
+const QString kDict = "dict";
+const QString kKey = "key";
+const QString kTrackId = "Track ID";
+const QString kName = "Name";
+const QString kArtist = "Artist";
+const QString kAlbum = "Album";
+const QString kAlbumArtist = "Album Artist";
+const QString kGenre = "Genre";
+const QString kGrouping = "Grouping";
+const QString kBPM = "BPM";
+const QString kBitRate = "Bit Rate";
+const QString kComments = "Comments";
+const QString kTotalTime = "Total Time";
+const QString kYear = "Year";
+const QString kLocation = "Location";
+const QString kTrackNumber = "Track Number";
+const QString kRating = "Rating";
+const QString kTrackType = "Track Type";
+const QString kRemote = "Remote";
+
+} // anonymous namespace
+
+ITunesXmlImporter::ITunesXmlImporter(
+        const QString& xmlFilePath,
+        mixxx::DbConnectionPoolPtr pDbConnectionPool,
+        const std::atomic<bool>& cancelImport,
+        PlaylistItemsCallback playlistItemsCallback,
+        ImportBatchWriter::ProgressCallback progressCallback)
+        : m_xmlFilePath(xmlFilePath),
+          m_pDbConnectionPool(pDbConnectionPool),
+          m_cancelImport(cancelImport),
+          m_playlistItemsCallback(std::move(playlistItemsCallback)),
+          m_writer(std::move(pDbConnectionPool), std::move(progressCallback)) {
+    m_libraryTableId = m_writer.addTable("itunes_library",
+            QStringList{
+                    "id",
+                    "artist",
+                    "title",
+                    "album",
+                    "album_artist",
+                    "year",
+                    "genre",
+                    "grouping",
+                    "comment",
+                    "tracknumber",
+                    "bpm",
+                    "bitrate",
+                    "duration",
+                    "location",
+                    "rating"});
+    m_playlistsTableId = m_writer.addTable("itunes_playlists",
+            QStringList{"id", "name"});
+    m_playlistTracksTableId = m_writer.addTable("itunes_playlist_tracks",
+            QStringList{"playlist_id", "track_id", "position"});
+}
+
+//static
+QString ITunesXmlImporter::localhostToken() {
+#if defined(__WINDOWS__)
+    return "//localhost/";
+#else
+    return "//localhost";
+#endif
+}
+
+void ITunesXmlImporter::guessMusicLibraryMountpoint(QXmlStreamReader& xml) {
+    // Normally the Folder Layout it some thing like that
+    // iTunes/
+    // iTunes/Album Artwork
+    // iTunes/iTunes Media <- this is the "Music Folder"
+    // iTunes/iTunes Music Library.xml <- this location we already knew
+    QString music_folder = QUrl(xml.readElementText()).toLocalFile();
+
+    QString music_folder_test = music_folder;
+    music_folder_test.replace(localhostToken(), "");
+    QDir music_folder_dir(music_folder_test);
+
+    // The music folder exists, so a simple transformation
+    // of replacing localhost token with nothing will work.
+    if (music_folder_dir.exists()) {
+        // Leave defaults intact.
+        return;
+    }
+
+    // The iTunes Music Library doesn't exist! This means we are likely loading
+    // the library from a system that is different from the one that wrote the
+    // iTunes configuration. The configuration file path, m_xmlFilePath is a
+    // readable location that in most situation is "close" to the music library
+    // path so since we can read that file we will try to infer the music
+    // library mount point from it.
+
+    // Examples:
+
+    // Windows with non-itunes-managed music:
+    // m_xmlFilePath: c:/Users/LegacyII/Music/iTunes/iTunes Music Library.xml
+    // Music Folder: file://localhost/C:/Users/LegacyII/Music/
+    // Transformation:  "//localhost/" -> ""
+
+    // Mac OS X with iTunes-managed music:
+    // m_xmlFilePath: /Users/rjryan/Music/iTunes/iTunes Music Library.xml
+    // Music Folder: file://localhost/Users/rjryan/Music/iTunes/iTunes Media/
+    // Transformation: "//localhost" -> ""
+
+    // Linux reading an OS X partition mounted at /media/foo to an
+    // iTunes-managed music folder:
+    // m_xmlFilePath: /media/foo/Users/rjryan/Music/iTunes/iTunes Music Library.xml
+    // Music Folder: file://localhost/Users/rjryan/Music/iTunes/iTunes Media/
+    // Transformation: "//localhost" -> "/media/foo"
+
+    // Linux reading a Windows partition mounted at /media/foo to an
+    // non-itunes-managed music folder:
+    // m_xmlFilePath: /media/foo/Users/LegacyII/Music/iTunes/iTunes Music Library.xml
+    // Music Folder: file://localhost/C:/Users/LegacyII/Music/
+    // Transformation:  "//localhost/C:" -> "/media/foo"
+
+    // Algorithm:
+    // 1. Find the largest common subsequence shared between m_xmlFilePath and
+    //    "Music Folder"
+    // 2. For all tracks, replace the left-side of of the LCS in "Music Folder"
+    //    with the left-side of the LCS in m_xmlFilePath.
+
+    QString lcs = LCS(m_xmlFilePath, music_folder);
+
+    if (lcs.size() <= 1) {
+        qDebug() << "ERROR: Couldn't find a suitable transformation to load iTunes data files. Leaving defaults intact.";
+    }
+
+    int musicFolderLcsIndex = music_folder.indexOf(lcs);
+    if (musicFolderLcsIndex < 0) {
+        qDebug() << "ERROR: Detected LCS" << lcs
+                 << "is not present in music_folder:" << music_folder;
+        return;
+    }
+
+    int dbfileLcsIndex = m_xmlFilePath.indexOf(lcs);
+    if (dbfileLcsIndex < 0) {
+        qDebug() << "ERROR: Detected LCS" << lcs
+                 << "is not present in m_xmlFilePath" << m_xmlFilePath;
+        return;
+    }
+
+    m_dbItunesRoot = music_folder.left(musicFolderLcsIndex);
+    m_mixxxItunesRoot = m_xmlFilePath.left(dbfileLcsIndex);
+    qDebug() << "Detected translation rule for iTunes files:"
+             << m_dbItunesRoot << "->" << m_mixxxItunesRoot;
+}
+
+bool ITunesXmlImporter::importLibrary() {
+    bool isTracksParsed = false;
+    bool isMusicFolderLocatedAfterTracks = false;
+
+    PerformanceTimer timer;
+    timer.start();
+
+    // By default set m_mixxxItunesRoot and m_dbItunesRoot to strip out
+    // file://localhost/ from the URL. When we load the user's iTunes XML
+    // configuration we may replace this with something based on the detected
+    // location of the user's iTunes path but the defaults are necessary in case
+    // their iTunes XML does not include the "Music Folder" key.
+    m_mixxxItunesRoot = "";
+    m_dbItunesRoot = localhostToken();
+
+    //Parse iTunes XML file using SAX (for performance)
+    QFile itunes_file(m_xmlFilePath);
+    if (!itunes_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open iTunes music collection";
+        return false;
+    }
+
+    QXmlStreamReader xml(&itunes_file);
+    while (!xml.atEnd() && !m_cancelImport) {
+        xml.readNext();
+        if (xml.isStartElement()) {
+            if (xml.name() == kKey) {
+                QString key = xml.readElementText();
+                if (key == "Music Folder") {
+                    if (isTracksParsed) isMusicFolderLocatedAfterTracks = true;
+                    if (readNextStartElement(xml)) {
+                        guessMusicLibraryMountpoint(xml);
+                    }
+                } else if (key == "Tracks") {
+                    parseTracks(xml);
+                    parsePlaylists(xml);
+                    isTracksParsed = true;
+                }
+            }
+        }
+    }
+
+    itunes_file.close();
+    flushPlaylistItems();
+
+    // Even if an error occurred, commit the transaction. The file may have been
+    // half-parsed.
+    bool success = m_writer.finish();
+
+    if (isMusicFolderLocatedAfterTracks) {
+        success = updateMusicFolder() && success;
+    }
+
+    if (xml.hasError()) {
+        // do error handling
+        qDebug() << "Abort processing iTunes music collection";
+        qDebug() << "line:" << xml.lineNumber() <<
+                "column:" << xml.columnNumber() <<
+                "error:" << xml.errorString();
+        success = false;
+    }
+
+    kLogger.info()
+            << "Imported" << m_writer.rowCount() << "rows from"
+            << m_xmlFilePath << "in"
+            << timer.elapsed().formatMillisWithUnit();
+    return success && !m_cancelImport;
+}
+
+bool ITunesXmlImporter::updateMusicFolder() {
+    qDebug() << "Updating iTunes real path from " << m_dbItunesRoot << " to " << m_mixxxItunesRoot;
+    // In some iTunes files "Music Folder" XML node is located at the end of
+    // file, i.e. after all tracks have already been written
+    QSqlQuery query(mixxx::DbConnectionPooled(m_pDbConnectionPool));
+    query.prepare("UPDATE itunes_library SET location = replace( location, :itunes_path, :mixxx_path )");
+    query.bindValue(":itunes_path", m_dbItunesRoot.replace(localhostToken(), ""));
+    query.bindValue(":mixxx_path", m_mixxxItunesRoot);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return true;
+}
+
+void ITunesXmlImporter::parseTracks(QXmlStreamReader& xml) {
+    bool in_container_dictionary = false;
+    bool in_track_dictionary = false;
+
+    qDebug() << "Parse iTunes music collection";
+
+    // read all sunsequent <dict> until we reach the closing ENTRY tag
+    while (!xml.atEnd() && !m_cancelImport) {
+        xml.readNext();
+
+        if (xml.isStartElement()) {
+            if (xml.name() == kDict) {
+                if (!in_track_dictionary && !in_container_dictionary) {
+                    in_container_dictionary = true;
+                    continue;
+                } else if (in_container_dictionary && !in_track_dictionary) {
+                    // We are in a <dict> tag that holds track information
+                    in_track_dictionary = true;
+                    // Parse track here
+                    parseTrack(xml);
+                }
+            }
+        }
+
+        if (xml.isEndElement() && xml.name() == kDict) {
+            if (in_track_dictionary && in_container_dictionary) {
+                in_track_dictionary = false;
+                continue;
+            } else if (in_container_dictionary && !in_track_dictionary) {
+                // Done parsing tracks.
+                in_container_dictionary = false;
+                break;
+            }
+        }
+    }
+}
+
+void ITunesXmlImporter::parseTrack(QXmlStreamReader& xml) {
+    //qDebug() << "----------------TRACK-----------------";
+    int id = -1;
+    QString title;
+    QString artist;
+    QString album;
+    QString album_artist;
+    QString year;
+    QString genre;
+    QString grouping;
+    QString location;
+
+    int bpm = 0;
+    int bitrate = 0;
+
+    //duration of a track
+    int playtime = 0;
+    int rating = 0;
+    QString comment;
+    QString tracknumber;
+    QString tracktype;
+
+    while (!xml.atEnd()) {
+        xml.readNext();
+
+        if (xml.isStartElement()) {
+            if (xml.name() == kKey) {
+                QString key = xml.readElementText();
+
+                QString content;
+                if (readNextStartElement(xml)) {
+                    content = xml.readElementText();
+                }
+
+                //qDebug() << "Key: " << key << " Content: " << content;
+
+                if (key == kTrackId) {
+                    id = content.toInt();
+                    continue;
+                }
+                if (key == kName) {
+                    title = content;
+                    continue;
+                }
+                if (key == kArtist) {
+                    artist = content;
+                    continue;
+                }
+                if (key == kAlbum) {
+                    album = content;
+                    continue;
+                }
+                if (key == kAlbumArtist) {
+                    album_artist = content;
+                    continue;
+                }
+                if (key == kGenre) {
+                    genre = content;
+                    continue;
+                }
+                if (key == kGrouping) {
+                    grouping = content;
+                    continue;
+                }
+                if (key == kBPM) {
+                    bpm = content.toInt();
+                    continue;
+                }
+                if (key == kBitRate) {
+                    bitrate =  content.toInt();
+                    continue;
+                }
+                if (key == kComments) {
+                    comment = content;
+                    continue;
+                }
+                if (key == kTotalTime) {
+                    playtime = (content.toInt() / 1000);
+                    continue;
+                }
+                if (key == kYear) {
+                    year = content;
+                    continue;
+                }
+                if (key == kLocation) {
+                    location = TrackFile::fromUrl(QUrl(content)).location();
+                    // Replace first part of location with the mixxx iTunes Root
+                    // on systems where iTunes installed it only strips //localhost
+                    // on iTunes from foreign systems the mount point is replaced
+                    if (!m_dbItunesRoot.isEmpty()) {
+                        location.replace(m_dbItunesRoot, m_mixxxItunesRoot);
+                    }
+                    continue;
+                }
+                if (key == kTrackNumber) {
+                    tracknumber = content;
+                    continue;
+                }
+                if (key == kRating) {
+                    //value is an integer and ranges from 0 to 100
+                    rating = (content.toInt() / 20);
+                    continue;
+                }
+                if (key == kTrackType) {
+                    tracktype = content;
+                    continue;
+                }
+            }
+        }
+        //exit loop on closing </dict>
+        if (xml.isEndElement() && xml.name() == kDict) {
+            break;
+        }
+    }
+
+    // If file is a remote file from iTunes Match, don't save it to the database.
+    // There's no way that mixxx can access it.
+    if (tracktype == kRemote) {
+        return;
+    }
+
+    // If we reach the end of <dict>
+    // Save parsed track to database
+    m_writer.addRow(m_libraryTableId,
+            QVariantList{
+                    id,
+                    artist,
+                    title,
+                    album,
+                    album_artist,
+                    year,
+                    genre,
+                    grouping,
+                    comment,
+                    tracknumber,
+                    bpm,
+                    bitrate,
+                    playtime,
+                    location,
+                    rating});
+}
+
+void ITunesXmlImporter::parsePlaylists(QXmlStreamReader& xml) {
+    qDebug() << "Parse iTunes playlists";
+    while (!xml.atEnd() && !m_cancelImport) {
+        xml.readNext();
+        //We process and iterate the <dict> tags holding playlist summary information here
+        if (xml.isStartElement() && xml.name() == kDict) {
+            parsePlaylist(xml);
+            continue;
+        }
+        if (xml.isEndElement()) {
+            if (xml.name() == "array")
+                break;
+        }
+    }
+}
+
+//static
+bool ITunesXmlImporter::readNextStartElement(QXmlStreamReader& xml) {
+    QXmlStreamReader::TokenType token = QXmlStreamReader::NoToken;
+    while (token != QXmlStreamReader::EndDocument && token != QXmlStreamReader::Invalid) {
+        token = xml.readNext();
+        if (token == QXmlStreamReader::StartElement) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ITunesXmlImporter::parsePlaylist(QXmlStreamReader& xml) {
+    //qDebug() << "Parse Playlist";
+
+    QString playlistname;
+    int playlist_id = -1;
+    int playlist_position = -1;
+    int track_reference = -1;
+    //indicates that we haven't found the <
+    bool isSystemPlaylist = false;
+    bool isPlaylistItemsStarted = false;
+
+    //We process and iterate the <dict> tags holding playlist summary information here
+    while (!xml.atEnd() && !m_cancelImport) {
+        xml.readNext();
+
+        if (xml.isStartElement()) {
+
+            if (xml.name() == kKey) {
+                QString key = xml.readElementText();
+                // The rules are processed in sequence
+                // That is, XML is ordered.
+                // For iTunes Playlist names are always followed by the ID.
+                // Afterwars the playlist entries occur
+                if (key == "Name") {
+                    readNextStartElement(xml);
+                    playlistname = xml.readElementText();
+                    continue;
+                }
+                //When parsing the ID, the playlistname has already been found
+                if (key == "Playlist ID") {
+                    readNextStartElement(xml);
+                    playlist_id = xml.readElementText().toInt();
+                    playlist_position = 1;
+                    continue;
+                }
+                //Hide playlists that are system playlists
+                if (key == "Master" || key == "Movies" || key == "TV Shows" ||
+                    key == "Music" || key == "Books" || key == "Purchased") {
+                    isSystemPlaylist = true;
+                    continue;
+                }
+
+                if (key == "Playlist Items") {
+                    isPlaylistItemsStarted = true;
+
+                    //if the playlist is prebuild don't hit the database
+                    if (isSystemPlaylist) continue;
+
+                    // Playlist names are unique in the database. The rows
+                    // are written asynchronously, so duplicates are detected
+                    // here instead of handling the constraint violation.
+                    if (m_playlistNames.contains(playlistname)) {
+                        playlistname += QString(" #%1").arg(playlist_id);
+                    }
+                    m_playlistNames.insert(playlistname);
+                    m_writer.addRow(m_playlistsTableId,
+                            QVariantList{playlist_id, playlistname});
+
+                    //append the playlist to the child model
+                    addPlaylistItem(playlistname);
+                }
+                // When processing playlist entries, playlist name and id have
+                // already been processed and persisted
+                if (key == kTrackId) {
+
+                    readNextStartElement(xml);
+                    track_reference = xml.readElementText().toInt();
+
+                    //Insert tracks if we are not in a pre-build playlist
+                    if (!isSystemPlaylist) {
+                        m_writer.addRow(m_playlistTracksTableId,
+                                QVariantList{
+                                        playlist_id,
+                                        track_reference,
+                                        playlist_position++});
+                    }
+                }
+            }
+        }
+        if (xml.isEndElement()) {
+            if (xml.name() == "array") {
+                //qDebug() << "exit playlist";
+                break;
+            }
+            if (xml.name() == kDict && !isPlaylistItemsStarted){
+                // Some playlists can be empty, so we need to exit.
+                break;
+            }
+        }
+    }
+}
+
+void ITunesXmlImporter::addPlaylistItem(const QString& playlistName) {
+    if (!m_playlistItemsCallback) {
+        return;
+    }
+    m_playlistItems.append(new TreeItem(playlistName));
+    if (m_playlistItems.size() >= kPlaylistItemsPerChunk) {
+        flushPlaylistItems();
+    }
+}
+
+void ITunesXmlImporter::flushPlaylistItems() {
+    if (m_playlistItems.isEmpty()) {
+        return;
+    }
+    QList<TreeItem*> items;
+    items.swap(m_playlistItems);
+    m_playlistItemsCallback(items);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QXmlStreamReader>
+#include <atomic>
+#include <functional>
+
+#include "library/importbatchwriter.h"
+#include "util/db/dbconnectionpool.h"
+
+class TreeItem;
+
+// Parses an iTunes Music Library.xml file into the tables of the
+// iTunes feature.
+//
+// The XML file is parsed on the calling thread while the rows are
+// written in batches by an ImportBatchWriter on a second thread.
+// The tables must have been cleared before.
+class ITunesXmlImporter final {
+  public:
+    // Receives the sidebar items of the playlists in the order they
+    // have been parsed. The ownership of the items is transferred to
+    // the callback.
+    typedef std::function<void(QList<TreeItem*> items)> PlaylistItemsCallback;
+
+    // Sidebar items are passed to the callback in chunks of this size
+    static constexpr int kPlaylistItemsPerChunk = 64;
+
+    ITunesXmlImporter(
+            const QString& xmlFilePath,
+            mixxx::DbConnectionPoolPtr pDbConnectionPool,
+            const std::atomic<bool>& cancelImport,
+            PlaylistItemsCallback playlistItemsCallback = PlaylistItemsCallback(),
+            ImportBatchWriter::ProgressCallback progressCallback =
+                    ImportBatchWriter::ProgressCallback());
+
+    // Returns false if the file could not be imported completely
+    bool importLibrary();
+
+    static QString localhostToken();
+
+  private:
+    void guessMusicLibraryMountpoint(QXmlStreamReader& xml);
+    void parseTracks(QXmlStreamReader& xml);
+    void parseTrack(QXmlStreamReader& xml);
+    void parsePlaylists(QXmlStreamReader& xml);
+    void parsePlaylist(QXmlStreamReader& xml);
+    void addPlaylistItem(const QString& playlistName);
+    void flushPlaylistItems();
+    bool updateMusicFolder();
+    static bool readNextStartElement(QXmlStreamReader& xml);
+
+    const QString m_xmlFilePath;
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const std::atomic<bool>& m_cancelImport;
+    const PlaylistItemsCallback m_playlistItemsCallback;
+
+    ImportBatchWriter m_writer;
+    int m_libraryTableId;
+    int m_playlistsTableId;
+    int m_playlistTracksTableId;
+
+    QString m_dbItunesRoot;
+    QString m_mixxxItunesRoot;
+
+    QSet<QString> m_playlistNames;
+    QList<TreeItem*> m_playlistItems;
+};
@@ -75,7 +75,9 @@ bool MissingTableModel::isColumnInternal(int column) {
             column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_SOURCE) ||
             column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_TYPE) ||
             column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_LOCATION) ||
-            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH)) {
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_COVERART_HASH) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BEATS_SUB_VERSION) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEYS_SUB_VERSION)) {
         return true;
     }
     return false;
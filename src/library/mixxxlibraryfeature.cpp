@@ -64,7 +64,9 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
             << "library." + LIBRARYTABLE_COVERART_SOURCE
             << "library." + LIBRARYTABLE_COVERART_TYPE
             << "library." + LIBRARYTABLE_COVERART_LOCATION
-            << "library." + LIBRARYTABLE_COVERART_HASH;
+            << "library." + LIBRARYTABLE_COVERART_HASH
+            << "library." + LIBRARYTABLE_BEATS_SUB_VERSION
+            << "library." + LIBRARYTABLE_KEYS_SUB_VERSION;
 
     QSqlQuery query(m_pTrackCollection->database());
     QString tableName = "library_cache_view";
@@ -95,6 +97,8 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
 
     // These rely on the 'default' track source being present.
     m_pLibraryTableModel = new LibraryTableModel(this, pLibrary->trackCollections(), "mixxx.db.model.library");
+    m_pLibraryTableModel->setSelectAsync(true);
+    m_pLibraryTableModel->setSkipUnchangedSelects(true);
 
     std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
     pRootItem->appendChild(kMissingTitle);
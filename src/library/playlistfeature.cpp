@@ -43,6 +43,9 @@ PlaylistFeature::PlaylistFeature(
                           "mixxx.db.model.playlist"),
                   QStringLiteral("PLAYLISTHOME")),
           m_icon(QStringLiteral(":/images/library/ic_library_playlist.svg")) {
+    m_pPlaylistTableModel->setSelectAsync(true);
+    m_pPlaylistTableModel->setSkipUnchangedSelects(true);
+
     // construct child model
     std::unique_ptr<TreeItem> pRootItem = TreeItem::newRoot(this);
     m_childModel.setRootItem(std::move(pRootItem));
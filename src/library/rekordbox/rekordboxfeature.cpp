@@ -1,15 +1,18 @@
 // rekordboxfeature.cpp
 // Created 05/24/2019 by Evan Dekker
 
+#include <QDataStream>
 #include <QMap>
 #include <QMessageBox>
 #include <QSettings>
 #include <QStandardPaths>
+#include <QtConcurrentMap>
 #include <QtDebug>
 
 #include "library/rekordbox/rekordbox_anlz.h"
 #include "library/rekordbox/rekordbox_pdb.h"
 #include "library/rekordbox/rekordboxfeature.h"
+#include "library/rekordbox/rekordboxpdbreader.h"
 
 #include <mp3guessenc.h>
 
@@ -29,6 +32,9 @@
 #include "util/db/dbconnectionpooled.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/file.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
 #include "util/sandbox.h"
 #include "waveform/waveform.h"
 
@@ -40,6 +46,8 @@
 
 namespace {
 
+const mixxx::Logger kLogger("RekordboxFeature");
+
 const QString kRekordboxLibraryTable = QStringLiteral("rekordbox_library");
 const QString kRekordboxPlaylistsTable = QStringLiteral("rekordbox_playlists");
 const QString kRekordboxPlaylistTracksTable = QStringLiteral("rekordbox_playlist_tracks");
@@ -48,6 +56,23 @@ const QString kPdbPath = QStringLiteral("PIONEER/rekordbox/export.pdb");
 const QString kPLaylistPathDelimiter = QStringLiteral("-->");
 constexpr double kLongestPosition = 999999999.0;
 
+// The number of tracks that are inserted at once, while the ANLZ files
+// of the next batch are parsed in parallel
+constexpr int kImportBatchSize = 512;
+
+// The number of rows per INSERT statement. SQLite limits the number of
+// bound values of a statement to 999 by default. Divides the batch size
+// so that only the last statement of an import has fewer rows.
+constexpr int kTrackColumnCount = 18;
+constexpr int kTracksPerInsert = 32;
+static_assert(kTrackColumnCount * kTracksPerInsert <= 999,
+        "Too many bound values per statement");
+static_assert(kImportBatchSize % kTracksPerInsert == 0,
+        "Batches are split into full statements");
+
+// Bump when changing the serialized format of pre-parsed ANLZ files
+constexpr quint8 kAnalysisFormatVersion = 1;
+
 enum class TrackColor : uint8_t {
     Pink = 1,
     Red,
@@ -98,7 +123,8 @@ bool createLibraryTable(QSqlDatabase& database, const QString& tableName) {
             "    rating INTEGER,"
             "    analyze_path TEXT UNIQUE,"
             "    device TEXT,"
-            "    color INTEGER"
+            "    color INTEGER,"
+            "    analysis BLOB"
             ");");
 
     if (!query.exec()) {
@@ -287,6 +313,195 @@ QString getText(rekordbox_pdb_t::device_sql_string_t* deviceString) {
     return text.remove(QChar('\x0'));
 }
 
+// The beat grid and cues of a single ANLZ file. Times are in milliseconds
+// and do not account for the timing offset of the decoder yet, which is
+// only known when loading the track.
+struct anlz_cue_t {
+    int listType;
+    int entryType;
+    int hotCueIndex;
+    int time;
+    int loopTime;
+    QString comment;
+    mixxx::RgbColor::optional_t color;
+};
+
+struct anlz_data_t {
+    QVector<int> beatTimes;
+    QVector<anlz_cue_t> cues;
+};
+
+mixxx::RgbColor::optional_t readCueColor(rekordbox_anlz_t::cue_extended_entry_t* cueExtendedEntry) {
+    return mixxx::RgbColor(qRgb(
+            static_cast<int>(cueExtendedEntry->color_red()),
+            static_cast<int>(cueExtendedEntry->color_green()),
+            static_cast<int>(cueExtendedEntry->color_blue())));
+}
+
+// This function is executed on the worker threads of the import and
+// when loading tracks that have not been analyzed during the import.
+anlz_data_t parseAnalyze(const QString& anlzPath, bool ignoreBeatsAndLegacyCues) {
+    anlz_data_t data;
+    if (!QFile(anlzPath).exists()) {
+        return data;
+    }
+
+    std::ifstream ifs(anlzPath.toStdString(), std::ifstream::binary);
+    kaitai::kstream ks(&ifs);
+
+    try {
+        rekordbox_anlz_t anlz = rekordbox_anlz_t(&ks);
+
+        for (auto* section : *anlz.sections()) {
+            switch (section->fourcc()) {
+            case rekordbox_anlz_t::SECTION_TAGS_BEAT_GRID: {
+                if (ignoreBeatsAndLegacyCues) {
+                    break;
+                }
+
+                rekordbox_anlz_t::beat_grid_tag_t* beatGridTag = static_cast<rekordbox_anlz_t::beat_grid_tag_t*>(section->body());
+
+                data.beatTimes.clear();
+                data.beatTimes.reserve(static_cast<int>(beatGridTag->beats()->size()));
+                for (auto* beat : *beatGridTag->beats()) {
+                    data.beatTimes << static_cast<int>(beat->time());
+                }
+            } break;
+            case rekordbox_anlz_t::SECTION_TAGS_CUES: {
+                if (ignoreBeatsAndLegacyCues) {
+                    break;
+                }
+
+                rekordbox_anlz_t::cue_tag_t* cuesTag = static_cast<rekordbox_anlz_t::cue_tag_t*>(section->body());
+
+                for (auto* cueEntry : *cuesTag->cues()) {
+                    anlz_cue_t cue;
+                    cue.listType = cuesTag->type();
+                    cue.entryType = cueEntry->type();
+                    cue.hotCueIndex = static_cast<int>(cueEntry->hot_cue() - 1);
+                    cue.time = static_cast<int>(cueEntry->time());
+                    cue.loopTime = static_cast<int>(cueEntry->loop_time());
+                    cue.color = mixxx::RgbColor::nullopt();
+                    data.cues << cue;
+                }
+            } break;
+            case rekordbox_anlz_t::SECTION_TAGS_CUES_2: {
+                rekordbox_anlz_t::cue_extended_tag_t* cuesExtendedTag = static_cast<rekordbox_anlz_t::cue_extended_tag_t*>(section->body());
+
+                for (auto* cueExtendedEntry : *cuesExtendedTag->cues()) {
+                    anlz_cue_t cue;
+                    cue.listType = cuesExtendedTag->type();
+                    cue.entryType = cueExtendedEntry->type();
+                    cue.hotCueIndex = static_cast<int>(cueExtendedEntry->hot_cue() - 1);
+                    cue.time = static_cast<int>(cueExtendedEntry->time());
+                    cue.loopTime = static_cast<int>(cueExtendedEntry->loop_time());
+                    cue.comment = toUnicode(cueExtendedEntry->comment());
+                    cue.color = readCueColor(cueExtendedEntry);
+                    data.cues << cue;
+                }
+            } break;
+            default:
+                break;
+            }
+        }
+    } catch (const std::exception& e) {
+        kLogger.warning() << "Failed to parse Rekordbox ANLZ file" << anlzPath << ":" << e.what();
+        return anlz_data_t();
+    }
+
+    return data;
+}
+
+void writeAnlzData(QDataStream& out, const anlz_data_t& data) {
+    // Beat times are stored as differences to the previous beat that
+    // compress well
+    out << static_cast<qint32>(data.beatTimes.size());
+    int previousTime = 0;
+    for (int time : data.beatTimes) {
+        out << static_cast<qint32>(time - previousTime);
+        previousTime = time;
+    }
+    out << static_cast<qint32>(data.cues.size());
+    for (const anlz_cue_t& cue : data.cues) {
+        out << static_cast<qint8>(cue.listType)
+            << static_cast<qint8>(cue.entryType)
+            << static_cast<qint32>(cue.hotCueIndex)
+            << static_cast<qint32>(cue.time)
+            << static_cast<qint32>(cue.loopTime)
+            << cue.comment
+            << static_cast<bool>(cue.color)
+            << static_cast<quint32>(cue.color ? *cue.color : 0);
+    }
+}
+
+bool readAnlzData(QDataStream& in, anlz_data_t* pData) {
+    qint32 beatCount = 0;
+    in >> beatCount;
+    if (beatCount < 0) {
+        return false;
+    }
+    pData->beatTimes.reserve(beatCount);
+    int time = 0;
+    for (qint32 i = 0; i < beatCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 timeDiff;
+        in >> timeDiff;
+        time += timeDiff;
+        pData->beatTimes << time;
+    }
+    qint32 cueCount = 0;
+    in >> cueCount;
+    if (cueCount < 0) {
+        return false;
+    }
+    for (qint32 i = 0; i < cueCount && in.status() == QDataStream::Ok; ++i) {
+        qint8 listType;
+        qint8 entryType;
+        qint32 hotCueIndex;
+        qint32 cueTime;
+        qint32 loopTime;
+        bool hasColor;
+        quint32 color;
+        anlz_cue_t cue;
+        in >> listType >> entryType >> hotCueIndex >> cueTime >> loopTime >> cue.comment >> hasColor >> color;
+        cue.listType = listType;
+        cue.entryType = entryType;
+        cue.hotCueIndex = hotCueIndex;
+        cue.time = cueTime;
+        cue.loopTime = loopTime;
+        cue.color = hasColor ? mixxx::RgbColor::optional(color) : mixxx::RgbColor::nullopt();
+        pData->cues << cue;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+// Both the .DAT and the .EXT file of a track are parsed during the import
+// and stored compressed in the analysis column, so loading the track does
+// not need to read them from the device again.
+QByteArray serializeAnalysis(const anlz_data_t& datData, const anlz_data_t& extData) {
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << kAnalysisFormatVersion;
+    writeAnlzData(out, datData);
+    writeAnlzData(out, extData);
+    return qCompress(bytes);
+}
+
+bool deserializeAnalysis(const QByteArray& analysis, anlz_data_t* pDatData, anlz_data_t* pExtData) {
+    if (analysis.isEmpty()) {
+        return false;
+    }
+    const QByteArray bytes = qUncompress(analysis);
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint8 version = 0;
+    in >> version;
+    if (version != kAnalysisFormatVersion) {
+        return false;
+    }
+    return readAnlzData(in, pDatData) && readAnlzData(in, pExtData);
+}
+
 int createDevicePlaylist(QSqlDatabase& database, QString devicePath) {
     int playlistID = -1;
 
@@ -304,128 +519,279 @@ int createDevicePlaylist(QSqlDatabase& database, QString devicePath) {
         return playlistID;
     }
 
-    QSqlQuery idQuery(database);
-    idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-    idQuery.bindValue(":path", devicePath);
-
-    if (!idQuery.exec()) {
-        LOG_FAILED_QUERY(idQuery)
-                << "devicePath: " << devicePath;
-        return playlistID;
-    }
-
-    while (idQuery.next()) {
-        playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-    }
+    playlistID = queryInsertIntoDevicePlaylist.lastInsertId().toInt();
 
     return playlistID;
 }
 
-void insertTrack(
-        QSqlDatabase& database,
-        rekordbox_pdb_t::track_row_t* track,
-        QSqlQuery& query,
-        QSqlQuery& queryInsertIntoDevicePlaylistTracks,
-        QMap<uint32_t, QString>& artistsMap,
-        QMap<uint32_t, QString>& albumsMap,
-        QMap<uint32_t, QString>& genresMap,
-        QMap<uint32_t, QString>& keysMap,
-        QString devicePath,
-        QString device,
-        int audioFilesCount) {
-    int rbID = static_cast<int>(track->id());
-    QString title = getText(track->title());
-    QString artist = artistsMap[track->artist_id()];
-    QString album = albumsMap[track->album_id()];
-    QString year = QString::number(track->year());
-    QString genre = genresMap[track->genre_id()];
-    QString location = devicePath + getText(track->file_path());
-    float bpm = static_cast<float>(track->tempo() / 100.0);
-    int bitrate = static_cast<int>(track->bitrate());
-    QString key = keysMap[track->key_id()];
-    int playtime = static_cast<int>(track->duration());
-    int rating = static_cast<int>(track->rating());
-    QString comment = getText(track->comment());
-    QString tracknumber = QString::number(track->track_number());
-    QString anlzPath = devicePath + getText(track->analyze_path());
-    mixxx::RgbColor::optional_t color = mixxx::RgbColor::nullopt();
-
-    switch (static_cast<TrackColor>(track->color_id())) {
+// A track row of the PDB file with all references resolved, which can
+// outlive the page it has been read from.
+struct track_t {
+    uint32_t rbID;
+    QString title;
+    QString artist;
+    QString album;
+    QString year;
+    QString genre;
+    QString location;
+    float bpm;
+    int bitrate;
+    QString key;
+    int playtime;
+    int rating;
+    QString comment;
+    QString tracknumber;
+    QString anlzPath;
+    mixxx::RgbColor::optional_t color;
+    QByteArray analysis;
+};
+
+track_t readTrack(
+        rekordbox_pdb_t::track_row_t* trackRow,
+        const QMap<uint32_t, QString>& artistsMap,
+        const QMap<uint32_t, QString>& albumsMap,
+        const QMap<uint32_t, QString>& genresMap,
+        const QMap<uint32_t, QString>& keysMap,
+        const QString& devicePath) {
+    track_t track;
+    track.rbID = trackRow->id();
+    track.title = getText(trackRow->title());
+    track.artist = artistsMap.value(trackRow->artist_id());
+    track.album = albumsMap.value(trackRow->album_id());
+    track.year = QString::number(trackRow->year());
+    track.genre = genresMap.value(trackRow->genre_id());
+    track.location = devicePath + getText(trackRow->file_path());
+    track.bpm = static_cast<float>(trackRow->tempo() / 100.0);
+    track.bitrate = static_cast<int>(trackRow->bitrate());
+    track.key = keysMap.value(trackRow->key_id());
+    track.playtime = static_cast<int>(trackRow->duration());
+    track.rating = static_cast<int>(trackRow->rating());
+    track.comment = getText(trackRow->comment());
+    track.tracknumber = QString::number(trackRow->track_number());
+    track.anlzPath = devicePath + getText(trackRow->analyze_path());
+    track.color = mixxx::RgbColor::nullopt();
+
+    switch (static_cast<TrackColor>(trackRow->color_id())) {
     case TrackColor::Pink:
-        color = kTrackColorPink;
+        track.color = kTrackColorPink;
         break;
     case TrackColor::Red:
-        color = kTrackColorRed;
+        track.color = kTrackColorRed;
         break;
     case TrackColor::Orange:
-        color = kTrackColorOrange;
+        track.color = kTrackColorOrange;
         break;
     case TrackColor::Yellow:
-        color = kTrackColorYellow;
+        track.color = kTrackColorYellow;
         break;
     case TrackColor::Green:
-        color = kTrackColorGreen;
+        track.color = kTrackColorGreen;
         break;
     case TrackColor::Aqua:
-        color = kTrackColorAqua;
+        track.color = kTrackColorAqua;
         break;
     case TrackColor::Blue:
-        color = kTrackColorBlue;
+        track.color = kTrackColorBlue;
         break;
     case TrackColor::Purple:
-        color = kTrackColorPurple;
+        track.color = kTrackColorPurple;
         break;
     default:
         break;
     }
 
-    query.bindValue(":rb_id", rbID);
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":key", key);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-    query.bindValue(":analyze_path", anlzPath);
-    query.bindValue(":device", device);
-    query.bindValue(":color", mixxx::RgbColor::toQVariant(color));
+    return track;
+}
 
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+// Returns an INSERT statement with positional placeholders for the
+// given number of rows
+QString insertRowsStatement(
+        const QString& tableName,
+        const QString& columns,
+        int columnCount,
+        int rowCount) {
+    QStringList placeholders;
+    for (int i = 0; i < columnCount; ++i) {
+        placeholders.append(QStringLiteral("?"));
+    }
+    const QString row = QStringLiteral("(") + placeholders.join(',') + QStringLiteral(")");
+    QStringList rows;
+    for (int i = 0; i < rowCount; ++i) {
+        rows.append(row);
     }
+    return "INSERT INTO " + tableName + " (" + columns + ") VALUES " + rows.join(',');
+}
 
-    int trackID = -1;
-    QSqlQuery finderQuery(database);
-    finderQuery.prepare("select id from " + kRekordboxLibraryTable + " where rb_id=:rb_id and device=:device");
-    finderQuery.bindValue(":rb_id", rbID);
-    finderQuery.bindValue(":device", device);
-
-    if (!finderQuery.exec()) {
-        LOG_FAILED_QUERY(finderQuery)
-                << "rbID:" << rbID;
+// Inserts the tracks of a device in batches with multi-row statements
+// that are prepared once. The ANLZ files of each batch are parsed on the
+// global thread pool while the previous batch is inserted. All rows are
+// inserted in the transaction of the caller and only become visible when
+// it is committed.
+class TrackImporter {
+  public:
+    TrackImporter(QSqlDatabase& database, int playlistID, const QString& device)
+            : m_database(database),
+              m_playlistID(playlistID),
+              m_device(device),
+              m_trackCount(0) {
+    }
+
+    ~TrackImporter() {
+        DEBUG_ASSERT(m_pendingTracks.isEmpty());
+        // The analyzed tracks must not be destroyed while being parsed
+        m_analysisFuture.waitForFinished();
     }
 
-    if (finderQuery.next()) {
-        trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
+    void addTrack(track_t track) {
+        m_pendingTracks.append(std::move(track));
+        if (m_pendingTracks.size() >= kImportBatchSize) {
+            analyzePendingTracks();
+        }
     }
 
-    // Insert into device all tracks playlist
-    queryInsertIntoDevicePlaylistTracks.bindValue(":track_id", trackID);
-    queryInsertIntoDevicePlaylistTracks.bindValue(":position", audioFilesCount);
+    // Inserts all remaining tracks
+    void finish() {
+        analyzePendingTracks();
+        insertAnalyzedTracks();
+    }
 
-    if (!queryInsertIntoDevicePlaylistTracks.exec()) {
-        LOG_FAILED_QUERY(queryInsertIntoDevicePlaylistTracks)
-                << "trackID:" << trackID
-                << "position:" << audioFilesCount;
+    int trackCount() const {
+        return m_trackCount;
     }
-}
+
+    // Maps the Rekordbox ids to the ids of the inserted tracks
+    const QHash<uint32_t, int>& trackIDs() const {
+        return m_trackIDs;
+    }
+
+  private:
+    void analyzePendingTracks() {
+        insertAnalyzedTracks();
+        if (m_pendingTracks.isEmpty()) {
+            return;
+        }
+        m_analyzedTracks.swap(m_pendingTracks);
+        m_analysisFuture = QtConcurrent::map(m_analyzedTracks, [](track_t& track) {
+            QString anlzPathExt = track.anlzPath.left(track.anlzPath.length() - 3) + "EXT";
+            track.analysis = serializeAnalysis(
+                    parseAnalyze(track.anlzPath, false),
+                    parseAnalyze(anlzPathExt, true));
+        });
+    }
+
+    void insertAnalyzedTracks() {
+        m_analysisFuture.waitForFinished();
+        for (int i = 0; i < m_analyzedTracks.size(); i += kTracksPerInsert) {
+            insertTracks(m_analyzedTracks.constData() + i,
+                    math_min(kTracksPerInsert, m_analyzedTracks.size() - i));
+        }
+        m_analyzedTracks.clear();
+    }
+
+    // The statements for each number of rows are prepared on first use
+    QSqlQuery& insertTracksQuery(int count) {
+        auto it = m_insertTracksQueries.find(count);
+        if (it == m_insertTracksQueries.end()) {
+            it = m_insertTracksQueries.insert(count, QSqlQuery(m_database));
+            it->prepare(insertRowsStatement(
+                    kRekordboxLibraryTable,
+                    "rb_id,artist,title,album,year,genre,comment,tracknumber,"
+                    "bpm,bitrate,duration,location,rating,key,analyze_path,"
+                    "device,color,analysis",
+                    kTrackColumnCount,
+                    count));
+        }
+        return *it;
+    }
+
+    QSqlQuery& insertPlaylistTracksQuery(int count) {
+        auto it = m_insertPlaylistTracksQueries.find(count);
+        if (it == m_insertPlaylistTracksQueries.end()) {
+            it = m_insertPlaylistTracksQueries.insert(count, QSqlQuery(m_database));
+            it->prepare(insertRowsStatement(
+                    kRekordboxPlaylistTracksTable,
+                    "playlist_id,track_id,position",
+                    3,
+                    count));
+        }
+        return *it;
+    }
+
+    void insertTracks(const track_t* pTracks, int count) {
+        QSqlQuery& query = insertTracksQuery(count);
+        for (int i = 0; i < count; ++i) {
+            const track_t& track = pTracks[i];
+            query.addBindValue(track.rbID);
+            query.addBindValue(track.artist);
+            query.addBindValue(track.title);
+            query.addBindValue(track.album);
+            query.addBindValue(track.year);
+            query.addBindValue(track.genre);
+            query.addBindValue(track.comment);
+            query.addBindValue(track.tracknumber);
+            query.addBindValue(track.bpm);
+            query.addBindValue(track.bitrate);
+            query.addBindValue(track.playtime);
+            query.addBindValue(track.location);
+            query.addBindValue(track.rating);
+            query.addBindValue(track.key);
+            query.addBindValue(track.anlzPath);
+            query.addBindValue(m_device);
+            query.addBindValue(mixxx::RgbColor::toQVariant(track.color));
+            query.addBindValue(track.analysis);
+        }
+
+        QVector<int> trackIDs(count, -1);
+        if (query.exec()) {
+            // The ids of the rows of a single statement are consecutive,
+            // because no other connection writes during the transaction
+            const int firstTrackID = query.lastInsertId().toInt() - count + 1;
+            for (int i = 0; i < count; ++i) {
+                trackIDs[i] = firstTrackID + i;
+                m_trackIDs.insert(pTracks[i].rbID, trackIDs[i]);
+            }
+        } else if (count > 1) {
+            // A single invalid track, e.g. with a duplicate location, fails
+            // the whole statement. Insert the tracks one by one to only lose
+            // the invalid ones.
+            for (int i = 0; i < count; ++i) {
+                insertTracks(pTracks + i, 1);
+            }
+            return;
+        } else {
+            LOG_FAILED_QUERY(query)
+                    << "rbID:" << pTracks[0].rbID;
+        }
+
+        // Insert into device all tracks playlist
+        QSqlQuery& playlistTracksQuery = insertPlaylistTracksQuery(count);
+        for (int i = 0; i < count; ++i) {
+            playlistTracksQuery.addBindValue(m_playlistID);
+            playlistTracksQuery.addBindValue(trackIDs[i]);
+            playlistTracksQuery.addBindValue(m_trackCount + i);
+        }
+        if (!playlistTracksQuery.exec()) {
+            LOG_FAILED_QUERY(playlistTracksQuery)
+                    << "positions:" << m_trackCount << "to" << m_trackCount + count - 1;
+        }
+
+        m_trackCount += count;
+    }
+
+    QSqlDatabase m_database;
+    const int m_playlistID;
+    const QString m_device;
+
+    QHash<int, QSqlQuery> m_insertTracksQueries;
+    QHash<int, QSqlQuery> m_insertPlaylistTracksQueries;
+
+    QVector<track_t> m_pendingTracks;
+    QVector<track_t> m_analyzedTracks;
+    QFuture<void> m_analysisFuture;
+
+    int m_trackCount;
+    QHash<uint32_t, int> m_trackIDs;
+};
 
 void buildPlaylistTree(
         QSqlDatabase& database,
@@ -436,7 +802,7 @@ void buildPlaylistTree(
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
         QString playlistPath,
-        QString device);
+        const QHash<uint32_t, int>& trackIDs);
 
 QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* deviceItem) {
     QString device = deviceItem->getLabel();
@@ -466,34 +832,17 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     QThread* thisThread = QThread::currentThread();
     thisThread->setPriority(QThread::LowPriority);
 
-    ScopedTransaction transaction(database);
-
-    QSqlQuery query(database);
-    query.prepare(
-            "INSERT INTO " + kRekordboxLibraryTable +
-            " (rb_id, artist, title, album, year,"
-            "genre,comment,tracknumber,bpm, bitrate,duration, location,"
-            "rating,key,analyze_path,device,color) VALUES (:rb_id, :artist, :title, :album, :year,:genre,"
-            ":comment, :tracknumber,:bpm, :bitrate,:duration, :location,"
-            ":rating,:key,:analyze_path,:device,:color)");
+    PerformanceTimer timer;
+    timer.start();
 
-    int audioFilesCount = 0;
+    ScopedTransaction transaction(database);
 
     // Create a playlist for all the tracks on a device
     int playlistID = createDevicePlaylist(database, devicePath);
 
-    QSqlQuery queryInsertIntoDevicePlaylistTracks(database);
-    queryInsertIntoDevicePlaylistTracks.prepare(
-            "INSERT INTO " + kRekordboxPlaylistTracksTable +
-            " (playlist_id, track_id, position) "
-            "VALUES (:playlist_id, :track_id, :position)");
+    TrackImporter trackImporter(database, playlistID, device);
 
-    queryInsertIntoDevicePlaylistTracks.bindValue(":playlist_id", playlistID);
-
-    std::ifstream ifs(dbPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
-
-    rekordbox_pdb_t reckordboxDB = rekordbox_pdb_t(&ks);
+    RekordboxPdbReader reader(dbPath);
 
     // There are other types of tables (eg. COLOR), these are the only ones we are
     // interested at the moment. Perhaps when/if
@@ -502,18 +851,6 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     // Attempt was made to also recover HISTORY
     // playlists (which are found on removable Rekordbox devices), however
     // they didn't appear to contain valid row_ref_t structures.
-    const int totalTables = 8;
-
-    rekordbox_pdb_t::page_type_t tableOrder[totalTables] = {
-            rekordbox_pdb_t::PAGE_TYPE_KEYS,
-            rekordbox_pdb_t::PAGE_TYPE_GENRES,
-            rekordbox_pdb_t::PAGE_TYPE_ARTISTS,
-            rekordbox_pdb_t::PAGE_TYPE_ALBUMS,
-            rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES,
-            rekordbox_pdb_t::PAGE_TYPE_TRACKS,
-            rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE,
-            rekordbox_pdb_t::PAGE_TYPE_HISTORY};
-
     QMap<uint32_t, QString> keysMap;
     QMap<uint32_t, QString> genresMap;
     QMap<uint32_t, QString> artistsMap;
@@ -523,108 +860,69 @@ QString parseDeviceDB(mixxx::DbConnectionPoolPtr dbConnectionPool, TreeItem* dev
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTreeMap;
     QMap<uint32_t, QMap<uint32_t, uint32_t>> playlistTrackMap;
 
-    bool folderOrPlaylistFound = false;
-
-    for (int tableOrderIndex = 0; tableOrderIndex < totalTables; tableOrderIndex++) {
-        for (
-                std::vector<rekordbox_pdb_t::table_t*>::iterator table = reckordboxDB.tables()->begin();
-                table != reckordboxDB.tables()->end();
-                ++table) {
-            if ((*table)->type() == tableOrder[tableOrderIndex]) {
-                uint16_t lastIndex = (*table)->last_page()->index();
-                rekordbox_pdb_t::page_ref_t* currentRef = (*table)->first_page();
-
-                while (true) {
-                    rekordbox_pdb_t::page_t* page = currentRef->body();
-
-                    if (page->is_data_page()) {
-                        for (
-                                std::vector<rekordbox_pdb_t::row_group_t*>::iterator rowGroup = page->row_groups()->begin();
-                                rowGroup != page->row_groups()->end();
-                                ++rowGroup) {
-                            for (
-                                    std::vector<rekordbox_pdb_t::row_ref_t*>::iterator rowRef = (*rowGroup)->rows()->begin();
-                                    rowRef != (*rowGroup)->rows()->end();
-                                    ++rowRef) {
-                                if ((*rowRef)->present()) {
-                                    switch (tableOrder[tableOrderIndex]) {
-                                    case rekordbox_pdb_t::PAGE_TYPE_KEYS: {
-                                        // Key found, update map
-                                        rekordbox_pdb_t::key_row_t* key =
-                                                static_cast<rekordbox_pdb_t::key_row_t*>((*rowRef)->body());
-                                        keysMap[key->id()] = getText(key->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_GENRES: {
-                                        // Genre found, update map
-                                        rekordbox_pdb_t::genre_row_t* genre =
-                                                static_cast<rekordbox_pdb_t::genre_row_t*>((*rowRef)->body());
-                                        genresMap[genre->id()] = getText(genre->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ARTISTS: {
-                                        // Artist found, update map
-                                        rekordbox_pdb_t::artist_row_t* artist =
-                                                static_cast<rekordbox_pdb_t::artist_row_t*>((*rowRef)->body());
-                                        artistsMap[artist->id()] = getText(artist->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_ALBUMS: {
-                                        // Album found, update map
-                                        rekordbox_pdb_t::album_row_t* album =
-                                                static_cast<rekordbox_pdb_t::album_row_t*>((*rowRef)->body());
-                                        albumsMap[album->id()] = getText(album->name());
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES: {
-                                        // Playlist to track mapping found, update map
-                                        rekordbox_pdb_t::playlist_entry_row_t* playlistEntry =
-                                                static_cast<rekordbox_pdb_t::playlist_entry_row_t*>((*rowRef)->body());
-                                        playlistTrackMap[playlistEntry->playlist_id()][playlistEntry->entry_index()] =
-                                                playlistEntry->track_id();
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_TRACKS: {
-                                        // Track found, insert into database
-                                        insertTrack(
-                                                database, static_cast<rekordbox_pdb_t::track_row_t*>((*rowRef)->body()), query, queryInsertIntoDevicePlaylistTracks, artistsMap, albumsMap, genresMap, keysMap, devicePath, device, audioFilesCount);
-
-                                        audioFilesCount++;
-                                    } break;
-                                    case rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE: {
-                                        // Playlist tree node found, update map
-                                        rekordbox_pdb_t::playlist_tree_row_t* playlistTree =
-                                                static_cast<rekordbox_pdb_t::playlist_tree_row_t*>((*rowRef)->body());
-
-                                        playlistNameMap[playlistTree->id()] = getText(playlistTree->name());
-                                        playlistIsFolderMap[playlistTree->id()] = playlistTree->is_folder();
-                                        playlistTreeMap[playlistTree->parent_id()][playlistTree->sort_order()] = playlistTree->id();
-
-                                        folderOrPlaylistFound = true;
-                                    } break;
-                                    default:
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    if (currentRef->index() == lastIndex) {
-                        break;
-                    } else {
-                        currentRef = page->next_page();
-                    }
-                }
-            }
-        }
-    }
+    // The tracks refer to the rows of the preceding tables
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_KEYS, [&keysMap](kaitai::kstruct* row) {
+        // Key found, update map
+        auto* key = static_cast<rekordbox_pdb_t::key_row_t*>(row);
+        keysMap[key->id()] = getText(key->name());
+    });
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_GENRES, [&genresMap](kaitai::kstruct* row) {
+        // Genre found, update map
+        auto* genre = static_cast<rekordbox_pdb_t::genre_row_t*>(row);
+        genresMap[genre->id()] = getText(genre->name());
+    });
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_ARTISTS, [&artistsMap](kaitai::kstruct* row) {
+        // Artist found, update map
+        auto* artist = static_cast<rekordbox_pdb_t::artist_row_t*>(row);
+        artistsMap[artist->id()] = getText(artist->name());
+    });
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_ALBUMS, [&albumsMap](kaitai::kstruct* row) {
+        // Album found, update map
+        auto* album = static_cast<rekordbox_pdb_t::album_row_t*>(row);
+        albumsMap[album->id()] = getText(album->name());
+    });
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_ENTRIES, [&playlistTrackMap](kaitai::kstruct* row) {
+        // Playlist to track mapping found, update map
+        auto* playlistEntry = static_cast<rekordbox_pdb_t::playlist_entry_row_t*>(row);
+        playlistTrackMap[playlistEntry->playlist_id()][playlistEntry->entry_index()] =
+                playlistEntry->track_id();
+    });
+    reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_TRACKS, [&](kaitai::kstruct* row) {
+        // Track found, insert into database
+        trackImporter.addTrack(readTrack(
+                static_cast<rekordbox_pdb_t::track_row_t*>(row),
+                artistsMap,
+                albumsMap,
+                genresMap,
+                keysMap,
+                devicePath));
+    });
+    trackImporter.finish();
+    const bool folderOrPlaylistFound = reader.visitRows(
+            rekordbox_pdb_t::PAGE_TYPE_PLAYLIST_TREE, [&](kaitai::kstruct* row) {
+                // Playlist tree node found, update map
+                auto* playlistTree = static_cast<rekordbox_pdb_t::playlist_tree_row_t*>(row);
+
+                playlistNameMap[playlistTree->id()] = getText(playlistTree->name());
+                playlistIsFolderMap[playlistTree->id()] = playlistTree->is_folder();
+                playlistTreeMap[playlistTree->parent_id()][playlistTree->sort_order()] = playlistTree->id();
+            }) > 0;
+
+    const int audioFilesCount = trackImporter.trackCount();
 
     if (audioFilesCount > 0 || folderOrPlaylistFound) {
         // If we have found anything, recursively build playlist/folder TreeItem children
         // for the original device TreeItem
-        buildPlaylistTree(database, deviceItem, 0, playlistNameMap, playlistIsFolderMap, playlistTreeMap, playlistTrackMap, devicePath, device);
+        buildPlaylistTree(database, deviceItem, 0, playlistNameMap, playlistIsFolderMap, playlistTreeMap, playlistTrackMap, devicePath, trackImporter.trackIDs());
     }
 
-    qDebug() << "Found: " << audioFilesCount << " audio files in Rekordbox device " << device;
-
     transaction.commit();
 
+    kLogger.info()
+            << "Imported" << audioFilesCount
+            << "tracks from Rekordbox device" << device
+            << "in" << timer.elapsed().formatMillisWithUnit();
+
     return devicePath;
 }
 
@@ -637,7 +935,19 @@ void buildPlaylistTree(
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTreeMap,
         QMap<uint32_t, QMap<uint32_t, uint32_t>>& playlistTrackMap,
         QString playlistPath,
-        QString device) {
+        const QHash<uint32_t, int>& trackIDs) {
+    QSqlQuery queryInsertIntoPlaylist(database);
+    queryInsertIntoPlaylist.prepare(
+            "INSERT INTO " + kRekordboxPlaylistsTable +
+            " (name) "
+            "VALUES (:name)");
+
+    QSqlQuery queryInsertIntoPlaylistTracks(database);
+    queryInsertIntoPlaylistTracks.prepare(
+            "INSERT INTO " + kRekordboxPlaylistTracksTable +
+            " (playlist_id, track_id, position) "
+            "VALUES (:playlist_id, :track_id, :position)");
+
     for (uint32_t childIndex = 0; childIndex < (uint32_t)playlistTreeMap[parentID].size(); childIndex++) {
         uint32_t childID = playlistTreeMap[parentID][childIndex];
         QString playlistItemName = playlistNameMap[childID];
@@ -652,12 +962,6 @@ void buildPlaylistTree(
         TreeItem* child = parent->appendChild(playlistItemName, QVariant(data));
 
         // Create a playlist for this child
-        QSqlQuery queryInsertIntoPlaylist(database);
-        queryInsertIntoPlaylist.prepare(
-                "INSERT INTO " + kRekordboxPlaylistsTable +
-                " (name) "
-                "VALUES (:name)");
-
         queryInsertIntoPlaylist.bindValue(":name", currentPath);
 
         if (!queryInsertIntoPlaylist.exec()) {
@@ -666,48 +970,14 @@ void buildPlaylistTree(
             return;
         }
 
-        QSqlQuery idQuery(database);
-        idQuery.prepare("select id from " + kRekordboxPlaylistsTable + " where name=:path");
-        idQuery.bindValue(":path", currentPath);
-
-        if (!idQuery.exec()) {
-            LOG_FAILED_QUERY(idQuery)
-                    << "currentPath" << currentPath;
-            return;
-        }
-
-        int playlistID = -1;
-        while (idQuery.next()) {
-            playlistID = idQuery.value(idQuery.record().indexOf("id")).toInt();
-        }
-
-        QSqlQuery queryInsertIntoPlaylistTracks(database);
-        queryInsertIntoPlaylistTracks.prepare(
-                "INSERT INTO " + kRekordboxPlaylistTracksTable +
-                " (playlist_id, track_id, position) "
-                "VALUES (:playlist_id, :track_id, :position)");
+        int playlistID = queryInsertIntoPlaylist.lastInsertId().toInt();
 
         if (playlistTrackMap.count(childID)) {
             // Add playlist tracks for children
             for (uint32_t trackIndex = 1; trackIndex <= static_cast<uint32_t>(playlistTrackMap[childID].size()); trackIndex++) {
                 uint32_t rbTrackID = playlistTrackMap[childID][trackIndex];
 
-                int trackID = -1;
-                QSqlQuery finderQuery(database);
-                finderQuery.prepare("select id from " + kRekordboxLibraryTable + " where rb_id=:rb_id and device=:device");
-                finderQuery.bindValue(":rb_id", rbTrackID);
-                finderQuery.bindValue(":device", device);
-
-                if (!finderQuery.exec()) {
-                    LOG_FAILED_QUERY(finderQuery)
-                            << "rbTrackID:" << rbTrackID
-                            << "device:" << device;
-                    return;
-                }
-
-                if (finderQuery.next()) {
-                    trackID = finderQuery.value(finderQuery.record().indexOf("id")).toInt();
-                }
+                int trackID = trackIDs.value(rbTrackID, -1);
 
                 queryInsertIntoPlaylistTracks.bindValue(":playlist_id", playlistID);
                 queryInsertIntoPlaylistTracks.bindValue(":track_id", trackID);
@@ -726,7 +996,7 @@ void buildPlaylistTree(
 
         if (playlistIsFolderMap[childID]) {
             // If this child is a folder (playlists are only leaf nodes), build playlist tree for it
-            buildPlaylistTree(database, child, childID, playlistNameMap, playlistIsFolderMap, playlistTreeMap, playlistTrackMap, currentPath, device);
+            buildPlaylistTree(database, child, childID, playlistNameMap, playlistIsFolderMap, playlistTreeMap, playlistTrackMap, currentPath, trackIDs);
         }
     }
 }
@@ -819,148 +1089,63 @@ void setHotCue(TrackPointer track, double position, int id, QString label, mixxx
     }
 }
 
-void readAnalyze(TrackPointer track, double sampleRate, int timingOffset, bool ignoreBeatsAndLegacyCues, QString anlzPath) {
-    if (!QFile(anlzPath).exists()) {
-        return;
-    }
+void applyAnalyze(TrackPointer track, const anlz_data_t& data, double sampleRate, int timingOffset) {
+    double sampleRateKhz = sampleRate / 1000.0;
+    double samples = sampleRateKhz * mixxx::kEngineChannelCount;
 
-    qDebug() << "Rekordbox ANLZ path:" << anlzPath << " for: " << track->getTitle();
+    const auto offsetTime = [timingOffset](int time) {
+        // Ensure no offset times are less than 1
+        return static_cast<double>(math_max(time - timingOffset, 1));
+    };
 
-    std::ifstream ifs(anlzPath.toStdString(), std::ifstream::binary);
-    kaitai::kstream ks(&ifs);
+    if (!data.beatTimes.isEmpty()) {
+        QVector<double> beats;
+        beats.reserve(data.beatTimes.size());
+        for (int time : data.beatTimes) {
+            beats << (sampleRateKhz * offsetTime(time));
+        }
 
-    rekordbox_anlz_t anlz = rekordbox_anlz_t(&ks);
+        QHash<QString, QString> extraVersionInfo;
 
-    double sampleRateKhz = sampleRate / 1000.0;
-    double samples = sampleRateKhz * mixxx::kEngineChannelCount;
+        BeatsPointer pBeats = BeatFactory::makePreferredBeats(
+                *track, beats, extraVersionInfo, false, false, sampleRate, 0, 0, 0);
+
+        track->setBeats(pBeats);
+    }
 
     QList<memory_cue_t> memoryCues;
     int lastHotCueIndex = 0;
     double cueLoopStartPosition = kLongestPosition;
     double cueLoopEndPosition = kLongestPosition;
 
-    for (std::vector<rekordbox_anlz_t::tagged_section_t*>::iterator section = anlz.sections()->begin(); section != anlz.sections()->end(); ++section) {
-        switch ((*section)->fourcc()) {
-        case rekordbox_anlz_t::SECTION_TAGS_BEAT_GRID: {
-            if (ignoreBeatsAndLegacyCues) {
-                break;
-            }
-
-            rekordbox_anlz_t::beat_grid_tag_t* beatGridTag = static_cast<rekordbox_anlz_t::beat_grid_tag_t*>((*section)->body());
-
-            QVector<double> beats;
-
-            for (std::vector<rekordbox_anlz_t::beat_grid_beat_t*>::iterator beat = beatGridTag->beats()->begin(); beat != beatGridTag->beats()->end(); ++beat) {
-                int time = static_cast<int>((*beat)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                beats << (sampleRateKhz * static_cast<double>(time));
-            }
-
-            QHash<QString, QString> extraVersionInfo;
-
-            BeatsPointer pBeats = BeatFactory::makePreferredBeats(
-                    *track, beats, extraVersionInfo, false, false, sampleRate, 0, 0, 0);
-
-            track->setBeats(pBeats);
-        } break;
-        case rekordbox_anlz_t::SECTION_TAGS_CUES: {
-            if (ignoreBeatsAndLegacyCues) {
-                break;
-            }
-
-            rekordbox_anlz_t::cue_tag_t* cuesTag = static_cast<rekordbox_anlz_t::cue_tag_t*>((*section)->body());
-
-            for (std::vector<rekordbox_anlz_t::cue_entry_t*>::iterator cueEntry = cuesTag->cues()->begin(); cueEntry != cuesTag->cues()->end(); ++cueEntry) {
-                int time = static_cast<int>((*cueEntry)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                double position = samples * static_cast<double>(time);
-
-                switch (cuesTag->type()) {
-                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
-                    switch ((*cueEntry)->type()) {
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
-                        memory_cue_t memoryCue;
-                        memoryCue.position = position;
-                        memoryCue.color = mixxx::RgbColor::nullopt();
-                        memoryCues << memoryCue;
-                    } break;
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
-                        // As Mixxx can only have 1 saved loop, use the first occurance of a memory loop relative to the start of the track
-                        if (position < cueLoopStartPosition) {
-                            cueLoopStartPosition = position;
-                            int endTime = static_cast<int>((*cueEntry)->loop_time()) - timingOffset;
-                            // Ensure no offset times are less than 1
-                            if (endTime < 1) {
-                                endTime = 1;
-                            }
-                            cueLoopEndPosition = samples * static_cast<double>(endTime);
-                        }
-                    } break;
-                    }
-                } break;
-                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
-                    int hotCueIndex = static_cast<int>((*cueEntry)->hot_cue() - 1);
-                    if (hotCueIndex > lastHotCueIndex) {
-                        lastHotCueIndex = hotCueIndex;
-                    }
-                    setHotCue(track, position, hotCueIndex, QString(), mixxx::RgbColor::nullopt());
-                } break;
+    for (const anlz_cue_t& cue : data.cues) {
+        double position = samples * offsetTime(cue.time);
+
+        switch (cue.listType) {
+        case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
+            switch (cue.entryType) {
+            case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
+                memory_cue_t memoryCue;
+                memoryCue.position = position;
+                memoryCue.comment = cue.comment;
+                memoryCue.color = cue.color;
+                memoryCues << memoryCue;
+            } break;
+            case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
+                // As Mixxx can only have 1 saved loop, use the first occurance of a memory loop relative to the start of the track
+                if (position < cueLoopStartPosition) {
+                    cueLoopStartPosition = position;
+                    cueLoopEndPosition = samples * offsetTime(cue.loopTime);
                 }
+            } break;
             }
         } break;
-        case rekordbox_anlz_t::SECTION_TAGS_CUES_2: {
-            rekordbox_anlz_t::cue_extended_tag_t* cuesExtendedTag = static_cast<rekordbox_anlz_t::cue_extended_tag_t*>((*section)->body());
-
-            for (std::vector<rekordbox_anlz_t::cue_extended_entry_t*>::iterator cueExtendedEntry = cuesExtendedTag->cues()->begin(); cueExtendedEntry != cuesExtendedTag->cues()->end(); ++cueExtendedEntry) {
-                int time = static_cast<int>((*cueExtendedEntry)->time()) - timingOffset;
-                // Ensure no offset times are less than 1
-                if (time < 1) {
-                    time = 1;
-                }
-                double position = samples * static_cast<double>(time);
-
-                switch (cuesExtendedTag->type()) {
-                case rekordbox_anlz_t::CUE_LIST_TYPE_MEMORY_CUES: {
-                    switch ((*cueExtendedEntry)->type()) {
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_MEMORY_CUE: {
-                        memory_cue_t memoryCue;
-                        memoryCue.position = position;
-                        memoryCue.comment = toUnicode((*cueExtendedEntry)->comment());
-                        memoryCue.color = mixxx::RgbColor(qRgb(static_cast<int>((*cueExtendedEntry)->color_red()), static_cast<int>((*cueExtendedEntry)->color_green()), static_cast<int>((*cueExtendedEntry)->color_blue())));
-                        memoryCues << memoryCue;
-                    } break;
-                    case rekordbox_anlz_t::CUE_ENTRY_TYPE_LOOP: {
-                        // As Mixxx can only have 1 saved loop, use the first occurance of a memory loop relative to the start of the track
-                        if (position < cueLoopStartPosition) {
-                            cueLoopStartPosition = position;
-                            int endTime = static_cast<int>((*cueExtendedEntry)->loop_time()) - timingOffset;
-                            // Ensure no offset times are less than 1
-                            if (endTime < 1) {
-                                endTime = 1;
-                            }
-                            cueLoopEndPosition = samples * static_cast<double>(endTime);
-                        }
-                    } break;
-                    }
-                } break;
-                case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
-                    int hotCueIndex = static_cast<int>((*cueExtendedEntry)->hot_cue() - 1);
-                    if (hotCueIndex > lastHotCueIndex) {
-                        lastHotCueIndex = hotCueIndex;
-                    }
-                    setHotCue(track, position, hotCueIndex, toUnicode((*cueExtendedEntry)->comment()), mixxx::RgbColor(qRgb(static_cast<int>((*cueExtendedEntry)->color_red()), static_cast<int>((*cueExtendedEntry)->color_green()), static_cast<int>((*cueExtendedEntry)->color_blue()))));
-                } break;
-                }
+        case rekordbox_anlz_t::CUE_LIST_TYPE_HOT_CUES: {
+            if (cue.hotCueIndex > lastHotCueIndex) {
+                lastHotCueIndex = cue.hotCueIndex;
             }
+            setHotCue(track, position, cue.hotCueIndex, cue.comment, cue.color);
         } break;
-        default:
-            break;
         }
     }
 
@@ -990,6 +1175,23 @@ void readAnalyze(TrackPointer track, double sampleRate, int timingOffset, bool i
     }
 }
 
+QByteArray queryAnalysis(const QSqlDatabase& database, const QString& location) {
+    QSqlQuery query(database);
+    query.prepare("select analysis from " + kRekordboxLibraryTable + " where location=:location");
+    query.bindValue(":location", location);
+
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query)
+                << "location:" << location;
+        return QByteArray();
+    }
+
+    if (!query.next()) {
+        return QByteArray();
+    }
+    return query.value(0).toByteArray();
+}
+
 } // anonymous namespace
 
 RekordboxPlaylistModel::RekordboxPlaylistModel(QObject* parent,
@@ -1091,10 +1293,18 @@ TrackPointer RekordboxPlaylistModel::getTrack(const QModelIndex& index) const {
 
     double sampleRate = static_cast<double>(track->getSampleRate());
 
-    QString anlzPath = index.sibling(index.row(), fieldIndex("analyze_path")).data().toString();
-    readAnalyze(track, sampleRate, timingOffset, false, anlzPath);
-    QString anlzPathExt = anlzPath.left(anlzPath.length() - 3) + "EXT";
-    readAnalyze(track, sampleRate, timingOffset, true, anlzPathExt);
+    anlz_data_t datData;
+    anlz_data_t extData;
+    if (!deserializeAnalysis(queryAnalysis(m_database, location), &datData, &extData)) {
+        // Not parsed during the import
+        QString anlzPath = index.sibling(index.row(), fieldIndex("analyze_path")).data().toString();
+        qDebug() << "Rekordbox ANLZ path:" << anlzPath << " for: " << track->getTitle();
+        datData = parseAnalyze(anlzPath, false);
+        QString anlzPathExt = anlzPath.left(anlzPath.length() - 3) + "EXT";
+        extData = parseAnalyze(anlzPathExt, true);
+    }
+    applyAnalyze(track, datData, sampleRate, timingOffset);
+    applyAnalyze(track, extData, sampleRate, timingOffset);
 
     // Assume that the key of the file the has been analyzed in Recordbox is correct
     // and prevent the AnalyzerKey from re-analyzing.
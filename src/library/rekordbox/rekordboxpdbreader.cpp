@@ -0,0 +1,76 @@
+#include "library/rekordbox/rekordboxpdbreader.h"
+
+#include <exception>
+#include <string>
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("RekordboxPdbReader");
+
+} // anonymous namespace
+
+RekordboxPdbReader::RekordboxPdbReader(const QString& filePath)
+        : m_file(filePath.toStdString(), std::ifstream::binary) {
+    if (!m_file.is_open()) {
+        kLogger.warning() << "Failed to open" << filePath;
+        return;
+    }
+    try {
+        m_pStream = std::make_unique<kaitai::kstream>(&m_file);
+        // Only reads the file header and the table headers
+        m_pPdb = std::make_unique<rekordbox_pdb_t>(m_pStream.get());
+    } catch (const std::exception& e) {
+        kLogger.warning() << "Failed to read" << filePath << ":" << e.what();
+        m_pPdb.reset();
+    }
+}
+
+RekordboxPdbReader::~RekordboxPdbReader() {
+    // The parser refers to the stream
+    m_pPdb.reset();
+}
+
+int RekordboxPdbReader::visitRows(
+        rekordbox_pdb_t::page_type_t type, const RowVisitor& visitor) {
+    if (!m_pPdb) {
+        return 0;
+    }
+    const uint32_t pageSize = m_pPdb->len_page();
+    int rowCount = 0;
+    try {
+        for (auto* pTable : *m_pPdb->tables()) {
+            if (pTable->type() != type) {
+                continue;
+            }
+            const uint32_t lastPageIndex = pTable->last_page()->index();
+            uint32_t pageIndex = pTable->first_page()->index();
+            // Pages are linked and a corrupt file may contain cycles
+            uint32_t remainingPages = m_pPdb->next_unused_page();
+            while (remainingPages-- > 0) {
+                m_pStream->seek(static_cast<uint64_t>(pageSize) * pageIndex);
+                std::string pageData = m_pStream->read_bytes(pageSize);
+                kaitai::kstream pageStream(pageData);
+                rekordbox_pdb_t::page_t page(&pageStream, pTable->first_page(), m_pPdb.get());
+                if (page.is_data_page()) {
+                    for (auto* pRowGroup : *page.row_groups()) {
+                        for (auto* pRowRef : *pRowGroup->rows()) {
+                            if (pRowRef->present()) {
+                                visitor(pRowRef->body());
+                                ++rowCount;
+                            }
+                        }
+                    }
+                }
+                if (pageIndex == lastPageIndex) {
+                    break;
+                }
+                pageIndex = page.next_page()->index();
+            }
+        }
+    } catch (const std::exception& e) {
+        kLogger.warning() << "Failed to read rows of table" << type << ":" << e.what();
+    }
+    return rowCount;
+}
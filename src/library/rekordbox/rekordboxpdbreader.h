@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QString>
+#include <fstream>
+#include <functional>
+#include <memory>
+
+#include "library/rekordbox/rekordbox_pdb.h"
+
+// Reads the tables of a Rekordbox export.pdb file page by page.
+//
+// The generated rekordbox_pdb_t parser caches every page that has been
+// visited together with all of its rows until the whole file has been
+// parsed. This reader only parses the table headers upfront and keeps a
+// single page in memory while visiting its rows.
+class RekordboxPdbReader final {
+  public:
+    // Rows and the strings they refer to are only valid while being visited
+    typedef std::function<void(kaitai::kstruct* pRow)> RowVisitor;
+
+    explicit RekordboxPdbReader(const QString& filePath);
+    ~RekordboxPdbReader();
+
+    bool isOpen() const {
+        return static_cast<bool>(m_pPdb);
+    }
+
+    // Visits all present rows of the tables with the given type in the
+    // order they are stored. Returns the number of visited rows.
+    int visitRows(rekordbox_pdb_t::page_type_t type, const RowVisitor& visitor);
+
+  private:
+    RekordboxPdbReader(const RekordboxPdbReader&) = delete;
+    RekordboxPdbReader& operator=(const RekordboxPdbReader&) = delete;
+
+    std::ifstream m_file;
+    std::unique_ptr<kaitai::kstream> m_pStream;
+    std::unique_ptr<rekordbox_pdb_t> m_pPdb;
+};
@@ -1,9 +1,35 @@
 #include "library/scanner/importfilestask.h"
 
 #include "library/scanner/libraryscanner.h"
+#include "sources/soundsourceproxy.h"
 #include "track/trackfile.h"
 #include "util/timer.h"
 
+namespace {
+
+// Imported files are handed over to the library scanner thread in batches
+// to reduce the number of queued signals without delaying the progress
+// feedback too much.
+const int kMaxImportedTrackFilesPerBatch = 32;
+
+mixxx::TrackRecord importTrackRecord(
+        TrackFile trackFile,
+        SecurityTokenPointer pToken) {
+    // Unlike SoundSourceProxy::importTemporaryTrack() this doesn't lock
+    // the GlobalTrackCache, because no track object could export its
+    // metadata into a file that is not in the library yet. Otherwise
+    // all tasks would be serialized.
+    TrackPointer pTrack = Track::newTemporary(
+            std::move(trackFile),
+            std::move(pToken));
+    SoundSourceProxy(pTrack).updateTrackFromSource();
+    mixxx::TrackRecord trackRecord;
+    pTrack->readTrackRecord(&trackRecord);
+    return trackRecord;
+}
+
+} // anonymous namespace
+
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
                                  const ScannerGlobalPointer scannerGlobal,
                                  const QString& dirPath,
@@ -23,6 +49,7 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
 
 void ImportFilesTask::run() {
     ScopedTimer timer("ImportFilesTask::run");
+    QList<ImportedTrackFile> importedTrackFiles;
     for (const QFileInfo& fileInfo: m_filesToImport) {
         // If a flag was raised telling us to cancel the library scan then stop.
         if (m_scannerGlobal->shouldCancel()) {
@@ -37,11 +64,17 @@ void ImportFilesTask::run() {
         // does then it is either in the user's library OR the user has
         // "removed" the track via "Right-Click -> Remove". These tracks
         // stay in the library, but their mixxx_deleted column is 1.
+        const bool modified = m_scannerGlobal->fileModifiedSinceLastScan(
+                trackLocation, LibraryFileStat::fromFileInfo(fileInfo));
         if (m_scannerGlobal->trackExistsInDatabase(trackLocation)) {
             // If the track is in the database, mark it as existing. This code gets
             // executed when other files in the same directory have changed (the
             // directory hash has changed).
-            emit trackExists(trackLocation);
+            if (modified) {
+                emit trackModified(trackLocation);
+            } else {
+                emit trackExists(trackLocation);
+            }
         } else {
             if (!fileInfo.exists()) {
                 qWarning() << "ImportFilesTask: Skipping inaccessible file"
@@ -50,9 +83,18 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            TrackFile trackFile(fileInfo);
+            importedTrackFiles.append(ImportedTrackFile{
+                    trackFile, importTrackRecord(trackFile, m_pToken)});
+            if (importedTrackFiles.size() >= kMaxImportedTrackFilesPerBatch) {
+                emit addNewTracks(importedTrackFiles);
+                importedTrackFiles.clear();
+            }
         }
     }
+    if (!importedTrackFiles.isEmpty()) {
+        emit addNewTracks(importedTrackFiles);
+    }
     // Insert or update the hash in the database.
     emit directoryHashedAndScanned(m_dirPath, !m_prevHashExists, m_newHash);
     setSuccess(true);
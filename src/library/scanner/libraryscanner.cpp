@@ -3,10 +3,12 @@
 #include "sources/soundsourceproxy.h"
 #include "library/scanner/recursivescandirectorytask.h"
 #include "library/scanner/libraryscannerdlg.h"
+#include "library/scanner/librarywatcher.h"
 #include "library/scanner/scannertask.h"
 #include "library/queryutil.h"
 #include "library/coverartutils.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/trace.h"
 #include "util/file.h"
 #include "util/timer.h"
@@ -18,8 +20,16 @@
 
 namespace {
 
-// TODO(rryan) make configurable
-const int kScannerThreadPoolSize = 1;
+// Importing the metadata of new files is CPU bound and done concurrently.
+// More threads would only compete for disk access.
+const int kMaxScannerThreadPoolSize = 4;
+
+const ConfigKey kConfigKeyScannerThreads("[Library]", "ScannerThreads");
+
+// Rescans only visit the directories that changed since the last scan
+// while the library is watched. Can be disabled for network shares where
+// changes by other hosts are not reported.
+const ConfigKey kConfigKeyIncrementalRescan("[Library]", "IncrementalRescan");
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -42,12 +52,14 @@ LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
                   pConfig),
           m_stateSema(1), // only one transaction is possible at a time
-          m_state(IDLE) {
+          m_state(IDLE),
+          m_bIncrementalScan(false) {
     // Move LibraryScanner to its own thread so that our signals/slots will
     // queue to our event loop.
     moveToThread(this);
@@ -56,7 +68,11 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    qRegisterMetaType<QList<ImportedTrackFile>>();
+
+    m_pool.setMaxThreadCount(math_max(1, pConfig->getValue(
+            kConfigKeyScannerThreads,
+            math_min(QThread::idealThreadCount(), kMaxScannerThreadPoolSize))));
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -71,6 +87,10 @@ LibraryScanner::LibraryScanner(
             &LibraryScanner::progressHashing,
             m_pProgressDlg.data(),
             &LibraryScannerDlg::slotUpdate);
+    connect(this,
+            &LibraryScanner::progressFilesScanned,
+            m_pProgressDlg.data(),
+            &LibraryScannerDlg::slotFilesScanned);
     connect(this,
             &LibraryScanner::scanStarted,
             m_pProgressDlg.data(),
@@ -140,16 +160,21 @@ void LibraryScanner::run() {
         }
 
         m_libraryHashDao.initialize(dbConnection);
+        m_libraryFileStatDao.initialize(dbConnection);
         m_cueDao.initialize(dbConnection);
         m_trackDao.initialize(dbConnection);
         m_playlistDao.initialize(dbConnection);
         m_analysisDao.initialize(dbConnection);
         m_directoryDao.initialize(dbConnection);
 
+        m_pWatcher = std::make_unique<LibraryWatcher>();
+
         // Start the event loop.
         kLogger.debug() << "Event loop starting";
         exec();
         kLogger.debug() << "Event loop stopped";
+
+        m_pWatcher.reset();
     }
     kLogger.debug() << "Exiting thread";
 }
@@ -170,15 +195,58 @@ void LibraryScanner::slotStartScan() {
 
     QSet<QString> trackLocations = m_trackDao.getAllTrackLocations();
     QHash<QString, mixxx::cache_key_t> directoryHashes = m_libraryHashDao.getDirectoryHashes();
+    QHash<QString, LibraryFileStat> fileStats = m_libraryFileStatDao.getFileStats();
     QRegExp extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
     QRegExp coverExtensionFilter =
             QRegExp(CoverArtUtils::supportedCoverArtExtensionsRegex(),
                     Qt::CaseInsensitive);
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
+    // If the watcher has seen all changes since the last scan only the
+    // changed directories need to be visited. All other directories that
+    // still exist are verified without listing their contents. Otherwise
+    // fall back to visiting the whole library.
+    QStringList changedDirectories;
+    QSet<QString> unchangedDirectories;
+    LibraryWatcher* pWatcher = nullptr;
+    if (m_pConfig->getValue(kConfigKeyIncrementalRescan, true)) {
+        pWatcher = m_pWatcher.get();
+    } else if (m_pWatcher) {
+        // Changes are not recorded while disabled
+        m_pWatcher->desynchronize();
+    }
+    m_bIncrementalScan = pWatcher && pWatcher->isSynchronized(m_libraryRootDirs);
+    if (m_bIncrementalScan) {
+        const QSet<QString> changedDirectoriesSinceLastScan =
+                pWatcher->takeChangedDirectories();
+        for (auto it = directoryHashes.constBegin();
+                it != directoryHashes.constEnd(); ++it) {
+            const QString& dirPath = it.key();
+            if (!QFileInfo(dirPath).isDir()) {
+                // Deleted or moved
+                continue;
+            }
+            if (changedDirectoriesSinceLastScan.contains(dirPath)) {
+                changedDirectories << dirPath;
+            } else {
+                unchangedDirectories.insert(dirPath);
+            }
+        }
+        kLogger.info()
+                << "Rescanning"
+                << changedDirectories.size()
+                << "changed directories";
+    } else if (pWatcher) {
+        pWatcher->reset();
+    }
+
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
+            new ScannerGlobal(trackLocations, directoryHashes, fileStats,
+                              unchangedDirectories, pWatcher, extensionFilter,
                               coverExtensionFilter, directoryBlacklist));
+    for (const QString& dirPath : unchangedDirectories) {
+        m_scannerGlobal->addVerifiedDirectory(dirPath);
+    }
 
     m_scannerGlobal->startTimer();
 
@@ -221,6 +289,22 @@ void LibraryScanner::slotStartScan() {
         // scanning so that relies on having an open bookmark for the containing
         // directory.
         MDir dir(dirPath);
+        if (m_bIncrementalScan) {
+            for (const QString& changedDirPath : changedDirectories) {
+                if (changedDirPath != dirPath &&
+                        !changedDirPath.startsWith(dirPath + QChar('/'))) {
+                    continue;
+                }
+                const QDir changedDir(changedDirPath);
+                if (!m_scannerGlobal->testAndMarkDirectoryScanned(changedDir)) {
+                    queueTask(new RecursiveScanDirectoryTask(this, m_scannerGlobal,
+                                                             changedDir,
+                                                             dir.token(),
+                                                             false));
+                }
+            }
+            continue;
+        }
         if (!m_scannerGlobal->testAndMarkDirectoryScanned(dir.dir())) {
             queueTask(new RecursiveScanDirectoryTask(this, m_scannerGlobal,
                                                      dir.dir(),
@@ -287,6 +371,9 @@ void LibraryScanner::cleanUpScan() {
     kLogger.debug() << "Marking tracks in changed directories as verified";
     m_trackDao.markTrackLocationsAsVerified(m_scannerGlobal->verifiedTracks());
 
+    kLogger.debug() << "Saving the status of new and modified files";
+    m_libraryFileStatDao.saveFileStats(m_scannerGlobal->changedFileStats());
+
     kLogger.debug() << "Marking unchanged directories and tracks as verified";
     m_libraryHashDao.updateDirectoryStatuses(
             m_scannerGlobal->verifiedDirectories(),
@@ -341,6 +428,7 @@ void LibraryScanner::cleanUpScan() {
     // songs if you move a set of songs from directory A to B, then back to
     // A.
     m_libraryHashDao.removeDeletedDirectoryHashes();
+    m_libraryFileStatDao.removeStaleFileStats();
 
     transaction.commit();
 
@@ -383,20 +471,30 @@ void LibraryScanner::slotFinishUnhashedScan() {
 
     if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         kLogger.debug() << "Scan finished cleanly";
+        if (m_scannerGlobal->watcher() && !m_bIncrementalScan) {
+            m_scannerGlobal->watcher()->setSynchronized(m_libraryRootDirs);
+        }
     } else {
         kLogger.debug() << "Scan cancelled";
+        // The changed directories have been taken from the watcher
+        if (m_pWatcher) {
+            m_pWatcher->desynchronize();
+        }
     }
 
     // TODO(XXX) doesn't take into account verifyRemainingTracks.
-    qDebug("Scan took: %s. "
+    qDebug("%s scan took: %s. "
            "%d unchanged directories. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
+           "%d modified tracks. "
            "%d new tracks.",
+           m_bIncrementalScan ? "Incremental" : "Full",
            m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
            m_scannerGlobal->verifiedDirectories().size(),
            m_scannerGlobal->numScannedDirectories(),
            m_scannerGlobal->verifiedTracks().size(),
+           m_scannerGlobal->numModifiedTracks(),
            m_scannerGlobal->addedTracks().size());
 
     m_scannerGlobal.clear();
@@ -476,9 +574,13 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             this,
             &LibraryScanner::slotTrackExists);
     connect(pTask,
-            &ScannerTask::addNewTrack,
+            &ScannerTask::trackModified,
+            this,
+            &LibraryScanner::slotTrackModified);
+    connect(pTask,
+            &ScannerTask::addNewTracks,
             this,
-            &LibraryScanner::slotAddNewTrack);
+            &LibraryScanner::slotAddNewTracks);
 
     // Progress signals.
     // Pass directly to the main thread
@@ -490,6 +592,10 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             &ScannerTask::progressHashing,
             this,
             &LibraryScanner::progressHashing);
+    connect(pTask,
+            &ScannerTask::filesScanned,
+            this,
+            &LibraryScanner::progressFilesScanned);
 
     m_pool.start(pTask);
 }
@@ -531,11 +637,46 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
-    //kLogger.debug() << "slotAddNewTrack" << trackPath;
-    ScopedTimer timer("LibraryScanner::addNewTrack");
+void LibraryScanner::slotTrackModified(const QString& trackPath) {
+    //kLogger.debug() << "slotTrackModified" << trackPath;
+    ScopedTimer timer("LibraryScanner::slotTrackModified");
+    if (m_scannerGlobal) {
+        m_scannerGlobal->addVerifiedTrack(trackPath);
+        m_scannerGlobal->trackModified();
+    }
+    TrackPointer pTrack = m_trackDao.getTrackByRef(
+            TrackRef::fromFileInfo(trackPath));
+    if (!pTrack) {
+        kLogger.warning()
+                << "Failed to load modified track:"
+                << trackPath;
+        return;
+    }
+    // The file has been modified outside of Mixxx, e.g. by a tag editor.
+    // The track is saved when it is released.
+    kLogger.debug() << "Reimporting metadata of modified track" << trackPath;
+    SoundSourceProxy(pTrack).updateTrackFromSource(
+            SoundSourceProxy::ImportTrackMetadataMode::Again);
+}
+
+void LibraryScanner::slotAddNewTracks(
+        const QList<ImportedTrackFile>& importedTrackFiles) {
+    ScopedTimer timer("LibraryScanner::slotAddNewTracks");
+    // All tracks are inserted within the transaction that has been started
+    // by TrackDAO::addTracksPrepare() using its prepared statements.
+    for (const ImportedTrackFile& importedTrackFile : importedTrackFiles) {
+        addNewTrack(importedTrackFile);
+    }
+}
+
+void LibraryScanner::addNewTrack(const ImportedTrackFile& importedTrackFile) {
+    const QString trackPath = importedTrackFile.trackFile.location();
+    //kLogger.debug() << "addNewTrack" << trackPath;
     // For statistics tracking and to detect moved tracks
-    TrackPointer pTrack(m_trackDao.addTracksAddFile(trackPath, false));
+    TrackPointer pTrack(m_trackDao.addTracksAddImportedFile(
+            importedTrackFile.trackFile,
+            importedTrackFile.trackRecord,
+            false));
     if (pTrack) {
         // The track's actual location might differ from the
         // given trackPath
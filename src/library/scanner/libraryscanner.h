@@ -8,20 +8,24 @@
 #include <QSemaphore>
 #include <QScopedPointer>
 
+#include <memory>
+
 #include "library/dao/cuedao.h"
+#include "library/dao/libraryfilestatdao.h"
 #include "library/dao/libraryhashdao.h"
 #include "library/dao/directorydao.h"
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackdao.h"
 #include "library/dao/analysisdao.h"
 #include "library/scanner/scannerglobal.h"
+#include "library/scanner/scannertask.h"
 #include "track/track.h"
 #include "util/db/dbconnectionpool.h"
 
 #include <gtest/gtest.h>
 
-class ScannerTask;
 class LibraryScannerDlg;
+class LibraryWatcher;
 
 class LibraryScanner : public QThread {
     FRIEND_TEST(LibraryScannerTest, ScannerRoundtrip);
@@ -45,6 +49,7 @@ class LibraryScanner : public QThread {
     void scanFinished();
     void progressHashing(QString);
     void progressLoading(QString path);
+    void progressFilesScanned(int numFiles);
     void progressCoverArt(QString file);
     void trackAdded(TrackPointer pTrack);
     void tracksChanged(QSet<TrackId> changedTrackIds);
@@ -70,7 +75,8 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+    void slotTrackModified(const QString& trackPath);
+    void slotAddNewTracks(const QList<ImportedTrackFile>& importedTrackFiles);
 
   private:
     enum ScannerState {
@@ -96,13 +102,17 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    void addNewTrack(const ImportedTrackFile& importedTrackFile);
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    UserSettingsPointer m_pConfig;
 
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
 
     // The library scanner thread's DAOs.
     LibraryHashDAO m_libraryHashDao;
+    LibraryFileStatDAO m_libraryFileStatDao;
     CueDAO m_cueDao;
     PlaylistDAO m_playlistDao;
     DirectoryDAO m_directoryDao;
@@ -120,6 +130,11 @@ class LibraryScanner : public QThread {
     volatile ScannerState m_state;
 
     QStringList m_libraryRootDirs;
+
+    // Lives in the library scanner thread. Only the directories that
+    // changed since the last scan are visited if it is synchronized.
+    std::unique_ptr<LibraryWatcher> m_pWatcher;
+    bool m_bIncrementalScan;
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 };
 
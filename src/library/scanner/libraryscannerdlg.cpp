@@ -25,7 +25,8 @@
 
 LibraryScannerDlg::LibraryScannerDlg(QWidget* parent, Qt::WindowFlags f)
         : QWidget(parent, f),
-          m_bCancelled(false) {
+          m_bCancelled(false),
+          m_numFilesScanned(0) {
     setWindowIcon(QIcon(":/images/mixxx_icon.svg"));
 
     QVBoxLayout* pLayout = new QVBoxLayout(this);
@@ -48,6 +49,10 @@ LibraryScannerDlg::LibraryScannerDlg(QWidget* parent, Qt::WindowFlags f)
     pCurrent->setWordWrap(true);
     connect(this, &LibraryScannerDlg::progress, pCurrent, &QLabel::setText);
     pLayout->addWidget(pCurrent);
+
+    QLabel* pThroughput = new QLabel(this);
+    connect(this, &LibraryScannerDlg::throughput, pThroughput, &QLabel::setText);
+    pLayout->addWidget(pThroughput);
     setLayout(pLayout);
 }
 
@@ -80,6 +85,18 @@ void LibraryScannerDlg::slotUpdateCover(QString path) {
     }
 }
 
+void LibraryScannerDlg::slotFilesScanned(int numFiles) {
+    m_numFilesScanned += numFiles;
+    if (isVisible()) {
+        const double seconds = m_timer.elapsed().toDoubleSeconds();
+        if (seconds > 0) {
+            emit throughput(tr("%1 files scanned (%2 files/s)")
+                    .arg(m_numFilesScanned)
+                    .arg(m_numFilesScanned / seconds, 0, 'f', 0));
+        }
+    }
+}
+
 void LibraryScannerDlg::slotCancel() {
     qDebug() << "Cancelling library scan...";
     m_bCancelled = true;
@@ -89,6 +106,7 @@ void LibraryScannerDlg::slotCancel() {
 
 void LibraryScannerDlg::slotScanStarted() {
     m_bCancelled = false;
+    m_numFilesScanned = 0;
     m_timer.start();
 }
 
@@ -34,6 +34,7 @@ class LibraryScannerDlg : public QWidget {
   public slots:
     void slotUpdate(QString path);
     void slotUpdateCover(QString path);
+    void slotFilesScanned(int numFiles);
     void slotCancel();
     void slotScanFinished();
     void slotScanStarted();
@@ -41,10 +42,12 @@ class LibraryScannerDlg : public QWidget {
   signals:
     void scanCancelled();
     void progress(QString);
+    void throughput(QString);
 
   private:
     PerformanceTimer m_timer;
     bool m_bCancelled;
+    int m_numFilesScanned;
 };
 
 #endif
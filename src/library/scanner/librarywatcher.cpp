@@ -0,0 +1,178 @@
+#include "library/scanner/librarywatcher.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QSocketNotifier>
+
+#ifdef __LINUX__
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("LibraryWatcher");
+
+#ifdef __LINUX__
+// Modifications are only reported once the file is closed to avoid
+// flooding the event queue while a file is written.
+const uint32_t kWatchMask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE |
+        IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_MOVED_FROM |
+        IN_MOVED_TO | IN_ONLYDIR;
+#endif
+
+} // anonymous namespace
+
+LibraryWatcher::LibraryWatcher()
+        : m_fd(-1),
+          m_pNotifier(nullptr),
+          m_synchronized(false),
+          m_missedChanges(true) {
+}
+
+LibraryWatcher::~LibraryWatcher() {
+    close();
+}
+
+void LibraryWatcher::close() {
+    delete m_pNotifier;
+    m_pNotifier = nullptr;
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        // Removes all watches
+        ::close(m_fd);
+    }
+#endif
+    m_fd = -1;
+}
+
+void LibraryWatcher::reset() {
+    QMutexLocker locker(&m_mutex);
+    close();
+    m_dirPathsByWatch.clear();
+    m_changedDirectories.clear();
+    m_rootDirs.clear();
+    m_synchronized = false;
+#ifdef __LINUX__
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        kLogger.warning()
+                << "Failed to initialize inotify:"
+                << strerror(errno);
+    } else {
+        m_pNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+        connect(m_pNotifier,
+                &QSocketNotifier::activated,
+                this,
+                &LibraryWatcher::slotReadEvents);
+    }
+#endif
+    m_missedChanges = m_fd < 0;
+}
+
+void LibraryWatcher::watchDirectory(const QString& dirPath) {
+#ifdef __LINUX__
+    QMutexLocker locker(&m_mutex);
+    if (m_fd < 0 || m_missedChanges) {
+        return;
+    }
+    const int wd = inotify_add_watch(m_fd,
+            QFile::encodeName(dirPath).constData(),
+            kWatchMask);
+    if (wd < 0) {
+        if (errno == ENOSPC) {
+            kLogger.warning()
+                    << "Too many directories to watch, the next scan will"
+                    << "visit the whole library again. Consider raising"
+                    << "fs.inotify.max_user_watches.";
+        } else {
+            kLogger.warning()
+                    << "Failed to watch"
+                    << dirPath
+                    << strerror(errno);
+        }
+        m_missedChanges = true;
+        return;
+    }
+    // Adding a watch for the same directory again returns the existing
+    // watch, possibly for a new path if the directory has been moved.
+    m_dirPathsByWatch.insert(wd, dirPath);
+#else
+    Q_UNUSED(dirPath);
+#endif
+}
+
+void LibraryWatcher::setSynchronized(const QStringList& rootDirs) {
+    QMutexLocker locker(&m_mutex);
+    readEvents();
+    // Changes of directories during the scan are kept for the next scan,
+    // because it is unknown if they happened before or after visiting the
+    // directory.
+    m_rootDirs = rootDirs;
+    m_synchronized = true;
+}
+
+void LibraryWatcher::desynchronize() {
+    QMutexLocker locker(&m_mutex);
+    m_synchronized = false;
+}
+
+bool LibraryWatcher::isSynchronized(const QStringList& rootDirs) {
+    QMutexLocker locker(&m_mutex);
+    // Changes that have not been delivered yet might overflow the queue
+    readEvents();
+    return m_synchronized && !m_missedChanges && m_rootDirs == rootDirs;
+}
+
+QSet<QString> LibraryWatcher::takeChangedDirectories() {
+    QMutexLocker locker(&m_mutex);
+    readEvents();
+    QSet<QString> changedDirectories;
+    changedDirectories.swap(m_changedDirectories);
+    return changedDirectories;
+}
+
+void LibraryWatcher::slotReadEvents() {
+    QMutexLocker locker(&m_mutex);
+    readEvents();
+}
+
+void LibraryWatcher::readEvents() {
+#ifdef __LINUX__
+    if (m_fd < 0) {
+        return;
+    }
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(m_fd, buffer, sizeof(buffer))) > 0) {
+        const char* pEventData = buffer;
+        while (pEventData < buffer + length) {
+            const auto* pEvent =
+                    reinterpret_cast<const struct inotify_event*>(pEventData);
+            pEventData += sizeof(struct inotify_event) + pEvent->len;
+            if (pEvent->mask & IN_Q_OVERFLOW) {
+                kLogger.warning()
+                        << "Missed changes of the library, the next scan"
+                        << "will visit the whole library again";
+                m_missedChanges = true;
+                continue;
+            }
+            const auto it = m_dirPathsByWatch.find(pEvent->wd);
+            if (it == m_dirPathsByWatch.end()) {
+                continue;
+            }
+            // Both changes of the directory's entries and of the directory
+            // itself, i.e. deleting or moving it. Directories that don't
+            // exist anymore are not scanned.
+            m_changedDirectories.insert(it.value());
+            if (pEvent->mask & IN_IGNORED) {
+                m_dirPathsByWatch.erase(it);
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class QSocketNotifier;
+
+// Records which directories of the library have changed since they have
+// been visited by the library scanner, such that a rescan only needs to
+// visit those. The directories are watched with inotify on Linux.
+//
+// The watcher is only synchronized with the library if a scan of the whole
+// library finished while watching and no change might have been missed
+// since, e.g. because the kernel's event queue overflowed or the limit of
+// watches per user has been reached. Otherwise the next scan has to visit
+// the whole library again. On other platforms the watcher is never
+// synchronized.
+//
+// Must be created and reset in the library scanner thread. The remaining
+// functions are thread-safe.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+  public:
+    LibraryWatcher();
+    ~LibraryWatcher() override;
+
+    // Forgets all watches and changes and starts from scratch, before
+    // scanning the whole library.
+    void reset();
+
+    // Starts watching a directory. Should be called before listing the
+    // directory to not miss changes in between.
+    void watchDirectory(const QString& dirPath);
+
+    // Called after the whole library has been scanned.
+    void setSynchronized(const QStringList& rootDirs);
+    // Called if changed directories could not be scanned.
+    void desynchronize();
+
+    bool isSynchronized(const QStringList& rootDirs);
+
+    QSet<QString> takeChangedDirectories();
+
+  private slots:
+    void slotReadEvents();
+
+  private:
+    void close();
+    void readEvents();
+
+    QMutex m_mutex;
+    int m_fd;
+    QSocketNotifier* m_pNotifier;
+    QHash<int, QString> m_dirPathsByWatch;
+    QSet<QString> m_changedDirectories;
+    QStringList m_rootDirs;
+    bool m_synchronized;
+    // A change might have been missed since the last reset.
+    bool m_missedChanges;
+};
@@ -5,6 +5,7 @@
 
 #include "library/scanner/libraryscanner.h"
 #include "library/scanner/importfilestask.h"
+#include "track/trackfile.h"
 #include "util/timer.h"
 
 RecursiveScanDirectoryTask::RecursiveScanDirectoryTask(
@@ -31,6 +32,12 @@ void RecursiveScanDirectoryTask::run() {
     // a QDirIterator with a QDir instead of a QString -- but it inherits its
     // Filter from the QDir so we have to set it first. If the QDir has not done
     // any FS operations yet then this should be lightweight.
+    // Changes after this point are visited by the next scan.
+    LibraryWatcher* pWatcher = m_scannerGlobal->watcher();
+    if (pWatcher) {
+        pWatcher->watchDirectory(m_dir.path());
+    }
+
     m_dir.setFilter(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
     QDirIterator it(m_dir);
 
@@ -69,6 +76,10 @@ void RecursiveScanDirectoryTask::run() {
                 continue;
             }
             const QDir currentDir(currentFile);
+            if (m_scannerGlobal->directoryUnchangedSinceLastScan(currentDir.path())) {
+                // Already verified without visiting it.
+                continue;
+            }
             dirsToScan.append(currentDir);
         }
     }
@@ -84,6 +95,7 @@ void RecursiveScanDirectoryTask::run() {
     const bool prevHashExists = mixxx::isValidCacheKey(prevHash);
 
     if (prevHashExists || m_scanUnhashed) {
+        emit filesScanned(filesToImport.size());
         // Compare the hashes, and if they don't match, rescan the files in that
         // directory!
         if (prevHash != newHash) {
@@ -98,6 +110,15 @@ void RecursiveScanDirectoryTask::run() {
                 emit directoryHashedAndScanned(dirPath, !prevHashExists, newHash);
             }
         } else {
+            // The list of files did not change, but their contents might
+            // have, e.g. when editing tags.
+            for (const QFileInfo& fileInfo : filesToImport) {
+                const QString trackLocation(TrackFile(fileInfo).location());
+                if (m_scannerGlobal->fileModifiedSinceLastScan(trackLocation,
+                            LibraryFileStat::fromFileInfo(fileInfo))) {
+                    emit trackModified(trackLocation);
+                }
+            }
             emit directoryUnchanged(dirPath);
         }
     } else {
@@ -9,6 +9,8 @@
 #include <QMutexLocker>
 #include <QSharedPointer>
 
+#include "library/dao/libraryfilestatdao.h"
+#include "library/scanner/librarywatcher.h"
 #include "util/cache.h"
 #include "util/task.h"
 #include "util/performancetimer.h"
@@ -39,18 +41,25 @@ class ScannerGlobal {
   public:
     ScannerGlobal(const QSet<QString>& trackLocations,
                   const QHash<QString, mixxx::cache_key_t>& directoryHashes,
+                  const QHash<QString, LibraryFileStat>& fileStats,
+                  const QSet<QString>& unchangedDirectories,
+                  LibraryWatcher* pWatcher,
                   const QRegExp& supportedExtensionsMatcher,
                   const QRegExp& supportedCoverExtensionsMatcher,
                   const QStringList& directoriesBlacklist)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
+              m_fileStats(fileStats),
+              m_unchangedDirectories(unchangedDirectories),
+              m_pWatcher(pWatcher),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_numScannedDirectories(0),
+              m_numModifiedTracks(0) {
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -67,6 +76,41 @@ class ScannerGlobal {
         return m_directoryHashes.value(directoryPath, -1);
     }
 
+    // Directories that are known to be unchanged since the last scan don't
+    // need to be visited. Only non-empty for incremental scans.
+    inline bool directoryUnchangedSinceLastScan(const QString& directoryPath) const {
+        return m_unchangedDirectories.contains(directoryPath);
+    }
+
+    // The watcher for changes after visiting a directory or nullptr.
+    LibraryWatcher* watcher() const {
+        return m_pWatcher;
+    }
+
+    // Compares the current status of a track file with the one seen by the
+    // last scan and remembers it for the next scan. Files that have not
+    // been seen before are not considered as modified.
+    inline bool fileModifiedSinceLastScan(const QString& trackLocation,
+                                          const LibraryFileStat& fileStat) {
+        if (!fileStat.isValid()) {
+            return false;
+        }
+        const auto it = m_fileStats.constFind(trackLocation);
+        const bool known = it != m_fileStats.constEnd();
+        if (known && it.value() == fileStat) {
+            return false;
+        }
+        QMutexLocker locker(&m_changedFileStatsMutex);
+        m_changedFileStats.insert(trackLocation, fileStat);
+        return known;
+    }
+
+    const QHash<QString, LibraryFileStat>& changedFileStats() const {
+        // no need for locking here, because it is only used
+        // after all tasks have finished.
+        return m_changedFileStats;
+    }
+
     inline bool directoryBlacklisted(const QString& directoryPath) const {
         return m_directoriesBlacklist.contains(directoryPath);
     }
@@ -173,12 +217,26 @@ class ScannerGlobal {
         m_numScannedDirectories++;
     }
 
+    int numModifiedTracks() const {
+        return m_numModifiedTracks;
+    }
+    void trackModified() {
+        m_numModifiedTracks++;
+    }
+
 
   private:
     TaskWatcher m_watcher;
 
     QSet<QString> m_trackLocations;
     QHash<QString, mixxx::cache_key_t> m_directoryHashes;
+    QHash<QString, LibraryFileStat> m_fileStats;
+    QSet<QString> m_unchangedDirectories;
+    LibraryWatcher* m_pWatcher;
+
+    // The status of new and modified files that needs to be saved.
+    mutable QMutex m_changedFileStatsMutex;
+    QHash<QString, LibraryFileStat> m_changedFileStats;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
     QRegExp m_supportedExtensionsMatcher;
@@ -218,6 +276,7 @@ class ScannerGlobal {
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
+    int m_numModifiedTracks;
 };
 
 typedef QSharedPointer<ScannerGlobal> ScannerGlobalPointer;
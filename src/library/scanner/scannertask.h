@@ -1,14 +1,25 @@
 #ifndef SCANNERTASK_H
 #define SCANNERTASK_H
 
+#include <QList>
 #include <QObject>
 #include <QRunnable>
 
 #include "track/track.h"
+#include "track/trackrecord.h"
 #include "library/scanner/scannerglobal.h"
 
 class LibraryScanner;
 
+// A new file with the metadata that has been imported from it by a
+// scanner task, ready to be added to the library.
+struct ImportedTrackFile {
+    TrackFile trackFile;
+    mixxx::TrackRecord trackRecord;
+};
+
+Q_DECLARE_METATYPE(QList<ImportedTrackFile>)
+
 class ScannerTask : public QObject, public QRunnable {
     Q_OBJECT
   public:
@@ -25,9 +36,11 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
-    void addNewTrack(const QString& filePath);
+    void trackModified(const QString& filePath);
+    void addNewTracks(const QList<ImportedTrackFile>& importedTrackFiles);
 
     // Feedback to GUI
+    void filesScanned(int numFiles);
     void progressLoading(const QString& fileName);
     void progressHashing(const QString& directoryPath);
 
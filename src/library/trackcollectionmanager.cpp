@@ -37,6 +37,7 @@ TrackCollectionManager::TrackCollectionManager(
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
+      m_pDbConnectionPool(pDbConnectionPool),
       m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
@@ -69,6 +70,15 @@ TrackCollectionManager::TrackCollectionManager(
     } else {
         m_pScanner = std::make_unique<LibraryScanner>(pDbConnectionPool, pConfig);
 
+        // The scanner modifies the database on its own connection without
+        // signals, e.g. when marking missing tracks. The table models must
+        // be invalidated before they are refreshed by libraryScanFinished,
+        // so this connection is made first.
+        connect(m_pScanner.get(),
+                &LibraryScanner::scanFinished,
+                m_pInternalCollection,
+                &TrackCollection::multipleTracksChanged);
+
         // Forward signals
         connect(m_pScanner.get(),
                 &LibraryScanner::scanStarted,
@@ -40,6 +40,11 @@ class TrackCollectionManager: public QObject,
         return m_pInternalCollection;
     }
 
+    // For accessing the internal collection from other threads
+    const mixxx::DbConnectionPoolPtr& dbConnectionPool() const {
+        return m_pDbConnectionPool;
+    }
+
     const QList<ExternalTrackCollection*>& externalCollections() const {
         return m_externalCollections;
     }
@@ -96,6 +101,8 @@ class TrackCollectionManager: public QObject,
 
     const UserSettingsPointer m_pConfig;
 
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+
     const parented_ptr<TrackCollection> m_pInternalCollection;
 
     QList<ExternalTrackCollection*> m_externalCollections;
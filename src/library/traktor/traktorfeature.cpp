@@ -111,15 +111,26 @@ TraktorFeature::TraktorFeature(Library* pLibrary, UserSettingsPointer pConfig)
                  << m_database.lastError();
     }
     connect(&m_future_watcher,
-            &QFutureWatcher<TreeItem*>::finished,
+            &QFutureWatcher<bool>::finished,
             this,
             &TraktorFeature::onTrackCollectionLoaded);
+    connect(this,
+            &TraktorFeature::playlistItemsParsed,
+            this,
+            &TraktorFeature::slotPlaylistItemsParsed,
+            Qt::QueuedConnection);
+    connect(this,
+            &TraktorFeature::importProgress,
+            this,
+            &TraktorFeature::slotImportProgress,
+            Qt::QueuedConnection);
 }
 
 TraktorFeature::~TraktorFeature() {
     m_database.close();
     m_cancelImport = true;
     m_future.waitForFinished();
+    qDeleteAll(m_pendingPlaylistItems);
     delete m_pTraktorTableModel;
     delete m_pTraktorPlaylistModel;
 }
@@ -154,6 +165,8 @@ void TraktorFeature::activate() {
 
     if (!m_isActivated) {
         m_isActivated =  true;
+        // Playlists are added to the sidebar while they are parsed
+        m_childModel.setRootItem(TreeItem::newRoot(this));
         // Let a worker thread do the XML parsing
         m_future = QtConcurrent::run(this, &TraktorFeature::importLibrary,
                                      getTraktorMusicDatabase());
@@ -182,12 +195,36 @@ void TraktorFeature::activateChild(const QModelIndex& index) {
     }
 }
 
-TreeItem* TraktorFeature::importLibrary(QString file) {
+TraktorFeature::ImportContext::ImportContext(ImportBatchWriter* pWriter)
+        : pWriter(pWriter),
+          nextTrackId(1),
+          nextPlaylistId(1) {
+    libraryTableId = pWriter->addTable("traktor_library",
+            QStringList{
+                    "id",
+                    "artist",
+                    "title",
+                    "album",
+                    "year",
+                    "genre",
+                    "comment",
+                    "tracknumber",
+                    "bpm",
+                    "bitrate",
+                    "duration",
+                    "location",
+                    "rating",
+                    "key"});
+    playlistsTableId = pWriter->addTable("traktor_playlists",
+            QStringList{"id", "name"});
+    playlistTracksTableId = pWriter->addTable("traktor_playlist_tracks",
+            QStringList{"playlist_id", "track_id", "position"});
+}
+
+bool TraktorFeature::importLibrary(QString file) {
     //Give thread a low priority
     QThread* thisThread = QThread::currentThread();
     thisThread->setPriority(QThread::LowPriority);
-    //Invisible root item of Traktor's child model
-    TreeItem* root = NULL;
     //Delete all table entries of Traktor feature
     ScopedTransaction transaction(m_database);
     clearTable("traktor_playlist_tracks");
@@ -195,19 +232,21 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
     clearTable("traktor_playlists");
     transaction.commit();
 
-    transaction.transaction();
-    QSqlQuery query(m_database);
-    query.prepare("INSERT INTO traktor_library (artist, title, album, year,"
-                  "genre,comment,tracknumber,bpm, bitrate,duration, location,"
-                  "rating,key) VALUES (:artist, :title, :album, :year,:genre,"
-                  ":comment, :tracknumber,:bpm, :bitrate,:duration, :location,"
-                  ":rating,:key)");
+    // Rows are written on a separate thread while parsing. Ids are
+    // assigned explicitly, because playlist entries refer to tracks
+    // that have not been written yet.
+    ImportBatchWriter writer(
+            m_pLibrary->dbConnectionPool(),
+            [this](int rowCount, double rowsPerSecond) {
+                emit importProgress(rowCount, rowsPerSecond);
+            });
+    ImportContext context(&writer);
 
     //Parse Trakor XML file using SAX (for performance)
     QFile traktor_file(file);
     if (!traktor_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         qDebug() << "Cannot open Traktor music collection";
-        return NULL;
+        return false;
     }
     QXmlStreamReader xml(&traktor_file);
     bool inCollectionTag = false;
@@ -224,7 +263,7 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
             // Each "ENTRY" tag in <COLLECTION> represents a track
             if (inCollectionTag && xml.name() == "ENTRY") {
                 //parse track
-                parseTrack(xml, query);
+                parseTrack(xml, &context);
                 ++nAudioFiles; //increment number of files in the music collection
             }
             if (xml.name() == "PLAYLISTS") {
@@ -236,7 +275,7 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
 
                 if (nodetype == "FOLDER" && name == "$ROOT") {
                     //process all playlists
-                    root = parsePlaylists(xml);
+                    parsePlaylists(xml, &context);
                     isRootFolderParsed = true;
                 }
             }
@@ -250,22 +289,20 @@ TreeItem* TraktorFeature::importLibrary(QString file) {
             }
         }
     }
+
+    // Even if an error occurred, commit all rows that have been parsed
+    const bool success = writer.finish();
     if (xml.hasError()) {
          // do error handling
          qDebug() << "Cannot process Traktor music collection";
-         if (root)
-             delete root;
-         return NULL;
+         return false;
     }
 
     qDebug() << "Found: " << nAudioFiles << " audio files in Traktor";
-    //initialize TraktorTableModel
-    transaction.commit();
-
-    return root;
+    return success && !m_cancelImport;
 }
 
-void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
+void TraktorFeature::parseTrack(QXmlStreamReader &xml, ImportContext* pContext) {
     QString title;
     QString artist;
     QString album;
@@ -354,26 +391,27 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
 
     // If we reach the end of ENTRY within the COLLECTION tag
     // Save parsed track to database
-    query.bindValue(":artist", artist);
-    query.bindValue(":title", title);
-    query.bindValue(":album", album);
-    query.bindValue(":genre", genre);
-    query.bindValue(":year", year);
-    query.bindValue(":duration", playtime);
-    query.bindValue(":location", location);
-    query.bindValue(":rating", rating);
-    query.bindValue(":comment", comment);
-    query.bindValue(":tracknumber", tracknumber);
-    query.bindValue(":key", key);
-    query.bindValue(":bpm", bpm);
-    query.bindValue(":bitrate", bitrate);
-
-    bool success = query.exec();
-    if (!success) {
-        qDebug() << "SQL Error in TraktorTableModel.cpp: line"
-                 << __LINE__ << " " << query.lastError();
-        return;
+    const int trackId = pContext->nextTrackId++;
+    // Playlist entries refer to the first track with the same location
+    if (!pContext->trackIdsByLocation.contains(location)) {
+        pContext->trackIdsByLocation.insert(location, trackId);
     }
+    pContext->pWriter->addRow(pContext->libraryTableId,
+            QVariantList{
+                    trackId,
+                    artist,
+                    title,
+                    album,
+                    year,
+                    genre,
+                    comment,
+                    tracknumber,
+                    bpm,
+                    bitrate,
+                    playtime,
+                    location,
+                    rating,
+                    key});
 }
 
 // Purpose: Parsing all the folder and playlists of Traktor
@@ -381,7 +419,7 @@ void TraktorFeature::parseTrack(QXmlStreamReader &xml, QSqlQuery &query) {
 // A folder can contain folders and playlists. A playlist contains entries but no folders.
 // In other words, Traktor uses a tree structure to organize music.
 // Inner nodes represent folders while leaves are playlists.
-TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
+void TraktorFeature::parsePlaylists(QXmlStreamReader &xml, ImportContext* pContext) {
 
     qDebug() << "Process RootFolder";
     //Each playlist is unique and can be identified by a path in the tree structure.
@@ -390,17 +428,11 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
 
     QString delimiter = "-->";
 
-    std::unique_ptr<TreeItem> rootItem = TreeItem::newRoot(this);
-    TreeItem* parent = rootItem.get();
-
-    QSqlQuery query_insert_to_playlists(m_database);
-    query_insert_to_playlists.prepare("INSERT INTO traktor_playlists (name) "
-                  "VALUES (:name)");
-
-    QSqlQuery query_insert_to_playlist_tracks(m_database);
-    query_insert_to_playlist_tracks.prepare(
-        "INSERT INTO traktor_playlist_tracks (playlist_id, track_id, position) "
-        "VALUES (:playlist_id, :track_id, :position)");
+    // Top-level folders and playlists are added to the sidebar as soon
+    // as they have been parsed completely. The parent is null on the
+    // top level.
+    std::unique_ptr<TreeItem> pTopLevelItem;
+    TreeItem* parent = nullptr;
 
     while (!xml.atEnd() && !m_cancelImport) {
         //read next XML element
@@ -418,18 +450,25 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
                     current_path += name;
                     //qDebug() << "Folder: " +current_path << " has parent " << parent->getData().toString();
                     map.insert(current_path, "FOLDER");
-                    parent = parent->appendChild(name, current_path);
+                    if (parent) {
+                        parent = parent->appendChild(name, current_path);
+                    } else {
+                        pTopLevelItem = std::make_unique<TreeItem>(name, current_path);
+                        parent = pTopLevelItem.get();
+                    }
                } else if (type == "PLAYLIST") {
                     current_path += delimiter;
                     current_path += name;
                     //qDebug() << "Playlist: " +current_path << " has parent " << parent->getData().toString();
                     map.insert(current_path, "PLAYLIST");
 
-                    parent->appendChild(name, current_path);
+                    if (parent) {
+                        parent->appendChild(name, current_path);
+                    } else {
+                        pTopLevelItem = std::make_unique<TreeItem>(name, current_path);
+                    }
                     // process all the entries within the playlist 'name' having path 'current_path'
-                    parsePlaylistEntries(xml, current_path,
-                                         query_insert_to_playlists,
-                                         query_insert_to_playlist_tracks);
+                    parsePlaylistEntries(xml, current_path, pContext);
                 }
             }
         }
@@ -439,6 +478,9 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
                 if (map.value(current_path) == "FOLDER") {
                     parent = parent->parent();
                 }
+                if (!parent && pTopLevelItem) {
+                    addPlaylistItem(pTopLevelItem.release());
+                }
 
                 //Whenever we find a closing NODE, remove the last component of the path
                 int lastSlash = current_path.lastIndexOf (delimiter);
@@ -452,42 +494,17 @@ TreeItem* TraktorFeature::parsePlaylists(QXmlStreamReader &xml) {
             }
         }
     }
-    return rootItem.release();
 }
 
 void TraktorFeature::parsePlaylistEntries(
         QXmlStreamReader &xml,
         QString playlist_path,
-        QSqlQuery query_insert_into_playlist,
-        QSqlQuery query_insert_into_playlisttracks) {
+        ImportContext* pContext) {
     // In the database, the name of a playlist is specified by the unique path,
     // e.g., /someFolderA/someFolderB/playlistA"
-    query_insert_into_playlist.bindValue(":name", playlist_path);
-
-    if (!query_insert_into_playlist.exec()) {
-        LOG_FAILED_QUERY(query_insert_into_playlist)
-                << "Failed to insert playlist in TraktorTableModel:"
-                << playlist_path;
-        return;
-    }
-
-    // Get playlist id
-    QSqlQuery id_query(m_database);
-    id_query.prepare("select id from traktor_playlists where name=:path");
-    id_query.bindValue(":path", playlist_path);
-
-    if (!id_query.exec()) {
-        LOG_FAILED_QUERY(id_query) << "Could not get inserted playlist id for Traktor playlist::"
-                                   << playlist_path;
-        return;
-    }
-
-    //playlist_id = id_query.lastInsertId().toInt();
-    int playlist_id = -1;
-    const int idColumn = id_query.record().indexOf("id");
-    while (id_query.next()) {
-        playlist_id = id_query.value(idColumn).toInt();
-    }
+    const int playlist_id = pContext->nextPlaylistId++;
+    pContext->pWriter->addRow(pContext->playlistsTableId,
+            QVariantList{playlist_id, playlist_path});
 
     int playlist_position = 1;
     while (!xml.atEnd() && !m_cancelImport) {
@@ -505,28 +522,12 @@ void TraktorFeature::parsePlaylistEntries(
                     #endif
 
                     //insert to database
-                    int track_id = -1;
-                    QSqlQuery finder_query(m_database);
-                    finder_query.prepare("select id from traktor_library where location=:path");
-                    finder_query.bindValue(":path", key);
-
-                    if (!finder_query.exec()) {
-                        LOG_FAILED_QUERY(finder_query) << "Could not get track id:" << key;
-                        continue;
-                    }
-
-                    if (finder_query.next()) {
-                        track_id = finder_query.value(finder_query.record().indexOf("id")).toInt();
-                    }
-
-                    query_insert_into_playlisttracks.bindValue(":playlist_id", playlist_id);
-                    query_insert_into_playlisttracks.bindValue(":track_id", track_id);
-                    query_insert_into_playlisttracks.bindValue(":position", playlist_position++);
-                    if (!query_insert_into_playlisttracks.exec()) {
-                        LOG_FAILED_QUERY(query_insert_into_playlisttracks)
-                                << "trackid" << track_id << " with path " << key
-                                << "playlistname; " << playlist_path <<" with ID " << playlist_id;
-                    }
+                    const int track_id = pContext->trackIdsByLocation.value(key, -1);
+                    pContext->pWriter->addRow(pContext->playlistTracksTableId,
+                            QVariantList{
+                                    playlist_id,
+                                    track_id,
+                                    playlist_position++});
                 }
             }
         }
@@ -539,6 +540,13 @@ void TraktorFeature::parsePlaylistEntries(
     }
 }
 
+void TraktorFeature::addPlaylistItem(TreeItem* pItem) {
+    QMutexLocker locker(&m_pendingPlaylistItemsMutex);
+    m_pendingPlaylistItems.append(pItem);
+    locker.unlock();
+    emit playlistItemsParsed();
+}
+
 void TraktorFeature::clearTable(QString table_name) {
     QSqlQuery query(m_database);
     query.prepare("delete from "+table_name);
@@ -602,10 +610,28 @@ QString TraktorFeature::getTraktorMusicDatabase() {
     return musicFolder;
 }
 
+void TraktorFeature::slotPlaylistItemsParsed() {
+    QList<TreeItem*> items;
+    QMutexLocker locker(&m_pendingPlaylistItemsMutex);
+    items.swap(m_pendingPlaylistItems);
+    locker.unlock();
+    m_childModel.insertTreeItemRows(items, m_childModel.rowCount());
+}
+
+void TraktorFeature::slotImportProgress(int rowCount, double rowsPerSecond) {
+    if (m_future.isFinished()) {
+        return;
+    }
+    m_title = tr("(loading) Traktor: %1 rows, %2 rows/s")
+                      .arg(QString::number(rowCount),
+                              QString::number(qRound(rowsPerSecond)));
+    emit featureIsLoading(this, false);
+}
+
 void TraktorFeature::onTrackCollectionLoaded() {
-    std::unique_ptr<TreeItem> root(m_future.result());
-    if (root) {
-        m_childModel.setRootItem(std::move(root));
+    // Add the remaining playlists
+    slotPlaylistItemsParsed();
+    if (m_future.result()) {
         // Tell the traktor track source that it should re-build its index.
         m_trackSource->buildIndex();
 
@@ -10,10 +10,14 @@
 #include <QFuture>
 #include <QtConcurrentRun>
 #include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <atomic>
 
 #include "library/baseexternallibraryfeature.h"
 #include "library/baseexternaltrackmodel.h"
 #include "library/baseexternalplaylistmodel.h"
+#include "library/importbatchwriter.h"
 #include "library/treeitemmodel.h"
 
 class TraktorTrackModel : public BaseExternalTrackModel {
@@ -50,16 +54,42 @@ class TraktorFeature : public BaseExternalLibraryFeature {
     void refreshLibraryModels();
     void onTrackCollectionLoaded();
 
+  signals:
+    // Emitted from the worker threads of the import
+    void playlistItemsParsed();
+    void importProgress(int rowCount, double rowsPerSecond);
+
+  private slots:
+    void slotPlaylistItemsParsed();
+    void slotImportProgress(int rowCount, double rowsPerSecond);
+
   private:
+    // The tables of the Traktor library and the ids that are assigned
+    // while parsing, only accessed by the import thread
+    struct ImportContext {
+        explicit ImportContext(ImportBatchWriter* pWriter);
+
+        ImportBatchWriter* const pWriter;
+        int libraryTableId;
+        int playlistsTableId;
+        int playlistTracksTableId;
+        int nextTrackId;
+        int nextPlaylistId;
+        QHash<QString, int> trackIdsByLocation;
+    };
+
     BaseSqlTableModel* getPlaylistModelForPlaylist(QString playlist) override;
-    TreeItem* importLibrary(QString file);
+    // Returns false if the library could not be imported completely
+    bool importLibrary(QString file);
     // parses a track in the music collection
-    void parseTrack(QXmlStreamReader &xml, QSqlQuery &query);
-    // Iterates over all playliost and folders and constructs the childmodel
-    TreeItem* parsePlaylists(QXmlStreamReader &xml);
+    void parseTrack(QXmlStreamReader &xml, ImportContext* pContext);
+    // Iterates over all playliost and folders and passes the completed
+    // top-level items of the childmodel to addPlaylistItem()
+    void parsePlaylists(QXmlStreamReader &xml, ImportContext* pContext);
     // processes a particular playlist
     void parsePlaylistEntries(QXmlStreamReader &xml, QString playlist_path,
-    QSqlQuery query_insert_into_playlist, QSqlQuery query_insert_into_playlisttracks);
+            ImportContext* pContext);
+    void addPlaylistItem(TreeItem* pItem);
     void clearTable(QString table_name);
     static QString getTraktorMusicDatabase();
     // private fields
@@ -70,11 +100,15 @@ class TraktorFeature : public BaseExternalLibraryFeature {
     TraktorPlaylistModel* m_pTraktorPlaylistModel;
 
     bool m_isActivated;
-    bool m_cancelImport;
-    QFutureWatcher<TreeItem*> m_future_watcher;
-    QFuture<TreeItem*> m_future;
+    std::atomic<bool> m_cancelImport;
+    QFutureWatcher<bool> m_future_watcher;
+    QFuture<bool> m_future;
     QString m_title;
 
+    // Playlists that have been parsed but not yet added to m_childModel
+    QMutex m_pendingPlaylistItemsMutex;
+    QList<TreeItem*> m_pendingPlaylistItems;
+
     QSharedPointer<BaseTrackCache> m_trackSource;
     QIcon m_icon;
 };
@@ -45,6 +45,10 @@ int runMixxx(MixxxApplication* app, const CmdlineArgs& args) {
     // Qt event loop.
     if (ErrorDialogHandler::instance()->checkError()) {
         mainWindow.finalize();
+    } else if (args.getRenderEnabled()) {
+        qDebug() << "Rendering the mix";
+        result = mainWindow.renderMix(args.getRenderTimelinePath(),
+                args.getRenderOutputPath()) ? 0 : 1;
     } else {
         qDebug() << "Displaying main window";
         mainWindow.show();
@@ -19,7 +19,9 @@
 
 #include <QDesktopServices>
 #include <QDesktopWidget>
+#include <QFile>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QGLFormat>
 #include <QGLWidget>
 #include <QGuiApplication>
@@ -35,6 +37,7 @@
 #include "effects/builtin/builtinbackend.h"
 #include "effects/effectsmanager.h"
 #include "engine/enginemaster.h"
+#include "engine/enginerenderer.h"
 #include "preferences/constants.h"
 #include "preferences/dialog/dlgprefeq.h"
 #include "preferences/dialog/dlgpreferences.h"
@@ -61,6 +64,7 @@
 #include "soundio/soundmanager.h"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "track/trackref.h"
 #include "util/compatibility.h"
 #include "util/db/dbconnectionpooled.h"
 #include "util/debug.h"
@@ -210,6 +214,7 @@ MixxxMainWindow::~MixxxMainWindow() {
 
 void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     ScopedTimer t("MixxxMainWindow::initialize");
+    m_startupPhaseTimer.start();
 
 #if defined(Q_OS_LINUX)
     // XESetWireToError will segfault if running as a Wayland client
@@ -351,7 +356,8 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     delete pModplugPrefs; // not needed anymore
 #endif
 
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance()->setThumbnailPath(
+            QDir(pConfig->getSettingsPath()).filePath("coverart"));
 
     launchProgress(30);
 
@@ -578,38 +584,42 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // https://bugs.launchpad.net/mixxx/+bug/1758189
     m_pPlayerManager->loadSamplers();
 
-    // Try open player device If that fails, the preference panel is opened.
-    bool retryClicked;
-    do {
-        retryClicked = false;
-        SoundDeviceError result = m_pSoundManager->setupDevices();
-        if (result == SOUNDDEVICE_ERROR_DEVICE_COUNT ||
-                result == SOUNDDEVICE_ERROR_EXCESSIVE_OUTPUT_CHANNEL) {
-            if (soundDeviceBusyDlg(&retryClicked) != QDialog::Accepted) {
-                exit(0);
+    // The engine is clocked by renderMix() instead of a sound device
+    // when rendering a mix.
+    if (!args.getRenderEnabled()) {
+        // Try open player device If that fails, the preference panel is opened.
+        bool retryClicked;
+        do {
+            retryClicked = false;
+            SoundDeviceError result = m_pSoundManager->setupDevices();
+            if (result == SOUNDDEVICE_ERROR_DEVICE_COUNT ||
+                    result == SOUNDDEVICE_ERROR_EXCESSIVE_OUTPUT_CHANNEL) {
+                if (soundDeviceBusyDlg(&retryClicked) != QDialog::Accepted) {
+                    exit(0);
+                }
+            } else if (result != SOUNDDEVICE_ERROR_OK) {
+                if (soundDeviceErrorMsgDlg(result, &retryClicked) !=
+                        QDialog::Accepted) {
+                    exit(0);
+                }
             }
-        } else if (result != SOUNDDEVICE_ERROR_OK) {
-            if (soundDeviceErrorMsgDlg(result, &retryClicked) !=
-                    QDialog::Accepted) {
+        } while (retryClicked);
+
+        // test for at least one out device, if none, display another dlg that
+        // says "mixxx will barely work with no outs"
+        // In case persisting errors, the user has already received a message
+        // box from the preferences dialog above. So we can watch here just the
+        // output count.
+        while (m_pSoundManager->getConfig().getOutputs().count() == 0) {
+            // Exit when we press the Exit button in the noSoundDlg dialog
+            // only call it if result != OK
+            bool continueClicked = false;
+            if (noOutputDlg(&continueClicked) != QDialog::Accepted) {
                 exit(0);
             }
+            if (continueClicked) break;
         }
-    } while (retryClicked);
-
-    // test for at least one out device, if none, display another dlg that
-    // says "mixxx will barely work with no outs"
-    // In case persisting errors, the user has already received a message
-    // box from the preferences dialog above. So we can watch here just the
-    // output count.
-    while (m_pSoundManager->getConfig().getOutputs().count() == 0) {
-        // Exit when we press the Exit button in the noSoundDlg dialog
-        // only call it if result != OK
-        bool continueClicked = false;
-        if (noOutputDlg(&continueClicked) != QDialog::Accepted) {
-            exit(0);
-        }
-        if (continueClicked) break;
-   }
+    }
 
     // Load tracks in args.qlMusicFiles (command line arguments) into player
     // 1 and 2:
@@ -638,6 +648,74 @@ void MixxxMainWindow::initialize(QApplication* pApp, const CmdlineArgs& args) {
     // The launch image widget is automatically disposed, but we still have a
     // pointer to it.
     m_pLaunchImage = nullptr;
+
+    int previousProgress = 0;
+    for (const auto& phase : m_startupPhases) {
+        qDebug() << "Startup phase" << previousProgress << "% to" << phase.first
+                 << "% took" << phase.second.formatMillisWithUnit();
+        previousProgress = phase.first;
+    }
+    qDebug() << "Startup phase after the launch image took"
+             << m_startupPhaseTimer.elapsed().formatMillisWithUnit();
+    m_startupPhases.clear();
+}
+
+bool MixxxMainWindow::renderMix(const QString& timelinePath,
+        const QString& outputPath) {
+    QFile timelineFile(timelinePath);
+    if (!timelineFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Failed to open the render timeline" << timelinePath;
+        return false;
+    }
+    // The format is chosen by the file extension, e.g. .wav or .flac
+    const QString suffix = QFileInfo(outputPath).suffix().toLower();
+    const QList<Encoder::Format> formats = EncoderFactory::getFactory().getFormats();
+    const Encoder::Format* pFormat = nullptr;
+    for (const auto& format : formats) {
+        if (format.internalName.toLower() == suffix) {
+            pFormat = &format;
+        }
+    }
+    if (!pFormat) {
+        qWarning() << "Unsupported render output" << outputPath;
+        return false;
+    }
+
+    // Files are relative to the timeline
+    const QDir timelineDir = QFileInfo(timelinePath).absoluteDir();
+    const double sampleRate =
+            ControlObject::get(ConfigKey("[Master]", "samplerate"));
+    EngineRenderTimeline timeline;
+    SINT numFrames = 0;
+    QString error;
+    if (!timeline.parse(QString::fromUtf8(timelineFile.readAll()),
+                sampleRate,
+                [this, &timelineDir](const QString& location) {
+                    return m_pTrackCollectionManager->getOrAddTrack(
+                            TrackRef::fromFileInfo(
+                                    timelineDir.absoluteFilePath(location)));
+                },
+                &numFrames,
+                &error)) {
+        qWarning() << "Failed to parse the render timeline" << timelinePath
+                   << error;
+        return false;
+    }
+
+    EngineRenderer renderer(m_pEngine, m_pPlayerManager);
+    if (!renderer.renderToFile(timeline,
+                numFrames,
+                AudioOutput(AudioOutput::MASTER, 0, 2),
+                outputPath,
+                *pFormat,
+                m_pSettingsManager->settings())) {
+        qWarning() << "Failed to render" << timelinePath << "into" << outputPath;
+        return false;
+    }
+    qDebug() << "Rendered" << outputPath << "in"
+             << renderer.renderDuration().formatMillisWithUnit() << "at"
+             << renderer.realTimeFactor() << "times real time";
+    return true;
 }
 
 void MixxxMainWindow::finalize() {
@@ -1652,6 +1730,8 @@ mixxx::ScreenSaverPreference MixxxMainWindow::getInhibitScreensaver()
 
 void MixxxMainWindow::launchProgress(int progress) {
     if (m_pLaunchImage) {
+        // Each step of the progress bar completes a phase of the startup
+        m_startupPhases.append(qMakePair(progress, m_startupPhaseTimer.restart()));
         m_pLaunchImage->progress(progress);
     }
     qApp->processEvents();
@@ -18,7 +18,9 @@
 #ifndef MIXXX_H
 #define MIXXX_H
 
+#include <QList>
 #include <QMainWindow>
+#include <QPair>
 #include <QSharedPointer>
 #include <QString>
 
@@ -68,6 +70,10 @@ class MixxxMainWindow : public QMainWindow {
 
     void finalize();
 
+    // Renders the mix of a timeline script (see --renderTimeline) into
+    // a file without a sound device. Returns false on errors.
+    bool renderMix(const QString& timelinePath, const QString& outputPath);
+
     // creates the menu_bar and inserts the file Menu
     void createMenuBar();
     void connectMenuBar();
@@ -196,6 +202,10 @@ class MixxxMainWindow : public QMainWindow {
     mixxx::TooltipsPreference m_toolTipsCfg;
     // Timer that tracks how long Mixxx has been running.
     Timer m_runtime_timer;
+    // The duration of each startup phase that ends with the given launch
+    // progress
+    PerformanceTimer m_startupPhaseTimer;
+    QList<QPair<int, mixxx::Duration>> m_startupPhases;
 
     const CmdlineArgs& m_cmdLineArgs;
 
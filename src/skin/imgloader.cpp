@@ -3,12 +3,18 @@
 #include <QFileInfo>
 
 #include "imgloader.h"
+#include "skin/skinimagepreloader.h"
 #include "widget/wwidget.h"
 
 ImgLoader::ImgLoader() {
 }
 
 QImage* ImgLoader::getImage(const QString& fileName, double scaleFactor) const {
+    QImage preloadedImage;
+    if (SkinImagePreloader::findImage(fileName, scaleFactor, &preloadedImage)) {
+        return new QImage(preloadedImage);
+    }
+
     QImage* pImage = new QImage();
     QFileInfo info(fileName);
     if (scaleFactor > 2.0) {
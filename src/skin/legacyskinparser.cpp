@@ -26,6 +26,8 @@
 
 #include "skin/colorschemeparser.h"
 #include "skin/skincontext.h"
+#include "skin/skindocumentcache.h"
+#include "skin/skinimagepreloader.h"
 #include "skin/launchimage.h"
 
 #include "effects/effectsmanager.h"
@@ -313,12 +315,22 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     if (m_pParent) {
         qDebug() << "ERROR: Somehow a parent already exists -- you are probably re-using a LegacySkinParser which is not advisable!";
     }
-    QDomElement skinDocument = openSkin(skinPath);
 
-    if (skinDocument.isNull()) {
+    PerformanceTimer phaseTimer;
+    phaseTimer.start();
+    m_pDocumentCache = std::make_unique<SkinDocumentCache>(
+            QDir(m_pConfig->getSettingsPath()).filePath("skincache"));
+    if (!m_pDocumentCache->load(skinPath, m_pContext->getScaleFactor())) {
         qDebug() << "LegacySkinParser::parseSkin - failed for skin:" << skinPath;
         return NULL;
     }
+    QDomElement skinDocument = m_pDocumentCache->skinDocument();
+    const mixxx::Duration documentsDuration = phaseTimer.restart();
+
+    // Decode the images while the skin attributes and color schemes are
+    // set up. The preloaded images are discarded when leaving this scope.
+    SkinImagePreloader imagePreloader;
+    imagePreloader.start(m_pDocumentCache->imagePaths(), m_pContext->getScaleFactor());
 
     SkinManifest manifest = getSkinManifest(skinDocument);
 
@@ -380,6 +392,10 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     }
 
     ColorSchemeParser::setupLegacyColorSchemes(skinDocument, m_pConfig, &m_style, m_pContext.get());
+    const mixxx::Duration attributesDuration = phaseTimer.restart();
+
+    imagePreloader.waitForFinished();
+    const mixxx::Duration imagesDuration = phaseTimer.restart();
 
     // don't parent till here so the first opengl waveform doesn't screw
     // up --bkgood
@@ -388,6 +404,15 @@ QWidget* LegacySkinParser::parseSkin(const QString& skinPath, QWidget* pParent)
     // (fullscreen mostly) --bkgood
     m_pParent = pParent;
     QList<QWidget*> widgets = parseNode(skinDocument);
+    const mixxx::Duration widgetsDuration = phaseTimer.elapsed();
+
+    qDebug() << "LegacySkinParser::parseSkin phases:"
+             << "documents" << documentsDuration.formatMillisWithUnit()
+             << (m_pDocumentCache->isLoadedFromCacheFile() ? "(cached)" : "(cold)")
+             << "attributes" << attributesDuration.formatMillisWithUnit()
+             << "waiting for" << SkinImagePreloader::imageCount() << "images"
+             << imagesDuration.formatMillisWithUnit()
+             << "widgets" << widgetsDuration.formatMillisWithUnit();
 
     if (widgets.empty()) {
         SKIN_WARNING(skinDocument, *m_pContext) << "Skin produced no widgets!";
@@ -1474,6 +1499,15 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         return it.value();
     }
 
+    if (m_pDocumentCache) {
+        const QDomElement templateNode = m_pDocumentCache->templateDocument(absolutePath);
+        if (!templateNode.isNull()) {
+            m_templateCache[absolutePath] = templateNode;
+            m_pContext->setSkinTemplatePath(templateFileInfo.absoluteDir().absolutePath());
+            return templateNode;
+        }
+    }
+
     QFile templateFile(absolutePath);
 
     if (!templateFile.open(QIODevice::ReadOnly)) {
@@ -22,6 +22,7 @@ class EffectsManager;
 class RecordingManager;
 class ControllerManager;
 class SkinContext;
+class SkinDocumentCache;
 class WLabel;
 class ControlObject;
 class LaunchImage;
@@ -147,6 +148,8 @@ class LegacySkinParser : public QObject, public SkinParser {
     RecordingManager* m_pRecordingManager;
     QWidget* m_pParent;
     std::unique_ptr<SkinContext> m_pContext;
+    // skin.xml and the templates, parsed before the widgets are created
+    std::unique_ptr<SkinDocumentCache> m_pDocumentCache;
     QString m_style;
     Tooltips m_tooltips;
     QHash<QString, QDomElement> m_templateCache;
@@ -0,0 +1,275 @@
+#include "skin/skindocumentcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrentMap>
+
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SkinDocumentCache");
+
+const quint32 kCacheFileMagic = 0x4d534b43; // "MSKC"
+// Increment whenever the contents of the cache file change
+const qint32 kCacheFileVersion = 1;
+
+const QString kSkinFileName = QStringLiteral("skin.xml");
+const QString kSkinSearchPathPrefix = QStringLiteral("skin:");
+
+const QRegularExpression kImageFileRegex(
+        QStringLiteral("\\.(png|svg|jpg|jpeg|gif|bmp)$"),
+        QRegularExpression::CaseInsensitiveOption);
+
+QStringList findSkinFiles(const QString& skinPath) {
+    QStringList filePaths;
+    QDirIterator it(skinPath,
+            QStringList{QStringLiteral("*.xml")},
+            QDir::Files | QDir::Readable,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString filePath = QFileInfo(it.next()).canonicalFilePath();
+        if (!filePath.isEmpty()) {
+            filePaths.append(filePath);
+        }
+    }
+    filePaths.sort();
+    return filePaths;
+}
+
+// Any modification of the skin files results in a different key
+QByteArray cacheKey(
+        const QString& skinPath,
+        double scaleFactor,
+        const QStringList& filePaths) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(skinPath.toUtf8());
+    hash.addData(QByteArray::number(scaleFactor));
+    for (const auto& filePath : filePaths) {
+        const QFileInfo fileInfo(filePath);
+        hash.addData(filePath.toUtf8());
+        hash.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
+        hash.addData(QByteArray::number(fileInfo.size()));
+    }
+    return hash.result();
+}
+
+void collectImageReference(const QString& value, QSet<QString>* pReferences) {
+    const QString reference = value.trimmed();
+    if (!reference.isEmpty() && kImageFileRegex.match(reference).hasMatch()) {
+        pReferences->insert(reference);
+    }
+}
+
+void collectImageReferences(const QDomElement& element, QSet<QString>* pReferences) {
+    const QDomNamedNodeMap attributes = element.attributes();
+    for (int i = 0; i < attributes.count(); ++i) {
+        collectImageReference(attributes.item(i).nodeValue(), pReferences);
+    }
+    for (QDomNode child = element.firstChild();
+            !child.isNull();
+            child = child.nextSibling()) {
+        if (child.isElement()) {
+            collectImageReferences(child.toElement(), pReferences);
+        } else if (child.isText()) {
+            collectImageReference(child.nodeValue(), pReferences);
+        }
+    }
+}
+
+} // anonymous namespace
+
+SkinDocumentCache::SkinDocumentCache(const QString& cacheDirPath)
+        : m_cacheDirPath(cacheDirPath),
+          m_loadedFromCacheFile(false) {
+}
+
+QString SkinDocumentCache::cacheFilePath(const QString& skinPath) const {
+    if (m_cacheDirPath.isEmpty()) {
+        return QString();
+    }
+    const QByteArray skinPathHash = QCryptographicHash::hash(
+            QFileInfo(skinPath).absoluteFilePath().toUtf8(),
+            QCryptographicHash::Sha1);
+    return QDir(m_cacheDirPath).filePath(
+            QString::fromLatin1(skinPathHash.toHex()) + QStringLiteral(".skincache"));
+}
+
+bool SkinDocumentCache::load(const QString& skinPath, double scaleFactor) {
+    m_loadedFromCacheFile = false;
+    m_sources.clear();
+    m_skinDocument = QDomElement();
+    m_templateDocuments.clear();
+    m_imagePaths.clear();
+
+    const QString skinFilePath =
+            QFileInfo(QDir(skinPath).filePath(kSkinFileName)).canonicalFilePath();
+    if (skinFilePath.isEmpty()) {
+        kLogger.warning() << "Missing" << kSkinFileName << "in" << skinPath;
+        return false;
+    }
+
+    const QStringList filePaths = findSkinFiles(skinPath);
+    const QByteArray key = cacheKey(skinPath, scaleFactor, filePaths);
+    const QString cacheFile = cacheFilePath(skinPath);
+    if (!cacheFile.isEmpty()) {
+        m_loadedFromCacheFile = readCacheFile(cacheFile, key);
+    }
+    if (!m_loadedFromCacheFile && !readSkinFiles(filePaths)) {
+        return false;
+    }
+
+    // The documents are independent of each other
+    const QList<QDomDocument> documents =
+            QtConcurrent::blockingMapped(m_sources, &SkinDocumentCache::parseSource);
+    for (int i = 0; i < m_sources.size(); ++i) {
+        const QDomElement documentElement = documents[i].documentElement();
+        if (m_sources[i].filePath == skinFilePath) {
+            m_skinDocument = documentElement;
+        } else if (!documentElement.isNull()) {
+            m_templateDocuments.insert(m_sources[i].filePath, documentElement);
+        }
+    }
+    if (m_skinDocument.isNull()) {
+        return false;
+    }
+
+    if (!m_loadedFromCacheFile) {
+        findImagePaths(skinPath, documents);
+        if (!cacheFile.isEmpty()) {
+            writeCacheFile(cacheFile, key);
+        }
+    }
+    return true;
+}
+
+QDomElement SkinDocumentCache::templateDocument(const QString& filePath) const {
+    return m_templateDocuments.value(QFileInfo(filePath).canonicalFilePath());
+}
+
+bool SkinDocumentCache::readCacheFile(
+        const QString& cacheFilePath, const QByteArray& key) {
+    QFile file(cacheFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint32 magic;
+    qint32 version;
+    QByteArray fileKey;
+    in >> magic >> version >> fileKey;
+    if (magic != kCacheFileMagic || version != kCacheFileVersion || fileKey != key) {
+        // Outdated, the file will be overwritten
+        return false;
+    }
+    quint32 sourceCount;
+    in >> sourceCount;
+    QList<Source> sources;
+    sources.reserve(sourceCount);
+    for (quint32 i = 0; i < sourceCount && in.status() == QDataStream::Ok; ++i) {
+        Source source;
+        in >> source.filePath >> source.contents;
+        sources.append(source);
+    }
+    QStringList imagePaths;
+    in >> imagePaths;
+    if (in.status() != QDataStream::Ok) {
+        kLogger.warning() << "Corrupt cache file" << cacheFilePath;
+        return false;
+    }
+    m_sources = sources;
+    m_imagePaths = imagePaths;
+    return true;
+}
+
+bool SkinDocumentCache::readSkinFiles(const QStringList& filePaths) {
+    for (const auto& filePath : filePaths) {
+        QFile file(filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            kLogger.warning() << "Failed to open" << filePath;
+            continue;
+        }
+        Source source;
+        source.filePath = filePath;
+        source.contents = file.readAll();
+        m_sources.append(source);
+    }
+    return !m_sources.isEmpty();
+}
+
+void SkinDocumentCache::writeCacheFile(
+        const QString& cacheFilePath, const QByteArray& key) const {
+    if (!QDir().mkpath(QFileInfo(cacheFilePath).absolutePath())) {
+        kLogger.warning() << "Failed to create the directory of" << cacheFilePath;
+        return;
+    }
+    // Replaces the previous file atomically
+    QSaveFile file(cacheFilePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to write" << cacheFilePath;
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << kCacheFileMagic << kCacheFileVersion << key;
+    out << static_cast<quint32>(m_sources.size());
+    for (const auto& source : m_sources) {
+        out << source.filePath << source.contents;
+    }
+    out << m_imagePaths;
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        kLogger.warning() << "Failed to write" << cacheFilePath;
+    }
+}
+
+void SkinDocumentCache::findImagePaths(
+        const QString& skinPath, const QList<QDomDocument>& documents) {
+    QSet<QString> references;
+    for (const auto& document : documents) {
+        const QDomElement documentElement = document.documentElement();
+        if (!documentElement.isNull()) {
+            collectImageReferences(documentElement, &references);
+        }
+    }
+
+    const QDir skinDir(skinPath);
+    QSet<QString> imagePaths;
+    for (auto reference : references) {
+        // Same as SkinContext::makeSkinPath() with the skin directory
+        // as the only search path
+        if (reference.startsWith(kSkinSearchPathPrefix)) {
+            reference = reference.mid(kSkinSearchPathPrefix.size());
+        }
+        const QFileInfo fileInfo(skinDir.filePath(reference));
+        if (fileInfo.isFile()) {
+            imagePaths.insert(fileInfo.canonicalFilePath());
+        }
+    }
+    m_imagePaths = imagePaths.values();
+    m_imagePaths.sort();
+}
+
+// static
+QDomDocument SkinDocumentCache::parseSource(const Source& source) {
+    QDomDocument document;
+    QString errorMessage;
+    int errorLine;
+    int errorColumn;
+    if (!document.setContent(source.contents, &errorMessage, &errorLine, &errorColumn)) {
+        kLogger.warning() << "Failed to parse" << source.filePath
+                          << "line:" << errorLine
+                          << "column:" << errorColumn
+                          << "message:" << errorMessage;
+        return QDomDocument();
+    }
+    return document;
+}
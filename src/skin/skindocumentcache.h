@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDomElement>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+// The XML documents of a skin, i.e. skin.xml and all templates in the
+// skin directory, which are parsed in parallel on the global thread pool.
+//
+// The contents of all documents are stored in a single cache file per skin
+// together with the images they refer to. The cache file is invalidated
+// when one of the XML files has been modified, added or removed or when
+// the skin is loaded with a different scale factor.
+class SkinDocumentCache final {
+  public:
+    // An empty cacheDirPath disables the cache file
+    explicit SkinDocumentCache(const QString& cacheDirPath);
+
+    // Returns false if skin.xml could not be parsed
+    bool load(const QString& skinPath, double scaleFactor);
+
+    // Whether the documents have been restored from the cache file
+    bool isLoadedFromCacheFile() const {
+        return m_loadedFromCacheFile;
+    }
+
+    QDomElement skinDocument() const {
+        return m_skinDocument;
+    }
+
+    // Returns a null element if the file is not part of the skin or
+    // could not be parsed
+    QDomElement templateDocument(const QString& filePath) const;
+
+    // The canonical paths of all existing image files that are referred
+    // to by the documents. Images with paths that are composed of skin
+    // variables are not included.
+    const QStringList& imagePaths() const {
+        return m_imagePaths;
+    }
+
+    QString cacheFilePath(const QString& skinPath) const;
+
+  private:
+    struct Source {
+        // Canonical path
+        QString filePath;
+        QByteArray contents;
+    };
+
+    bool readCacheFile(const QString& cacheFilePath, const QByteArray& key);
+    bool readSkinFiles(const QStringList& filePaths);
+    void writeCacheFile(const QString& cacheFilePath, const QByteArray& key) const;
+    void findImagePaths(const QString& skinPath, const QList<QDomDocument>& documents);
+
+    static QDomDocument parseSource(const Source& source);
+
+    const QString m_cacheDirPath;
+
+    bool m_loadedFromCacheFile;
+    QList<Source> m_sources;
+    QDomElement m_skinDocument;
+    QHash<QString, QDomElement> m_templateDocuments;
+    QStringList m_imagePaths;
+};
@@ -0,0 +1,111 @@
+#include "skin/skinimagepreloader.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QtConcurrentRun>
+
+#include "skin/imgloader.h"
+#include "util/assert.h"
+#include "util/memory.h"
+
+namespace {
+
+QMutex s_mutex;
+// Decoded images by canonical path and scale factor
+QHash<QString, QImage> s_images;
+bool s_active = false;
+
+QString imageKey(const QString& canonicalFilePath, double scaleFactor) {
+    return canonicalFilePath + QChar('@') + QString::number(scaleFactor);
+}
+
+} // anonymous namespace
+
+SkinImagePreloader::SkinImagePreloader() {
+    QMutexLocker locker(&s_mutex);
+    DEBUG_ASSERT(!s_active);
+    s_active = true;
+}
+
+SkinImagePreloader::~SkinImagePreloader() {
+    m_futures.waitForFinished();
+    QMutexLocker locker(&s_mutex);
+    s_images.clear();
+    s_active = false;
+}
+
+void SkinImagePreloader::start(const QStringList& imagePaths, double scaleFactor) {
+    for (const auto& imagePath : imagePaths) {
+        m_futures.addFuture(QtConcurrent::run(
+                &SkinImagePreloader::preloadImage, imagePath, scaleFactor));
+    }
+}
+
+void SkinImagePreloader::waitForFinished() {
+    m_futures.waitForFinished();
+}
+
+// static
+int SkinImagePreloader::imageCount() {
+    QMutexLocker locker(&s_mutex);
+    return s_images.size();
+}
+
+// static
+bool SkinImagePreloader::findImage(
+        const QString& fileName,
+        double scaleFactor,
+        QImage* pImage) {
+    QMutexLocker locker(&s_mutex);
+    if (s_images.isEmpty()) {
+        // Avoid resolving the path while no skin is loaded
+        return false;
+    }
+    locker.unlock();
+    const QString canonicalFilePath = QFileInfo(fileName).canonicalFilePath();
+    if (canonicalFilePath.isEmpty()) {
+        return false;
+    }
+    locker.relock();
+    const auto it = s_images.constFind(imageKey(canonicalFilePath, scaleFactor));
+    if (it == s_images.constEnd()) {
+        return false;
+    }
+    // Implicitly shared
+    *pImage = it.value();
+    return true;
+}
+
+// static
+void SkinImagePreloader::preloadImage(const QString& imagePath, double scaleFactor) {
+    QImage image;
+    if (imagePath.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive)) {
+        QSvgRenderer renderer;
+        if (!renderer.load(imagePath)) {
+            // The above line already logs a warning
+            return;
+        }
+        image = QImage(renderer.defaultSize() * scaleFactor, QImage::Format_ARGB32);
+        image.fill(0x00000000); // Transparent black.
+        QPainter painter(&image);
+        renderer.render(&painter);
+    } else {
+        const ImgLoader loader;
+        const auto pImage = std::unique_ptr<QImage>(
+                loader.getImage(imagePath, scaleFactor));
+        if (pImage) {
+            image = *pImage;
+        }
+    }
+    if (image.isNull()) {
+        return;
+    }
+    QMutexLocker locker(&s_mutex);
+    if (s_active) {
+        s_images.insert(imageKey(imagePath, scaleFactor), image);
+    }
+}
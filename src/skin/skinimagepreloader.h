@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QFutureSynchronizer>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+
+// Decodes the images of a skin on the global thread pool while the skin
+// is being prepared on the GUI thread, before any widgets are created.
+//
+// Raster images are decoded by ImgLoader. SVG images are rendered with
+// their default size like Paintable and WImageStore do when they need a
+// pixmap. Both pick up the preloaded images instead of loading them again
+// from disk. Only a single preloader may exist at a time.
+class SkinImagePreloader final {
+  public:
+    SkinImagePreloader();
+    // Waits for pending images and discards all preloaded images
+    ~SkinImagePreloader();
+
+    void start(const QStringList& imagePaths, double scaleFactor);
+    void waitForFinished();
+
+    // The number of images that have been decoded successfully
+    static int imageCount();
+
+    // Returns false if the image has not been preloaded. Thread-safe.
+    static bool findImage(
+            const QString& fileName,
+            double scaleFactor,
+            QImage* pImage);
+
+  private:
+    static void preloadImage(const QString& imagePath, double scaleFactor);
+
+    QFutureSynchronizer<void> m_futures;
+};
@@ -13,6 +13,7 @@
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/callbackprofiler.h"
 #include "util/logger.h"
 #include "util/sample.h"
 
@@ -407,6 +408,8 @@ void SoundDeviceNetwork::callbackProcessClkRef() {
     // This must be the very first call, to measure an exact value
     updateCallbackEntryToDacTime();
 
+    CallbackProfiler::ScopedCallback profiledCallback(m_framesPerBuffer, m_dSampleRate);
+
     Trace trace("SoundDeviceNetwork::callbackProcessClkRef %1",
                 m_deviceId.name);
 
@@ -443,7 +446,10 @@ void SoundDeviceNetwork::callbackProcessClkRef() {
 #endif
     }
 
-    m_pSoundManager->readProcess();
+    {
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::ReadProcess);
+        m_pSoundManager->readProcess();
+    }
 
     {
         ScopedTimer t("SoundDevicePortAudio::callbackProcess prepare %1",
@@ -451,7 +457,10 @@ void SoundDeviceNetwork::callbackProcessClkRef() {
         m_pSoundManager->onDeviceOutputCallback(m_framesPerBuffer);
     }
 
-    m_pSoundManager->writeProcess();
+    {
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::WriteProcess);
+        m_pSoundManager->writeProcess();
+    }
 
     m_pSoundManager->processUnderflowHappened();
 
@@ -33,6 +33,7 @@
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
+#include "util/callbackprofiler.h"
 #include "util/denormalsarezero.h"
 #include "util/sample.h"
 #include "util/timer.h"
@@ -897,6 +898,8 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     // This must be the very first call, else timeInfo becomes invalid
     updateCallbackEntryToDacTime(timeInfo);
 
+    CallbackProfiler::ScopedCallback profiledCallback(framesPerBuffer, m_dSampleRate);
+
     Trace trace("SoundDevicePortAudio::callbackProcessClkRef %1",
                 m_deviceId.debugName());
 
@@ -966,11 +969,15 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     if (in) {
         ScopedTimer t("SoundDevicePortAudio::callbackProcess input %1",
                 m_deviceId.debugName());
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Input);
         composeInputBuffer(in, framesPerBuffer, 0, m_inputParams.channelCount);
         m_pSoundManager->pushInputBuffers(m_audioInputs, m_framesPerBuffer);
     }
 
-    m_pSoundManager->readProcess();
+    {
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::ReadProcess);
+        m_pSoundManager->readProcess();
+    }
 
     {
         ScopedTimer t("SoundDevicePortAudio::callbackProcess prepare %1",
@@ -981,6 +988,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     if (out) {
         ScopedTimer t("SoundDevicePortAudio::callbackProcess output %1",
                 m_deviceId.debugName());
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::Output);
 
         if (m_outputParams.channelCount <= 0) {
             qWarning()
@@ -993,7 +1001,10 @@ int SoundDevicePortAudio::callbackProcessClkRef(
         composeOutputBuffer(out, framesPerBuffer, 0, m_outputParams.channelCount);
     }
 
-    m_pSoundManager->writeProcess();
+    {
+        CallbackProfiler::ScopedStage stage(CallbackProfiler::Stage::WriteProcess);
+        m_pSoundManager->writeProcess();
+    }
 
     updateAudioLatencyUsage(framesPerBuffer);
 
@@ -77,6 +77,7 @@ SoundSourceFLAC::SoundSourceFLAC(const QUrl& url)
           m_decoder(nullptr),
           m_maxBlocksize(0),
           m_bitsPerSample(kBitsPerSampleDefault),
+          m_streamChannelCount(0),
           m_curFrameIndex(0) {
 }
 
@@ -86,7 +87,7 @@ SoundSourceFLAC::~SoundSourceFLAC() {
 
 SoundSource::OpenResult SoundSourceFLAC::tryOpen(
         OpenMode /*mode*/,
-        const OpenParams& /*config*/) {
+        const OpenParams& params) {
     DEBUG_ASSERT(!m_file.isOpen());
     if (!m_file.open(QIODevice::ReadOnly)) {
         kLogger.warning()
@@ -102,6 +103,7 @@ SoundSource::OpenResult SoundSourceFLAC::tryOpen(
         return OpenResult::Failed;
     }
     FLAC__stream_decoder_set_md5_checking(m_decoder, false);
+    m_requestedChannelCount = params.getSignalInfo().getChannelCount();
     const FLAC__StreamDecoderInitStatus initStatus(
             FLAC__stream_decoder_init_stream(
                     m_decoder,
@@ -400,11 +402,11 @@ inline CSAMPLE convertDecodedSample(FLAC__int32 decodedSample, int bitsPerSample
 FLAC__StreamDecoderWriteStatus SoundSourceFLAC::flacWrite(
         const FLAC__Frame* frame, const FLAC__int32* const buffer[]) {
     const SINT numChannels = frame->header.channels;
-    if (getSignalInfo().getChannelCount() > numChannels) {
+    if (m_streamChannelCount > numChannels) {
         kLogger.warning()
                 << "Corrupt or unsupported FLAC file:"
                 << "Invalid number of channels in FLAC frame header"
-                << frame->header.channels << "<>" << getSignalInfo().getChannelCount();
+                << frame->header.channels << "<>" << m_streamChannelCount;
         return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
     }
     if (getSignalInfo().getSampleRate() != SINT(frame->header.sample_rate)) {
@@ -444,6 +446,26 @@ FLAC__StreamDecoderWriteStatus SoundSourceFLAC::flacWrite(
     }
 
     CSAMPLE* pSampleBuffer = writableSlice.data();
+    if (getSignalInfo().getChannelCount() == 1 && m_streamChannelCount > 1) {
+        // Mix the first two channels down to mono
+        for (SINT i = 0; i < numWritableFrames; ++i) {
+            *pSampleBuffer++ = (convertDecodedSample(buffer[0][i], m_bitsPerSample) +
+                                       convertDecodedSample(buffer[1][i], m_bitsPerSample)) *
+                    0.5f;
+        }
+        return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+    }
+    if (getSignalInfo().getChannelCount() == 2 && m_streamChannelCount == 1) {
+        // Dual mono
+        for (SINT i = 0; i < numWritableFrames; ++i) {
+            const CSAMPLE sample = convertDecodedSample(buffer[0][i], m_bitsPerSample);
+            *pSampleBuffer++ = sample;
+            *pSampleBuffer++ = sample;
+        }
+        return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+    }
+    // Only the first two channels of a multi-channel stream are
+    // decoded for stereo
     DEBUG_ASSERT(getSignalInfo().getChannelCount() <= numChannels);
     switch (getSignalInfo().getChannelCount()) {
     case 1: {
@@ -481,7 +503,12 @@ void SoundSourceFLAC::flacMetadata(const FLAC__StreamMetadata* metadata) {
     // "...always before the first audio frame (i.e. write callback)."
     switch (metadata->type) {
     case FLAC__METADATA_TYPE_STREAMINFO: {
-        initChannelCountOnce(metadata->data.stream_info.channels);
+        m_streamChannelCount = metadata->data.stream_info.channels;
+        if (m_requestedChannelCount.isValid() && m_requestedChannelCount <= 2) {
+            initChannelCountOnce(m_requestedChannelCount);
+        } else {
+            initChannelCountOnce(m_streamChannelCount);
+        }
         initSampleRateOnce(metadata->data.stream_info.sample_rate);
         initFrameIndexRangeOnce(
                 IndexRange::forward(
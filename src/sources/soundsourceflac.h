@@ -48,6 +48,9 @@ class SoundSourceFLAC final : public SoundSource {
     // of subframes (one for each channel)
     SINT m_maxBlocksize; // in time samples (audio samples = time samples * chanCount)
     SINT m_bitsPerSample;
+    SINT m_streamChannelCount;
+    // A requested mono or stereo signal is produced while decoding
+    audio::ChannelCount m_requestedChannelCount;
 
     ReadAheadSampleBuffer m_sampleBuffer;
 
@@ -29,6 +29,7 @@ ov_callbacks SoundSourceOggVorbis::s_callbacks = {
 
 SoundSourceOggVorbis::SoundSourceOggVorbis(const QUrl& url)
         : SoundSource(url, "ogg"),
+          m_streamChannelCount(0),
           m_curFrameIndex(0) {
     memset(&m_vf, 0, sizeof(m_vf));
 }
@@ -39,7 +40,7 @@ SoundSourceOggVorbis::~SoundSourceOggVorbis() {
 
 SoundSource::OpenResult SoundSourceOggVorbis::tryOpen(
         OpenMode /*mode*/,
-        const OpenParams& /*config*/) {
+        const OpenParams& params) {
     m_pFile = std::make_unique<QFile>(getLocalFileName());
     if (!m_pFile->open(QFile::ReadOnly)) {
         kLogger.warning()
@@ -82,7 +83,16 @@ SoundSource::OpenResult SoundSourceOggVorbis::tryOpen(
                 << getUrlString();
         return OpenResult::Failed;
     }
-    initChannelCountOnce(vi->channels);
+    m_streamChannelCount = vi->channels;
+    // The decoded channels are interleaved while reading and a requested
+    // mono or stereo signal is produced on the fly without an additional
+    // copy by AudioSourceStereoProxy
+    const auto requestedChannelCount = params.getSignalInfo().getChannelCount();
+    if (requestedChannelCount.isValid() && requestedChannelCount <= 2) {
+        initChannelCountOnce(requestedChannelCount);
+    } else {
+        initChannelCountOnce(m_streamChannelCount);
+    }
     initSampleRateOnce(vi->rate);
     if (0 < vi->bitrate_nominal) {
         initBitrateOnce(vi->bitrate_nominal / 1000);
@@ -153,7 +163,22 @@ ReadableSampleFrames SoundSourceOggVorbis::readSampleFramesClamped(
         const long readResult = ov_read_float(&m_vf, &pcmChannels, numberOfFramesRemaining, &currentSection);
         if (0 < readResult) {
             m_curFrameIndex += readResult;
-            if (pSampleBuffer) {
+            if (pSampleBuffer && getSignalInfo().getChannelCount() == 1 &&
+                    m_streamChannelCount > 1) {
+                // Mix the first two channels down to mono
+                for (long i = 0; i < readResult; ++i) {
+                    *pSampleBuffer++ = (pcmChannels[0][i] + pcmChannels[1][i]) * 0.5f;
+                }
+            } else if (pSampleBuffer && getSignalInfo().getChannelCount() == 2 &&
+                    m_streamChannelCount == 1) {
+                // Dual mono
+                for (long i = 0; i < readResult; ++i) {
+                    *pSampleBuffer++ = pcmChannels[0][i];
+                    *pSampleBuffer++ = pcmChannels[0][i];
+                }
+            } else if (pSampleBuffer) {
+                // Only the first two channels of a multi-channel
+                // stream are read for stereo
                 switch (getSignalInfo().getChannelCount()) {
                 case 1:
                     for (long i = 0; i < readResult; ++i) {
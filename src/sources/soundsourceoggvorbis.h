@@ -37,6 +37,9 @@ class SoundSourceOggVorbis final : public SoundSource {
 
     OggVorbis_File m_vf;
 
+    // Might differ from the number of channels that are read
+    SINT m_streamChannelCount;
+
     SINT m_curFrameIndex;
 };
 
@@ -0,0 +1,105 @@
+#include "test/allocationcounter.h"
+
+#include <errno.h>
+#include <stddef.h>
+
+#include "test/realtimesafetychecker.h"
+
+namespace {
+
+// Plain data in the static TLS block of the executable, accessing it must
+// not allocate.
+thread_local quint64 t_allocationCount = 0;
+
+inline void countAllocation() {
+    ++t_allocationCount;
+    if (RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::Allocation);
+    }
+}
+
+} // anonymous namespace
+
+#if defined(__LINUX__) && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && \
+        !defined(__SANITIZE_THREAD__)
+#define MIXXX_COUNT_ALLOCATIONS
+
+#include <malloc.h>
+#include <stdlib.h>
+
+// Replaces the allocation functions of glibc for the whole process. The
+// implementations of glibc remain available under their internal names.
+// operator new allocates with these as well. The definitions must match
+// the declarations of glibc, including __THROW.
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) __THROW {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) __THROW {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) __THROW {
+    countAllocation();
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) __THROW {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) __THROW {
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) __THROW {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    countAllocation();
+    void* result = __libc_memalign(alignment, size);
+    if (!result) {
+        return ENOMEM;
+    }
+    *ptr = result;
+    return 0;
+}
+
+void free(void* ptr) __THROW {
+    if (ptr && RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::Deallocation);
+    }
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+#endif
+
+// static
+bool AllocationCounter::isSupported() {
+#ifdef MIXXX_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// static
+quint64 AllocationCounter::threadAllocationCount() {
+    return t_allocationCount;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Counts the heap allocations of the current thread, e.g. to find
+// allocations in the audio callback that might block. The test binary
+// intercepts malloc and friends if it is linked with glibc and not built
+// with a sanitizer. Otherwise nothing is counted.
+class AllocationCounter {
+  public:
+    AllocationCounter()
+            : m_startCount(threadAllocationCount()) {
+    }
+
+    // The number of allocations since construction or the last reset
+    quint64 count() const {
+        return threadAllocationCount() - m_startCount;
+    }
+
+    void reset() {
+        m_startCount = threadAllocationCount();
+    }
+
+    static bool isSupported();
+
+    // The number of allocations since the start of the current thread
+    static quint64 threadAllocationCount();
+
+  private:
+    quint64 m_startCount;
+};
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "test/allocationcounter.h"
+
+namespace {
+
+TEST(AllocationCounterTest, CountsAllocationsOfCurrentThread) {
+    if (!AllocationCounter::isSupported()) {
+        return;
+    }
+    AllocationCounter counter;
+    EXPECT_EQ(0u, counter.count());
+
+    auto pValue = std::make_unique<int>(1);
+    EXPECT_EQ(1u, counter.count());
+
+    std::vector<int> values;
+    values.reserve(16);
+    EXPECT_EQ(2u, counter.count());
+
+    // Nothing is allocated without growing
+    values.push_back(*pValue);
+    EXPECT_EQ(2u, counter.count());
+
+    counter.reset();
+    EXPECT_EQ(0u, counter.count());
+}
+
+} // namespace
@@ -0,0 +1,242 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFile>
+
+#include "library/dao/analysisdao.h"
+#include "test/librarytest.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformfactory.h"
+
+namespace {
+
+class AnalysisDaoTest : public LibraryTest {
+  protected:
+    AnalysisDaoTest()
+            : m_trackId(internalCollection()->addTrack(
+                      Track::newTemporary(TrackFile(QDir(QDir::tempPath()),
+                              QStringLiteral("analysis.mp3"))),
+                      false)) {
+    }
+
+    AnalysisDao& analysisDao() {
+        return internalCollection()->getAnalysisDAO();
+    }
+
+    // A waveform of a 10 minute track like it is generated by
+    // AnalyzerWaveform. Summaries are limited to maxVisualSamples.
+    static WaveformPointer newWaveform(int maxVisualSamples = -1) {
+        const int sampleRate = 44100;
+        const int samples = 10 * 60 * sampleRate * 2;
+        WaveformPointer pWaveform(new Waveform(
+                sampleRate, samples, 441, maxVisualSamples));
+        WaveformData* pData = pWaveform->data();
+        for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+            pData[i].filtered.low = static_cast<unsigned char>(i % 251);
+            pData[i].filtered.mid = static_cast<unsigned char>(i % 241);
+            pData[i].filtered.high = static_cast<unsigned char>(i % 239);
+            pData[i].filtered.all = static_cast<unsigned char>(i % 256);
+        }
+        pWaveform->setCompletion(pWaveform->getDataSize());
+        if (maxVisualSamples == -1) {
+            pWaveform->setVersion(WaveformFactory::currentWaveformVersion());
+            pWaveform->setDescription(WaveformFactory::currentWaveformDescription());
+        } else {
+            pWaveform->setVersion(WaveformFactory::currentWaveformSummaryVersion());
+            pWaveform->setDescription(WaveformFactory::currentWaveformSummaryDescription());
+        }
+        return pWaveform;
+    }
+
+    // Saves the waveform as compressed protobuf like Mixxx 2.2
+    AnalysisDao::AnalysisInfo saveCompressedWaveform(const Waveform& waveform) {
+        AnalysisDao::AnalysisInfo analysis;
+        analysis.trackId = m_trackId;
+        analysis.type = AnalysisDao::TYPE_WAVEFORM;
+        analysis.version = WAVEFORM_5_VERSION;
+        analysis.description = WAVEFORM_5_DESCRIPTION;
+        analysis.data = waveform.toByteArray();
+        EXPECT_TRUE(analysisDao().saveAnalysis(&analysis));
+        return analysis;
+    }
+
+    static void expectSameWaveform(const Waveform& expected, const Waveform& actual) {
+        ASSERT_TRUE(actual.isValid());
+        ASSERT_EQ(expected.getDataSize(), actual.getDataSize());
+        EXPECT_EQ(expected.getTextureStride(), actual.getTextureStride());
+        EXPECT_EQ(expected.getTextureSize(), actual.getTextureSize());
+        EXPECT_DOUBLE_EQ(expected.getAudioVisualRatio(), actual.getAudioVisualRatio());
+        EXPECT_EQ(expected.getDataSize(), actual.getCompletion());
+        for (int i = 0; i < expected.getDataSize(); ++i) {
+            ASSERT_EQ(expected.get(i).m_i, actual.get(i).m_i) << "at " << i;
+        }
+    }
+
+    const TrackId m_trackId;
+};
+
+TEST_F(AnalysisDaoTest, MapsSavedWaveforms) {
+    ASSERT_TRUE(m_trackId.isValid());
+    const WaveformPointer pWaveform = newWaveform();
+    const WaveformPointer pWaveSummary = newWaveform(2 * 1920);
+    analysisDao().saveTrackAnalyses(m_trackId, pWaveform, pWaveSummary);
+    EXPECT_EQ(Waveform::SaveState::Saved, pWaveform->saveState());
+    EXPECT_EQ(Waveform::SaveState::Saved, pWaveSummary->saveState());
+
+    const auto analyses = analysisDao().getAnalysesForTrack(m_trackId);
+    ASSERT_EQ(2, analyses.size());
+    for (const auto& analysis : analyses) {
+        EXPECT_EQ(AnalysisDao::STORAGE_MAPPED, analysis.storageFormat);
+#ifndef __WINDOWS__
+        EXPECT_TRUE(analysis.pMappedFile != nullptr);
+#endif
+        std::unique_ptr<Waveform> pLoaded(
+                WaveformFactory::loadWaveformFromAnalysis(analysis));
+        if (analysis.type == AnalysisDao::TYPE_WAVEFORM) {
+            EXPECT_EQ(WaveformFactory::VC_USE,
+                    WaveformFactory::waveformVersionToVersionClass(analysis.version));
+            expectSameWaveform(*pWaveform, *pLoaded);
+        } else {
+            EXPECT_EQ(WaveformFactory::VC_USE,
+                    WaveformFactory::waveformSummaryVersionToVersionClass(
+                            analysis.version));
+            expectSameWaveform(*pWaveSummary, *pLoaded);
+        }
+        // The padding of the texture
+        EXPECT_EQ(0, pLoaded->get(pLoaded->getTextureSize() - 1).m_i);
+        EXPECT_EQ(analysis.analysisId, pLoaded->getId());
+        EXPECT_EQ(Waveform::SaveState::Saved, pLoaded->saveState());
+    }
+}
+
+TEST_F(AnalysisDaoTest, RemovesLoadedAnalyses) {
+    const WaveformPointer pWaveform = newWaveform();
+    analysisDao().saveTrackAnalyses(m_trackId, pWaveform, newWaveform(2 * 1920));
+    const auto analyses = analysisDao().getAnalysesForTrackByType(
+            m_trackId, AnalysisDao::TYPE_WAVEFORM);
+    ASSERT_EQ(1, analyses.size());
+    std::unique_ptr<Waveform> pLoaded(
+            WaveformFactory::loadWaveformFromAnalysis(analyses.first()));
+
+    // The loaded waveform doesn't keep its file from being removed
+    EXPECT_TRUE(analysisDao().deleteAnalysesForTrack(m_trackId));
+    EXPECT_FALSE(QFile::exists(config()->getSettingsPath() + "/analysis/" +
+            QString::number(analyses.first().analysisId)));
+    EXPECT_TRUE(analysisDao().getAnalysesForTrack(m_trackId).isEmpty());
+    expectSameWaveform(*pWaveform, *pLoaded);
+}
+
+TEST_F(AnalysisDaoTest, ConvertsCompressedWaveforms) {
+    const WaveformPointer pWaveform = newWaveform();
+    const AnalysisDao::AnalysisInfo saved = saveCompressedWaveform(*pWaveform);
+
+    auto analyses = analysisDao().getAnalysesForTrack(m_trackId);
+    ASSERT_EQ(1, analyses.size());
+    EXPECT_EQ(AnalysisDao::STORAGE_COMPRESSED, analyses.first().storageFormat);
+    EXPECT_EQ(WaveformFactory::VC_CONVERT,
+            WaveformFactory::waveformVersionToVersionClass(analyses.first().version));
+    std::unique_ptr<Waveform> pConverted(WaveformFactory::convertWaveformFromAnalysis(
+            &analysisDao(), analyses.first()));
+    expectSameWaveform(*pWaveform, *pConverted);
+    EXPECT_EQ(WaveformFactory::currentWaveformVersion(), pConverted->getVersion());
+
+    // Replaced by the current version
+    analyses = analysisDao().getAnalysesForTrack(m_trackId);
+    ASSERT_EQ(1, analyses.size());
+    const AnalysisDao::AnalysisInfo& converted = analyses.first();
+    EXPECT_EQ(saved.analysisId, converted.analysisId);
+    EXPECT_EQ(AnalysisDao::STORAGE_MAPPED, converted.storageFormat);
+    EXPECT_EQ(WaveformFactory::currentWaveformVersion(), converted.version);
+    std::unique_ptr<Waveform> pLoaded(
+            WaveformFactory::loadWaveformFromAnalysis(converted));
+    expectSameWaveform(*pWaveform, *pLoaded);
+}
+
+TEST_F(AnalysisDaoTest, SkipsTruncatedFiles) {
+    analysisDao().saveTrackAnalyses(m_trackId, newWaveform(), newWaveform(2 * 1920));
+    const auto analyses = analysisDao().getAnalysesForTrackByType(
+            m_trackId, AnalysisDao::TYPE_WAVEFORM);
+    ASSERT_EQ(1, analyses.size());
+
+    QFile file(config()->getSettingsPath() + "/analysis/" +
+            QString::number(analyses.first().analysisId));
+    ASSERT_TRUE(file.exists());
+    ASSERT_TRUE(file.resize(file.size() / 2));
+    EXPECT_TRUE(analysisDao().getAnalysesForTrackByType(
+            m_trackId, AnalysisDao::TYPE_WAVEFORM).isEmpty());
+}
+
+class AnalysisDaoBenchmarkEnvironment : public AnalysisDaoTest {
+  public:
+    // The fixture is only used for setting up the database
+    void TestBody() override {
+    }
+
+    using AnalysisDaoTest::analysisDao;
+    using AnalysisDaoTest::newWaveform;
+    using AnalysisDaoTest::saveCompressedWaveform;
+
+    TrackId trackId() const {
+        return m_trackId;
+    }
+};
+
+// Loads the waveform of a 10 minute track until it can be rendered. The
+// argument selects the format, 0 for compressed protobuf and 1 for a mapped
+// blob.
+static void BM_LoadWaveform(benchmark::State& state) {
+    AnalysisDaoBenchmarkEnvironment environment;
+    const WaveformPointer pWaveform = environment.newWaveform();
+    if (state.range(0) == 0) {
+        environment.saveCompressedWaveform(*pWaveform);
+    } else {
+        environment.analysisDao().saveTrackAnalyses(environment.trackId(),
+                pWaveform,
+                environment.newWaveform(2 * 1920));
+    }
+
+    while (state.KeepRunning()) {
+        const auto analyses = environment.analysisDao().getAnalysesForTrackByType(
+                environment.trackId(), AnalysisDao::TYPE_WAVEFORM);
+        if (analyses.size() != 1) {
+            state.SkipWithError("Failed to load the analysis");
+            return;
+        }
+        std::unique_ptr<Waveform> pLoaded(
+                WaveformFactory::loadWaveformFromAnalysis(analyses.first()));
+        benchmark::DoNotOptimize(pLoaded->get(pLoaded->getDataSize() / 2));
+    }
+    state.SetBytesProcessed(state.iterations() *
+            pWaveform->getDataSize() * static_cast<int64_t>(sizeof(WaveformData)));
+}
+BENCHMARK(BM_LoadWaveform)->Unit(benchmark::kMicrosecond)->Arg(0)->Arg(1);
+
+// Converts the waveform of a 10 minute track from compressed protobuf into a
+// mapped blob.
+static void BM_ConvertWaveform(benchmark::State& state) {
+    AnalysisDaoBenchmarkEnvironment environment;
+    const WaveformPointer pWaveform = environment.newWaveform();
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        environment.analysisDao().deleteAnalysesForTrack(environment.trackId());
+        environment.saveCompressedWaveform(*pWaveform);
+        state.ResumeTiming();
+
+        const auto analyses = environment.analysisDao().getAnalysesForTrackByType(
+                environment.trackId(), AnalysisDao::TYPE_WAVEFORM);
+        if (analyses.size() != 1) {
+            state.SkipWithError("Failed to load the analysis");
+            return;
+        }
+        std::unique_ptr<Waveform> pConverted(WaveformFactory::convertWaveformFromAnalysis(
+                &environment.analysisDao(), analyses.first()));
+        benchmark::DoNotOptimize(pConverted->getDataSize());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() *
+            pWaveform->getDataSize() * static_cast<int64_t>(sizeof(WaveformData)));
+}
+BENCHMARK(BM_ConvertWaveform)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,399 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QtMath>
+#include <vector>
+
+#include "analyzer/analysisframebus.h"
+#include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "analyzer/plugins/buffering_utils.h"
+#include "sources/audiosourcestereoproxy.h"
+#include "sources/soundsourceproxy.h"
+#include "test/mixxxtest.h"
+#include "track/beatutils.h"
+#include "track/keyutils.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+constexpr int kSampleRate = 44100;
+
+const char* const kFileNameSuffixes[] = {
+        ".aiff",
+        ".flac",
+        "-itunes-12.7.0-aac.m4a",
+        "-vbr.mp3",
+        ".ogg",
+        ".opus",
+        ".wav",
+        ".wv",
+};
+
+class AnalysisFrameBusTest : public MixxxTest {
+  protected:
+    // Collects the windows that are passed to the callback
+    static bool initializeHelper(
+            mixxx::DownmixAndOverlapHelper* pHelper,
+            std::vector<double>* pWindows) {
+        return pHelper->initialize(
+                1024,
+                256,
+                [pWindows](double* pBuffer, size_t frames) {
+                    pWindows->insert(pWindows->end(), pBuffer, pBuffer + frames);
+                    return true;
+                });
+    }
+};
+
+TEST_F(AnalysisFrameBusTest, MonoDownmix) {
+    const SINT kFrames = 100;
+    std::vector<CSAMPLE> stereo(kFrames * 2);
+    for (SINT i = 0; i < kFrames; ++i) {
+        stereo[i * 2] = 0.01f * i;
+        stereo[i * 2 + 1] = -0.005f * i;
+    }
+
+    mixxx::AnalysisFrameBus frameBus(kFrames);
+    frameBus.publish(stereo.data(), kFrames);
+    EXPECT_EQ(kFrames, frameBus.frameLength());
+    EXPECT_EQ(kFrames * 2, frameBus.stereoLength());
+    EXPECT_EQ(stereo.data(), frameBus.stereoData());
+    const CSAMPLE* pMono = frameBus.monoData();
+    for (SINT i = 0; i < kFrames; ++i) {
+        EXPECT_FLOAT_EQ((stereo[i * 2] + stereo[i * 2 + 1]) / 2, pMono[i]);
+    }
+
+    // The downmix is updated for the next chunk
+    std::fill(stereo.begin(), stereo.end(), 1.0f);
+    frameBus.publish(stereo.data(), kFrames / 2);
+    EXPECT_EQ(kFrames / 2, frameBus.frameLength());
+    EXPECT_FLOAT_EQ(1.0f, frameBus.monoData()[0]);
+}
+
+TEST_F(AnalysisFrameBusTest, DownmixAndOverlapHelperMonoInput) {
+    // Chunks that do not fit the window or step size
+    const SINT kChunkFrames = 1000;
+    const int kChunks = 7;
+    std::vector<CSAMPLE> stereo(kChunkFrames * 2);
+    mixxx::AnalysisFrameBus frameBus(kChunkFrames);
+
+    mixxx::DownmixAndOverlapHelper stereoHelper;
+    std::vector<double> stereoWindows;
+    ASSERT_TRUE(initializeHelper(&stereoHelper, &stereoWindows));
+    mixxx::DownmixAndOverlapHelper monoHelper;
+    std::vector<double> monoWindows;
+    ASSERT_TRUE(initializeHelper(&monoHelper, &monoWindows));
+
+    int sample = 0;
+    for (int chunk = 0; chunk < kChunks; ++chunk) {
+        // The last chunk is incomplete
+        const SINT frames = chunk == kChunks - 1 ? kChunkFrames / 3 : kChunkFrames;
+        for (SINT i = 0; i < frames * 2; ++i) {
+            stereo[i] = static_cast<CSAMPLE>((sample++ % 97) / 97.0 - 0.5);
+        }
+        frameBus.publish(stereo.data(), frames);
+        EXPECT_TRUE(stereoHelper.processStereoSamples(
+                frameBus.stereoData(), frameBus.stereoLength()));
+        EXPECT_TRUE(monoHelper.processMonoSamples(
+                frameBus.monoData(), frameBus.frameLength()));
+    }
+    EXPECT_TRUE(stereoHelper.finalize());
+    EXPECT_TRUE(monoHelper.finalize());
+
+    ASSERT_FALSE(stereoWindows.empty());
+    // Bit-identical
+    EXPECT_EQ(stereoWindows, monoWindows);
+}
+
+TEST_F(AnalysisFrameBusTest, DecimatedMonoIsContinuous) {
+    const int kFactor = 4;
+    const SINT kFrames = 10000;
+    std::vector<CSAMPLE> stereo(kFrames * 2);
+    std::vector<CSAMPLE> mono(kFrames);
+    for (SINT i = 0; i < kFrames; ++i) {
+        stereo[i * 2] = static_cast<CSAMPLE>(qSin(i * 0.01));
+        stereo[i * 2 + 1] = static_cast<CSAMPLE>((i % 89) / 89.0 - 0.5);
+        mono[i] = (stereo[i * 2] + stereo[i * 2 + 1]) * 0.5f;
+    }
+
+    // The whole signal at once
+    mixxx::PolyphaseDecimator decimator(kFactor);
+    std::vector<CSAMPLE> expected(
+            mixxx::PolyphaseDecimator::maxOutputSamples(kFrames, kFactor));
+    expected.resize(decimator.process(mono.data(), kFrames, expected.data()));
+    ASSERT_EQ(static_cast<size_t>(kFrames / kFactor), expected.size());
+
+    // Chunks that are not a multiple of the decimation factor
+    const SINT kChunkFrames[] = {1, 3, 999, 250, 17, 1000};
+    mixxx::AnalysisFrameBus frameBus(1000);
+    std::vector<CSAMPLE> decimated;
+    SINT frame = 0;
+    for (int chunk = 0; frame < kFrames; ++chunk) {
+        const SINT frames = math_min(kChunkFrames[chunk % 6], kFrames - frame);
+        frameBus.publish(&stereo[frame * 2], frames);
+        const auto slice = frameBus.decimatedMonoData(kFactor);
+        decimated.insert(decimated.end(), slice.data(), slice.data() + slice.length());
+        // Not decimated
+        EXPECT_EQ(mono[frame], frameBus.decimatedMonoData(1)[0]);
+        frame += frames;
+    }
+    // Bit-identical
+    EXPECT_EQ(expected, decimated);
+
+    // A new track starts with a new filter state
+    frameBus.reset();
+    frameBus.publish(stereo.data(), 1000);
+    const auto slice = frameBus.decimatedMonoData(kFactor);
+    ASSERT_EQ(1000 / kFactor, slice.length());
+    EXPECT_TRUE(std::equal(slice.data(), slice.data() + slice.length(), expected.begin()));
+}
+
+TEST_F(AnalysisFrameBusTest, PolyphaseDecimatorFrequencyResponse) {
+    const int kFactor = 2;
+    const SINT kFrames = 8192;
+    const auto kDelayFrames =
+            static_cast<SINT>(mixxx::PolyphaseDecimator::delayFrames(kFactor));
+    // In the pass band and far above the Nyquist frequency of the
+    // decimated signal that would be aliased
+    const double kPassFrequency = 1000.0;
+    const double kStopFrequency = 0.4 * kSampleRate;
+    std::vector<CSAMPLE> pass(kFrames);
+    std::vector<CSAMPLE> stop(kFrames);
+    for (SINT i = 0; i < kFrames; ++i) {
+        pass[i] = static_cast<CSAMPLE>(qSin(2 * M_PI * kPassFrequency * i / kSampleRate));
+        stop[i] = static_cast<CSAMPLE>(qSin(2 * M_PI * kStopFrequency * i / kSampleRate));
+    }
+
+    std::vector<CSAMPLE> output(kFrames / kFactor);
+    mixxx::PolyphaseDecimator passDecimator(kFactor);
+    ASSERT_EQ(output.size(), passDecimator.process(pass.data(), kFrames, output.data()));
+    // After the filter has settled
+    for (SINT i = kDelayFrames * 2; i < kFrames; i += kFactor) {
+        EXPECT_NEAR(pass[i - kDelayFrames], output[i / kFactor], 1e-3) << "frame " << i;
+    }
+
+    mixxx::PolyphaseDecimator stopDecimator(kFactor);
+    ASSERT_EQ(output.size(), stopDecimator.process(stop.data(), kFrames, output.data()));
+    for (SINT i = kDelayFrames * 2; i < kFrames; i += kFactor) {
+        EXPECT_NEAR(0.0, output[i / kFactor], 1e-3) << "frame " << i;
+    }
+}
+
+TEST_F(AnalysisFrameBusTest, DecimationFactor) {
+    EXPECT_EQ(2, mixxx::PolyphaseDecimator::factorForTargetSampleRate(44100, 22050));
+    EXPECT_EQ(2, mixxx::PolyphaseDecimator::factorForTargetSampleRate(48000, 22050));
+    EXPECT_EQ(8, mixxx::PolyphaseDecimator::factorForTargetSampleRate(96000, 11025));
+    EXPECT_EQ(4, mixxx::PolyphaseDecimator::factorForTargetSampleRate(66150, 11025));
+    EXPECT_EQ(1, mixxx::PolyphaseDecimator::factorForTargetSampleRate(22050, 22050));
+    EXPECT_EQ(1, mixxx::PolyphaseDecimator::factorForTargetSampleRate(44100, 0));
+}
+
+// An A minor chord with kicks on every beat and a hi-hat in between
+std::vector<CSAMPLE> makeTestTrack(double bpm, SINT frames) {
+    std::vector<CSAMPLE> samples(frames * 2);
+    const double framesPerBeat = kSampleRate * 60.0 / bpm;
+    const SINT kickFrames = kSampleRate / 20;
+    const SINT hihatFrames = kSampleRate / 50;
+    quint32 noise = 1;
+    for (SINT i = 0; i < frames; ++i) {
+        const double t = double(i) / kSampleRate;
+        double value = 0.1 * (qSin(2 * M_PI * 220.0 * t) +
+                                     qSin(2 * M_PI * 261.63 * t) +
+                                     qSin(2 * M_PI * 329.63 * t));
+        const double beatFrame = std::fmod(i, framesPerBeat);
+        if (beatFrame < kickFrames) {
+            value += 0.6 * qSin(2 * M_PI * 60.0 * beatFrame / kSampleRate) *
+                    (1.0 - beatFrame / kickFrames);
+        }
+        const double offbeatFrame = std::fmod(i + framesPerBeat / 2, framesPerBeat);
+        noise = noise * 1664525 + 1013904223;
+        if (offbeatFrame < hihatFrames) {
+            value += 0.2 * (noise / 4294967296.0 - 0.5) *
+                    (1.0 - offbeatFrame / hihatFrames);
+        }
+        samples[i * 2] = static_cast<CSAMPLE>(value);
+        samples[i * 2 + 1] = static_cast<CSAMPLE>(value);
+    }
+    return samples;
+}
+
+struct AnalysisResult {
+    double bpm;
+    mixxx::track::io::key::ChromaticKey key;
+};
+
+// Analyzes the samples with the default plugins at the given target
+// sample rates like AnalyzerBeats and AnalyzerKey
+AnalysisResult analyzeTestTrack(const std::vector<CSAMPLE>& samples,
+        int beatsTargetSampleRate,
+        int keyTargetSampleRate) {
+    const SINT frames = samples.size() / 2;
+    mixxx::AnalyzerQueenMaryBeats beatsPlugin(beatsTargetSampleRate);
+    mixxx::AnalyzerQueenMaryKey keyPlugin(keyTargetSampleRate);
+    beatsPlugin.initialize(kSampleRate);
+    keyPlugin.initialize(kSampleRate);
+    mixxx::AnalysisFrameBus frameBus(mixxx::kAnalysisFramesPerChunk);
+    for (SINT frame = 0; frame < frames; frame += mixxx::kAnalysisFramesPerChunk) {
+        frameBus.publish(&samples[frame * 2],
+                math_min(mixxx::kAnalysisFramesPerChunk, frames - frame));
+        beatsPlugin.processFrames(frameBus);
+        keyPlugin.processFrames(frameBus);
+    }
+    beatsPlugin.finalize();
+    keyPlugin.finalize();
+
+    AnalysisResult result;
+    result.bpm = BeatUtils::calculateBpm(beatsPlugin.getBeats(), kSampleRate, 60, 200);
+    result.key = KeyUtils::calculateGlobalKey(
+            keyPlugin.getKeyChanges(), frames * 2, kSampleRate);
+    return result;
+}
+
+TEST_F(AnalysisFrameBusTest, DownsampledAnalysis) {
+    const std::vector<CSAMPLE> samples = makeTestTrack(128, 30 * kSampleRate);
+    const AnalysisResult reference = analyzeTestTrack(samples, 0, 0);
+    const AnalysisResult downsampled = analyzeTestTrack(samples,
+            mixxx::kAnalysisBeatsTargetSampleRate,
+            mixxx::kAnalysisKeyTargetSampleRate);
+    EXPECT_NEAR(reference.bpm, downsampled.bpm, 0.5);
+    EXPECT_EQ(reference.key, downsampled.key);
+}
+
+// Decodes and analyzes a test file with the key and beat detectors. With a
+// second argument of 0 every plugin gets the decoded stereo samples and
+// mixes them down itself, otherwise the analysis frame bus is used.
+static void BM_DecodeAndAnalyze(benchmark::State& state) {
+    const QString fileNameSuffix = kFileNameSuffixes[state.range(0)];
+    const bool useFrameBus = state.range(1) != 0;
+    if (!SoundSourceProxy::isFileNameSupported(fileNameSuffix)) {
+        state.SkipWithError("Unsupported file type");
+        return;
+    }
+    const QString filePath = kTestDir.absoluteFilePath("cover-test" + fileNameSuffix);
+
+    mixxx::SampleBuffer sampleBuffer(mixxx::kAnalysisSamplesPerChunk);
+    mixxx::AnalysisFrameBus frameBus(mixxx::kAnalysisFramesPerChunk);
+    int64_t frames = 0;
+    while (state.KeepRunning()) {
+        auto pTrack = Track::newTemporary(filePath);
+        SoundSourceProxy proxy(pTrack);
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::kAnalysisChannels);
+        auto pAudioSource = proxy.openAudioSource(openParams);
+        if (!pAudioSource) {
+            state.SkipWithError("Failed to open file");
+            return;
+        }
+        mixxx::AudioSourceStereoProxy audioSourceProxy(
+                pAudioSource,
+                mixxx::kAnalysisFramesPerChunk);
+        frameBus.reset();
+
+        mixxx::AnalyzerQueenMaryKey keyPlugin;
+        mixxx::AnalyzerQueenMaryBeats beatsPlugin;
+        keyPlugin.initialize(pAudioSource->getSignalInfo().getSampleRate());
+        beatsPlugin.initialize(pAudioSource->getSignalInfo().getSampleRate());
+
+        mixxx::IndexRange remainingFrameRange = audioSourceProxy.frameIndexRange();
+        while (!remainingFrameRange.empty()) {
+            const auto chunkFrameRange =
+                    remainingFrameRange.splitAndShrinkFront(
+                            math_min(mixxx::kAnalysisFramesPerChunk,
+                                    remainingFrameRange.length()));
+            const auto readableSampleFrames =
+                    audioSourceProxy.readSampleFrames(
+                            mixxx::WritableSampleFrames(
+                                    chunkFrameRange,
+                                    mixxx::SampleBuffer::WritableSlice(sampleBuffer)));
+            if (readableSampleFrames.frameIndexRange().empty()) {
+                break;
+            }
+            if (useFrameBus) {
+                frameBus.publish(
+                        readableSampleFrames.readableData(),
+                        readableSampleFrames.frameIndexRange().length());
+                keyPlugin.processFrames(frameBus);
+                beatsPlugin.processFrames(frameBus);
+            } else {
+                keyPlugin.processSamples(
+                        readableSampleFrames.readableData(),
+                        readableSampleFrames.readableLength());
+                beatsPlugin.processSamples(
+                        readableSampleFrames.readableData(),
+                        readableSampleFrames.readableLength());
+            }
+            frames += readableSampleFrames.frameIndexRange().length();
+        }
+
+        keyPlugin.finalize();
+        beatsPlugin.finalize();
+        benchmark::DoNotOptimize(keyPlugin.getKeyChanges());
+    }
+    // Frames per second of decoding and analysis
+    state.SetItemsProcessed(frames);
+    state.SetLabel(fileNameSuffix.toStdString());
+}
+BENCHMARK(BM_DecodeAndAnalyze)
+        ->Unit(benchmark::kMillisecond)
+        ->Args({0, 0})
+        ->Args({0, 1})
+        ->Args({1, 0})
+        ->Args({1, 1})
+        ->Args({2, 0})
+        ->Args({2, 1})
+        ->Args({3, 0})
+        ->Args({3, 1})
+        ->Args({4, 0})
+        ->Args({4, 1})
+        ->Args({5, 0})
+        ->Args({5, 1})
+        ->Args({6, 0})
+        ->Args({6, 1})
+        ->Args({7, 0})
+        ->Args({7, 1});
+
+// Compares the analysis of a 3 minute track at the default target sample
+// rates of the beat and key detectors with an analysis at the original
+// sample rate as the reference.
+static void BM_DownsampledAnalysis(benchmark::State& state) {
+    const double bpm = state.range(0);
+    const std::vector<CSAMPLE> samples = makeTestTrack(bpm, 180 * kSampleRate);
+
+    AnalysisResult reference;
+    AnalysisResult downsampled;
+    double referenceMillis = 0;
+    double downsampledMillis = 0;
+    while (state.KeepRunning()) {
+        PerformanceTimer timer;
+        timer.start();
+        reference = analyzeTestTrack(samples, 0, 0);
+        referenceMillis = timer.restart().toDoubleMillis();
+        downsampled = analyzeTestTrack(samples,
+                mixxx::kAnalysisBeatsTargetSampleRate,
+                mixxx::kAnalysisKeyTargetSampleRate);
+        downsampledMillis = timer.elapsed().toDoubleMillis();
+    }
+
+    state.counters["full_rate_ms"] = referenceMillis;
+    state.counters["downsampled_ms"] = downsampledMillis;
+    state.counters["speedup"] = referenceMillis / downsampledMillis;
+    state.counters["bpm_error"] = std::abs(downsampled.bpm - reference.bpm);
+    state.counters["key_match"] = downsampled.key == reference.key ? 1 : 0;
+}
+BENCHMARK(BM_DownsampledAnalysis)
+        ->Unit(benchmark::kMillisecond)
+        ->Iterations(1)
+        ->Arg(90)
+        ->Arg(120)
+        ->Arg(128)
+        ->Arg(140)
+        ->Arg(174);
+
+} // namespace
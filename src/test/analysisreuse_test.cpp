@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <QDir>
+
+#include "analyzer/analysisreuse.h"
+#include "analyzer/analyzerbeats.h"
+#include "analyzer/analyzerebur128.h"
+#include "analyzer/analyzerkey.h"
+#include "analyzer/analyzerwaveform.h"
+#include "analyzer/constants.h"
+#include "preferences/replaygainsettings.h"
+#include "sources/soundsourceproxy.h"
+#include "test/librarytest.h"
+#include "track/beatfactory.h"
+#include "track/keyfactory.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+// Both files contain the same MPEG audio with different cover art
+const QString kTrackFileName = QStringLiteral("cover-test-jpg.mp3");
+const QString kCopyFileName = QStringLiteral("cover-test-png.mp3");
+const QString kOtherFileName = QStringLiteral("cover-test-vbr.mp3");
+
+class AnalysisReuseTest : public LibraryTest {
+  protected:
+    AnalysisReuseTest()
+            : m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk) {
+    }
+
+    mixxx::AudioFingerprint computeAudioFingerprint(const QString& fileName) {
+        auto pTrack = Track::newTemporary(kTestDir.absoluteFilePath(fileName));
+        SoundSourceProxy proxy(pTrack);
+        mixxx::AudioSource::OpenParams openParams;
+        openParams.setChannelCount(mixxx::kAnalysisChannels);
+        auto pAudioSource = proxy.openAudioSource(openParams);
+        EXPECT_TRUE(pAudioSource);
+        if (!pAudioSource) {
+            return mixxx::kInvalidAudioFingerprint;
+        }
+        return mixxx::AnalysisReuse::computeAudioFingerprint(
+                pAudioSource, &m_sampleBuffer);
+    }
+
+    TrackPointer addTrack(const QString& fileName) {
+        auto pTrack = getOrAddTrackByLocation(kTestDir.absoluteFilePath(fileName));
+        EXPECT_TRUE(pTrack);
+        return pTrack;
+    }
+
+    mixxx::SampleBuffer m_sampleBuffer;
+};
+
+TEST_F(AnalysisReuseTest, AudioFingerprint) {
+    const auto audioFingerprint = computeAudioFingerprint(kTrackFileName);
+    EXPECT_NE(mixxx::kInvalidAudioFingerprint, audioFingerprint);
+    // Independent of the tags
+    EXPECT_EQ(audioFingerprint, computeAudioFingerprint(kCopyFileName));
+    EXPECT_NE(audioFingerprint, computeAudioFingerprint(kOtherFileName));
+}
+
+TEST_F(AnalysisReuseTest, ReuseAnalysisResults) {
+    mixxx::AnalysisReuse analysisReuse(dbConnection());
+    const auto audioFingerprint = computeAudioFingerprint(kTrackFileName);
+
+    TrackPointer pTrack = addTrack(kTrackFileName);
+    ASSERT_TRUE(pTrack);
+    pTrack->setBeats(BeatFactory::makeBeatGrid(*pTrack, 128, 0));
+    pTrack->setKeys(KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::A_MINOR,
+            mixxx::track::io::key::USER));
+    pTrack->setReplayGain(mixxx::ReplayGain(0.5, 0.9f));
+    ASSERT_TRUE(trackCollections()->saveTrack(pTrack));
+    // Already analyzed tracks are fingerprinted when visited again
+    EXPECT_FALSE(analysisReuse.hasAudioFingerprint(pTrack->getId()));
+    EXPECT_TRUE(analysisReuse.storeAudioFingerprint(pTrack->getId(), audioFingerprint));
+    EXPECT_TRUE(analysisReuse.hasAudioFingerprint(pTrack->getId()));
+
+    TrackPointer pCopy = addTrack(kCopyFileName);
+    ASSERT_TRUE(pCopy);
+    EXPECT_TRUE(analysisReuse.reuseAnalysisResults(pCopy, audioFingerprint));
+    ASSERT_TRUE(pCopy->getBeats());
+    EXPECT_DOUBLE_EQ(128, pCopy->getBpm());
+    EXPECT_EQ(mixxx::track::io::key::A_MINOR, pCopy->getKey());
+    // The ReplayGain is not reused, because it depends on every sample
+    EXPECT_FALSE(pCopy->getReplayGain().hasRatio());
+
+    // Nothing is missing anymore
+    EXPECT_FALSE(analysisReuse.reuseAnalysisResults(pCopy, audioFingerprint));
+
+    // Tracks with other audio don't reuse anything
+    TrackPointer pOther = addTrack(kOtherFileName);
+    ASSERT_TRUE(pOther);
+    EXPECT_FALSE(analysisReuse.reuseAnalysisResults(
+            pOther, computeAudioFingerprint(kOtherFileName)));
+    EXPECT_FALSE(pOther->getBeats());
+}
+
+TEST_F(AnalysisReuseTest, ExistingResultsAreNotReplaced) {
+    mixxx::AnalysisReuse analysisReuse(dbConnection());
+    const auto audioFingerprint = computeAudioFingerprint(kTrackFileName);
+
+    TrackPointer pTrack = addTrack(kTrackFileName);
+    ASSERT_TRUE(pTrack);
+    pTrack->setKeys(KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::A_MINOR,
+            mixxx::track::io::key::USER));
+    ASSERT_TRUE(trackCollections()->saveTrack(pTrack));
+    EXPECT_TRUE(analysisReuse.storeAudioFingerprint(pTrack->getId(), audioFingerprint));
+
+    TrackPointer pCopy = addTrack(kCopyFileName);
+    ASSERT_TRUE(pCopy);
+    pCopy->setKeys(KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::C_MAJOR,
+            mixxx::track::io::key::USER));
+    EXPECT_FALSE(analysisReuse.reuseAnalysisResults(pCopy, audioFingerprint));
+    EXPECT_EQ(mixxx::track::io::key::C_MAJOR, pCopy->getKey());
+}
+
+TEST_F(AnalysisReuseTest, PartialReuseWithWaveformAndReplayGain) {
+    ReplayGainSettings replayGainSettings(config());
+    replayGainSettings.setReplayGainAnalyzerEnabled(true);
+    replayGainSettings.setReplayGainAnalyzerVersion(2);
+
+    mixxx::AnalysisReuse analysisReuse(dbConnection());
+    const auto audioFingerprint = computeAudioFingerprint(kTrackFileName);
+
+    TrackPointer pTrack = addTrack(kTrackFileName);
+    ASSERT_TRUE(pTrack);
+    pTrack->setBeats(BeatFactory::makeBeatGrid(*pTrack, 128, 0));
+    pTrack->setKeys(KeyFactory::makeBasicKeys(
+            mixxx::track::io::key::A_MINOR,
+            mixxx::track::io::key::USER));
+    ASSERT_TRUE(trackCollections()->saveTrack(pTrack));
+    EXPECT_TRUE(analysisReuse.storeAudioFingerprint(pTrack->getId(), audioFingerprint));
+
+    // The analyzers in the order of AnalyzerThread
+    std::vector<AnalyzerWithState> analyzers;
+    analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerWaveform>(config(), dbConnection())));
+    analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerEbur128>(config())));
+    analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerBeats>(config(), true)));
+    analyzers.push_back(AnalyzerWithState(
+            std::make_unique<AnalyzerKey>(config())));
+    const std::size_t beatsAnalyzerIndex = 2;
+    const std::size_t keysAnalyzerIndex = 3;
+
+    TrackPointer pCopy = addTrack(kCopyFileName);
+    ASSERT_TRUE(pCopy);
+    const int sampleRate = 44100;
+    const int totalSamples = sampleRate * mixxx::kAnalysisChannels * 10;
+    for (auto&& analyzer : analyzers) {
+        EXPECT_TRUE(analyzer.initialize(pCopy, sampleRate, totalSamples));
+    }
+
+    EXPECT_TRUE(analysisReuse.reuseAnalysisResults(pCopy, audioFingerprint));
+    EXPECT_FALSE(analyzers[beatsAnalyzerIndex].reinitialize(
+            pCopy, sampleRate, totalSamples));
+    EXPECT_FALSE(analyzers[keysAnalyzerIndex].reinitialize(
+            pCopy, sampleRate, totalSamples));
+    // The track still needs to be decoded for the waveform and ReplayGain
+    EXPECT_TRUE(analyzers[0].isActive());
+    EXPECT_TRUE(analyzers[1].isActive());
+    // The empty waveform of the analyzer is already attached to the track,
+    // so only the analyzers of reused results may decide again
+    EXPECT_TRUE(pCopy->getWaveform());
+    for (auto&& analyzer : analyzers) {
+        analyzer.cancel();
+    }
+
+    // A complete analysis of 100 s audio in 10 s, 6 s of them in the beat
+    // and 2 s in the key analyzer
+    mixxx::TrackAnalysisStatistics analyzedTrack;
+    analyzedTrack.audioSeconds = 100.0;
+    analyzedTrack.analyzed = true;
+    analyzedTrack.analysisSeconds = 10.0;
+    analyzedTrack.beatsAnalyzed = true;
+    analyzedTrack.beatsAnalysisSeconds = 6.0;
+    analyzedTrack.keysAnalyzed = true;
+    analyzedTrack.keysAnalysisSeconds = 2.0;
+
+    // The copy of 50 s audio as reported by AnalyzerThread
+    mixxx::TrackAnalysisStatistics copiedTrack;
+    copiedTrack.audioSeconds = 50.0;
+    copiedTrack.analyzed = true;
+    copiedTrack.analysisSeconds = 1.0;
+    copiedTrack.beatsReused = true;
+    copiedTrack.keysReused = true;
+    EXPECT_TRUE(copiedTrack.isPartiallyReused());
+
+    mixxx::AnalysisReuseStatistics statistics;
+    statistics.addTrack(copiedTrack);
+    EXPECT_EQ(0, statistics.reusedTracksCount());
+    EXPECT_EQ(1, statistics.partiallyReusedTracksCount());
+    // Nothing to base the estimate on yet
+    EXPECT_DOUBLE_EQ(0.0, statistics.estimatedSecondsSaved());
+
+    statistics.addTrack(analyzedTrack);
+    EXPECT_DOUBLE_EQ(3.0 + 1.0, statistics.estimatedSecondsSaved());
+
+    // Tracks without anything left to analyze save the complete analysis
+    mixxx::TrackAnalysisStatistics skippedTrack;
+    skippedTrack.audioSeconds = 200.0;
+    skippedTrack.beatsReused = true;
+    skippedTrack.keysReused = true;
+    EXPECT_FALSE(skippedTrack.isPartiallyReused());
+    statistics.addTrack(skippedTrack);
+    EXPECT_EQ(1, statistics.reusedTracksCount());
+    EXPECT_EQ(1, statistics.partiallyReusedTracksCount());
+    EXPECT_DOUBLE_EQ(3.0 + 1.0 + 20.0, statistics.estimatedSecondsSaved());
+
+    statistics.reset();
+    EXPECT_EQ(0, statistics.reusedTracksCount());
+    EXPECT_EQ(0, statistics.partiallyReusedTracksCount());
+    EXPECT_DOUBLE_EQ(0.0, statistics.estimatedSecondsSaved());
+}
+
+} // namespace
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+
+#include "util/callbackprofiler.h"
+#include "util/latencyhistogram.h"
+#include "util/time.h"
+
+namespace {
+
+TEST(LatencyHistogramTest, BucketsHaveBoundedRelativeError) {
+    for (qint64 nanos = 0; nanos < 64; ++nanos) {
+        EXPECT_EQ(nanos, LatencyHistogram::bucketUpperBound(
+                LatencyHistogram::bucketIndex(nanos)));
+    }
+    for (qint64 nanos = 64; nanos < (Q_INT64_C(1) << 39); nanos = nanos * 3 / 2 + 7) {
+        const int index = LatencyHistogram::bucketIndex(nanos);
+        ASSERT_LT(index, LatencyHistogram::kNumBuckets);
+        const qint64 upperBound = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_LE(nanos, upperBound);
+        EXPECT_GT(nanos, LatencyHistogram::bucketUpperBound(index - 1));
+        EXPECT_GE(1.0 / LatencyHistogram::kSubBuckets,
+                static_cast<double>(upperBound - nanos) / nanos);
+    }
+    EXPECT_EQ(LatencyHistogram::kNumBuckets - 1,
+            LatencyHistogram::bucketIndex(std::numeric_limits<qint64>::max()));
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(mixxx::Duration(), histogram.percentile(99));
+
+    // 1 ms to 1000 ms
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(mixxx::Duration::fromMillis(i));
+    }
+    EXPECT_EQ(1000u, histogram.count());
+    EXPECT_EQ(mixxx::Duration::fromMillis(1000), histogram.max());
+    EXPECT_NEAR(500.5, histogram.mean().toDoubleMillis(), 1e-3);
+    EXPECT_NEAR(500.0, histogram.percentile(50).toDoubleMillis(), 500.0 / 32);
+    EXPECT_NEAR(990.0, histogram.percentile(99).toDoubleMillis(), 990.0 / 32);
+    EXPECT_EQ(mixxx::Duration::fromMillis(1000), histogram.percentile(100));
+    EXPECT_EQ(histogram.percentile(0), histogram.percentile(0.01));
+
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(mixxx::Duration(), histogram.percentile(50));
+}
+
+class CallbackProfilerTest : public testing::Test {
+  protected:
+    // 1 ms buffers
+    static constexpr SINT kFrames = 48;
+    static constexpr double kSampleRate = 48000;
+
+    CallbackProfilerTest()
+            : m_pProfiler(std::make_unique<CallbackProfiler>()) {
+        mixxx::Time::setTestMode(true);
+        setTime(0);
+    }
+
+    ~CallbackProfilerTest() override {
+        mixxx::Time::setTestMode(false);
+    }
+
+    void setTime(qint64 micros) {
+        m_nowMicros = micros;
+        mixxx::Time::setTestElapsedTime(mixxx::Duration::fromMicros(micros));
+    }
+    void advance(qint64 micros) {
+        setTime(m_nowMicros + micros);
+    }
+
+    // A callback that spends the given times reading and mixing
+    void callback(qint64 readMicros, qint64 mixMicros) {
+        CallbackProfiler::ScopedCallback callback(kFrames, kSampleRate, m_pProfiler.get());
+        {
+            CallbackProfiler::ScopedStage stage(
+                    CallbackProfiler::Stage::ReadProcess, m_pProfiler.get());
+            advance(readMicros);
+        }
+        CallbackProfiler::ScopedStage stage(
+                CallbackProfiler::Stage::Mixing, m_pProfiler.get());
+        advance(mixMicros / 2);
+        {
+            CallbackProfiler::ScopedStage nestedStage(
+                    CallbackProfiler::Stage::Effects, m_pProfiler.get());
+            advance(mixMicros - mixMicros / 2);
+        }
+    }
+
+    std::unique_ptr<CallbackProfiler> m_pProfiler;
+    qint64 m_nowMicros;
+};
+
+TEST_F(CallbackProfilerTest, AccountsTimeToInnermostStage) {
+    callback(100, 400);
+    EXPECT_EQ(1u, m_pProfiler->callbackHistogram().count());
+    EXPECT_EQ(mixxx::Duration::fromMicros(500), m_pProfiler->callbackHistogram().max());
+    EXPECT_EQ(mixxx::Duration::fromMicros(100),
+            m_pProfiler->stageHistogram(CallbackProfiler::Stage::ReadProcess).max());
+    EXPECT_EQ(mixxx::Duration::fromMicros(200),
+            m_pProfiler->stageHistogram(CallbackProfiler::Stage::Mixing).max());
+    EXPECT_EQ(mixxx::Duration::fromMicros(200),
+            m_pProfiler->stageHistogram(CallbackProfiler::Stage::Effects).max());
+    EXPECT_EQ(mixxx::Duration(),
+            m_pProfiler->stageHistogram(CallbackProfiler::Stage::WriteProcess).max());
+    EXPECT_EQ(0u, m_pProfiler->deadlineMissCount());
+}
+
+TEST_F(CallbackProfilerTest, IgnoresStagesOutsideOfCallbacks) {
+    {
+        CallbackProfiler::ScopedStage stage(
+                CallbackProfiler::Stage::Mixing, m_pProfiler.get());
+        advance(1000);
+    }
+    callback(0, 100);
+    EXPECT_EQ(mixxx::Duration::fromMicros(50),
+            m_pProfiler->stageHistogram(CallbackProfiler::Stage::Mixing).max());
+}
+
+TEST_F(CallbackProfilerTest, CapturesCallbacksAroundDeadlineMiss) {
+    const int callbacksBefore = 100;
+    for (int i = 0; i < callbacksBefore; ++i) {
+        callback(100, 400);
+    }
+    // Exceeds the 1 ms period of the buffer
+    callback(200, 1000);
+    CallbackProfiler::DeadlineMiss deadlineMiss;
+    EXPECT_FALSE(m_pProfiler->takeDeadlineMiss(&deadlineMiss));
+
+    for (int i = 0; i < CallbackProfiler::kCallbacksAfterMiss; ++i) {
+        callback(100, 400);
+    }
+    EXPECT_EQ(1u, m_pProfiler->deadlineMissCount());
+    ASSERT_TRUE(m_pProfiler->takeDeadlineMiss(&deadlineMiss));
+    EXPECT_FALSE(m_pProfiler->takeDeadlineMiss(&deadlineMiss));
+
+    ASSERT_EQ(CallbackProfiler::kHistorySize, deadlineMiss.numRecords);
+    EXPECT_EQ(CallbackProfiler::kHistorySize - CallbackProfiler::kCallbacksAfterMiss - 1,
+            deadlineMiss.missIndex);
+    const CallbackProfiler::CallbackRecord& missed =
+            deadlineMiss.records[deadlineMiss.missIndex];
+    EXPECT_TRUE(missed.missedDeadline());
+    EXPECT_EQ(1200000, missed.durationNanos);
+    EXPECT_EQ(1000000, missed.deadlineNanos);
+    EXPECT_EQ(kFrames, missed.frames);
+    EXPECT_EQ(200000, missed.stageNanos[static_cast<int>(
+            CallbackProfiler::Stage::ReadProcess)]);
+    // Oldest first without gaps
+    for (int i = 1; i < deadlineMiss.numRecords; ++i) {
+        const CallbackProfiler::CallbackRecord& previous = deadlineMiss.records[i - 1];
+        EXPECT_EQ(previous.startNanos + previous.durationNanos,
+                deadlineMiss.records[i].startNanos);
+        EXPECT_EQ(i == deadlineMiss.missIndex, deadlineMiss.records[i].missedDeadline());
+    }
+}
+
+TEST_F(CallbackProfilerTest, DropsDeadlineMissesThatAreNotTaken) {
+    const int numMisses = 20;
+    for (int miss = 0; miss < numMisses; ++miss) {
+        callback(0, 2000);
+        for (int i = 0; i < CallbackProfiler::kCallbacksAfterMiss; ++i) {
+            callback(0, 100);
+        }
+    }
+    EXPECT_EQ(static_cast<quint64>(numMisses), m_pProfiler->deadlineMissCount());
+    int taken = 0;
+    CallbackProfiler::DeadlineMiss deadlineMiss;
+    while (m_pProfiler->takeDeadlineMiss(&deadlineMiss)) {
+        ++taken;
+    }
+    EXPECT_LT(0, taken);
+    EXPECT_EQ(static_cast<quint64>(numMisses - taken),
+            m_pProfiler->droppedDeadlineMissCount());
+}
+
+} // namespace
@@ -1,5 +1,7 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 #include "library/coverartcache.h"
 #include "library/coverartutils.h"
@@ -49,6 +51,22 @@ class CoverArtCacheTest : public LibraryTest, public CoverArtCache {
         EXPECT_FALSE(img.isNull());
         EXPECT_EQ(img, res.cover.image);
     }
+
+    static CoverInfo fileCoverInfo(const QString& coverLocation) {
+        CoverInfo info;
+        info.type = CoverInfo::FILE;
+        info.source = CoverInfo::GUESSED;
+        info.coverLocation = coverLocation;
+        info.hash = CoverImageUtils::calculateHash(QImage(coverLocation));
+        return info;
+    }
+
+    static CoverArtCache::FutureResult loadThumbnail(const CoverInfo& info,
+            int desiredWidth,
+            const QString& thumbnailPath) {
+        return CoverArtCache::loadCover(
+                nullptr, TrackPointer(), info, desiredWidth, false, thumbnailPath);
+    }
 };
 
 const QString kCoverFileTest("cover_test.jpg");
@@ -77,3 +95,85 @@ TEST_F(CoverArtCacheTest, loadCover) {
     loadCoverFromFile(kTrackLocationTest, kCoverFileTest, kCoverLocationTest); //relative
     loadCoverFromFile(QString(), kCoverLocationTest, kCoverLocationTest); //absolute
 }
+
+TEST_F(CoverArtCacheTest, storesThumbnails) {
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QString coverLocation = tempDir.filePath(kCoverFileTest);
+    ASSERT_TRUE(QFile::copy(kCoverLocationTest, coverLocation));
+    const QString thumbnailPath = tempDir.filePath("thumbnails");
+    ASSERT_TRUE(QDir().mkpath(thumbnailPath));
+    const CoverInfo info = fileCoverInfo(coverLocation);
+
+    const CoverArtCache::FutureResult res = loadThumbnail(info, 50, thumbnailPath);
+    EXPECT_EQ(50, res.cover.image.width());
+    EXPECT_EQ(50, res.cover.resizedToWidth);
+    const QFileInfoList thumbnails = QDir(thumbnailPath).entryInfoList(QDir::Files);
+    ASSERT_EQ(1, thumbnails.size());
+    // Rounded up to the next step
+    EXPECT_EQ(64, QImage(thumbnails.first().filePath()).width());
+
+    // Widths of the same step share the thumbnail, even if the
+    // original cover is gone
+    ASSERT_TRUE(QFile::remove(coverLocation));
+    const CoverArtCache::FutureResult cached = loadThumbnail(info, 60, thumbnailPath);
+    EXPECT_EQ(60, cached.cover.image.width());
+    EXPECT_EQ(info.hash, cached.cover.hash);
+    EXPECT_FALSE(cached.coverInfoUpdated);
+    EXPECT_EQ(1, QDir(thumbnailPath).entryList(QDir::Files).size());
+
+    // Other widths need the original cover
+    EXPECT_TRUE(loadThumbnail(info, 100, thumbnailPath).cover.image.isNull());
+}
+
+namespace {
+
+class CoverArtCacheBenchmarkEnvironment : public CoverArtCacheTest {
+  public:
+    // The fixture is only used for setting up the QApplication
+    void TestBody() override {
+    }
+
+    using CoverArtCacheTest::fileCoverInfo;
+    using CoverArtCacheTest::loadThumbnail;
+};
+
+// Loads the cover of a single row in the library table like the worker
+// threads of the cover art cache do on a miss of the pixmap cache. The
+// argument selects the source, 0 for decoding and scaling the original
+// cover and 1 for a thumbnail that has been stored before.
+static void BM_LoadRowCover(benchmark::State& state) {
+    CoverArtCacheBenchmarkEnvironment environment;
+    QTemporaryDir tempDir;
+    // A cover like it is embedded into files by stores
+    QImage cover(1400, 1400, QImage::Format_RGB32);
+    for (int y = 0; y < cover.height(); ++y) {
+        for (int x = 0; x < cover.width(); ++x) {
+            cover.setPixel(x, y, qRgb(x % 256, y % 256, (x * y) % 256));
+        }
+    }
+    const QString coverLocation = tempDir.filePath("cover.jpg");
+    if (!cover.save(coverLocation)) {
+        state.SkipWithError("Failed to save the cover");
+        return;
+    }
+    const CoverInfo info = environment.fileCoverInfo(coverLocation);
+    const QString thumbnailPath =
+            state.range(0) == 0 ? QString() : tempDir.filePath("thumbnails");
+    if (!thumbnailPath.isEmpty()) {
+        QDir().mkpath(thumbnailPath);
+    }
+    // The cover column of the default skins on a high DPI screen
+    const int desiredWidth = 100;
+    environment.loadThumbnail(info, desiredWidth, thumbnailPath);
+
+    while (state.KeepRunning()) {
+        const CoverArtCache::FutureResult res =
+                environment.loadThumbnail(info, desiredWidth, thumbnailPath);
+        benchmark::DoNotOptimize(res.cover.image.constBits());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoadRowCover)->Unit(benchmark::kMicrosecond)->Arg(0)->Arg(1);
+
+} // anonymous namespace
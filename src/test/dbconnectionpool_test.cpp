@@ -1,10 +1,21 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <QSqlQuery>
+#include <atomic>
+#include <thread>
+
 #include "test/mixxxtest.h"
 
 #include "database/mixxxdb.h"
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/dbconnectionpooled.h"
+#include "util/db/fwdsqlquery.h"
+#include "util/db/sqlstatementcache.h"
+#include "util/db/sqltransaction.h"
+#include "util/duration.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
 
 #include "library/dao/settingsdao.h"
 
@@ -35,3 +46,179 @@ TEST_F(DbConnectionPoolTest, MoveSemantics) {
     EXPECT_TRUE(p1.isPooling());
     EXPECT_FALSE(p2.isPooling());
 }
+
+TEST_F(DbConnectionPoolTest, UsesWriteAheadLog) {
+    mixxx::DbConnectionPooler pooler(m_mixxxDb.connectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(m_mixxxDb.connectionPool());
+    QSqlQuery query(database);
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("wal"), query.value(0).toString().toLower());
+    ASSERT_TRUE(query.exec("PRAGMA temp_store"));
+    ASSERT_TRUE(query.next());
+    // MEMORY
+    EXPECT_EQ(2, query.value(0).toInt());
+}
+
+TEST_F(DbConnectionPoolTest, ReusesPreparedStatements) {
+    mixxx::DbConnectionPooler pooler(m_mixxxDb.connectionPool());
+    QSqlDatabase database = mixxx::DbConnectionPooled(m_mixxxDb.connectionPool());
+    auto* const pStatementCache = mixxx::SqlStatementCache::forDatabase(database);
+    ASSERT_NE(nullptr, pStatementCache);
+    const quint64 hitCount = pStatementCache->hitCount();
+    const QString statement = QStringLiteral("SELECT :value AS value");
+
+    for (int i = 0; i < 3; ++i) {
+        FwdSqlQuery query(database, statement);
+        ASSERT_TRUE(query.isPrepared());
+        query.bindValue(":value", i);
+        ASSERT_TRUE(query.execPrepared());
+        ASSERT_TRUE(query.next());
+        EXPECT_EQ(i, query.fieldValue(query.fieldIndex("value")).toInt());
+    }
+    EXPECT_EQ(hitCount + 2, pStatementCache->hitCount());
+
+    // A statement that is in use is not shared
+    {
+        FwdSqlQuery outer(database, statement);
+        outer.bindValue(":value", 1);
+        ASSERT_TRUE(outer.execPrepared());
+        FwdSqlQuery inner(database, statement);
+        ASSERT_TRUE(inner.isPrepared());
+        inner.bindValue(":value", 2);
+        ASSERT_TRUE(inner.execPrepared());
+        ASSERT_TRUE(outer.next());
+        ASSERT_TRUE(inner.next());
+        EXPECT_EQ(1, outer.fieldValue(0).toInt());
+        EXPECT_EQ(2, inner.fieldValue(0).toInt());
+    }
+    EXPECT_EQ(hitCount + 3, pStatementCache->hitCount());
+}
+
+namespace {
+
+class DbConnectionPoolBenchmarkEnvironment : public DbConnectionPoolTest {
+  public:
+    // The fixture is only used for setting up the QApplication
+    void TestBody() override {
+    }
+
+    QString databaseFilePath(const QString& fileName) const {
+        return getTestDataDir().filePath(fileName);
+    }
+};
+
+// Adds tracks with short generated metadata like the library scanner does
+bool populateLibrary(const QSqlDatabase& database, int numTracks) {
+    SqlTransaction transaction(database);
+    FwdSqlQuery insertLocation(database,
+            "INSERT INTO track_locations "
+            "(location, filename, directory, filesize, fs_deleted, needs_verification) "
+            "VALUES (:location, :filename, :directory, 1000000, 0, 0)");
+    FwdSqlQuery insertTrack(database,
+            "INSERT INTO library "
+            "(artist, title, album, location, duration, bpm, mixxx_deleted, played) "
+            "VALUES (:artist, :title, :album, :location, 300, 120, 0, 0)");
+    for (int i = 0; i < numTracks; ++i) {
+        const QString directory = QStringLiteral("/music/%1").arg(i / 100);
+        const QString fileName = QStringLiteral("%1.mp3").arg(i);
+        insertLocation.bindValue(":location", directory + QChar('/') + fileName);
+        insertLocation.bindValue(":filename", fileName);
+        insertLocation.bindValue(":directory", directory);
+        if (!insertLocation.execPrepared()) {
+            return false;
+        }
+        insertTrack.bindValue(":artist", QStringLiteral("Artist %1").arg(i % 5000));
+        insertTrack.bindValue(":title", QStringLiteral("Title %1").arg(i));
+        insertTrack.bindValue(":album", QStringLiteral("Album %1").arg(i / 10));
+        insertTrack.bindValue(":location", insertLocation.lastInsertId());
+        if (!insertTrack.execPrepared()) {
+            return false;
+        }
+    }
+    return transaction.commit();
+}
+
+// Reads a page of the library table on the GUI thread while a scanner
+// thread keeps updating tracks in small transactions. The first argument
+// enables the write-ahead log and the second one is the number of tracks.
+static void BM_ReadLibraryWhileScanning(benchmark::State& state) {
+    DbConnectionPoolBenchmarkEnvironment environment;
+    const int numTracks = static_cast<int>(state.range(1));
+    mixxx::DbConnection::Params params;
+    params.type = QStringLiteral("QSQLITE");
+    params.filePath = environment.databaseFilePath(
+            QStringLiteral("library-%1.sqlite").arg(state.range(0)));
+    params.sqliteTuning.writeAheadLog = state.range(0) != 0;
+    const auto pDbConnectionPool = mixxx::DbConnectionPool::create(
+            params, QStringLiteral("BENCHMARK"));
+    mixxx::DbConnectionPooler pooler(pDbConnectionPool);
+    const QSqlDatabase database = mixxx::DbConnectionPooled(pDbConnectionPool);
+    if (!MixxxDb::initDatabaseSchema(database) ||
+            !populateLibrary(database, numTracks)) {
+        state.SkipWithError("Failed to create the library");
+        return;
+    }
+
+    std::atomic<bool> scanning(true);
+    std::atomic<int> scannerCommits(0);
+    std::thread scanner([&] {
+        mixxx::DbConnectionPooler scannerPooler(pDbConnectionPool);
+        const QSqlDatabase scannerDatabase =
+                mixxx::DbConnectionPooled(pDbConnectionPool);
+        int trackId = 1;
+        while (scanning.load()) {
+            SqlTransaction transaction(scannerDatabase);
+            for (int i = 0; i < 100; ++i) {
+                FwdSqlQuery query(scannerDatabase,
+                        "UPDATE library SET bpm=bpm+1 WHERE id=:id");
+                query.bindValue(":id", trackId);
+                query.execPrepared();
+                trackId = trackId % numTracks + 1;
+            }
+            if (transaction.commit()) {
+                ++scannerCommits;
+            }
+        }
+    });
+
+    const int pageSize = 100;
+    int firstTrackId = 1;
+    mixxx::Duration maxDuration;
+    while (state.KeepRunning()) {
+        PerformanceTimer timer;
+        timer.start();
+        FwdSqlQuery query(database,
+                "SELECT library.id, artist, title, album, bpm, track_locations.location "
+                "FROM library INNER JOIN track_locations "
+                "ON library.location = track_locations.id "
+                "WHERE library.id >= :first ORDER BY library.id LIMIT :count");
+        query.bindValue(":first", firstTrackId);
+        query.bindValue(":count", pageSize);
+        int rows = 0;
+        if (query.execPrepared()) {
+            while (query.next()) {
+                benchmark::DoNotOptimize(query.fieldValue(2));
+                ++rows;
+            }
+        }
+        if (rows == 0) {
+            state.SkipWithError("Failed to read the library");
+            break;
+        }
+        maxDuration = math_max(maxDuration, timer.elapsed());
+        firstTrackId = (firstTrackId + 7919) % (numTracks - pageSize) + 1;
+    }
+
+    scanning.store(false);
+    scanner.join();
+    state.SetItemsProcessed(state.iterations() * pageSize);
+    state.counters["max_ms"] = maxDuration.toDoubleMillis();
+    state.counters["commits"] = scannerCommits.load();
+}
+BENCHMARK(BM_ReadLibraryWhileScanning)
+        ->Unit(benchmark::kMicrosecond)
+        ->Args({0, 250000})
+        ->Args({1, 250000});
+
+} // anonymous namespace
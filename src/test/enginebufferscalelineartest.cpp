@@ -1,12 +1,15 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
 #include <QVector>
+#include <QtMath>
 
 #include "engine/bufferscalers/enginebufferscalelinear.h"
 #include "engine/readaheadmanager.h"
 #include "test/mixxxtest.h"
+#include "test/sinereadaheadmanager.h"
 #include "util/math.h"
 #include "util/sample.h"
 #include "util/types.h"
@@ -126,10 +129,28 @@ class EngineBufferScaleLinearTest : public MixxxTest {
         }
     }
 
+    void AssertBufferCyclesNear(const CSAMPLE* pBuffer, int iBufferLen,
+                                const CSAMPLE* pCycleBuffer, int iCycleLength,
+                                int iSkip) {
+        for (int i = iSkip; i < iBufferLen; ++i) {
+            EXPECT_NEAR(pCycleBuffer[i % iCycleLength], pBuffer[i], 1e-3);
+        }
+    }
+
     StrictMock<ReadAheadManagerMock>* m_pReadAheadMock;
     EngineBufferScaleLinear* m_pScaler;
 };
 
+const EngineBufferScaleLinear::Quality kQualities[] = {
+        EngineBufferScaleLinear::Quality::Linear,
+        EngineBufferScaleLinear::Quality::CubicHermite,
+        EngineBufferScaleLinear::Quality::Sinc8,
+};
+
+// The wider interpolations start with the silence in front of the first
+// buffer, so these frames are skipped when checking the output.
+const int kSkipFrames = 8;
+
 TEST_F(EngineBufferScaleLinearTest, ScaleConstant) {
     SetRateNoLerp(1.0);
 
@@ -296,4 +317,107 @@ TEST_F(EngineBufferScaleLinearTest, TestRepeatedScaleCalls) {
     SampleUtil::free(pOutput);
 }
 
+TEST_F(EngineBufferScaleLinearTest, TestHalfSpeedHigherQualities) {
+    // The same reference as TestHalfSpeedSmoothlyDoublesSamples. Both
+    // interpolations reproduce the input at integer positions and are
+    // symmetric, so they hit the middle between alternating frames.
+    CSAMPLE readBuffer[] = { -101.0, 101.0,
+                             -99.0, 99.0 };
+    CSAMPLE expectedResult[] = { -101.0, 101.0,
+                                 -100.0, 100.0,
+                                 -99.0, 99.0,
+                                 -100.0, 100.0 };
+
+    // Tell the RAMAN mock to invoke getNextSamplesFake
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock, &ReadAheadManagerMock::getNextSamplesFake));
+
+    CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+    for (const auto quality : {EngineBufferScaleLinear::Quality::CubicHermite,
+                 EngineBufferScaleLinear::Quality::Sinc8}) {
+        m_pScaler->clear();
+        m_pScaler->setQuality(quality);
+        m_pReadAheadMock->setReadBuffer(readBuffer, 4);
+        SetRateNoLerp(0.5);
+
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+        AssertBufferCyclesNear(pOutput, kiLinearScaleReadAheadLength,
+                expectedResult, 8, 2 * kSkipFrames);
+    }
+
+    SampleUtil::free(pOutput);
+}
+
+TEST_F(EngineBufferScaleLinearTest, TestConstantSignalAllQualities) {
+    CSAMPLE readBuffer[] = { 0.5f, -0.25f };
+    CSAMPLE expectedResult[] = { 0.5f, -0.25f };
+
+    // Tell the RAMAN mock to invoke getNextSamplesFake
+    EXPECT_CALL(*m_pReadAheadMock, getNextSamples(_, _, _))
+            .WillRepeatedly(Invoke(m_pReadAheadMock, &ReadAheadManagerMock::getNextSamplesFake));
+
+    CSAMPLE* pOutput = SampleUtil::alloc(kiLinearScaleReadAheadLength);
+    for (const auto quality : kQualities) {
+        m_pScaler->clear();
+        m_pScaler->setQuality(quality);
+        m_pReadAheadMock->setReadBuffer(readBuffer, 2);
+
+        // Constant rate
+        SetRateNoLerp(0.7);
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+        AssertBufferCyclesNear(pOutput, kiLinearScaleReadAheadLength,
+                expectedResult, 2, 2 * kSkipFrames);
+
+        // Ramping rate, which continues with the buffered frames
+        SetRate(1.9);
+        m_pScaler->scaleBuffer(pOutput, kiLinearScaleReadAheadLength);
+        AssertBufferCyclesNear(pOutput, kiLinearScaleReadAheadLength,
+                expectedResult, 2, 0);
+    }
+
+    SampleUtil::free(pOutput);
+}
+
+// The cost of one deck for one engine callback of 1024 frames at a constant
+// rate, a rate that changes with every callback, or when scratching back and
+// forth.
+static void BM_ScaleBuffer(benchmark::State& state) {
+    const auto quality = static_cast<EngineBufferScaleLinear::Quality>(state.range(0));
+    const int mode = state.range(1);
+    const SINT kCallbackSamples = 2 * 1024;
+
+    SineReadAheadManager readAheadManager;
+    EngineBufferScaleLinear scaler(&readAheadManager);
+    scaler.setSampleRate(mixxx::audio::SampleRate(44100));
+    scaler.setQuality(quality);
+    CSAMPLE* pOutput = SampleUtil::alloc(kCallbackSamples);
+
+    int callback = 0;
+    while (state.KeepRunning()) {
+        double rate = 0.93;
+        if (mode == 1) {
+            rate = 0.9 + 0.01 * (callback % 20);
+        } else if (mode == 2) {
+            rate = 2.5 * qSin(callback * 0.3);
+        }
+        double pitchRatio = rate;
+        scaler.setScaleParameters(1.0, &rate, &pitchRatio);
+        scaler.scaleBuffer(pOutput, kCallbackSamples);
+        benchmark::DoNotOptimize(pOutput[0]);
+        ++callback;
+    }
+    state.SetItemsProcessed(state.iterations() * kCallbackSamples / 2);
+
+    SampleUtil::free(pOutput);
+}
+BENCHMARK(BM_ScaleBuffer)
+        ->Unit(benchmark::kMicrosecond)
+        ->Apply([](benchmark::internal::Benchmark* b) {
+            for (int quality = 0; quality < 3; ++quality) {
+                for (int mode = 0; mode < 3; ++mode) {
+                    b->Args({quality, mode});
+                }
+            }
+        });
+
 }  // namespace
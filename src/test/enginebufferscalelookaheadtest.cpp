@@ -0,0 +1,306 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "engine/bufferscalers/enginebufferscalelinear.h"
+#include "engine/bufferscalers/enginebufferscalelookahead.h"
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/engineworkerscheduler.h"
+#include "engine/readaheadmanager.h"
+#include "test/mixxxtest.h"
+#include "test/sinereadaheadmanager.h"
+#include "util/performancetimer.h"
+#include "util/sample.h"
+#include "util/types.h"
+
+namespace {
+
+const mixxx::audio::SampleRate kSampleRate(44100);
+
+// Blocks the worker in the middle of a chunk while stalled
+class StallingScale : public EngineBufferScaleLinear {
+  public:
+    explicit StallingScale(ReadAheadManager* pReadAheadManager)
+            : EngineBufferScaleLinear(pReadAheadManager),
+              m_pTestThread(QThread::currentThread()),
+              m_stall(false) {
+    }
+
+    double scaleBuffer(CSAMPLE* pOutputBuffer, SINT iOutputBufferSize) override {
+        if (m_stall.load() && QThread::currentThread() != m_pTestThread) {
+            m_stalled.release();
+            m_resume.acquire();
+        }
+        return EngineBufferScaleLinear::scaleBuffer(pOutputBuffer, iOutputBufferSize);
+    }
+
+    void stall() {
+        m_stall.store(true);
+    }
+
+    bool waitUntilStalled() {
+        return m_stalled.tryAcquire(1, 10000);
+    }
+
+    void resume() {
+        m_stall.store(false);
+        m_resume.release();
+    }
+
+  private:
+    QThread* const m_pTestThread;
+    std::atomic<bool> m_stall;
+    QSemaphore m_stalled;
+    QSemaphore m_resume;
+};
+
+class EngineBufferScaleLookAheadTest : public MixxxTest {
+  protected:
+    // Not a multiple of the chunks that are stretched ahead
+    static constexpr SINT kCallbackFrames = 300;
+
+    void SetUp() override {
+        m_pLookAhead = std::make_unique<EngineBufferScaleLookAhead>(
+                &m_readAheadManager);
+        m_pExpectedScale = std::make_unique<EngineBufferScaleLinear>(
+                &m_expectedReadAheadManager);
+
+        m_pLookAhead->setSampleRate(kSampleRate);
+        m_pExpectedScale->setSampleRate(kSampleRate);
+        // Sets the sample rate of the stretchers and clears them
+        auto pScale = std::make_unique<StallingScale>(
+                m_pLookAhead->getInputReadAheadManager());
+        m_pScale = pScale.get();
+        m_pLookAhead->setScales(
+                std::move(pScale),
+                std::make_unique<EngineBufferScaleLinear>(
+                        m_pLookAhead->getInputReadAheadManager()));
+        m_pExpectedScale->clear();
+
+        m_framesRead = 0.0;
+        m_expectedFramesRead = 0.0;
+        m_output.resize(kCallbackFrames * 2);
+        m_expectedOutput.resize(kCallbackFrames * 2);
+    }
+
+    void TearDown() override {
+        // Stops the worker before the scheduler is deleted
+        m_pLookAhead.reset();
+    }
+
+    // Scales a callback without comparing the result and returns false if
+    // the worker had to be abandoned
+    bool processCallbackUnchecked() {
+        bool seamless = m_pLookAhead->prepareScaleBuffer(kCallbackFrames * 2);
+        if (!seamless) {
+            m_pLookAhead->clear();
+        }
+        m_pLookAhead->scaleBuffer(m_output.data(), kCallbackFrames * 2);
+        m_scheduler.runWorkers();
+        return seamless;
+    }
+
+    void setRate(double rate) {
+        double tempoRatio = rate;
+        double pitchRatio = rate;
+        m_pLookAhead->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+        tempoRatio = rate;
+        pitchRatio = rate;
+        m_pExpectedScale->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    }
+
+    // Scales the same callback with and without the look-ahead and expects
+    // the same result
+    void processCallback(bool waitForWorker) {
+        m_framesRead += m_pLookAhead->scaleBuffer(
+                m_output.data(), kCallbackFrames * 2);
+        m_expectedFramesRead += m_pExpectedScale->scaleBuffer(
+                m_expectedOutput.data(), kCallbackFrames * 2);
+        // The input of a stretched chunk is accounted in proportion to the
+        // frames that have been taken from it
+        EXPECT_NEAR(m_expectedFramesRead, m_framesRead, 256);
+        for (SINT i = 0; i < kCallbackFrames * 2; ++i) {
+            EXPECT_NEAR(m_expectedOutput[i], m_output[i], 1e-5) << "sample " << i;
+        }
+        m_scheduler.runWorkers();
+        if (waitForWorker) {
+            m_scheduler.waitForIdleWorkers();
+        }
+    }
+
+    SineReadAheadManager m_readAheadManager;
+    SineReadAheadManager m_expectedReadAheadManager;
+    EngineWorkerScheduler m_scheduler;
+    std::unique_ptr<EngineBufferScaleLookAhead> m_pLookAhead;
+    // The stretcher that is handed over to the worker first
+    StallingScale* m_pScale;
+    std::unique_ptr<EngineBufferScaleLinear> m_pExpectedScale;
+    double m_framesRead;
+    double m_expectedFramesRead;
+    std::vector<CSAMPLE> m_output;
+    std::vector<CSAMPLE> m_expectedOutput;
+};
+
+TEST_F(EngineBufferScaleLookAheadTest, NoLookAheadWithoutScheduler) {
+    setRate(0.8);
+    for (int i = 0; i < 40; ++i) {
+        processCallback(false);
+    }
+    EXPECT_EQ(0, m_pLookAhead->stretchedAheadFrames());
+}
+
+TEST_F(EngineBufferScaleLookAheadTest, StretchAhead) {
+    m_pLookAhead->setScheduler(&m_scheduler);
+    setRate(0.8);
+    for (int i = 0; i < 40; ++i) {
+        processCallback(true);
+    }
+    EXPECT_LT(0, m_pLookAhead->stretchedAheadFrames());
+}
+
+TEST_F(EngineBufferScaleLookAheadTest, WorkerFallsBehind) {
+    // The scheduler is not started and never wakes the worker, which is
+    // therefore always between two chunks when the engine needs frames
+    m_pLookAhead->setScheduler(&m_scheduler);
+    setRate(0.8);
+    for (int i = 0; i < 200; ++i) {
+        // The engine takes the stretcher back without abandoning it
+        EXPECT_TRUE(m_pLookAhead->prepareScaleBuffer(kCallbackFrames * 2));
+        // The output continues as if there was no look-ahead
+        processCallback(false);
+    }
+    EXPECT_EQ(0, m_pLookAhead->stretchedAheadFrames());
+    // Every callback after the parameters became steady fell back
+    EXPECT_LT(100, m_pLookAhead->underflowCount());
+}
+
+TEST_F(EngineBufferScaleLookAheadTest, StalledWorkerIsAbandoned) {
+    m_pLookAhead->setScheduler(&m_scheduler);
+    m_scheduler.start(QThread::HighPriority);
+    setRate(0.8);
+    for (int i = 0; i < 40; ++i) {
+        processCallback(true);
+    }
+    ASSERT_LT(0, m_pLookAhead->stretchedAheadFrames());
+
+    // The engine never waits for the stalled worker
+    m_pScale->stall();
+    processCallbackUnchecked();
+    ASSERT_TRUE(m_pScale->waitUntilStalled());
+    bool abandoned = false;
+    for (int i = 0; i < 40 && !abandoned; ++i) {
+        abandoned = !processCallbackUnchecked();
+    }
+    EXPECT_TRUE(abandoned);
+    EXPECT_EQ(0, m_pLookAhead->stretchedAheadFrames());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_TRUE(processCallbackUnchecked());
+    }
+    m_pLookAhead->clear();
+    EXPECT_EQ(0, m_pLookAhead->stretchedAheadFrames());
+
+    // Stretches ahead again after the worker has released the stretcher
+    m_pScale->resume();
+    for (int i = 0; i < 40; ++i) {
+        processCallbackUnchecked();
+        m_scheduler.waitForIdleWorkers();
+    }
+    EXPECT_LT(0, m_pLookAhead->stretchedAheadFrames());
+}
+
+TEST_F(EngineBufferScaleLookAheadTest, RateJump) {
+    m_pLookAhead->setScheduler(&m_scheduler);
+    setRate(0.8);
+    EXPECT_FALSE(m_pLookAhead->isRateJump(1.0, 0.88, 0.88));
+    for (int i = 0; i < 40; ++i) {
+        processCallback(true);
+    }
+    ASSERT_LT(0, m_pLookAhead->stretchedAheadFrames());
+    EXPECT_FALSE(m_pLookAhead->isRateJump(1.0, 0.8008, 0.8008));
+    EXPECT_TRUE(m_pLookAhead->isRateJump(1.0, 0.88, 0.88));
+    EXPECT_TRUE(m_pLookAhead->isRateJump(1.0, 0.8, 1.0));
+
+    m_pLookAhead->clear();
+    EXPECT_EQ(0, m_pLookAhead->stretchedAheadFrames());
+    EXPECT_FALSE(m_pLookAhead->isRateJump(1.0, 0.88, 0.88));
+}
+
+// Measures the time of the engine callbacks for 4 keylocked decks in real
+// time. With a second argument of 0 the stretching is done in the callback,
+// otherwise the decks are stretched ahead by their workers.
+static void BM_KeylockDecksCallback(benchmark::State& state) {
+    const int deckCount = state.range(0);
+    const bool lookAhead = state.range(1) != 0;
+    const SINT kFrames = 128;
+    const int kCallbacks = 10 * kSampleRate / kFrames;
+
+    EngineWorkerScheduler scheduler;
+    scheduler.start(QThread::HighPriority);
+    std::vector<std::unique_ptr<SineReadAheadManager>> readAheadManagers;
+    std::vector<std::unique_ptr<EngineBufferScaleLookAhead>> lookAheads;
+    for (int i = 0; i < deckCount; ++i) {
+        readAheadManagers.push_back(std::make_unique<SineReadAheadManager>());
+        lookAheads.push_back(std::make_unique<EngineBufferScaleLookAhead>(
+                readAheadManagers.back().get()));
+        lookAheads.back()->setSampleRate(kSampleRate);
+        lookAheads.back()->setScales(
+                std::make_unique<EngineBufferScaleRubberBand>(
+                        lookAheads.back()->getInputReadAheadManager()),
+                std::make_unique<EngineBufferScaleRubberBand>(
+                        lookAheads.back()->getInputReadAheadManager()));
+        if (lookAhead) {
+            lookAheads.back()->setScheduler(&scheduler);
+        }
+    }
+    CSAMPLE* pOutput = SampleUtil::alloc(kFrames * 2);
+    std::vector<qint64> callbackNanos;
+    callbackNanos.reserve(kCallbacks);
+
+    while (state.KeepRunning()) {
+        PerformanceTimer clock;
+        clock.start();
+        for (int callback = 0; callback < kCallbacks; ++callback) {
+            PerformanceTimer timer;
+            timer.start();
+            for (int i = 0; i < deckCount; ++i) {
+                // Slowly changing like with sync
+                double tempoRatio = 0.93 + 0.001 * ((callback / 100 + i) % 10);
+                double pitchRatio = 1.0;
+                // Without a scheduler the look-ahead stretches in the callback
+                lookAheads[i]->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+                lookAheads[i]->scaleBuffer(pOutput, kFrames * 2);
+                benchmark::DoNotOptimize(pOutput[0]);
+            }
+            callbackNanos.push_back(timer.elapsed().toIntegerNanos());
+            scheduler.runWorkers();
+
+            // Wait for the next callback of the sound card
+            const qint64 nextCallbackNanos =
+                    (callback + 1) * kFrames * 1000000000LL / kSampleRate;
+            while (clock.elapsed().toIntegerNanos() < nextCallbackNanos) {
+                QThread::usleep(100);
+            }
+        }
+    }
+
+    std::sort(callbackNanos.begin(), callbackNanos.end());
+    state.counters["p99_us"] =
+            callbackNanos[callbackNanos.size() * 99 / 100] / 1000.0;
+    state.counters["max_us"] = callbackNanos.back() / 1000.0;
+
+    SampleUtil::free(pOutput);
+    lookAheads.clear();
+}
+BENCHMARK(BM_KeylockDecksCallback)
+        ->Unit(benchmark::kMillisecond)
+        ->Iterations(1)
+        ->Args({4, 0})
+        ->Args({4, 1});
+
+} // namespace
@@ -0,0 +1,351 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "effects/builtin/filtereffect.h"
+#include "test/engineeffectsrig.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+class EngineEffectsManagerTest : public MixxxTest {
+};
+
+// Controls the StallingEffects of a test from the test thread.
+class EffectStall {
+  public:
+    EffectStall()
+            : m_pTestThread(QThread::currentThread()),
+              m_stall(false),
+              m_waitForHelper(false) {
+    }
+
+    // The next channel that is processed by a helper thread blocks until
+    // resume(). The test thread waits in its first channel until that has
+    // happened.
+    void stall() {
+        m_waitForHelper.store(true);
+        m_stall.store(true);
+    }
+
+    void resume() {
+        m_resume.release();
+    }
+
+    void process() {
+        if (!m_stall.load()) {
+            return;
+        }
+        if (QThread::currentThread() == m_pTestThread) {
+            if (m_waitForHelper.exchange(false)) {
+                // Leaves a channel for the helper
+                EXPECT_TRUE(m_stalled.tryAcquire(1, 10000));
+            }
+        } else if (m_stall.exchange(false)) {
+            m_stalled.release();
+            m_resume.acquire();
+        }
+    }
+
+  private:
+    QThread* const m_pTestThread;
+    std::atomic<bool> m_stall;
+    std::atomic<bool> m_waitForHelper;
+    QSemaphore m_stalled;
+    QSemaphore m_resume;
+};
+
+// Negates the signal, which is distinguishable from both the dry signal and
+// the processed signal of other callbacks.
+class StallingEffect : public EffectProcessorImpl<EffectState> {
+  public:
+    explicit StallingEffect(EffectStall* pStall)
+            : m_pStall(pStall) {
+    }
+
+    static QString getId() {
+        return "org.mixxx.test.stalling";
+    }
+
+    static EffectManifestPointer getManifest() {
+        EffectManifestPointer pManifest(new EffectManifest());
+        pManifest->setId(getId());
+        pManifest->setName("Stalling");
+        return pManifest;
+    }
+
+    void processChannel(const ChannelHandle& handle,
+                        EffectState* pState,
+                        const CSAMPLE* pInput, CSAMPLE* pOutput,
+                        const mixxx::EngineParameters& bufferParameters,
+                        const EffectEnableState enableState,
+                        const GroupFeatureState& groupFeatures) override {
+        Q_UNUSED(handle);
+        Q_UNUSED(pState);
+        Q_UNUSED(enableState);
+        Q_UNUSED(groupFeatures);
+        m_pStall->process();
+        SampleUtil::copyWithGain(pOutput, pInput, -1,
+                bufferParameters.samplesPerBuffer());
+    }
+
+  private:
+    EffectStall* const m_pStall;
+};
+
+class StallingEffectInstantiator : public EffectInstantiator {
+  public:
+    explicit StallingEffectInstantiator(EffectStall* pStall)
+            : m_pStall(pStall) {
+    }
+
+    EffectProcessor* instantiate(EngineEffect* pEngineEffect,
+                                 EffectManifestPointer pManifest) override {
+        Q_UNUSED(pEngineEffect);
+        Q_UNUSED(pManifest);
+        return new StallingEffect(m_pStall);
+    }
+
+  private:
+    EffectStall* const m_pStall;
+};
+
+std::vector<mixxx::SampleBuffer> makeScaledDeckBuffers(
+        unsigned int numSamples, CSAMPLE_GAIN gain) {
+    std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    for (mixxx::SampleBuffer& deckBuffer : deckBuffers) {
+        SampleUtil::applyGain(deckBuffer.data(), gain, numSamples);
+    }
+    return deckBuffers;
+}
+
+// Returns the decks that still contain their input and expects all other
+// decks to contain the negated input.
+std::vector<int> dryDecks(const std::vector<mixxx::SampleBuffer>& input,
+                          const std::vector<mixxx::SampleBuffer>& output,
+                          unsigned int numSamples) {
+    std::vector<int> decks;
+    for (int deck = 0; deck < kNumDecks; ++deck) {
+        if (std::equal(input[deck].data(), input[deck].data() + numSamples,
+                       output[deck].data())) {
+            decks.push_back(deck);
+            continue;
+        }
+        for (unsigned int i = 0; i < numSamples; ++i) {
+            if (std::fabs(output[deck][i] + input[deck][i]) > 1e-6) {
+                ADD_FAILURE() << "deck " << deck << " sample " << i
+                              << ": " << output[deck][i]
+                              << " instead of " << -input[deck][i];
+                break;
+            }
+        }
+    }
+    return decks;
+}
+
+TEST_F(EngineEffectsManagerTest, ParallelProcessingMatchesSerialProcessing) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pSerialRig = environment.createDelayRig(0);
+    auto pParallelRig = environment.createDelayRig(2);
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    mixxx::SampleBuffer serialOutput(numSamples);
+    mixxx::SampleBuffer parallelOutput(numSamples);
+
+    // Several callbacks to let the enabling ramps and the effect tails
+    // develop.
+    for (int callback = 0; callback < 16; ++callback) {
+        pSerialRig->process(deckBuffers, environment.outputHandle(),
+                            serialOutput.data(), numSamples);
+        pParallelRig->process(deckBuffers, environment.outputHandle(),
+                              parallelOutput.data(), numSamples);
+        for (unsigned int i = 0; i < numSamples; ++i) {
+            ASSERT_FLOAT_EQ(serialOutput[i], parallelOutput[i])
+                    << "callback " << callback << " sample " << i;
+        }
+    }
+}
+
+TEST_F(EngineEffectsManagerTest, SkipsEffectsAfterTheirTailHasDecayed) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pRig = environment.createRig(0);
+    const std::vector<EngineEffect*> effects = {
+            pRig->addEffect<EchoEffect>(),
+            pRig->addEffect<ReverbEffect>(),
+            pRig->addEffect<FlangerEffect>()};
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    std::vector<mixxx::SampleBuffer> silentDeckBuffers;
+    for (int deck = 0; deck < kNumDecks; ++deck) {
+        silentDeckBuffers.emplace_back(numSamples);
+        silentDeckBuffers.back().clear();
+    }
+    mixxx::SampleBuffer output(numSamples);
+
+    for (int callback = 0; callback < 16; ++callback) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+    for (const EngineEffect* pEffect : effects) {
+        EXPECT_EQ(0u, pEffect->skippedBufferCount()) << pEffect->name();
+    }
+
+    // The echo repeats fade out during the first seconds of silence and the
+    // last repeat must be followed by the full delay time before echo gives
+    // up. Allow for 30 seconds.
+    auto allSkipped = [&effects] {
+        for (const EngineEffect* pEffect : effects) {
+            if (pEffect->skippedBufferCount() == 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (int callback = 0; callback < 30 * 44100 / 512 && !allSkipped(); ++callback) {
+        pRig->process(silentDeckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+    ASSERT_TRUE(allSkipped());
+
+    std::vector<quint64> processedBufferCounts;
+    for (const EngineEffect* pEffect : effects) {
+        processedBufferCounts.push_back(pEffect->processedBufferCount());
+    }
+    for (int callback = 0; callback < 4; ++callback) {
+        pRig->process(silentDeckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+        for (unsigned int i = 0; i < numSamples; ++i) {
+            ASSERT_EQ(0.0f, output[i]);
+        }
+    }
+    for (std::size_t i = 0; i < effects.size(); ++i) {
+        EXPECT_EQ(processedBufferCounts[i], effects[i]->processedBufferCount())
+                << effects[i]->name();
+    }
+
+    // Processing resumes immediately with the input.
+    pRig->process(deckBuffers, environment.outputHandle(),
+                  output.data(), numSamples);
+    EXPECT_EQ(processedBufferCounts[0] + kNumDecks, effects[0]->processedBufferCount());
+}
+
+TEST_F(EngineEffectsManagerTest, SkipsFilterAtIdentity) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pRig = environment.createRig(0);
+    // The default parameters of the filter are at identity.
+    EngineEffect* pFilter = pRig->addEffect<FilterEffect>();
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    mixxx::SampleBuffer dryMix(numSamples);
+    dryMix.clear();
+    for (const mixxx::SampleBuffer& deckBuffer : deckBuffers) {
+        SampleUtil::add(dryMix.data(), deckBuffer.data(), numSamples);
+    }
+    mixxx::SampleBuffer output(numSamples);
+
+    // The first buffer enables the filter, the second one lets it settle at
+    // identity.
+    for (int callback = 0; callback < 8; ++callback) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+    EXPECT_EQ(static_cast<quint64>(2 * kNumDecks), pFilter->processedBufferCount());
+    EXPECT_EQ(static_cast<quint64>(6 * kNumDecks), pFilter->skippedBufferCount());
+    for (unsigned int i = 0; i < numSamples; ++i) {
+        ASSERT_FLOAT_EQ(dryMix[i], output[i]);
+    }
+
+    // Closing the low pass filter requires processing again.
+    pRig->setParameter(pFilter, 0, 1000);
+    pRig->process(deckBuffers, environment.outputHandle(),
+                  output.data(), numSamples);
+    EXPECT_EQ(static_cast<quint64>(3 * kNumDecks), pFilter->processedBufferCount());
+    EXPECT_EQ(static_cast<quint64>(6 * kNumDecks), pFilter->skippedBufferCount());
+}
+
+TEST_F(EngineEffectsManagerTest, StalledHelperLeavesInPlaceChannelDry) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pRig = environment.createRig(1);
+    EffectStall stall;
+    pRig->addEffect(StallingEffect::getManifest(),
+            EffectInstantiatorPointer(new StallingEffectInstantiator(&stall)));
+
+    const unsigned int numSamples = 1024;
+    // Lets the enabling ramp pass
+    for (int callback = 0; callback < 8; ++callback) {
+        std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+        pRig->processInPlace(&deckBuffers, environment.outputHandle(), numSamples);
+    }
+
+    // The helper is stuck in one of the channels, which keeps its dry signal
+    stall.stall();
+    const std::vector<mixxx::SampleBuffer> stalledInput = makeDeckBuffers(numSamples);
+    std::vector<mixxx::SampleBuffer> stalledOutput = makeDeckBuffers(numSamples);
+    pRig->processInPlace(&stalledOutput, environment.outputHandle(), numSamples);
+    const std::vector<int> stalledDecks =
+            dryDecks(stalledInput, stalledOutput, numSamples);
+    ASSERT_EQ(1u, stalledDecks.size());
+
+    // While the helper is stuck the channel stays dry without waiting
+    const std::vector<mixxx::SampleBuffer> nextInput =
+            makeScaledDeckBuffers(numSamples, 0.75f);
+    std::vector<mixxx::SampleBuffer> nextOutput =
+            makeScaledDeckBuffers(numSamples, 0.75f);
+    pRig->processInPlace(&nextOutput, environment.outputHandle(), numSamples);
+    EXPECT_EQ(stalledDecks, dryDecks(nextInput, nextOutput, numSamples));
+
+    // The late result of the helper is never copied into a buffer of a
+    // later callback, the channel is processed again once the helper is
+    // done.
+    stall.resume();
+    const std::vector<mixxx::SampleBuffer> lateInput =
+            makeScaledDeckBuffers(numSamples, 0.5f);
+    bool processed = false;
+    for (int callback = 0; callback < 10000 && !processed; ++callback) {
+        std::vector<mixxx::SampleBuffer> lateOutput =
+                makeScaledDeckBuffers(numSamples, 0.5f);
+        pRig->processInPlace(&lateOutput, environment.outputHandle(), numSamples);
+        const std::vector<int> lateDryDecks =
+                dryDecks(lateInput, lateOutput, numSamples);
+        processed = lateDryDecks.empty();
+        if (!processed) {
+            ASSERT_EQ(stalledDecks, lateDryDecks);
+            QThread::msleep(1);
+        }
+    }
+    EXPECT_TRUE(processed);
+}
+
+// Callback time of the post-fader effects of 4 decks with echo, reverb and
+// flanger. The argument is the number of helper threads, 0 is serial
+// processing on the calling thread.
+static void BM_EngineEffectsManagerPostFaderMix(benchmark::State& state) {
+    QTemporaryDir configDir;
+    UserSettingsPointer pConfig(new UserSettings(
+            configDir.filePath("benchmark.cfg")));
+    EngineEffectsRigEnvironment environment(pConfig);
+    auto pRig = environment.createDelayRig(state.range(0));
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    mixxx::SampleBuffer output(numSamples);
+
+    while (state.KeepRunning()) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+}
+BENCHMARK(BM_EngineEffectsManagerPostFaderMix)->Arg(0)->Arg(1)->Arg(3);
+
+}  // namespace
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "effects/builtin/echoeffect.h"
+#include "effects/builtin/flangereffect.h"
+#include "effects/builtin/reverbeffect.h"
+#include "effects/effectinstantiator.h"
+#include "effects/effectsmanager.h"
+#include "engine/effects/engineeffect.h"
+#include "engine/effects/engineeffectchain.h"
+#include "engine/effects/engineeffectrack.h"
+#include "engine/effects/engineeffectsmanager.h"
+#include "util/math.h"
+#include "util/sample.h"
+#include "util/samplebuffer.h"
+
+constexpr int kNumDecks = 4;
+constexpr unsigned int kSampleRate = 44100;
+
+// Builds the engine side of a single post-fader effect chain that is enabled
+// for kNumDecks input channels. All requests are delivered through the
+// message pipe like EffectsManager does.
+class EngineEffectsRig {
+  public:
+    EngineEffectsRig(EffectsManager* pEffectsManager,
+                     const QSet<ChannelHandleAndGroup>& inputChannels,
+                     const QSet<ChannelHandleAndGroup>& outputChannels,
+                     int numWorkerThreads)
+            : m_pEffectsManager(pEffectsManager),
+              m_inputChannels(inputChannels) {
+        auto pipes = TwoWayMessagePipe<EffectsRequest*, EffectsResponse>::makeTwoWayMessagePipe(
+                2048, 2048);
+        m_pRequestPipe.reset(pipes.first);
+        m_pEngineEffectsManager = std::make_unique<EngineEffectsManager>(
+                pipes.second, numWorkerThreads);
+
+        m_pRack = std::make_unique<EngineEffectRack>(0);
+        EffectsRequest* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ADD_EFFECT_RACK;
+        pRequest->AddEffectRack.pRack = m_pRack.get();
+        pRequest->AddEffectRack.signalProcessingStage = SignalProcessingStage::Postfader;
+        sendRequest(pRequest);
+
+        m_pChain = std::make_unique<EngineEffectChain>(
+                "[EffectRack1_EffectUnit1]", inputChannels, outputChannels);
+        pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ADD_CHAIN_TO_RACK;
+        pRequest->pTargetRack = m_pRack.get();
+        pRequest->AddChainToRack.pChain = m_pChain.get();
+        pRequest->AddChainToRack.iIndex = 0;
+        sendRequest(pRequest);
+
+        // Enable the chain before it contains any effects. The effects
+        // already allocated their states for all input channels on
+        // construction.
+        for (const ChannelHandleAndGroup& inputChannel : inputChannels) {
+            m_inputHandles.push_back(inputChannel.handle());
+        }
+        for (const ChannelHandle& inputHandle : m_inputHandles) {
+            pRequest = new EffectsRequest();
+            pRequest->type = EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+            pRequest->pTargetChain = m_pChain.get();
+            pRequest->EnableInputChannelForChain.pChannelHandle = &inputHandle;
+            pRequest->EnableInputChannelForChain.pEffectStatesMapArray =
+                    new EffectStatesMapArray;
+            sendRequest(pRequest);
+        }
+
+        pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::SET_EFFECT_CHAIN_PARAMETERS;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->SetEffectChainParameters.enabled = true;
+        pRequest->SetEffectChainParameters.mix_mode = EffectChainMixMode::DrySlashWet;
+        pRequest->SetEffectChainParameters.mix = 1.0;
+        sendRequest(pRequest);
+
+        applyRequests();
+    }
+
+    ~EngineEffectsRig() {
+        // Joins the worker threads before the effects are destroyed.
+        m_pEngineEffectsManager.reset();
+    }
+
+    // Processes and mixes all decks like ChannelMixer does for the master
+    // output and returns the mix in pOutput.
+    void process(const std::vector<mixxx::SampleBuffer>& deckBuffers,
+                 const ChannelHandle& outputHandle,
+                 CSAMPLE* pOutput,
+                 unsigned int numSamples) {
+        m_pEngineEffectsManager->onCallbackStart();
+        GroupFeatureState features;
+        SampleUtil::clear(pOutput, numSamples);
+        m_pEngineEffectsManager->beginParallelBatch();
+        for (std::size_t i = 0; i < m_inputHandles.size(); ++i) {
+            m_pEngineEffectsManager->processPostFaderAndMix(
+                    m_inputHandles[i], outputHandle,
+                    const_cast<CSAMPLE*>(deckBuffers[i].data()), pOutput,
+                    numSamples, kSampleRate, features);
+        }
+        m_pEngineEffectsManager->finishParallelBatch();
+    }
+
+    // Processes all decks in place like EngineMaster does for the
+    // crossfader buses and returns the processed signal in deckBuffers.
+    void processInPlace(std::vector<mixxx::SampleBuffer>* pDeckBuffers,
+                        const ChannelHandle& outputHandle,
+                        unsigned int numSamples) {
+        m_pEngineEffectsManager->onCallbackStart();
+        GroupFeatureState features;
+        m_pEngineEffectsManager->beginParallelBatch();
+        for (std::size_t i = 0; i < m_inputHandles.size(); ++i) {
+            m_pEngineEffectsManager->processPostFaderInPlace(
+                    m_inputHandles[i], outputHandle,
+                    (*pDeckBuffers)[i].data(),
+                    numSamples, kSampleRate, features);
+        }
+        m_pEngineEffectsManager->finishParallelBatch();
+    }
+
+    // Appends an enabled built-in effect to the chain.
+    template<class EffectType>
+    EngineEffect* addEffect() {
+        return addEffect(EffectType::getManifest(),
+                EffectInstantiatorPointer(
+                        new EffectProcessorInstantiator<EffectType>()));
+    }
+
+    EngineEffect* addEffect(EffectManifestPointer pManifest,
+                            EffectInstantiatorPointer pInstantiator) {
+        auto pEffect = std::make_unique<EngineEffect>(
+                pManifest, m_inputChannels, m_pEffectsManager, pInstantiator);
+
+        EffectsRequest* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ADD_EFFECT_TO_CHAIN;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->AddEffectToChain.pEffect = pEffect.get();
+        pRequest->AddEffectToChain.iIndex = static_cast<int>(m_effects.size());
+        sendRequest(pRequest);
+
+        pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::SET_EFFECT_PARAMETERS;
+        pRequest->pTargetEffect = pEffect.get();
+        pRequest->SetEffectParameters.enabled = true;
+        sendRequest(pRequest);
+
+        m_effects.push_back(std::move(pEffect));
+        applyRequests();
+        return m_effects.back().get();
+    }
+
+    void setParameter(EngineEffect* pEffect, int iParameter, double value) {
+        const EffectManifestParameterPointer pManifestParameter =
+                pEffect->getManifest()->parameters().at(iParameter);
+        EffectsRequest* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::SET_PARAMETER_PARAMETERS;
+        pRequest->pTargetEffect = pEffect;
+        pRequest->SetParameterParameters.iParameter = iParameter;
+        pRequest->minimum = pManifestParameter->getMinimum();
+        pRequest->maximum = pManifestParameter->getMaximum();
+        pRequest->default_value = pManifestParameter->getDefault();
+        pRequest->value = value;
+        sendRequest(pRequest);
+        applyRequests();
+    }
+
+  private:
+    void applyRequests() {
+        m_pEngineEffectsManager->onCallbackStart();
+        EffectsResponse response;
+        while (m_pRequestPipe->readMessage(&response)) {
+            EXPECT_TRUE(response.success);
+        }
+    }
+
+    void sendRequest(EffectsRequest* pRequest) {
+        pRequest->request_id = static_cast<qint64>(m_requests.size());
+        m_requests.emplace_back(pRequest);
+        m_pRequestPipe->writeMessage(pRequest);
+    }
+
+    EffectsManager* const m_pEffectsManager;
+    const QSet<ChannelHandleAndGroup> m_inputChannels;
+    std::vector<ChannelHandle> m_inputHandles;
+    QScopedPointer<EffectsRequestPipe> m_pRequestPipe;
+    std::vector<std::unique_ptr<EffectsRequest>> m_requests;
+    std::unique_ptr<EngineEffectRack> m_pRack;
+    std::unique_ptr<EngineEffectChain> m_pChain;
+    std::vector<std::unique_ptr<EngineEffect>> m_effects;
+    std::unique_ptr<EngineEffectsManager> m_pEngineEffectsManager;
+};
+
+// Owns everything that is needed to construct EngineEffectsRigs.
+class EngineEffectsRigEnvironment {
+  public:
+    explicit EngineEffectsRigEnvironment(UserSettingsPointer pConfig)
+            : m_effectsManager(nullptr, pConfig, &m_channelHandleFactory),
+              m_outputChannel(
+                      m_channelHandleFactory.getOrCreateHandle("[Master]"),
+                      "[Master]") {
+        m_effectsManager.registerOutputChannel(m_outputChannel);
+        m_outputChannels.insert(m_outputChannel);
+        for (int i = 1; i <= kNumDecks; ++i) {
+            const QString group = QString("[Channel%1]").arg(i);
+            ChannelHandleAndGroup inputChannel(
+                    m_channelHandleFactory.getOrCreateHandle(group), group);
+            m_effectsManager.registerInputChannel(inputChannel);
+            m_inputChannels.insert(inputChannel);
+        }
+    }
+
+    std::unique_ptr<EngineEffectsRig> createRig(int numWorkerThreads) {
+        return std::make_unique<EngineEffectsRig>(&m_effectsManager,
+                m_inputChannels, m_outputChannels, numWorkerThreads);
+    }
+
+    // A rig with echo, reverb and flanger.
+    std::unique_ptr<EngineEffectsRig> createDelayRig(int numWorkerThreads) {
+        auto pRig = createRig(numWorkerThreads);
+        pRig->addEffect<EchoEffect>();
+        pRig->addEffect<ReverbEffect>();
+        pRig->addEffect<FlangerEffect>();
+        return pRig;
+    }
+
+    const ChannelHandle& outputHandle() const {
+        return m_outputChannel.handle();
+    }
+
+  private:
+    ChannelHandleFactory m_channelHandleFactory;
+    EffectsManager m_effectsManager;
+    ChannelHandleAndGroup m_outputChannel;
+    QSet<ChannelHandleAndGroup> m_inputChannels;
+    QSet<ChannelHandleAndGroup> m_outputChannels;
+};
+
+inline std::vector<mixxx::SampleBuffer> makeDeckBuffers(unsigned int numSamples) {
+    std::vector<mixxx::SampleBuffer> deckBuffers;
+    for (int deck = 0; deck < kNumDecks; ++deck) {
+        deckBuffers.emplace_back(numSamples);
+        for (unsigned int i = 0; i < numSamples; ++i) {
+            // A different tone on every deck.
+            deckBuffers.back()[i] = static_cast<CSAMPLE>(
+                    0.5 * sin(2 * M_PI * (deck + 1) * 110 * (i / 2) / kSampleRate));
+        }
+    }
+    return deckBuffers;
+}
@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <optional>
+#include <vector>
+
+#include "engine/enginerenderer.h"
+#include "recording/defs_recording.h"
+#include "test/realtimesafetychecker.h"
+#include "test/signalpathtest.h"
+#include "test/testplayermanager.h"
+#include "util/sample.h"
+
+namespace {
+
+const int kFramesPerBuffer = 512;
+
+// Checks the real-time safety of the engine while processing a buffer
+class RealtimeCallbacks : public EngineRenderer::CallbackListener {
+  public:
+    void callbackStarted() override {
+        m_realtimeThread.emplace();
+    }
+
+    void callbackFinished() override {
+        m_realtimeThread.reset();
+    }
+
+  private:
+    std::optional<RealtimeSafetyChecker::ScopedRealtimeThread> m_realtimeThread;
+};
+
+class EngineRendererTest : public BaseSignalPathTest {
+  protected:
+    EngineRendererTest()
+            : m_masterOutput(AudioOutput::MASTER, 0, 2) {
+        m_playerManager.addDeck(m_pMixerDeck1);
+        m_playerManager.addDeck(m_pMixerDeck2);
+        m_playerManager.addDeck(m_pMixerDeck3);
+    }
+
+    TrackPointer newSineTrack() const {
+        return Track::newTemporary(QDir::currentPath() + "/src/test/sine-30.wav");
+    }
+
+    // Renders the master output into m_output
+    bool render(const EngineRenderTimeline& timeline, int numBuffers) {
+        m_output.clear();
+        EngineRenderer renderer(m_pEngineMaster, &m_playerManager, kFramesPerBuffer);
+        renderer.setCallbackListener(&m_realtimeCallbacks);
+        return renderer.render(timeline, numBuffers * kFramesPerBuffer, m_masterOutput,
+                [this](const CSAMPLE* pBuffer, int iBufferSize) {
+                    m_output.insert(m_output.end(), pBuffer, pBuffer + iBufferSize);
+                });
+    }
+
+    CSAMPLE peakOfBuffer(int buffer) const {
+        return SampleUtil::maxAbsAmplitude(
+                m_output.data() + buffer * kFramesPerBuffer * 2,
+                kFramesPerBuffer * 2);
+    }
+
+    const AudioOutput m_masterOutput;
+    TestPlayerManager m_playerManager;
+    RealtimeCallbacks m_realtimeCallbacks;
+    std::vector<CSAMPLE> m_output;
+};
+
+TEST_F(EngineRendererTest, LoadsAndPlaysTracksFromTimeline) {
+    EngineRenderTimeline timeline;
+    timeline.loadTrack(0, m_sGroup1, newSineTrack());
+    timeline.setControl(4 * kFramesPerBuffer, ConfigKey(m_sGroup1, "play"), 1.0);
+
+    const int numBuffers = 16;
+    ASSERT_TRUE(render(timeline, numBuffers));
+    ASSERT_EQ(static_cast<size_t>(numBuffers * kFramesPerBuffer * 2), m_output.size());
+
+    for (int buffer = 0; buffer < 4; ++buffer) {
+        EXPECT_EQ(0.0f, peakOfBuffer(buffer)) << "buffer " << buffer;
+    }
+    // The readers are waited for, so there are no drop outs after the
+    // first buffer of playing.
+    for (int buffer = 5; buffer < numBuffers; ++buffer) {
+        EXPECT_LT(0.1f, peakOfBuffer(buffer)) << "buffer " << buffer;
+    }
+}
+
+TEST_F(EngineRendererTest, RampsCrossfader) {
+    // Deck 1 on the left side fades out when moving the crossfader from the
+    // left to the right.
+    EngineRenderTimeline timeline;
+    timeline.loadTrack(0, m_sGroup1, newSineTrack(), true);
+    timeline.setControl(0, ConfigKey(m_sGroup1, "orientation"), EngineChannel::LEFT);
+    timeline.rampControl(4 * kFramesPerBuffer, 12 * kFramesPerBuffer,
+            ConfigKey(m_sMasterGroup, "crossfader"), -1.0, 1.0);
+
+    const int numBuffers = 16;
+    ASSERT_TRUE(render(timeline, numBuffers));
+
+    EXPECT_LT(0.1f, peakOfBuffer(3));
+    EXPECT_DOUBLE_EQ(1.0, ControlObject::get(ConfigKey(m_sMasterGroup, "crossfader")));
+    EXPECT_GT(peakOfBuffer(3), peakOfBuffer(10));
+    EXPECT_GT(1e-3f, peakOfBuffer(numBuffers - 1));
+}
+
+TEST_F(EngineRendererTest, FailsForUnknownPlayer) {
+    EngineRenderTimeline timeline;
+    timeline.loadTrack(0, "[Channel9]", newSineTrack());
+    EXPECT_FALSE(render(timeline, 2));
+    // The remaining timeline is rendered anyway
+    EXPECT_EQ(static_cast<size_t>(2 * kFramesPerBuffer * 2), m_output.size());
+}
+
+TEST_F(EngineRendererTest, RendersToWaveFile) {
+    EngineRenderTimeline timeline;
+    timeline.loadTrack(0, m_sGroup1, newSineTrack(), true);
+
+    QTemporaryDir outputDir;
+    ASSERT_TRUE(outputDir.isValid());
+    const QString filePath = outputDir.filePath("render.wav");
+    const SINT numFrames = 44100;
+    EngineRenderer renderer(m_pEngineMaster, &m_playerManager, kFramesPerBuffer);
+    ASSERT_TRUE(renderer.renderToFile(timeline, numFrames, m_masterOutput,
+            filePath,
+            EncoderFactory::getFactory().getFormatFor(ENCODING_WAVE),
+            config()));
+
+    // At least 16 bit stereo samples
+    EXPECT_LE(numFrames * 2 * 2, QFileInfo(filePath).size());
+    EXPECT_LT(0.0, renderer.realTimeFactor());
+}
+
+TEST_F(EngineRendererTest, ParsesTimeline) {
+    const QString script = QStringLiteral(
+            "# Crossfade from deck 1 to deck 2\n"
+            "load 0 [Channel1] play sine 30.wav\n"
+            "load 0 [Channel2] cue sine 30.wav\n"
+            "set 0.5 [Channel2] play 1\n"
+            "\n"
+            "ramp 0.5 1.5 [Master] crossfader -1 1\n"
+            "end 2\n");
+    QStringList locations;
+    EngineRenderTimeline timeline;
+    SINT endFrame = 0;
+    QString error;
+    ASSERT_TRUE(timeline.parse(script, 1000,
+            [this, &locations](const QString& location) {
+                locations.append(location);
+                return newSineTrack();
+            },
+            &endFrame,
+            &error))
+            << error.toStdString();
+    EXPECT_EQ(2000, endFrame);
+    EXPECT_EQ(QStringList({"sine 30.wav", "sine 30.wav"}), locations);
+
+    ASSERT_TRUE(render(timeline, 4));
+    EXPECT_DOUBLE_EQ(1.0, ControlObject::get(ConfigKey(m_sGroup2, "play")));
+    EXPECT_DOUBLE_EQ(1.0, ControlObject::get(ConfigKey(m_sMasterGroup, "crossfader")));
+}
+
+TEST_F(EngineRendererTest, RejectsInvalidTimeline) {
+    const auto resolveTrack = [this](const QString&) {
+        return newSineTrack();
+    };
+    SINT endFrame = 0;
+    QString error;
+    EngineRenderTimeline timeline;
+    // Missing end
+    EXPECT_FALSE(timeline.parse("set 0 [Master] crossfader 0", 1000,
+            resolveTrack, &endFrame, &error));
+    // Negative time
+    EXPECT_FALSE(timeline.parse("set -1 [Master] crossfader 0\nend 1", 1000,
+            resolveTrack, &endFrame, &error));
+    // Ramp that ends before it starts
+    EXPECT_FALSE(timeline.parse("ramp 2 1 [Master] crossfader -1 1\nend 3", 1000,
+            resolveTrack, &endFrame, &error));
+    EXPECT_TRUE(error.startsWith("Line 1:"));
+    // Unknown file
+    EXPECT_FALSE(timeline.parse("load 0 [Channel1] play missing.wav\nend 1", 1000,
+            [](const QString&) { return TrackPointer(); },
+            &endFrame, &error));
+}
+
+class EngineRenderBenchmarkEnvironment : public EngineRendererTest {
+  public:
+    // The fixture is only used for setting up the engine
+    void TestBody() override {
+    }
+
+    EngineRenderTimeline mixTimeline(int numDecks, SINT numFrames) const {
+        const char* groups[] = {m_sGroup1, m_sGroup2, m_sGroup3};
+        EngineRenderTimeline timeline;
+        for (int i = 0; i < numDecks; ++i) {
+            // Play the track from the start again in every run
+            timeline.loadTrack(0, groups[i], newSineTrack(), true);
+            timeline.setControl(0, ConfigKey(groups[i], "orientation"),
+                    i % 2 == 0 ? EngineChannel::LEFT : EngineChannel::RIGHT);
+        }
+        timeline.rampControl(0, numFrames,
+                ConfigKey(m_sMasterGroup, "crossfader"), -1.0, 1.0);
+        return timeline;
+    }
+
+    EngineMaster* engineMaster() const {
+        return m_pEngineMaster;
+    }
+    PlayerManagerInterface* playerManager() {
+        return &m_playerManager;
+    }
+};
+
+// Renders 20 seconds of a crossfade between the playing decks. The argument
+// is the number of decks.
+static void BM_EngineRenderMix(benchmark::State& state) {
+    EngineRenderBenchmarkEnvironment environment;
+    const SINT numFrames = 20 * 44100;
+    const EngineRenderTimeline timeline = environment.mixTimeline(
+            static_cast<int>(state.range(0)), numFrames);
+    const AudioOutput masterOutput(AudioOutput::MASTER, 0, 2);
+    EngineRenderer renderer(environment.engineMaster(),
+            environment.playerManager());
+
+    double realTimeFactor = 0.0;
+    while (state.KeepRunning()) {
+        if (!renderer.render(timeline, numFrames, masterOutput,
+                    [](const CSAMPLE*, int) {})) {
+            state.SkipWithError("Failed to load the tracks");
+            return;
+        }
+        realTimeFactor += renderer.realTimeFactor();
+    }
+    state.SetItemsProcessed(state.iterations() * numFrames);
+    state.counters["realtime_x"] = benchmark::Counter(
+            realTimeFactor, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EngineRenderMix)->Unit(benchmark::kMillisecond)->Arg(1)->Arg(3);
+
+} // namespace
@@ -0,0 +1,294 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "effects/builtin/builtinbackend.h"
+#include "effects/effectchain.h"
+#include "effects/effectchainslot.h"
+#include "effects/effectrack.h"
+#include "engine/enginerenderer.h"
+#include "test/allocationcounter.h"
+#include "test/signalpathtest.h"
+#include "test/testplayermanager.h"
+#include "util/performancetimer.h"
+
+// Replays a scripted DJ session on 4 decks with sync, keylock, loops,
+// scratching and effects through the whole engine and measures every
+// callback. Trends can be tracked with the JSON output of the benchmark
+// library, e.g.
+//   mixxx-test --benchmark --benchmark_filter=EngineSession \
+//       --benchmark_out=session.json --benchmark_out_format=json
+
+namespace {
+
+const char* kGroup4 = "[Channel4]";
+const int kSampleRate = 44100;
+const double kSessionSeconds = 24.0;
+
+SINT framesAt(double seconds) {
+    return static_cast<SINT>(seconds * kSampleRate);
+}
+
+// Collects the duration and the allocations of each callback without
+// allocating itself.
+class CallbackStats : public EngineRenderer::CallbackListener {
+  public:
+    explicit CallbackStats(int maxCallbacks)
+            : m_totalAllocations(0),
+              m_callbacksWithAllocations(0) {
+        m_durationsNanos.reserve(maxCallbacks);
+    }
+
+    void clear() {
+        m_durationsNanos.clear();
+        m_totalAllocations = 0;
+        m_callbacksWithAllocations = 0;
+    }
+
+    void callbackStarted() override {
+        m_allocationCounter.reset();
+        m_timer.start();
+    }
+
+    void callbackFinished() override {
+        const qint64 durationNanos = m_timer.elapsed().toIntegerNanos();
+        const quint64 allocations = m_allocationCounter.count();
+        DEBUG_ASSERT(m_durationsNanos.size() < m_durationsNanos.capacity());
+        m_durationsNanos.push_back(durationNanos);
+        m_totalAllocations += allocations;
+        if (allocations > 0) {
+            ++m_callbacksWithAllocations;
+        }
+    }
+
+    int callbacks() const {
+        return static_cast<int>(m_durationsNanos.size());
+    }
+
+    // The nearest-rank percentile of the callback durations in
+    // microseconds, 1.0 is the maximum.
+    double percentileMicros(double percentile) {
+        if (m_durationsNanos.empty()) {
+            return 0.0;
+        }
+        const auto rank = static_cast<size_t>(
+                std::ceil(percentile * m_durationsNanos.size()));
+        const auto nth = m_durationsNanos.begin() +
+                std::min(std::max(rank, size_t(1)), m_durationsNanos.size()) - 1;
+        std::nth_element(m_durationsNanos.begin(), nth, m_durationsNanos.end());
+        return *nth / 1000.0;
+    }
+
+    quint64 totalAllocations() const {
+        return m_totalAllocations;
+    }
+
+    int callbacksWithAllocations() const {
+        return m_callbacksWithAllocations;
+    }
+
+  private:
+    PerformanceTimer m_timer;
+    AllocationCounter m_allocationCounter;
+    std::vector<qint64> m_durationsNanos;
+    quint64 m_totalAllocations;
+    int m_callbacksWithAllocations;
+};
+
+class EngineSessionTest : public BaseSignalPathTest {
+  protected:
+    EngineSessionTest() {
+        m_pMixerDeck4 = new Deck(nullptr, m_pConfig, m_pEngineMaster,
+                m_pEffectsManager, m_pVisualsManager, EngineChannel::CENTER, kGroup4);
+        m_pMixerDeck4->setupEqControls();
+        addDeck(m_pMixerDeck4->getEngineDeck());
+
+        m_playerManager.addDeck(m_pMixerDeck1);
+        m_playerManager.addDeck(m_pMixerDeck2);
+        m_playerManager.addDeck(m_pMixerDeck3);
+        m_playerManager.addDeck(m_pMixerDeck4);
+
+        // An effect unit with an echo, a filter and a reverb
+        m_pEffectsManager->addEffectsBackend(new BuiltInBackend(m_pEffectsManager));
+        StandardEffectRackPointer pRack = m_pEffectsManager->addStandardEffectRack();
+        EffectChainPointer pChain(new EffectChain(m_pEffectsManager,
+                "org.mixxx.test.session"));
+        pChain->addEffect(m_pEffectsManager->instantiateEffect("org.mixxx.effects.echo"));
+        pChain->addEffect(m_pEffectsManager->instantiateEffect("org.mixxx.effects.filter"));
+        pChain->addEffect(m_pEffectsManager->instantiateEffect("org.mixxx.effects.reverb"));
+        pRack->getEffectChainSlot(0)->loadEffectChainToSlot(pChain);
+    }
+
+    ~EngineSessionTest() override {
+        delete m_pMixerDeck4;
+    }
+
+    TrackPointer newTrack(double bpm) const {
+        TrackPointer pTrack = Track::newTemporary(
+                QDir::currentPath() + "/src/test/sine-30.wav");
+        pTrack->setBpm(bpm);
+        return pTrack;
+    }
+
+    // A mix of all 4 decks: Deck 1 is played with keylock while pitching
+    // and looping it, deck 2 and 3 are synced, deck 4 is scratched.
+    // Deck 2 is sent to the effect unit.
+    EngineRenderTimeline sessionTimeline() const {
+        const QString unit = StandardEffectRack::formatEffectChainSlotGroupString(0, 0);
+        const ConfigKey crossfader(m_sMasterGroup, "crossfader");
+        EngineRenderTimeline timeline;
+
+        timeline.loadTrack(0, m_sGroup1, newTrack(120.0), true);
+        timeline.loadTrack(0, m_sGroup2, newTrack(124.0));
+        timeline.loadTrack(0, m_sGroup3, newTrack(126.0));
+        timeline.loadTrack(0, kGroup4, newTrack(128.0));
+        timeline.setControl(0, ConfigKey(m_sGroup1, "orientation"), EngineChannel::LEFT);
+        timeline.setControl(0, ConfigKey(m_sGroup2, "orientation"), EngineChannel::RIGHT);
+        timeline.setControl(0, ConfigKey(m_sGroup3, "orientation"), EngineChannel::LEFT);
+        timeline.setControl(0, ConfigKey(kGroup4, "orientation"), EngineChannel::RIGHT);
+        // Reset what previous runs of the session have changed
+        timeline.setControl(0, crossfader, -1.0);
+        timeline.setControl(0, ConfigKey(m_sGroup1, "rate"), 0.0);
+        timeline.setControl(0, ConfigKey(m_sGroup2, "sync_enabled"), 0.0);
+        timeline.setControl(0, ConfigKey(m_sGroup3, "sync_enabled"), 0.0);
+        for (const char* group : {m_sGroup1, m_sGroup2}) {
+            timeline.setControl(0, ConfigKey(group, "beatloop_4_activate"), 0.0);
+            timeline.setControl(0, ConfigKey(group, "beatloop_1_activate"), 0.0);
+            timeline.setControl(0, ConfigKey(group, "reloop_toggle"), 0.0);
+        }
+        timeline.setControl(0, ConfigKey(m_sGroup1, "keylock"), 1.0);
+        timeline.setControl(0, ConfigKey(m_sGroup3, "keylock"), 1.0);
+
+        timeline.setControl(0, ConfigKey(unit, "enabled"), 1.0);
+        timeline.setControl(0, ConfigKey(unit, QString("group_%1_enable").arg(m_sGroup2)), 1.0);
+        for (unsigned int effect = 0; effect < 3; ++effect) {
+            timeline.setControl(0,
+                    ConfigKey(StandardEffectRack::formatEffectSlotGroupString(0, 0, effect),
+                            "enabled"),
+                    1.0);
+        }
+        timeline.setControl(0, ConfigKey(unit, "mix"), 0.0);
+
+        timeline.setControl(framesAt(2), ConfigKey(m_sGroup2, "sync_enabled"), 1.0);
+        timeline.setControl(framesAt(2), ConfigKey(m_sGroup2, "play"), 1.0);
+        timeline.rampControl(framesAt(4), framesAt(8), ConfigKey(m_sGroup1, "rate"), 0.0, 0.3);
+        timeline.setControl(framesAt(6), ConfigKey(m_sGroup1, "beatloop_4_activate"), 1.0);
+        timeline.setControl(framesAt(8), ConfigKey(m_sGroup3, "sync_enabled"), 1.0);
+        timeline.setControl(framesAt(8), ConfigKey(m_sGroup3, "play"), 1.0);
+        timeline.rampControl(framesAt(8), framesAt(16), crossfader, -1.0, 1.0);
+        timeline.setControl(framesAt(10), ConfigKey(m_sGroup1, "reloop_toggle"), 1.0);
+
+        timeline.setControl(framesAt(12), ConfigKey(kGroup4, "play"), 1.0);
+        timeline.setControl(framesAt(12), ConfigKey(kGroup4, "scratch2_enable"), 1.0);
+        timeline.rampControl(framesAt(12), framesAt(13), ConfigKey(kGroup4, "scratch2"), 1.0, -1.5);
+        timeline.rampControl(framesAt(13), framesAt(14), ConfigKey(kGroup4, "scratch2"), -1.5, 2.0);
+        timeline.setControl(framesAt(14), ConfigKey(kGroup4, "scratch2_enable"), 0.0);
+
+        timeline.rampControl(framesAt(16), framesAt(20), ConfigKey(unit, "mix"), 0.0, 1.0);
+        timeline.setControl(framesAt(18), ConfigKey(m_sGroup2, "beatloop_1_activate"), 1.0);
+        timeline.setControl(framesAt(20), ConfigKey(m_sGroup2, "reloop_toggle"), 1.0);
+        timeline.setControl(framesAt(22), ConfigKey(m_sGroup3, "play"), 0.0);
+        return timeline;
+    }
+
+    Deck* m_pMixerDeck4;
+    TestPlayerManager m_playerManager;
+};
+
+TEST_F(EngineSessionTest, ReplaysSession) {
+    EngineRenderer renderer(m_pEngineMaster, &m_playerManager);
+    const SINT numFrames = framesAt(kSessionSeconds);
+    CallbackStats stats(numFrames / renderer.framesPerBuffer() + 1);
+    renderer.setCallbackListener(&stats);
+    ASSERT_TRUE(renderer.render(sessionTimeline(), numFrames,
+            AudioOutput(AudioOutput::MASTER, 0, 2),
+            [](const CSAMPLE*, int) {}));
+
+    EXPECT_EQ((numFrames + renderer.framesPerBuffer() - 1) / renderer.framesPerBuffer(),
+            stats.callbacks());
+    EXPECT_LE(stats.percentileMicros(0.5), stats.percentileMicros(0.99));
+    EXPECT_LE(stats.percentileMicros(0.99), stats.percentileMicros(1.0));
+
+    // All decks have been played
+    for (const char* group : {m_sGroup1, m_sGroup2, m_sGroup3, kGroup4}) {
+        EXPECT_LT(0.0, ControlObject::get(ConfigKey(group, "playposition")))
+                << group;
+    }
+    EXPECT_DOUBLE_EQ(1.0, ControlObject::get(ConfigKey(m_sGroup1, "play")));
+    EXPECT_DOUBLE_EQ(0.0, ControlObject::get(ConfigKey(m_sGroup3, "play")));
+    EXPECT_DOUBLE_EQ(0.0, ControlObject::get(ConfigKey(m_sGroup1, "loop_enabled")));
+    EXPECT_DOUBLE_EQ(0.0, ControlObject::get(ConfigKey(m_sGroup2, "loop_enabled")));
+    EXPECT_DOUBLE_EQ(1.0, ControlObject::get(ConfigKey(m_sGroup2, "sync_enabled")));
+}
+
+class EngineSessionBenchmarkEnvironment : public EngineSessionTest {
+  public:
+    // The fixture is only used for setting up the engine
+    void TestBody() override {
+    }
+
+    using EngineSessionTest::sessionTimeline;
+
+    EngineMaster* engineMaster() const {
+        return m_pEngineMaster;
+    }
+    PlayerManagerInterface* playerManager() {
+        return &m_playerManager;
+    }
+};
+
+// Callback latency percentiles and allocations of the whole engine during
+// the session. The argument is the number of frames per buffer.
+static void BM_EngineSessionCallbacks(benchmark::State& state) {
+    EngineSessionBenchmarkEnvironment environment;
+    const EngineRenderTimeline timeline = environment.sessionTimeline();
+    const SINT numFrames = framesAt(kSessionSeconds);
+    const AudioOutput masterOutput(AudioOutput::MASTER, 0, 2);
+    EngineRenderer renderer(environment.engineMaster(),
+            environment.playerManager(),
+            static_cast<int>(state.range(0)));
+    CallbackStats stats(numFrames / renderer.framesPerBuffer() + 1);
+    renderer.setCallbackListener(&stats);
+
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double p999 = 0.0;
+    double max = 0.0;
+    double allocations = 0.0;
+    double callbacksWithAllocations = 0.0;
+    while (state.KeepRunning()) {
+        stats.clear();
+        if (!renderer.render(timeline, numFrames, masterOutput,
+                    [](const CSAMPLE*, int) {})) {
+            state.SkipWithError("Failed to load the tracks");
+            return;
+        }
+        state.PauseTiming();
+        p50 += stats.percentileMicros(0.5);
+        p99 += stats.percentileMicros(0.99);
+        p999 += stats.percentileMicros(0.999);
+        max += stats.percentileMicros(1.0);
+        allocations += static_cast<double>(stats.totalAllocations()) / stats.callbacks();
+        callbacksWithAllocations += stats.callbacksWithAllocations();
+        state.ResumeTiming();
+    }
+    state.counters["p50_us"] = benchmark::Counter(p50, benchmark::Counter::kAvgIterations);
+    state.counters["p99_us"] = benchmark::Counter(p99, benchmark::Counter::kAvgIterations);
+    state.counters["p99.9_us"] = benchmark::Counter(p999, benchmark::Counter::kAvgIterations);
+    state.counters["max_us"] = benchmark::Counter(max, benchmark::Counter::kAvgIterations);
+    if (AllocationCounter::isSupported()) {
+        state.counters["allocs_per_callback"] = benchmark::Counter(
+                allocations, benchmark::Counter::kAvgIterations);
+        state.counters["callbacks_with_allocs"] = benchmark::Counter(
+                callbacksWithAllocations, benchmark::Counter::kAvgIterations);
+    }
+}
+BENCHMARK(BM_EngineSessionCallbacks)
+        ->Unit(benchmark::kMillisecond)
+        ->Arg(256)
+        ->Arg(1024);
+
+} // namespace
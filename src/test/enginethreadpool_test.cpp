@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QThread>
+
+#include <atomic>
+#include <vector>
+
+#include "engine/enginethreadpool.h"
+
+namespace {
+
+// Records which thread has processed each part. Parts of helper threads
+// block while the job is stalled.
+class StallingJob : public EngineThreadPoolJob {
+  public:
+    explicit StallingJob(int numParts)
+            : m_threadIndices(numParts),
+              m_stall(false) {
+        for (auto& threadIndex : m_threadIndices) {
+            threadIndex.store(-1);
+        }
+    }
+
+    void runJobPart(int partIndex, int threadIndex) override {
+        if (m_stall.load()) {
+            if (threadIndex == 0) {
+                // Leaves a part for the helper
+                EXPECT_TRUE(m_stalled.tryAcquire(1, 10000));
+            } else {
+                m_stalled.release();
+                m_resume.acquire();
+            }
+        }
+        m_threadIndices[partIndex].store(threadIndex);
+    }
+
+    int threadIndex(int partIndex) const {
+        return m_threadIndices[partIndex].load();
+    }
+
+    void stall() {
+        m_stall.store(true);
+    }
+
+    void resume() {
+        m_stall.store(false);
+        m_resume.release();
+    }
+
+  private:
+    std::vector<std::atomic<int>> m_threadIndices;
+    std::atomic<bool> m_stall;
+    QSemaphore m_stalled;
+    QSemaphore m_resume;
+};
+
+bool waitUntilIdle(const EngineThreadPool& pool) {
+    for (int i = 0; i < 10000 && pool.isBusy(); ++i) {
+        QThread::msleep(1);
+    }
+    return !pool.isBusy();
+}
+
+TEST(EngineThreadPoolTest, ProcessesAllParts) {
+    EngineThreadPool pool(2);
+    StallingJob job(8);
+    EXPECT_TRUE(pool.run(&job, 8));
+    for (int part = 0; part < 8; ++part) {
+        EXPECT_LE(0, job.threadIndex(part));
+        EXPECT_GT(pool.numThreads(), job.threadIndex(part));
+    }
+}
+
+TEST(EngineThreadPoolTest, StalledHelperCancelsJob) {
+    EngineThreadPool pool(1, mixxx::Duration::fromMillis(1));
+    StallingJob job(2);
+    job.stall();
+    // Returns while the helper is stalled in its part
+    EXPECT_FALSE(pool.run(&job, 2));
+    int helperPart = job.threadIndex(0) == 0 ? 1 : 0;
+    EXPECT_EQ(0, job.threadIndex(1 - helperPart));
+    EXPECT_TRUE(pool.isPartFinished(1 - helperPart));
+    EXPECT_FALSE(pool.isPartFinished(helperPart));
+    EXPECT_TRUE(pool.isBusy());
+
+    // The stalled helper doesn't get any parts of the next job
+    StallingJob nextJob(4);
+    EXPECT_TRUE(pool.run(&nextJob, 4));
+    for (int part = 0; part < 4; ++part) {
+        EXPECT_EQ(0, nextJob.threadIndex(part));
+    }
+
+    job.resume();
+    ASSERT_TRUE(waitUntilIdle(pool));
+    EXPECT_EQ(1, job.threadIndex(helperPart));
+    StallingJob lastJob(4);
+    EXPECT_TRUE(pool.run(&lastJob, 4));
+}
+
+} // namespace
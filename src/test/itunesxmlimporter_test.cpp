@@ -0,0 +1,272 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <atomic>
+
+#include "library/importbatchwriter.h"
+#include "library/itunes/itunesxmlimporter.h"
+#include "library/treeitem.h"
+#include "test/librarytest.h"
+
+namespace {
+
+// Writes an iTunes Music Library.xml with the given number of tracks
+// and playlists. Every playlist refers to tracksPerPlaylist tracks.
+bool writeITunesXml(
+        const QString& filePath,
+        int trackCount,
+        int playlistCount,
+        int tracksPerPlaylist) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<plist version=\"1.0\">\n<dict>\n"
+        << "\t<key>Major Version</key><integer>1</integer>\n"
+        << "\t<key>Tracks</key>\n\t<dict>\n";
+    for (int id = 1; id <= trackCount; ++id) {
+        out << "\t\t<key>" << id << "</key>\n\t\t<dict>\n"
+            << "\t\t\t<key>Track ID</key><integer>" << id << "</integer>\n"
+            << "\t\t\t<key>Name</key><string>Title " << id << "</string>\n"
+            << "\t\t\t<key>Artist</key><string>Artist " << id % 100 << "</string>\n"
+            << "\t\t\t<key>Album</key><string>Album " << id % 1000 << "</string>\n"
+            << "\t\t\t<key>Genre</key><string>House</string>\n"
+            << "\t\t\t<key>Total Time</key><integer>" << 180000 + id << "</integer>\n"
+            << "\t\t\t<key>Track Number</key><integer>" << id % 20 << "</integer>\n"
+            << "\t\t\t<key>BPM</key><integer>124</integer>\n"
+            << "\t\t\t<key>Bit Rate</key><integer>320</integer>\n"
+            << "\t\t\t<key>Rating</key><integer>80</integer>\n"
+            << "\t\t\t<key>Track Type</key><string>File</string>\n"
+            << "\t\t\t<key>Location</key><string>"
+            << "file://localhost/Music/Artist%20" << id % 100
+            << "/Track%20" << id << ".mp3</string>\n"
+            << "\t\t</dict>\n";
+    }
+    // A track from iTunes Match that is not imported
+    out << "\t\t<key>" << trackCount + 1 << "</key>\n\t\t<dict>\n"
+        << "\t\t\t<key>Track ID</key><integer>" << trackCount + 1 << "</integer>\n"
+        << "\t\t\t<key>Name</key><string>Remote</string>\n"
+        << "\t\t\t<key>Track Type</key><string>Remote</string>\n"
+        << "\t\t</dict>\n"
+        << "\t</dict>\n"
+        << "\t<key>Playlists</key>\n\t<array>\n";
+    // The system playlist with all tracks is not imported
+    out << "\t\t<dict>\n"
+        << "\t\t\t<key>Name</key><string>Library</string>\n"
+        << "\t\t\t<key>Master</key><true/>\n"
+        << "\t\t\t<key>Playlist ID</key><integer>1</integer>\n"
+        << "\t\t\t<key>Playlist Items</key>\n\t\t\t<array>\n"
+        << "\t\t\t\t<dict><key>Track ID</key><integer>1</integer></dict>\n"
+        << "\t\t\t</array>\n"
+        << "\t\t</dict>\n";
+    for (int i = 0; i < playlistCount; ++i) {
+        const int playlistId = 1000 + i;
+        out << "\t\t<dict>\n"
+            // Every second playlist has the same name as its predecessor
+            << "\t\t\t<key>Name</key><string>Playlist " << i / 2 << "</string>\n"
+            << "\t\t\t<key>Playlist ID</key><integer>" << playlistId << "</integer>\n"
+            << "\t\t\t<key>Playlist Items</key>\n\t\t\t<array>\n";
+        for (int j = 0; j < tracksPerPlaylist; ++j) {
+            out << "\t\t\t\t<dict><key>Track ID</key><integer>"
+                << (i + j) % trackCount + 1 << "</integer></dict>\n";
+        }
+        out << "\t\t\t</array>\n"
+            << "\t\t</dict>\n";
+    }
+    out << "\t</array>\n"
+        << "</dict>\n</plist>\n";
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+int queryCount(const QSqlDatabase& database, const QString& statement) {
+    QSqlQuery query(database);
+    if (!query.exec(statement) || !query.next()) {
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+class ITunesXmlImporterTest : public LibraryTest {
+  protected:
+    QString xmlPath() const {
+        return m_tempDir.filePath("iTunes Music Library.xml");
+    }
+
+    void clearTables() {
+        QSqlQuery query(dbConnection());
+        query.exec("DELETE FROM itunes_playlist_tracks");
+        query.exec("DELETE FROM itunes_playlists");
+        query.exec("DELETE FROM itunes_library");
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(ITunesXmlImporterTest, ImportTracksAndPlaylists) {
+    const int trackCount = 1000;
+    const int playlistCount = 4;
+    const int tracksPerPlaylist = 300;
+    ASSERT_TRUE(writeITunesXml(xmlPath(), trackCount, playlistCount, tracksPerPlaylist));
+
+    const std::atomic<bool> cancelImport(false);
+    QStringList playlistItemLabels;
+    ITunesXmlImporter importer(
+            xmlPath(),
+            dbConnectionPool(),
+            cancelImport,
+            [&playlistItemLabels](QList<TreeItem*> items) {
+                for (auto* pItem : items) {
+                    playlistItemLabels.append(pItem->getLabel());
+                }
+                qDeleteAll(items);
+            });
+    EXPECT_TRUE(importer.importLibrary());
+
+    EXPECT_EQ(trackCount, queryCount(dbConnection(), "SELECT COUNT(*) FROM itunes_library"));
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "SELECT title, artist, duration, rating, location "
+            "FROM itunes_library WHERE id=42"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(QStringLiteral("Title 42"), query.value(0).toString());
+    EXPECT_EQ(QStringLiteral("Artist 42"), query.value(1).toString());
+    EXPECT_EQ(180, query.value(2).toInt());
+    EXPECT_EQ(4, query.value(3).toInt());
+    EXPECT_TRUE(query.value(4).toString().endsWith("/Music/Artist 42/Track 42.mp3"));
+
+    // Duplicate names are made unique by appending the id
+    const QStringList expectedPlaylists{
+            "Playlist 0",
+            "Playlist 0 #1001",
+            "Playlist 1",
+            "Playlist 1 #1003"};
+    EXPECT_EQ(expectedPlaylists, playlistItemLabels);
+    EXPECT_EQ(playlistCount, queryCount(dbConnection(), "SELECT COUNT(*) FROM itunes_playlists"));
+    EXPECT_EQ(1, queryCount(dbConnection(),
+                      "SELECT COUNT(*) FROM itunes_playlists "
+                      "WHERE id=1003 AND name='Playlist 1 #1003'"));
+    EXPECT_EQ(playlistCount * tracksPerPlaylist,
+            queryCount(dbConnection(), "SELECT COUNT(*) FROM itunes_playlist_tracks"));
+    ASSERT_TRUE(query.exec(
+            "SELECT track_id FROM itunes_playlist_tracks "
+            "WHERE playlist_id=1002 AND position=10"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(12, query.value(0).toInt());
+}
+
+TEST_F(ITunesXmlImporterTest, MissingFile) {
+    const std::atomic<bool> cancelImport(false);
+    ITunesXmlImporter importer(xmlPath(), dbConnectionPool(), cancelImport);
+    EXPECT_FALSE(importer.importLibrary());
+    EXPECT_EQ(0, queryCount(dbConnection(), "SELECT COUNT(*) FROM itunes_library"));
+}
+
+TEST_F(ITunesXmlImporterTest, BatchWriterRetriesFailedRows) {
+    ImportBatchWriter writer(dbConnectionPool());
+    const int tableId = writer.addTable("itunes_playlists", QStringList{"id", "name"});
+    for (int id = 1; id <= 10; ++id) {
+        // The names of the playlists are unique
+        const int nameId = id == 5 ? 1 : id;
+        writer.addRow(tableId, QVariantList{id, QString("Playlist %1").arg(nameId)});
+    }
+    EXPECT_TRUE(writer.finish());
+    EXPECT_EQ(9, writer.rowCount());
+    EXPECT_EQ(9, queryCount(dbConnection(), "SELECT COUNT(*) FROM itunes_playlists"));
+}
+
+class ITunesXmlImporterBenchmarkEnvironment : public ITunesXmlImporterTest {
+  public:
+    // The fixture is only used for the database and the file
+    void TestBody() override {
+    }
+
+    using ITunesXmlImporterTest::clearTables;
+    using ITunesXmlImporterTest::dbConnection;
+    using ITunesXmlImporterTest::dbConnectionPool;
+    using ITunesXmlImporterTest::xmlPath;
+};
+
+// Imports a generated iTunes library with 100k tracks and 100 playlists
+// of 500 tracks each.
+static void BM_ImportITunesXml(benchmark::State& state) {
+    const int trackCount = 100000;
+    const int playlistCount = 100;
+    const int tracksPerPlaylist = 500;
+    ITunesXmlImporterBenchmarkEnvironment environment;
+    if (!writeITunesXml(environment.xmlPath(), trackCount, playlistCount, tracksPerPlaylist)) {
+        state.SkipWithError("Failed to write the file");
+        return;
+    }
+
+    const std::atomic<bool> cancelImport(false);
+    int rowCount = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        environment.clearTables();
+        state.ResumeTiming();
+        ITunesXmlImporter importer(
+                environment.xmlPath(),
+                environment.dbConnectionPool(),
+                cancelImport,
+                [](QList<TreeItem*> items) {
+                    qDeleteAll(items);
+                });
+        if (!importer.importLibrary()) {
+            state.SkipWithError("Failed to import the file");
+            return;
+        }
+        rowCount = queryCount(environment.dbConnection(),
+                "SELECT COUNT(*) FROM itunes_library");
+    }
+    if (rowCount != trackCount) {
+        state.SkipWithError("Failed to import all tracks");
+        return;
+    }
+    state.SetItemsProcessed(state.iterations() *
+            (trackCount + playlistCount * (tracksPerPlaylist + 1)));
+    state.SetBytesProcessed(state.iterations() * QFile(environment.xmlPath()).size());
+}
+BENCHMARK(BM_ImportITunesXml)->Unit(benchmark::kMillisecond);
+
+// Writes 100k track rows with the given number of rows per INSERT
+// statement. A single row per statement corresponds to executing one
+// prepared INSERT per track.
+static void BM_WriteImportBatches(benchmark::State& state) {
+    const int trackCount = 100000;
+    ITunesXmlImporterBenchmarkEnvironment environment;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        environment.clearTables();
+        state.ResumeTiming();
+        ImportBatchWriter writer(
+                environment.dbConnectionPool(),
+                ImportBatchWriter::ProgressCallback(),
+                static_cast<int>(state.range(0)));
+        const int tableId = writer.addTable("itunes_library",
+                QStringList{"id", "artist", "title", "location", "duration"});
+        for (int id = 1; id <= trackCount; ++id) {
+            writer.addRow(tableId,
+                    QVariantList{
+                            id,
+                            QString("Artist %1").arg(id % 100),
+                            QString("Title %1").arg(id),
+                            QString("/Music/Track %1.mp3").arg(id),
+                            180});
+        }
+        if (!writer.finish() || writer.rowCount() != trackCount) {
+            state.SkipWithError("Failed to write all rows");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * trackCount);
+}
+BENCHMARK(BM_WriteImportBatches)->Unit(benchmark::kMillisecond)->Arg(1)->Arg(16)->Arg(256);
+
+} // namespace
@@ -1,15 +1,104 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QEventLoop>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#include <memory>
+
 #include "test/librarytest.h"
 
+#include "library/dao/directorydao.h"
 #include "library/scanner/libraryscanner.h"
 
+namespace {
+
+const ConfigKey kConfigKeyIncrementalRescan("[Library]", "IncrementalRescan");
+const ConfigKey kConfigKeyScannerThreads("[Library]", "ScannerThreads");
+
+// A small MP3 file with ID3 tags.
+const QString kTaggedFileLocation(QDir::currentPath() +
+        "/src/test/id3-test-data/artist.mp3");
+
+// A library of empty files that cannot be decoded, but are imported
+// anyway.
+QString syntheticFilePath(const QString& rootDir, int directory, int file) {
+    return QString("%1/%2/%3.mp3").arg(rootDir).arg(directory).arg(file);
+}
+
+void createSyntheticLibrary(const QString& rootDir,
+                            int numDirectories, int numFilesPerDirectory) {
+    for (int directory = 0; directory < numDirectories; ++directory) {
+        QDir(rootDir).mkpath(QString::number(directory));
+        for (int file = 0; file < numFilesPerDirectory; ++file) {
+            QFile(syntheticFilePath(rootDir, directory, file)).open(QIODevice::WriteOnly);
+        }
+    }
+}
+
+// A library of copies of a tagged file.
+bool createTaggedLibrary(const QString& rootDir,
+                         int numDirectories, int numFilesPerDirectory) {
+    for (int directory = 0; directory < numDirectories; ++directory) {
+        QDir(rootDir).mkpath(QString::number(directory));
+        for (int file = 0; file < numFilesPerDirectory; ++file) {
+            if (!QFile::copy(kTaggedFileLocation,
+                        syntheticFilePath(rootDir, directory, file))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Modifies the file in place like a tag editor without changing the
+// list of files in its directory.
+void appendToFile(const QString& filePath) {
+    QFile file(filePath);
+    file.open(QIODevice::Append);
+    file.write("x");
+}
+
+void scanAndWait(LibraryScanner* pScanner) {
+    QEventLoop loop;
+    QObject::connect(pScanner,
+            &LibraryScanner::scanFinished,
+            &loop,
+            &QEventLoop::quit);
+    pScanner->scan();
+    loop.exec();
+}
+
+void deleteTrack(Track* pTrack) {
+    delete pTrack;
+}
+
+} // anonymous namespace
+
 class LibraryScannerTest : public LibraryTest {
   protected:
     LibraryScannerTest()
         : m_libraryScanner(dbConnectionPool(), config()) {
     }
+
+    void addLibraryDirectory(const QString& dirPath) {
+        DirectoryDAO directoryDao;
+        directoryDao.initialize(dbConnection());
+        directoryDao.addDirectory(dirPath);
+    }
+
+    qint64 savedFileSize(const QString& location) {
+        QSqlQuery query(dbConnection());
+        query.prepare("SELECT size FROM LibraryFileStats WHERE location=:location");
+        query.bindValue(":location", location);
+        if (!query.exec() || !query.next()) {
+            return -1;
+        }
+        return query.value(0).toLongLong();
+    }
+
     LibraryScanner m_libraryScanner;
 };
 
@@ -52,3 +141,149 @@ TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     m_libraryScanner.changeScannerState(LibraryScanner::IDLE);
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
 }
+
+TEST_F(LibraryScannerTest, DetectsModifiedFilesInUnchangedDirectories) {
+    QTemporaryDir musicDir;
+    createSyntheticLibrary(musicDir.path(), 2, 4);
+    addLibraryDirectory(musicDir.path());
+    m_libraryScanner.start();
+
+    scanAndWait(&m_libraryScanner);
+    const QString location = syntheticFilePath(musicDir.path(), 1, 2);
+    EXPECT_EQ(0, savedFileSize(location));
+
+    // Only the directory of the modified file is visited if the library
+    // has been watched since the last scan.
+    appendToFile(location);
+    scanAndWait(&m_libraryScanner);
+    EXPECT_EQ(1, savedFileSize(location));
+
+    // A full rescan compares the status of all files.
+    config()->setValue(kConfigKeyIncrementalRescan, false);
+    appendToFile(location);
+    scanAndWait(&m_libraryScanner);
+    EXPECT_EQ(2, savedFileSize(location));
+    EXPECT_EQ(0, savedFileSize(syntheticFilePath(musicDir.path(), 0, 2)));
+}
+
+TEST_F(LibraryScannerTest, ImportsMetadataOfNewFilesConcurrently) {
+    config()->setValue(kConfigKeyScannerThreads, 4);
+    LibraryScanner libraryScanner(dbConnectionPool(), config());
+    QTemporaryDir musicDir;
+    ASSERT_TRUE(createTaggedLibrary(musicDir.path(), 8, 8));
+    addLibraryDirectory(musicDir.path());
+    libraryScanner.start();
+
+    scanAndWait(&libraryScanner);
+
+    QSqlQuery query(dbConnection());
+    query.prepare("SELECT COUNT(*) FROM library WHERE artist=:artist");
+    query.bindValue(":artist", "Test Artist");
+    ASSERT_TRUE(query.exec());
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(64, query.value(0).toInt());
+}
+
+namespace {
+
+// A library scanner thread with its own database for benchmarks.
+class LibraryScannerBenchmarkEnvironment {
+  public:
+    explicit LibraryScannerBenchmarkEnvironment(UserSettingsPointer pConfig)
+            : m_mixxxDb(pConfig, true),
+              m_dbConnectionPooler(m_mixxxDb.connectionPool()) {
+        const QSqlDatabase dbConnection =
+                mixxx::DbConnectionPooled(m_mixxxDb.connectionPool());
+        MixxxDb::initDatabaseSchema(dbConnection);
+        // Provides the GlobalTrackCache
+        m_pTrackCollectionManager = std::make_unique<TrackCollectionManager>(
+                nullptr, pConfig, m_mixxxDb.connectionPool(), deleteTrack);
+        DirectoryDAO directoryDao;
+        directoryDao.initialize(dbConnection);
+        directoryDao.addDirectory(m_musicDir.path());
+        m_pScanner = std::make_unique<LibraryScanner>(
+                m_mixxxDb.connectionPool(), pConfig);
+        m_pScanner->start();
+    }
+
+    ~LibraryScannerBenchmarkEnvironment() {
+        // Stop the scanner before the GlobalTrackCache is destroyed.
+        m_pScanner.reset();
+    }
+
+    const QString musicDirPath() const {
+        return m_musicDir.path();
+    }
+
+    LibraryScanner* scanner() const {
+        return m_pScanner.get();
+    }
+
+  private:
+    const QTemporaryDir m_musicDir;
+    const MixxxDb m_mixxxDb;
+    const mixxx::DbConnectionPooler m_dbConnectionPooler;
+    std::unique_ptr<TrackCollectionManager> m_pTrackCollectionManager;
+    std::unique_ptr<LibraryScanner> m_pScanner;
+};
+
+// Rescan of a library with 64 directories of 64 files after modifying a
+// single file. The argument enables incremental rescans (1) that only visit
+// the modified directory or forces full rescans (0).
+static void BM_LibraryScannerRescan(benchmark::State& state) {
+    const int numDirectories = 64;
+    const int numFilesPerDirectory = 64;
+    QTemporaryDir configDir;
+    UserSettingsPointer pConfig(new UserSettings(
+            configDir.filePath("benchmark.cfg")));
+    pConfig->setValue(kConfigKeyIncrementalRescan, state.range(0) != 0);
+    LibraryScannerBenchmarkEnvironment environment(pConfig);
+    createSyntheticLibrary(environment.musicDirPath(),
+            numDirectories, numFilesPerDirectory);
+    // Import all files
+    scanAndWait(environment.scanner());
+
+    int iteration = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        appendToFile(syntheticFilePath(environment.musicDirPath(),
+                iteration % numDirectories, iteration % numFilesPerDirectory));
+        ++iteration;
+        state.ResumeTiming();
+        scanAndWait(environment.scanner());
+    }
+    state.SetItemsProcessed(state.iterations() * numDirectories * numFilesPerDirectory);
+}
+BENCHMARK(BM_LibraryScannerRescan)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Initial scan of a library with 10k new tagged files in 100 directories.
+// The argument is the number of threads that import the files.
+static void BM_LibraryScannerImport(benchmark::State& state) {
+    const int numDirectories = 100;
+    const int numFilesPerDirectory = 100;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        QTemporaryDir configDir;
+        UserSettingsPointer pConfig(new UserSettings(
+                configDir.filePath("benchmark.cfg")));
+        pConfig->setValue(kConfigKeyScannerThreads, state.range(0));
+        auto pEnvironment =
+                std::make_unique<LibraryScannerBenchmarkEnvironment>(pConfig);
+        if (!createTaggedLibrary(pEnvironment->musicDirPath(),
+                    numDirectories, numFilesPerDirectory)) {
+            state.SkipWithError("Failed to copy the test data");
+            return;
+        }
+        state.ResumeTiming();
+
+        scanAndWait(pEnvironment->scanner());
+
+        state.PauseTiming();
+        pEnvironment.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * numDirectories * numFilesPerDirectory);
+}
+BENCHMARK(BM_LibraryScannerImport)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
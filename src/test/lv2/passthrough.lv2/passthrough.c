@@ -0,0 +1,88 @@
+// A minimal stereo LV2 plugin that copies its input to its output with an
+// adjustable gain. At the default gain of 1 it passes the signal through
+// unchanged, so the tests and benchmarks measure the cost of hosting LV2
+// plugins and not the cost of any DSP.
+
+#include <stdlib.h>
+
+#include "lv2/lv2plug.in/ns/lv2core/lv2.h"
+
+#define PASSTHROUGH_URI "http://mixxx.org/test/lv2/passthrough"
+
+typedef enum {
+    PASSTHROUGH_IN_L = 0,
+    PASSTHROUGH_IN_R = 1,
+    PASSTHROUGH_OUT_L = 2,
+    PASSTHROUGH_OUT_R = 3,
+    PASSTHROUGH_GAIN = 4
+} PortIndex;
+
+typedef struct {
+    const float* in[2];
+    float* out[2];
+    const float* gain;
+} PassThrough;
+
+static LV2_Handle instantiate(const LV2_Descriptor* descriptor,
+        double rate,
+        const char* bundlePath,
+        const LV2_Feature* const* features) {
+    (void)descriptor;
+    (void)rate;
+    (void)bundlePath;
+    (void)features;
+    return (LV2_Handle)calloc(1, sizeof(PassThrough));
+}
+
+static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
+    PassThrough* self = (PassThrough*)instance;
+    switch ((PortIndex)port) {
+    case PASSTHROUGH_IN_L:
+        self->in[0] = (const float*)data;
+        break;
+    case PASSTHROUGH_IN_R:
+        self->in[1] = (const float*)data;
+        break;
+    case PASSTHROUGH_OUT_L:
+        self->out[0] = (float*)data;
+        break;
+    case PASSTHROUGH_OUT_R:
+        self->out[1] = (float*)data;
+        break;
+    case PASSTHROUGH_GAIN:
+        self->gain = (const float*)data;
+        break;
+    }
+}
+
+static void run(LV2_Handle instance, uint32_t numFrames) {
+    const PassThrough* self = (const PassThrough*)instance;
+    const float gain = *self->gain;
+    for (int channel = 0; channel < 2; ++channel) {
+        const float* in = self->in[channel];
+        float* out = self->out[channel];
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            out[i] = in[i] * gain;
+        }
+    }
+}
+
+static void cleanup(LV2_Handle instance) {
+    free(instance);
+}
+
+static const LV2_Descriptor descriptor = {
+    PASSTHROUGH_URI,
+    instantiate,
+    connect_port,
+    NULL,
+    run,
+    NULL,
+    cleanup,
+    NULL
+};
+
+LV2_SYMBOL_EXPORT
+const LV2_Descriptor* lv2_descriptor(uint32_t index) {
+    return index == 0 ? &descriptor : NULL;
+}
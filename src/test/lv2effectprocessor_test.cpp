@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+// The pass-through plugin bundle is built along with the tests when LV2
+// support is enabled.
+#if defined(__LILV__) && defined(MIXXX_TEST_LV2_PATH)
+
+#include <QTemporaryDir>
+
+#include <memory>
+#include <vector>
+
+#include "effects/builtin/filtereffect.h"
+#include "effects/effectinstantiator.h"
+#include "effects/lv2/lv2backend.h"
+#include "test/engineeffectsrig.h"
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QString kPassThroughId = "http://mixxx.org/test/lv2/passthrough";
+const int kGainParameter = 0;
+
+// Discovers the pass-through plugin that is built along with the tests.
+// lilv only looks for bundles on LV2_PATH, which is replaced for the
+// lifetime of the plugin.
+class LV2PassThroughPlugin {
+  public:
+    LV2PassThroughPlugin()
+            : m_hadLV2Path(qEnvironmentVariableIsSet("LV2_PATH")),
+              m_lv2Path(qgetenv("LV2_PATH")) {
+        qputenv("LV2_PATH", MIXXX_TEST_LV2_PATH);
+        m_pBackend = std::make_unique<LV2Backend>(nullptr);
+    }
+
+    ~LV2PassThroughPlugin() {
+        m_pBackend.reset();
+        if (m_hadLV2Path) {
+            qputenv("LV2_PATH", m_lv2Path);
+        } else {
+            qunsetenv("LV2_PATH");
+        }
+    }
+
+    bool isAvailable() const {
+        return m_pBackend->canInstantiateEffect(kPassThroughId);
+    }
+
+    EngineEffect* addTo(EngineEffectsRig* pRig) const {
+        LV2Manifest* pLV2Manifest = m_pBackend->getLV2Manifest(kPassThroughId);
+        return pRig->addEffect(pLV2Manifest->getEffectManifest(),
+                EffectInstantiatorPointer(new LV2EffectProcessorInstantiator(
+                        pLV2Manifest->getPlugin(),
+                        pLV2Manifest->getAudioPortIndices(),
+                        pLV2Manifest->getControlPortIndices())));
+    }
+
+  private:
+    const bool m_hadLV2Path;
+    const QByteArray m_lv2Path;
+    std::unique_ptr<LV2Backend> m_pBackend;
+};
+
+class LV2EffectProcessorTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pPlugin = std::make_unique<LV2PassThroughPlugin>();
+        ASSERT_TRUE(m_pPlugin->isAvailable())
+                << "The pass-through plugin was not found in " << MIXXX_TEST_LV2_PATH;
+    }
+
+    void TearDown() override {
+        // Restores LV2_PATH for the following tests
+        m_pPlugin.reset();
+    }
+
+    mixxx::SampleBuffer dryMix(const std::vector<mixxx::SampleBuffer>& deckBuffers,
+                               unsigned int numSamples) const {
+        mixxx::SampleBuffer mix(numSamples);
+        mix.clear();
+        for (const mixxx::SampleBuffer& deckBuffer : deckBuffers) {
+            SampleUtil::add(mix.data(), deckBuffer.data(), numSamples);
+        }
+        return mix;
+    }
+
+    std::unique_ptr<LV2PassThroughPlugin> m_pPlugin;
+};
+
+TEST_F(LV2EffectProcessorTest, PlanarChainPassesSignalThrough) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pRig = environment.createRig(0);
+    // The filter at identity splits the LV2 effects into two planar runs.
+    const std::vector<EngineEffect*> lv2Effects = {
+            m_pPlugin->addTo(pRig.get()),
+            m_pPlugin->addTo(pRig.get())};
+    pRig->addEffect<FilterEffect>();
+    EngineEffect* pLastLV2Effect = m_pPlugin->addTo(pRig.get());
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    const mixxx::SampleBuffer expected = dryMix(deckBuffers, numSamples);
+    mixxx::SampleBuffer output(numSamples);
+
+    const int numCallbacks = 4;
+    for (int callback = 0; callback < numCallbacks; ++callback) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+        for (unsigned int i = 0; i < numSamples; ++i) {
+            ASSERT_FLOAT_EQ(expected[i], output[i])
+                    << "callback " << callback << " sample " << i;
+        }
+    }
+    for (const EngineEffect* pEffect : lv2Effects) {
+        EXPECT_EQ(static_cast<quint64>(numCallbacks * kNumDecks),
+                pEffect->processedBufferCount());
+    }
+    EXPECT_EQ(static_cast<quint64>(numCallbacks * kNumDecks),
+            pLastLV2Effect->processedBufferCount());
+}
+
+TEST_F(LV2EffectProcessorTest, ParameterChangeIsRampedOverBlocks) {
+    EngineEffectsRigEnvironment environment(config());
+    auto pRig = environment.createRig(0);
+    EngineEffect* pEffect = m_pPlugin->addTo(pRig.get());
+
+    // 512 frames are processed in 8 blocks of 64 frames.
+    const unsigned int numSamples = 1024;
+    const unsigned int numBlocks = 8;
+    const unsigned int blockSamples = numSamples / numBlocks;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    const mixxx::SampleBuffer expected = dryMix(deckBuffers, numSamples);
+    mixxx::SampleBuffer output(numSamples);
+
+    for (int callback = 0; callback < 2; ++callback) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+
+    pRig->setParameter(pEffect, kGainParameter, 0.0);
+    pRig->process(deckBuffers, environment.outputHandle(),
+                  output.data(), numSamples);
+    for (unsigned int i = 0; i < numSamples; ++i) {
+        const unsigned int block = i / blockSamples;
+        const CSAMPLE gain = 1.0f - static_cast<CSAMPLE>(block + 1) / numBlocks;
+        ASSERT_NEAR(expected[i] * gain, output[i], 1e-6) << "sample " << i;
+    }
+
+    pRig->process(deckBuffers, environment.outputHandle(),
+                  output.data(), numSamples);
+    for (unsigned int i = 0; i < numSamples; ++i) {
+        ASSERT_EQ(0.0f, output[i]) << "sample " << i;
+    }
+}
+
+// Callback time of the post-fader effects of 4 decks with a chain of
+// pass-through plugins. The argument is the number of plugins in the chain.
+static void BM_LV2PassThroughChain(benchmark::State& state) {
+    QTemporaryDir configDir;
+    UserSettingsPointer pConfig(new UserSettings(
+            configDir.filePath("benchmark.cfg")));
+    LV2PassThroughPlugin plugin;
+    if (!plugin.isAvailable()) {
+        state.SkipWithError("The pass-through plugin was not found");
+        return;
+    }
+    EngineEffectsRigEnvironment environment(pConfig);
+    auto pRig = environment.createRig(0);
+    for (int i = 0; i < state.range(0); ++i) {
+        plugin.addTo(pRig.get());
+    }
+
+    const unsigned int numSamples = 1024;
+    const std::vector<mixxx::SampleBuffer> deckBuffers = makeDeckBuffers(numSamples);
+    mixxx::SampleBuffer output(numSamples);
+
+    while (state.KeepRunning()) {
+        pRig->process(deckBuffers, environment.outputHandle(),
+                      output.data(), numSamples);
+    }
+}
+BENCHMARK(BM_LV2PassThroughChain)->Arg(1)->Arg(2)->Arg(4);
+
+}  // namespace
+
+#endif // __LILV__ && MIXXX_TEST_LV2_PATH
@@ -0,0 +1,239 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QtDebug>
+
+#include "test/mixxxtest.h"
+#include "util/math.h"
+#include "widget/paintable.h"
+#include "widget/wpixmapstore.h"
+
+namespace {
+
+const QByteArray kSvg(
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"40\" height=\"100\">"
+        "<rect x=\"0\" y=\"0\" width=\"40\" height=\"50\" fill=\"#ff0000\"/>"
+        "<rect x=\"0\" y=\"50\" width=\"40\" height=\"50\" fill=\"#0000ff\"/>"
+        "<circle cx=\"20\" cy=\"20\" r=\"15\" fill=\"#00ff00\"/>"
+        "</svg>");
+
+PaintablePointer newSvgPaintable(const QByteArray& svg) {
+    PixmapSource source;
+    source.setSVG(svg);
+    return PaintablePointer(new Paintable(source, Paintable::STRETCH, 1.0));
+}
+
+QImage newFrame(const QSize& size) {
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+int maxColorDifference(const QImage& lhs, const QImage& rhs) {
+    int maxDifference = 0;
+    for (int y = 0; y < lhs.height(); ++y) {
+        for (int x = 0; x < lhs.width(); ++x) {
+            const QRgb l = lhs.pixel(x, y);
+            const QRgb r = rhs.pixel(x, y);
+            maxDifference = math_max(maxDifference, qAbs(qRed(l) - qRed(r)));
+            maxDifference = math_max(maxDifference, qAbs(qGreen(l) - qGreen(r)));
+            maxDifference = math_max(maxDifference, qAbs(qBlue(l) - qBlue(r)));
+            maxDifference = math_max(maxDifference, qAbs(qAlpha(l) - qAlpha(r)));
+        }
+    }
+    return maxDifference;
+}
+
+class PaintableTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        WPixmapStore::setSvgRasterCacheCapacity(
+                WPixmapStore::kDefaultSvgRasterCacheCapacityKB);
+    }
+
+    void TearDown() override {
+        WPixmapStore::setSvgRasterCacheCapacity(
+                WPixmapStore::kDefaultSvgRasterCacheCapacityKB);
+    }
+};
+
+TEST_F(PaintableTest, SvgIsRasterizedOncePerSize) {
+    PaintablePointer pPaintable = newSvgPaintable(kSvg);
+    ASSERT_EQ(QSize(40, 100), pPaintable->size());
+    const int sizeBefore = WPixmapStore::svgRasterCacheSizeKB();
+
+    QImage frame = newFrame(QSize(80, 200));
+    QPainter painter(&frame);
+    pPaintable->draw(QRectF(0, 0, 80, 200), &painter);
+    const int rasterSizeKB = WPixmapStore::svgRasterCacheSizeKB() - sizeBefore;
+    // 80 x 200 pixels with 32 bits
+    EXPECT_EQ(63, rasterSizeKB);
+
+    // Same size at a different position
+    pPaintable->draw(QRectF(10, 10, 80, 200), &painter);
+    EXPECT_EQ(sizeBefore + rasterSizeKB, WPixmapStore::svgRasterCacheSizeKB());
+
+    // Parts of the image with the same scale, like a VU meter does
+    pPaintable->draw(QRectF(0, 100, 80, 100), &painter, QRectF(0, 50, 40, 50));
+    pPaintable->draw(QRectF(0, 150, 80, 50), &painter, QRectF(0, 75, 40, 25));
+    EXPECT_EQ(sizeBefore + rasterSizeKB, WPixmapStore::svgRasterCacheSizeKB());
+
+    // A different size needs another raster
+    pPaintable->draw(QRectF(0, 0, 40, 100), &painter);
+    EXPECT_LT(sizeBefore + rasterSizeKB, WPixmapStore::svgRasterCacheSizeKB());
+    painter.end();
+
+    // The rasters are discarded with the Paintable
+    pPaintable.clear();
+    EXPECT_EQ(sizeBefore, WPixmapStore::svgRasterCacheSizeKB());
+}
+
+TEST_F(PaintableTest, RasterMatchesDirectRendering) {
+    PaintablePointer pPaintable = newSvgPaintable(kSvg);
+    const QRectF targetRect(3, 7, 60, 150);
+    const QRectF sourceRect(0, 25, 40, 75);
+
+    QImage cachedFrame = newFrame(QSize(100, 200));
+    QPainter cachedPainter(&cachedFrame);
+    pPaintable->draw(targetRect, &cachedPainter, sourceRect);
+    cachedPainter.end();
+
+    WPixmapStore::setSvgRasterCacheCapacity(0);
+    QImage directFrame = newFrame(QSize(100, 200));
+    QPainter directPainter(&directFrame);
+    pPaintable->draw(targetRect, &directPainter, sourceRect);
+    directPainter.end();
+
+    // Only the anti-aliased edges may differ slightly
+    EXPECT_GE(16, maxColorDifference(cachedFrame, directFrame));
+    EXPECT_EQ(directFrame.pixel(30, 10), cachedFrame.pixel(30, 10));
+    EXPECT_EQ(directFrame.pixel(30, 150), cachedFrame.pixel(30, 150));
+}
+
+TEST_F(PaintableTest, HighDpiRaster) {
+    PaintablePointer pPaintable = newSvgPaintable(kSvg);
+    const int sizeBefore = WPixmapStore::svgRasterCacheSizeKB();
+
+    QImage frame = newFrame(QSize(80, 200));
+    frame.setDevicePixelRatio(2.0);
+    QPainter painter(&frame);
+    pPaintable->draw(QRectF(0, 0, 40, 100), &painter);
+    painter.end();
+    // Rasterized with 80 x 200 device pixels
+    EXPECT_EQ(sizeBefore + 63, WPixmapStore::svgRasterCacheSizeKB());
+}
+
+class SkinPaintables {
+  public:
+    SkinPaintables() {
+        const QString skinPath = QStringLiteral("res/skins/Deere/");
+        m_pKnob = load(skinPath + "knob_small.svg", Paintable::STRETCH);
+        m_pKnobBack = load(skinPath + "knob_bg_grey.svg", Paintable::STRETCH);
+        m_pSlider = load(skinPath + "slider-vertical.svg", Paintable::STRETCH);
+        m_pHandle = load(skinPath + "handle-vertical-grey.svg", Paintable::STRETCH);
+        m_pVuMeter = load(skinPath + "vumeter_clip.svg", Paintable::STRETCH);
+    }
+
+    bool isValid() const {
+        return m_pKnob && m_pKnobBack && m_pSlider && m_pHandle && m_pVuMeter;
+    }
+
+    // Paints the widgets of two decks and a mixer that change with
+    // every frame: 32 knobs, 8 sliders and 4 VU meters
+    void paintFrame(QPainter* pPainter, int frame) {
+        for (int i = 0; i < 32; ++i) {
+            const QRectF knobRect(40 + 40 * (i % 16), 40 + 60 * (i / 16), 36, 36);
+            m_pKnobBack->draw(knobRect, pPainter, m_pKnobBack->rect());
+            pPainter->save();
+            pPainter->translate(knobRect.center());
+            pPainter->rotate(((frame + i) % 270) - 135.0);
+            m_pKnob->drawCentered(
+                    knobRect.translated(-knobRect.center()), pPainter, m_pKnob->rect());
+            pPainter->restore();
+        }
+        for (int i = 0; i < 8; ++i) {
+            const QRectF sliderRect(40 + 50 * i, 200, 24, 180);
+            m_pSlider->draw(sliderRect, pPainter, m_pSlider->rect());
+            const qreal position = ((frame + 10 * i) % 100) / 100.0;
+            const QRectF handleRect(sliderRect.x(),
+                    sliderRect.y() + position * (sliderRect.height() - 30),
+                    sliderRect.width(),
+                    30);
+            m_pHandle->draw(handleRect, pPainter, m_pHandle->rect());
+        }
+        for (int i = 0; i < 4; ++i) {
+            const QRectF vuRect(500 + 20 * i, 200, 12, 180);
+            const qreal level = ((frame * 7 + 13 * i) % 100) / 100.0;
+            const QRectF sourceRect = m_pVuMeter->rect();
+            const qreal sourceHeight = sourceRect.height() * level;
+            if (sourceHeight > 0) {
+                m_pVuMeter->draw(
+                        QRectF(vuRect.x(),
+                                vuRect.bottom() - vuRect.height() * level,
+                                vuRect.width(),
+                                vuRect.height() * level),
+                        pPainter,
+                        QRectF(0,
+                                sourceRect.height() - sourceHeight,
+                                sourceRect.width(),
+                                sourceHeight));
+            }
+        }
+    }
+
+  private:
+    static PaintablePointer load(const QString& path, Paintable::DrawMode mode) {
+        if (!QFileInfo(path).exists()) {
+            qWarning() << "Missing skin image" << path;
+            return PaintablePointer();
+        }
+        return PaintablePointer(new Paintable(PixmapSource(path), mode, 1.0));
+    }
+
+    PaintablePointer m_pKnob;
+    PaintablePointer m_pKnobBack;
+    PaintablePointer m_pSlider;
+    PaintablePointer m_pHandle;
+    PaintablePointer m_pVuMeter;
+};
+
+// Paints the SVG widgets of a skin like the GUI thread does at 60 Hz.
+// The first argument enables the raster cache, the second one is the
+// device pixel ratio. The frame rate counter needs to stay well above
+// 60 frames per second.
+static void BM_PaintSkinFrame(benchmark::State& state) {
+    WPixmapStore::setSvgRasterCacheCapacity(state.range(0) ?
+            WPixmapStore::kDefaultSvgRasterCacheCapacityKB : 0);
+    SkinPaintables paintables;
+    if (!paintables.isValid()) {
+        state.SkipWithError("Failed to load the skin images");
+        return;
+    }
+    const qreal devicePixelRatio = state.range(1);
+    QImage frame(QSize(800, 400) * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    frame.setDevicePixelRatio(devicePixelRatio);
+
+    int frameIndex = 0;
+    while (state.KeepRunning()) {
+        frame.fill(Qt::black);
+        QPainter painter(&frame);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        paintables.paintFrame(&painter, frameIndex++);
+    }
+    state.counters["fps"] = benchmark::Counter(
+            state.iterations(), benchmark::Counter::kIsRate);
+    WPixmapStore::setSvgRasterCacheCapacity(
+            WPixmapStore::kDefaultSvgRasterCacheCapacityKB);
+}
+BENCHMARK(BM_PaintSkinFrame)
+        ->Unit(benchmark::kMillisecond)
+        ->Args({0, 1})
+        ->Args({1, 1})
+        ->Args({0, 2})
+        ->Args({1, 2});
+
+} // namespace
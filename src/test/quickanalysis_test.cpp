@@ -0,0 +1,275 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QtMath>
+#include <vector>
+
+#include "analyzer/analysisframebus.h"
+#include "analyzer/analyzerbeats.h"
+#include "analyzer/analyzerebur128.h"
+#include "analyzer/analyzerkey.h"
+#include "analyzer/constants.h"
+#include "analyzer/plugins/analyzerqueenmarybeats.h"
+#include "analyzer/plugins/analyzerqueenmarykey.h"
+#include "analyzer/quickanalysis.h"
+#include "test/mixxxtest.h"
+#include "track/beatutils.h"
+#include "track/keyfactory.h"
+#include "track/keyutils.h"
+#include "util/math.h"
+#include "util/performancetimer.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kTrackLengthFrames = 10 * kSampleRate;
+
+class QuickAnalysisTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pTrack = Track::newTemporary();
+    }
+
+    // Keys as stored by AnalyzerKey
+    void setKeys(bool quickAnalysis, bool provisionalReplayGain) {
+        QHash<QString, QString> extraVersionInfo;
+        extraVersionInfo["vamp_plugin_id"] = "qm-keydetector";
+        if (quickAnalysis) {
+            mixxx::addQuickAnalysisVersionInfo(
+                    &extraVersionInfo, provisionalReplayGain);
+        }
+        KeyChangeList keyChanges;
+        keyChanges.push_back(qMakePair(mixxx::track::io::key::A_MINOR, 0.0));
+        m_pTrack->setKeys(KeyFactory::makePreferredKeys(
+                keyChanges, extraVersionInfo, kSampleRate, kTrackLengthFrames * 2));
+    }
+
+    bool initializeKeyAnalyzer(bool quickAnalysis) {
+        AnalyzerKey analyzer(KeyDetectionSettings(config()), quickAnalysis);
+        const bool result = analyzer.initialize(
+                m_pTrack, kSampleRate, kTrackLengthFrames * 2);
+        analyzer.cleanup();
+        return result;
+    }
+
+    bool initializeGainAnalyzer(bool quickAnalysis) {
+        ReplayGainSettings rgSettings(config());
+        rgSettings.setReplayGainAnalyzerEnabled(true);
+        rgSettings.setReplayGainAnalyzerVersion(2);
+        rgSettings.setReplayGainReanalyze(false);
+        AnalyzerEbur128 analyzer(config(), quickAnalysis);
+        const bool result = analyzer.initialize(
+                m_pTrack, kSampleRate, kTrackLengthFrames * 2);
+        analyzer.cleanup();
+        return result;
+    }
+
+    TrackPointer m_pTrack;
+};
+
+TEST_F(QuickAnalysisTest, FrameRanges) {
+    const SINT windowFrames = mixxx::kQuickAnalysisSecondsPerWindow * kSampleRate;
+    const SINT trackFrames = 4 * mixxx::kQuickAnalysisWindows * windowFrames;
+    const auto frameRanges = mixxx::quickAnalysisFrameRanges(
+            mixxx::IndexRange::forward(100, trackFrames), kSampleRate);
+    ASSERT_EQ(static_cast<std::size_t>(mixxx::kQuickAnalysisWindows), frameRanges.size());
+    SINT previousEnd = 100;
+    for (const auto& frameRange : frameRanges) {
+        EXPECT_EQ(windowFrames, frameRange.length());
+        EXPECT_LT(previousEnd, frameRange.start());
+        previousEnd = frameRange.end();
+    }
+    // Neither the intro nor the outro
+    EXPECT_LT(previousEnd, 100 + trackFrames);
+
+    // Short tracks are analyzed completely
+    const auto shortTrack = mixxx::IndexRange::forward(
+            0, (mixxx::kQuickAnalysisWindows + 1) * windowFrames);
+    const auto shortFrameRanges = mixxx::quickAnalysisFrameRanges(shortTrack, kSampleRate);
+    ASSERT_EQ(1u, shortFrameRanges.size());
+    EXPECT_EQ(shortTrack, shortFrameRanges.front());
+}
+
+TEST_F(QuickAnalysisTest, TrackFramePosition) {
+    const std::vector<mixxx::IndexRange> frameRanges = {
+            mixxx::IndexRange::forward(1000, 100),
+            mixxx::IndexRange::forward(5000, 100),
+    };
+    EXPECT_DOUBLE_EQ(1000, mixxx::quickAnalysisTrackFramePosition(frameRanges, 0));
+    EXPECT_DOUBLE_EQ(1099.5, mixxx::quickAnalysisTrackFramePosition(frameRanges, 99.5));
+    EXPECT_DOUBLE_EQ(5000, mixxx::quickAnalysisTrackFramePosition(frameRanges, 100));
+    EXPECT_DOUBLE_EQ(5110, mixxx::quickAnalysisTrackFramePosition(frameRanges, 210));
+}
+
+TEST_F(QuickAnalysisTest, SubVersion) {
+    QHash<QString, QString> extraVersionInfo;
+    extraVersionInfo["vamp_plugin_id"] = "qm-keydetector";
+    EXPECT_FALSE(mixxx::isQuickAnalysisSubVersion(
+            KeyFactory::getPreferredSubVersion(extraVersionInfo)));
+    mixxx::addQuickAnalysisVersionInfo(&extraVersionInfo, false);
+    EXPECT_TRUE(mixxx::isQuickAnalysisSubVersion(
+            KeyFactory::getPreferredSubVersion(extraVersionInfo)));
+}
+
+TEST_F(QuickAnalysisTest, ProvisionalKeysAreReplaced) {
+    setKeys(true, false);
+    EXPECT_TRUE(mixxx::isQuickAnalysisSubVersion(m_pTrack->getKeys().getSubVersion()));
+    // Regardless of the re-analysis preference
+    EXPECT_TRUE(initializeKeyAnalyzer(false));
+    EXPECT_FALSE(initializeKeyAnalyzer(true));
+}
+
+TEST_F(QuickAnalysisTest, KeysAreNotReplacedByProvisionalOnes) {
+    EXPECT_TRUE(initializeKeyAnalyzer(true));
+    setKeys(false, false);
+    EXPECT_FALSE(mixxx::isQuickAnalysisSubVersion(m_pTrack->getKeys().getSubVersion()));
+    EXPECT_FALSE(initializeKeyAnalyzer(true));
+}
+
+TEST_F(QuickAnalysisTest, ProvisionalReplayGain) {
+    EXPECT_TRUE(initializeGainAnalyzer(true));
+    m_pTrack->setReplayGain(mixxx::ReplayGain(0.5, CSAMPLE_PEAK));
+    EXPECT_FALSE(initializeGainAnalyzer(true));
+
+    // The ReplayGain existed before the quick analysis
+    setKeys(true, false);
+    EXPECT_FALSE(mixxx::hasQuickAnalysisReplayGain(m_pTrack));
+    EXPECT_FALSE(initializeGainAnalyzer(false));
+
+    // The ReplayGain has been added by the quick analysis
+    setKeys(true, true);
+    EXPECT_TRUE(mixxx::hasQuickAnalysisReplayGain(m_pTrack));
+    EXPECT_TRUE(initializeGainAnalyzer(false));
+    EXPECT_FALSE(initializeGainAnalyzer(true));
+}
+
+// A beatless intro with an A minor chord, then kicks at the given tempo
+std::vector<CSAMPLE> makeTestTrack(double bpm, SINT frames, SINT introFrames) {
+    std::vector<CSAMPLE> samples(frames * 2);
+    const double framesPerBeat = kSampleRate * 60.0 / bpm;
+    const SINT kickFrames = kSampleRate / 20;
+    for (SINT i = 0; i < frames; ++i) {
+        const double t = double(i) / kSampleRate;
+        double value = 0.1 * (qSin(2 * M_PI * 220.0 * t) +
+                                     qSin(2 * M_PI * 261.63 * t) +
+                                     qSin(2 * M_PI * 329.63 * t));
+        if (i >= introFrames) {
+            const double beatFrame = std::fmod(i - introFrames, framesPerBeat);
+            if (beatFrame < kickFrames) {
+                value += 0.6 * qSin(2 * M_PI * 60.0 * beatFrame / kSampleRate) *
+                        (1.0 - beatFrame / kickFrames);
+            }
+        }
+        samples[i * 2] = static_cast<CSAMPLE>(value);
+        samples[i * 2 + 1] = static_cast<CSAMPLE>(value);
+    }
+    return samples;
+}
+
+struct AnalysisResult {
+    double bpm;
+    mixxx::track::io::key::ChromaticKey key;
+};
+
+// Analyzes the whole track like AnalyzerBeats and AnalyzerKey with the
+// default plugins
+AnalysisResult analyzeTestTrack(const std::vector<CSAMPLE>& samples, SINT frames) {
+    mixxx::AnalyzerQueenMaryBeats beatsPlugin;
+    mixxx::AnalyzerQueenMaryKey keyPlugin;
+    beatsPlugin.initialize(kSampleRate);
+    keyPlugin.initialize(kSampleRate);
+    mixxx::AnalysisFrameBus frameBus(mixxx::kAnalysisFramesPerChunk);
+    for (SINT frame = 0; frame < frames; frame += mixxx::kAnalysisFramesPerChunk) {
+        frameBus.publish(&samples[frame * 2],
+                math_min(mixxx::kAnalysisFramesPerChunk, frames - frame));
+        beatsPlugin.processFrames(frameBus);
+        keyPlugin.processFrames(frameBus);
+    }
+    beatsPlugin.finalize();
+    keyPlugin.finalize();
+
+    AnalysisResult result;
+    result.bpm = BeatUtils::calculateBpm(beatsPlugin.getBeats(), kSampleRate, 60, 200);
+    result.key = KeyUtils::calculateGlobalKey(
+            keyPlugin.getKeyChanges(), frames * 2, kSampleRate);
+    return result;
+}
+
+class QuickAnalysisBenchmarkEnvironment : public QuickAnalysisTest {
+  public:
+    // The fixture is only used for the config
+    void TestBody() override {
+    }
+
+    // Decodes the windows like AnalyzerThread and analyzes them with
+    // AnalyzerBeats and AnalyzerKey in quick-analysis mode
+    AnalysisResult quickAnalyzeTestTrack(
+            const std::vector<CSAMPLE>& samples, SINT frames) {
+        BeatDetectionSettings bpmSettings(config());
+        bpmSettings.setBpmRangeStart(60);
+        bpmSettings.setBpmRangeEnd(200);
+        const TrackPointer pTrack = Track::newTemporary();
+        AnalyzerBeats beatsAnalyzer(config(), true, true);
+        AnalyzerKey keyAnalyzer(KeyDetectionSettings(config()), true);
+        beatsAnalyzer.initialize(pTrack, kSampleRate, frames * 2);
+        keyAnalyzer.initialize(pTrack, kSampleRate, frames * 2);
+        mixxx::AnalysisFrameBus frameBus(mixxx::kAnalysisFramesPerChunk);
+        for (const auto& frameRange : mixxx::quickAnalysisFrameRanges(
+                     mixxx::IndexRange::forward(0, frames), kSampleRate)) {
+            for (SINT frame = frameRange.start(); frame < frameRange.end();
+                    frame += mixxx::kAnalysisFramesPerChunk) {
+                frameBus.publish(&samples[frame * 2],
+                        math_min(mixxx::kAnalysisFramesPerChunk, frameRange.end() - frame));
+                beatsAnalyzer.processFrames(frameBus);
+                keyAnalyzer.processFrames(frameBus);
+            }
+        }
+        beatsAnalyzer.storeResults(pTrack);
+        keyAnalyzer.storeResults(pTrack);
+        beatsAnalyzer.cleanup();
+        keyAnalyzer.cleanup();
+
+        AnalysisResult result;
+        result.bpm = pTrack->getBpm();
+        result.key = pTrack->getKey();
+        return result;
+    }
+};
+
+// Compares a quick analysis of a few windows of a 3 minute track with a
+// regular analysis of the whole track as the reference.
+static void BM_QuickAnalysisAccuracy(benchmark::State& state) {
+    const double bpm = state.range(0);
+    const SINT kFrames = 180 * kSampleRate;
+    const std::vector<CSAMPLE> samples = makeTestTrack(bpm, kFrames, 12 * kSampleRate);
+    QuickAnalysisBenchmarkEnvironment environment;
+
+    AnalysisResult reference;
+    AnalysisResult quick;
+    double referenceMillis = 0;
+    double quickMillis = 0;
+    while (state.KeepRunning()) {
+        PerformanceTimer timer;
+        timer.start();
+        reference = analyzeTestTrack(samples, kFrames);
+        referenceMillis = timer.restart().toDoubleMillis();
+        quick = environment.quickAnalyzeTestTrack(samples, kFrames);
+        quickMillis = timer.elapsed().toDoubleMillis();
+    }
+
+    state.counters["full_ms"] = referenceMillis;
+    state.counters["quick_ms"] = quickMillis;
+    state.counters["speedup"] = referenceMillis / quickMillis;
+    state.counters["bpm_error"] = std::abs(quick.bpm - reference.bpm);
+    state.counters["key_match"] = quick.key == reference.key ? 1 : 0;
+}
+BENCHMARK(BM_QuickAnalysisAccuracy)
+        ->Unit(benchmark::kMillisecond)
+        ->Iterations(1)
+        ->Arg(90)
+        ->Arg(120)
+        ->Arg(128)
+        ->Arg(140)
+        ->Arg(174);
+
+} // namespace
@@ -0,0 +1,332 @@
+#include "test/realtimesafetychecker.h"
+
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "util/math.h"
+
+#if defined(__LINUX__) && defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && \
+        !defined(__SANITIZE_THREAD__)
+#define MIXXX_CHECK_REALTIME_SAFETY
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <stdlib.h>
+#endif
+
+namespace {
+
+const int kMaxFrames = 32;
+// The frames of reportViolation() and of the interceptor
+const int kSkippedFrames = 2;
+const int kMaxStacks = 256;
+
+// Violations that have not been fixed yet. A violation is known if any
+// symbol of its backtrace contains one of these. Remove an entry once it
+// has been fixed, so it won't come back.
+const char* const kKnownViolations[] = {
+        // Control changes notify the GUI with queued signals by design.
+        // This covers the slots that are connected directly as well.
+        "ControlDoublePrivate::valueChanged",
+        // The engine thread names itself in the first callback.
+        "QObject::setObjectName",
+        // The beats are guarded by a mutex that is shared with the GUI and
+        // the analyzers.
+        "BeatGrid::",
+        "BeatMap::",
+        // The cues are guarded by a mutex that is shared with the GUI.
+        "CueControl::",
+        // Logging on error paths
+        "QMessageLogger::",
+};
+
+// All violations with the same backtrace. Slots are claimed by writing the
+// hash of the backtrace and are never released while checking.
+struct StackSlot {
+    std::atomic<quint64> hash;
+    std::atomic<bool> ready;
+    std::atomic<quint64> count;
+    RealtimeSafetyChecker::Violation violation;
+    int numFrames;
+    void* frames[kMaxFrames];
+};
+
+// Zero initialized static storage, no allocations while checking
+std::array<StackSlot, kMaxStacks> s_stacks;
+std::array<std::atomic<quint64>, RealtimeSafetyChecker::kNumViolations> s_violationCounts;
+std::atomic<quint64> s_droppedStacks;
+
+thread_local int t_realtimeDepth = 0;
+// Capturing a backtrace may allocate itself
+thread_local bool t_bReporting = false;
+
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+quint64 hashStack(RealtimeSafetyChecker::Violation violation,
+        void* const* frames,
+        int numFrames) {
+    // FNV-1a
+    quint64 hash = Q_UINT64_C(14695981039346656037) ^ static_cast<quint64>(violation);
+    for (int i = 0; i < numFrames; ++i) {
+        hash = (hash ^ reinterpret_cast<quintptr>(frames[i])) * Q_UINT64_C(1099511628211);
+    }
+    // Zero marks free slots
+    return hash != 0 ? hash : 1;
+}
+
+QString demangledSymbol(const char* symbol) {
+    // Format: binary(mangled+offset) [address]
+    const QString line = QString::fromLocal8Bit(symbol);
+    const int begin = line.indexOf('(') + 1;
+    const int end = line.indexOf('+', begin);
+    if (begin <= 0 || end <= begin) {
+        return line;
+    }
+    const QByteArray mangled = line.mid(begin, end - begin).toLocal8Bit();
+    int status = -1;
+    char* demangled = abi::__cxa_demangle(mangled.constData(), nullptr, nullptr, &status);
+    if (status != 0 || !demangled) {
+        return line;
+    }
+    const QString result = QString::fromLocal8Bit(demangled);
+    free(demangled);
+    return result;
+}
+
+template<typename Function>
+Function originalFunction(const char* symbol) {
+    Function pFunction = reinterpret_cast<Function>(dlsym(RTLD_NEXT, symbol));
+    if (!pFunction) {
+        qFatal("Failed to find %s", symbol);
+    }
+    return pFunction;
+}
+#endif
+
+} // anonymous namespace
+
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+// Calls from Mixxx to these functions of QtCore are bound to the following
+// definitions by their mangled names, while QtCore calls its own functions
+// directly. The this pointer is passed like the first argument.
+void interceptQMutexLock(void* pMutex) __asm__("_ZN6QMutex4lockEv");
+void interceptQReadWriteLockLockForRead(void* pLock) __asm__(
+        "_ZN14QReadWriteLock11lockForReadEv");
+void interceptQReadWriteLockLockForWrite(void* pLock) __asm__(
+        "_ZN14QReadWriteLock12lockForWriteEv");
+// QMetaObject::activate(QObject*, const QMetaObject*, int, void**) is
+// called by every signal that is generated by moc.
+void interceptQMetaObjectActivate(void* pSender,
+        const void* pMetaObject,
+        int localSignalIndex,
+        void** argv) __asm__("_ZN11QMetaObject8activateEP7QObjectPKS_iPPv");
+
+void interceptQMutexLock(void* pMutex) {
+    static const auto original = originalFunction<void (*)(void*)>(
+            "_ZN6QMutex4lockEv");
+    if (RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::MutexLock);
+    }
+    original(pMutex);
+}
+
+void interceptQReadWriteLockLockForRead(void* pLock) {
+    static const auto original = originalFunction<void (*)(void*)>(
+            "_ZN14QReadWriteLock11lockForReadEv");
+    if (RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::MutexLock);
+    }
+    original(pLock);
+}
+
+void interceptQReadWriteLockLockForWrite(void* pLock) {
+    static const auto original = originalFunction<void (*)(void*)>(
+            "_ZN14QReadWriteLock12lockForWriteEv");
+    if (RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::MutexLock);
+    }
+    original(pLock);
+}
+
+void interceptQMetaObjectActivate(void* pSender,
+        const void* pMetaObject,
+        int localSignalIndex,
+        void** argv) {
+    static const auto original =
+            originalFunction<void (*)(void*, const void*, int, void**)>(
+                    "_ZN11QMetaObject8activateEP7QObjectPKS_iPPv");
+    if (RealtimeSafetyChecker::isRealtimeThread()) {
+        RealtimeSafetyChecker::reportViolation(
+                RealtimeSafetyChecker::Violation::SignalEmission);
+    }
+    original(pSender, pMetaObject, localSignalIndex, argv);
+}
+#endif
+
+RealtimeSafetyChecker::ScopedRealtimeThread::ScopedRealtimeThread()
+        : m_bEnabled(isEnabled()) {
+    if (!m_bEnabled) {
+        return;
+    }
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+    // The first backtrace loads libgcc, which allocates
+    static const bool s_bBacktraceLoaded = [] {
+        void* frame;
+        return backtrace(&frame, 1) > 0;
+    }();
+    Q_UNUSED(s_bBacktraceLoaded);
+#endif
+    ++t_realtimeDepth;
+}
+
+RealtimeSafetyChecker::ScopedRealtimeThread::~ScopedRealtimeThread() {
+    if (m_bEnabled) {
+        --t_realtimeDepth;
+    }
+}
+
+// static
+bool RealtimeSafetyChecker::isSupported() {
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+    return true;
+#else
+    return false;
+#endif
+}
+
+// static
+bool RealtimeSafetyChecker::isEnabled() {
+    static const bool s_bEnabled = isSupported() &&
+            qEnvironmentVariableIntValue("MIXXX_CHECK_REALTIME_SAFETY") == 1;
+    return s_bEnabled;
+}
+
+// static
+bool RealtimeSafetyChecker::isRealtimeThread() {
+    return t_realtimeDepth > 0;
+}
+
+// static
+void RealtimeSafetyChecker::reportViolation(Violation violation) {
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+    if (t_bReporting) {
+        return;
+    }
+    t_bReporting = true;
+    s_violationCounts[static_cast<int>(violation)].fetch_add(1, std::memory_order_relaxed);
+
+    void* frames[kSkippedFrames + kMaxFrames];
+    const int numFrames = math_max(
+            backtrace(frames, kSkippedFrames + kMaxFrames) - kSkippedFrames, 0);
+    void* const* stackFrames = frames + kSkippedFrames;
+    const quint64 hash = hashStack(violation, stackFrames, numFrames);
+    bool recorded = false;
+    for (int probe = 0; probe < kMaxStacks && !recorded; ++probe) {
+        StackSlot& slot = s_stacks[(hash + probe) % kMaxStacks];
+        quint64 slotHash = slot.hash.load(std::memory_order_acquire);
+        if (slotHash == 0 && slot.hash.compare_exchange_strong(slotHash, hash)) {
+            slot.violation = violation;
+            slot.numFrames = numFrames;
+            std::copy(stackFrames, stackFrames + numFrames, slot.frames);
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            slot.ready.store(true, std::memory_order_release);
+            recorded = true;
+        } else if (slotHash == hash) {
+            // Different backtraces with the same hash are counted together
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            recorded = true;
+        }
+    }
+    if (!recorded) {
+        s_droppedStacks.fetch_add(1, std::memory_order_relaxed);
+    }
+    t_bReporting = false;
+#else
+    Q_UNUSED(violation);
+#endif
+}
+
+// static
+quint64 RealtimeSafetyChecker::violationCount(Violation violation) {
+    return s_violationCounts[static_cast<int>(violation)].load(std::memory_order_relaxed);
+}
+
+// static
+QString RealtimeSafetyChecker::violationName(Violation violation) {
+    switch (violation) {
+    case Violation::Allocation:
+        return QStringLiteral("Allocation");
+    case Violation::Deallocation:
+        return QStringLiteral("Deallocation");
+    case Violation::MutexLock:
+        return QStringLiteral("Mutex lock");
+    case Violation::SignalEmission:
+        return QStringLiteral("Signal emission");
+    }
+    DEBUG_ASSERT(!"Unknown violation");
+    return QString();
+}
+
+// static
+QList<RealtimeSafetyChecker::ViolationStack> RealtimeSafetyChecker::takeViolations() {
+    QList<ViolationStack> violations;
+#ifdef MIXXX_CHECK_REALTIME_SAFETY
+    for (auto& slot : s_stacks) {
+        if (!slot.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        ViolationStack stack;
+        stack.violation = slot.violation;
+        stack.count = slot.count.load(std::memory_order_relaxed);
+        stack.known = false;
+        char** symbols = backtrace_symbols(slot.frames, slot.numFrames);
+        for (int i = 0; symbols && i < slot.numFrames; ++i) {
+            const QString symbol = demangledSymbol(symbols[i]);
+            for (const char* knownViolation : kKnownViolations) {
+                if (symbol.contains(QLatin1String(knownViolation))) {
+                    stack.known = true;
+                }
+            }
+            stack.frames.append(symbol);
+        }
+        free(symbols);
+        violations.append(stack);
+
+        slot.ready.store(false, std::memory_order_relaxed);
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.hash.store(0, std::memory_order_release);
+    }
+#endif
+    for (auto& count : s_violationCounts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    const quint64 droppedStacks = s_droppedStacks.exchange(0);
+    if (droppedStacks > 0) {
+        qWarning() << "Real-time violations without a backtrace:" << droppedStacks;
+    }
+    return violations;
+}
+
+// static
+void RealtimeSafetyChecker::expectNoNewViolations() {
+    for (const auto& stack : takeViolations()) {
+        const QString message = QStringLiteral("%1 on a real-time thread (%2 times):\n    %3")
+                                        .arg(violationName(stack.violation),
+                                                QString::number(stack.count),
+                                                stack.frames.join("\n    "));
+        if (stack.known) {
+            qDebug() << "Known real-time violation:"
+                     << violationName(stack.violation)
+                     << stack.count;
+        } else {
+            ADD_FAILURE() << message.toStdString();
+        }
+    }
+}
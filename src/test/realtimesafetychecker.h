@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+// Detects operations on the audio thread that may block for an unbounded
+// time: heap allocations and deallocations, locking a QMutex or
+// QReadWriteLock and emitting Qt signals.
+//
+// Threads are marked as real-time with ScopedRealtimeThread. The test binary
+// intercepts the corresponding library functions and records a backtrace of
+// each violation on a marked thread without allocating. Intercepting is only
+// supported when linking with glibc without a sanitizer.
+//
+// Checking is opt-in, because the backtraces are expensive. It is enabled by
+// setting the environment variable MIXXX_CHECK_REALTIME_SAFETY=1.
+class RealtimeSafetyChecker {
+  public:
+    enum class Violation {
+        Allocation,
+        Deallocation,
+        MutexLock,
+        SignalEmission,
+    };
+    static constexpr int kNumViolations = static_cast<int>(Violation::SignalEmission) + 1;
+
+    // All violations with the same backtrace
+    struct ViolationStack {
+        Violation violation;
+        quint64 count;
+        // Demangled symbols, innermost first
+        QStringList frames;
+        // Matches one of the known violations that have not been fixed yet
+        bool known;
+    };
+
+    // Marks the current thread as real-time while in scope if checking is
+    // enabled. Scopes may be nested.
+    class ScopedRealtimeThread {
+      public:
+        ScopedRealtimeThread();
+        ~ScopedRealtimeThread();
+
+      private:
+        const bool m_bEnabled;
+    };
+
+    static bool isSupported();
+    static bool isEnabled();
+    static bool isRealtimeThread();
+
+    // Called by the interceptors
+    static void reportViolation(Violation violation);
+
+    static quint64 violationCount(Violation violation);
+    static QString violationName(Violation violation);
+
+    // Returns the violations since the last call and resets all counters.
+    // Must not be called while a marked thread is running.
+    static QList<ViolationStack> takeViolations();
+
+    // Adds a failure to the current test for each violation that is not
+    // known, and logs the known ones.
+    static void expectNoNewViolations();
+};
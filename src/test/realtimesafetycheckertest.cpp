@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <memory>
+
+#include "test/realtimesafetychecker.h"
+
+namespace {
+
+class RealtimeSafetyCheckerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        // Discard the violations of previous tests
+        RealtimeSafetyChecker::takeViolations();
+    }
+
+    static int countViolations(
+            const QList<RealtimeSafetyChecker::ViolationStack>& violations,
+            RealtimeSafetyChecker::Violation violation) {
+        int count = 0;
+        for (const auto& stack : violations) {
+            if (stack.violation == violation) {
+                EXPECT_FALSE(stack.known);
+                EXPECT_FALSE(stack.frames.isEmpty());
+                ++count;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(RealtimeSafetyCheckerTest, DetectsViolationsOnRealtimeThread) {
+    if (!RealtimeSafetyChecker::isEnabled()) {
+        return;
+    }
+    QMutex mutex;
+    std::unique_ptr<volatile int> pValue;
+    {
+        RealtimeSafetyChecker::ScopedRealtimeThread realtimeThread;
+        EXPECT_TRUE(RealtimeSafetyChecker::isRealtimeThread());
+        pValue = std::make_unique<volatile int>(1);
+        QMutexLocker locker(&mutex);
+    }
+    EXPECT_FALSE(RealtimeSafetyChecker::isRealtimeThread());
+    EXPECT_LT(0u, RealtimeSafetyChecker::violationCount(
+            RealtimeSafetyChecker::Violation::Allocation));
+    EXPECT_EQ(1u, RealtimeSafetyChecker::violationCount(
+            RealtimeSafetyChecker::Violation::MutexLock));
+
+    const auto violations = RealtimeSafetyChecker::takeViolations();
+    EXPECT_LT(0, countViolations(violations,
+            RealtimeSafetyChecker::Violation::Allocation));
+    EXPECT_EQ(1, countViolations(violations,
+            RealtimeSafetyChecker::Violation::MutexLock));
+    EXPECT_EQ(0u, RealtimeSafetyChecker::violationCount(
+            RealtimeSafetyChecker::Violation::Allocation));
+}
+
+TEST_F(RealtimeSafetyCheckerTest, IgnoresOtherThreads) {
+    QMutex mutex;
+    auto pValue = std::make_unique<volatile int>(1);
+    QMutexLocker locker(&mutex);
+    EXPECT_FALSE(RealtimeSafetyChecker::isRealtimeThread());
+    EXPECT_TRUE(RealtimeSafetyChecker::takeViolations().isEmpty());
+}
+
+} // namespace
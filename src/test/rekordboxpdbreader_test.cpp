@@ -0,0 +1,308 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QVector>
+#include <QtEndian>
+#include <fstream>
+
+#include "library/rekordbox/rekordbox_pdb.h"
+#include "library/rekordbox/rekordboxpdbreader.h"
+#include "util/assert.h"
+
+namespace {
+
+const int kPageSize = 4096;
+const int kPageHeaderSize = 40;
+const int kRowGroupSize = 36;
+const int kRowsPerGroup = 16;
+const int kTrackRowHeaderSize = 136;
+
+void writeU2(QByteArray* pData, int pos, quint16 value) {
+    qToLittleEndian(value, pData->data() + pos);
+}
+
+void writeU4(QByteArray* pData, int pos, quint32 value) {
+    qToLittleEndian(value, pData->data() + pos);
+}
+
+QByteArray shortAsciiString(const QByteArray& text) {
+    DEBUG_ASSERT(text.size() <= 126);
+    return char(2 * text.size() + 3) + text;
+}
+
+QString shortAsciiText(rekordbox_pdb_t::device_sql_string_t* pString) {
+    auto* pShortAscii = dynamic_cast<rekordbox_pdb_t::device_sql_short_ascii_t*>(pString->body());
+    if (!pShortAscii) {
+        return QString();
+    }
+    return QString::fromStdString(pShortAscii->text());
+}
+
+QByteArray artistRow(quint32 id, const QByteArray& name) {
+    QByteArray row(10, '\0');
+    writeU2(&row, 0, 0x60);
+    writeU4(&row, 4, id);
+    row[8] = 0x03;
+    // The name follows immediately
+    row[9] = 10;
+    return row + shortAsciiString(name);
+}
+
+QByteArray trackRow(quint32 id, quint32 artistId, const QByteArray& title, const QByteArray& filePath) {
+    QByteArray row(kTrackRowHeaderSize, '\0');
+    writeU4(&row, 68, artistId);
+    writeU4(&row, 72, id);
+    // All other strings are empty
+    const QByteArray emptyString = shortAsciiString(QByteArray());
+    const int titleOffset = kTrackRowHeaderSize + emptyString.size();
+    const int filePathOffset = titleOffset + shortAsciiString(title).size();
+    for (int i = 0; i < 21; ++i) {
+        writeU2(&row, 94 + 2 * i, kTrackRowHeaderSize);
+    }
+    writeU2(&row, 94 + 2 * 17, titleOffset);
+    writeU2(&row, 94 + 2 * 20, filePathOffset);
+    return row + emptyString + shortAsciiString(title) + shortAsciiString(filePath);
+}
+
+// Writes an export.pdb file with tables that are stored in linked data
+// pages like Rekordbox does
+class PdbWriter {
+  public:
+    void addTable(rekordbox_pdb_t::page_type_t type, const QVector<QByteArray>& rows) {
+        Table table;
+        table.type = type;
+        table.firstPage = m_pages.size() + 1;
+        QVector<QByteArray> pageRows;
+        int heapSize = 0;
+        for (const auto& row : rows) {
+            // Rows are aligned to 4 bytes
+            const int rowSize = (row.size() + 3) & ~3;
+            const int numGroups = pageRows.size() / kRowsPerGroup + 1;
+            if (kPageHeaderSize + heapSize + rowSize + numGroups * kRowGroupSize > kPageSize) {
+                addPage(type, pageRows);
+                pageRows.clear();
+                heapSize = 0;
+            }
+            pageRows.append(row);
+            heapSize += rowSize;
+        }
+        addPage(type, pageRows);
+        table.lastPage = m_pages.size();
+        m_tables.append(table);
+    }
+
+    bool write(const QString& filePath) const {
+        // The first page contains the file header
+        QByteArray header(kPageSize, '\0');
+        writeU4(&header, 4, kPageSize);
+        writeU4(&header, 8, m_tables.size());
+        writeU4(&header, 12, m_pages.size() + 1);
+        writeU4(&header, 20, 1);
+        int pos = 28;
+        for (const auto& table : m_tables) {
+            writeU4(&header, pos, table.type);
+            writeU4(&header, pos + 4, m_pages.size() + 1);
+            writeU4(&header, pos + 8, table.firstPage);
+            writeU4(&header, pos + 12, table.lastPage);
+            pos += 16;
+        }
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return false;
+        }
+        file.write(header);
+        for (const auto& page : m_pages) {
+            file.write(page);
+        }
+        return true;
+    }
+
+  private:
+    struct Table {
+        rekordbox_pdb_t::page_type_t type;
+        int firstPage;
+        int lastPage;
+    };
+
+    void addPage(rekordbox_pdb_t::page_type_t type, const QVector<QByteArray>& rows) {
+        const int pageIndex = m_pages.size() + 1;
+        QByteArray page(kPageSize, '\0');
+        writeU4(&page, 4, pageIndex);
+        writeU4(&page, 8, type);
+        // The last page of a table links to an unused page
+        writeU4(&page, 12, pageIndex + 1);
+        page[24] = static_cast<char>(rows.size());
+        // A data page
+        page[27] = 0x34;
+        writeU2(&page, 34, rows.size());
+        int heapSize = 0;
+        for (int i = 0; i < rows.size(); ++i) {
+            const int base = kPageSize - (i / kRowsPerGroup) * kRowGroupSize;
+            const int rowIndex = i % kRowsPerGroup;
+            writeU2(&page, base - (6 + 2 * rowIndex), heapSize);
+            const quint16 presentFlags = qFromLittleEndian<quint16>(page.constData() + base - 4);
+            writeU2(&page, base - 4, presentFlags | (1 << rowIndex));
+            page.replace(kPageHeaderSize + heapSize, rows[i].size(), rows[i]);
+            heapSize += (rows[i].size() + 3) & ~3;
+        }
+        m_pages.append(page);
+    }
+
+    QVector<Table> m_tables;
+    QVector<QByteArray> m_pages;
+};
+
+class RekordboxPdbReaderTest : public testing::Test {
+  protected:
+    QString pdbPath() const {
+        return m_tempDir.filePath("export.pdb");
+    }
+
+    // A collection of tracks from a few artists that spans many pages
+    bool writePdb(int trackCount) const {
+        const int artistCount = 50;
+        QVector<QByteArray> artistRows;
+        for (int i = 1; i <= artistCount; ++i) {
+            artistRows.append(artistRow(i, "Artist " + QByteArray::number(i)));
+        }
+        QVector<QByteArray> trackRows;
+        trackRows.reserve(trackCount);
+        for (int i = 1; i <= trackCount; ++i) {
+            trackRows.append(trackRow(i,
+                    (i % artistCount) + 1,
+                    "Title " + QByteArray::number(i),
+                    "/Contents/Artist/Album/Track " + QByteArray::number(i) + ".mp3"));
+        }
+        PdbWriter writer;
+        writer.addTable(rekordbox_pdb_t::PAGE_TYPE_ARTISTS, artistRows);
+        writer.addTable(rekordbox_pdb_t::PAGE_TYPE_TRACKS, trackRows);
+        return writer.write(pdbPath());
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(RekordboxPdbReaderTest, VisitsAllRows) {
+    const int trackCount = 2000;
+    ASSERT_TRUE(writePdb(trackCount));
+
+    RekordboxPdbReader reader(pdbPath());
+    ASSERT_TRUE(reader.isOpen());
+
+    QStringList artistNames;
+    const int artistRowCount = reader.visitRows(
+            rekordbox_pdb_t::PAGE_TYPE_ARTISTS, [&](kaitai::kstruct* row) {
+                auto* pArtist = static_cast<rekordbox_pdb_t::artist_row_t*>(row);
+                EXPECT_EQ(static_cast<uint32_t>(artistNames.size() + 1), pArtist->id());
+                artistNames.append(shortAsciiText(pArtist->name()));
+            });
+    EXPECT_EQ(50, artistRowCount);
+    ASSERT_EQ(50, artistNames.size());
+    EXPECT_EQ(QStringLiteral("Artist 1"), artistNames.first());
+    EXPECT_EQ(QStringLiteral("Artist 50"), artistNames.last());
+
+    uint32_t lastTrackId = 0;
+    const int trackRowCount = reader.visitRows(
+            rekordbox_pdb_t::PAGE_TYPE_TRACKS, [&](kaitai::kstruct* row) {
+                auto* pTrack = static_cast<rekordbox_pdb_t::track_row_t*>(row);
+                ASSERT_EQ(lastTrackId + 1, pTrack->id());
+                lastTrackId = pTrack->id();
+                EXPECT_EQ((lastTrackId % 50) + 1, pTrack->artist_id());
+                EXPECT_EQ(QStringLiteral("Title %1").arg(lastTrackId),
+                        shortAsciiText(pTrack->title()));
+                EXPECT_EQ(QStringLiteral("/Contents/Artist/Album/Track %1.mp3").arg(lastTrackId),
+                        shortAsciiText(pTrack->file_path()));
+                EXPECT_TRUE(shortAsciiText(pTrack->comment()).isEmpty());
+            });
+    EXPECT_EQ(trackCount, trackRowCount);
+    EXPECT_EQ(static_cast<uint32_t>(trackCount), lastTrackId);
+
+    // Tables that do not exist
+    const int albumRowCount = reader.visitRows(
+            rekordbox_pdb_t::PAGE_TYPE_ALBUMS, [](kaitai::kstruct*) {
+                ADD_FAILURE();
+            });
+    EXPECT_EQ(0, albumRowCount);
+}
+
+TEST_F(RekordboxPdbReaderTest, IgnoresMissingFiles) {
+    RekordboxPdbReader reader(pdbPath());
+    EXPECT_FALSE(reader.isOpen());
+    const int trackRowCount = reader.visitRows(
+            rekordbox_pdb_t::PAGE_TYPE_TRACKS, [](kaitai::kstruct*) {
+                ADD_FAILURE();
+            });
+    EXPECT_EQ(0, trackRowCount);
+}
+
+class RekordboxPdbReaderBenchmarkEnvironment : public RekordboxPdbReaderTest {
+  public:
+    // The fixture is only used for writing the file
+    void TestBody() override {
+    }
+
+    using RekordboxPdbReaderTest::pdbPath;
+    using RekordboxPdbReaderTest::writePdb;
+};
+
+// Reads the titles and file paths of 20000 tracks from a synthetic
+// export.pdb. The argument selects the reader, 0 for the tree of the
+// generated parser that keeps all pages and 1 for reading page by page.
+static void BM_ReadPdbTracks(benchmark::State& state) {
+    const int trackCount = 20000;
+    RekordboxPdbReaderBenchmarkEnvironment environment;
+    if (!environment.writePdb(trackCount)) {
+        state.SkipWithError("Failed to write the file");
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        int rowCount = 0;
+        const auto readTrack = [&rowCount](kaitai::kstruct* row) {
+            auto* pTrack = static_cast<rekordbox_pdb_t::track_row_t*>(row);
+            benchmark::DoNotOptimize(shortAsciiText(pTrack->title()));
+            benchmark::DoNotOptimize(shortAsciiText(pTrack->file_path()));
+            ++rowCount;
+        };
+        if (state.range(0) == 0) {
+            std::ifstream ifs(environment.pdbPath().toStdString(), std::ifstream::binary);
+            kaitai::kstream ks(&ifs);
+            rekordbox_pdb_t pdb(&ks);
+            for (auto* pTable : *pdb.tables()) {
+                if (pTable->type() != rekordbox_pdb_t::PAGE_TYPE_TRACKS) {
+                    continue;
+                }
+                const uint32_t lastIndex = pTable->last_page()->index();
+                rekordbox_pdb_t::page_ref_t* pPageRef = pTable->first_page();
+                while (true) {
+                    rekordbox_pdb_t::page_t* pPage = pPageRef->body();
+                    for (auto* pRowGroup : *pPage->row_groups()) {
+                        for (auto* pRowRef : *pRowGroup->rows()) {
+                            if (pRowRef->present()) {
+                                readTrack(pRowRef->body());
+                            }
+                        }
+                    }
+                    if (pPageRef->index() == lastIndex) {
+                        break;
+                    }
+                    pPageRef = pPage->next_page();
+                }
+            }
+        } else {
+            RekordboxPdbReader reader(environment.pdbPath());
+            reader.visitRows(rekordbox_pdb_t::PAGE_TYPE_TRACKS, readTrack);
+        }
+        if (rowCount != trackCount) {
+            state.SkipWithError("Failed to read all tracks");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * trackCount);
+    state.SetBytesProcessed(state.iterations() * QFile(environment.pdbPath()).size());
+}
+BENCHMARK(BM_ReadPdbTracks)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+
+} // namespace
@@ -388,6 +388,20 @@ TEST_F(SampleUtilTest, deinterleaveBuffer) {
     }
 }
 
+TEST_F(SampleUtilTest, maxAbsAmplitude) {
+    for (int i = 0; i < buffers.size(); ++i) {
+        CSAMPLE* buffer = buffers[i];
+        int size = sizes[i];
+        FillBuffer(buffer, 0.1f, size);
+        EXPECT_FLOAT_EQ(0.1f, SampleUtil::maxAbsAmplitude(buffer, size));
+        // The last sample must not be missed by the vectorized loop.
+        buffer[size - 1] = -0.5f;
+        EXPECT_FLOAT_EQ(0.5f, SampleUtil::maxAbsAmplitude(buffer, size));
+        ClearBuffer(buffer, size);
+        EXPECT_FLOAT_EQ(0.0f, SampleUtil::maxAbsAmplitude(buffer, size));
+    }
+}
+
 TEST_F(SampleUtilTest, reverse) {
     if (buffers.size() > 0 && sizes[0] > 10) {
         CSAMPLE* buffer = buffers[1];
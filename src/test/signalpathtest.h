@@ -21,6 +21,7 @@
 #include "mixer/previewdeck.h"
 #include "mixer/sampler.h"
 #include "test/mixxxtest.h"
+#include "test/realtimesafetychecker.h"
 #include "util/defs.h"
 #include "util/memory.h"
 #include "util/sample.h"
@@ -98,6 +99,8 @@ class BaseSignalPathTest : public MixxxTest {
     }
 
     ~BaseSignalPathTest() override {
+        RealtimeSafetyChecker::expectNoNewViolations();
+
         delete m_pMixerDeck1;
         delete m_pMixerDeck2;
         delete m_pMixerDeck3;
@@ -197,6 +200,7 @@ class BaseSignalPathTest : public MixxxTest {
     }
 
     void ProcessBuffer() {
+        RealtimeSafetyChecker::ScopedRealtimeThread realtimeThread;
         m_pEngineMaster->process(kProcessBufferSize);
     }
 
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QtMath>
+
+#include "engine/readaheadmanager.h"
+#include "util/types.h"
+
+// Feeds a stereo sine tone to a scaler like a ReadAheadManager reading a
+// track. The tone goes backwards when reading in reverse. The right
+// channel is inverted, so swapped or mixed channels are noticed.
+class SineReadAheadManager : public ReadAheadManager {
+  public:
+    SineReadAheadManager()
+            : m_frame(0) {
+    }
+
+    SINT getNextSamples(double dRate, CSAMPLE* buffer, SINT requested_samples) override {
+        const SINT frames = requested_samples / 2;
+        for (SINT i = 0; i < frames; ++i) {
+            const CSAMPLE value = static_cast<CSAMPLE>(qSin(m_frame * 0.05));
+            buffer[2 * i] = value;
+            buffer[2 * i + 1] = -value;
+            m_frame += dRate < 0 ? -1 : 1;
+        }
+        return frames * 2;
+    }
+
+  private:
+    qint64 m_frame;
+};
@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+
+#include "skin/imgloader.h"
+#include "skin/skindocumentcache.h"
+#include "skin/skinimagepreloader.h"
+#include "test/mixxxtest.h"
+#include "util/memory.h"
+
+namespace {
+
+const QByteArray kSkinXml(
+        "<skin>\n"
+        "  <Template src=\"skin:deck.xml\"/>\n"
+        "  <WidgetGroup>\n"
+        "    <BackPath>background.png</BackPath>\n"
+        "  </WidgetGroup>\n"
+        "</skin>\n");
+
+const QByteArray kDeckXml(
+        "<Template>\n"
+        "  <Knob>\n"
+        "    <Path>skin:knob.svg</Path>\n"
+        "    <Path>knob_<Variable name=\"color\"/>.svg</Path>\n"
+        "    <Path>missing.png</Path>\n"
+        "  </Knob>\n"
+        "</Template>\n");
+
+const QByteArray kSvg(
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"40\" height=\"100\">"
+        "<rect x=\"0\" y=\"0\" width=\"40\" height=\"100\" fill=\"#ff0000\"/>"
+        "</svg>");
+
+bool writeFile(const QString& filePath, const QByteArray& contents) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(contents) == contents.size();
+}
+
+class SkinDocumentCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(writeFile(skinFilePath("skin.xml"), kSkinXml));
+        ASSERT_TRUE(writeFile(skinFilePath("deck.xml"), kDeckXml));
+        ASSERT_TRUE(writeFile(skinFilePath("knob.svg"), kSvg));
+        QImage background(8, 8, QImage::Format_ARGB32);
+        background.fill(Qt::red);
+        ASSERT_TRUE(background.save(skinFilePath("background.png")));
+    }
+
+    QString skinPath() const {
+        return m_skinDir.path();
+    }
+
+    QString skinFilePath(const QString& fileName) const {
+        return m_skinDir.filePath(fileName);
+    }
+
+    QString cacheDirPath() const {
+        return m_cacheDir.path();
+    }
+
+    QStringList expectedImagePaths() const {
+        return QStringList{
+                QFileInfo(skinFilePath("background.png")).canonicalFilePath(),
+                QFileInfo(skinFilePath("knob.svg")).canonicalFilePath()};
+    }
+
+    QTemporaryDir m_skinDir;
+    QTemporaryDir m_cacheDir;
+};
+
+TEST_F(SkinDocumentCacheTest, LoadColdThenCached) {
+    SkinDocumentCache coldCache(cacheDirPath());
+    ASSERT_TRUE(coldCache.load(skinPath(), 1.0));
+    EXPECT_FALSE(coldCache.isLoadedFromCacheFile());
+    EXPECT_EQ(QStringLiteral("skin"), coldCache.skinDocument().tagName());
+    EXPECT_EQ(QStringLiteral("Template"),
+            coldCache.templateDocument(skinFilePath("deck.xml")).tagName());
+    EXPECT_TRUE(coldCache.templateDocument(skinFilePath("missing.xml")).isNull());
+    // Neither missing files nor paths with variables
+    EXPECT_EQ(expectedImagePaths(), coldCache.imagePaths());
+    EXPECT_TRUE(QFileInfo(coldCache.cacheFilePath(skinPath())).isFile());
+
+    SkinDocumentCache cachedCache(cacheDirPath());
+    ASSERT_TRUE(cachedCache.load(skinPath(), 1.0));
+    EXPECT_TRUE(cachedCache.isLoadedFromCacheFile());
+    EXPECT_EQ(coldCache.skinDocument().ownerDocument().toString(),
+            cachedCache.skinDocument().ownerDocument().toString());
+    EXPECT_EQ(coldCache.templateDocument(skinFilePath("deck.xml")).ownerDocument().toString(),
+            cachedCache.templateDocument(skinFilePath("deck.xml")).ownerDocument().toString());
+    EXPECT_EQ(expectedImagePaths(), cachedCache.imagePaths());
+    // Line numbers of skin warnings refer to the original files
+    EXPECT_EQ(3, cachedCache.skinDocument().firstChildElement("WidgetGroup").lineNumber());
+}
+
+TEST_F(SkinDocumentCacheTest, ModifiedSkinInvalidatesCache) {
+    ASSERT_TRUE(SkinDocumentCache(cacheDirPath()).load(skinPath(), 1.0));
+
+    QByteArray modifiedDeckXml = kDeckXml;
+    modifiedDeckXml.replace("</Template>", "  <Label/>\n</Template>");
+    ASSERT_TRUE(writeFile(skinFilePath("deck.xml"), modifiedDeckXml));
+    SkinDocumentCache modifiedCache(cacheDirPath());
+    ASSERT_TRUE(modifiedCache.load(skinPath(), 1.0));
+    EXPECT_FALSE(modifiedCache.isLoadedFromCacheFile());
+    EXPECT_FALSE(modifiedCache.templateDocument(skinFilePath("deck.xml"))
+                         .firstChildElement("Label")
+                         .isNull());
+
+    // The cache file has been replaced
+    SkinDocumentCache cachedCache(cacheDirPath());
+    ASSERT_TRUE(cachedCache.load(skinPath(), 1.0));
+    EXPECT_TRUE(cachedCache.isLoadedFromCacheFile());
+
+    // A different scale factor
+    SkinDocumentCache scaledCache(cacheDirPath());
+    ASSERT_TRUE(scaledCache.load(skinPath(), 2.0));
+    EXPECT_FALSE(scaledCache.isLoadedFromCacheFile());
+}
+
+TEST_F(SkinDocumentCacheTest, InvalidSkin) {
+    ASSERT_TRUE(writeFile(skinFilePath("skin.xml"), "<skin><WidgetGroup></skin>"));
+    EXPECT_FALSE(SkinDocumentCache(cacheDirPath()).load(skinPath(), 1.0));
+
+    ASSERT_TRUE(QFile::remove(skinFilePath("skin.xml")));
+    EXPECT_FALSE(SkinDocumentCache(cacheDirPath()).load(skinPath(), 1.0));
+}
+
+TEST_F(SkinDocumentCacheTest, PreloadedImagesAreNotLoadedAgain) {
+    const QStringList imagePaths = expectedImagePaths();
+    const ImgLoader loader;
+    {
+        SkinImagePreloader imagePreloader;
+        imagePreloader.start(imagePaths, 1.0);
+        imagePreloader.waitForFinished();
+        EXPECT_EQ(2, SkinImagePreloader::imageCount());
+
+        QImage svgImage;
+        ASSERT_TRUE(SkinImagePreloader::findImage(
+                QDir(skinPath()).filePath("./knob.svg"), 1.0, &svgImage));
+        EXPECT_EQ(QSize(40, 100), svgImage.size());
+        EXPECT_EQ(qRgb(255, 0, 0), svgImage.pixel(20, 50));
+        EXPECT_FALSE(SkinImagePreloader::findImage(imagePaths[1], 2.0, &svgImage));
+
+        // The decoded image is used even though the file is gone
+        ASSERT_TRUE(QFile::remove(imagePaths[0]));
+        const auto pImage = std::unique_ptr<QImage>(loader.getImage(imagePaths[0], 1.0));
+        EXPECT_EQ(QSize(8, 8), pImage->size());
+    }
+    EXPECT_EQ(0, SkinImagePreloader::imageCount());
+    const auto pImage = std::unique_ptr<QImage>(loader.getImage(imagePaths[0], 1.0));
+    EXPECT_TRUE(pImage->isNull());
+}
+
+const QString kBenchmarkSkinPath = QStringLiteral("res/skins/Deere");
+
+// Loads the documents of a skin with a cold or a valid cache file.
+static void BM_LoadSkinDocuments(benchmark::State& state) {
+    const bool cached = state.range(0) != 0;
+    QTemporaryDir cacheDir;
+    SkinDocumentCache cache(cacheDir.path());
+    if (!cache.load(kBenchmarkSkinPath, 1.0)) {
+        state.SkipWithError("Failed to load the skin");
+        return;
+    }
+    const QString cacheFilePath = cache.cacheFilePath(kBenchmarkSkinPath);
+    while (state.KeepRunning()) {
+        if (!cached) {
+            state.PauseTiming();
+            QFile::remove(cacheFilePath);
+            state.ResumeTiming();
+        }
+        SkinDocumentCache documents(cacheDir.path());
+        if (!documents.load(kBenchmarkSkinPath, 1.0) ||
+                documents.isLoadedFromCacheFile() != cached) {
+            state.SkipWithError("Failed to load the skin");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_LoadSkinDocuments)->Unit(benchmark::kMillisecond)->Arg(0)->Arg(1);
+
+// Decodes all images of a skin with the given number of threads. A single
+// thread corresponds to loading the images on the GUI thread.
+static void BM_PreloadSkinImages(benchmark::State& state) {
+    SkinDocumentCache cache(QString());
+    if (!cache.load(kBenchmarkSkinPath, 1.0)) {
+        state.SkipWithError("Failed to load the skin");
+        return;
+    }
+    QThreadPool* pThreadPool = QThreadPool::globalInstance();
+    const int maxThreadCount = pThreadPool->maxThreadCount();
+    pThreadPool->setMaxThreadCount(
+            state.range(0) > 0 ? state.range(0) : QThread::idealThreadCount());
+    int imageCount = 0;
+    while (state.KeepRunning()) {
+        SkinImagePreloader imagePreloader;
+        imagePreloader.start(cache.imagePaths(), 1.0);
+        imagePreloader.waitForFinished();
+        imageCount = SkinImagePreloader::imageCount();
+    }
+    pThreadPool->setMaxThreadCount(maxThreadCount);
+    state.SetItemsProcessed(state.iterations() * imageCount);
+}
+BENCHMARK(BM_PreloadSkinImages)->Unit(benchmark::kMillisecond)->Arg(1)->Arg(0);
+
+} // namespace
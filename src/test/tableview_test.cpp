@@ -1,10 +1,22 @@
-// Tests for tableview-related things
-// Right now it's just testing the serialize-unserialize of the header state code.
+// Tests for tableview-related things: the serialize-unserialize of the
+// header state code and loading the rows of the table models.
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <QEventLoop>
+#include <QSqlQuery>
+#include <QTemporaryDir>
 #include <QtDebug>
+
+#include "library/basetrackcache.h"
+#include "library/dao/trackschema.h"
+#include "library/librarytablemodel.h"
+#include "library/queryutil.h"
 #include "proto/headers.pb.h"
+#include "test/librarytest.h"
+#include "util/db/sqltransaction.h"
+#include "util/performancetimer.h"
 #include "widget/wtracktableviewheader.h"
 
 class HeaderViewStateTest : public testing::Test {
@@ -69,3 +81,300 @@ TEST_F(HeaderViewStateTest, BadHeaderState) {
     HeaderViewState view_state("BLAHBLAHBLAHBAD");
     ASSERT_FALSE(view_state.healthy());
 }
+
+namespace {
+
+// A subset of the columns of the track source of MixxxLibraryFeature
+const QStringList kTrackSourceColumns = {
+        "library." + LIBRARYTABLE_ID,
+        "library." + LIBRARYTABLE_ARTIST,
+        "library." + LIBRARYTABLE_TITLE,
+        "library." + LIBRARYTABLE_ALBUM,
+        "library." + LIBRARYTABLE_ALBUMARTIST,
+        "library." + LIBRARYTABLE_GENRE,
+        "library." + LIBRARYTABLE_GROUPING,
+        "library." + LIBRARYTABLE_COMMENT,
+        "track_locations." + TRACKLOCATIONSTABLE_LOCATION,
+};
+
+void deleteTrack(Track* pTrack) {
+    // Delete track objects directly in unit tests with
+    // no main event loop
+    delete pTrack;
+}
+
+void connectTrackSource(TrackCollection* pTrackCollection) {
+    const QString tableName = "library_cache_view";
+    QSqlQuery query(pTrackCollection->database());
+    query.prepare(QString(
+            "CREATE TEMPORARY VIEW IF NOT EXISTS %1 AS "
+            "SELECT %2 FROM library "
+            "INNER JOIN track_locations ON library.location = track_locations.id")
+                    .arg(tableName, kTrackSourceColumns.join(",")));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+    QStringList columns;
+    for (const auto& column : kTrackSourceColumns) {
+        columns.append(column.mid(column.indexOf('.') + 1));
+    }
+    pTrackCollection->connectTrackSource(QSharedPointer<BaseTrackCache>(
+            new BaseTrackCache(pTrackCollection,
+                    tableName,
+                    LIBRARYTABLE_ID,
+                    columns,
+                    true)));
+}
+
+// The artists of the tracks are in reverse order of insertion
+QString artistOfTrack(int numTracks, int track) {
+    return QString("Artist %1").arg(numTracks - track, 6, 10, QChar('0'));
+}
+
+void addTracks(const QSqlDatabase& database, int numTracks) {
+    SqlTransaction transaction(database);
+    QSqlQuery locationQuery(database);
+    locationQuery.prepare(
+            "INSERT INTO track_locations "
+            "(location, filename, directory, filesize, fs_deleted, needs_verification) "
+            "VALUES (:location, :filename, '/music', 0, 0, 0)");
+    QSqlQuery libraryQuery(database);
+    libraryQuery.prepare(
+            "INSERT INTO library (artist, title, location, mixxx_deleted) "
+            "VALUES (:artist, :title, :location, 0)");
+    for (int track = 0; track < numTracks; ++track) {
+        const QString fileName = QString("%1.mp3").arg(track);
+        locationQuery.bindValue(":location", "/music/" + fileName);
+        locationQuery.bindValue(":filename", fileName);
+        if (!locationQuery.exec()) {
+            LOG_FAILED_QUERY(locationQuery);
+            return;
+        }
+        libraryQuery.bindValue(":artist", artistOfTrack(numTracks, track));
+        libraryQuery.bindValue(":title", QString("Title %1").arg(track));
+        libraryQuery.bindValue(":location", locationQuery.lastInsertId());
+        if (!libraryQuery.exec()) {
+            LOG_FAILED_QUERY(libraryQuery);
+            return;
+        }
+    }
+    transaction.commit();
+}
+
+// Modifies the library without changing the rows of the table models
+void hideAndUnhideTrack(TrackCollection* pTrackCollection) {
+    const QList<TrackId> trackIds{TrackId(QVariant(1))};
+    pTrackCollection->hideTracks(trackIds);
+    pTrackCollection->unhideTracks(trackIds);
+}
+
+void waitForSelect(BaseSqlTableModel* pModel) {
+    QEventLoop eventLoop;
+    QObject::connect(pModel,
+            &BaseSqlTableModel::selectFinished,
+            &eventLoop,
+            &QEventLoop::quit);
+    if (pModel->isSelecting()) {
+        eventLoop.exec();
+    }
+}
+
+QList<TrackId> trackIdsOfRows(const BaseSqlTableModel& model) {
+    QList<TrackId> trackIds;
+    for (int row = 0; row < model.rowCount(); ++row) {
+        trackIds.append(model.getTrackId(model.index(row, 0)));
+    }
+    return trackIds;
+}
+
+const int kNumTracks = 1000;
+
+class LibraryTableModelTest : public LibraryTest {
+  protected:
+    LibraryTableModelTest() {
+        addTracks(dbConnection(), kNumTracks);
+        connectTrackSource(internalCollection());
+    }
+
+    std::unique_ptr<LibraryTableModel> newModel(bool selectAsync) {
+        auto pModel = std::make_unique<LibraryTableModel>(
+                nullptr, trackCollections(), "mixxx.db.model.library");
+        pModel->setSelectAsync(selectAsync);
+        pModel->setSort(pModel->fieldIndex(LIBRARYTABLE_ARTIST),
+                Qt::AscendingOrder);
+        return pModel;
+    }
+};
+
+TEST_F(LibraryTableModelTest, AsyncSelectMatchesSyncSelect) {
+    auto pSyncModel = newModel(false);
+    pSyncModel->select();
+    ASSERT_EQ(kNumTracks, pSyncModel->rowCount());
+
+    auto pAsyncModel = newModel(true);
+    pAsyncModel->select();
+    EXPECT_TRUE(pAsyncModel->isSelecting());
+    waitForSelect(pAsyncModel.get());
+
+    ASSERT_EQ(kNumTracks, pAsyncModel->rowCount());
+    EXPECT_EQ(trackIdsOfRows(*pSyncModel), trackIdsOfRows(*pAsyncModel));
+    const int artistColumn = pAsyncModel->fieldIndex(LIBRARYTABLE_ARTIST);
+    EXPECT_EQ(artistOfTrack(kNumTracks, kNumTracks - 1),
+            pAsyncModel->index(0, artistColumn).data().toString());
+}
+
+TEST_F(LibraryTableModelTest, SearchSupersedesRunningSelect) {
+    auto pSyncModel = newModel(false);
+    pSyncModel->search("Title 7");
+
+    auto pAsyncModel = newModel(true);
+    pAsyncModel->search("Title 1");
+    pAsyncModel->search("Title 7");
+    waitForSelect(pAsyncModel.get());
+
+    EXPECT_LT(0, pAsyncModel->rowCount());
+    EXPECT_GT(kNumTracks, pAsyncModel->rowCount());
+    EXPECT_EQ(trackIdsOfRows(*pSyncModel), trackIdsOfRows(*pAsyncModel));
+}
+
+TEST_F(LibraryTableModelTest, AsyncSelectEvaluatesDirtyTracks) {
+    const TrackId firstTrackId(QVariant(1));
+    TrackPointer pTrack = internalCollection()->getTrackById(firstTrackId);
+    ASSERT_TRUE(pTrack);
+    // Sorts last by the modified artist, but not by the one in the database
+    pTrack->setArtist("Zzz");
+
+    auto pSyncModel = newModel(false);
+    pSyncModel->select();
+    auto pAsyncModel = newModel(true);
+    pAsyncModel->select();
+    waitForSelect(pAsyncModel.get());
+
+    ASSERT_EQ(kNumTracks, pAsyncModel->rowCount());
+    EXPECT_EQ(firstTrackId,
+            pAsyncModel->getTrackId(pAsyncModel->index(kNumTracks - 1, 0)));
+    EXPECT_EQ(trackIdsOfRows(*pSyncModel), trackIdsOfRows(*pAsyncModel));
+}
+
+TEST_F(LibraryTableModelTest, SkipsSelectIfNothingChanged) {
+    auto pModel = newModel(false);
+    pModel->setSkipUnchangedSelects(true);
+    int numSelects = 0;
+    QObject::connect(pModel.get(),
+            &BaseSqlTableModel::selectFinished,
+            [&numSelects]() { ++numSelects; });
+
+    pModel->select();
+    EXPECT_EQ(1, numSelects);
+    pModel->select();
+    EXPECT_EQ(1, numSelects);
+
+    // Modifications without signals are not detected
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec("UPDATE library SET played=1 WHERE id=1"));
+    pModel->select();
+    EXPECT_EQ(1, numSelects);
+
+    hideAndUnhideTrack(internalCollection());
+    pModel->select();
+    EXPECT_EQ(2, numSelects);
+    EXPECT_EQ(kNumTracks, pModel->rowCount());
+
+    pModel->search("Title 7");
+    EXPECT_EQ(3, numSelects);
+    pModel->search("Title 7");
+    EXPECT_EQ(3, numSelects);
+}
+
+TEST_F(LibraryTableModelTest, ReselectsWithoutChangeTracking) {
+    // Like the models of external libraries, whose tables are
+    // re-imported without any signals
+    auto pModel = newModel(false);
+    pModel->select();
+    ASSERT_EQ(kNumTracks, pModel->rowCount());
+
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec("UPDATE library SET mixxx_deleted=1 WHERE id=1"));
+    pModel->select();
+    EXPECT_EQ(kNumTracks - 1, pModel->rowCount());
+}
+
+class TableModelBenchmarkEnvironment {
+  public:
+    explicit TableModelBenchmarkEnvironment(UserSettingsPointer pConfig)
+            : m_mixxxDb(pConfig, true),
+              m_dbConnectionPooler(m_mixxxDb.connectionPool()) {
+        MixxxDb::initDatabaseSchema(dbConnection());
+        m_pTrackCollectionManager = std::make_unique<TrackCollectionManager>(
+                nullptr, pConfig, m_mixxxDb.connectionPool(), deleteTrack);
+    }
+
+    QSqlDatabase dbConnection() const {
+        return mixxx::DbConnectionPooled(m_mixxxDb.connectionPool());
+    }
+
+    TrackCollectionManager* trackCollections() const {
+        return m_pTrackCollectionManager.get();
+    }
+
+  private:
+    const MixxxDb m_mixxxDb;
+    const mixxx::DbConnectionPooler m_dbConnectionPooler;
+    std::unique_ptr<TrackCollectionManager> m_pTrackCollectionManager;
+};
+
+// Loads a library of 50k tracks sorted by artist into the table model. The
+// argument selects on a background connection (1) or blocks the GUI thread
+// until all rows are loaded (0). Reports the time until the first rows
+// are available for display and until all rows have been inserted.
+static void BM_LibraryTableModelSelect(benchmark::State& state) {
+    const int numTracks = 50000;
+    QTemporaryDir configDir;
+    UserSettingsPointer pConfig(new UserSettings(
+            configDir.filePath("benchmark.cfg")));
+    TableModelBenchmarkEnvironment environment(pConfig);
+    addTracks(environment.dbConnection(), numTracks);
+    connectTrackSource(environment.trackCollections()->internalCollection());
+
+    LibraryTableModel model(nullptr,
+            environment.trackCollections(),
+            "mixxx.db.model.library");
+    model.setSelectAsync(state.range(0) != 0);
+    model.setSort(model.fieldIndex(LIBRARYTABLE_ARTIST), Qt::AscendingOrder);
+    // Builds the index of the track source
+    model.select();
+    waitForSelect(&model);
+
+    PerformanceTimer timer;
+    double firstRowsMillis = 0;
+    double completeMillis = 0;
+    bool firstRowsInserted = false;
+    QObject::connect(&model,
+            &QAbstractItemModel::rowsInserted,
+            [&timer, &firstRowsMillis, &firstRowsInserted]() {
+                if (!firstRowsInserted) {
+                    firstRowsMillis += timer.elapsed().toDoubleMillis();
+                    firstRowsInserted = true;
+                }
+            });
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        hideAndUnhideTrack(environment.trackCollections()->internalCollection());
+        firstRowsInserted = false;
+        state.ResumeTiming();
+        timer.start();
+        model.select();
+        waitForSelect(&model);
+        completeMillis += timer.elapsed().toDoubleMillis();
+    }
+    if (model.rowCount() != numTracks) {
+        state.SkipWithError("Not all rows have been loaded");
+    }
+    state.counters["first_rows_ms"] = benchmark::Counter(
+            firstRowsMillis, benchmark::Counter::kAvgIterations);
+    state.counters["complete_ms"] = benchmark::Counter(
+            completeMillis, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LibraryTableModelSelect)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+
+#include "mixer/deck.h"
+#include "mixer/playermanager.h"
+
+// Provides the decks of an engine test by their group, e.g. for loading
+// tracks with EngineRenderer.
+class TestPlayerManager : public PlayerManagerInterface {
+  public:
+    void addDeck(Deck* pDeck) {
+        m_decks.insert(pDeck->getGroup(), pDeck);
+    }
+
+    BaseTrackPlayer* getPlayer(QString group) const override {
+        return m_decks.value(group);
+    }
+    Deck* getDeck(unsigned int player) const override {
+        return m_decks.value(PlayerManager::groupForDeck(player - 1));
+    }
+    unsigned int numberOfDecks() const override {
+        return m_decks.size();
+    }
+    PreviewDeck* getPreviewDeck(unsigned int libPreviewPlayer) const override {
+        Q_UNUSED(libPreviewPlayer);
+        return nullptr;
+    }
+    unsigned int numberOfPreviewDecks() const override {
+        return 0;
+    }
+    Sampler* getSampler(unsigned int sampler) const override {
+        Q_UNUSED(sampler);
+        return nullptr;
+    }
+    unsigned int numberOfSamplers() const override {
+        return 0;
+    }
+
+  private:
+    QMap<QString, Deck*> m_decks;
+};
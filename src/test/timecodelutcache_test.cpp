@@ -0,0 +1,188 @@
+#ifdef __VINYLCONTROL__
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <cstring>
+
+#include "test/mixxxtest.h"
+#include "vinylcontrol/timecodelutcache.h"
+
+#ifdef _MSC_VER
+#include "timecoder.h"
+#else
+extern "C" {
+#include "timecoder.h"
+}
+#endif
+
+namespace {
+
+// The shortest timecode keeps the tests fast
+const char* const kTestTimecode = "mixvibes_7inch";
+
+// All timecodes that are supported by VinylControlXwax
+const char* const kSupportedTimecodes[] = {
+        "serato_2a",
+        "serato_2b",
+        "serato_cd",
+        "traktor_a",
+        "traktor_b",
+        "mixvibes_v2",
+};
+
+// A copy of a definition without a lookup table, which leaves the static
+// definitions of xwax untouched
+timecode_def copyDefinition(const char* name) {
+    timecode_def def = *timecoder_match_definition(name);
+    def.lookup = false;
+    return def;
+}
+
+void freeDefinition(timecode_def* pDef) {
+    if (pDef->lookup) {
+        lut_clear(&pDef->lut);
+        pDef->lookup = false;
+    }
+}
+
+class TimecodeLutCacheTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_def = copyDefinition(kTestTimecode);
+        ASSERT_EQ(0, timecoder_build_lookup(&m_def, nullptr, nullptr));
+        m_filePath = m_cacheDir.filePath(QStringLiteral("test.lut"));
+    }
+
+    void TearDown() override {
+        freeDefinition(&m_def);
+    }
+
+    void expectSameLookup(const timecode_def& def) const {
+        ASSERT_TRUE(def.lookup);
+        EXPECT_EQ(0, memcmp(m_def.lut.slot, def.lut.slot, sizeof(struct slot) * m_def.length));
+        EXPECT_EQ(0, memcmp(m_def.lut.table, def.lut.table, sizeof(slot_no_t) * LUT_HASHES));
+        EXPECT_EQ(0u, lut_lookup(const_cast<struct lut*>(&def.lut), def.seed));
+    }
+
+    QTemporaryDir m_cacheDir;
+    QString m_filePath;
+    timecode_def m_def;
+};
+
+TEST_F(TimecodeLutCacheTest, WriteAndMap) {
+    ASSERT_TRUE(TimecodeLutCache::writeLookupTable(m_filePath, m_def));
+
+    timecode_def def = copyDefinition(kTestTimecode);
+    const auto pFile = TimecodeLutCache::mapLookupTable(m_filePath, &def);
+    ASSERT_NE(nullptr, pFile);
+    expectSameLookup(def);
+    // Does not free the mapped memory
+    freeDefinition(&def);
+}
+
+TEST_F(TimecodeLutCacheTest, RejectCorruptFile) {
+    ASSERT_TRUE(TimecodeLutCache::writeLookupTable(m_filePath, m_def));
+    {
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.seek(file.size() / 2));
+        char byte;
+        ASSERT_TRUE(file.getChar(&byte));
+        ASSERT_TRUE(file.seek(file.size() / 2));
+        ASSERT_TRUE(file.putChar(static_cast<char>(byte ^ 0x01)));
+    }
+    timecode_def def = copyDefinition(kTestTimecode);
+    EXPECT_EQ(nullptr, TimecodeLutCache::mapLookupTable(m_filePath, &def));
+    EXPECT_FALSE(def.lookup);
+}
+
+TEST_F(TimecodeLutCacheTest, RejectOtherDefinition) {
+    ASSERT_TRUE(TimecodeLutCache::writeLookupTable(m_filePath, m_def));
+    timecode_def def = copyDefinition("serato_2a");
+    EXPECT_EQ(nullptr, TimecodeLutCache::mapLookupTable(m_filePath, &def));
+    EXPECT_FALSE(def.lookup);
+
+    EXPECT_EQ(nullptr,
+            TimecodeLutCache::mapLookupTable(
+                    m_cacheDir.filePath(QStringLiteral("missing.lut")), &def));
+}
+
+TEST_F(TimecodeLutCacheTest, BuildInBackgroundThenMap) {
+    TimecodeLutCache* pCache = TimecodeLutCache::createInstance();
+    pCache->setCacheDirPath(m_cacheDir.path());
+    QSignalSpy readySpy(pCache, &TimecodeLutCache::lookupTableReady);
+
+    timecode_def def = copyDefinition(kTestTimecode);
+    EXPECT_FALSE(pCache->attachLookupTable(&def));
+    // Does not start a second build
+    EXPECT_FALSE(pCache->attachLookupTable(&def));
+    ASSERT_TRUE(readySpy.count() > 0 || readySpy.wait(60000));
+    EXPECT_EQ(QString::fromLatin1(kTestTimecode), readySpy.first().first().toString());
+    EXPECT_TRUE(pCache->attachLookupTable(&def));
+    expectSameLookup(def);
+    pCache->freeLookupTables();
+    EXPECT_FALSE(def.lookup);
+
+    // Mapped in the background from the file that has been written
+    readySpy.clear();
+    EXPECT_FALSE(pCache->attachLookupTable(&def));
+    ASSERT_TRUE(readySpy.count() > 0 || readySpy.wait(10000));
+    EXPECT_TRUE(pCache->attachLookupTable(&def));
+    expectSameLookup(def);
+    TimecodeLutCache::destroy();
+    EXPECT_FALSE(def.lookup);
+}
+
+// Initializes the lookup table of a timecode either by building it like
+// every start did before or by mapping the cached file.
+static void BM_InitTimecodeLookupTable(benchmark::State& state) {
+    const char* const name = kSupportedTimecodes[state.range(0)];
+    const bool cached = state.range(1) != 0;
+    state.SetLabel(name);
+
+    QTemporaryDir cacheDir;
+    const QString filePath = cacheDir.filePath(QStringLiteral("benchmark.lut"));
+    if (cached) {
+        timecode_def def = copyDefinition(name);
+        if (timecoder_build_lookup(&def, nullptr, nullptr) != 0 ||
+                !TimecodeLutCache::writeLookupTable(filePath, def)) {
+            state.SkipWithError("Failed to write the lookup table");
+            freeDefinition(&def);
+            return;
+        }
+        freeDefinition(&def);
+    }
+
+    while (state.KeepRunning()) {
+        timecode_def def = copyDefinition(name);
+        if (cached) {
+            const auto pFile = TimecodeLutCache::mapLookupTable(filePath, &def);
+            if (!pFile) {
+                state.SkipWithError("Failed to map the lookup table");
+                return;
+            }
+        } else {
+            if (timecoder_build_lookup(&def, nullptr, nullptr) != 0) {
+                state.SkipWithError("Failed to build the lookup table");
+                return;
+            }
+            freeDefinition(&def);
+        }
+    }
+}
+BENCHMARK(BM_InitTimecodeLookupTable)
+        ->Unit(benchmark::kMillisecond)
+        ->Apply([](benchmark::internal::Benchmark* b) {
+            for (int timecode = 0; timecode < 6; ++timecode) {
+                b->Args({timecode, 0});
+                b->Args({timecode, 1});
+            }
+        });
+
+} // namespace
+
+#endif // __VINYLCONTROL__
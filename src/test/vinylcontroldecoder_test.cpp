@@ -0,0 +1,233 @@
+#ifdef __VINYLCONTROL__
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QThread>
+#include <QtMath>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "test/mixxxtest.h"
+#include "util/math.h"
+#include "util/memory.h"
+#include "vinylcontrol/defs_vinylcontrol.h"
+#include "vinylcontrol/timecodelutcache.h"
+#include "vinylcontrol/vinylcontrol.h"
+#include "vinylcontrol/vinylcontroldecoder.h"
+#include "vinylcontrol/vinylcontrolxwax.h"
+
+#ifdef _MSC_VER
+#include "timecoder.h"
+#else
+extern "C" {
+#include "timecoder.h"
+}
+#endif
+
+namespace {
+
+const unsigned int kChannels = 2;
+
+class CountingVinylControl : public VinylControl {
+  public:
+    CountingVinylControl(UserSettingsPointer pConfig, QString group)
+            : VinylControl(pConfig, group),
+              m_analyzedFrames(0) {
+    }
+
+    void analyzeSamples(CSAMPLE* pSamples, size_t nFrames) override {
+        Q_UNUSED(pSamples);
+        m_analyzedFrames.fetch_add(nFrames);
+    }
+
+    bool writeQualityReport(VinylSignalQualityReport* pReport) override {
+        pReport->timecode_quality = 1.0f;
+        pReport->angle = 0.0f;
+        return true;
+    }
+
+    size_t analyzedFrames() const {
+        return m_analyzedFrames.load();
+    }
+
+  protected:
+    float getAngle() override {
+        return 0.0f;
+    }
+
+  private:
+    std::atomic<size_t> m_analyzedFrames;
+};
+
+bool waitForDecodedFrames(const VinylControlDecoder& decoder, quint64 frames) {
+    for (int i = 0; i < 1000; ++i) {
+        if (decoder.decodedFrames() >= frames) {
+            return true;
+        }
+        QThread::msleep(5);
+    }
+    return false;
+}
+
+class VinylControlDecoderTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pDecoder = std::make_unique<VinylControlDecoder>(1);
+        m_pDecoder->start();
+    }
+
+    std::unique_ptr<VinylControlDecoder> m_pDecoder;
+};
+
+TEST_F(VinylControlDecoderTest, DecodeReceivedSamples) {
+    auto pVinylControl = std::make_unique<CountingVinylControl>(
+            config(), kVCGroup.arg(2));
+    EXPECT_EQ(nullptr, m_pDecoder->replaceVinylControl(pVinylControl.get()));
+    m_pDecoder->setSignalQualityReporting(true);
+
+    const std::vector<CSAMPLE> buffer(256 * kChannels, 0.5f);
+    for (int i = 0; i < 10; ++i) {
+        m_pDecoder->receiveSamples(buffer.data(), 256);
+    }
+    ASSERT_TRUE(waitForDecodedFrames(*m_pDecoder, 2560));
+    EXPECT_EQ(2560u, pVinylControl->analyzedFrames());
+    EXPECT_LE(0, m_pDecoder->latency().toIntegerNanos());
+
+    VinylSignalQualityReport report;
+    ASSERT_EQ(1, m_pDecoder->getSignalQualityFifo()->read(&report, 1));
+    EXPECT_EQ(1, report.processor);
+
+    // The decoder does not use the previous VinylControl anymore
+    EXPECT_EQ(pVinylControl.get(), m_pDecoder->replaceVinylControl(nullptr));
+    m_pDecoder->receiveSamples(buffer.data(), 256);
+    m_pDecoder->shutdown();
+    m_pDecoder->wait();
+    EXPECT_EQ(2560u, pVinylControl->analyzedFrames());
+}
+
+// A quadrature tone like on a timecode record, with the amplitude of each
+// cycle carrying the next bit of the timecode.
+std::vector<CSAMPLE> generateTimecode(
+        const timecode_def& def, unsigned int sampleRate, unsigned int frames) {
+    const bool leftIsPrimary = def.flags & 0x2;
+    const bool switchPhase = def.flags & 0x1;
+    std::vector<CSAMPLE> samples(frames * kChannels);
+    bits_t code = def.seed;
+    bool bit = true;
+    double lastPhase = 0.0;
+    for (unsigned int i = 0; i < frames; ++i) {
+        const double cycles = static_cast<double>(i) * def.resolution / sampleRate;
+        const double phase = cycles - qFloor(cycles);
+        if (phase < lastPhase) {
+            // Same as fwd() of timecoder.c
+            bits_t taken = code & (def.taps | 0x1);
+            bits_t parity = 0;
+            while (taken != 0) {
+                parity += taken & 0x1;
+                taken >>= 1;
+            }
+            code = (code >> 1) | ((parity & 0x1) << (def.bits - 1));
+            bit = (code >> (def.bits - 1)) & 0x1;
+        }
+        lastPhase = phase;
+        const double amplitude = bit ? 0.8 : 0.5;
+        const CSAMPLE primary = amplitude * qSin(2 * M_PI * phase);
+        const CSAMPLE secondary = (switchPhase ? 1 : -1) * amplitude * qCos(2 * M_PI * phase);
+        samples[i * kChannels] = leftIsPrimary ? primary : secondary;
+        samples[i * kChannels + 1] = leftIsPrimary ? secondary : primary;
+    }
+    return samples;
+}
+
+const unsigned int kBenchmarkSampleRate = 96000;
+// The buffer size of the sound card
+const unsigned int kCallbackFrames = 128;
+// Stays well below the size of the sample pipe of a decoder
+const quint64 kMaxPendingFrames = 8192;
+
+// Decodes 2 seconds of Serato timecode at 96 kHz for each of the given
+// number of decks. With a second argument of 0 the decks are decoded one
+// after another on a single thread like VinylControlProcessor did before.
+// Otherwise every deck is decoded by its own VinylControlDecoder.
+static void BM_DecodeTimecode(benchmark::State& state) {
+    const int deckCount = state.range(0);
+    const bool threaded = state.range(1) != 0;
+
+    QTemporaryDir configDir;
+    UserSettingsPointer pConfig(new UserSettings(
+            configDir.filePath("benchmark.cfg")));
+    pConfig->set(ConfigKey("[Soundcard]", "Samplerate"),
+            ConfigValue(static_cast<int>(kBenchmarkSampleRate)));
+
+    TimecodeLutCache::createInstance()->setCacheDirPath(configDir.filePath("timecodes"));
+    timecode_def* pDef = timecoder_match_definition("serato_2a");
+    while (!TimecodeLutCache::instance()->attachLookupTable(pDef)) {
+        QThread::msleep(10);
+    }
+
+    const unsigned int frames = 2 * kBenchmarkSampleRate;
+    const std::vector<CSAMPLE> timecode = generateTimecode(*pDef, kBenchmarkSampleRate, frames);
+    std::vector<CSAMPLE> workBuffer(kCallbackFrames * kChannels);
+
+    std::vector<std::unique_ptr<VinylControl>> vinylControls;
+    std::vector<std::unique_ptr<VinylControlDecoder>> decoders;
+    for (int i = 0; i < deckCount; ++i) {
+        const QString group = kVCGroup.arg(i + 1);
+        pConfig->set(ConfigKey(group, "vinylcontrol_vinyl_type"),
+                ConfigValue(QString(MIXXX_VINYL_SERATOCV02VINYLSIDEA)));
+        vinylControls.push_back(std::make_unique<VinylControlXwax>(pConfig, group));
+        if (threaded) {
+            decoders.push_back(std::make_unique<VinylControlDecoder>(i));
+            decoders.back()->replaceVinylControl(vinylControls.back().get());
+            decoders.back()->start(QThread::HighPriority);
+        }
+    }
+
+    mixxx::Duration maxLatency;
+    quint64 fedFrames = 0;
+    while (state.KeepRunning()) {
+        for (unsigned int offset = 0; offset < frames; offset += kCallbackFrames) {
+            const CSAMPLE* pChunk = &timecode[offset * kChannels];
+            if (threaded) {
+                for (const auto& pDecoder : decoders) {
+                    // Don't overflow the sample pipe
+                    while (fedFrames - pDecoder->decodedFrames() > kMaxPendingFrames) {
+                        QThread::yieldCurrentThread();
+                    }
+                    pDecoder->receiveSamples(pChunk, kCallbackFrames);
+                    maxLatency = math_max(maxLatency, pDecoder->latency());
+                }
+            } else {
+                for (const auto& pVinylControl : vinylControls) {
+                    std::copy(pChunk, pChunk + kCallbackFrames * kChannels, workBuffer.begin());
+                    pVinylControl->analyzeSamples(workBuffer.data(), kCallbackFrames);
+                }
+            }
+            fedFrames += kCallbackFrames;
+        }
+        for (const auto& pDecoder : decoders) {
+            while (pDecoder->decodedFrames() < fedFrames) {
+                QThread::yieldCurrentThread();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * frames * deckCount);
+    state.counters["max_latency_ms"] = maxLatency.toDoubleMillis();
+
+    decoders.clear();
+    vinylControls.clear();
+    TimecodeLutCache::destroy();
+}
+BENCHMARK(BM_DecodeTimecode)
+        ->Unit(benchmark::kMillisecond)
+        ->Args({1, 0})
+        ->Args({4, 0})
+        ->Args({1, 1})
+        ->Args({4, 1});
+
+} // namespace
+
+#endif // __VINYLCONTROL__
@@ -0,0 +1,180 @@
+#include "util/callbackprofiler.h"
+
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/time.h"
+
+namespace {
+
+mixxx::Logger kLogger("CallbackProfiler");
+
+// The queue keeps one slot empty
+const size_t kDeadlineMissQueueSize = 8 + 1;
+
+} // anonymous namespace
+
+CallbackProfiler::CallbackRecord::CallbackRecord()
+        : startNanos(0),
+          durationNanos(0),
+          deadlineNanos(0),
+          frames(0) {
+    stageNanos.fill(0);
+}
+
+CallbackProfiler::DeadlineMiss::DeadlineMiss()
+        : numRecords(0),
+          missIndex(0) {
+}
+
+CallbackProfiler::DeadlineMiss::DeadlineMiss(
+        const std::array<CallbackRecord, kHistorySize>& history,
+        quint64 numRecorded,
+        quint64 missedRecord)
+        : numRecords(static_cast<int>(math_min<quint64>(numRecorded, kHistorySize))),
+          missIndex(static_cast<int>(missedRecord - (numRecorded - numRecords))) {
+    const quint64 firstRecord = numRecorded - numRecords;
+    for (int i = 0; i < numRecords; ++i) {
+        records[i] = history[(firstRecord + i) % kHistorySize];
+    }
+}
+
+// static
+CallbackProfiler& CallbackProfiler::instance() {
+    static CallbackProfiler s_instance;
+    return s_instance;
+}
+
+// static
+QString CallbackProfiler::stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Other:
+        return QStringLiteral("other");
+    case Stage::Input:
+        return QStringLiteral("input");
+    case Stage::ReadProcess:
+        return QStringLiteral("readProcess");
+    case Stage::ProcessChannels:
+        return QStringLiteral("processChannels");
+    case Stage::Effects:
+        return QStringLiteral("effects");
+    case Stage::Mixing:
+        return QStringLiteral("mixing");
+    case Stage::SidechainPush:
+        return QStringLiteral("sidechain");
+    case Stage::Output:
+        return QStringLiteral("output");
+    case Stage::WriteProcess:
+        return QStringLiteral("writeProcess");
+    }
+    DEBUG_ASSERT(!"Unknown stage");
+    return QString();
+}
+
+CallbackProfiler::CallbackProfiler()
+        : m_bInCallback(false),
+          m_currentStage(Stage::Other),
+          m_stageStartNanos(0),
+          m_numRecorded(0),
+          m_bDeadlineMissPending(false),
+          m_missedRecord(0),
+          m_deadlineMissCount(0),
+          m_droppedDeadlineMissCount(0),
+          m_deadlineMisses(kDeadlineMissQueueSize) {
+}
+
+void CallbackProfiler::callbackStarted(SINT frames, double sampleRate) {
+    DEBUG_ASSERT(!m_bInCallback);
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    m_current = CallbackRecord();
+    m_current.startNanos = nowNanos;
+    m_current.frames = frames;
+    m_current.deadlineNanos = sampleRate > 0 ?
+            static_cast<qint64>(frames * 1e9 / sampleRate) : 0;
+    m_currentStage = Stage::Other;
+    m_stageStartNanos = nowNanos;
+    m_bInCallback = true;
+}
+
+void CallbackProfiler::callbackFinished() {
+    VERIFY_OR_DEBUG_ASSERT(m_bInCallback) {
+        return;
+    }
+    const qint64 nowNanos = mixxx::Time::elapsed().toIntegerNanos();
+    accountElapsedTime(nowNanos);
+    m_bInCallback = false;
+    m_current.durationNanos = nowNanos - m_current.startNanos;
+
+    m_callbackHistogram.recordNanos(m_current.durationNanos);
+    for (int i = 0; i < kNumStages; ++i) {
+        m_stageHistograms[i].recordNanos(m_current.stageNanos[i]);
+    }
+
+    const quint64 record = m_numRecorded++;
+    m_history[record % kHistorySize] = m_current;
+    if (m_current.missedDeadline()) {
+        m_deadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+        // Following misses are part of the pending history
+        if (!m_bDeadlineMissPending) {
+            m_bDeadlineMissPending = true;
+            m_missedRecord = record;
+        }
+    }
+    if (m_bDeadlineMissPending &&
+            record - m_missedRecord >= static_cast<quint64>(kCallbacksAfterMiss)) {
+        m_bDeadlineMissPending = false;
+        // Copies the history into a preallocated slot of the queue
+        if (!m_deadlineMisses.try_emplace(m_history, m_numRecorded, m_missedRecord)) {
+            m_droppedDeadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+CallbackProfiler::Stage CallbackProfiler::enterStage(Stage stage) {
+    if (!m_bInCallback) {
+        return Stage::Other;
+    }
+    accountElapsedTime(mixxx::Time::elapsed().toIntegerNanos());
+    const Stage previousStage = m_currentStage;
+    m_currentStage = stage;
+    return previousStage;
+}
+
+void CallbackProfiler::accountElapsedTime(qint64 nowNanos) {
+    m_current.stageNanos[static_cast<int>(m_currentStage)] += nowNanos - m_stageStartNanos;
+    m_stageStartNanos = nowNanos;
+}
+
+bool CallbackProfiler::takeDeadlineMiss(DeadlineMiss* pDeadlineMiss) {
+    DeadlineMiss* pFront = m_deadlineMisses.front();
+    if (!pFront) {
+        return false;
+    }
+    *pDeadlineMiss = *pFront;
+    m_deadlineMisses.pop();
+    return true;
+}
+
+void CallbackProfiler::logSummary() const {
+    if (m_callbackHistogram.count() == 0) {
+        return;
+    }
+    kLogger.info()
+            << "Audio callbacks:" << m_callbackHistogram.count()
+            << "missed deadlines:" << deadlineMissCount()
+            << "p50:" << m_callbackHistogram.percentile(50)
+            << "p99:" << m_callbackHistogram.percentile(99)
+            << "p99.9:" << m_callbackHistogram.percentile(99.9)
+            << "max:" << m_callbackHistogram.max();
+    for (int i = 0; i < kNumStages; ++i) {
+        const LatencyHistogram& histogram = m_stageHistograms[i];
+        if (histogram.max() == mixxx::Duration()) {
+            continue;
+        }
+        kLogger.info()
+                << "  " << stageName(static_cast<Stage>(i))
+                << "mean:" << histogram.mean()
+                << "p99:" << histogram.percentile(99)
+                << "p99.9:" << histogram.percentile(99.9)
+                << "max:" << histogram.max();
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <QString>
+#include <array>
+#include <atomic>
+
+#include "rigtorp/SPSCQueue.h"
+#include "util/duration.h"
+#include "util/latencyhistogram.h"
+#include "util/types.h"
+
+// Always-on instrumentation of the audio callback that drives the engine.
+//
+// The duration of every callback and the time spent in each stage of it are
+// recorded into latency histograms. The last callbacks are kept in a ring
+// buffer, which is copied when a callback misses its deadline, i.e. takes
+// longer than the period of its buffer. A copy contains the callbacks before
+// and after the miss and is picked up by StatsManager, which writes it to
+// the timeline when Mixxx is started with --timelinePath.
+//
+// The callback thread is the only one that may call the recording methods.
+// They are lock-free and do not allocate. The histograms can be read from
+// any thread at any time.
+class CallbackProfiler {
+  public:
+    // Time spent within nested stages is only accounted to the innermost
+    // stage, e.g. effects that are processed while mixing.
+    enum class Stage {
+        Other,
+        Input,
+        ReadProcess,
+        ProcessChannels,
+        Effects,
+        Mixing,
+        SidechainPush,
+        Output,
+        WriteProcess,
+    };
+    static constexpr int kNumStages = static_cast<int>(Stage::WriteProcess) + 1;
+
+    static constexpr int kHistorySize = 64;
+    // The number of callbacks that are recorded after a missed deadline
+    // before the history is copied.
+    static constexpr int kCallbacksAfterMiss = 16;
+
+    struct CallbackRecord {
+        CallbackRecord();
+
+        // The start since Mixxx started up
+        qint64 startNanos;
+        qint64 durationNanos;
+        qint64 deadlineNanos;
+        std::array<qint64, kNumStages> stageNanos;
+        SINT frames;
+
+        bool missedDeadline() const {
+            return durationNanos > deadlineNanos;
+        }
+    };
+
+    // The history of callbacks around a missed deadline
+    struct DeadlineMiss {
+        DeadlineMiss();
+        DeadlineMiss(const std::array<CallbackRecord, kHistorySize>& history,
+                quint64 numRecorded,
+                quint64 missedRecord);
+
+        // Oldest first
+        std::array<CallbackRecord, kHistorySize> records;
+        int numRecords;
+        // The index of the callback that missed its deadline, later ones
+        // may have missed theirs as well.
+        int missIndex;
+    };
+
+    // Records the callback while in scope
+    class ScopedCallback {
+      public:
+        ScopedCallback(SINT frames, double sampleRate,
+                CallbackProfiler* pProfiler = &CallbackProfiler::instance())
+                : m_pProfiler(pProfiler) {
+            m_pProfiler->callbackStarted(frames, sampleRate);
+        }
+        ~ScopedCallback() {
+            m_pProfiler->callbackFinished();
+        }
+
+      private:
+        CallbackProfiler* const m_pProfiler;
+    };
+
+    // Accounts the time while in scope to the stage. Has no effect outside
+    // of a callback, e.g. when the engine is clocked by tests.
+    class ScopedStage {
+      public:
+        explicit ScopedStage(Stage stage,
+                CallbackProfiler* pProfiler = &CallbackProfiler::instance())
+                : m_pProfiler(pProfiler),
+                  m_previousStage(pProfiler->enterStage(stage)) {
+        }
+        ~ScopedStage() {
+            m_pProfiler->enterStage(m_previousStage);
+        }
+
+      private:
+        CallbackProfiler* const m_pProfiler;
+        const Stage m_previousStage;
+    };
+
+    // The profiler of the sound devices
+    static CallbackProfiler& instance();
+
+    static QString stageName(Stage stage);
+
+    CallbackProfiler();
+
+    void callbackStarted(SINT frames, double sampleRate);
+    void callbackFinished();
+    // Returns the stage that was active before
+    Stage enterStage(Stage stage);
+
+    const LatencyHistogram& callbackHistogram() const {
+        return m_callbackHistogram;
+    }
+    const LatencyHistogram& stageHistogram(Stage stage) const {
+        return m_stageHistograms[static_cast<int>(stage)];
+    }
+    quint64 deadlineMissCount() const {
+        return m_deadlineMissCount.load(std::memory_order_relaxed);
+    }
+    // Histories that were not taken in time and have been discarded
+    quint64 droppedDeadlineMissCount() const {
+        return m_droppedDeadlineMissCount.load(std::memory_order_relaxed);
+    }
+
+    // Takes the oldest history of a missed deadline. Must only be called by a
+    // single thread.
+    bool takeDeadlineMiss(DeadlineMiss* pDeadlineMiss);
+
+    // Logs the percentiles of the callbacks and their stages
+    void logSummary() const;
+
+  private:
+    void accountElapsedTime(qint64 nowNanos);
+
+    // Only accessed by the callback thread
+    bool m_bInCallback;
+    CallbackRecord m_current;
+    Stage m_currentStage;
+    qint64 m_stageStartNanos;
+    std::array<CallbackRecord, kHistorySize> m_history;
+    quint64 m_numRecorded;
+    bool m_bDeadlineMissPending;
+    quint64 m_missedRecord;
+
+    LatencyHistogram m_callbackHistogram;
+    std::array<LatencyHistogram, kNumStages> m_stageHistograms;
+    std::atomic<quint64> m_deadlineMissCount;
+    std::atomic<quint64> m_droppedDeadlineMissCount;
+    rigtorp::SPSCQueue<DeadlineMiss> m_deadlineMisses;
+};
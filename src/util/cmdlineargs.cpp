@@ -58,6 +58,12 @@ bool CmdlineArgs::Parse(int &argc, char **argv) {
         } else if (argv[i] == QString("--timelinePath") && i+1 < argc) {
             m_timelinePath = QString::fromLocal8Bit(argv[i+1]);
             i++;
+        } else if (argv[i] == QString("--renderTimeline") && i+1 < argc) {
+            m_renderTimelinePath = QString::fromLocal8Bit(argv[i+1]);
+            i++;
+        } else if (argv[i] == QString("--renderOutput") && i+1 < argc) {
+            m_renderOutputPath = QString::fromLocal8Bit(argv[i+1]);
+            i++;
         } else if (argv[i] == QString("--logLevel") && i+1 < argc) {
             logLevelSet = true;
             auto level = QLatin1String(argv[i+1]);
@@ -156,6 +162,19 @@ void CmdlineArgs::printUsage() {
 \n\
 -f, --fullScreen        Starts Mixxx in full-screen mode\n\
 \n\
+--renderTimeline PATH   Renders the mix of a timeline script into the\n\
+                        file of --renderOutput as fast as possible\n\
+                        instead of playing it on a sound device, then\n\
+                        exits. Each line of the script is one event with\n\
+                        times in seconds:\n\
+                          load TIME GROUP play|cue FILE\n\
+                          set TIME GROUP ITEM VALUE\n\
+                          ramp START END GROUP ITEM STARTVALUE ENDVALUE\n\
+                          end TIME\n\
+\n\
+--renderOutput PATH     The rendered file. The format is chosen by the\n\
+                        file extension, e.g. .wav, .flac or .mp3.\n\
+\n\
 --logLevel LEVEL        Sets the verbosity of command line logging\n\
                         critical - Critical/Fatal only\n\
                         warning  - Above + Warnings\n\
@@ -37,6 +37,9 @@ class CmdlineArgs final {
     const QString& getResourcePath() const { return m_resourcePath; }
     const QString& getPluginPath() const { return m_pluginPath; }
     const QString& getTimelinePath() const { return m_timelinePath; }
+    bool getRenderEnabled() const { return !m_renderTimelinePath.isEmpty(); }
+    const QString& getRenderTimelinePath() const { return m_renderTimelinePath; }
+    const QString& getRenderOutputPath() const { return m_renderOutputPath; }
 
   private:
     CmdlineArgs();
@@ -55,6 +58,8 @@ class CmdlineArgs final {
     QString m_resourcePath;
     QString m_pluginPath;
     QString m_timelinePath;
+    QString m_renderTimelinePath;
+    QString m_renderOutputPath;
 };
 
 #endif /* CMDLINEARGS_H */
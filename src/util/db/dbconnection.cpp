@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlQuery>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -231,9 +232,55 @@ void sqliteLike(sqlite3_context *context,
     return;
 }
 
+bool execPragma(QSqlDatabase database, const QString& pragma, QVariant* pResult = nullptr) {
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA ") + pragma)) {
+        kLogger.warning()
+                << "Failed to execute"
+                << pragma
+                << query.lastError();
+        return false;
+    }
+    if (pResult) {
+        *pResult = query.next() ? query.value(0) : QVariant();
+    }
+    return true;
+}
+
+void tuneDatabase(QSqlDatabase database, const DbConnection::SqliteTuning& tuning) {
+    if (tuning.writeAheadLog) {
+        // Returns the resulting journal mode, which stays "memory"
+        // for in-memory databases
+        QVariant journalMode;
+        if (execPragma(database, QStringLiteral("journal_mode=WAL"), &journalMode)) {
+            if (journalMode.toString().compare(
+                        QLatin1String("wal"), Qt::CaseInsensitive) == 0) {
+                // Only the last transactions might get lost on power
+                // failure, but the database won't get corrupted in WAL
+                // mode. Committing doesn't need to wait for fsync().
+                execPragma(database, QStringLiteral("synchronous=NORMAL"));
+            } else {
+                kLogger.debug()
+                        << "Write-ahead log is not available, journal mode is"
+                        << journalMode.toString();
+            }
+        }
+    }
+    // Negative values are in KiB instead of pages
+    execPragma(database,
+            QStringLiteral("cache_size=-%1").arg(tuning.cacheSizeKiB));
+    execPragma(database,
+            QStringLiteral("mmap_size=%1").arg(tuning.mmapSizeBytes));
+    // Temporary tables are used for resolving and importing tracks
+    execPragma(database, QStringLiteral("temp_store=MEMORY"));
+}
+
 #endif // __SQLITE3__
 
-bool initDatabase(QSqlDatabase database, StringCollator* pCollator) {
+bool initDatabase(
+        QSqlDatabase database,
+        StringCollator* pCollator,
+        const DbConnection::SqliteTuning& tuning) {
     DEBUG_ASSERT(database.isOpen());
 #ifdef __SQLITE3__
     QVariant v = database.driver()->handle();
@@ -303,9 +350,12 @@ bool initDatabase(QSqlDatabase database, StringCollator* pCollator) {
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    tuneDatabase(database, tuning);
 #else
     Q_UNUSED(database);
     Q_UNUSED(pCollator);
+    Q_UNUSED(tuning);
 #endif // __SQLITE3__
     return true;
 }
@@ -315,13 +365,15 @@ bool initDatabase(QSqlDatabase database, StringCollator* pCollator) {
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_sqlDatabase(createDatabase(params, connectionName)),
+      m_sqliteTuning(params.sqliteTuning) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
         const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)),
+      m_sqliteTuning(prototype.m_sqliteTuning) {
 }
 
 DbConnection::~DbConnection() {
@@ -342,13 +394,14 @@ bool DbConnection::open() {
                 << m_sqlDatabase.lastError();
         return false; // abort
     }
-    if (!initDatabase(m_sqlDatabase, &m_collator)) {
+    if (!initDatabase(m_sqlDatabase, &m_collator, m_sqliteTuning)) {
         kLogger.warning()
                 << "Failed to initialize database connection"
                 << *this;
         m_sqlDatabase.close();
         return false; // abort
     }
+    m_statementCache.attach(m_sqlDatabase);
     return true;
 }
 
@@ -365,8 +418,13 @@ void DbConnection::close() {
         if (kLogger.debugEnabled()) {
             kLogger.debug()
                     << "Closing database connection:"
-                    << *this;
+                    << *this
+                    << "prepared statements reused:"
+                    << m_statementCache.hitCount()
+                    << "of"
+                    << m_statementCache.hitCount() + m_statementCache.missCount();
         }
+        m_statementCache.detach(m_sqlDatabase);
         m_sqlDatabase.close();
     }
 }
@@ -5,6 +5,7 @@
 #include <QSqlDatabase>
 #include <QtDebug>
 
+#include "util/db/sqlstatementcache.h"
 #include "util/string.h"
 
 namespace mixxx {
@@ -24,6 +25,19 @@ class DbConnection final {
 
     static void makeStringLatinLow(QString* string);
 
+    // Applied to SQLite connections when opening them, see also
+    // https://www.sqlite.org/pragma.html
+    struct SqliteTuning {
+        // Readers don't block the writer and vice versa. Not
+        // available for in-memory databases.
+        bool writeAheadLog = true;
+        // The page cache of each connection in KiB
+        int cacheSizeKiB = 16 * 1024;
+        // The size of the database file that is read through
+        // memory-mapped I/O instead of copying pages, 0 = disabled
+        qint64 mmapSizeBytes = 256 * 1024 * 1024;
+    };
+
     struct Params {
         QString type;
         QString connectOptions;
@@ -31,6 +45,7 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+        SqliteTuning sqliteTuning;
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -64,7 +79,9 @@ class DbConnection final {
     DbConnection(const DbConnection&&) = delete;
 
     QSqlDatabase m_sqlDatabase;
+    const SqliteTuning m_sqliteTuning;
     StringCollator m_collator;
+    SqlStatementCache m_statementCache;
 };
 
 } // namespace mixxx
@@ -2,6 +2,7 @@
 
 #include <QSqlRecord>
 
+#include "util/db/sqlstatementcache.h"
 #include "util/performancetimer.h"
 #include "util/logger.h"
 #include "util/assert.h"
@@ -36,7 +37,18 @@ FwdSqlQuery::FwdSqlQuery(
         QSqlDatabase database,
         const QString& statement)
     : QSqlQuery(database),
-      m_prepared(prepareQuery(*this, statement)) {
+      m_prepared(false) {
+    auto* const pStatementCache = mixxx::SqlStatementCache::forDatabase(database);
+    if (pStatementCache && pStatementCache->take(statement, this)) {
+        DEBUG_ASSERT(isForwardOnly());
+        m_prepared = true;
+        m_cachedStatement = statement;
+        return;
+    }
+    m_prepared = prepareQuery(*this, statement);
+    if (m_prepared && pStatementCache) {
+        m_cachedStatement = statement;
+    }
     if (!m_prepared) {
         DEBUG_ASSERT(!database.isOpen() || hasError());
         kLogger.critical()
@@ -47,6 +59,40 @@ FwdSqlQuery::FwdSqlQuery(
     }
 }
 
+FwdSqlQuery::FwdSqlQuery(FwdSqlQuery&& other)
+    : QSqlQuery(other), // implicitly shared
+      m_prepared(other.m_prepared),
+      m_cachedStatement(std::move(other.m_cachedStatement)) {
+    other.m_cachedStatement = QString();
+}
+
+FwdSqlQuery::~FwdSqlQuery() {
+    returnToStatementCache();
+}
+
+FwdSqlQuery& FwdSqlQuery::operator=(FwdSqlQuery&& other) {
+    if (this != &other) {
+        returnToStatementCache();
+        QSqlQuery::operator=(other); // implicitly shared
+        m_prepared = other.m_prepared;
+        m_cachedStatement = std::move(other.m_cachedStatement);
+        other.m_cachedStatement = QString();
+    }
+    return *this;
+}
+
+void FwdSqlQuery::returnToStatementCache() {
+    if (m_cachedStatement.isEmpty()) {
+        return;
+    }
+    // The connection might have been closed in the meantime
+    auto* const pStatementCache = mixxx::SqlStatementCache::forDriver(driver());
+    if (pStatementCache) {
+        pStatementCache->put(m_cachedStatement, *this);
+    }
+    m_cachedStatement = QString();
+}
+
 bool FwdSqlQuery::execPrepared() {
     DEBUG_ASSERT(isPrepared());
     DEBUG_ASSERT(!hasError());
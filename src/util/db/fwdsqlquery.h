@@ -30,6 +30,11 @@ class FwdSqlQuerySelectResult;
 //
 // Please note that forward-only queries don't provide information
 // about the size of the result set!
+//
+// Prepared statements are reused from the SqlStatementCache of the
+// connection if available and returned upon destruction. All
+// placeholders must be bound before executing the query, because
+// values that have been bound by a previous user are not reset.
 class FwdSqlQuery: protected QSqlQuery {
     friend class SqlQueryFinisher;
     friend class FwdSqlQuerySelectResult;
@@ -38,6 +43,10 @@ class FwdSqlQuery: protected QSqlQuery {
     FwdSqlQuery(
             QSqlDatabase database,
             const QString& statement);
+    FwdSqlQuery(FwdSqlQuery&& other);
+    ~FwdSqlQuery();
+
+    FwdSqlQuery& operator=(FwdSqlQuery&& other);
 
     bool isPrepared() const {
         return m_prepared;
@@ -111,7 +120,18 @@ class FwdSqlQuery: protected QSqlQuery {
     bool fieldValueBoolean(DbFieldIndex fieldIndex) const;
 
   private:
-    FwdSqlQuery() = default; // hidden
+    FwdSqlQuery() // hidden
+            : m_prepared(false) {
+    }
+    // Only a single instance may return the statement to the cache
+    FwdSqlQuery(const FwdSqlQuery&) = delete;
+    FwdSqlQuery& operator=(const FwdSqlQuery&) = delete;
+
+    void returnToStatementCache();
 
     bool m_prepared;
+
+    // Non-empty if the prepared statement is owned by this instance
+    // and will be returned to the statement cache of the connection
+    QString m_cachedStatement;
 };
@@ -0,0 +1,93 @@
+#include "util/db/sqlstatementcache.h"
+
+#include <QSqlDriver>
+#include <QSqlError>
+#include <QVariant>
+
+#include "util/assert.h"
+
+namespace mixxx {
+
+namespace {
+
+// The dynamic property of the QSqlDriver that is shared by all copies
+// of a QSqlDatabase for the same connection
+const char* const kDriverProperty = "mixxxSqlStatementCache";
+
+} // anonymous namespace
+
+SqlStatementCache::SqlStatementCache(int capacity)
+        : m_statements(capacity),
+          m_hitCount(0),
+          m_missCount(0) {
+}
+
+SqlStatementCache::~SqlStatementCache() {
+    DEBUG_ASSERT(m_statements.isEmpty());
+}
+
+//static
+SqlStatementCache* SqlStatementCache::forDatabase(const QSqlDatabase& database) {
+    return forDriver(database.driver());
+}
+
+//static
+SqlStatementCache* SqlStatementCache::forDriver(const QSqlDriver* pDriver) {
+    if (!pDriver) {
+        return nullptr;
+    }
+    return static_cast<SqlStatementCache*>(
+            pDriver->property(kDriverProperty).value<void*>());
+}
+
+void SqlStatementCache::attach(const QSqlDatabase& database) {
+    VERIFY_OR_DEBUG_ASSERT(database.driver()) {
+        return;
+    }
+    DEBUG_ASSERT(!forDatabase(database));
+    database.driver()->setProperty(kDriverProperty,
+            QVariant::fromValue(static_cast<void*>(this)));
+}
+
+void SqlStatementCache::detach(const QSqlDatabase& database) {
+    // Finalize all statements while the connection is still open
+    clear();
+    VERIFY_OR_DEBUG_ASSERT(database.driver()) {
+        return;
+    }
+    DEBUG_ASSERT(forDatabase(database) == this);
+    database.driver()->setProperty(kDriverProperty, QVariant());
+}
+
+bool SqlStatementCache::take(const QString& statement, QSqlQuery* pQuery) {
+    DEBUG_ASSERT(pQuery);
+    QSqlQuery* pCachedQuery = m_statements.take(statement);
+    if (!pCachedQuery) {
+        ++m_missCount;
+        return false;
+    }
+    ++m_hitCount;
+    // Implicitly shared
+    *pQuery = *pCachedQuery;
+    delete pCachedQuery;
+    return true;
+}
+
+void SqlStatementCache::put(const QString& statement, QSqlQuery query) {
+    // Release the locks and resources of the statement until it is
+    // executed again
+    query.finish();
+    if (query.lastError().isValid() &&
+            query.lastError().type() != QSqlError::NoError) {
+        return;
+    }
+    // Replaces a statement that has been prepared again while the
+    // cached one was in use
+    m_statements.insert(statement, new QSqlQuery(std::move(query)));
+}
+
+void SqlStatementCache::clear() {
+    m_statements.clear();
+}
+
+} // namespace mixxx
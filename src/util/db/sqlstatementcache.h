@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QCache>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+class QSqlDriver;
+
+namespace mixxx {
+
+// Keeps the prepared statements of a single database connection for
+// reuse, so that the same SQL text is not compiled again on every
+// execution.
+//
+// A prepared statement is owned exclusively while it is in use: take()
+// removes it from the cache and put() returns it after it has been
+// finished. Bound values are not reset in between, i.e. users must bind
+// all placeholders before executing a reused statement.
+//
+// The cache is attached to the driver of the connection and like the
+// connection it must only be accessed from the thread that opened it.
+class SqlStatementCache final {
+  public:
+    static constexpr int kDefaultCapacity = 128;
+
+    explicit SqlStatementCache(int capacity = kDefaultCapacity);
+    ~SqlStatementCache();
+
+    // Returns the cache that is attached to the connection or nullptr
+    static SqlStatementCache* forDatabase(const QSqlDatabase& database);
+    static SqlStatementCache* forDriver(const QSqlDriver* pDriver);
+
+    // The cache must be detached before closing the connection
+    void attach(const QSqlDatabase& database);
+    void detach(const QSqlDatabase& database);
+
+    // Moves a previously prepared statement into pQuery. Returns false
+    // if the statement needs to be prepared.
+    bool take(const QString& statement, QSqlQuery* pQuery);
+
+    // Finishes the query and keeps it for reuse unless it failed
+    void put(const QString& statement, QSqlQuery query);
+
+    void clear();
+
+    int size() const {
+        return m_statements.size();
+    }
+
+    quint64 hitCount() const {
+        return m_hitCount;
+    }
+    quint64 missCount() const {
+        return m_missCount;
+    }
+
+  private:
+    SqlStatementCache(const SqlStatementCache&) = delete;
+    SqlStatementCache& operator=(const SqlStatementCache&) = delete;
+
+    // Least recently used statements are finalized first
+    QCache<QString, QSqlQuery> m_statements;
+
+    quint64 m_hitCount;
+    quint64 m_missCount;
+};
+
+} // namespace mixxx
@@ -0,0 +1,103 @@
+#include "util/latencyhistogram.h"
+
+#include <cmath>
+
+#include "util/math.h"
+
+namespace {
+
+constexpr qint64 kMaxValue = (Q_INT64_C(1) << LatencyHistogram::kMaxValueBits) - 1;
+// Values below are stored exactly, one value per bucket
+constexpr qint64 kLinearRange = 2 * LatencyHistogram::kSubBuckets;
+
+} // anonymous namespace
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+// static
+int LatencyHistogram::bucketIndex(qint64 nanos) {
+    if (nanos < kLinearRange) {
+        return nanos > 0 ? static_cast<int>(nanos) : 0;
+    }
+    nanos = math_min(nanos, kMaxValue);
+    // The number of low bits that are dropped to fit the value into the
+    // sub buckets of its power of two range
+#if defined(__GNUC__) || defined(__clang__)
+    const int magnitude = 63 - __builtin_clzll(static_cast<unsigned long long>(nanos)) -
+            kSubBucketBits;
+#else
+    int magnitude = 0;
+    while ((nanos >> magnitude) >= kLinearRange) {
+        ++magnitude;
+    }
+#endif
+    return magnitude * kSubBuckets + static_cast<int>(nanos >> magnitude);
+}
+
+// static
+qint64 LatencyHistogram::bucketUpperBound(int index) {
+    DEBUG_ASSERT(index >= 0 && index < kNumBuckets);
+    if (index < kLinearRange) {
+        return index;
+    }
+    const int magnitude = index / kSubBuckets - 1;
+    const qint64 subBucket = index - magnitude * kSubBuckets;
+    return ((subBucket + 1) << magnitude) - 1;
+}
+
+void LatencyHistogram::recordNanos(qint64 nanos) {
+    m_buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+    qint64 maxNanos = m_maxNanos.load(std::memory_order_relaxed);
+    while (nanos > maxNanos &&
+            !m_maxNanos.compare_exchange_weak(maxNanos, nanos, std::memory_order_relaxed)) {
+    }
+}
+
+mixxx::Duration LatencyHistogram::mean() const {
+    const quint64 numValues = count();
+    if (numValues == 0) {
+        return mixxx::Duration();
+    }
+    return mixxx::Duration::fromNanos(
+            m_sumNanos.load(std::memory_order_relaxed) / static_cast<qint64>(numValues));
+}
+
+mixxx::Duration LatencyHistogram::percentile(double percentile) const {
+    // The total is summed up from the buckets instead of using m_count,
+    // which might be ahead while a value is recorded concurrently.
+    quint64 total = 0;
+    for (const auto& bucket : m_buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return mixxx::Duration();
+    }
+    const quint64 rank = math_clamp<quint64>(
+            static_cast<quint64>(std::ceil(percentile / 100.0 * total)),
+            1,
+            total);
+    quint64 cumulative = 0;
+    for (int index = 0; index < kNumBuckets; ++index) {
+        cumulative += m_buckets[index].load(std::memory_order_relaxed);
+        if (cumulative >= rank) {
+            // No recorded value exceeds the maximum
+            return mixxx::Duration::fromNanos(math_min(
+                    bucketUpperBound(index),
+                    m_maxNanos.load(std::memory_order_relaxed)));
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sumNanos.store(0, std::memory_order_relaxed);
+    m_maxNanos.store(0, std::memory_order_relaxed);
+}
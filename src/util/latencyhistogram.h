@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+#include "util/duration.h"
+
+// A histogram of durations with a bounded relative error, similar to
+// HdrHistogram. Each power of two range is split into kSubBuckets linear
+// buckets, so every recorded value is accurate to 1/kSubBuckets (~3 %)
+// regardless of whether it is a few microseconds or several seconds.
+//
+// Recording is wait-free and does not allocate, so it can be used in the
+// audio callback while other threads read the histogram.
+class LatencyHistogram {
+  public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    // Durations of more than 2^40 ns (~18 minutes) are clamped.
+    static constexpr int kMaxValueBits = 40;
+    static constexpr int kNumBuckets =
+            (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+    LatencyHistogram();
+
+    void record(mixxx::Duration duration) {
+        recordNanos(duration.toIntegerNanos());
+    }
+    void recordNanos(qint64 nanos);
+
+    quint64 count() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+    mixxx::Duration max() const {
+        return mixxx::Duration::fromNanos(m_maxNanos.load(std::memory_order_relaxed));
+    }
+    mixxx::Duration mean() const;
+
+    // Returns the smallest duration that is greater than or equal to
+    // percentile % of all recorded durations, e.g. percentile(99.9).
+    mixxx::Duration percentile(double percentile) const;
+
+    // Values that are recorded concurrently might be lost.
+    void reset();
+
+    // Exposed for testing
+    static int bucketIndex(qint64 nanos);
+    // The largest value that is recorded in the bucket
+    static qint64 bucketUpperBound(int index);
+
+  private:
+    std::array<std::atomic<quint64>, kNumBuckets> m_buckets;
+    std::atomic<quint64> m_count;
+    std::atomic<qint64> m_sumNanos;
+    std::atomic<qint64> m_maxNanos;
+};
@@ -412,6 +412,17 @@ SampleUtil::CLIP_STATUS SampleUtil::sumAbsPerChannel(CSAMPLE* pfAbsL,
     return clipping;
 }
 
+// static
+CSAMPLE SampleUtil::maxAbsAmplitude(const CSAMPLE* pBuffer, SINT numSamples) {
+    CSAMPLE fMax = CSAMPLE_ZERO;
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        CSAMPLE absValue = fabs(pBuffer[i]);
+        fMax = absValue > fMax ? absValue : fMax;
+    }
+    return fMax;
+}
+
 // static
 void SampleUtil::copyClampBuffer(CSAMPLE* M_RESTRICT pDest,
         const CSAMPLE* M_RESTRICT pSrc, SINT iNumSamples) {
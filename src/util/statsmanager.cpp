@@ -2,7 +2,12 @@
 #include <QMutexLocker>
 #include <QTextStream>
 #include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaType>
+#include <QSet>
 
 #include "util/statsmanager.h"
 #include "util/cmdlineargs.h"
@@ -12,6 +17,14 @@
 const int kStatsPipeSize = 1 << 10;
 const int kProcessLength = kStatsPipeSize * 4 / 5;
 
+// The most recent deadline misses of the audio callback that are kept
+// for the timeline
+const int kMaxDeadlineMisses = 64;
+
+// Thread ids of the Chrome trace
+const int kEventsTraceThread = 1;
+const int kCallbackTraceThread = 2;
+
 // static
 bool StatsManager::s_bStatsManagerEnabled = false;
 
@@ -70,8 +83,13 @@ StatsManager::~StatsManager() {
         }
     }
     qDebug() << "=====================================";
+    CallbackProfiler::instance().logSummary();
 
     if (CmdlineArgs::Instance().getTimelineEnabled()) {
+        {
+            QMutexLocker locker(&m_statsPipeLock);
+            processDeadlineMisses();
+        }
         writeTimeline(CmdlineArgs::Instance().getTimelinePath());
     }
 }
@@ -103,6 +121,11 @@ QString humanizeNanos(qint64 nanos) {
 }
 
 void StatsManager::writeTimeline(const QString& filename) {
+    if (filename.endsWith(QStringLiteral(".json"), Qt::CaseInsensitive)) {
+        writeChromeTrace(filename);
+        return;
+    }
+
     QFile timeline(filename);
     if (!timeline.open(QIODevice::WriteOnly | QIODevice::Text)) {
         qDebug() << "Could not open timeline file for writing:"
@@ -161,6 +184,146 @@ void StatsManager::writeTimeline(const QString& filename) {
     timeline.close();
 }
 
+namespace {
+
+QJsonObject chromeTraceThreadName(int threadId, const QString& name) {
+    QJsonObject event;
+    event.insert("name", "thread_name");
+    event.insert("ph", "M");
+    event.insert("pid", 1);
+    event.insert("tid", threadId);
+    event.insert("args", QJsonObject{{"name", name}});
+    return event;
+}
+
+QJsonObject chromeTraceSpan(const QString& name, int threadId,
+        qint64 startNanos, qint64 durationNanos) {
+    QJsonObject event;
+    event.insert("name", name);
+    event.insert("cat", "audio");
+    event.insert("ph", "X");
+    event.insert("pid", 1);
+    event.insert("tid", threadId);
+    // Chrome traces are in microseconds
+    event.insert("ts", startNanos / 1e3);
+    event.insert("dur", durationNanos / 1e3);
+    return event;
+}
+
+} // anonymous namespace
+
+void StatsManager::writeChromeTrace(const QString& filename) {
+    QFile trace(filename);
+    if (!trace.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Could not open timeline file for writing:"
+                 << trace.fileName();
+        return;
+    }
+
+    QJsonArray traceEvents;
+    traceEvents.append(chromeTraceThreadName(kEventsTraceThread, "Events"));
+    traceEvents.append(chromeTraceThreadName(kCallbackTraceThread, "Audio callback"));
+
+    // Start and end events with the same tag are paired as async events,
+    // because events with different tags do not nest.
+    std::sort(m_events.begin(), m_events.end(), OrderByTime());
+    QHash<QString, int> asyncIds;
+    for (const Event& event : qAsConst(m_events)) {
+        QJsonObject traceEvent;
+        traceEvent.insert("name", event.m_tag);
+        traceEvent.insert("cat", "event");
+        traceEvent.insert("pid", 1);
+        traceEvent.insert("tid", kEventsTraceThread);
+        traceEvent.insert("ts", event.m_time.toDoubleMicros());
+        if (event.m_type == Stat::EVENT_START || event.m_type == Stat::EVENT_END) {
+            int id = asyncIds.value(event.m_tag);
+            if (id == 0) {
+                id = asyncIds.size() + 1;
+                asyncIds.insert(event.m_tag, id);
+            }
+            traceEvent.insert("ph", event.m_type == Stat::EVENT_START ? "b" : "e");
+            traceEvent.insert("id", id);
+        } else {
+            traceEvent.insert("ph", "i");
+            traceEvent.insert("s", "g");
+        }
+        traceEvents.append(traceEvent);
+    }
+
+    // The histories of subsequent misses may overlap
+    QSet<qint64> writtenCallbacks;
+    for (const auto& deadlineMiss : qAsConst(m_deadlineMisses)) {
+        for (int i = 0; i < deadlineMiss.numRecords; ++i) {
+            const CallbackProfiler::CallbackRecord& record = deadlineMiss.records[i];
+            if (writtenCallbacks.contains(record.startNanos)) {
+                continue;
+            }
+            writtenCallbacks.insert(record.startNanos);
+
+            QJsonObject callback = chromeTraceSpan(
+                    record.missedDeadline() ? "Missed deadline" : "Callback",
+                    kCallbackTraceThread,
+                    record.startNanos,
+                    record.durationNanos);
+            callback.insert("args", QJsonObject{
+                    {"frames", static_cast<int>(record.frames)},
+                    {"deadline_us", record.deadlineNanos / 1e3}});
+            traceEvents.append(callback);
+
+            // Interleaved stages have been summed up, so the stages are
+            // laid out one after another within the callback.
+            qint64 stageStartNanos = record.startNanos;
+            for (int stage = 0; stage < CallbackProfiler::kNumStages; ++stage) {
+                const qint64 stageNanos = record.stageNanos[stage];
+                if (stageNanos <= 0) {
+                    continue;
+                }
+                traceEvents.append(chromeTraceSpan(
+                        CallbackProfiler::stageName(
+                                static_cast<CallbackProfiler::Stage>(stage)),
+                        kCallbackTraceThread,
+                        stageStartNanos,
+                        stageNanos));
+                stageStartNanos += stageNanos;
+            }
+        }
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", traceEvents);
+    root.insert("displayTimeUnit", "ms");
+    trace.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    trace.close();
+}
+
+void StatsManager::processDeadlineMisses() {
+    CallbackProfiler::DeadlineMiss deadlineMiss;
+    while (CallbackProfiler::instance().takeDeadlineMiss(&deadlineMiss)) {
+        const CallbackProfiler::CallbackRecord& missed =
+                deadlineMiss.records[deadlineMiss.missIndex];
+        int slowestStage = 0;
+        for (int stage = 1; stage < CallbackProfiler::kNumStages; ++stage) {
+            if (missed.stageNanos[stage] > missed.stageNanos[slowestStage]) {
+                slowestStage = stage;
+            }
+        }
+        qDebug() << "Audio callback took"
+                 << mixxx::Duration::fromNanos(missed.durationNanos)
+                 << "of"
+                 << mixxx::Duration::fromNanos(missed.deadlineNanos)
+                 << "most of it in"
+                 << CallbackProfiler::stageName(
+                            static_cast<CallbackProfiler::Stage>(slowestStage));
+
+        if (CmdlineArgs::Instance().getTimelineEnabled()) {
+            m_deadlineMisses.append(deadlineMiss);
+            while (m_deadlineMisses.size() > kMaxDeadlineMisses) {
+                m_deadlineMisses.removeFirst();
+            }
+        }
+    }
+}
+
 void StatsManager::onStatsPipeDestroyed(StatsPipe* pPipe) {
     QMutexLocker locker(&m_statsPipeLock);
     processIncomingStatReports();
@@ -234,6 +397,7 @@ void StatsManager::processIncomingStatReports() {
             }
         }
     }
+    processDeadlineMisses();
 }
 
 void StatsManager::run() {
@@ -13,6 +13,7 @@
 
 #include "rigtorp/SPSCQueue.h"
 
+#include "util/callbackprofiler.h"
 #include "util/singleton.h"
 #include "util/stat.h"
 #include "util/event.h"
@@ -77,7 +78,10 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     void processIncomingStatReports();
     StatsPipe* getStatsPipeForThread();
     void onStatsPipeDestroyed(StatsPipe* pPipe);
+    void processDeadlineMisses();
+    // Writes a Chrome trace if the file name ends with .json, otherwise CSV
     void writeTimeline(const QString& filename);
+    void writeChromeTrace(const QString& filename);
 
     QAtomicInt m_emitAllStats;
     QAtomicInt m_quit;
@@ -85,6 +89,7 @@ class StatsManager : public QThread, public Singleton<StatsManager> {
     QMap<QString, Stat> m_baseStats;
     QMap<QString, Stat> m_experimentStats;
     QList<Event> m_events;
+    QList<CallbackProfiler::DeadlineMiss> m_deadlineMisses;
 
     QWaitCondition m_statsPipeCondition;
     QMutex m_statsPipeLock;
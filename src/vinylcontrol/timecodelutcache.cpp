@@ -0,0 +1,306 @@
+#include "vinylcontrol/timecodelutcache.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QtConcurrentRun>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include "timecoder.h"
+#else
+extern "C" {
+#include "timecoder.h"
+}
+#endif
+
+#include "util/assert.h"
+#include "util/logger.h"
+#include "util/timer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TimecodeLutCache");
+
+const quint32 kFileMagic = 0x54434c54; // "TCLT"
+// Increment whenever the layout of the file changes
+const quint32 kFileVersion = 1;
+
+struct LutFileHeader {
+    quint32 magic;
+    quint32 version;
+    // The parameters of the definition that determine the table
+    quint32 bits;
+    quint32 seed;
+    quint32 taps;
+    quint32 length;
+    quint32 hashes;
+    quint32 slotSize;
+    // Of the slots and the hash table that follow the header
+    quint64 checksum;
+};
+static_assert(sizeof(LutFileHeader) == 40, "Unexpected padding");
+static_assert(sizeof(struct slot) % sizeof(quint32) == 0, "Unexpected slot size");
+
+qint64 slotsBytes(const timecode_def& def) {
+    return static_cast<qint64>(sizeof(struct slot)) * def.length;
+}
+
+qint64 tableBytes() {
+    return static_cast<qint64>(sizeof(slot_no_t)) * LUT_HASHES;
+}
+
+LutFileHeader headerFor(const timecode_def& def) {
+    LutFileHeader header;
+    header.magic = kFileMagic;
+    header.version = kFileVersion;
+    header.bits = def.bits;
+    header.seed = def.seed;
+    header.taps = def.taps;
+    header.length = def.length;
+    header.hashes = LUT_HASHES;
+    header.slotSize = sizeof(struct slot);
+    header.checksum = 0;
+    return header;
+}
+
+// Fletcher-64, fast enough to validate the largest table in a few
+// milliseconds
+void updateChecksum(quint64* pSum1, quint64* pSum2, const void* pData, qint64 bytes) {
+    DEBUG_ASSERT(bytes % sizeof(quint32) == 0);
+    const quint32* pWords = static_cast<const quint32*>(pData);
+    const qint64 wordCount = bytes / sizeof(quint32);
+    quint64 sum1 = *pSum1;
+    quint64 sum2 = *pSum2;
+    for (qint64 i = 0; i < wordCount; ++i) {
+        sum1 += pWords[i];
+        sum2 += sum1;
+    }
+    *pSum1 = sum1;
+    *pSum2 = sum2;
+}
+
+quint64 lookupTableChecksum(const struct lut& lut, const timecode_def& def) {
+    quint64 sum1 = 0;
+    quint64 sum2 = 0;
+    updateChecksum(&sum1, &sum2, lut.slot, slotsBytes(def));
+    updateChecksum(&sum1, &sum2, lut.table, tableBytes());
+    return (sum2 << 32) ^ sum1;
+}
+
+struct BuildProgress {
+    TimecodeLutCache* pCache;
+    QString timecode;
+    unsigned int length;
+    int percent;
+};
+
+void reportBuildProgress(void* pData, unsigned int n) {
+    auto* pProgress = static_cast<BuildProgress*>(pData);
+    const int percent = static_cast<int>(100.0 * n / pProgress->length);
+    if (percent != pProgress->percent) {
+        pProgress->percent = percent;
+        emit pProgress->pCache->buildProgress(pProgress->timecode, percent);
+    }
+}
+
+} // anonymous namespace
+
+TimecodeLutCache::TimecodeLutCache() {
+    // One table after another
+    m_threadPool.setMaxThreadCount(1);
+}
+
+TimecodeLutCache::~TimecodeLutCache() {
+    m_threadPool.waitForDone();
+    freeLookupTables();
+}
+
+void TimecodeLutCache::setCacheDirPath(const QString& cacheDirPath) {
+    QMutexLocker locker(&m_mutex);
+    m_cacheDirPath = cacheDirPath;
+}
+
+QString TimecodeLutCache::cacheFilePath(const timecode_def& def) const {
+    if (m_cacheDirPath.isEmpty()) {
+        return QString();
+    }
+    return QDir(m_cacheDirPath).filePath(QString::fromLatin1(def.name) + QStringLiteral(".lut"));
+}
+
+bool TimecodeLutCache::attachLookupTable(timecode_def* pDef) {
+    VERIFY_OR_DEBUG_ASSERT(pDef) {
+        return false;
+    }
+    QMutexLocker locker(&m_mutex);
+    if (pDef->lookup) {
+        return true;
+    }
+    if (m_pendingDefs.contains(pDef)) {
+        return false;
+    }
+    // Even mapping and validating a file takes too long for the callers
+    m_pendingDefs.insert(pDef);
+    QtConcurrent::run(&m_threadPool,
+            this,
+            &TimecodeLutCache::prepareLookupTable,
+            pDef,
+            cacheFilePath(*pDef));
+    return false;
+}
+
+void TimecodeLutCache::freeLookupTables() {
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_attachedDefs.constBegin(); it != m_attachedDefs.constEnd(); ++it) {
+        timecode_def* pDef = it.key();
+        // Only frees tables that are not mapped from a file
+        lut_clear(&pDef->lut);
+        pDef->lookup = false;
+    }
+    // Unmaps the files
+    m_attachedDefs.clear();
+}
+
+std::unique_ptr<QFile> TimecodeLutCache::loadLookupTable(
+        const QString& filePath, timecode_def* pDef) {
+    if (filePath.isEmpty() || !QFileInfo::exists(filePath)) {
+        return nullptr;
+    }
+    PerformanceTimer timer;
+    timer.start();
+    std::unique_ptr<QFile> pFile = mapLookupTable(filePath, pDef);
+    if (pFile) {
+        kLogger.debug()
+                << "Mapped lookup table of" << pDef->name
+                << "in" << timer.elapsed().formatMillisWithUnit();
+    }
+    return pFile;
+}
+
+void TimecodeLutCache::prepareLookupTable(
+        timecode_def* pDef, const QString& filePath) {
+    const QString timecode = QString::fromLatin1(pDef->name);
+
+    // Map, build and write a private copy without holding the lock. The
+    // definition is only modified by attaching a table while it is
+    // pending, which only happens here.
+    timecode_def def = *pDef;
+    def.lookup = false;
+    std::unique_ptr<QFile> pFile = loadLookupTable(filePath, &def);
+    if (!pFile) {
+        PerformanceTimer timer;
+        timer.start();
+        BuildProgress progress{this, timecode, def.length, -1};
+        if (timecoder_build_lookup(&def, &reportBuildProgress, &progress) == -1) {
+            kLogger.warning() << "Failed to build the lookup table of" << timecode;
+            QMutexLocker locker(&m_mutex);
+            m_pendingDefs.remove(pDef);
+            return;
+        }
+        kLogger.info()
+                << "Built lookup table of" << timecode
+                << "in" << timer.elapsed().formatMillisWithUnit();
+        emit buildProgress(timecode, 100);
+        if (!filePath.isEmpty() && writeLookupTable(filePath, def)) {
+            timecode_def mappedDef = *pDef;
+            mappedDef.lookup = false;
+            pFile = loadLookupTable(filePath, &mappedDef);
+            if (pFile) {
+                // Keep the mapped table instead of the one in memory
+                lut_clear(&def.lut);
+                def.lut = mappedDef.lut;
+            }
+        }
+        // Otherwise keep the table in memory
+        def.lookup = true;
+    }
+    DEBUG_ASSERT(def.lookup);
+
+    QMutexLocker locker(&m_mutex);
+    pDef->lut = def.lut;
+    pDef->lookup = true;
+    m_attachedDefs.insert(pDef, QSharedPointer<QFile>(pFile.release()));
+    m_pendingDefs.remove(pDef);
+    locker.unlock();
+
+    emit lookupTableReady(timecode);
+}
+
+// static
+std::unique_ptr<QFile> TimecodeLutCache::mapLookupTable(
+        const QString& filePath, timecode_def* pDef) {
+    VERIFY_OR_DEBUG_ASSERT(pDef && !pDef->lookup) {
+        return nullptr;
+    }
+    auto pFile = std::make_unique<QFile>(filePath);
+    if (!pFile->open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    const qint64 fileSize =
+            static_cast<qint64>(sizeof(LutFileHeader)) + slotsBytes(*pDef) + tableBytes();
+    if (pFile->size() != fileSize) {
+        kLogger.warning() << "Unexpected size of" << filePath;
+        return nullptr;
+    }
+    uchar* pData = pFile->map(0, fileSize);
+    if (!pData) {
+        kLogger.warning() << "Failed to map" << filePath << pFile->errorString();
+        return nullptr;
+    }
+
+    LutFileHeader header;
+    memcpy(&header, pData, sizeof(header));
+    LutFileHeader expectedHeader = headerFor(*pDef);
+    expectedHeader.checksum = header.checksum;
+    if (memcmp(&header, &expectedHeader, sizeof(header)) != 0) {
+        kLogger.warning() << "Outdated lookup table" << filePath;
+        return nullptr;
+    }
+
+    struct lut lut;
+    lut_attach(&lut,
+            reinterpret_cast<struct slot*>(pData + sizeof(LutFileHeader)),
+            reinterpret_cast<slot_no_t*>(
+                    pData + sizeof(LutFileHeader) + slotsBytes(*pDef)),
+            pDef->length);
+    if (lookupTableChecksum(lut, *pDef) != header.checksum) {
+        kLogger.warning() << "Corrupt lookup table" << filePath;
+        return nullptr;
+    }
+    pDef->lut = lut;
+    pDef->lookup = true;
+    return pFile;
+}
+
+// static
+bool TimecodeLutCache::writeLookupTable(
+        const QString& filePath, const timecode_def& def) {
+    VERIFY_OR_DEBUG_ASSERT(def.lookup) {
+        return false;
+    }
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath())) {
+        kLogger.warning() << "Failed to create the directory of" << filePath;
+        return false;
+    }
+    // Replaces a previous file atomically
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning() << "Failed to write" << filePath << file.errorString();
+        return false;
+    }
+    LutFileHeader header = headerFor(def);
+    header.checksum = lookupTableChecksum(def.lut, def);
+    const bool success =
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ==
+                    static_cast<qint64>(sizeof(header)) &&
+            file.write(reinterpret_cast<const char*>(def.lut.slot), slotsBytes(def)) ==
+                    slotsBytes(def) &&
+            file.write(reinterpret_cast<const char*>(def.lut.table), tableBytes()) ==
+                    tableBytes() &&
+            file.commit();
+    if (!success) {
+        kLogger.warning() << "Failed to write" << filePath << file.errorString();
+    }
+    return success;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+
+#include "util/singleton.h"
+
+struct timecode_def;
+
+// Provides the lookup tables of the xwax timecode definitions, which map
+// the bitstream of a timecode to its position on the record.
+//
+// Building a table takes seconds for long timecodes. The tables are
+// therefore stored as files in a cache directory that are mapped into
+// memory on the next start, which only takes a few milliseconds for
+// validating the checksum. Both happen in the background while the
+// VinylControlXwax instances that need the tables are waiting.
+//
+// The tables are attached to the definitions and shared by all
+// VinylControlXwax instances until freeLookupTables() is called.
+class TimecodeLutCache : public QObject, public Singleton<TimecodeLutCache> {
+    Q_OBJECT
+  public:
+    // Without a directory the tables are built on every start
+    void setCacheDirPath(const QString& cacheDirPath);
+
+    // Returns true if the definition has a lookup table. Otherwise the
+    // table is mapped from its file or built in the background and false
+    // is returned until it has been attached. Thread-safe and never blocks
+    // on file I/O.
+    bool attachLookupTable(timecode_def* pDef);
+
+    // Detaches all lookup tables. Must only be called when no timecoder
+    // is using them anymore.
+    void freeLookupTables();
+
+    // Maps a file that has been written by writeLookupTable() and
+    // attaches it to the definition. Returns nullptr if the file does not
+    // exist, does not match the definition or is corrupt. The table is
+    // only valid as long as the returned file exists.
+    static std::unique_ptr<QFile> mapLookupTable(
+            const QString& filePath, timecode_def* pDef);
+    // The definition must have a lookup table
+    static bool writeLookupTable(
+            const QString& filePath, const timecode_def& def);
+
+  signals:
+    // Emitted from the thread that maps or builds the table
+    void buildProgress(QString timecode, int percent);
+    void lookupTableReady(QString timecode);
+
+  private:
+    TimecodeLutCache();
+    ~TimecodeLutCache() override;
+    friend class Singleton<TimecodeLutCache>;
+
+    QString cacheFilePath(const timecode_def& def) const;
+    static std::unique_ptr<QFile> loadLookupTable(
+            const QString& filePath, timecode_def* pDef);
+    // Maps the file or builds and writes the table and then attaches
+    // it. Runs in the thread pool.
+    void prepareLookupTable(timecode_def* pDef, const QString& filePath);
+
+    QString m_cacheDirPath;
+
+    // Guards the lookup tables of the definitions and all members
+    QMutex m_mutex;
+    QSet<timecode_def*> m_pendingDefs;
+    // Definitions with a lookup table and the file it is mapped from, if any
+    QHash<timecode_def*, QSharedPointer<QFile>> m_attachedDefs;
+
+    QThreadPool m_threadPool;
+};
@@ -0,0 +1,135 @@
+#include "vinylcontrol/vinylcontroldecoder.h"
+
+#include <QMutexLocker>
+#include <QtDebug>
+
+#include "util/defs.h"
+#include "util/sample.h"
+#include "util/stat.h"
+#include "util/time.h"
+#include "util/timer.h"
+#include "vinylcontrol/vinylcontrol.h"
+
+namespace {
+
+const int kSignalQualityFifoSize = 256;
+const int kSamplePipeFifoSize = 65536;
+
+const int kChannels = 2;
+
+} // anonymous namespace
+
+VinylControlDecoder::VinylControlDecoder(int index)
+        : m_index(index),
+          m_latencyStatKey(QString("VinylControlDecoder %1 latency").arg(index + 1)),
+          m_samplePipe(kSamplePipeFifoSize),
+          m_receivedNanos(0),
+          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
+          m_pVinylControl(nullptr),
+          m_signalQualityFifo(kSignalQualityFifoSize),
+          m_bReportSignalQuality(false),
+          m_bQuit(false),
+          m_latencyNanos(0),
+          m_decodedFrames(0) {
+}
+
+VinylControlDecoder::~VinylControlDecoder() {
+    shutdown();
+    wait();
+    SampleUtil::free(m_pWorkBuffer);
+}
+
+void VinylControlDecoder::shutdown() {
+    m_bQuit.store(true);
+    m_samplesAvailable.release();
+}
+
+VinylControl* VinylControlDecoder::replaceVinylControl(VinylControl* pVinylControl) {
+    QMutexLocker locker(&m_vinylControlMutex);
+    VinylControl* pPrevious = m_pVinylControl;
+    m_pVinylControl = pVinylControl;
+    return pPrevious;
+}
+
+void VinylControlDecoder::receiveSamples(
+        const CSAMPLE* pBuffer, unsigned int iNumFrames) {
+    const int nSamples = iNumFrames * kChannels;
+    const int samplesWritten = m_samplePipe.write(pBuffer, nSamples);
+    if (samplesWritten < nSamples) {
+        qWarning() << "ERROR: Buffer overflow in VinylControlDecoder. Dropping samples on the floor."
+                   << "VCIndex:" << m_index;
+    }
+    // Only the oldest pending samples determine the latency
+    qint64 noPendingSamples = 0;
+    m_receivedNanos.compare_exchange_strong(
+            noPendingSamples, mixxx::Time::elapsed().toIntegerNanos());
+    m_samplesAvailable.release();
+}
+
+void VinylControlDecoder::run() {
+    QThread::currentThread()->setObjectName(
+            QString("VinylControlDecoder %1").arg(m_index + 1));
+
+    while (true) {
+        m_samplesAvailable.acquire();
+        if (m_bQuit.load()) {
+            break;
+        }
+        // All buffers that have arrived in the meantime are decoded at once
+        m_samplesAvailable.tryAcquire(m_samplesAvailable.available());
+        decodeAvailableSamples();
+    }
+}
+
+void VinylControlDecoder::decodeAvailableSamples() {
+    const qint64 receivedNanos = m_receivedNanos.exchange(0);
+
+    QMutexLocker locker(&m_vinylControlMutex);
+    VinylControl* pVinylControl = m_pVinylControl;
+
+    quint64 framesRead = 0;
+    int samplesRead;
+    while ((samplesRead = m_samplePipe.read(m_pWorkBuffer, MAX_BUFFER_LEN)) > 0) {
+        if (samplesRead % kChannels != 0) {
+            qWarning() << "VinylControlDecoder received non-even number of samples via sample FIFO.";
+            samplesRead--;
+        }
+        const int frames = samplesRead / kChannels;
+        if (pVinylControl) {
+            pVinylControl->analyzeSamples(m_pWorkBuffer, frames);
+        }
+        framesRead += frames;
+    }
+    if (framesRead == 0) {
+        return;
+    }
+    if (!pVinylControl) {
+        // Samples are being written to a non-existent processor. Warning?
+        qWarning() << "Samples written to non-existent VinylControl processor:" << m_index;
+        return;
+    }
+
+    // The VinylControl has updated the rate and position controls
+    if (receivedNanos > 0) {
+        const qint64 latencyNanos =
+                mixxx::Time::elapsed().toIntegerNanos() - receivedNanos;
+        m_latencyNanos.store(latencyNanos);
+        Stat::track(m_latencyStatKey,
+                Stat::DURATION_NANOSEC,
+                kDefaultComputeFlags,
+                latencyNanos);
+    }
+    m_decodedFrames.fetch_add(framesRead);
+
+    // TODO(rryan) define a time-based update rate. This will update way
+    // too quickly.
+    if (m_bReportSignalQuality.load()) {
+        VinylSignalQualityReport report;
+        if (pVinylControl->writeQualityReport(&report)) {
+            report.processor = m_index;
+            if (m_signalQualityFifo.write(&report, 1) != 1) {
+                qWarning() << "VinylControlDecoder could not write signal quality report for VC index:" << m_index;
+            }
+        }
+    }
+}
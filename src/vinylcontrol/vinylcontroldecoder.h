@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+#include "util/duration.h"
+#include "util/fifo.h"
+#include "util/types.h"
+#include "vinylcontrol/vinylsignalquality.h"
+
+class VinylControl;
+
+// VinylControlDecoder is the thread that decodes the timecode of a single
+// vinyl control input. Each deck gets its own decoder so that decks with
+// long timecodes or high sample rates do not delay each other.
+//
+// Samples are handed over from the engine callback through a lock-free
+// FIFO. The decoder sleeps on a semaphore until the next buffer arrives.
+// The VinylControl is only locked while it is replaced, which never
+// happens in the engine callback.
+class VinylControlDecoder : public QThread {
+    Q_OBJECT
+  public:
+    explicit VinylControlDecoder(int index);
+    // Stops the thread and waits until it has finished
+    ~VinylControlDecoder() override;
+
+    int index() const {
+        return m_index;
+    }
+
+    // Called from the engine callback. Lock-free and not re-entrant.
+    void receiveSamples(const CSAMPLE* pBuffer, unsigned int iNumFrames);
+
+    // Replaces the VinylControl that decodes the samples and returns the
+    // previous one. Blocks while the previous one is analyzing samples,
+    // so the caller is free to delete it afterwards.
+    VinylControl* replaceVinylControl(VinylControl* pVinylControl);
+
+    void setSignalQualityReporting(bool enable) {
+        m_bReportSignalQuality.store(enable);
+    }
+
+    FIFO<VinylSignalQualityReport>* getSignalQualityFifo() {
+        return &m_signalQualityFifo;
+    }
+
+    // The time between the engine callback that delivered the oldest
+    // pending samples and the VinylControl having updated the controls
+    // of the deck after analyzing them.
+    mixxx::Duration latency() const {
+        return mixxx::Duration::fromNanos(m_latencyNanos.load());
+    }
+
+    // The number of frames that have been analyzed so far
+    quint64 decodedFrames() const {
+        return m_decodedFrames.load();
+    }
+
+    // Commands the thread to exit asap
+    void shutdown();
+
+  protected:
+    void run() override;
+
+  private:
+    void decodeAvailableSamples();
+
+    const int m_index;
+    const QString m_latencyStatKey;
+
+    // Written by the engine callback, read by the decoder thread
+    FIFO<CSAMPLE> m_samplePipe;
+    QSemaphore m_samplesAvailable;
+    // The time when the oldest samples in m_samplePipe have been received
+    // or 0 if there are no pending samples
+    std::atomic<qint64> m_receivedNanos;
+
+    CSAMPLE* m_pWorkBuffer;
+
+    // Guards m_pVinylControl against replacing it while it is analyzing
+    // samples. Never locked by the engine callback.
+    QMutex m_vinylControlMutex;
+    VinylControl* m_pVinylControl;
+
+    FIFO<VinylSignalQualityReport> m_signalQualityFifo;
+    std::atomic<bool> m_bReportSignalQuality;
+    std::atomic<bool> m_bQuit;
+
+    std::atomic<qint64> m_latencyNanos;
+    std::atomic<quint64> m_decodedFrames;
+};
@@ -6,6 +6,8 @@
 
 #include "vinylcontrol/vinylcontrolmanager.h"
 
+#include <QDir>
+
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
 #include "mixer/playermanager.h"
@@ -13,6 +15,7 @@
 #include "util/compatibility.h"
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
+#include "vinylcontrol/timecodelutcache.h"
 #include "vinylcontrol/vinylcontrol.h"
 #include "vinylcontrol/vinylcontrolprocessor.h"
 #include "vinylcontrol/vinylcontrolxwax.h"
@@ -22,10 +25,16 @@ VinylControlManager::VinylControlManager(QObject* pParent,
                                          SoundManager* pSoundManager)
         : QObject(pParent),
           m_pConfig(pConfig),
-          m_pProcessor(new VinylControlProcessor(this, pConfig)),
+          m_pProcessor(nullptr),
           m_iTimerId(-1),
           m_pNumDecks(nullptr),
           m_iNumConfiguredDecks(0) {
+    // The timecode lookup tables are shared by all decks and must exist
+    // before the processor creates any VinylControlXwax
+    TimecodeLutCache::createInstance()->setCacheDirPath(
+            QDir(pConfig->getSettingsPath()).filePath("timecodes"));
+    m_pProcessor = new VinylControlProcessor(this, pConfig);
+
     // Register every possible VC input with SoundManager to route to the
     // VinylControlProcessor.
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
@@ -36,6 +45,7 @@ VinylControlManager::VinylControlManager(QObject* pParent,
 
 VinylControlManager::~VinylControlManager() {
     delete m_pProcessor;
+    TimecodeLutCache::destroy();
 
     // save a bunch of stuff to config
     // turn off vinyl control so it won't be enabled on load (this is redundant to mixxx.cpp)
@@ -158,15 +168,18 @@ void VinylControlManager::removeSignalQualityListener(VinylSignalQualityListener
 }
 
 void VinylControlManager::updateSignalQualityListeners() {
-    FIFO<VinylSignalQualityReport>* signalQualityFifo = m_pProcessor->getSignalQualityFifo();
-    if (signalQualityFifo == NULL) {
-        return;
-    }
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        FIFO<VinylSignalQualityReport>* signalQualityFifo =
+                m_pProcessor->getSignalQualityFifo(i);
+        if (signalQualityFifo == NULL) {
+            continue;
+        }
 
-    VinylSignalQualityReport report;
-    while (signalQualityFifo->read(&report, 1) == 1) {
-        foreach (VinylSignalQualityListener* pListener, m_listeners) {
-            pListener->onVinylSignalQualityUpdate(report);
+        VinylSignalQualityReport report;
+        while (signalQualityFifo->read(&report, 1) == 1) {
+            foreach (VinylSignalQualityListener* pListener, m_listeners) {
+                pListener->onVinylSignalQualityUpdate(report);
+            }
         }
     }
 }
@@ -3,28 +3,21 @@
 #include "vinylcontrol/vinylcontrolprocessor.h"
 
 #include "control/controlpushbutton.h"
+#include "util/assert.h"
 #include "util/defs.h"
 #include "util/event.h"
-#include "util/sample.h"
 #include "util/timer.h"
 #include "vinylcontrol/defs_vinylcontrol.h"
 #include "vinylcontrol/vinylcontrol.h"
+#include "vinylcontrol/vinylcontroldecoder.h"
 #include "vinylcontrol/vinylcontrolxwax.h"
 
-#define SIGNAL_QUALITY_FIFO_SIZE 256
-#define SAMPLE_PIPE_FIFO_SIZE 65536
-
 VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPointer pConfig)
-        : QThread(pParent),
+        : QObject(pParent),
           m_pConfig(pConfig),
           m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
-          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_processorsLock(QMutex::Recursive),
-          m_processors(kMaximumVinylControlInputs, NULL),
-          m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
-          m_bReportSignalQuality(false),
-          m_bQuit(false),
-          m_bReloadConfig(false) {
+          m_processors(kMaximumVinylControlInputs, NULL) {
     connect(m_pToggle,
             &ControlPushButton::valueChanged,
             this,
@@ -32,19 +25,19 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
             Qt::DirectConnection);
 
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        m_samplePipes[i] = new FIFO<CSAMPLE>(SAMPLE_PIPE_FIFO_SIZE);
+        m_decoders[i] = new VinylControlDecoder(i);
+        m_decoders[i]->start(QThread::HighPriority);
     }
-
-    start(QThread::HighPriority);
 }
 
 VinylControlProcessor::~VinylControlProcessor() {
-    m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
-    wait();
+    // Waits until the decoders have finished
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        delete m_decoders[i];
+        m_decoders[i] = NULL;
+    }
 
     delete m_pToggle;
-    SampleUtil::free(m_pWorkBuffer);
 
     {
         QMutexLocker locker(&m_processorsLock);
@@ -52,9 +45,6 @@ VinylControlProcessor::~VinylControlProcessor() {
             VinylControl* pProcessor = m_processors.at(i);
             m_processors[i] = NULL;
             delete pProcessor;
-
-            delete m_samplePipes[i];
-            m_samplePipes[i] = NULL;
         }
     }
 
@@ -64,93 +54,45 @@ VinylControlProcessor::~VinylControlProcessor() {
 }
 
 void VinylControlProcessor::setSignalQualityReporting(bool enable) {
-    m_bReportSignalQuality = enable;
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_decoders[i]->setSignalQualityReporting(enable);
+    }
 }
 
 void VinylControlProcessor::shutdown() {
-    m_bQuit = true;
-    m_samplesAvailableSignal.wakeAll();
-}
-
-void VinylControlProcessor::requestReloadConfig() {
-    m_bReloadConfig = true;
-    m_samplesAvailableSignal.wakeAll();
-}
-
-void VinylControlProcessor::run() {
-    unsigned static id = 0; //the id of this thread, for debugging purposes //XXX copypasta (should factor this out somehow), -kousu 2/2009
-    QThread::currentThread()->setObjectName(QString("VinylControlProcessor %1").arg(++id));
-
-    while (!m_bQuit) {
-        if (m_bReloadConfig) {
-            reloadConfig();
-            m_bReloadConfig = false;
-        }
-
-        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-            QMutexLocker locker(&m_processorsLock);
-            VinylControl* pProcessor = m_processors[i];
-            locker.unlock();
-            FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
-
-            if (pSamplePipe->readAvailable() > 0) {
-                int samplesRead = pSamplePipe->read(m_pWorkBuffer, MAX_BUFFER_LEN);
-
-                if (samplesRead % 2 != 0) {
-                    qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
-                    samplesRead--;
-                }
-                int framesRead = samplesRead / 2;
-
-                if (pProcessor) {
-                    pProcessor->analyzeSamples(m_pWorkBuffer, framesRead);
-                } else {
-                    // Samples are being written to a non-existent processor. Warning?
-                    qWarning() << "Samples written to non-existent VinylControl processor:" << i;
-                }
-            }
-
-            // TODO(rryan) define a time-based update rate. This will update way
-            // too quickly.
-            if (pProcessor && m_bReportSignalQuality) {
-                VinylSignalQualityReport report;
-                if (pProcessor->writeQualityReport(&report)) {
-                    report.processor = i;
-                    if (m_signalQualityFifo.write(&report, 1) != 1) {
-                        qWarning() << "VinylControlProcessor could not write signal quality report for VC index:" << i;
-                    }
-                }
-            }
-        }
-
-        if (m_bQuit) {
-            break;
-        }
-
-        // Wait for a signal from the main thread or engine thread that we
-        // should wake up and process input.
-        m_waitForSampleMutex.lock();
-        m_samplesAvailableSignal.wait(&m_waitForSampleMutex);
-        m_waitForSampleMutex.unlock();
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        m_decoders[i]->shutdown();
     }
 }
 
-void VinylControlProcessor::reloadConfig() {
+void VinylControlProcessor::requestReloadConfig() {
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-        QMutexLocker locker(&m_processorsLock);
-        VinylControl* pCurrent = m_processors[i];
-
-        if (pCurrent == NULL) {
+        if (!deckConfigured(i)) {
             continue;
         }
+        replaceProcessor(i, new VinylControlXwax(m_pConfig, kVCGroup.arg(i + 1)));
+    }
+}
 
-        VinylControl *pNew = new VinylControlXwax(
-            m_pConfig, kVCGroup.arg(i + 1));
-        m_processors.replace(i, pNew);
-        locker.unlock();
-        // Delete outside of the critical section to avoid deadlocks.
-        delete pCurrent;
+FIFO<VinylSignalQualityReport>* VinylControlProcessor::getSignalQualityFifo(int index) {
+    VERIFY_OR_DEBUG_ASSERT(index >= 0 && index < kMaximumVinylControlInputs) {
+        return NULL;
     }
+    return m_decoders[index]->getSignalQualityFifo();
+}
+
+void VinylControlProcessor::replaceProcessor(int index, VinylControl* pNew) {
+    QMutexLocker locker(&m_processorsLock);
+    VinylControl* pCurrent = m_processors.at(index);
+    m_processors.replace(index, pNew);
+    locker.unlock();
+    // Blocks until the decoder has finished analyzing samples with the
+    // current processor.
+    VinylControl* pPrevious = m_decoders[index]->replaceVinylControl(pNew);
+    DEBUG_ASSERT(pPrevious == pCurrent);
+    Q_UNUSED(pPrevious);
+    // Delete outside of the critical section to avoid deadlocks.
+    delete pCurrent;
 }
 
 void VinylControlProcessor::onInputConfigured(AudioInput input) {
@@ -166,15 +108,7 @@ void VinylControlProcessor::onInputConfigured(AudioInput input) {
         return;
     }
 
-    VinylControl *pNew = new VinylControlXwax(
-        m_pConfig, kVCGroup.arg(index + 1));
-
-    QMutexLocker locker(&m_processorsLock);
-    VinylControl* pCurrent = m_processors.at(index);
-    m_processors.replace(index, pNew);
-    locker.unlock();
-    // Delete outside of the critical section to avoid deadlocks.
-    delete pCurrent;
+    replaceProcessor(index, new VinylControlXwax(m_pConfig, kVCGroup.arg(index + 1)));
 }
 
 void VinylControlProcessor::onInputUnconfigured(AudioInput input) {
@@ -191,12 +125,7 @@ void VinylControlProcessor::onInputUnconfigured(AudioInput input) {
         return;
     }
 
-    QMutexLocker locker(&m_processorsLock);
-    VinylControl* pVC = m_processors.at(index);
-    m_processors.replace(index, NULL);
-    locker.unlock();
-    // Delete outside of the critical section to avoid deadlocks.
-    delete pVC;
+    replaceProcessor(index, NULL);
 }
 
 bool VinylControlProcessor::deckConfigured(int index) const {
@@ -219,23 +148,14 @@ void VinylControlProcessor::receiveBuffer(AudioInput input,
         return;
     }
 
-    FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[vcIndex];
+    VinylControlDecoder* pDecoder = m_decoders[vcIndex];
 
-    if (pSamplePipe == NULL) {
+    if (pDecoder == NULL) {
         // Should not be possible.
         return;
     }
 
-    const int kChannels = 2;
-    const int nSamples = nFrames * kChannels;
-    int samplesWritten = pSamplePipe->write(pBuffer, nSamples);
-
-    if (samplesWritten < nSamples) {
-        qWarning() << "ERROR: Buffer overflow in VinylControlProcessor. Dropping samples on the floor."
-                   << "VCIndex:" << vcIndex;
-    }
-
-    m_samplesAvailableSignal.wakeAll();
+    pDecoder->receiveSamples(pBuffer, nFrames);
 }
 
 void VinylControlProcessor::toggleDeck(double value) {
@@ -23,6 +23,7 @@
 #include <limits.h>
 
 #include "vinylcontrol/vinylcontrolxwax.h"
+#include "vinylcontrol/timecodelutcache.h"
 #include "util/timer.h"
 #include "control/controlproxy.h"
 #include "control/controlobject.h"
@@ -41,9 +42,6 @@
 // Sample threshold below which we consider there to be no signal.
 const double kMinSignal = 75.0 / SAMPLE_MAX;
 
-bool VinylControlXwax::s_bLUTInitialized = false;
-QMutex VinylControlXwax::s_xwaxLUTMutex;
-
 VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
         : VinylControl(pConfig, group),
           m_dVinylPositionOld(0.0),
@@ -74,7 +72,11 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
           m_dLastTrackSelectPos(0.0),
           m_dCurTrackSelectPos(0.0),
           m_dDriftAmt(0.0),
-          m_dUiUpdateTime(-1.0) {
+          m_dUiUpdateTime(-1.0),
+          m_pTimecodeDef(NULL),
+          m_dSpeed(1.0),
+          m_iSampleRate(0),
+          m_bTimecoderInitialized(false) {
     // TODO(rryan): Should probably live in VinylControlManager since it's not
     // specific to a VC deck.
     signalenabled->slotSet(m_pConfig->getValueString(
@@ -122,18 +124,17 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
     }
 
 
-    timecode_def* tc_def = timecoder_find_definition(timecode);
-    if (tc_def == NULL) {
+    m_pTimecodeDef = timecoder_match_definition(timecode);
+    if (m_pTimecodeDef == NULL) {
         qDebug() << "Error finding timecode definition for " << timecode << ", defaulting to serato_2a";
         timecode = (char*)"serato_2a";
-        tc_def = timecoder_find_definition(timecode);
+        m_pTimecodeDef = timecoder_match_definition(timecode);
     }
 
-    double speed = 1.0;
     double rpm = 100.0 / 3.0;
     if (strVinylSpeed == MIXXX_VINYL_SPEED_45) {
         rpm = 45.0;
-        speed = 1.35;
+        m_dSpeed = 1.35;
     }
 
     double latency = ControlObject::get(
@@ -143,7 +144,7 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
         latency = 20;
     }
 
-    int iSampleRate = m_pConfig->getValueString(
+    m_iSampleRate = m_pConfig->getValueString(
         ConfigKey("[Soundcard]","Samplerate")).toULong();
 
     // Set pitch ring size to 1/4 of one revolution -- a full revolution adds
@@ -151,23 +152,28 @@ VinylControlXwax::VinylControlXwax(UserSettingsPointer pConfig, QString group)
     m_iPitchRingSize = static_cast<int>(60000 / (rpm * latency * 4));
     m_pPitchRing = new double[m_iPitchRingSize];
 
-    qDebug() << "Xwax Vinyl control starting with a sample rate of:" << iSampleRate;
-    qDebug() << "Building timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
+    qDebug() << "Xwax Vinyl control starting with a sample rate of:" << m_iSampleRate;
+    qDebug() << "Preparing timecode lookup tables for" << strVinylType << "with speed" << strVinylSpeed;
 
-    // Initialize the timecoder structure. Use the static mutex so that we only
-    // do this once across the VinylControlXwax instances.
-    s_xwaxLUTMutex.lock();
+    // The timecoder is initialized as soon as the lookup table of the
+    // timecode is available, which might be built in the background.
+    if (!initTimecoder()) {
+        qDebug() << "Waiting for the timecode lookup table of" << timecode;
+    }
 
-    timecoder_init(&timecoder, tc_def, speed, iSampleRate, /* phono */ false);
+    qDebug() << "Starting vinyl control xwax thread";
+}
+
+bool VinylControlXwax::initTimecoder() {
+    DEBUG_ASSERT(!m_bTimecoderInitialized);
+    if (!TimecodeLutCache::instance()->attachLookupTable(m_pTimecodeDef)) {
+        return false;
+    }
+    timecoder_init(&timecoder, m_pTimecodeDef, m_dSpeed, m_iSampleRate, /* phono */ false);
     timecoder_monitor_init(&timecoder, MIXXX_VINYL_SCOPE_SIZE);
-    //Note that timecoder_init will not double-malloc the LUTs, and after this we are guaranteed
-    //that the LUT has been generated unless we ran out of memory.
-    s_bLUTInitialized = true;
     m_uiSafeZone = timecoder_get_safe(&timecoder);
-    //}
-    s_xwaxLUTMutex.unlock();
-
-    qDebug() << "Starting vinyl control xwax thread";
+    m_bTimecoderInitialized = true;
+    return true;
 }
 
 VinylControlXwax::~VinylControlXwax() {
@@ -177,29 +183,23 @@ VinylControlXwax::~VinylControlXwax() {
     delete [] m_pWorkBuffer;
 
     // Cleanup xwax nicely
-    timecoder_monitor_clear(&timecoder);
-    timecoder_clear(&timecoder);
-
-    // TODO(rryan): This looks wrong. freeLUTs is called later by
-    // VinylControlProcessor so we are probably leaking the LUTs.
-    s_bLUTInitialized = false;
+    if (m_bTimecoderInitialized) {
+        timecoder_monitor_clear(&timecoder);
+        timecoder_clear(&timecoder);
+    }
 
     m_pVCRate->set(0.0);
 }
 
 //static
 void VinylControlXwax::freeLUTs() {
-    s_xwaxLUTMutex.lock(); //Static mutex! We don't want two threads doing this!
-    if (s_bLUTInitialized) {
-        timecoder_free_lookup(); //Frees all the LUTs in xwax.
-        s_bLUTInitialized = false;
-    }
-    s_xwaxLUTMutex.unlock();
+    // The lookup tables are shared by all instances
+    TimecodeLutCache::instance()->freeLookupTables();
 }
 
 
 bool VinylControlXwax::writeQualityReport(VinylSignalQualityReport* pReport) {
-    if (pReport) {
+    if (pReport && m_bTimecoderInitialized) {
         pReport->timecode_quality = m_fTimecodeQuality;
         pReport->angle = getAngle();
         memcpy(pReport->scope, timecoder.mon, sizeof(pReport->scope));
@@ -211,6 +211,10 @@ bool VinylControlXwax::writeQualityReport(VinylSignalQualityReport* pReport) {
 
 void VinylControlXwax::analyzeSamples(CSAMPLE* pSamples, size_t nFrames) {
     ScopedTimer t("VinylControlXwax::analyzeSamples");
+    if (!m_bTimecoderInitialized && !initTimecoder()) {
+        // The lookup table is still being built
+        return;
+    }
     CSAMPLE gain = m_pVinylControlInputGain->get();
     const int kChannels = 2;
 
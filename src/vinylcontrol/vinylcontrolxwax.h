@@ -34,6 +34,8 @@ class VinylControlXwax : public VinylControl {
     float getAngle();
 
   private:
+    // Returns false while the lookup table of the timecode is not available
+    bool initTimecoder();
     void syncPosition();
     void togglePlayButton(bool on);
     bool checkEnabled(bool was, bool is);
@@ -132,12 +134,16 @@ class VinylControlXwax : public VinylControl {
     // with updates.
     double m_dUiUpdateTime;
 
+    // The timecode and the parameters of the timecoder, which is initialized
+    // once the lookup table of the timecode is available.
+    timecode_def* m_pTimecodeDef;
+    double m_dSpeed;
+    unsigned int m_iSampleRate;
+    bool m_bTimecoderInitialized;
+
     // Contains information that xwax's code needs internally about the timecode
     // and how to process it.
     struct timecoder timecoder;
-    // Static mutex that protects our creation/destruction of the xwax LUTs
-    static QMutex s_xwaxLUTMutex;
-    static bool s_bLUTInitialized;
 };
 
 #endif
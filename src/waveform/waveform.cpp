@@ -1,4 +1,6 @@
+#include <QDataStream>
 #include <QtDebug>
+#include <cstring>
 
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
@@ -7,6 +9,21 @@ using namespace mixxx::track;
 
 const int kNumChannels = 2;
 
+// The header of a blob is followed by the texture without any conversion.
+// All values of the header are little endian.
+//
+//   char[4] magic
+//   quint32 version
+//   qint32  dataSize
+//   qint32  textureStride
+//   double  visualSampleRate
+//   double  audioVisualRatio
+const char kBlobMagic[4] = {'M', 'X', 'W', 'F'};
+const quint32 kBlobVersion = 1;
+const int kBlobHeaderSize = 32;
+// Limits the texture of a blob to 1 GB
+const int kMaxBlobDataSize = 1 << 28;
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -21,6 +38,8 @@ Waveform::Waveform(const QByteArray data)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
+          m_pData(nullptr),
+          m_textureSize(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(computeTextureStride(0)),
@@ -28,11 +47,29 @@ Waveform::Waveform(const QByteArray data)
     readByteArray(data);
 }
 
+Waveform::Waveform(const QByteArray& blob, std::shared_ptr<const void> pBlobOwner)
+        : m_id(-1),
+          m_saveState(SaveState::NotSaved),
+          m_dataSize(0),
+          m_pData(nullptr),
+          m_textureSize(0),
+          m_visualSampleRate(0),
+          m_audioVisualRatio(0),
+          m_textureStride(computeTextureStride(0)),
+          m_completion(-1) {
+    readBlob(blob);
+    if (m_pData) {
+        m_pBlobOwner = std::move(pBlobOwner);
+    }
+}
+
 Waveform::Waveform(int audioSampleRate, int audioSamples,
                    int desiredVisualSampleRate, int maxVisualSamples)
         : m_id(-1),
           m_saveState(SaveState::NotSaved),
           m_dataSize(0),
+          m_pData(nullptr),
+          m_textureSize(0),
           m_visualSampleRate(0),
           m_audioVisualRatio(0),
           m_textureStride(1024),
@@ -108,7 +145,7 @@ QByteArray Waveform::toByteArray() const {
 
     int dataSize = getDataSize();
     for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
+        const WaveformData& datum = get(i);
         all->add_value(datum.filtered.all);
         low->add_value(datum.filtered.low);
         mid->add_value(datum.filtered.mid);
@@ -126,6 +163,86 @@ QByteArray Waveform::toByteArray() const {
     return QByteArray(output.data(), output.length());
 }
 
+QByteArray Waveform::toBlob() const {
+    const int dataBytes = getDataSize() * static_cast<int>(sizeof(WaveformData));
+    const int textureBytes = getTextureSize() * static_cast<int>(sizeof(WaveformData));
+    QByteArray blob;
+    blob.reserve(kBlobHeaderSize + textureBytes);
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    stream.writeRawData(kBlobMagic, sizeof(kBlobMagic));
+    stream << kBlobVersion
+           << static_cast<qint32>(getDataSize())
+           << static_cast<qint32>(m_textureStride)
+           << m_visualSampleRate
+           << m_audioVisualRatio;
+    DEBUG_ASSERT(blob.size() == kBlobHeaderSize);
+
+    // The padding of the texture is not necessarily initialized
+    blob.append(reinterpret_cast<const char*>(m_pData), dataBytes);
+    blob.append(textureBytes - dataBytes, '\0');
+    return blob;
+}
+
+void Waveform::readBlob(const QByteArray& blob) {
+    if (blob.size() < kBlobHeaderSize) {
+        qDebug() << "ERROR: Waveform blob is too short:" << blob.size();
+        return;
+    }
+
+    QDataStream stream(QByteArray::fromRawData(blob.constData(), kBlobHeaderSize));
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    char magic[sizeof(kBlobMagic)];
+    quint32 version = 0;
+    qint32 dataSize = 0;
+    qint32 textureStride = 0;
+    double visualSampleRate = 0;
+    double audioVisualRatio = 0;
+    stream.readRawData(magic, sizeof(magic));
+    stream >> version >> dataSize >> textureStride
+           >> visualSampleRate >> audioVisualRatio;
+
+    if (std::memcmp(magic, kBlobMagic, sizeof(kBlobMagic)) != 0 ||
+            version != kBlobVersion) {
+        qDebug() << "ERROR: Unsupported waveform blob version" << version;
+        return;
+    }
+    if (dataSize < 0 || dataSize > kMaxBlobDataSize ||
+            textureStride != computeTextureStride(dataSize) ||
+            !(visualSampleRate > 0) || !(audioVisualRatio > 0)) {
+        qDebug() << "ERROR: Invalid waveform blob header:"
+                 << "dataSize" << dataSize
+                 << "textureStride" << textureStride
+                 << "visualSampleRate" << visualSampleRate
+                 << "audioVisualRatio" << audioVisualRatio;
+        return;
+    }
+    const int textureSize = textureStride * textureStride;
+    if (blob.size() - kBlobHeaderSize !=
+            textureSize * static_cast<int>(sizeof(WaveformData))) {
+        qDebug() << "ERROR: Waveform blob of size" << blob.size()
+                 << "does not match its texture size" << textureSize;
+        return;
+    }
+    const char* pTexture = blob.constData() + kBlobHeaderSize;
+    VERIFY_OR_DEBUG_ASSERT(
+            reinterpret_cast<quintptr>(pTexture) % alignof(WaveformData) == 0) {
+        return;
+    }
+
+    m_blob = blob;
+    m_pData = reinterpret_cast<const WaveformData*>(pTexture);
+    m_dataSize = dataSize;
+    m_textureStride = textureStride;
+    m_textureSize = textureSize;
+    m_visualSampleRate = visualSampleRate;
+    m_audioVisualRatio = audioVisualRatio;
+    m_completion = dataSize;
+    m_saveState = SaveState::Saved;
+}
+
 void Waveform::readByteArray(const QByteArray& data) {
     if (data.isNull()) {
         return;
@@ -201,12 +318,16 @@ void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    m_pData = m_data.data();
+    m_textureSize = static_cast<int>(m_data.size());
 }
 
 void Waveform::assign(int size, int value) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, value);
+    m_pData = m_data.data();
+    m_textureSize = static_cast<int>(m_data.size());
     m_saveState = SaveState::SavePending;
 }
 
@@ -1,6 +1,7 @@
 #ifndef WAVEFORM_H
 #define WAVEFORM_H
 
+#include <memory>
 #include <vector>
 
 #include <QMutex>
@@ -10,6 +11,7 @@
 #include <QSharedPointer>
 #include <QMutexLocker>
 
+#include "util/assert.h"
 #include "util/class.h"
 #include "util/compatibility.h"
 
@@ -37,7 +39,12 @@ class Waveform {
         Saved
     };
 
+    // Parses the serialized protobuf of toByteArray()
     explicit Waveform(const QByteArray pData = QByteArray());
+    // Refers to the data of a blob written by toBlob() without copying or
+    // parsing it. If the blob does not own its data, e.g. if it has been
+    // mapped into memory, pBlobOwner must keep the data alive.
+    Waveform(const QByteArray& blob, std::shared_ptr<const void> pBlobOwner);
     Waveform(int audioSampleRate, int audioSamples,
              int desiredVisualSampleRate, int maxVisualSamples);
 
@@ -74,6 +81,8 @@ class Waveform {
     }
 
     QByteArray toByteArray() const;
+    // A header followed by the texture as it is used by the renderers
+    QByteArray toBlob() const;
 
     // We do not lock the mutex since m_dataSize and m_visualSampleRate are not
     // changed after the constructor runs.
@@ -110,33 +119,37 @@ class Waveform {
     // the constructor runs.
     inline int getTextureStride() const { return m_textureStride; }
 
-    // We do not lock the mutex since m_data is not resized after the
+    // We do not lock the mutex since the texture is not resized after the
     // constructor runs.
-    inline int getTextureSize() const { return static_cast<int>(m_data.size()); }
+    inline int getTextureSize() const { return m_textureSize; }
 
     // Atomically get the number of data elements in this Waveform. We do not
     // lock the mutex since m_dataSize is not changed after the constructor
     // runs.
     inline int getDataSize() const { return m_dataSize; }
 
-    inline const WaveformData& get(int i) const { return m_data[i];}
-    inline unsigned char getLow(int i) const { return m_data[i].filtered.low;}
-    inline unsigned char getMid(int i) const { return m_data[i].filtered.mid;}
-    inline unsigned char getHigh(int i) const { return m_data[i].filtered.high;}
-    inline unsigned char getAll(int i) const { return m_data[i].filtered.all;}
+    inline const WaveformData& get(int i) const { return m_pData[i];}
+    inline unsigned char getLow(int i) const { return m_pData[i].filtered.low;}
+    inline unsigned char getMid(int i) const { return m_pData[i].filtered.mid;}
+    inline unsigned char getHigh(int i) const { return m_pData[i].filtered.high;}
+    inline unsigned char getAll(int i) const { return m_pData[i].filtered.all;}
 
     // We do not lock the mutex since m_data is not resized after the
-    // constructor runs.
-    WaveformData* data() { return &m_data[0];}
+    // constructor runs. Waveforms that refer to a blob are read-only.
+    WaveformData* data() {
+        DEBUG_ASSERT(m_blob.isNull());
+        return m_data.data();
+    }
 
-    // We do not lock the mutex since m_data is not resized after the
+    // We do not lock the mutex since the texture is not resized after the
     // constructor runs.
-    const WaveformData* data() const { return &m_data[0];}
+    const WaveformData* data() const { return m_pData;}
 
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readBlob(const QByteArray& blob);
     void resize(int size);
     void assign(int size, int value = 0);
 
@@ -165,6 +178,15 @@ class Waveform {
     // TODO(XXX): In the future we should switch to QVector and use the raw data
     // pointer when performance matters.
     std::vector<WaveformData> m_data;
+    // A blob that is referred to instead of m_data and the owner of its data
+    QByteArray m_blob;
+    std::shared_ptr<const void> m_pBlobOwner;
+    // Points to the texture in either m_data or m_blob. Not allowed to change
+    // after the constructor runs.
+    const WaveformData* m_pData;
+    // The number of elements of the texture. Not allowed to change after the
+    // constructor runs.
+    int m_textureSize;
     // Not allowed to change after the constructor runs.
     double m_visualSampleRate;
     // Not allowed to change after the constructor runs.
@@ -6,13 +6,49 @@
 // static
 Waveform* WaveformFactory::loadWaveformFromAnalysis(
         const AnalysisDao::AnalysisInfo& analysis) {
-    Waveform* pWaveform = new Waveform(analysis.data);
+    Waveform* pWaveform;
+    if (analysis.storageFormat == AnalysisDao::STORAGE_MAPPED) {
+        pWaveform = new Waveform(analysis.data, analysis.pMappedFile);
+    } else {
+        pWaveform = new Waveform(analysis.data);
+    }
     pWaveform->setId(analysis.analysisId);
     pWaveform->setVersion(analysis.version);
     pWaveform->setDescription(analysis.description);
     return pWaveform;
 }
 
+// static
+Waveform* WaveformFactory::convertWaveformFromAnalysis(
+        AnalysisDao* pAnalysisDao,
+        const AnalysisDao::AnalysisInfo& analysis) {
+    Waveform* pWaveform = loadWaveformFromAnalysis(analysis);
+    if (!pWaveform->isValid()) {
+        return pWaveform;
+    }
+
+    AnalysisDao::AnalysisInfo converted = analysis;
+    if (analysis.type == AnalysisDao::TYPE_WAVESUMMARY) {
+        converted.version = currentWaveformSummaryVersion();
+        converted.description = currentWaveformSummaryDescription();
+    } else {
+        converted.version = currentWaveformVersion();
+        converted.description = currentWaveformDescription();
+    }
+    converted.storageFormat = AnalysisDao::STORAGE_MAPPED;
+    converted.data = pWaveform->toBlob();
+    converted.pMappedFile.reset();
+    // Replaces the file of the analysis, which has been read completely
+    if (pAnalysisDao->saveAnalysis(&converted)) {
+        pWaveform->setVersion(converted.version);
+        pWaveform->setDescription(converted.description);
+    } else {
+        qWarning() << "Failed to convert analysis" << analysis.analysisId
+                   << "from version" << analysis.version;
+    }
+    return pWaveform;
+}
+
 // static
 WaveformFactory::VersionClass WaveformFactory::waveformVersionToVersionClass(const QString& version) {
     if (version == WAVEFORM_CURRENT_VERSION) {
@@ -20,6 +56,11 @@ WaveformFactory::VersionClass WaveformFactory::waveformVersionToVersionClass(con
         return VC_USE;
     }
 
+    if (version == WAVEFORM_5_VERSION) {
+        // Used in Mixxx 2.2, same data but slow to load
+        return VC_CONVERT;
+    }
+
     if (version == WAVEFORM_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
@@ -46,6 +87,11 @@ WaveformFactory::VersionClass WaveformFactory::waveformSummaryVersionToVersionCl
         return VC_USE;
     }
 
+    if (version == WAVEFORMSUMMARY_5_VERSION) {
+        // Used in Mixxx 2.2, same data but slow to load
+        return VC_CONVERT;
+    }
+
     if (version == WAVEFORMSUMMARY_4_VERSION) {
         // Used in Mixxx 1.12 beta, suffers Bug lp:1406389
         return VC_REMOVE;
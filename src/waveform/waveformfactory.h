@@ -28,22 +28,35 @@ class Waveform;
 #define WAVEFORM_5_DESCRIPTION "Waveform 5.0"
 #define WAVEFORMSUMMARY_5_DESCRIPTION "WaveformSummary 5.0"
 
-#define WAVEFORM_CURRENT_VERSION WAVEFORM_5_VERSION
-#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_5_VERSION
-#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_5_DESCRIPTION
-#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_5_DESCRIPTION
+// Used from Mixxx 2.3 alpha, mapped blobs instead of compressed protobufs
+#define WAVEFORM_6_VERSION "Waveform-6.0"
+#define WAVEFORMSUMMARY_6_VERSION "WaveformSummary-6.0"
+#define WAVEFORM_6_DESCRIPTION "Waveform 6.0"
+#define WAVEFORMSUMMARY_6_DESCRIPTION "WaveformSummary 6.0"
+
+#define WAVEFORM_CURRENT_VERSION WAVEFORM_6_VERSION
+#define WAVEFORMSUMMARY_CURRENT_VERSION WAVEFORMSUMMARY_6_VERSION
+#define WAVEFORM_CURRENT_DESCRIPTION WAVEFORM_6_DESCRIPTION
+#define WAVEFORMSUMMARY_CURRENT_DESCRIPTION WAVEFORMSUMMARY_6_DESCRIPTION
 
 
 class WaveformFactory {
   public:
     enum VersionClass {
         VC_USE,
+        // Use, but store again in the current version
+        VC_CONVERT,
         VC_KEEP,
         VC_REMOVE
     };
 
     static Waveform* loadWaveformFromAnalysis(
             const AnalysisDao::AnalysisInfo& analysis);
+    // Loads an analysis of version class VC_CONVERT and replaces it with
+    // the current version.
+    static Waveform* convertWaveformFromAnalysis(
+            AnalysisDao* pAnalysisDao,
+            const AnalysisDao::AnalysisInfo& analysis);
     static VersionClass waveformVersionToVersionClass(const QString& version);
     static VersionClass waveformSummaryVersionToVersionClass(const QString& version);
     static QString currentWaveformVersion();
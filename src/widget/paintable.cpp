@@ -3,14 +3,23 @@
 
 #include <QDir>
 #include <QString>
+#include <QTransform>
 #include <QtDebug>
+#include <cmath>
 
 #include "skin/imgloader.h"
-
+#include "skin/skinimagepreloader.h"
 #include "util/math.h"
 #include "util/memory.h"
 #include "util/painterscope.h"
 
+namespace {
+
+// Paintables are only created on the GUI thread
+quint64 s_nextSvgRasterId = 0;
+
+} // anonymous namespace
+
 // static
 Paintable::DrawMode Paintable::DrawModeFromString(const QString& str) {
     if (str.compare("FIXED", Qt::CaseInsensitive) == 0) {
@@ -53,6 +62,26 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
     if (!source.isSVG()) {
         m_pPixmap.reset(WPixmapStore::getPixmapNoCache(source.getPath(), scaleFactor));
     } else {
+#ifdef __APPLE__
+        // Apple does Retina scaling behind the scenes, so we also pass a
+        // Paintable::FIXED image. On the other targets, it is better to
+        // cache the pixmap. We do not do this for TILE and color schemas.
+        // which can result in a correct but possibly blurry picture at a
+        // Retina display. This can be fixed when switching to QT5
+        const bool rasterize = mode == TILE || WPixmapStore::willCorrectColors();
+#else
+        const bool rasterize = mode == TILE || mode == Paintable::FIXED ||
+                WPixmapStore::willCorrectColors();
+#endif
+        QImage preloadedImage;
+        if (rasterize && SkinImagePreloader::findImage(
+                    source.getPath(), scaleFactor, &preloadedImage)) {
+            // Rendered by the preloader in the same way as below
+            WPixmapStore::correctImageColors(&preloadedImage);
+            m_pPixmap.reset(new QPixmap(QPixmap::fromImage(preloadedImage)));
+            return;
+        }
+
         auto pSvg = std::make_unique<QSvgRenderer>();
         if (!source.getSvgSourceData().isEmpty()) {
             // Call here the different overload for svg content
@@ -69,16 +98,7 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
             return;
         }
         m_pSvg.reset(pSvg.release());
-#ifdef __APPLE__
-        // Apple does Retina scaling behind the scenes, so we also pass a
-        // Paintable::FIXED image. On the other targets, it is better to
-        // cache the pixmap. We do not do this for TILE and color schemas.
-        // which can result in a correct but possibly blurry picture at a
-        // Retina display. This can be fixed when switching to QT5
-        if (mode == TILE || WPixmapStore::willCorrectColors()) {
-#else
-        if (mode == TILE || mode == Paintable::FIXED || WPixmapStore::willCorrectColors()) {
-#endif
+        if (rasterize) {
             // The SVG renderer doesn't directly support tiling, so we render
             // it to a pixmap which will then get tiled.
             QImage copy_buffer(m_pSvg->defaultSize() * scaleFactor, QImage::Format_ARGB32);
@@ -89,10 +109,18 @@ Paintable::Paintable(const PixmapSource& source, DrawMode mode, double scaleFact
 
             m_pPixmap.reset(new QPixmap(copy_buffer.size()));
             m_pPixmap->convertFromImage(copy_buffer);
+        } else {
+            m_svgRasterKeyPrefix = QString("%1/").arg(s_nextSvgRasterId++);
         }
     }
 }
 
+Paintable::~Paintable() {
+    if (!m_svgRasterKeyPrefix.isEmpty()) {
+        WPixmapStore::removeSvgRasters(m_svgRasterKeyPrefix);
+    }
+}
+
 bool Paintable::isNull() const {
     return m_source.isEmpty();
 }
@@ -240,7 +268,7 @@ void Paintable::drawInternal(const QRectF& targetRect, QPainter* pPainter,
     } else if (m_pSvg) {
         if (m_drawMode == TILE) {
             qWarning() << "Tiled SVG should have been rendered to pixmap!";
-        } else {
+        } else if (!drawSvgRaster(targetRect, pPainter, sourceRect)) {
             // NOTE(rryan): QSvgRenderer render does not clip for us -- it
             // applies a world transformation using viewBox and renders the
             // entire SVG to the painter. We save/restore the QPainter in case
@@ -255,6 +283,63 @@ void Paintable::drawInternal(const QRectF& targetRect, QPainter* pPainter,
     }
 }
 
+bool Paintable::drawSvgRaster(const QRectF& targetRect, QPainter* pPainter,
+                              const QRectF& sourceRect) {
+    const QSizeF svgSize = m_pSvg->defaultSize();
+    if (svgSize.isEmpty()) {
+        return false;
+    }
+    // The whole SVG is rasterized with the scale of the source to the
+    // target rect in device pixels. Drawing different source rects with
+    // the same scale, e.g. for VU meters, reuses the same pixmap.
+    qreal devicePixelRatio = 1.0;
+    if (pPainter->device()) {
+        devicePixelRatio = pPainter->device()->devicePixelRatioF();
+    }
+    // Rotations, e.g. of knobs, do not affect the scale
+    const QTransform& transform = pPainter->worldTransform();
+    const qreal scaleX = std::hypot(transform.m11(), transform.m12()) *
+            devicePixelRatio * targetRect.width() / sourceRect.width();
+    const qreal scaleY = std::hypot(transform.m21(), transform.m22()) *
+            devicePixelRatio * targetRect.height() / sourceRect.height();
+    const QSize rasterSize(
+            qRound(svgSize.width() * scaleX),
+            qRound(svgSize.height() * scaleY));
+    if (rasterSize.isEmpty()) {
+        return false;
+    }
+
+    const QString key = m_svgRasterKeyPrefix +
+            QString("%1x%2").arg(
+                    QString::number(rasterSize.width()),
+                    QString::number(rasterSize.height()));
+    QPixmap raster;
+    if (!WPixmapStore::findSvgRaster(key, &raster)) {
+        if (!WPixmapStore::isSvgRasterCacheable(rasterSize)) {
+            return false;
+        }
+        QImage image(rasterSize, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.setRenderHints(pPainter->renderHints());
+        m_pSvg->setViewBox(QRectF(QPointF(0, 0), svgSize));
+        m_pSvg->render(&painter, QRectF(QPointF(0, 0), QSizeF(rasterSize)));
+        painter.end();
+        raster = QPixmap::fromImage(image);
+        WPixmapStore::insertSvgRaster(key, raster);
+    }
+
+    const qreal rasterScaleX = rasterSize.width() / svgSize.width();
+    const qreal rasterScaleY = rasterSize.height() / svgSize.height();
+    const QRectF rasterSourceRect(
+            sourceRect.x() * rasterScaleX,
+            sourceRect.y() * rasterScaleY,
+            sourceRect.width() * rasterScaleX,
+            sourceRect.height() * rasterScaleY);
+    pPainter->drawPixmap(targetRect, raster, rasterSourceRect);
+    return true;
+}
+
 // static
 QString Paintable::getAltFileName(const QString& fileName) {
     // Detect if the alternate image file exists and, if it does,
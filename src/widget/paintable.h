@@ -31,6 +31,7 @@ class Paintable {
     };
 
     Paintable(const PixmapSource& source, DrawMode mode, double scaleFactor);
+    ~Paintable();
 
     QSize size() const;
     int width() const;
@@ -55,11 +56,18 @@ class Paintable {
   private:
     void drawInternal(const QRectF& targetRect, QPainter* pPainter,
                       const QRectF& sourceRect);
+    // Draws the SVG from a pixmap that is rasterized once for the
+    // resulting size in device pixels. Returns false if the SVG needs
+    // to be rendered directly.
+    bool drawSvgRaster(const QRectF& targetRect, QPainter* pPainter,
+                       const QRectF& sourceRect);
 
     QScopedPointer<QPixmap> m_pPixmap;
     QScopedPointer<QSvgRenderer> m_pSvg;
     DrawMode m_drawMode;
     PixmapSource m_source;
+    // Identifies the rasterized images of this Paintable in WPixmapStore
+    QString m_svgRasterKeyPrefix;
 };
 
 #endif // PAINTABLE
@@ -5,6 +5,7 @@
 #include <QPainter>
 
 #include "skin/imgloader.h"
+#include "skin/skinimagepreloader.h"
 #include "util/assert.h"
 
 
@@ -58,6 +59,11 @@ std::shared_ptr<QImage> WImageStore::getImage(const PixmapSource& source, double
 // static
 QImage* WImageStore::getImageNoCache(const PixmapSource& source, double scaleFactor) {
     if (source.isSVG()) {
+        QImage preloadedImage;
+        if (SkinImagePreloader::findImage(source.getPath(), scaleFactor, &preloadedImage)) {
+            return new QImage(preloadedImage);
+        }
+
         QSvgRenderer renderer;
 
         if (!source.getSvgSourceData().isEmpty()) {
@@ -7,8 +7,20 @@
 #include "util/math.h"
 #include "skin/imgloader.h"
 
+namespace {
+
+int rasterCostKB(const QSize& size) {
+    // 32 bits per pixel
+    return static_cast<int>(
+            (static_cast<qint64>(size.width()) * size.height() * 4 + 1023) / 1024);
+}
+
+} // anonymous namespace
+
 // static
 QHash<QString, WeakPaintablePointer> WPixmapStore::m_paintableCache;
+QCache<QString, QPixmap> WPixmapStore::m_svgRasterCache(
+        WPixmapStore::kDefaultSvgRasterCacheCapacityKB);
 QSharedPointer<ImgSource> WPixmapStore::m_loader
         = QSharedPointer<ImgSource>(new ImgLoader());
 
@@ -63,4 +75,47 @@ void WPixmapStore::setLoader(QSharedPointer<ImgSource> ld) {
     // loader has changed. The pixmaps will get freed once all the widgets
     // referring to them are destroyed.
     m_paintableCache.clear();
+    // The loader is replaced when the skin is (re-)loaded
+    m_svgRasterCache.clear();
+}
+
+// static
+bool WPixmapStore::findSvgRaster(const QString& key, QPixmap* pPixmap) {
+    const QPixmap* pCachedPixmap = m_svgRasterCache.object(key);
+    if (!pCachedPixmap) {
+        return false;
+    }
+    // Implicitly shared
+    *pPixmap = *pCachedPixmap;
+    return true;
+}
+
+// static
+bool WPixmapStore::isSvgRasterCacheable(const QSize& size) {
+    return rasterCostKB(size) <= m_svgRasterCache.maxCost() / 8;
+}
+
+// static
+void WPixmapStore::insertSvgRaster(const QString& key, const QPixmap& pixmap) {
+    m_svgRasterCache.insert(key, new QPixmap(pixmap), rasterCostKB(pixmap.size()));
+}
+
+// static
+void WPixmapStore::removeSvgRasters(const QString& keyPrefix) {
+    const QList<QString> keys = m_svgRasterCache.keys();
+    for (const auto& key : keys) {
+        if (key.startsWith(keyPrefix)) {
+            m_svgRasterCache.remove(key);
+        }
+    }
+}
+
+// static
+void WPixmapStore::setSvgRasterCacheCapacity(int capacityKB) {
+    m_svgRasterCache.setMaxCost(math_max(capacityKB, 0));
+}
+
+// static
+int WPixmapStore::svgRasterCacheSizeKB() {
+    return m_svgRasterCache.totalCost();
 }
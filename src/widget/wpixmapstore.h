@@ -18,6 +18,7 @@
 #ifndef WPIXMAPSTORE_H
 #define WPIXMAPSTORE_H
 
+#include <QCache>
 #include <QPixmap>
 #include <QHash>
 #include <QSharedPointer>
@@ -47,8 +48,23 @@ class WPixmapStore {
     static void correctImageColors(QImage* p);
     static bool willCorrectColors();
 
+    // SVG images that are rasterized by Paintables for a particular
+    // size on the screen. The cache is shared by all Paintables and
+    // bounded by its capacity. It must only be accessed from the GUI
+    // thread.
+    static constexpr int kDefaultSvgRasterCacheCapacityKB = 64 * 1024;
+    static bool findSvgRaster(const QString& key, QPixmap* pPixmap);
+    // Images that would occupy a large part of the cache are not cached
+    static bool isSvgRasterCacheable(const QSize& size);
+    static void insertSvgRaster(const QString& key, const QPixmap& pixmap);
+    static void removeSvgRasters(const QString& keyPrefix);
+    // A capacity of 0 disables the cache
+    static void setSvgRasterCacheCapacity(int capacityKB);
+    static int svgRasterCacheSizeKB();
+
   private:
     static QHash<QString, WeakPaintablePointer> m_paintableCache;
+    static QCache<QString, QPixmap> m_svgRasterCache;
     static QSharedPointer<ImgSource> m_loader;
 };
 